@@ -76,6 +76,7 @@ set(BS_BANSHEECORE_INC_SCENE
 	"Include/BsGameObjectManager.h"
 	"Include/BsSceneObject.h"
 	"Include/BsSceneManager.h"
+	"Include/BsSceneTransformStorage.h"
 	"Include/BsPrefab.h"
 	"Include/BsPrefabDiff.h"
 	"Include/BsPrefabUtility.h"
@@ -196,9 +197,11 @@ set(BS_BANSHEECORE_INC_RESOURCES
 	"Include/BsVertexDataDesc.h"
 	"Include/BsTransientMesh.h"
 	"Include/BsTextureManager.h"
+	"Include/BsTextureStreamingManager.h"
 	"Include/BsTexture.h"
 	"Include/BsResources.h"
 	"Include/BsResourceManifest.h"
+	"Include/BsResourceArchive.h"
 	"Include/BsResourceHandle.h"
 	"Include/BsResource.h"
 	"Include/BsPixelData.h"
@@ -347,6 +350,7 @@ set(BS_BANSHEECORE_INC_RTTI
 	"Include/BsAnimationClipRTTI.h"
 	"Include/BsAnimationCurveRTTI.h"
 	"Include/BsSkeletonRTTI.h"
+	"Include/BsCompressedAnimationCurvesRTTI.h"
 	"Include/BsCCameraRTTI.h"
 	"Include/BsCameraRTTI.h"
 	"Include/BsPostProcessSettingsRTTI.h"
@@ -387,9 +391,11 @@ set(BS_BANSHEECORE_SRC_RESOURCES
 	"Source/BsResource.cpp"
 	"Source/BsResourceHandle.cpp"
 	"Source/BsResourceManifest.cpp"
+	"Source/BsResourceArchive.cpp"
 	"Source/BsResources.cpp"
 	"Source/BsTexture.cpp"
 	"Source/BsTextureManager.cpp"
+	"Source/BsTextureStreamingManager.cpp"
 	"Source/BsTransientMesh.cpp"
 	"Source/BsVertexDataDesc.cpp"
 	"Source/BsResourceMetaData.cpp"
@@ -506,6 +512,7 @@ set(BS_BANSHEECORE_SRC_SCENE
 	"Source/BsGameObjectManager.cpp"
 	"Source/BsSceneObject.cpp"
 	"Source/BsSceneManager.cpp"
+	"Source/BsSceneTransformStorage.cpp"
 	"Source/BsPrefab.cpp"
 	"Source/BsPrefabDiff.cpp"
 	"Source/BsPrefabUtility.cpp"
@@ -540,9 +547,24 @@ set(BS_BANSHEECORE_INC_ANIMATION
 	"Include/BsCurveCache.h"
 	"Include/BsAnimationUtility.h"
 	"Include/BsSkeletonMask.h"
+	"Include/BsCompressedAnimationCurves.h"
 	"Include/BsMorphShapes.h"
 )
 
+set(BS_BANSHEECORE_INC_TESTING
+	"Include/BsPixelUtilTestSuite.h"
+	"Include/BsGameObjectManagerTestSuite.h"
+	"Include/BsSceneManagerTestSuite.h"
+	"Include/BsResourcesTestSuite.h"
+)
+
+set(BS_BANSHEECORE_SRC_TESTING
+	"Source/BsPixelUtilTestSuite.cpp"
+	"Source/BsGameObjectManagerTestSuite.cpp"
+	"Source/BsSceneManagerTestSuite.cpp"
+	"Source/BsResourcesTestSuite.cpp"
+)
+
 set(BS_BANSHEECORE_SRC_ANIMATION
 	"Source/BsAnimationCurve.cpp"
 	"Source/BsAnimationClip.cpp"
@@ -551,6 +573,7 @@ set(BS_BANSHEECORE_SRC_ANIMATION
 	"Source/BsAnimationManager.cpp"
 	"Source/BsAnimationUtility.cpp"
 	"Source/BsSkeletonMask.cpp"
+	"Source/BsCompressedAnimationCurves.cpp"
 	"Source/BsMorphShapes.cpp"
 )
 
@@ -622,6 +645,8 @@ source_group("Header Files\\Audio" FILES ${BS_BANSHEECORE_INC_AUDIO})
 source_group("Source Files\\Audio" FILES ${BS_BANSHEECORE_SRC_AUDIO})
 source_group("Header Files\\Animation" FILES ${BS_BANSHEECORE_INC_ANIMATION})
 source_group("Source Files\\Animation" FILES ${BS_BANSHEECORE_SRC_ANIMATION})
+source_group("Header Files\\Testing" FILES ${BS_BANSHEECORE_INC_TESTING})
+source_group("Source Files\\Testing" FILES ${BS_BANSHEECORE_SRC_TESTING})
 
 set(BS_BANSHEECORE_SRC
 	${BS_BANSHEECORE_INC_COMPONENTS}
@@ -664,4 +689,6 @@ set(BS_BANSHEECORE_SRC
 	${BS_BANSHEECORE_SRC_ANIMATION}
 	${BS_BANSHEECORE_INC_RENDERAPI_MANAGERS}
 	${BS_BANSHEECORE_SRC_RENDERAPI_MANAGERS}
+	${BS_BANSHEECORE_INC_TESTING}
+	${BS_BANSHEECORE_SRC_TESTING}
 )
\ No newline at end of file
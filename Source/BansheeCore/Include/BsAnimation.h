@@ -57,6 +57,36 @@ namespace bs
 		bool stopped = false;
 	};
 
+	/** 
+	 * Level of detail used for evaluating an animation. Allows animations that cover a small portion of the screen to be
+	 * evaluated less often, and with fewer bones.
+	 */
+	struct AnimationLOD
+	{
+		AnimationLOD(float screenSize = 0.0f, UINT32 frameInterval = 1, UINT32 maxBoneDepth = (UINT32)-1)
+			:screenSize(screenSize), frameInterval(frameInterval), maxBoneDepth(maxBoneDepth)
+		{ }
+
+		/** 
+		 * Minimum size of the animation bounds on screen for this LOD to be used, as a fraction of the screen height. When
+		 * the bounds are smaller than all provided LODs, the LOD with the smallest size is used.
+		 */
+		float screenSize;
+
+		/** 
+		 * Determines how often to evaluate the skeletal animation, as the number of animation updates between two 
+		 * evaluations. 1 evaluates the animation on every update, while 0 freezes the animation in its last evaluated
+		 * pose. Poses for updates in between evaluations are interpolated from the two last evaluated poses.
+		 */
+		UINT32 frameInterval;
+
+		/** 
+		 * Maximum depth of bones that will be evaluated, where root bones have depth zero. Bones deeper than this keep
+		 * their last local transform.
+		 */
+		UINT32 maxBoneDepth;
+	};
+
 	/** Type of playback for animation clips. */
 	enum class AnimPlaybackType
 	{
@@ -253,6 +283,15 @@ namespace bs
 		AABox mBounds;
 		bool mCullEnabled;
 
+		// Level of detail
+		Vector<AnimationLOD> lods; /**< Sorted from the largest to the smallest screen size. */
+		UINT32 lodFrameInterval; /**< Evaluation interval of the currently active LOD. */
+		UINT32 lodMaxBoneDepth; /**< Maximum bone depth of the currently active LOD. */
+		UINT32 lodFramesSinceEval; /**< Number of animation updates since the skeleton was last evaluated. */
+		UINT32 lodNumCachedPoses; /**< Number of valid poses in @p lodPoses. */
+		bool skeletonPoseValid; /**< True if @p skeletonPose contains an evaluated pose. */
+		LocalSkeletonPose lodPoses[2]; /**< Two most recently evaluated poses, oldest first. */
+
 		// Evaluation results
 		LocalSkeletonPose skeletonPose;
 		LocalSkeletonPose sceneObjectPose;
@@ -318,6 +357,16 @@ namespace bs
 		 */
 		void setCulling(bool cull);
 
+		/** 
+		 * Sets a list of levels of detail that determine how often and how many bones of the skeletal animation are 
+		 * evaluated, depending on how large the animation bounds (as provided by setBounds()) appear on the screen of the
+		 * camera closest to them. If no LODs are provided the animation is always fully evaluated on every update.
+		 */
+		void setLODs(const Vector<AnimationLOD>& lods);
+
+		/** @copydoc setLODs */
+		const Vector<AnimationLOD>& getLODs() const { return mLODs; }
+
 		/** 
 		 * Plays the specified animation clip. 
 		 *
@@ -515,6 +564,7 @@ namespace bs
 		float mDefaultSpeed;
 		AABox mBounds;
 		bool mCull;
+		Vector<AnimationLOD> mLODs;
 		AnimDirtyState mDirty;
 
 		SPtr<Skeleton> mSkeleton;
@@ -127,9 +127,33 @@ namespace bs
 		 */
 		SPtr<AnimationCurves> getCurves() const { return mCurves; }
 
-		/** Assigns a new set of curves to be used by the animation. The clip will store a copy of this object.*/
+		/** 
+		 * Assigns a new set of curves to be used by the animation. The clip will store a copy of this object. If the clip
+		 * was compressed the compressed data will be discarded.
+		 */
 		void setCurves(const AnimationCurves& curves);
 
+		/** 
+		 * Compresses the position, rotation and scale curves of the clip. Compressed clips use significantly less memory
+		 * and can be evaluated faster, at the cost of some precision. Once compressed the position, rotation and scale 
+		 * curves returned by getCurves() will no longer contain any keyframes (but will retain their names), and the data
+		 * will instead be available through getCompressedCurves(). Generic curves are not affected.
+		 *
+		 * @param[in]	maxError	Maximum error allowed when removing redundant keyframes. Applies to individual
+		 *							components of positions, rotations (quaternions) and scales.
+		 * @return					True if the clip was compressed, false if the clip curves could not be compressed.
+		 */
+		bool compress(float maxError = 0.0001f);
+
+		/** Checks has the clip been compressed. */
+		bool isCompressed() const { return mCompressedCurves != nullptr; }
+
+		/** 
+		 * Returns compressed position, rotation and scale curves, or null if the clip is not compressed. Curve indices
+		 * match the indices of the curves returned by getCurves().
+		 */
+		SPtr<CompressedAnimationCurves> getCompressedCurves() const { return mCompressedCurves; }
+
 		/** Returns all events that will be triggered by the animation. */
 		const Vector<AnimationEvent>& getEvents() const { return mEvents; }
 
@@ -262,6 +286,9 @@ namespace bs
 		 */
 		SPtr<AnimationCurves> mCurves;
 
+		/** Compressed version of position, rotation and scale curves in @p mCurves, if the clip was compressed. */
+		SPtr<CompressedAnimationCurves> mCompressedCurves;
+
 		/**
 		 * A set of curves containing motion of the root bone. If this is non-empty it should be true that mCurves does not
 		 * contain animation curves for the root bone. Root motion will not be evaluated through normal animation process
@@ -23,7 +23,9 @@ namespace bs
 
 	/**
 	 * Animation spline represented by a set of keyframes, each representing an endpoint of a cubic hermite curve. The
-	 * spline can be evaluated at any time, and uses caching to speed up multiple sequential evaluations.
+	 * spline can be evaluated at any time, and uses caching to speed up multiple sequential evaluations. Curves with many
+	 * keys additionally keep a key index that allows keys to be found in constant time on average, regardless of the
+	 * order in which the curve is evaluated.
 	 */
 	template <class T>
 	class BS_CORE_EXPORT TAnimationCurve // Note: Curves are expected to be immutable for threading purposes
@@ -114,7 +116,8 @@ namespace bs
 		void findKeys(float time, const TCurveCache<T>& cache, UINT32& leftKey, UINT32& rightKey) const;
 
 		/** 
-		 * Returns a pair of keys that can be used for interpolating to field the value at the provided time. 
+		 * Returns a pair of keys that can be used for interpolating to field the value at the provided time. Uses the key
+		 * index if available, or a binary search over all keys otherwise.
 		 *
 		 * @param[in]	time			Time for which to find the relevant keys from. It is expected to be clamped to a
 		 *								valid range within the curve.
@@ -123,6 +126,15 @@ namespace bs
 		 */
 		void findKeys(float time, UINT32& leftKey, UINT32& rightKey) const;
 
+		/** 
+		 * Builds an index that maps uniformly sized time intervals of the curve to the range of keys located within them.
+		 * Only built for curves with at least KEY_INDEX_MIN_KEYS keys. Must be called whenever key times change.
+		 */
+		void buildKeyIndex();
+
+		/** Maps the provided time to a cell of the key index. */
+		UINT32 getKeyIndexCell(float time) const;
+
 		/** Returns a keyframe index nearest to the provided time. */
 		UINT32 findKey(float time);
 
@@ -147,11 +159,19 @@ namespace bs
 		T evaluateCache(float time, const TCurveCache<T>& animInstance) const;
 
 		static const UINT32 CACHE_LOOKAHEAD;
+		static const UINT32 KEY_INDEX_MIN_KEYS;
 
 		Vector<KeyFrame> mKeyframes;
 		float mStart;
 		float mEnd;
 		float mLength;
+
+		/** 
+		 * For each cell of the key index, the number of keys located in all the preceding cells. Contains an extra entry
+		 * at the end equal to the total number of keys. Empty if the curve has no index.
+		 */
+		Vector<UINT32> mKeyIndex;
+		float mKeyIndexInvCellSize;
 	};
 
 	/** Flags that described an TAnimationCurve<T>. */
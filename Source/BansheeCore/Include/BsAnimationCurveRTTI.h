@@ -80,6 +80,7 @@ namespace bs
 			memory = rttiReadElem(data.mLength, memory);
 			memory = rttiReadElem(data.mKeyframes, memory);
 
+			data.buildKeyIndex();
 			return size;
 		}
 
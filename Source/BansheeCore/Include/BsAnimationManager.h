@@ -102,6 +102,30 @@ namespace bs
 	private:
 		friend class Animation;
 
+		/** Contains temporary information about an animation proxy, used during evaluation. */
+		struct ProxyEvalInfo
+		{
+			UINT32 boneIdx;
+			bool visible;
+			bool hasAnimInfo;
+			RendererAnimationData::AnimInfo animInfo;
+		};
+
+		/** Contains information about a camera required for determining how large animation bounds appear on screen. */
+		struct LODCameraInfo
+		{
+			Vector3 position;
+			/** 
+			 * Scale that converts bounds radius into a fraction of screen height. For perspective cameras the radius must
+			 * first be divided by the distance to the camera.
+			 */
+			float screenScale;
+			bool perspective;
+		};
+
+		/** Maximum number of animations to evaluate in a single task when evaluating animations in parallel. */
+		static const UINT32 PROXY_BATCH_SIZE = 8;
+
 		/** Possible states the worker thread can be in, used for synchronization. */
 		enum class WorkerState
 		{
@@ -121,6 +145,23 @@ namespace bs
 		/** Worker method ran on the animation thread that evaluates all animation at the provided time. */
 		void evaluateAnimation();
 
+		/** 
+		 * Determines the size of the animation bounds on screen of the camera closest to them, and selects the level of
+		 * detail to evaluate the animation with. Also determines if the animation is visible, if culling is enabled.
+		 * Returns false if the animation was culled.
+		 */
+		bool updateVisibilityAndLOD(AnimationProxy& anim) const;
+
+		/** 
+		 * Evaluates a single animation proxy. Skeletal pose is written to the @p renderData transform buffer, starting at
+		 * @p boneIdx. Returns true if the animation produced any data that should be made available to the renderer, in
+		 * which case @p animInfo will be populated.
+		 *
+		 * @note	Thread safe as long as the provided proxy and transform buffer range isn't accessed by another thread.
+		 */
+		bool evaluateProxy(const SPtr<AnimationProxy>& anim, UINT32 boneIdx, RendererAnimationData& renderData,
+			const RendererAnimationData& prevRenderData, RendererAnimationData::AnimInfo& animInfo);
+
 		UINT64 mNextId;
 		UnorderedMap<UINT64, Animation*> mAnimations;
 		
@@ -137,6 +178,8 @@ namespace bs
 		// Animation thread
 		Vector<SPtr<AnimationProxy>> mProxies;
 		Vector<ConvexVolume> mCullFrustums;
+		Vector<LODCameraInfo> mLODCameras;
+		Vector<ProxyEvalInfo> mProxyEvalInfos;
 		RendererAnimationData mAnimData[CoreThread::NUM_SYNC_BUFFERS];
 
 		UINT32 mPoseReadBufferIdx;
@@ -41,6 +41,18 @@ namespace bs
 
 		void setData(AudioClip* obj, const SPtr<DataStream>& val, UINT32 size)
 		{
+			// Clips can hold on to their data indefinitely, so they shouldn't keep referencing a mapped file
+			if (val->isMapped())
+			{
+				UINT8* data = (UINT8*)bs_alloc(size);
+				val->read(data, size);
+
+				obj->mStreamData = bs_shared_ptr_new<MemoryDataStream>(data, size);
+				obj->mStreamSize = size;
+				obj->mStreamOffset = 0;
+				return;
+			}
+
 			obj->mStreamData = val->clone(); // Making sure that the AudioClip cannot modify the source stream, which is still used by the deserializer
 			obj->mStreamSize = size;
 			obj->mStreamOffset = (UINT32)val->tell();
@@ -65,77 +65,83 @@ namespace bs
 
 	/**
 	 * Represents a single queued command in the command list. Contains all the data for executing the command and checking 
-	 * up on the command status.
+	 * up on the command status. Commands are stored in command blocks, and the callback of the command is stored directly
+	 * after this header.
 	 */
 	struct QueuedCommand
 	{
-#if BS_DEBUG_MODE
-		QueuedCommand(std::function<void(AsyncOp&)> _callback, UINT32 _debugId, const SPtr<AsyncOpSyncData>& asyncOpSyncData,
-			bool _notifyWhenComplete = false, UINT32 _callbackId = 0)
-			: debugId(_debugId), callbackWithReturnValue(_callback), asyncOp(asyncOpSyncData), returnsValue(true)
-			, callbackId(_callbackId), notifyWhenComplete(_notifyWhenComplete)
-		{ }
-
-		QueuedCommand(std::function<void()> _callback, UINT32 _debugId, bool _notifyWhenComplete = false, UINT32 _callbackId = 0)
-			:debugId(_debugId), callback(_callback), asyncOp(AsyncOpEmpty()), returnsValue(false), callbackId(_callbackId)
+		QueuedCommand(bool _returnsValue, bool _notifyWhenComplete, UINT32 _callbackId)
+			:invoke(nullptr), asyncOp(AsyncOpEmpty()), size(0), callbackId(_callbackId), returnsValue(_returnsValue)
 			, notifyWhenComplete(_notifyWhenComplete)
 		{ }
 
-		UINT32 debugId;
-#else
-		QueuedCommand(std::function<void(AsyncOp&)> _callback, const SPtr<AsyncOpSyncData>& asyncOpSyncData, 
-			bool _notifyWhenComplete = false, UINT32 _callbackId = 0)
-			:callbackWithReturnValue(_callback), returnsValue(true), notifyWhenComplete(_notifyWhenComplete), 
-			callbackId(_callbackId), asyncOp(asyncOpSyncData)
-		{ }
+		/** Returns the memory the command callback is stored in. */
+		void* getCallback() { return (UINT8*)this + getHeaderSize(); }
 
-		QueuedCommand(std::function<void()> _callback, bool _notifyWhenComplete = false, UINT32 _callbackId = 0)
-			:callback(_callback), returnsValue(false), notifyWhenComplete(_notifyWhenComplete), callbackId(_callbackId), asyncOp(AsyncOpEmpty())
-		{ }
-#endif
+		/** Returns the number of bytes required for storing the command header, including padding. */
+		static UINT32 getHeaderSize() { return alignSize((UINT32)sizeof(QueuedCommand)); }
 
-		~QueuedCommand()
-		{ }
+		/** Rounds up the provided size so it is a multiple of the command alignment. */
+		static UINT32 alignSize(UINT32 size) { return (size + ALIGNMENT - 1) & ~(ALIGNMENT - 1); }
 
-		QueuedCommand(const QueuedCommand& source)
+		/** Executes the callback of a command that doesn't return a value (if @p execute is true), and destroys it. */
+		template<class T>
+		static void invokeCallback(QueuedCommand* command, bool execute)
 		{
-			callback = source.callback;
-			callbackWithReturnValue = source.callbackWithReturnValue;
-			asyncOp = source.asyncOp;
-			returnsValue = source.returnsValue;
-			callbackId = source.callbackId;
-			notifyWhenComplete = source.notifyWhenComplete;
+			T* callback = (T*)command->getCallback();
+			if(execute)
+				(*callback)();
 
-#if BS_DEBUG_MODE
-			debugId = source.debugId;
-#endif
+			callback->~T();
 		}
 
-		QueuedCommand& operator=(const QueuedCommand& rhs)
+		/** Executes the callback of a command that returns a value (if @p execute is true), and destroys it. */
+		template<class T>
+		static void invokeReturnCallback(QueuedCommand* command, bool execute)
 		{
-			callback = rhs.callback;
-			callbackWithReturnValue = rhs.callbackWithReturnValue;
-			asyncOp = rhs.asyncOp;
-			returnsValue = rhs.returnsValue;
-			callbackId = rhs.callbackId;
-			notifyWhenComplete = rhs.notifyWhenComplete;
-			
-#if BS_DEBUG_MODE
-			debugId = rhs.debugId;
-#endif
+			T* callback = (T*)command->getCallback();
+			if(execute)
+				(*callback)(command->asyncOp);
 
-			return *this;
+			callback->~T();
 		}
 
-		std::function<void()> callback;
-		std::function<void(AsyncOp&)> callbackWithReturnValue;
+		/** Alignment of command headers and callbacks, in bytes. */
+		static const UINT32 ALIGNMENT = 16;
+
+		void(*invoke)(QueuedCommand*, bool);
 		AsyncOp asyncOp;
-		bool returnsValue;
+		UINT32 size; /**< Number of bytes taken up by the command, including the header and the callback. */
 		UINT32 callbackId;
+		bool returnsValue;
 		bool notifyWhenComplete;
+
+#if BS_DEBUG_MODE
+		UINT32 debugId;
+#endif
+	};
+
+	/** 
+	 * Chunk of memory containing a sequence of queued commands. Commands are constructed in-place in the block, so queuing
+	 * a command doesn't require an allocation. Blocks are chained together when commands don't fit in a single one.
+	 */
+	struct CommandBlock
+	{
+		/** Returns the memory commands are stored in. */
+		UINT8* getData() { return (UINT8*)this + QueuedCommand::alignSize((UINT32)sizeof(CommandBlock)); }
+
+		CommandBlock* next;
+		UINT32 size; /**< Number of bytes used by the commands in the block. */
+		UINT32 capacity; /**< Number of bytes available for commands in the block. */
 	};
 
-	/** Manages a list of commands that can be queued for later execution on the core thread. */
+	/** 
+	 * Manages a list of commands that can be queued for later execution on the core thread. 
+	 *
+	 * Commands and their callbacks are stored in a chain of command blocks. Blocks of executed commands are recycled, and
+	 * are returned from the thread executing the commands to the thread queuing them through a lock-free queue. This means
+	 * queuing and executing commands doesn't require any allocations once the queue has warmed up.
+	 */
 	class BS_CORE_EXPORT CommandQueueBase
 	{
 	public:
@@ -161,11 +167,13 @@ namespace bs
 		 * @param[in]	commands			Commands to execute.
 		 * @param[in]	notifyCallback  	Callback that will be called if a command that has @p notifyOnComplete flag set.
 		 * 									The callback will receive @p callbackId of the command.
+		 *
+		 * @note	Commands must always be executed on the same thread.
 		 */
-		void playbackWithNotify(Queue<QueuedCommand>* commands, std::function<void(UINT32)> notifyCallback);
+		void playbackWithNotify(CommandBlock* commands, std::function<void(UINT32)> notifyCallback);
 
 		/** Executes all provided commands one by one in order. To get the commands you should call flush(). */
-		void playback(Queue<QueuedCommand>* commands);
+		void playback(CommandBlock* commands);
 
 		/**
 		 * Allows you to set a breakpoint that will trigger when the specified command is executed.		
@@ -186,7 +194,8 @@ namespace bs
 		 * Last parameter must be unbound and of AsyncOp& type. This is used to signal that the command is completed, and 
 		 * also for storing the return value.		
 		 *
-		 * @param[in]	commandCallback		Command to queue for execution.
+		 * @param[in]	commandCallback		Command to queue for execution. Any callable object can be provided, and it will
+		 *									be stored in the queue directly.
 		 * @param[in]	_notifyWhenComplete	(optional) Call the notify method (provided in the call to playback())
 		 * 									when the command is complete.
 		 * @param[in]	_callbackId			(optional) Identifier for the callback so you can then later find it
@@ -200,26 +209,52 @@ namespace bs
 		 * Callback method also needs to call AsyncOp::markAsResolved once it is done processing. (If it doesn't it will 
 		 * still be called automatically, but the return value will default to nullptr)
 		 */
-		AsyncOp queueReturn(std::function<void(AsyncOp&)> commandCallback, bool _notifyWhenComplete = false, UINT32 _callbackId = 0);
+		template<class T>
+		AsyncOp queueReturn(T&& commandCallback, bool _notifyWhenComplete = false, UINT32 _callbackId = 0)
+		{
+			typedef typename std::decay<T>::type CallbackType;
+			static_assert(alignof(CallbackType) <= QueuedCommand::ALIGNMENT, "Unsupported command callback alignment.");
+
+			QueuedCommand* command = allocCommand((UINT32)sizeof(CallbackType), true, _notifyWhenComplete, _callbackId);
+			new (command->getCallback()) CallbackType(std::forward<T>(commandCallback));
+			command->invoke = &QueuedCommand::invokeReturnCallback<CallbackType>;
+
+			AsyncOp asyncOp = command->asyncOp;
+			onCommandQueued();
+
+			return asyncOp;
+		}
 
 		/**
 		 * Queue up a new command to execute. Make sure the provided function has all of its parameters properly bound. 
 		 * Provided command is not expected to return a value. If you wish to return a value from the callback use the 
 		 * queueReturn() which accepts an AsyncOp parameter.
 		 *
-		 * @param[in]	commandCallback		Command to queue for execution.
+		 * @param[in]	commandCallback		Command to queue for execution. Any callable object can be provided, and it will
+		 *									be stored in the queue directly.
 		 * @param[in]	_notifyWhenComplete	(optional) Call the notify method (provided in the call to playback())
 		 * 									when the command is complete.
 		 * @param[in]	_callbackId		   	(optional) Identifier for the callback so you can then later find
 		 * 									it if needed.
 		 */
-		void queue(std::function<void()> commandCallback, bool _notifyWhenComplete = false, UINT32 _callbackId = 0);
+		template<class T>
+		void queue(T&& commandCallback, bool _notifyWhenComplete = false, UINT32 _callbackId = 0)
+		{
+			typedef typename std::decay<T>::type CallbackType;
+			static_assert(alignof(CallbackType) <= QueuedCommand::ALIGNMENT, "Unsupported command callback alignment.");
+
+			QueuedCommand* command = allocCommand((UINT32)sizeof(CallbackType), false, _notifyWhenComplete, _callbackId);
+			new (command->getCallback()) CallbackType(std::forward<T>(commandCallback));
+			command->invoke = &QueuedCommand::invokeCallback<CallbackType>;
+
+			onCommandQueued();
+		}
 
 		/**
-		 * Returns a copy of all queued commands and makes room for new ones. Must be called from the thread that created 
-		 * the command queue. Returned commands must be passed to playback() method.
+		 * Returns all queued commands and makes room for new ones. Must be called from the thread that created the command
+		 * queue. Returned commands must be passed to playback() method. Returns null if no commands are queued.
 		 */
-		Queue<QueuedCommand>* flush();
+		CommandBlock* flush();
 
 		/** Cancels all currently queued commands. */
 		void cancelAll();
@@ -227,6 +262,9 @@ namespace bs
 		/**	Returns true if no commands are queued. */
 		bool isEmpty();
 
+		/** Number of bytes available for commands in a single command block. */
+		static const UINT32 BLOCK_SIZE = 32 * 1024;
+
 	protected:
 		/**
 		 * Helper method that throws an "Invalid thread" exception. Used primarily so we can avoid including Exception 
@@ -235,8 +273,40 @@ namespace bs
 		void throwInvalidThreadException(const String& message) const;
 
 	private:
-		Queue<QueuedCommand>* mCommands;
-		Stack<Queue<QueuedCommand>*> mEmptyCommandQueues; /**< List of empty queues for reuse. */
+		/** 
+		 * Allocates room for a new command at the end of the queue and constructs its header. Caller is expected to
+		 * construct the callback and assign the invoke method.
+		 */
+		QueuedCommand* allocCommand(UINT32 callbackSize, bool returnsValue, bool notifyWhenComplete, UINT32 callbackId);
+
+		/** Called after a command has been fully constructed. */
+		void onCommandQueued();
+
+		/** Retrieves an unused command block able to hold at least @p size bytes. */
+		CommandBlock* allocBlock(UINT32 size);
+
+		/** 
+		 * Returns a block whose commands were executed back to the queuing thread, so it can be re-used. Must only be called
+		 * from the thread executing the commands.
+		 */
+		void releaseBlock(CommandBlock* block);
+
+		/** Destroys all commands in the provided blocks without executing them, and frees the blocks. */
+		void destroyCommands(CommandBlock* commands);
+
+		/** Maximum number of command blocks that can be waiting to be returned to the queuing thread. */
+		static const UINT32 MAX_RETURNED_BLOCKS = 32;
+
+		CommandBlock* mFirstBlock;
+		CommandBlock* mLastBlock;
+		UINT32 mNumCommands;
+		Vector<CommandBlock*> mFreeBlocks; /**< List of empty blocks for reuse. Accessed by the queuing thread only. */
+
+		// Ring buffer of blocks returned by the executing thread. Written to by the executing thread and read from by the
+		// queuing thread.
+		CommandBlock* mReturnedBlocks[MAX_RETURNED_BLOCKS];
+		std::atomic<UINT32> mReturnedBlocksStart;
+		std::atomic<UINT32> mReturnedBlocksEnd;
 
 		SPtr<AsyncOpSyncData> mAsyncOpSyncData;
 		ThreadId mMyThreadId;
@@ -299,7 +369,8 @@ namespace bs
 		{ }
 
 		/** @copydoc CommandQueueBase::queueReturn */
-		AsyncOp queueReturn(std::function<void(AsyncOp&)> commandCallback, bool _notifyWhenComplete = false, UINT32 _callbackId = 0)
+		template<class T>
+		AsyncOp queueReturn(T&& commandCallback, bool _notifyWhenComplete = false, UINT32 _callbackId = 0)
 		{
 #if BS_DEBUG_MODE
 #if BS_THREAD_SUPPORT != 0
@@ -309,14 +380,15 @@ namespace bs
 #endif
 
 			this->lock();
-			AsyncOp asyncOp = CommandQueueBase::queueReturn(commandCallback, _notifyWhenComplete, _callbackId);
+			AsyncOp asyncOp = CommandQueueBase::queueReturn(std::forward<T>(commandCallback), _notifyWhenComplete, _callbackId);
 			this->unlock();
 
 			return asyncOp;
 		}
 
 		/** @copydoc CommandQueueBase::queue */
-		void queue(std::function<void()> commandCallback, bool _notifyWhenComplete = false, UINT32 _callbackId = 0)
+		template<class T>
+		void queue(T&& commandCallback, bool _notifyWhenComplete = false, UINT32 _callbackId = 0)
 		{
 #if BS_DEBUG_MODE
 #if BS_THREAD_SUPPORT != 0
@@ -326,12 +398,12 @@ namespace bs
 #endif
 
 			this->lock();
-			CommandQueueBase::queue(commandCallback, _notifyWhenComplete, _callbackId);
+			CommandQueueBase::queue(std::forward<T>(commandCallback), _notifyWhenComplete, _callbackId);
 			this->unlock();
 		}
 
 		/** @copydoc CommandQueueBase::flush */
-		bs::Queue<QueuedCommand>* flush()
+		CommandBlock* flush()
 		{
 #if BS_DEBUG_MODE
 #if BS_THREAD_SUPPORT != 0
@@ -341,7 +413,7 @@ namespace bs
 #endif
 
 			this->lock();
-			bs::Queue<QueuedCommand>* commands = CommandQueueBase::flush();
+			CommandBlock* commands = CommandQueueBase::flush();
 			this->unlock();
 
 			return commands;
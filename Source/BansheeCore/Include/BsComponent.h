@@ -15,7 +15,15 @@ namespace bs
 	/** Flags that control behavior of a Component. */
 	enum class ComponentFlag
 	{
-		AlwaysRun = 1 /**< Ensures that scene manager cannot pause or stop component callbacks from executing. Off by default. */
+		AlwaysRun = 1, /**< Ensures that scene manager cannot pause or stop component callbacks from executing. Off by default. */
+		PostPhysicsUpdate = 2, /**< Component's postPhysicsUpdate() method is called every frame. Off by default. */
+		LateUpdate = 4, /**< Component's lateUpdate() method is called every frame. Off by default. */
+		/** 
+		 * Component's update methods only modify the component's own state, and don't create, destroy or modify any other
+		 * game objects (including their transforms). Allows the scene manager to update components of the same type in
+		 * parallel. Off by default.
+		 */
+		ThreadSafeUpdate = 8
 	};
 
 	typedef Flags<ComponentFlag> ComponentFlags;
@@ -39,6 +47,10 @@ namespace bs
 	 *  - If the component's parent SceneObject is inactive (SceneObject::setActive(false)), or any of his parents are
 	 *    inactive, then the component is considered to be in Stopped state, regardless whether the ComponentFlag::AlwaysRun
 	 *    flag is set or not.
+	 *
+	 * Active components are updated grouped by type, in three phases per frame: update() before the physics simulation, 
+	 * and optionally postPhysicsUpdate() after it and lateUpdate() after all other updates (see ComponentFlag). Update 
+	 * related flags should be set in constructor and not change during component lifetime.
 	 **/
 	class BS_CORE_EXPORT Component : public GameObject
 	{
@@ -52,9 +64,21 @@ namespace bs
 		/**	Returns a handle to this object. */
 		HComponent getHandle() const { return mThisHandle; }
 
-		/** Called once per frame. Only called if the component is in Running state. */
+		/** Called once per frame, before the physics simulation update. Only called if the component is in Running state. */
 		virtual void update() { }
 
+		/** 
+		 * Called once per frame, after the physics simulation update. Only called if the component is in Running state and
+		 * has the ComponentFlag::PostPhysicsUpdate flag set.
+		 */
+		virtual void postPhysicsUpdate() { }
+
+		/** 
+		 * Called once per frame, after all other component updates. Only called if the component is in Running state and
+		 * has the ComponentFlag::LateUpdate flag set.
+		 */
+		virtual void lateUpdate() { }
+
 		/**
 		 * Calculates bounds of the visible contents represented by this component (for example a mesh for Renderable).
 		 * 
@@ -170,9 +194,12 @@ namespace bs
 		TransformChangedFlags mNotifyFlags;
 		ComponentFlags mFlags;
 		UINT32 mSceneManagerId;
+		UINT32 mUpdateGroupId;
+		UINT32 mUpdateGroupIdx;
 
 	private:
 		HSceneObject mParent;
+		TransformChangedFlags mPendingNotifyFlags; /**< Notifications waiting for a batched transform update. */
 
 		/************************************************************************/
 		/* 								RTTI		                     		*/
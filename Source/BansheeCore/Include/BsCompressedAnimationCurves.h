@@ -0,0 +1,172 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#pragma once
+
+#include "BsCorePrerequisites.h"
+#include "BsIReflectable.h"
+#include "BsVector3.h"
+#include "BsQuaternion.h"
+
+namespace bs
+{
+	/** @addtogroup Animation-Internal
+	 *  @{
+	 */
+
+	/** Single quantized key stored in a CompressedAnimationCurves key stream. */
+	struct CompressedAnimationKey
+	{
+		/**
+		 * Index of the track the key belongs to, in lower 14 bits. For rotation tracks the upper two bits contain the
+		 * index of the quaternion component that was omitted during encoding.
+		 */
+		UINT16 track;
+		UINT16 frame; /**< Frame at which the key is located. Divide by sample rate to get the time in seconds. */
+		UINT16 value[3]; /**< Quantized value of the key. */
+	};
+
+	/** Range used for quantizing values of a single position or scale track. */
+	struct CompressedTrackRange
+	{
+		Vector3 min;
+		Vector3 extent;
+	};
+
+	/**
+	 * Set of tracks with the same length. Keys of all tracks in a group are stored contiguously in the key stream, so each
+	 * group can be looped independently at its own length, same as the uncompressed curves.
+	 */
+	struct CompressedTrackGroup
+	{
+		float length; /**< Length of the tracks in the group, in seconds. */
+		UINT32 firstKey; /**< Index of the first key of the group in the key stream. */
+		UINT32 numKeys; /**< Number of keys in the group. */
+	};
+
+	/**
+	 * Holds the state required for decoding CompressedAnimationCurves. You should keep a persistent instance of this
+	 * object for every animation evaluating the curves, so that sequential evaluations only need to decode the keys
+	 * that were passed since the last evaluation.
+	 */
+	struct CompressedCurveCursor
+	{
+	private:
+		friend class CompressedAnimationCurves;
+
+		/**
+		 * Indices of the keys that are currently used for interpolation. Two entries per track, the key to interpolate
+		 * from, followed by the key to interpolate to. -1 if no key has been decoded.
+		 */
+		mutable Vector<UINT32> keys;
+		mutable Vector<UINT32> streamPos; /**< Index of the next key in the stream to decode, per track group. */
+		mutable Vector<float> frames; /**< Frame (fractional) each track group was last advanced to. */
+	};
+
+	/**
+	 * Compressed version of position, rotation and scale curves in an AnimationClip. Curves are resampled at the clip's
+	 * sample rate, after which any keys that can be reconstructed through interpolation of their neighbours (within a
+	 * provided error) are removed. Remaining keys have their values quantized to 16-bit values. Rotations are encoded
+	 * using the smallest-three method, while positions and scales are quantized relative to a per-track range.
+	 *
+	 * Keys of all tracks are stored in a single stream, grouped by track length and sorted by the time at which they are
+	 * first required for interpolation. This ensures that evaluating all tracks at a specific time requires only a single
+	 * forward pass over each group, and that sequential evaluations only touch newly required keys.
+	 *
+	 * Track indices match the indices of curves in the AnimationCurves object the data was compressed from.
+	 *
+	 * @note	Immutable and therefore thread safe, as long as each thread uses its own CompressedCurveCursor.
+	 */
+	class BS_CORE_EXPORT CompressedAnimationCurves : public IReflectable
+	{
+	public:
+		/**
+		 * Advances the cursor to the provided time, decoding all the keys required for evaluating the tracks at that time.
+		 * Must be called before any of the evaluate methods.
+		 *
+		 * @param[in]	time		Time to advance the cursor to.
+		 * @param[in]	loop		If true the time will loop when it goes past the end or beggining of a track. 
+		 *							Otherwise it will be clamped. Each track loops at its own length.
+		 * @param[in]	cursor		Cursor to advance.
+		 */
+		void seek(float time, bool loop, const CompressedCurveCursor& cursor) const;
+
+		/** Evaluates the position track at the provided index, at the time the cursor was last advanced to. */
+		Vector3 evaluatePosition(UINT32 idx, const CompressedCurveCursor& cursor) const;
+
+		/** Evaluates the rotation track at the provided index, at the time the cursor was last advanced to. */
+		Quaternion evaluateRotation(UINT32 idx, const CompressedCurveCursor& cursor) const;
+
+		/** Evaluates the scale track at the provided index, at the time the cursor was last advanced to. */
+		Vector3 evaluateScale(UINT32 idx, const CompressedCurveCursor& cursor) const;
+
+		/** Returns the number of position tracks. */
+		UINT32 getNumPositionTracks() const { return mNumPositionTracks; }
+
+		/** Returns the number of rotation tracks. */
+		UINT32 getNumRotationTracks() const { return mNumRotationTracks; }
+
+		/** Returns the number of scale tracks. */
+		UINT32 getNumScaleTracks() const { return mNumScaleTracks; }
+
+		/** Returns the length of the longest track, in seconds. */
+		float getLength() const { return mLength; }
+
+		/** Returns the total number of keys stored, across all tracks. */
+		UINT32 getNumKeys() const { return (UINT32)mKeys.size(); }
+
+		/**
+		 * Compresses position, rotation and scale curves from the provided curve set.
+		 *
+		 * @param[in]	curves		Curves to compress. Generic curves are ignored.
+		 * @param[in]	sampleRate	Number of samples per second to resample the curves at.
+		 * @param[in]	maxError	Maximum error allowed when removing keys. Applies to individual components of the
+		 *							position, rotation (quaternion) and scale values.
+		 * @return					Compressed curves, or null if the curves cannot be compressed (too many tracks, or
+		 *							too many frames).
+		 */
+		static SPtr<CompressedAnimationCurves> create(const AnimationCurves& curves, UINT32 sampleRate, float maxError);
+
+	private:
+		CompressedAnimationCurves();
+
+		/** Decodes a position or scale value from the key at the provided index. */
+		Vector3 decodeVector(UINT32 keyIdx, const CompressedTrackRange& range) const;
+
+		/** Decodes a rotation from the key at the provided index. */
+		Quaternion decodeRotation(UINT32 keyIdx) const;
+
+		/** Finds the keys to interpolate between for the provided track and returns the interpolation factor. */
+		float getKeys(UINT32 track, const CompressedCurveCursor& cursor, UINT32& leftKey, UINT32& rightKey) const;
+
+		/** Resets the part of the cursor belonging to the provided track group to the group's first key. */
+		void resetGroup(UINT32 group, const CompressedCurveCursor& cursor) const;
+
+		UINT32 mNumPositionTracks;
+		UINT32 mNumRotationTracks;
+		UINT32 mNumScaleTracks;
+		UINT32 mSampleRate;
+		float mLength;
+
+		Vector<CompressedTrackRange> mRanges; /**< Quantization ranges for position tracks, followed by scale tracks. */
+		Vector<CompressedAnimationKey> mKeys;
+		Vector<CompressedTrackGroup> mGroups;
+		Vector<UINT32> mTrackGroups; /**< Index of the group each track belongs to. */
+
+		/************************************************************************/
+		/* 								SERIALIZATION                      		*/
+		/************************************************************************/
+	public:
+		friend class CompressedAnimationCurvesRTTI;
+		static RTTITypeBase* getRTTIStatic();
+		RTTITypeBase* getRTTI() const override;
+
+		/**
+		 * Creates CompressedAnimationCurves with no data. You must populate its data manually.
+		 *
+		 * @note	For serialization use only.
+		 */
+		static SPtr<CompressedAnimationCurves> createEmpty();
+	};
+
+	/** @} */
+}
@@ -0,0 +1,60 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#pragma once
+
+#include "BsCorePrerequisites.h"
+#include "BsRTTIType.h"
+#include "BsCompressedAnimationCurves.h"
+
+namespace bs
+{
+	/** @cond RTTI */
+	/** @addtogroup RTTI-Impl-Core
+	 *  @{
+	 */
+
+	BS_ALLOW_MEMCPY_SERIALIZATION(CompressedAnimationKey);
+	BS_ALLOW_MEMCPY_SERIALIZATION(CompressedTrackRange);
+	BS_ALLOW_MEMCPY_SERIALIZATION(CompressedTrackGroup);
+
+	class BS_CORE_EXPORT CompressedAnimationCurvesRTTI :
+		public RTTIType <CompressedAnimationCurves, IReflectable, CompressedAnimationCurvesRTTI>
+	{
+	private:
+		BS_BEGIN_RTTI_MEMBERS
+			BS_RTTI_MEMBER_PLAIN(mNumPositionTracks, 0)
+			BS_RTTI_MEMBER_PLAIN(mNumRotationTracks, 1)
+			BS_RTTI_MEMBER_PLAIN(mNumScaleTracks, 2)
+			BS_RTTI_MEMBER_PLAIN(mSampleRate, 3)
+			BS_RTTI_MEMBER_PLAIN(mLength, 4)
+			BS_RTTI_MEMBER_PLAIN_ARRAY(mRanges, 5)
+			BS_RTTI_MEMBER_PLAIN_ARRAY(mKeys, 6)
+			BS_RTTI_MEMBER_PLAIN_ARRAY(mGroups, 7)
+			BS_RTTI_MEMBER_PLAIN_ARRAY(mTrackGroups, 8)
+		BS_END_RTTI_MEMBERS
+
+	public:
+		CompressedAnimationCurvesRTTI()
+			:mInitMembers(this)
+		{ }
+
+		const String& getRTTIName() override
+		{
+			static String name = "CompressedAnimationCurves";
+			return name;
+		}
+
+		UINT32 getRTTIId() override
+		{
+			return TID_CompressedAnimationCurves;
+		}
+
+		SPtr<IReflectable> newRTTIObject() override
+		{
+			return CompressedAnimationCurves::createEmpty();
+		}
+	};
+
+	/** @} */
+	/** @endcond */
+}
@@ -148,10 +148,21 @@ namespace bs
 		friend class CoreObjectManager;
 
 		volatile UINT8 mFlags;
-		UINT32 mCoreDirtyFlags;
+		std::atomic<UINT32> mCoreDirtyFlags;
+		UINT32 mCoreSyncFlags; // Dirty flags captured when the object's sync started, zero if it isn't being synced
+		UINT32 mCoreDirtyIdx; // Index in CoreObjectManager's dirty object list, -1 if not in the list
 		UINT64 mInternalID; // ID == 0 is not a valid ID
 		std::weak_ptr<CoreObject> mThis;
 
+		/** 
+		 * Marks the object as clean and captures its dirty flags for the sync that is about to start. Modifications made 
+		 * from this point on mark the object dirty again, so they get synced the next time.
+		 */
+		void beginCoreSync() { mCoreSyncFlags = mCoreDirtyFlags.exchange(0); }
+
+		/** Notifies the object that the sync started with beginCoreSync() has finished. */
+		void endCoreSync() { mCoreSyncFlags = 0; }
+
 		/**
 		 * Queues object initialization command on the core thread. The command is added to the primary core thread queue 
 		 * and will be executed as soon as the core thread is ready.
@@ -211,9 +222,10 @@ namespace bs
 		bool isCoreDirty() const { return mCoreDirtyFlags != 0; }
 
 		/**
-		 * Returns the exact value of the internal flag that signals whether an object needs to be synced with the core thread.
+		 * Returns the dirty flags the object had at the time the sync in progress started. Only valid when called from 
+		 * syncToCore().
 		 */
-		UINT32 getCoreDirtyFlags() const { return mCoreDirtyFlags; }
+		UINT32 getCoreDirtyFlags() const { return mCoreSyncFlags; }
 
 		/**
 		 * Copy internal dirty data to a memory buffer that will be used for updating core thread version of that data.
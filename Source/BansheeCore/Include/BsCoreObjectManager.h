@@ -30,16 +30,18 @@ namespace bs
 		struct CoreStoredSyncObjData
 		{
 			CoreStoredSyncObjData()
-				:internalId(0)
+				:internalId(0), alloc(nullptr)
 			{ }
 
-			CoreStoredSyncObjData(const SPtr<ct::CoreObject> destObj, UINT64 internalId, const CoreSyncData& syncData)
-				:destinationObj(destObj), syncData(syncData), internalId(internalId)
+			CoreStoredSyncObjData(const SPtr<ct::CoreObject> destObj, UINT64 internalId, const CoreSyncData& syncData,
+				FrameAlloc* alloc)
+				:destinationObj(destObj), syncData(syncData), internalId(internalId), alloc(alloc)
 			{ }
 
 			SPtr<ct::CoreObject> destinationObj;
 			CoreSyncData syncData;
 			UINT64 internalId;
+			FrameAlloc* alloc; /**< Allocator the sync data was allocated with. */
 		};
 
 		/**
@@ -52,13 +54,25 @@ namespace bs
 			Vector<CoreStoredSyncObjData> entries;
 		};
 
-		/** Contains information about a dirty CoreObject that requires syncing to the core thread. */	
+		/** 
+		 * Contains information about a dirty CoreObject that requires syncing to the core thread. Object is null if it was
+		 * destroyed while dirty.
+		 */	
 		struct DirtyObjectData
 		{
 			CoreObject* object;
+			UINT64 internalId;
 			INT32 syncDataId;
 		};
 
+		/** Object scheduled to be synced by syncDownload(). */
+		struct SyncEntry
+		{
+			CoreObject* object; /**< Null if the object was destroyed. */
+			SPtr<CoreObject> objectRef; /**< Keeps the object alive while it is being synced. Null if already synced. */
+			UINT32 level; /**< Objects are synced after all objects with a lower level, which include their dependencies. */
+		};
+
 	public:
 		CoreObjectManager();
 		~CoreObjectManager();
@@ -98,6 +112,9 @@ namespace bs
 		 * Stores all syncable data from dirty core objects into memory allocated by the provided allocator. Additional 
 		 * meta-data is stored internally to be used by call to syncUpload().
 		 *
+		 * Objects are synced after their dependencies. Large numbers of objects that don't depend on each other are synced
+		 * in parallel on worker threads, in which case their data is allocated from ThreadFrameAlloc instead.
+		 *
 		 * @param[in]	allocator Allocator to use for allocating memory for stored data.
 		 *
 		 * @note	Sim thread only.
@@ -121,15 +138,30 @@ namespace bs
 		 */
 		void updateDependencies(CoreObject* object, Vector<CoreObject*>* dependencies);
 
+		/** Adds the object to the dirty object list, unless it is already in it. Caller must hold the objects mutex. */
+		void addDirtyObject(CoreObject* object);
+
+		/** Removes the object from the dirty object list, if it is in it. Caller must hold the objects mutex. */
+		void removeDirtyObject(CoreObject* object);
+
+		/** Minimum number of independent objects required before they are synced in parallel. */
+		static const UINT32 PARALLEL_MIN_OBJECTS = 512;
+
+		/** Minimum number of objects synced by a single task when syncing in parallel. */
+		static const UINT32 OBJECTS_PER_TASK = 256;
+
 		UINT64 mNextAvailableID;
-		Map<UINT64, CoreObject*> mObjects;
-		Map<UINT64, DirtyObjectData> mDirtyObjects;
-		Map<UINT64, Vector<CoreObject*>> mDependencies;
-		Map<UINT64, Vector<CoreObject*>> mDependants;
+		UnorderedMap<UINT64, CoreObject*> mObjects;
+		Vector<DirtyObjectData> mDirtyObjects; /**< Each object stores its index in this list. */
+		UnorderedMap<UINT64, Vector<CoreObject*>> mDependencies;
+		UnorderedMap<UINT64, Vector<CoreObject*>> mDependants;
 
 		Vector<CoreStoredSyncObjData> mDestroyedSyncData;
 		List<CoreStoredSyncData> mCoreSyncData;
 
+		/** Objects unregistered while being synced by syncDownload(). Processed once the sync is done. */
+		Vector<CoreObject*> mPendingUnregistrations;
+
 		Mutex mObjectsMutex;
 	};
 
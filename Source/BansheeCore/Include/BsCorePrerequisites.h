@@ -3,6 +3,7 @@
 #pragma once
 
 #include "BsPrerequisitesUtil.h"
+#include "BsThreadFrameAlloc.h"
 
 /** @addtogroup Layers
  *  @{
@@ -333,6 +334,7 @@ namespace bs
 	class MaterialParams;
 	template <class T> class TAnimationCurve;
 	struct AnimationCurves;
+	class CompressedAnimationCurves;
 	class Skeleton;
 	class Animation;
 	class GpuParamsSet;
@@ -353,6 +355,7 @@ namespace bs
 	class Resource;
 	class Resources;
 	class ResourceManifest;
+	class ResourceArchive;
 	class Texture;
 	class Mesh;
 	class MeshBase;
@@ -571,6 +574,7 @@ namespace bs
 		TID_CachedTextureData = 1133,
         TID_Skybox = 1134,
         TID_CSkybox = 1135,
+		TID_CompressedAnimationCurves = 1136,
 
 		// Moved from Engine layer
 		TID_CCamera = 30000,
@@ -683,10 +687,13 @@ namespace bs
 		static void onThreadStarted(const String& name)
 		{
 			MemStack::beginThread();
+			ThreadFrameAlloc::beginThread();
 		}
 
 		static void onThreadEnded(const String& name)
 		{
+			ThreadFrameAlloc::endThread();
+			PoolAlloc::endThread();
 			MemStack::endThread();
 		}
 	};
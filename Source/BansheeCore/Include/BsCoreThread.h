@@ -88,7 +88,8 @@ namespace bs
 		/**
 		 * Queues a new command that will be added to the command queue. Command returns a value.
 		 * 		
-		 * @param[in]	commandCallback		Command to queue.
+		 * @param[in]	commandCallback		Command to queue. Any callable object accepting an AsyncOp& parameter can be
+		 *									provided, and it will be stored in the queue without additional allocations.
 		 * @param[in]	flags				Flags that further control command submission.
 		 * @return							Structure that can be used to check if the command completed execution,
 		 *									and to retrieve the return value once it has.
@@ -96,18 +97,80 @@ namespace bs
 		 * @see		CommandQueue::queueReturn()
 		 * @note	Thread safe
 		 */
-		AsyncOp queueReturnCommand(std::function<void(AsyncOp&)> commandCallback, CoreThreadQueueFlags flags = CTQF_Default);
+		template<class T>
+		AsyncOp queueReturnCommand(T&& commandCallback, CoreThreadQueueFlags flags = CTQF_Default)
+		{
+			assert(BS_THREAD_CURRENT_ID != getCoreThreadId() && "Cannot queue commands on the core thread for the core thread");
+
+			if (!flags.isSet(CTQF_InternalQueue))
+				return getQueue()->queueReturnCommand(std::forward<T>(commandCallback));
+			else
+			{
+				bool blockUntilComplete = flags.isSet(CTQF_BlockUntilComplete);
+
+				AsyncOp op;
+				UINT32 commandId = -1;
+				{
+					Lock lock(mCommandQueueMutex);
+
+					if (blockUntilComplete)
+					{
+						commandId = mMaxCommandNotifyId++;
+						op = mCommandQueue->queueReturn(std::forward<T>(commandCallback), true, commandId);
+					}
+					else
+						op = mCommandQueue->queueReturn(std::forward<T>(commandCallback));
+				}
+
+				mCommandReadyCondition.notify_all();
+
+				if (blockUntilComplete)
+					blockUntilCommandCompleted(commandId);
+
+				return op;
+			}
+		}
 
 		/**
 		 * Queues a new command that will be to the global command queue. 
 		 * 	
-		 * @param[in]	commandCallback		Command to queue.
+		 * @param[in]	commandCallback		Command to queue. Any callable object can be provided, and it will be stored 
+		 *									in the queue without additional allocations.
 		 * @param[in]	flags				Flags that further control command submission.
 		 *
 		 * @see		CommandQueue::queue()
 		 * @note	Thread safe
 		 */
-		void queueCommand(std::function<void()> commandCallback, CoreThreadQueueFlags flags = CTQF_Default);
+		template<class T>
+		void queueCommand(T&& commandCallback, CoreThreadQueueFlags flags = CTQF_Default)
+		{
+			assert(BS_THREAD_CURRENT_ID != getCoreThreadId() && "Cannot queue commands on the core thread for the core thread");
+
+			if (!flags.isSet(CTQF_InternalQueue))
+				getQueue()->queueCommand(std::forward<T>(commandCallback));
+			else
+			{
+				bool blockUntilComplete = flags.isSet(CTQF_BlockUntilComplete);
+
+				UINT32 commandId = -1;
+				{
+					Lock lock(mCommandQueueMutex);
+
+					if (blockUntilComplete)
+					{
+						commandId = mMaxCommandNotifyId++;
+						mCommandQueue->queue(std::forward<T>(commandCallback), true, commandId);
+					}
+					else
+						mCommandQueue->queue(std::forward<T>(commandCallback));
+				}
+
+				mCommandReadyCondition.notify_all();
+
+				if (blockUntilComplete)
+					blockUntilCommandCompleted(commandId);
+			}
+		}
 
 		/**
 		 * Called once every frame.
@@ -32,6 +32,11 @@ namespace bs
 	/**
 	 * Tracks GameObject creation and destructions. Also resolves GameObject references from GameObject handles.
 	 *
+	 * Objects are stored in a generational slot map. A newly assigned instance ID encodes the index of the object's slot
+	 * in its lower 32 bits and the slot's generation in its upper 32 bits, so registration, lookup and removal are O(1)
+	 * and don't allocate. Generation of a slot is incremented whenever the slot is freed, ensuring IDs are never reused.
+	 * Objects that were given a different ID through remapId() are located through a separate hash map.
+	 *
 	 * @note	Sim thread only.
 	 */
 	class BS_CORE_EXPORT GameObjectManager : public Module<GameObjectManager>
@@ -43,6 +48,14 @@ namespace bs
 			GameObjectHandleBase handle;
 		};
 
+		/** Entry in the object slot map. */
+		struct ObjectSlot
+		{
+			UINT64 id; /**< Instance ID of the object occupying the slot, or 0 if the slot is free. */
+			UINT32 generation; /**< Incremented whenever the slot is freed. Never zero. */
+			UINT32 index; /**< Index of the object in mObjects if occupied, or index of the next free slot if free. */
+		};
+
 	public:
 		GameObjectManager();
 		~GameObjectManager();
@@ -137,14 +150,28 @@ namespace bs
 		UINT32 getDeserializationFlags() const { return mGODeserializationMode; }
 
 	private:
-		UINT64 mNextAvailableID; // 0 is not a valid ID
-		Map<UINT64, GameObjectHandleBase> mObjects;
-		Map<UINT64, GameObjectHandleBase> mQueuedForDestroy;
+		/** Returns the index of the slot occupied by the object with the specified ID, or -1 if no such object exists. */
+		UINT32 findSlot(UINT64 id) const;
+
+		/** Finds a free slot (or creates a new one) and assigns it a new unique instance ID. Returns the slot index. */
+		UINT32 allocateSlot();
+
+		/** Removes the object occupying the specified slot, and releases the slot. */
+		void freeSlot(UINT32 slotIdx);
+
+		Vector<ObjectSlot> mSlots;
+		UINT32 mNextFreeSlot; // -1 if no free slots
+		Vector<GameObjectHandleBase> mObjects; // Densely packed, in no particular order
+		Vector<UINT32> mObjectSlots; // Slot index for each entry in mObjects
+		UnorderedMap<UINT64, UINT32> mRemappedIds; // Slots of objects whose IDs don't encode their slot index
+
+		Vector<GameObjectHandleBase> mQueuedForDestroy;
+		UnorderedSet<UINT64> mQueuedForDestroyIds;
 
 		GameObject* mActiveDeserializedObject;
 		bool mIsDeserializationActive;
-		Map<UINT64, UINT64> mIdMapping;
-		Map<UINT64, SPtr<GameObjectHandleData>> mUnresolvedHandleData;
+		UnorderedMap<UINT64, UINT64> mIdMapping;
+		UnorderedMap<UINT64, SPtr<GameObjectHandleData>> mUnresolvedHandleData;
 		Vector<UnresolvedHandle> mUnresolvedHandles;
 		Vector<std::function<void()>> mEndCallbacks;
 		UINT32 mGODeserializationMode;
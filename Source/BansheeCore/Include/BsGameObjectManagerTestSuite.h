@@ -0,0 +1,26 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#pragma once
+
+#include "BsCorePrerequisites.h"
+#include "BsTestSuite.h"
+
+namespace bs
+{
+	class BS_CORE_EXPORT GameObjectManagerTestSuite : public TestSuite
+	{
+	public:
+		GameObjectManagerTestSuite();
+
+		void startUp() override;
+		void shutDown() override;
+
+	private:
+		void testRegister_unique_ids();
+		void testUnregister_dense();
+		void testReuse_new_generation();
+		void testRemap();
+		void testRemap_slot_reused();
+		void testQueueForDestroy_once();
+	};
+}
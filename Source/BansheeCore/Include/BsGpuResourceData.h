@@ -66,6 +66,26 @@ namespace bs
 		 */
 		void setExternalBuffer(UINT8* data);
 
+		/**
+		 * Makes the internal data pointer point to memory owned by a data stream, such as a file mapped into memory. No
+		 * copying is done. A reference to the stream is kept for as long as the data is used.
+		 *
+		 * @note	If any internal data is allocated, it is freed.
+		 */
+		void setExternalBuffer(UINT8* data, const SPtr<DataStream>& owner);
+
+		/**
+		 * If the data references memory owned by a data stream, copies the data into a newly allocated internal buffer and
+		 * releases the reference to the stream. Otherwise does nothing. 
+		 */
+		void copyToInternalBuffer();
+
+		/**
+		 * If the data references a file mapped into memory, returns the path of the file and the offset of the data from
+		 * the start of the file, allowing the data to be read again after it has been released. Returns false otherwise.
+		 */
+		bool getSourceFileLocation(Path& filePath, UINT64& offset) const;
+
 		/** Checks if the internal buffer is locked due to some other thread using it. */
 		bool isLocked() const { return mLocked; }
 
@@ -84,6 +104,7 @@ namespace bs
 
 	private:
 		UINT8* mData;
+		SPtr<DataStream> mDataOwner;
 		bool mOwnsData;
 		mutable bool mLocked;
 
@@ -128,6 +128,9 @@ namespace bs
 		/** Retrieves a core implementation of a mesh usable only from the core thread. */
 		SPtr<ct::Mesh> getCore() const;
 
+		/** @copydoc Resource::getMemoryUsage */
+		void getMemoryUsage(UINT64& cpuBytes, UINT64& gpuBytes) const override;
+
 		/**	Returns a dummy mesh, containing just one triangle. Don't modify the returned mesh. */
 		static HMesh dummy();
 
@@ -162,6 +162,35 @@ namespace bs
 		 */
 		bool getImportRootMotion() const { return mImportRootMotion; }
 
+		/**	
+		 * Enables or disables compression of imported animation clips. Compressed clips use significantly less memory and
+		 * are faster to evaluate, at the cost of some precision. Compressed clips don't provide direct access to their
+		 * position, rotation and scale curves.
+		 *
+		 * @see	AnimationClip::compress
+		 */
+		void setAnimationCompression(bool enabled) { mCompressAnimation = enabled; }
+
+		/**	
+		 * Checks is animation clip compression enabled.
+		 *
+		 * @see	setAnimationCompression
+		 */
+		bool getAnimationCompression() const { return mCompressAnimation; }
+
+		/**	
+		 * Sets the maximum error allowed when removing redundant keyframes during animation clip compression. Applies to
+		 * individual components of bone positions, rotations (quaternions) and scales.
+		 */
+		void setAnimationCompressionError(float error) { mAnimationCompressionError = error; }
+
+		/**	
+		 * Returns the maximum error allowed when removing redundant keyframes during animation clip compression. 
+		 *
+		 * @see	setAnimationCompressionError
+		 */
+		float getAnimationCompressionError() const { return mAnimationCompressionError; }
+
 		/** Creates a new import options object that allows you to customize how are meshes imported. */
 		static SPtr<MeshImportOptions> create();
 
@@ -174,6 +203,8 @@ namespace bs
 		bool mImportAnimation;
 		bool mReduceKeyFrames;
 		bool mImportRootMotion;
+		bool mCompressAnimation;
+		float mAnimationCompressionError;
 		float mImportScale;
 		CollisionMeshType mCollisionMeshType;
 		Vector<AnimationSplitInfo> mAnimationSplits;
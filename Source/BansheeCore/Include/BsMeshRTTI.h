@@ -52,6 +52,11 @@ namespace bs
 		void onDeserializationEnded(IReflectable* obj, const UnorderedMap<String, UINT64>& params) override
 		{
 			Mesh* mesh = static_cast<Mesh*>(obj);
+
+			// CPU cached data lives as long as the mesh, so it shouldn't keep referencing the file it was loaded from
+			if ((mesh->mUsage & MU_CPUCACHED) != 0 && mesh->mCPUData != nullptr)
+				mesh->mCPUData->copyToInternalBuffer();
+
 			mesh->initialize();
 		}
 
@@ -52,6 +52,16 @@ namespace bs
 
 		void setData(PixelData* obj, const SPtr<DataStream>& value, UINT32 size)
 		{
+			// Reference mapped files directly instead of copying, the mapping is released once the data is no longer used
+			if (value->isMapped())
+			{
+				MemoryDataStream* memStream = static_cast<MemoryDataStream*>(value.get());
+				obj->setExternalBuffer(memStream->getCurrentPtr(), value);
+
+				value->skip(size);
+				return;
+			}
+
 			obj->allocateInternalBuffer(size);
 			value->read(obj->getData(), size);
 		}
@@ -0,0 +1,25 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#pragma once
+
+#include "BsCorePrerequisites.h"
+#include "BsTestSuite.h"
+
+namespace bs
+{
+	class BS_CORE_EXPORT PixelUtilTestSuite : public TestSuite
+	{
+	public:
+		PixelUtilTestSuite();
+
+		void startUp() override;
+		void shutDown() override;
+
+	private:
+		void testConvert_matches_scalar();
+		void testConvert_row_pitch();
+		void testGenMipmaps_uniform_blocks();
+		void testGenMipmaps_average();
+		void testParallel_matches_serial();
+	};
+}
@@ -77,13 +77,14 @@ namespace bs
 		 */
 		struct ProfileSample
 		{
-			ProfileSample(double _time, UINT64 _numAllocs, UINT64 _numFrees)
-				:time(_time), numAllocs(_numAllocs), numFrees(_numFrees)
+			ProfileSample(double _time, UINT64 _numAllocs, UINT64 _numFrees, UINT64 _numAllocBytes)
+				:time(_time), numAllocs(_numAllocs), numFrees(_numFrees), numAllocBytes(_numAllocBytes)
 			{ }
 
 			double time;
 			UINT64 numAllocs;
 			UINT64 numFrees;
+			UINT64 numAllocBytes;
 		};
 
 		/**
@@ -95,13 +96,14 @@ namespace bs
 		 */
 		struct PreciseProfileSample
 		{
-			PreciseProfileSample(UINT64 _cycles, UINT64 _numAllocs, UINT64 _numFrees)
-				:cycles(_cycles), numAllocs(_numAllocs), numFrees(_numFrees)
+			PreciseProfileSample(UINT64 _cycles, UINT64 _numAllocs, UINT64 _numFrees, UINT64 _numAllocBytes)
+				:cycles(_cycles), numAllocs(_numAllocs), numFrees(_numFrees), numAllocBytes(_numAllocBytes)
 			{ }
 
 			UINT64 cycles;
 			UINT64 numAllocs;
 			UINT64 numFrees;
+			UINT64 numAllocBytes;
 		};
 
 		/**	Contains basic (time based) profiling data contained in a profiling block. */
@@ -129,6 +131,7 @@ namespace bs
 
 			UINT64 memAllocs;
 			UINT64 memFrees;
+			UINT64 memAllocBytes;
 		};
 
 		/**	Contains precise (CPU cycle based) profiling data contained in a profiling block. */
@@ -156,6 +159,7 @@ namespace bs
 
 			UINT64 memAllocs;
 			UINT64 memFrees;
+			UINT64 memAllocBytes;
 		};
 
 		/**
@@ -337,6 +341,7 @@ namespace bs
 
 			UINT64 memAllocs; /**< Number of memory allocations that happened within the block. */
 			UINT64 memFrees; /**< Number of memory deallocations that happened within the block. */
+			UINT64 memAllocBytes; /**< Number of bytes allocated within the block. */
 
 			double avgTimeMs; /**< Average time it took to execute the block, per call. In milliseconds. */
 			double maxTimeMs; /**< Maximum time of a single call in the block. In milliseconds. */
@@ -369,6 +374,7 @@ namespace bs
 
 			UINT64 memAllocs; /**< Number of memory allocations that happened within the block. */
 			UINT64 memFrees; /**< Number of memory deallocations that happened within the block. */
+			UINT64 memAllocBytes; /**< Number of bytes allocated within the block. */
 
 			UINT64 avgCycles; /**< Average number of cycles it took to execute the block, per call. */
 			UINT64 maxCycles; /**< Maximum number of cycles of a single call in the block. */
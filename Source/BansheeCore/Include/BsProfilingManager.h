@@ -16,6 +16,12 @@ namespace bs
 	struct ProfilerReport
 	{
 		CPUProfilerReport cpuReport;
+
+		/** 
+		 * Memory usage per allocator category and tag, as reported by MemAllocProfiler. Memory is tracked for all threads 
+		 * at once, so this is only populated for the sim thread. Empty if memory tracking is disabled.
+		 */
+		MemoryStatsList memoryStats;
 	};
 
 	/**	Type of thread used by the profiler. */
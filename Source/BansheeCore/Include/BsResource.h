@@ -31,6 +31,15 @@ namespace bs
 		/**	Returns whether or not this resource is allowed to be asynchronously loaded. */
 		virtual bool allowAsyncLoading() const { return true; }
 
+		/**
+		 * Returns an estimate of the memory used by the resource, in bytes. Used by Resources for keeping loaded 
+		 * resources within the residency budget. Resources that report no memory usage are never evicted.
+		 *
+		 * @param[out]	cpuBytes	Amount of system memory used by the resource.
+		 * @param[out]	gpuBytes	Amount of video memory used by the resource.
+		 */
+		virtual void getMemoryUsage(UINT64& cpuBytes, UINT64& gpuBytes) const { cpuBytes = 0; gpuBytes = 0; }
+
 	protected:
 		friend class Resources;
 		friend class ResourceHandleBase;
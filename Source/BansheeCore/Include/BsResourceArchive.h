@@ -0,0 +1,120 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#pragma once
+
+#include "BsCorePrerequisites.h"
+
+namespace bs
+{
+	/** @addtogroup Resources-Internal
+	 *  @{
+	 */
+
+	/** Determines how is a resource stored in a resource archive. */
+	enum class ResourceArchiveCompression
+	{
+		/** Resource is stored as is, and is referenced directly from the mapped archive when loaded. */
+		None,
+		/** Resource is compressed using Compression, and decompressed into a separate buffer when loaded. */
+		LZ
+	};
+
+	/** Information about a single resource stored in a resource archive. */
+	struct ResourceArchiveEntry
+	{
+		String uuid;
+		UINT64 offset; /**< Offset of the resource data from the start of the archive, in bytes. */
+		UINT64 size; /**< Size of the resource data as stored in the archive, in bytes. */
+		UINT64 uncompressedSize; /**< Size of the resource data once decompressed, in bytes. */
+		ResourceArchiveCompression compression;
+		bool allowAsyncLoading; /**< Determines can the resource be loaded asynchronously. */
+		Vector<String> dependencies; /**< UUIDs of all resources the resource depends on. */
+	};
+
+	/**
+	 * A single file containing multiple resources, and an index mapping resource UUIDs to their location in the file and
+	 * their dependencies. Allows many resources to be loaded from a single memory mapped file, instead of each resource 
+	 * requiring its own file. Register the archive with Resources::registerResourceArchive() so its resources can be
+	 * loaded by UUID.
+	 *
+	 * Each resource is stored in the same format as the files written by Resources::save(), optionally compressed. Data 
+	 * of each resource starts at an offset aligned to the alignment the archive was created with. Use 
+	 * ResourceArchiveWriter to create archives.
+	 *
+	 * @note	Thread safe.
+	 */
+	class BS_CORE_EXPORT ResourceArchive
+	{
+		struct ConstructPrivately {};
+	public:
+		ResourceArchive(const ConstructPrivately& dummy, const Path& path, const SPtr<MemoryDataStream>& data);
+
+		/** Returns the path of the archive file. */
+		const Path& getPath() const { return mPath; }
+
+		/** Returns the number of resources stored in the archive. */
+		UINT32 getNumEntries() const { return (UINT32)mEntries.size(); }
+
+		/** Returns information about the resource with the provided UUID, or null if the archive doesn't contain it. */
+		const ResourceArchiveEntry* findEntry(const String& uuid) const;
+
+		/**
+		 * Opens a stream for reading the data of the provided resource. Uncompressed resources reference the mapped 
+		 * archive directly, while compressed resources are decompressed into a new buffer. Returns null if the data 
+		 * can't be read.
+		 */
+		SPtr<DataStream> openEntry(const ResourceArchiveEntry& entry) const;
+
+		/** Opens an archive previously created with ResourceArchiveWriter. Returns null if the archive isn't valid. */
+		static SPtr<ResourceArchive> open(const Path& path);
+
+	private:
+		/** Parses the index of the archive. Returns false if the index is malformed. */
+		bool readIndex(UINT64 offset, UINT64 size, UINT32 numEntries);
+
+		Path mPath;
+		SPtr<MemoryDataStream> mData;
+		UnorderedMap<String, ResourceArchiveEntry> mEntries;
+	};
+
+	/** Creates a resource archive by packing together resource files saved by Resources::save(). */
+	class BS_CORE_EXPORT ResourceArchiveWriter
+	{
+	public:
+		/**
+		 * Creates a new archive file, overwriting any existing file.
+		 *
+		 * @param[in]	path		Path of the archive file to create.
+		 * @param[in]	alignment	Alignment of the data of each resource, in bytes. The default page-sized alignment
+		 *							ensures data blocks referenced directly from the mapped archive start on a page 
+		 *							boundary.
+		 */
+		ResourceArchiveWriter(const Path& path, UINT32 alignment = 4096);
+		~ResourceArchiveWriter();
+
+		/**
+		 * Adds a resource to the archive.
+		 *
+		 * @param[in]	uuid			UUID of the resource.
+		 * @param[in]	resourcePath	Path to a resource file saved by Resources::save().
+		 * @param[in]	compression		Determines how to store the resource. Compressed resources are stored uncompressed
+		 *								if compression doesn't reduce their size.
+		 * @return						True if the resource was added, false if its file couldn't be read or a resource 
+		 *								with the same UUID was already added.
+		 */
+		bool add(const String& uuid, const Path& resourcePath, 
+			ResourceArchiveCompression compression = ResourceArchiveCompression::None);
+
+		/** Writes the index and closes the archive file. Called automatically on destruction. */
+		void close();
+
+	private:
+		SPtr<DataStream> mOutput;
+		UINT32 mAlignment;
+		UINT64 mOffset;
+		Vector<ResourceArchiveEntry> mEntries;
+		UnorderedSet<String> mUUIDs;
+	};
+
+	/** @} */
+}
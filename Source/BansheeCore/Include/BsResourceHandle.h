@@ -20,7 +20,7 @@ namespace bs
 		SPtr<Resource> mPtr;
 		String mUUID;
 		bool mIsCreated;	
-		UINT32 mRefCount;
+		std::atomic<UINT32> mRefCount;
 	};
 
 	/**
@@ -151,9 +151,7 @@ namespace bs
 		{ 
 			if (mData)
 			{
-				mData->mRefCount--;
-
-				if (mData->mRefCount == 0)
+				if (mData->mRefCount.fetch_sub(1) == 1)
 					destroy();
 			}
 		};
@@ -39,7 +39,9 @@ namespace bs
 			{
 				HResource loadedResource = gResources()._getResourceHandle(resourceHandle->mData->mUUID);
 
-				resourceHandle->releaseRef();
+				// Temporary data created by newRTTIObject() is never registered with Resources, so drop it directly instead
+				// of through releaseRef(). Otherwise destroy() would block waiting on it if the resource is still loading.
+				resourceHandle->mData->mRefCount--;
 				resourceHandle->mData = loadedResource.mData;
 				resourceHandle->addRef();
 			}
@@ -58,12 +60,14 @@ namespace bs
 
 		SPtr<IReflectable> newRTTIObject() override
 		{
-			SPtr<TResourceHandleBase<false>> obj = bs_shared_ptr<TResourceHandleBase<false>>
-				(new (bs_alloc<TResourceHandleBase<false>>()) TResourceHandleBase<false>());
+			// Created as a full handle so the reference acquired in onDeserializationEnded() is released along with it
+			SPtr<HResource> handle = bs_shared_ptr<HResource>(new (bs_alloc<HResource>()) HResource());
+
+			TResourceHandleBase<false>* obj = handle.get();
 			obj->mData = bs_shared_ptr_new<ResourceHandleData>();
 			obj->mData->mRefCount++;
 
-			return obj;
+			return handle;
 		}
 	};
 
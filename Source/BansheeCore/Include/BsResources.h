@@ -39,6 +39,67 @@ namespace bs
 	typedef Flags<ResourceLoadFlag> ResourceLoadFlags;
 	BS_FLAGS_OPERATORS(ResourceLoadFlag);
 
+	/** 
+	 * Determines in which order asynchronously loaded resources are processed. Resources of higher priority are always 
+	 * read before resources of lower priority, and their deserialization is scheduled with a higher task priority.
+	 */
+	enum class ResourceLoadPriority
+	{
+		/** Something is waiting for the resource to finish loading. */
+		Blocking,
+		/** Resource is expected to be needed soon (e.g. it is close to becoming visible). */
+		VisibleSoon,
+		/** Resource is not expected to be needed any time soon (e.g. pre-loading). */
+		Background,
+		Count // Keep last
+	};
+
+	/** Stages every asynchronously loaded resource goes through, in order. */
+	enum class ResourceLoadStage
+	{
+		/** Resource file is mapped and read, and its dependencies are queued for loading. */
+		Read,
+		/** Resource object is deserialized from the file contents. */
+		Deserialize,
+		/** Resource is registered as loaded and dependant resources are notified. */
+		PostProcess,
+		/** Core thread initializes the resource's core thread counterpart (e.g. uploads it to the GPU). */
+		Upload,
+		Count // Keep last
+	};
+
+	/** Information about the state of the resource loading pipeline. */
+	struct ResourceLoadStats
+	{
+		/** Number of resources that completed each stage. */
+		UINT64 numProcessed[(UINT32)ResourceLoadStage::Count];
+
+		/** 
+		 * Total time spent in each stage, in microseconds. For the upload stage this is the time between the resource 
+		 * being deserialized and the core thread finishing its initialization.
+		 */
+		UINT64 totalTimeUs[(UINT32)ResourceLoadStage::Count];
+
+		/** Number of resources currently queued for, or being processed by, each stage. */
+		UINT32 numQueued[(UINT32)ResourceLoadStage::Count];
+	};
+
+	/** Information about the memory used by loaded resources, and about resources evicted to stay within the budget. */
+	struct ResourceResidencyStats
+	{
+		UINT64 cpuBudget; /**< Maximum amount of system memory loaded resources may use, in bytes. Zero if unlimited. */
+		UINT64 gpuBudget; /**< Maximum amount of video memory loaded resources may use, in bytes. Zero if unlimited. */
+		UINT64 cpuBytes; /**< Amount of system memory used by loaded resources, in bytes. */
+		UINT64 gpuBytes; /**< Amount of video memory used by loaded resources, in bytes. */
+		UINT32 numResident; /**< Number of loaded resources. */
+		UINT32 numEvictable; /**< Number of loaded resources not referenced outside of the resource system. */
+
+		UINT64 numEvictions; /**< Number of resources evicted since startup. */
+		UINT64 cpuBytesEvicted; /**< Amount of system memory freed by evictions since startup, in bytes. */
+		UINT64 gpuBytesEvicted; /**< Amount of video memory freed by evictions since startup, in bytes. */
+		UINT64 numReloads; /**< Number of evicted resources that were loaded again since startup. */
+	};
+
 	/**
 	 * Manager for dealing with all engine resources. It allows you to save new resources and load existing ones.
 	 *
@@ -50,15 +111,30 @@ namespace bs
 		struct LoadedResourceData
 		{
 			LoadedResourceData()
-				:numInternalRefs(0)
+				:numInternalRefs(0), lastUsedFrame(0), cpuBytes(0), gpuBytes(0), memoryUsageKnown(false)
 			{ }
 
 			LoadedResourceData(const WeakResourceHandle<Resource>& resource)
-				:resource(resource), numInternalRefs(0)
+				:resource(resource), numInternalRefs(0), lastUsedFrame(0), cpuBytes(0), gpuBytes(0), 
+				memoryUsageKnown(false)
 			{ }
 
 			WeakResourceHandle<Resource> resource;
 			UINT32 numInternalRefs;
+
+			UINT64 lastUsedFrame; /**< Last frame the resource was referenced from outside of the resource system. */
+			UINT64 cpuBytes;
+			UINT64 gpuBytes;
+			bool memoryUsageKnown;
+		};
+
+		/** Loaded resource that can be evicted if the resources are over the memory budget. */
+		struct EvictionCandidate
+		{
+			WeakResourceHandle<Resource> resource;
+			UINT64 lastUsedFrame;
+			UINT64 cpuBytes;
+			UINT64 gpuBytes;
 		};
 
 		/** Information about a resource that's currently being loaded. */
@@ -70,11 +146,45 @@ namespace bs
 
 			LoadedResourceData resData;
 			SPtr<Resource> loadedData;
-			UINT32 remainingDependencies;
+			std::atomic<UINT32> remainingDependencies; /**< Decremented by dependencies without holding this load's lock. */
 			Vector<HResource> dependencies;
 			bool notifyImmediately;
 		};
 
+		/** 
+		 * Loads in progress for a subset of resources, along with the loads waiting on those resources. Split by the
+		 * resource UUID so that loads of unrelated resources don't contend for the same lock.
+		 */
+		struct InProgressShard
+		{
+			Mutex mutex;
+			UnorderedMap<String, ResourceLoadData*> resources; /**< Resources that are being asynchronously loaded. */
+			UnorderedMap<String, Vector<ResourceLoadData*>> dependantLoads; /**< Loads to notify once a dependency loads. */
+		};
+
+		/** Number of shards the in-progress load data is split into. */
+		static const UINT32 NUM_IN_PROGRESS_SHARDS = 16;
+
+		/** Resource waiting to be read by the loading pipeline. */
+		struct ReadRequest
+		{
+			String uuid;
+			Path filePath;
+			SPtr<ResourceArchive> archive; /**< Archive containing the resource, if not stored in its own file. */
+			String sortKey; /**< Location of the resource data, used for grouping reads by their location on disk. */
+			HResource resource;
+			ResourceLoadFlags loadFlags;
+		};
+
+		/** Resource whose file was read by the loading pipeline, waiting to be deserialized. */
+		struct DeserializeRequest
+		{
+			Path filePath;
+			HResource resource;
+			SPtr<DataStream> stream; /**< File contents, positioned after the saved resource data. */
+			bool keepSourceData;
+		};
+
 	public:
 		Resources();
 		~Resources();
@@ -84,7 +194,9 @@ namespace bs
 		 * synchronously.
 		 *			
 		 * @param[in]	filePath	File path to the resource to load. This can be absolute or relative to the working 
-		 *							folder.
+		 *							folder. If a registered manifest maps the path to a resource stored in a registered
+		 *							resource archive, the resource is loaded from the archive and the file doesn't need
+		 *							to exist.
 		 * @param[in]	loadFlags	Flags used to control the load process.
 		 *			
 		 * @see		release(ResourceHandleBase&), unloadAllUnused()
@@ -119,16 +231,21 @@ namespace bs
 		 *
 		 * @param[in]	filePath	Full pathname of the file.
 		 * @param[in]	loadFlags	Flags used to control the load process.
+		 * @param[in]	priority	Determines the order in which resources are loaded. Dependencies are loaded with the
+		 *							same priority as the resource referencing them. Resources being waited on through
+		 *							ResourceHandle<T>::blockUntilLoaded are automatically promoted to the highest priority.
 		 *			
 		 * @see		load(const Path&, ResourceLoadFlags)
 		 */
-		HResource loadAsync(const Path& filePath, ResourceLoadFlags loadFlags = ResourceLoadFlag::Default);
+		HResource loadAsync(const Path& filePath, ResourceLoadFlags loadFlags = ResourceLoadFlag::Default, 
+			ResourceLoadPriority priority = ResourceLoadPriority::VisibleSoon);
 
 		/** @copydoc loadAsync */
 		template <class T>
-		ResourceHandle<T> loadAsync(const Path& filePath, ResourceLoadFlags loadFlags = ResourceLoadFlag::Default)
+		ResourceHandle<T> loadAsync(const Path& filePath, ResourceLoadFlags loadFlags = ResourceLoadFlag::Default, 
+			ResourceLoadPriority priority = ResourceLoadPriority::VisibleSoon)
 		{
-			return static_resource_cast<T>(loadAsync(filePath, loadFlags));
+			return static_resource_cast<T>(loadAsync(filePath, loadFlags, priority));
 		}
 
 		/**
@@ -138,10 +255,12 @@ namespace bs
 		 * @param[in]	async		If true resource will be loaded asynchronously. Handle to non-loaded resource will be
 		 *							returned immediately while loading will continue in the background.		
 		 * @param[in]	loadFlags	Flags used to control the load process.
+		 * @param[in]	priority	Determines the order in which resources are loaded, if loading asynchronously.
 		 *													
 		 * @see		load(const Path&, bool)
 		 */
-		HResource loadFromUUID(const String& uuid, bool async = false, ResourceLoadFlags loadFlags = ResourceLoadFlag::Default);
+		HResource loadFromUUID(const String& uuid, bool async = false, ResourceLoadFlags loadFlags = ResourceLoadFlag::Default,
+			ResourceLoadPriority priority = ResourceLoadPriority::VisibleSoon);
 
 		/**
 		 * Releases an internal reference to the resource held by the resources system. This allows the resource to be 
@@ -162,6 +281,23 @@ namespace bs
 		 */
 		void unloadAllUnused();
 
+		/**
+		 * Sets the maximum amount of memory loaded resources may use. When over budget, resources that aren't referenced
+		 * outside of the resource system are unloaded, least recently used first. Only resources that can be loaded
+		 * again by their UUID (i.e. that are registered in a manifest or an archive) are unloaded. Existing handles to 
+		 * unloaded resources become valid again once the resource is loaded again (e.g. by calling 
+		 * load(const WeakResourceHandle<Resource>&, ResourceLoadFlags)).
+		 *
+		 * @param[in]	cpuBytes	Maximum amount of system memory used by resources, in bytes. Zero for unlimited.
+		 * @param[in]	gpuBytes	Maximum amount of video memory used by resources, in bytes. Zero for unlimited.
+		 *
+		 * @note	Memory usage is as reported by Resource::getMemoryUsage(). Budget is enforced once per frame.
+		 */
+		void setResidencyBudget(UINT64 cpuBytes, UINT64 gpuBytes);
+
+		/** Returns information about memory used by loaded resources, and about evicted resources. */
+		ResourceResidencyStats getResidencyStats() const;
+
 		/**
 		 * Saves the resource at the specified location.
 		 *
@@ -207,6 +343,15 @@ namespace bs
 		 */
 		Vector<String> getDependencies(const Path& filePath);
 
+		/**
+		 * Returns a list of dependencies of the resource with the specified UUID. For resources stored in a registered
+		 * archive the list is retrieved from the archive index, otherwise it is read from the resource file.
+		 *
+		 * @param[in]	uuid	UUID of the resource to get dependencies for.
+		 * @return				List of dependencies represented as UUIDs. Empty if the resource cannot be found.
+		 */
+		Vector<String> getDependenciesFromUUID(const String& uuid);
+
 		/**
 		 * Checks is the resource with the specified UUID loaded.
 		 *
@@ -231,6 +376,15 @@ namespace bs
 		/**	Unregisters a resource manifest previously registered with registerResourceManifest(). */
 		void unregisterResourceManifest(const SPtr<ResourceManifest>& manifest);
 
+		/**
+		 * Registers a resource archive whose resources can then be loaded by their UUIDs. When resolving a UUID, archives
+		 * take priority over manifests, and archives registered later take priority over those registered earlier.
+		 */
+		void registerResourceArchive(const SPtr<ResourceArchive>& archive);
+
+		/**	Unregisters a resource archive previously registered with registerResourceArchive(). */
+		void unregisterResourceArchive(const SPtr<ResourceArchive>& archive);
+
 		/**
 		 * Allows you to retrieve resource manifest containing UUID <-> file path mapping that is used when resolving 
 		 * resource references.
@@ -248,6 +402,17 @@ namespace bs
 		/** Attempts to retrieve UUID from the provided file path. Returns true if successful, false otherwise. */
 		bool getUUIDFromFilePath(const Path& path, String& uuid) const;
 
+		/** Returns statistics about the resource loading pipeline, including the time spent in each loading stage. */
+		ResourceLoadStats getLoadStats() const;
+
+		/** 
+		 * Records which resources are in use and unloads least recently used resources if over the residency budget.
+		 * Called once per frame.
+		 *
+		 * @note	Internal method.
+		 */
+		void _updateResidency();
+
 		/**
 		 * Called when the resource has been successfully loaded. 
 		 *
@@ -300,33 +465,131 @@ namespace bs
 		/**
 		 * Starts resource loading or returns an already loaded resource. Both UUID and filePath must match the	same 
 		 * resource, although you may provide an empty path in which case the resource will be retrieved from memory if its
-		 * currently loaded.
+		 * currently loaded. If @p archive is provided, the resource is loaded from the archive instead of the file path.
 		 */
-		HResource loadInternal(const String& UUID, const Path& filePath, bool synchronous, ResourceLoadFlags loadFlags);
+		HResource loadInternal(const String& UUID, const Path& filePath, const SPtr<ResourceArchive>& archive, 
+			bool synchronous, ResourceLoadFlags loadFlags, ResourceLoadPriority priority = ResourceLoadPriority::VisibleSoon);
 
-		/** Performs actually reading and deserializing of the resource file. Called from various worker threads. */
-		SPtr<Resource> loadFromDiskAndDeserialize(const Path& filePath, bool loadWithSaveData);
+		/** 
+		 * Opens a stream for reading the resource data, either from the archive if one is provided, or from the file. The
+		 * stream is positioned at the saved resource data, followed by the resource. Returns null if the data cannot be
+		 * opened.
+		 */
+		SPtr<DataStream> openResourceStream(const String& uuid, const Path& filePath, const SPtr<ResourceArchive>& archive);
+
+		/** Returns the registered archive containing the resource with the provided UUID, or null if there is none. */
+		SPtr<ResourceArchive> findArchive(const String& uuid) const;
+
+		/** Deserializes the resource using a decoder positioned after the resource's saved resource data. */
+		SPtr<Resource> deserialize(FileDecoder& decoder, const Path& filePath, bool loadWithSaveData);
 
 		/**	Triggered when individual resource has finished loading. */
 		void loadComplete(HResource& resource);
 
-		/**	Callback triggered when the task manager is ready to process the loading task. */
-		void loadCallback(const Path& filePath, HResource& resource, bool loadWithSaveData);
+		/**	Callback triggered when a synchronously loaded resource is ready to be read and deserialized. */
+		void loadCallback(const Path& filePath, const SPtr<ResourceArchive>& archive, HResource& resource, 
+			bool loadWithSaveData);
+
+		/** 
+		 * Marks the resource as deserialized, and completes its load if it has no outstanding dependencies. Called from
+		 * the final stage of both synchronous and asynchronous loads.
+		 */
+		void finishDeserialize(HResource& resource, const SPtr<Resource>& rawResource);
+
+		/** Queues a request to read the resource file on the loading pipeline. */
+		void queueRead(const ReadRequest& request, ResourceLoadPriority priority);
+
+		/** 
+		 * Starts new read tasks if there are pending read requests and the deserialize stage isn't full. Must be called 
+		 * with mPipelineMutex locked.
+		 */
+		void startReadTasks();
+
+		/** 
+		 * Worker method of a read task. Processes batches of read requests, highest priority first, until there are no
+		 * requests left or the deserialize stage is full.
+		 */
+		void readTaskWorker();
+
+		/** 
+		 * Reads the resource file and its saved resource data, queues the resource's dependencies for loading with the 
+		 * provided priority, and queues the resource for deserialization.
+		 */
+		void readResource(const ReadRequest& request, ResourceLoadPriority priority);
+
+		/** Deserializes a resource read by readResource() and completes its load if possible. */
+		void deserializeResource(const DeserializeRequest& request);
+
+		/** Worker method of a deserialize task. */
+		void deserializeTaskWorker(const DeserializeRequest& request);
+
+		/** 
+		 * Records the time until the core thread initializes the core counterpart of the provided resource, if it has
+		 * one.
+		 */
+		void trackUpload(const SPtr<Resource>& resource);
+
+		/** Executed on the core thread after the core counterpart of a loaded resource has been initialized. */
+		void uploadComplete(const Timer& timer);
+
+		/** 
+		 * Promotes a resource whose file is still waiting to be read to ResourceLoadPriority::Blocking. Called when
+		 * something starts waiting on the resource.
+		 */
+		void prioritizeLoad(const String& uuid);
+
+		/** Adds the provided time to the statistics of the specified loading stage. */
+		void recordStage(ResourceLoadStage stage, UINT64 timeUs);
 
 		/**	Destroys a resource, freeing its memory. */
 		void destroy(ResourceHandleBase& resource);
 
+		/** 
+		 * Returns the in-progress shard responsible for the resource with the provided UUID. Shards are locked before
+		 * mLoadedResourceMutex, and in order of their indices if more than one is needed at once.
+		 */
+		InProgressShard& getInProgressShard(const String& uuid);
+
+		/** Returns the index of the in-progress shard responsible for the resource with the provided UUID. */
+		static UINT32 getInProgressShardIdx(const String& uuid);
+
+		/** 
+		 * Frees a deserialize stage slot reserved by a read task, for a resource that was read but not queued for 
+		 * deserialization, or whose deserialization finished.
+		 */
+		void releaseDeserializeSlot();
+
+		/** 
+		 * Prepares an existing handle to a resource that is about to start loading. Must be called with 
+		 * mLoadedResourceMutex held.
+		 */
+		void prepareHandleForLoad(HResource& handle);
+
 	private:
 		Vector<SPtr<ResourceManifest>> mResourceManifests;
+		Vector<SPtr<ResourceArchive>> mResourceArchives;
 		SPtr<ResourceManifest> mDefaultResourceManifest;
 
-		Mutex mInProgressResourcesMutex;
-		Mutex mLoadedResourceMutex;
+		mutable Mutex mManifestMutex;
+		mutable Mutex mLoadedResourceMutex;
 
 		UnorderedMap<String, WeakResourceHandle<Resource>> mHandles;
 		UnorderedMap<String, LoadedResourceData> mLoadedResources;
-		UnorderedMap<String, ResourceLoadData*> mInProgressResources; // Resources that are being asynchronously loaded
-		UnorderedMap<String, Vector<ResourceLoadData*>> mDependantLoads; // Allows dependency to be notified when a dependant is loaded
+		InProgressShard mInProgressShards[NUM_IN_PROGRESS_SHARDS];
+
+		// Loading pipeline
+		mutable Mutex mPipelineMutex;
+		Deque<ReadRequest> mReadQueues[(UINT32)ResourceLoadPriority::Count];
+		UINT32 mNumReadTasks;
+		UINT32 mNumQueuedDeserialize;
+
+		std::atomic<UINT64> mStageNumProcessed[(UINT32)ResourceLoadStage::Count];
+		std::atomic<UINT64> mStageTimeUs[(UINT32)ResourceLoadStage::Count];
+		std::atomic<UINT32> mNumQueuedUploads;
+
+		// Residency, protected by mLoadedResourceMutex
+		ResourceResidencyStats mResidencyStats;
+		UnorderedSet<String> mEvictedResources;
 	};
 
 	/** Provides easier access to Resources manager. */
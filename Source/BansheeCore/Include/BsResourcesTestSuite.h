@@ -0,0 +1,25 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#pragma once
+
+#include "BsCorePrerequisites.h"
+#include "BsTestSuite.h"
+
+namespace bs
+{
+	class BS_CORE_EXPORT ResourcesTestSuite : public TestSuite
+	{
+	public:
+		ResourcesTestSuite();
+
+		void startUp() override;
+		void shutDown() override;
+
+	private:
+		void testLoadAsync_dependencies();
+		void testLoadAsync_sync_load_in_progress();
+		void testResidency_evict_reload();
+
+		Path mFolder;
+	};
+}
@@ -5,6 +5,8 @@
 #include "BsCorePrerequisites.h"
 #include "BsModule.h"
 #include "BsGameObject.h"
+#include "BsComponent.h"
+#include "BsSceneTransformStorage.h"
 
 namespace bs
 {
@@ -63,6 +65,15 @@ namespace bs
 		HSceneObject sceneObject;
 	};
 
+	/** Types of core objects whose transforms the scene manager keeps in sync with their scene objects. */
+	enum class SceneCoreObjectType
+	{
+		Renderable,
+		Camera,
+		Light,
+		ReflectionProbe
+	};
+
 	/** Possible states components can be in. Controls which component callbacks are triggered. */
 	enum class ComponentState
 	{
@@ -71,6 +82,15 @@ namespace bs
 		Stopped /**< No component callbacks are being triggered. */
 	};
 
+	/** Phases of the frame in which component update methods are called. */
+	enum class ComponentUpdatePhase
+	{
+		PrePhysics, /**< Before the physics simulation. Calls Component::update(). */
+		PostPhysics, /**< After the physics simulation. Calls Component::postPhysicsUpdate(). */
+		Late, /**< After all other updates, before transforms are synced with the renderer. Calls Component::lateUpdate(). */
+		Count // Keep at end
+	};
+
 	/** Manages active SceneObjects and provides ways for querying and updating them or their components. */
 	class BS_CORE_EXPORT SceneManager : public Module<SceneManager>
 	{
@@ -97,8 +117,24 @@ namespace bs
 		/** Checks are the components currently in the Running state. */
 		bool isRunning() const { return mComponentState == ComponentState::Running; }
 
+		/**
+		 * Enables or disables batched transform updates. When enabled, a transform change on a scene object doesn't
+		 * immediately notify its descendants. Instead, world transforms of all moved objects and their descendants are
+		 * recalculated together once per frame in _updateTransforms(), and each affected object's components receive a
+		 * single onTransformChanged() call with the combined flags. World transforms can still be queried at any time.
+		 *
+		 * @note	
+		 * Whether a component receives a notification is decided when the change is made, so components that suppress
+		 * notifications by temporarily clearing their notify flags don't receive them later. Changes made during the
+		 * physics update are delivered immediately, as components check the physics update state when notified.
+		 */
+		void setBatchedTransformUpdates(bool enabled);
+
+		/** @copydoc setBatchedTransformUpdates */
+		bool getBatchedTransformUpdates() const { return mBatchedTransformUpdates; }
+
 		/** Returns all cameras in the scene. */
-		const Map<Camera*, SceneCameraData>& getAllCameras() const { return mCameras; }
+		const Vector<SceneCameraData>& getAllCameras() const { return mCameras; }
 
 		/**
 		 * Returns the camera in the scene marked as main. Main camera controls the final render surface that is displayed
@@ -113,7 +149,7 @@ namespace bs
 		void setMainRenderTarget(const SPtr<RenderTarget>& rt);
 
 		/**	Returns all renderables in the scene. */
-		const Map<Renderable*, SceneRenderableData>& getAllRenderables() const { return mRenderables; }
+		const Vector<SceneRenderableData>& getAllRenderables() const { return mRenderables; }
 
 		/** Notifies the scene manager that a new renderable was created. */
 		void _registerRenderable(const SPtr<Renderable>& renderable, const HSceneObject& so);
@@ -145,10 +181,26 @@ namespace bs
 		/** Changes the root scene object. Any persistent objects will remain in the scene, now parented to the new root. */
 		void _setRootNode(const HSceneObject& root);
 
-		/** Called every frame. Calls update methods on all scene objects and their components. */
-		void _update();
+		/** 
+		 * Called every frame, once for each update phase. Calls the update method of the phase on all active components.
+		 *
+		 * Components are updated grouped by type, in order in which the types were first encountered. Groups of components
+		 * with the ComponentFlag::ThreadSafeUpdate flag are updated in parallel if large enough. Time spent updating each
+		 * type is reported to ProfilerCPU.
+		 */
+		void _update(ComponentUpdatePhase phase);
 
-		/** Updates dirty transforms on any core objects that may be tied with scene objects. */
+		/** 
+		 * Recalculates world transforms of all scene objects moved since the last call, and triggers their transform
+		 * changed notifications. Only relevant if batched transform updates are enabled. Called once per frame, before
+		 * _updateCoreObjectTransforms().
+		 */
+		void _updateTransforms();
+
+		/** 
+		 * Updates dirty transforms and active states on any core objects that may be tied with scene objects. Only core
+		 * objects whose scene objects were queued through _notifyCoreObjectsDirty() since the last call are checked.
+		 */
 		void _updateCoreObjectTransforms();
 
 		/** Notifies the manager that a new component has just been created. The manager triggers necessary callbacks. */
@@ -185,12 +237,57 @@ namespace bs
 		 */
 		void registerNewSO(const HSceneObject& node);
 
+		/** Notifies the manager that the local transform of an instantiated scene object changed. */
+		void _notifyTransformModified(const HSceneObject& so);
+
+		/** Notifies the manager that a scene object was added to or removed from the hierarchy. */
+		void _notifyHierarchyChanged();
+
+		/** 
+		 * Notifies the manager that the world transform or the active state of a scene object changed, and core objects
+		 * tied to it need to be updated on the next call to _updateCoreObjectTransforms(). Each object is only queued
+		 * once per frame.
+		 */
+		void _notifyCoreObjectsDirty(const HSceneObject& so);
+
+		/** 
+		 * Adds a core object to its type's array and binds it to the provided scene object. If the core object was
+		 * already registered its previous entry is removed first.
+		 */
+		template<class T>
+		void registerCoreObject(Vector<T>& objects, SceneCoreObjectType type, const T& data);
+
+		/** Removes a core object from its type's array, if registered, and unbinds it from its scene object. */
+		template<class T>
+		void unregisterCoreObject(Vector<T>& objects, void* object);
+
+		/** Updates the transform and active state of a single core object from its scene object. */
+		void syncCoreObject(SceneCoreObjectType type, UINT32 idx);
+
 		/**	Callback that is triggered when the main render target size is changed. */
 		void onMainRenderTargetResized();
 
+		/** Adds a component to the active component list, and to the update group of its type. */
+		void addToActiveList(const HComponent& component);
+
 		/** Removes a component from the active component list. */
 		void removeFromActiveList(const HComponent& component);
 
+		/** Adds a component to the update group for its type and update flags, creating the group if needed. */
+		void addToUpdateGroup(const HComponent& component);
+
+		/** 
+		 * Removes a component from its update group. During an update the component's entry is cleared instead, and the
+		 * group is compacted once the update phase finishes.
+		 */
+		void removeFromUpdateGroup(const HComponent& component);
+
+		/** Removes entries cleared by removeFromUpdateGroup() during an update phase, and re-indexes the remaining ones. */
+		void compactUpdateGroups();
+
+		/** Calls the update method of the provided phase on components in the range [start, end) of an update group. */
+		void updateComponents(UINT32 groupId, ComponentUpdatePhase phase, UINT32 start, UINT32 end);
+
 		/** Removes a component from the inactive component list. */
 		void removeFromInactiveList(const HComponent& component);
 
@@ -207,23 +304,58 @@ namespace bs
 		void decodeComponentId(UINT32 id, UINT32& idx, UINT32& type);
 
 	protected:
+		/** 
+		 * Active components of the same type and with the same update flags, which are updated together. Holds raw
+		 * pointers as components are removed from the group before they are destroyed.
+		 */
+		struct ComponentUpdateGroup
+		{
+			const char* name; /**< Name of the component type, used for profiling. Owned by the RTTI type. */
+			ComponentFlags flags;
+			Vector<Component*> components; /**< Can contain null entries while an update phase is in progress. */
+			bool hasRemovedEntries = false; /**< True if entries were cleared during the current update phase. */
+		};
+
+		/** Location of a core object registered with the scene manager. */
+		struct CoreObjectEntry
+		{
+			SceneCoreObjectType type;
+			UINT32 index; /**< Index in the array of registered objects of the same type. */
+			/**
+			 * Scene object the core object is tied to. Not using the instance ID as it can change during the object's
+			 * lifetime (e.g. when reverting to a prefab).
+			 */
+			const SceneObject* sceneObject;
+		};
+
 		HSceneObject mRootNode;
 
-		Map<Camera*, SceneCameraData> mCameras;
+		Vector<SceneCameraData> mCameras;
 		Vector<SceneCameraData> mMainCameras;
 
-		Map<Renderable*, SceneRenderableData> mRenderables;
-		Map<Light*, SceneLightData> mLights;
-		Map<ReflectionProbe*, SceneReflectionProbeData> mReflectionProbes;
+		Vector<SceneRenderableData> mRenderables;
+		Vector<SceneLightData> mLights;
+		Vector<SceneReflectionProbeData> mReflectionProbes;
+
+		UnorderedMap<void*, CoreObjectEntry> mCoreObjects;
+		UnorderedMultimap<const SceneObject*, void*> mSceneObjectBindings;
+		Vector<HSceneObject> mDirtySceneObjects;
 
 		Vector<HComponent> mActiveComponents;
 		Vector<HComponent> mInactiveComponents;
 		Vector<HComponent> mUnintializedComponents;
 
+		Vector<ComponentUpdateGroup> mUpdateGroups;
+		UnorderedMap<UINT64, UINT32> mUpdateGroupLookup; /**< Maps (RTTI type ID, update flags) to an update group. */
+		bool mUpdatingComponents = false; /**< True while _update() is calling component update methods. */
+
 		SPtr<RenderTarget> mMainRT;
 		HEvent mMainRTResizedConn;
 
 		ComponentState mComponentState = ComponentState::Running;
+
+		SceneTransformStorage mTransformStorage;
+		bool mBatchedTransformUpdates = false;
 	};
 
 	/**	Provides easy access to the SceneManager. */
@@ -0,0 +1,24 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#pragma once
+
+#include "BsCorePrerequisites.h"
+#include "BsTestSuite.h"
+
+namespace bs
+{
+	class BS_CORE_EXPORT SceneManagerTestSuite : public TestSuite
+	{
+	public:
+		SceneManagerTestSuite();
+
+		void startUp() override;
+		void shutDown() override;
+
+	private:
+		void testUpdate_once();
+		void testUpdate_remove_self();
+		void testUpdate_remove_updated();
+		void testUpdate_remove_pending();
+	};
+}
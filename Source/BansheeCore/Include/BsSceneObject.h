@@ -39,10 +39,13 @@ namespace bs
 		enum DirtyFlags
 		{
 			LocalTfrmDirty = 0x01,
-			WorldTfrmDirty = 0x02
+			WorldTfrmDirty = 0x02,
+			QueuedForUpdate = 0x04, /**< Object is queued for a batched transform update in SceneManager. */
+			CoreSyncQueued = 0x08 /**< Object is queued for a core object transform sync in SceneManager. */
 		};
 
 		friend class SceneManager;
+		friend class SceneTransformStorage;
 		friend class Prefab;
 		friend class PrefabDiff;
 		friend class PrefabUtility;
@@ -340,6 +343,10 @@ namespace bs
 		/**
 		 * Returns a hash value that changes whenever a scene objects transform gets updated. It allows you to detect 
 		 * changes with the local or world transforms without directly comparing their values with some older state.
+		 *
+		 * @note	
+		 * If SceneManager has batched transform updates enabled, the hash of an object whose parent moved only changes
+		 * during SceneManager::_updateTransforms().
 		 */
 		UINT32 getTransformHash() const { return mDirtyHash; }
 
@@ -358,13 +365,42 @@ namespace bs
 		mutable UINT32 mDirtyFlags;
 		mutable UINT32 mDirtyHash;
 
+		mutable UINT32 mWorldVersion; /**< Incremented whenever the world transform is recalculated. */
+		mutable UINT32 mParentWorldVersion; /**< Parent's mWorldVersion when the world transform was last calculated. */
+		mutable UINT32 mPendingNotifyFlags; /**< Notifications for descendants waiting for a batched transform update. */
+		UINT32 mTransformIdx; /**< Index of the object in SceneTransformStorage. */
+
 		/** 
-		 * Notifies components and child scene object that a transform has been changed.  
+		 * Notifies components and child scene object that a transform has been changed. If batched transform updates are
+		 * enabled in SceneManager, the notifications are instead queued until SceneManager::_updateTransforms().
 		 * 
 		 * @param	flags	Specifies in what way was the transform changed.
 		 */
 		void notifyTransformChanged(TransformChangedFlags flags) const;
 
+		/** Triggers transform changed callbacks on the components of this object, without notifying any children. */
+		void triggerTransformChanged(TransformChangedFlags flags) const;
+
+		/** Triggers transform changed callbacks on the components of this object and all of its descendants. */
+		void triggerTransformChangedRecursive(TransformChangedFlags flags) const;
+
+		/**
+		 * Triggers transform changed callbacks queued on the components of this object by batched transform updates.
+		 *
+		 * @param	parentFlags		Changes to the transforms of the object's ancestors since the last update. Delivered
+		 *							to components that currently support them, in addition to the queued callbacks.
+		 */
+		void triggerPendingTransformChanged(TransformChangedFlags parentFlags) const;
+
+		/** Discards any transform changed callbacks queued on the components of this object. */
+		void clearPendingTransformChanged() const;
+
+		/** 
+		 * Queues the object in SceneManager so that any core objects tied to it get updated with its new transform and
+		 * active state.
+		 */
+		void notifyCoreObjectsDirty() const;
+
 		/** Updates the local transform. Normally just reconstructs the transform matrix from the position/rotation/scale. */
 		void updateLocalTfrm() const;
 
@@ -378,8 +414,11 @@ namespace bs
 		/**	Checks if cached local transform needs updating. */
 		bool isCachedLocalTfrmUpToDate() const { return (mDirtyFlags & DirtyFlags::LocalTfrmDirty) == 0; }
 
-		/**	Checks if cached world transform needs updating. */
-		bool isCachedWorldTfrmUpToDate() const { return (mDirtyFlags & DirtyFlags::WorldTfrmDirty) == 0; }
+		/**	
+		 * Checks if cached world transform needs updating. With batched transform updates children aren't notified right
+		 * away when their parent moves, so the state of the ancestors is checked as well.
+		 */
+		bool isCachedWorldTfrmUpToDate() const;
 
 		/************************************************************************/
 		/* 								Hierarchy	                     		*/
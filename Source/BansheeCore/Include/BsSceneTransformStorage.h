@@ -0,0 +1,93 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#pragma once
+
+#include "BsCorePrerequisites.h"
+#include "BsGameObject.h"
+#include "BsVector3.h"
+#include "BsQuaternion.h"
+#include "BsMatrix4.h"
+
+namespace bs
+{
+	/** @addtogroup Scene-Internal
+	 *  @{
+	 */
+
+	/**
+	 * Keeps transforms of all scene objects in the scene hierarchy in contiguous arrays, sorted by their depth in the
+	 * hierarchy, so that world transforms of all objects whose transform changed during the frame (and of all their
+	 * descendants) can be recalculated in a single batched pass.
+	 *
+	 * Objects at the same depth are independent of each other, and are processed in parallel when there's enough of them.
+	 * Once all world transforms are calculated they are written back into the scene objects, and each changed object's
+	 * components receive a single transform changed notification for the entire frame.
+	 *
+	 * @note	Used by SceneManager when batched transform updates are enabled. Sim thread only.
+	 */
+	class BS_CORE_EXPORT SceneTransformStorage
+	{
+		/** Values of the mDirty array. */
+		enum DirtyState
+		{
+			Clean = 0,
+			Modified = 1, /**< Transform of the object itself was modified. */
+			ParentModified = 2 /**< World transform of one of the object's ancestors was modified. */
+		};
+
+	public:
+		SceneTransformStorage();
+
+		/**
+		 * Notifies the storage that the scene hierarchy changed (objects were added, removed or re-parented), and the
+		 * object arrays need to be rebuilt before the next update.
+		 */
+		void notifyHierarchyDirty() { mHierarchyDirty = true; }
+
+		/**
+		 * Queues an object whose local transform was modified. The object's world transform, and world transforms of all
+		 * its descendants, will be recalculated on the next call to update().
+		 */
+		void queueModified(const HSceneObject& so);
+
+		/**
+		 * Recalculates world transforms of all modified objects and their descendants, writes them back into the scene
+		 * objects and triggers transform changed notifications on their components.
+		 *
+		 * @param[in]	root	Root of the scene hierarchy. Only objects that are its descendants are stored.
+		 */
+		void update(const HSceneObject& root);
+
+		/** Removes all stored objects and queued changes. */
+		void clear();
+
+	private:
+		/** Rebuilds the object arrays by walking the scene hierarchy breadth first. */
+		void rebuild(const HSceneObject& root);
+
+		/** Calculates world transforms of modified objects in range [start, end) of a single hierarchy level. */
+		void updateRange(UINT32 start, UINT32 end);
+
+		Vector<HSceneObject> mObjects;
+		Vector<UINT32> mParents; /**< Index of the parent object, or -1 for the root. */
+		Vector<UINT32> mLevelOffsets; /**< Index of the first object at each depth, plus the total count at the end. */
+
+		Vector<Vector3> mLocalPositions;
+		Vector<Quaternion> mLocalRotations;
+		Vector<Vector3> mLocalScales;
+
+		Vector<Vector3> mWorldPositions;
+		Vector<Quaternion> mWorldRotations;
+		Vector<Vector3> mWorldScales;
+		Vector<Matrix4> mWorldTfrms;
+
+		Vector<UINT8> mDirty;
+		Vector<UINT32> mNotifyFlags; /**< Notifications for the object's descendants. */
+		Vector<UINT32> mParentNotifyFlags; /**< Notifications received from the object's ancestors. */
+
+		Vector<HSceneObject> mModifiedObjects;
+		bool mHierarchyDirty;
+	};
+
+	/** @} */
+}
@@ -8,10 +8,12 @@
 #include "BsVector3.h"
 #include "BsQuaternion.h"
 #include "BsCurveCache.h"
+#include "BsCompressedAnimationCurves.h"
 
 namespace bs
 {
 	class SkeletonMask;
+	struct SkeletonPoseSoA;
 
 	/** @addtogroup Animation-Internal
 	 *  @{
@@ -49,6 +51,13 @@ namespace bs
 		TCurveCache<Vector3>* scaleCaches; /**< Cache used for evaluating scale curves. */
 		TCurveCache<float>* genericCaches; /**< Cache used for evaluating generic curves. */
 
+		/** 
+		 * Compressed position, rotation and scale curves, if the clip is compressed. When present these are used instead
+		 * of the position, rotation and scale curves in @p curves.
+		 */
+		SPtr<CompressedAnimationCurves> compressedCurves;
+		CompressedCurveCursor compressedCursor; /**< Cursor used for decoding @p compressedCurves. */
+
 		float time; /**< Time to evaluate the curve at. */
 		float weight; /**< Determines how much of an influence will this clip have in regard to others in the same layer. */
 		bool loop; /**< Determines should the animation loop (wrap) once ending or beginning frames are passed. */
@@ -141,9 +150,28 @@ namespace bs
 		 *							to hold all the bone data of this skeleton.
 		 * @param[in]	layers		One or multiple layers, containing one or multiple animation states to evaluate.
 		 * @param[in]	numLayers	Number of layers in the @p layers array.
+		 * @param[in]	maxBoneDepth	Bones deeper in the hierarchy than this value (root bones having depth zero) will
+		 *								not be evaluated, and will instead keep the local transform already present in
+		 *								@p localPose. Caller must ensure @p localPose contains a valid pose if limiting the
+		 *								depth.
 		 */
 		void getPose(Matrix4* pose, LocalSkeletonPose& localPose, const SkeletonMask& mask, 
-			const AnimationStateLayer* layers, UINT32 numLayers);
+			const AnimationStateLayer* layers, UINT32 numLayers, UINT32 maxBoneDepth = (UINT32)-1);
+
+		/** 
+		 * Outputs a skeleton pose by interpolating between two previously evaluated local poses.
+		 *
+		 * @param[out]		pose		Output pose containing the requested transforms. Must be pre-allocated with enough
+		 *								space to hold all the bone matrices of this skeleton. Entries for bones marked as
+		 *								overriden in @p localPose are not modified.
+		 * @param[in, out]	localPose	Output pose containing the interpolated local transforms. Its @p hasOverride
+		 *								array is used as input.
+		 * @param[in]		from		Local pose to interpolate from.
+		 * @param[in]		to			Local pose to interpolate to.
+		 * @param[in]		t			Interpolation factor in range [0, 1].
+		 */
+		void getPose(Matrix4* pose, LocalSkeletonPose& localPose, const LocalSkeletonPose& from, 
+			const LocalSkeletonPose& to, float t);
 
 		/** Returns the total number of bones in the skeleton. */
 		UINT32 getNumBones() const { return mNumBones; }
@@ -157,6 +185,9 @@ namespace bs
 		/** Returns the inverse bind pose for the bone at the provided index. */
 		const Matrix4& getInvBindPose(UINT32 idx) const { return mInvBindPoses[idx]; }
 
+		/** Returns the number of parents between the bone at the provided index and its root bone. */
+		UINT32 getBoneDepth(UINT32 idx) const { return mBoneDepths[idx]; }
+
 		/** 
 		 * Creates a new Skeleton. 
 		 *
@@ -169,9 +200,24 @@ namespace bs
 		Skeleton();
 		Skeleton(BONE_DESC* bones, UINT32 numBones);
 
+		/** 
+		 * Builds a list of bone indices sorted so that parent bones always come before their children, allowing the
+		 * global pose to be calculated in a single linear pass. Also calculates the depth of each bone.
+		 */
+		void buildBoneOrder();
+
+		/** 
+		 * Converts a blended local pose into final bone matrices, by building the local matrices, applying the hierarchy
+		 * and the inverse bind poses. Bones marked in @p hasOverride are expected to already contain a global transform
+		 * in @p pose.
+		 */
+		void calculateGlobalPose(Matrix4* pose, const SkeletonPoseSoA& localPose, const bool* hasOverride) const;
+
 		UINT32 mNumBones;
 		Matrix4* mInvBindPoses;
 		SkeletonBoneInfo* mBoneInfo;
+		UINT32* mBoneOrder;
+		UINT32* mBoneDepths;
 
 		/************************************************************************/
 		/* 								SERIALIZATION                      		*/
@@ -76,6 +76,13 @@ namespace bs
 
 		/** Number of texture slices to create if creating a texture array. Ignored for 3D textures. */
 		UINT32 numArraySlices = 1;
+
+		/** 
+		 * If true, only the smallest mip levels of the texture will be loaded initially, while the more detailed levels
+		 * will be streamed in as the texture is needed at higher detail on screen. Only relevant for textures loaded
+		 * from disk. See ct::TextureStreamingManager.
+		 */
+		bool streaming = false;
 	};
 
 	/** Properties of a Texture. Shared between sim and core thread versions of a Texture. */
@@ -131,6 +138,9 @@ namespace bs
 		/** Returns the number of array slices of the texture (if the texture is an array texture). */
 		UINT32 getNumArraySlices() const { return mDesc.numArraySlices; }
 
+		/** Determines are the more detailed mip levels of the texture streamed in on demand. */
+		bool isStreaming() const { return mDesc.streaming; }
+
 		/**
 		 * Allocates a buffer that exactly matches the format of the texture described by these properties, for the provided
 		 * face and mip level. This is a helper function, primarily meant for creating buffers when reading from, or writing
@@ -221,6 +231,9 @@ namespace bs
 		/**	Retrieves a core implementation of a texture usable only from the core thread. */
 		SPtr<ct::Texture> getCore() const;
 
+		/** @copydoc Resource::getMemoryUsage */
+		void getMemoryUsage(UINT64& cpuBytes, UINT64& gpuBytes) const override;
+
 		/************************************************************************/
 		/* 								STATICS		                     		*/
 		/************************************************************************/
@@ -321,7 +334,7 @@ namespace bs
 	{
 	public:
 		Texture(const TEXTURE_DESC& desc, const SPtr<PixelData>& initData, GpuDeviceFlags deviceMask);
-		virtual ~Texture() {}
+		virtual ~Texture();
 
 
 		/** @copydoc CoreObject::initialize */
@@ -427,6 +440,28 @@ namespace bs
 		SPtr<TextureView> requestView(UINT32 mostDetailMip, UINT32 numMips, UINT32 firstArraySlice, UINT32 numArraySlices, 
 									  GpuViewUsage usage);
 
+		/************************************************************************/
+		/* 								STREAMING                      			*/
+		/************************************************************************/
+
+		/** 
+		 * Returns the most detailed mip level that contains valid data. Always zero unless the texture's mip levels are
+		 * being streamed in.
+		 */
+		UINT32 getFirstLoadedMip() const { return mFirstLoadedMip; }
+
+		/** 
+		 * Clamps the provided surface so it only covers mip levels that contain valid data. Should be used when binding
+		 * the texture for sampling.
+		 */
+		TextureSurface getLoadedSurface(const TextureSurface& surface) const;
+
+		/** 
+		 * Changes the most detailed mip level that contains valid data. Called by TextureStreamingManager after a more
+		 * detailed level was uploaded, or when a level was discarded.
+		 */
+		virtual void _setFirstLoadedMip(UINT32 mipLevel) { mFirstLoadedMip = mipLevel; }
+
 		/** Returns a plain white texture. */
 		static SPtr<Texture> WHITE;
 
@@ -468,6 +503,7 @@ namespace bs
 		UnorderedMap<TEXTURE_VIEW_DESC, SPtr<TextureView>, TextureView::HashFunction, TextureView::EqualFunction> mTextureViews;
 		TextureProperties mProperties;
 		SPtr<PixelData> mInitData;
+		UINT32 mFirstLoadedMip;
 	};
 
 	/** @} */
@@ -81,6 +81,15 @@ namespace bs
 		 */
 		CubemapSourceType getCubemapSourceType() const { return mCubemapSourceType; }
 
+		/** 
+		 * Determines should the more detailed mip levels of the texture be streamed in on demand, as the texture is
+		 * displayed at higher detail on screen. Only relevant for textures with mipmaps that aren't CPU cached.
+		 */
+		void setStreaming(bool streaming) { mStreaming = streaming; }
+
+		/** Checks will the more detailed mip levels of the texture be streamed in on demand. */
+		bool getStreaming() const { return mStreaming; }
+
 		/** Creates a new import options object that allows you to customize how are textures imported. */
 		static SPtr<TextureImportOptions> create();
 
@@ -100,6 +109,7 @@ namespace bs
 		bool mSRGB;
 		bool mCubemap;
 		CubemapSourceType mCubemapSourceType;
+		bool mStreaming;
 	};
 
 	/** @} */
@@ -10,6 +10,7 @@
 #include "BsRenderAPI.h"
 #include "BsTextureManager.h"
 #include "BsPixelData.h"
+#include "BsTextureStreamingManager.h"
 
 namespace bs
 {
@@ -31,6 +32,7 @@ namespace bs
 			BS_RTTI_MEMBER_PLAIN_NAMED(numSamples, mProperties.mDesc.numSamples, 7)
 			BS_RTTI_MEMBER_PLAIN_NAMED(type, mProperties.mDesc.type, 9)
 			BS_RTTI_MEMBER_PLAIN_NAMED(format, mProperties.mDesc.format, 10)
+			BS_RTTI_MEMBER_PLAIN_NAMED(streaming, mProperties.mDesc.streaming, 13)
 		BS_END_RTTI_MEMBERS
 
 		INT32& getUsage(Texture* obj) { return obj->mProperties.mDesc.usage; }
@@ -133,14 +135,33 @@ namespace bs
 			// in mRTTIData.
 			texture->initialize();
 
+			// Streamed textures only upload their smallest mip levels, the rest are uploaded by the streaming manager
+			// when needed. Source data is required in full when it needs to be kept, so streaming is skipped then.
+			auto iterFind = params.find("keepSourceData");
+			bool keepSourceData = iterFind != params.end() && iterFind->second > 0;
+
+			UINT32 firstLoadedMip = 0;
+			if (!keepSourceData && (texProps.getUsage() & TU_CPUCACHED) == 0 && ct::TextureStreamingManager::isStarted())
+				firstLoadedMip = ct::TextureStreamingManager::getInitialLoadedMip(texProps);
+
 			for(size_t i = 0; i < pixelData->size(); i++)
 			{
 				UINT32 face = (size_t)Math::floor(i / (float)(texProps.getNumMipmaps() + 1));
 				UINT32 mipmap = i % (texProps.getNumMipmaps() + 1);
 
+				if (mipmap < firstLoadedMip)
+					continue;
+
 				texture->writeData(pixelData->at(i), face, mipmap, false);
 			}
 
+			if (firstLoadedMip > 0)
+			{
+				SPtr<ct::Texture> coreTexture = texture->getCore();
+				gCoreThread().queueCommand(std::bind(&ct::TextureStreamingManager::_registerTexture, 
+					ct::TextureStreamingManager::instancePtr(), coreTexture, *pixelData, firstLoadedMip));
+			}
+
 			bs_delete(pixelData);
 			texture->mRTTIData = nullptr;	
 		}
@@ -0,0 +1,174 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#pragma once
+
+#include "BsCorePrerequisites.h"
+#include "BsModule.h"
+
+namespace bs
+{
+	/** @addtogroup Resources-Internal
+	 *  @{
+	 */
+
+	/** Information about the state of texture streaming. */
+	struct TextureStreamingStats
+	{
+		UINT32 numTextures; /**< Number of textures with streamed mip levels. */
+		UINT64 maxLoadedBytes; /**< Maximum amount of streamed mip data that can be loaded at once, in bytes. */
+		UINT64 loadedBytes; /**< Amount of streamed mip data currently loaded, in bytes. */
+		UINT32 numPendingLoads; /**< Number of mip levels currently being loaded. */
+
+		UINT64 numStreamedIn; /**< Number of mip levels streamed in since startup. */
+		UINT64 bytesStreamedIn; /**< Amount of mip data streamed in since startup, in bytes. */
+		UINT64 numDiscarded; /**< Number of loaded mip levels discarded to stay within the limit since startup. */
+	};
+
+	namespace ct
+	{
+	/**
+	 * Keeps track of textures whose higher mip levels are streamed in on demand. Such textures initially have only their
+	 * smallest mip levels loaded. Each frame the renderer reports the most detailed mip level each texture needs, and
+	 * the manager loads the missing levels asynchronously and uploads them, while keeping the total size of loaded
+	 * streamed levels below a limit. When over the limit, levels of the least recently needed textures are discarded.
+	 *
+	 * Until a level is loaded the texture is sampled as if its most detailed level was the first loaded one (see
+	 * Texture::getLoadedSurface()).
+	 *
+	 * @note
+	 * Render APIs allocate video memory for the full mip chain when a texture is created, and discarded levels keep 
+	 * their storage. Streaming reduces load times, disk reads and uploads, and bounds the texture detail that's loaded, 
+	 * but doesn't reduce the amount of video memory allocated for textures.
+	 *
+	 * @note
+	 * Source data of streamed levels isn't kept in memory. When a level is needed it is read again from the file (or
+	 * archive) the texture was loaded from, on a worker thread, and released once uploaded. Only data that can't be read
+	 * again (e.g. compressed archive entries, or data converted to a different format on load) is kept in memory.
+	 * @note
+	 * Core thread only.
+	 */
+	class BS_CORE_EXPORT TextureStreamingManager : public Module<TextureStreamingManager>
+	{
+		/** Source of the data of a single face and mip level of a streamed texture. */
+		struct StreamedSubresource
+		{
+			/**
+			 * Layout of the data. Also holds the data itself if it can't be read from a file, in which case @p filePath is
+			 * empty. Null for levels that are always loaded.
+			 */
+			SPtr<PixelData> pixelData;
+			Path filePath; /**< File to read the data from. */
+			UINT64 offset = 0; /**< Offset of the data from the start of the file, in bytes. */
+			UINT32 size = 0; /**< Size of the data, in bytes. */
+		};
+
+		/** Information about a single streamed texture. */
+		struct StreamedTexture
+		{
+			Texture* texture;
+			Vector<StreamedSubresource> subresources; /**< Data sources for all faces and mip levels. */
+
+			UINT32 firstLoadedMip;
+			UINT32 firstAlwaysLoadedMip; /**< Most detailed mip level that's never discarded. */
+			UINT32 firstLoadableMip; /**< Most detailed mip level whose data can be loaded. */
+			UINT32 requestedMip; /**< Most detailed mip level requested this frame. */
+			UINT32 wantedMip; /**< Most detailed mip level that was needed recently. */
+			UINT64 lastRequestFrame;
+
+			SPtr<Task> loadTask; /**< Task loading the next more detailed mip level, if any. */
+			SPtr<Vector<SPtr<PixelData>>> loadedData; /**< Per-face data read by the load task. */
+		};
+
+	public:
+		TextureStreamingManager();
+		~TextureStreamingManager();
+
+		/**
+		 * Sets the maximum size of the streamed mip levels of all textures that can be loaded at once, in bytes. Mip 
+		 * levels that are always loaded don't count towards the limit. Mip levels larger than the limit are never 
+		 * streamed in.
+		 *
+		 * @note	This limits the amount of data read and uploaded, not the amount of video memory allocated for textures.
+		 */
+		void setMaxLoadedBytes(UINT64 bytes) { mMaxLoadedBytes = bytes; }
+
+		/** @copydoc setMaxLoadedBytes */
+		UINT64 getMaxLoadedBytes() const { return mMaxLoadedBytes; }
+
+		/**
+		 * Notifies the manager that the texture will be sampled at the provided mip level this frame. Has no effect for
+		 * textures that aren't streamed.
+		 */
+		void requestMip(Texture* texture, UINT32 mipLevel);
+
+		/** Returns the number of textures with streamed mip levels. */
+		UINT32 getNumTextures() const { return (UINT32)mTextures.size(); }
+
+		/** Returns information about the state of texture streaming. */
+		TextureStreamingStats getStats() const;
+
+		/**
+		 * Returns the most detailed mip level of a texture with the provided properties that should be loaded when the
+		 * texture is first loaded. Returns zero if the texture shouldn't be streamed.
+		 */
+		static UINT32 getInitialLoadedMip(const TextureProperties& props);
+
+		/** @name Internal
+		 *  @{
+		 */
+
+		/**
+		 * Registers a texture whose mip levels more detailed than @p firstLoadedMip are streamed in on demand.
+		 *
+		 * @param[in]	texture			Texture to stream. Mip levels starting with @p firstLoadedMip must already be
+		 *								written to the texture.
+		 * @param[in]	pixelData		Data for all faces and mip levels of the texture, in the order of sub-resources.
+		 *								Only entries for streamed levels are used. Entries referencing a mapped file are
+		 *								released, and read from the file again when needed.
+		 * @param[in]	firstLoadedMip	Most detailed mip level that's loaded.
+		 */
+		void _registerTexture(const SPtr<Texture>& texture, const Vector<SPtr<PixelData>>& pixelData,
+			UINT32 firstLoadedMip);
+
+		/** Stops streaming for the provided texture. Called when the texture is destroyed. */
+		void _unregisterTexture(Texture* texture);
+
+		/**
+		 * Updates the needed mip levels from the requests made this frame, finishes uploads of loaded levels, starts new
+		 * loads and discards levels if over the limit. Called once per frame by the renderer, after all requests were made.
+		 */
+		void _update();
+
+		/** @} */
+	private:
+		/** Returns the size of all faces of the specified mip level of a texture, in bytes. */
+		static UINT64 getMipSize(const TextureProperties& props, UINT32 mipLevel);
+
+		/**
+		 * Uploads the mip level read by the texture's load task and marks it as loaded. If the data couldn't be read
+		 * the level, and any more detailed levels, are no longer streamed.
+		 */
+		void finishLoad(StreamedTexture& entry);
+
+		/**
+		 * Discards the most detailed loaded streamed mip level of the least recently needed texture, skipping levels that
+		 * are needed by textures visible this frame, and any levels of @p exclude. Returns false if no level can be
+		 * discarded.
+		 */
+		bool discardMip(const StreamedTexture* exclude);
+
+		Vector<StreamedTexture> mTextures;
+		UnorderedMap<Texture*, UINT32> mTextureLookup;
+
+		UINT64 mMaxLoadedBytes;
+		UINT64 mLoadedBytes;
+		UINT64 mFrameIdx;
+
+		UINT64 mNumStreamedIn;
+		UINT64 mBytesStreamedIn;
+		UINT64 mNumDiscarded;
+	};
+	}
+
+	/** @} */
+}
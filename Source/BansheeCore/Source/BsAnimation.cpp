@@ -35,8 +35,9 @@ namespace bs
 	AnimationProxy::AnimationProxy(UINT64 id)
 		: id(id), layers(nullptr), numLayers(0), numSceneObjects(0), sceneObjectInfos(nullptr)
 		, sceneObjectTransforms(nullptr), morphChannelInfos(nullptr), morphShapeInfos(nullptr), numMorphShapes(0)
-		, numMorphChannels(0), numMorphVertices(0), morphChannelWeightsDirty(false), mCullEnabled(true), numGenericCurves(0)
-		, genericCurveOutputs(nullptr)
+		, numMorphChannels(0), numMorphVertices(0), morphChannelWeightsDirty(false), mCullEnabled(true), lodFrameInterval(1)
+		, lodMaxBoneDepth((UINT32)-1), lodFramesSinceEval(0), lodNumCachedPoses(0), skeletonPoseValid(false)
+		, numGenericCurves(0), genericCurveOutputs(nullptr)
 	{ }
 
 	AnimationProxy::~AnimationProxy()
@@ -128,7 +129,17 @@ namespace bs
 		// Note: I could avoid having a separate allocation for LocalSkeletonPoses and use the same buffer as the rest
 		// of AnimationProxy
 		if (skeleton != nullptr)
-			skeletonPose = LocalSkeletonPose(skeleton->getNumBones());
+		{
+			UINT32 numBones = skeleton->getNumBones();
+
+			skeletonPose = LocalSkeletonPose(numBones);
+			lodPoses[0] = LocalSkeletonPose(numBones);
+			lodPoses[1] = LocalSkeletonPose(numBones);
+		}
+
+		skeletonPoseValid = false;
+		lodNumCachedPoses = 0;
+		lodFramesSinceEval = 0;
 
 		numSceneObjects = (UINT32)sceneObjects.size();
 		if (numSceneObjects > 0)
@@ -451,6 +462,7 @@ namespace bs
 					if (isClipValid)
 					{
 						state.curves = clipInfo.clip->getCurves();
+						state.compressedCurves = clipInfo.clip->getCompressedCurves();
 						state.disabled = clipInfo.playbackType == AnimPlaybackType::None;
 					}
 					else
@@ -744,6 +756,15 @@ namespace bs
 		mDirty |= AnimDirtyStateFlag::Culling;
 	}
 
+	void Animation::setLODs(const Vector<AnimationLOD>& lods)
+	{
+		mLODs = lods;
+		std::stable_sort(mLODs.begin(), mLODs.end(), 
+			[](const AnimationLOD& a, const AnimationLOD& b) { return a.screenSize > b.screenSize; });
+
+		mDirty |= AnimDirtyStateFlag::Culling;
+	}
+
 	void Animation::play(const HAnimationClip& clip)
 	{
 		AnimationClipInfo* clipInfo = addClip(clip, (UINT32)-1);
@@ -1299,6 +1320,7 @@ namespace bs
 		{
 			mAnimProxy->mCullEnabled = mCull;
 			mAnimProxy->mBounds = mBounds;
+			mAnimProxy->lods = mLODs;
 
 			mDirty.unset(AnimDirtyStateFlag::Culling);
 		}
@@ -3,6 +3,7 @@
 #include "BsAnimationClip.h"
 #include "BsResources.h"
 #include "BsSkeleton.h"
+#include "BsCompressedAnimationCurves.h"
 #include "BsAnimationClipRTTI.h"
 
 namespace bs
@@ -140,12 +141,44 @@ namespace bs
 	void AnimationClip::setCurves(const AnimationCurves& curves)
 	{
 		*mCurves = curves;
+		mCompressedCurves = nullptr;
 
 		buildNameMapping();
 		calculateLength();
 		mVersion++;
 	}
 
+	bool AnimationClip::compress(float maxError)
+	{
+		if (mCompressedCurves != nullptr)
+			return true;
+
+		SPtr<CompressedAnimationCurves> compressedCurves = CompressedAnimationCurves::create(*mCurves, mSampleRate, maxError);
+		if (compressedCurves == nullptr)
+			return false;
+
+		// Curves must be immutable, so create a new copy without the compressed keyframes
+		SPtr<AnimationCurves> curves = bs_shared_ptr_new<AnimationCurves>(*mCurves);
+
+		auto stripCurves = [](auto& entries)
+		{
+			for (auto& entry : entries)
+				entry.curve = decltype(entry.curve)();
+		};
+
+		stripCurves(curves->position);
+		stripCurves(curves->rotation);
+		stripCurves(curves->scale);
+
+		mCurves = curves;
+		mCompressedCurves = compressedCurves;
+
+		calculateLength();
+		mVersion++;
+
+		return true;
+	}
+
 	bool AnimationClip::hasRootMotion() const
 	{
 		return mRootMotion != nullptr && 
@@ -167,6 +200,9 @@ namespace bs
 
 		for (auto& entry : mCurves->generic)
 			mLength = std::max(mLength, entry.curve.getLength());
+
+		if (mCompressedCurves != nullptr)
+			mLength = std::max(mLength, mCompressedCurves->getLength());
 	}
 
 	void AnimationClip::buildNameMapping()
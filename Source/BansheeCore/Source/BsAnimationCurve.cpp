@@ -154,16 +154,19 @@ namespace bs
 	template <class T>
 	const UINT32 TAnimationCurve<T>::CACHE_LOOKAHEAD = 3;
 
+	template <class T>
+	const UINT32 TAnimationCurve<T>::KEY_INDEX_MIN_KEYS = 16;
+
 	template <class T>
 	TAnimationCurve<T>::TAnimationCurve()
-		:mStart(0.0f), mEnd(0.0f), mLength(0.0f)
+		:mStart(0.0f), mEnd(0.0f), mLength(0.0f), mKeyIndexInvCellSize(0.0f)
 	{
 		
 	}
 
 	template <class T>
 	TAnimationCurve<T>::TAnimationCurve(const Vector<KeyFrame>& keyframes)
-		:mKeyframes(keyframes)
+		:mKeyframes(keyframes), mKeyIndexInvCellSize(0.0f)
 	{
 #if BS_DEBUG_MODE
 		// Ensure keyframes are sorted
@@ -185,6 +188,47 @@ namespace bs
 
 		mStart = 0.0f;
 		mLength = mEnd;
+
+		buildKeyIndex();
+	}
+
+	template <class T>
+	void TAnimationCurve<T>::buildKeyIndex()
+	{
+		mKeyIndex.clear();
+		mKeyIndexInvCellSize = 0.0f;
+
+		UINT32 numKeys = (UINT32)mKeyframes.size();
+		if (numKeys < KEY_INDEX_MIN_KEYS || mLength <= 0.0f)
+			return;
+
+		// One cell per key on average, so that finding a key requires searching through a single key in the common case
+		UINT32 numCells = numKeys;
+		mKeyIndexInvCellSize = numCells / mLength;
+		mKeyIndex.resize(numCells + 1, 0);
+
+		// Count the keys per cell, then convert the counts into starting offsets. Keys must be assigned to cells using
+		// the same calculation as lookups, so that search ranges are correct even with floating point precision errors.
+		for (UINT32 i = 0; i < numKeys; i++)
+			mKeyIndex[getKeyIndexCell(mKeyframes[i].time) + 1]++;
+
+		for (UINT32 i = 0; i < numCells; i++)
+			mKeyIndex[i + 1] += mKeyIndex[i];
+	}
+
+	template <class T>
+	UINT32 TAnimationCurve<T>::getKeyIndexCell(float time) const
+	{
+		UINT32 lastCell = (UINT32)mKeyIndex.size() - 2;
+
+		float cell = (time - mStart) * mKeyIndexInvCellSize;
+		if (cell <= 0.0f)
+			return 0;
+
+		if (cell >= (float)lastCell)
+			return lastCell;
+
+		return (UINT32)cell;
 	}
 
 	template <class T>
@@ -394,6 +438,16 @@ namespace bs
 	{
 		INT32 start = 0;
 		INT32 searchLength = (INT32)mKeyframes.size();
+
+		// All keys in the preceding cells are before the provided time, and all keys in the following cells are after it,
+		// so only the keys in the time's cell need to be searched
+		if(!mKeyIndex.empty())
+		{
+			UINT32 cell = getKeyIndexCell(time);
+
+			start = (INT32)mKeyIndex[cell];
+			searchLength = (INT32)mKeyIndex[cell + 1] - start;
+		}
 		
 		while(searchLength > 0)
 		{
@@ -10,6 +10,7 @@
 #include "BsMorphShapes.h"
 #include "BsMeshData.h"
 #include "BsMeshUtility.h"
+#include "BsFrameAlloc.h"
 
 namespace bs
 {
@@ -46,6 +47,7 @@ namespace bs
 		if (mPaused || !mWorkerStarted)
 			return;
 
+		BS_MEMORY_SCOPE("Animation");
 		mAnimationWorker->wait();
 		
 		WorkerState state = mWorkerState.load(std::memory_order_acquire);
@@ -68,6 +70,7 @@ namespace bs
 		if (mAnimationTime < mNextAnimationUpdateTime)
 			return;
 
+		BS_MEMORY_SCOPE("Animation");
 		mNextAnimationUpdateTime = Math::floor(mAnimationTime / mUpdateRate) * mUpdateRate + mUpdateRate;
 
 		float timeDelta = mAnimationTime - mLastAnimationUpdateTime;
@@ -84,17 +87,33 @@ namespace bs
 		}
 
 		mCullFrustums.clear();
+		mLODCameras.clear();
 
 		auto& allCameras = gSceneManager().getAllCameras();
 		for(auto& entry : allCameras)
 		{
-			bool isOverlayCamera = entry.second.camera->getFlags().isSet(CameraFlag::Overlay);
+			bool isOverlayCamera = entry.camera->getFlags().isSet(CameraFlag::Overlay);
 			if (isOverlayCamera)
 				continue;
 
 			// TODO: Not checking if camera and animation renderable's layers match. If we checked more animations could
 			// be culled.
-			mCullFrustums.push_back(entry.second.camera->getWorldFrustum());
+			const SPtr<Camera>& camera = entry.camera;
+			mCullFrustums.push_back(camera->getWorldFrustum());
+
+			LODCameraInfo lodInfo;
+			lodInfo.position = camera->getPosition();
+			lodInfo.perspective = camera->getProjectionType() == PT_PERSPECTIVE;
+
+			if (lodInfo.perspective)
+			{
+				float tanHalfVertFOV = Math::tan(camera->getHorzFOV() * 0.5f) / camera->getAspectRatio();
+				lodInfo.screenScale = 1.0f / std::max(tanHalfVertFOV, 0.0001f);
+			}
+			else
+				lodInfo.screenScale = 2.0f / std::max(camera->getOrthoWindowHeight(), 0.0001f);
+
+			mLODCameras.push_back(lodInfo);
 		}
 
 		// Make sure thread finishes writing all changes to the anim proxies as they will be read by the animation thread
@@ -110,6 +129,8 @@ namespace bs
 
 	void AnimationManager::evaluateAnimation()
 	{
+		BS_MEMORY_SCOPE("Animation");
+
 		// Make sure we don't load obsolete anim proxy data written by the simulation thread
 		WorkerState state = mWorkerState.load(std::memory_order_acquire);
 		assert(state == WorkerState::Started);
@@ -117,199 +138,399 @@ namespace bs
 		// No need for locking, as we are sure that only postUpdate() writes to the proxy buffer, and increments the write
 		// buffer index. And it's called sequentially ensuring previous call to evaluate finishes.
 
+		UINT32 numProxies = (UINT32)mProxies.size();
+		mProxyEvalInfos.resize(numProxies);
+
+		// Cull animations and determine where in the transform buffer will each animation write its bones. This way
+		// animations can be evaluated in parallel without needing to synchronize the output.
 		UINT32 totalNumBones = 0;
-		for (auto& anim : mProxies)
+		for(UINT32 i = 0; i < numProxies; i++)
 		{
-			if (anim->skeleton != nullptr)
+			const SPtr<AnimationProxy>& anim = mProxies[i];
+			ProxyEvalInfo& evalInfo = mProxyEvalInfos[i];
+
+			evalInfo.visible = true;
+			evalInfo.hasAnimInfo = false;
+			evalInfo.boneIdx = totalNumBones;
+
+			evalInfo.visible = updateVisibilityAndLOD(*anim);
+
+			if (evalInfo.visible && anim->skeleton != nullptr)
 				totalNumBones += anim->skeleton->getNumBones();
 		}
 
 		RendererAnimationData& renderData = mAnimData[mPoseWriteBufferIdx];
 		
 		UINT32 prevPoseBufferIdx = (mPoseWriteBufferIdx + CoreThread::NUM_SYNC_BUFFERS - 1) % CoreThread::NUM_SYNC_BUFFERS;
-		RendererAnimationData& prevRenderData = mAnimData[prevPoseBufferIdx];
+		const RendererAnimationData& prevRenderData = mAnimData[prevPoseBufferIdx];
 		
 		mPoseWriteBufferIdx = (mPoseWriteBufferIdx + 1) % CoreThread::NUM_SYNC_BUFFERS;
 
 		renderData.transforms.resize(totalNumBones);
 		renderData.infos.clear();
 
-		UINT32 curBoneIdx = 0;
-		for(auto& anim : mProxies)
+		// Evaluate animations in batches, in parallel. Each animation only writes to its own proxy and to its own range
+		// of the transform buffer.
+		auto evaluateBatch = [&](UINT32 start, UINT32 end)
 		{
-			if(anim->mCullEnabled)
-			{
-				bool isVisible = false;
-				for(auto& frustum : mCullFrustums)
-				{
-					if(frustum.intersects(anim->mBounds))
-					{
-						isVisible = true;
-						break;
-					}
-				}
+			// Batches can run on other worker threads, which don't inherit the scope of the caller
+			BS_MEMORY_SCOPE("Animation");
 
-				if (!isVisible)
+			for(UINT32 i = start; i < end; i++)
+			{
+				ProxyEvalInfo& evalInfo = mProxyEvalInfos[i];
+				if (!evalInfo.visible)
 					continue;
+
+				evalInfo.animInfo = RendererAnimationData::AnimInfo();
+				evalInfo.hasAnimInfo = evaluateProxy(mProxies[i], evalInfo.boneIdx, renderData, prevRenderData, 
+					evalInfo.animInfo);
 			}
+		};
 
-			RendererAnimationData::AnimInfo animInfo;
-			bool hasAnimInfo = false;
+		if(numProxies > PROXY_BATCH_SIZE)
+			TaskScheduler::instance().parallelFor(0, numProxies, PROXY_BATCH_SIZE, evaluateBatch);
+		else
+			evaluateBatch(0, numProxies);
 
-			// Evaluate skeletal animation
-			if (anim->skeleton != nullptr)
-			{
-				UINT32 numBones = anim->skeleton->getNumBones();
+		// Merge the results in the original order, so the output is identical to a serial evaluation
+		for(UINT32 i = 0; i < numProxies; i++)
+		{
+			ProxyEvalInfo& evalInfo = mProxyEvalInfos[i];
+			if (evalInfo.hasAnimInfo)
+				renderData.infos[mProxies[i]->id] = evalInfo.animInfo;
 
-				RendererAnimationData::PoseInfo& poseInfo = animInfo.poseInfo;
-				poseInfo.animId = anim->id;
-				poseInfo.startIdx = curBoneIdx;
-				poseInfo.numBones = numBones;
+			// Don't keep a reference to the morph shape data, render data already holds one
+			evalInfo.animInfo.morphShapeInfo.meshData = nullptr;
+		}
 
-				memset(anim->skeletonPose.hasOverride, 0, sizeof(bool) * anim->skeletonPose.numBones);
-				Matrix4* boneDst = renderData.transforms.data() + curBoneIdx;
+		// Increments counter and ensures all writes are recorded
+		mWorkerState.store(WorkerState::DataReady, std::memory_order_release);
+		mDataReadyCount.fetch_add(1, std::memory_order_acq_rel);
+	}
 
-				// Copy transforms from mapped scene objects
-				UINT32 boneTfrmIdx = 0;
-				for(UINT32 i = 0; i < anim->numSceneObjects; i++)
-				{
-					const AnimatedSceneObjectInfo& soInfo = anim->sceneObjectInfos[i];
+	bool AnimationManager::updateVisibilityAndLOD(AnimationProxy& anim) const
+	{
+		bool hasLODs = !anim.lods.empty();
+		if (!anim.mCullEnabled && !hasLODs)
+		{
+			anim.lodFrameInterval = 1;
+			anim.lodMaxBoneDepth = (UINT32)-1;
 
-					if (soInfo.boneIdx == -1)
-						continue;
+			return true;
+		}
 
-					boneDst[soInfo.boneIdx] = anim->sceneObjectTransforms[boneTfrmIdx];
-					anim->skeletonPose.hasOverride[soInfo.boneIdx] = true;
-					boneTfrmIdx++;
-				}
+		Vector3 center = anim.mBounds.getCenter();
+		float radius = anim.mBounds.getRadius();
 
-				// Animate bones
-				anim->skeleton->getPose(boneDst, anim->skeletonPose, anim->skeletonMask, anim->layers, anim->numLayers);
+		bool isVisible = !anim.mCullEnabled;
+		float screenSize = 0.0f;
+		for(UINT32 i = 0; i < (UINT32)mCullFrustums.size(); i++)
+		{
+			if (anim.mCullEnabled && !mCullFrustums[i].intersects(anim.mBounds))
+				continue;
 
-				curBoneIdx += numBones;
-				hasAnimInfo = true;
-			}
-			else
+			isVisible = true;
+			if (!hasLODs)
+				break;
+
+			// The closest camera is the one the bounds appear largest in
+			const LODCameraInfo& camera = mLODCameras[i];
+			if(camera.perspective)
 			{
-				RendererAnimationData::PoseInfo& poseInfo = animInfo.poseInfo;
-				poseInfo.animId = anim->id;
-				poseInfo.startIdx = 0;
-				poseInfo.numBones = 0;
+				float distance = camera.position.distance(center);
+				if (distance > radius)
+					screenSize = std::max(screenSize, radius * camera.screenScale / distance);
+				else
+					screenSize = std::numeric_limits<float>::max();
 			}
+			else
+				screenSize = std::max(screenSize, radius * camera.screenScale);
+		}
 
-			// Reset mapped SO transform
-			for (UINT32 i = 0; i < anim->sceneObjectPose.numBones; i++)
+		if (hasLODs)
+		{
+			// LODs are sorted from largest to smallest, fall back to the smallest one
+			const AnimationLOD* lod = &anim.lods.back();
+			for(auto& entry : anim.lods)
 			{
-				anim->sceneObjectPose.positions[i] = Vector3::ZERO;
-				anim->sceneObjectPose.rotations[i] = Quaternion::IDENTITY;
-				anim->sceneObjectPose.scales[i] = Vector3::ONE;
+				if(screenSize >= entry.screenSize)
+				{
+					lod = &entry;
+					break;
+				}
 			}
 
-			// Update mapped scene objects
-			memset(anim->sceneObjectPose.hasOverride, 1, sizeof(bool) * anim->numSceneObjects);
+			anim.lodFrameInterval = lod->frameInterval;
+			anim.lodMaxBoneDepth = lod->maxBoneDepth;
+		}
+		else
+		{
+			anim.lodFrameInterval = 1;
+			anim.lodMaxBoneDepth = (UINT32)-1;
+		}
+
+		return isVisible;
+	}
+
+	bool AnimationManager::evaluateProxy(const SPtr<AnimationProxy>& anim, UINT32 boneIdx, 
+		RendererAnimationData& renderData, const RendererAnimationData& prevRenderData, 
+		RendererAnimationData::AnimInfo& animInfo)
+	{
+		bool hasAnimInfo = false;
+
+		// Evaluate skeletal animation
+		if (anim->skeleton != nullptr)
+		{
+			UINT32 numBones = anim->skeleton->getNumBones();
+
+			RendererAnimationData::PoseInfo& poseInfo = animInfo.poseInfo;
+			poseInfo.animId = anim->id;
+			poseInfo.startIdx = boneIdx;
+			poseInfo.numBones = numBones;
+
+			memset(anim->skeletonPose.hasOverride, 0, sizeof(bool) * anim->skeletonPose.numBones);
+			Matrix4* boneDst = renderData.transforms.data() + boneIdx;
 
-			// Update scene object transforms
+			// Copy transforms from mapped scene objects
+			UINT32 boneTfrmIdx = 0;
 			for(UINT32 i = 0; i < anim->numSceneObjects; i++)
 			{
 				const AnimatedSceneObjectInfo& soInfo = anim->sceneObjectInfos[i];
 
-				// We already evaluated bones
-				if (soInfo.boneIdx != -1)
+				if (soInfo.boneIdx == -1)
 					continue;
 
-				if (soInfo.layerIdx == (UINT32)-1 || soInfo.stateIdx == (UINT32)-1)
-					continue;
+				boneDst[soInfo.boneIdx] = anim->sceneObjectTransforms[boneTfrmIdx];
+				anim->skeletonPose.hasOverride[soInfo.boneIdx] = true;
+				boneTfrmIdx++;
+			}
 
-				const AnimationState& state = anim->layers[soInfo.layerIdx].states[soInfo.stateIdx];
-				if (state.disabled)
-					continue;
+			// Animate bones. Bones deeper than the LOD allows keep their previous local transform, which requires a pose
+			// to have been evaluated before.
+			UINT32 maxBoneDepth = anim->skeletonPoseValid ? anim->lodMaxBoneDepth : (UINT32)-1;
+			UINT32 frameInterval = anim->lodFrameInterval;
+
+			if(frameInterval == 1)
+			{
+				anim->skeleton->getPose(boneDst, anim->skeletonPose, anim->skeletonMask, anim->layers, anim->numLayers,
+					maxBoneDepth);
+
+				anim->skeletonPoseValid = true;
+				anim->lodNumCachedPoses = 0;
+			}
+			else
+			{
+				// Evaluate the skeleton once every frameInterval updates (or only once if frozen), and interpolate between
+				// the two most recently evaluated poses in between. This means the displayed pose lags a single interval
+				// behind the animation time, but transitions smoothly between evaluations.
+				bool evaluate = anim->lodNumCachedPoses == 0 || 
+					(frameInterval != 0 && (anim->lodFramesSinceEval + 1) >= frameInterval);
+
+				if(evaluate)
+				{
+					std::swap(anim->lodPoses[0], anim->lodPoses[1]);
+
+					anim->skeleton->getPose(boneDst, anim->skeletonPose, anim->skeletonMask, anim->layers, 
+						anim->numLayers, maxBoneDepth);
+
+					LocalSkeletonPose& newestPose = anim->lodPoses[1];
+					memcpy(newestPose.positions, anim->skeletonPose.positions, sizeof(Vector3) * numBones);
+					memcpy(newestPose.rotations, anim->skeletonPose.rotations, sizeof(Quaternion) * numBones);
+					memcpy(newestPose.scales, anim->skeletonPose.scales, sizeof(Vector3) * numBones);
+
+					anim->skeletonPoseValid = true;
+					anim->lodNumCachedPoses = std::min(anim->lodNumCachedPoses + 1, 2U);
+					anim->lodFramesSinceEval = 0;
+				}
+				else if(frameInterval != 0)
+					anim->lodFramesSinceEval++;
+
+				// If only a single pose was evaluated so far there is nothing to interpolate, and if it was evaluated
+				// this update the output is already up to date
+				if(!evaluate || anim->lodNumCachedPoses > 1)
+				{
+					const LocalSkeletonPose& from = anim->lodNumCachedPoses > 1 ? anim->lodPoses[0] : anim->lodPoses[1];
+					const LocalSkeletonPose& to = anim->lodPoses[1];
+
+					float t = frameInterval != 0 ? anim->lodFramesSinceEval / (float)frameInterval : 1.0f;
+					anim->skeleton->getPose(boneDst, anim->skeletonPose, from, to, t);
+				}
+			}
+
+			hasAnimInfo = true;
+		}
+		else
+		{
+			RendererAnimationData::PoseInfo& poseInfo = animInfo.poseInfo;
+			poseInfo.animId = anim->id;
+			poseInfo.startIdx = 0;
+			poseInfo.numBones = 0;
+		}
+
+		// Reset mapped SO transform
+		for (UINT32 i = 0; i < anim->sceneObjectPose.numBones; i++)
+		{
+			anim->sceneObjectPose.positions[i] = Vector3::ZERO;
+			anim->sceneObjectPose.rotations[i] = Quaternion::IDENTITY;
+			anim->sceneObjectPose.scales[i] = Vector3::ONE;
+		}
+
+		// Update mapped scene objects
+		memset(anim->sceneObjectPose.hasOverride, 1, sizeof(bool) * anim->numSceneObjects);
+
+		// Update scene object transforms
+		for(UINT32 i = 0; i < anim->numSceneObjects; i++)
+		{
+			const AnimatedSceneObjectInfo& soInfo = anim->sceneObjectInfos[i];
+
+			// We already evaluated bones
+			if (soInfo.boneIdx != -1)
+				continue;
+
+			if (soInfo.layerIdx == (UINT32)-1 || soInfo.stateIdx == (UINT32)-1)
+				continue;
+
+			const AnimationState& state = anim->layers[soInfo.layerIdx].states[soInfo.stateIdx];
+			if (state.disabled)
+				continue;
+
+			const CompressedAnimationCurves* compressedCurves = state.compressedCurves.get();
+			if (compressedCurves != nullptr)
+				compressedCurves->seek(state.time, state.loop, state.compressedCursor);
 
+			{
+				UINT32 curveIdx = soInfo.curveIndices.position;
+				if (curveIdx != (UINT32)-1)
 				{
-					UINT32 curveIdx = soInfo.curveIndices.position;
-					if (curveIdx != (UINT32)-1)
+					if (compressedCurves != nullptr)
+						anim->sceneObjectPose.positions[curveIdx] = compressedCurves->evaluatePosition(curveIdx, state.compressedCursor);
+					else
 					{
 						const TAnimationCurve<Vector3>& curve = state.curves->position[curveIdx].curve;
 						anim->sceneObjectPose.positions[curveIdx] = curve.evaluate(state.time, state.positionCaches[curveIdx], state.loop);
-						anim->sceneObjectPose.hasOverride[curveIdx] = false;
 					}
+
+					anim->sceneObjectPose.hasOverride[curveIdx] = false;
 				}
+			}
 
+			{
+				UINT32 curveIdx = soInfo.curveIndices.rotation;
+				if (curveIdx != (UINT32)-1)
 				{
-					UINT32 curveIdx = soInfo.curveIndices.rotation;
-					if (curveIdx != (UINT32)-1)
+					if (compressedCurves != nullptr)
+						anim->sceneObjectPose.rotations[curveIdx] = compressedCurves->evaluateRotation(curveIdx, state.compressedCursor);
+					else
 					{
 						const TAnimationCurve<Quaternion>& curve = state.curves->rotation[curveIdx].curve;
 						anim->sceneObjectPose.rotations[curveIdx] = curve.evaluate(state.time, state.rotationCaches[curveIdx], state.loop);
-						anim->sceneObjectPose.rotations[curveIdx].normalize();
-						anim->sceneObjectPose.hasOverride[curveIdx] = false;
 					}
+
+					anim->sceneObjectPose.rotations[curveIdx].normalize();
+					anim->sceneObjectPose.hasOverride[curveIdx] = false;
 				}
+			}
 
+			{
+				UINT32 curveIdx = soInfo.curveIndices.scale;
+				if (curveIdx != (UINT32)-1)
 				{
-					UINT32 curveIdx = soInfo.curveIndices.scale;
-					if (curveIdx != (UINT32)-1)
+					if (compressedCurves != nullptr)
+						anim->sceneObjectPose.scales[curveIdx] = compressedCurves->evaluateScale(curveIdx, state.compressedCursor);
+					else
 					{
 						const TAnimationCurve<Vector3>& curve = state.curves->scale[curveIdx].curve;
 						anim->sceneObjectPose.scales[curveIdx] = curve.evaluate(state.time, state.scaleCaches[curveIdx], state.loop);
-						anim->sceneObjectPose.hasOverride[curveIdx] = false;
 					}
+
+					anim->sceneObjectPose.hasOverride[curveIdx] = false;
 				}
 			}
+		}
 
-			// Update generic curves
-			// Note: No blending for generic animations, just use first animation
-			if (anim->numLayers > 0 && anim->layers[0].numStates > 0)
+		// Update generic curves
+		// Note: No blending for generic animations, just use first animation
+		if (anim->numLayers > 0 && anim->layers[0].numStates > 0)
+		{
+			const AnimationState& state = anim->layers[0].states[0];
+			if (!state.disabled)
 			{
-				const AnimationState& state = anim->layers[0].states[0];
-				if (!state.disabled)
+				UINT32 numCurves = (UINT32)state.curves->generic.size();
+				for (UINT32 i = 0; i < numCurves; i++)
 				{
-					UINT32 numCurves = (UINT32)state.curves->generic.size();
-					for (UINT32 i = 0; i < numCurves; i++)
-					{
-						const TAnimationCurve<float>& curve = state.curves->generic[i].curve;
-						anim->genericCurveOutputs[i] = curve.evaluate(state.time, state.genericCaches[i], state.loop);
-					}
+					const TAnimationCurve<float>& curve = state.curves->generic[i].curve;
+					anim->genericCurveOutputs[i] = curve.evaluate(state.time, state.genericCaches[i], state.loop);
 				}
 			}
+		}
 
-			// Update morph shapes
-			if(anim->numMorphShapes > 0)
+		// Update morph shapes
+		if(anim->numMorphShapes > 0)
+		{
+			auto iterFind = prevRenderData.infos.find(anim->id);
+			if (iterFind != prevRenderData.infos.end())
+				animInfo.morphShapeInfo = iterFind->second.morphShapeInfo;
+			else
+				animInfo.morphShapeInfo.version = 1; // 0 is considered invalid version
+
+			// Recalculate weights if curves are present
+			bool hasMorphCurves = false;
+			for(UINT32 i = 0; i < anim->numMorphChannels; i++)
 			{
-				auto iterFind = prevRenderData.infos.find(anim->id);
-				if (iterFind != prevRenderData.infos.end())
-					animInfo.morphShapeInfo = iterFind->second.morphShapeInfo;
+				MorphChannelInfo& channelInfo = anim->morphChannelInfos[i];
+				if(channelInfo.weightCurveIdx != (UINT32)-1)
+				{
+					channelInfo.weight = Math::clamp01(anim->genericCurveOutputs[channelInfo.weightCurveIdx]);
+					hasMorphCurves = true;
+				}
+
+				float frameWeight;
+				if (channelInfo.frameCurveIdx != (UINT32)-1)
+				{
+					frameWeight = Math::clamp01(anim->genericCurveOutputs[channelInfo.frameCurveIdx]);
+					hasMorphCurves = true;
+				}
 				else
-					animInfo.morphShapeInfo.version = 1; // 0 is considered invalid version
+					frameWeight = 0.0f;
 
-				// Recalculate weights if curves are present
-				bool hasMorphCurves = false;
-				for(UINT32 i = 0; i < anim->numMorphChannels; i++)
+				if(channelInfo.shapeCount == 1)
 				{
-					MorphChannelInfo& channelInfo = anim->morphChannelInfos[i];
-					if(channelInfo.weightCurveIdx != (UINT32)-1)
-					{
-						channelInfo.weight = Math::clamp01(anim->genericCurveOutputs[channelInfo.weightCurveIdx]);
-						hasMorphCurves = true;
-					}
+					MorphShapeInfo& shapeInfo = anim->morphShapeInfos[channelInfo.shapeStart];
 
-					float frameWeight;
-					if (channelInfo.frameCurveIdx != (UINT32)-1)
+					// Blend between base shape and the only available frame
+					float relative = frameWeight - shapeInfo.frameWeight;
+					if (relative <= 0.0f)
 					{
-						frameWeight = Math::clamp01(anim->genericCurveOutputs[channelInfo.frameCurveIdx]);
-						hasMorphCurves = true;
+						float diff = shapeInfo.frameWeight;
+						if (diff > 0.0f)
+						{
+							float t = -relative / diff;
+							shapeInfo.finalWeight = 1.0f - std::min(t, 1.0f);
+						}
+						else
+							shapeInfo.finalWeight = 1.0f;
 					}
-					else
-						frameWeight = 0.0f;
-
-					if(channelInfo.shapeCount == 1)
+					else // If past the final frame we clamp
+						shapeInfo.finalWeight = 1.0f;
+				}
+				else if(channelInfo.shapeCount > 1)
+				{
+					for(UINT32 j = 0; j < channelInfo.shapeCount - 1; j++)
 					{
-						MorphShapeInfo& shapeInfo = anim->morphShapeInfos[channelInfo.shapeStart];
+						float prevShapeWeight;
+						if (j > 0)
+							prevShapeWeight = anim->morphShapeInfos[j - 1].frameWeight;
+						else
+							prevShapeWeight = 0.0f; // Base shape, blend between it and the first frame
+
+						float nextShapeWeight = anim->morphShapeInfos[j + 1].frameWeight;
+						MorphShapeInfo& shapeInfo = anim->morphShapeInfos[j];
 
-						// Blend between base shape and the only available frame
 						float relative = frameWeight - shapeInfo.frameWeight;
 						if (relative <= 0.0f)
 						{
-							float diff = shapeInfo.frameWeight;
+							float diff = shapeInfo.frameWeight - prevShapeWeight;
 							if (diff > 0.0f)
 							{
 								float t = -relative / diff;
@@ -318,157 +539,126 @@ namespace bs
 							else
 								shapeInfo.finalWeight = 1.0f;
 						}
-						else // If past the final frame we clamp
-							shapeInfo.finalWeight = 1.0f;
-					}
-					else if(channelInfo.shapeCount > 1)
-					{
-						for(UINT32 j = 0; j < channelInfo.shapeCount - 1; j++)
+						else
 						{
-							float prevShapeWeight;
-							if (j > 0)
-								prevShapeWeight = anim->morphShapeInfos[j - 1].frameWeight;
-							else
-								prevShapeWeight = 0.0f; // Base shape, blend between it and the first frame
-
-							float nextShapeWeight = anim->morphShapeInfos[j + 1].frameWeight;
-							MorphShapeInfo& shapeInfo = anim->morphShapeInfos[j];
-
-							float relative = frameWeight - shapeInfo.frameWeight;
-							if (relative <= 0.0f)
+							float diff = nextShapeWeight - shapeInfo.frameWeight;
+							if (diff > 0.0f)
 							{
-								float diff = shapeInfo.frameWeight - prevShapeWeight;
-								if (diff > 0.0f)
-								{
-									float t = -relative / diff;
-									shapeInfo.finalWeight = 1.0f - std::min(t, 1.0f);
-								}
-								else
-									shapeInfo.finalWeight = 1.0f;
+								float t = relative / diff;
+								shapeInfo.finalWeight = std::min(t, 1.0f);
 							}
 							else
-							{
-								float diff = nextShapeWeight - shapeInfo.frameWeight;
-								if (diff > 0.0f)
-								{
-									float t = relative / diff;
-									shapeInfo.finalWeight = std::min(t, 1.0f);
-								}
-								else
-									shapeInfo.finalWeight = 0.0f;
-							}
+								shapeInfo.finalWeight = 0.0f;
 						}
+					}
 
-						// Last frame
-						{
-							UINT32 lastFrame = channelInfo.shapeStart + channelInfo.shapeCount - 1;
-							MorphShapeInfo& prevShapeInfo = anim->morphShapeInfos[lastFrame - 1];
-							MorphShapeInfo& shapeInfo = anim->morphShapeInfos[lastFrame];
+					// Last frame
+					{
+						UINT32 lastFrame = channelInfo.shapeStart + channelInfo.shapeCount - 1;
+						MorphShapeInfo& prevShapeInfo = anim->morphShapeInfos[lastFrame - 1];
+						MorphShapeInfo& shapeInfo = anim->morphShapeInfos[lastFrame];
 
-							float relative = frameWeight - shapeInfo.frameWeight;
-							if (relative <= 0.0f)
+						float relative = frameWeight - shapeInfo.frameWeight;
+						if (relative <= 0.0f)
+						{
+							float diff = shapeInfo.frameWeight - prevShapeInfo.frameWeight;
+							if (diff > 0.0f)
 							{
-								float diff = shapeInfo.frameWeight - prevShapeInfo.frameWeight;
-								if (diff > 0.0f)
-								{
-									float t = -relative / diff;
-									shapeInfo.finalWeight = 1.0f - std::min(t, 1.0f);
-								}
-								else
-									shapeInfo.finalWeight = 1.0f;
+								float t = -relative / diff;
+								shapeInfo.finalWeight = 1.0f - std::min(t, 1.0f);
 							}
-							else // If past the final frame we clamp
+							else
 								shapeInfo.finalWeight = 1.0f;
 						}
-					}
-
-					for(UINT32 j = 0; j < channelInfo.shapeCount; j++)
-					{
-						MorphShapeInfo& shapeInfo = anim->morphShapeInfos[channelInfo.shapeStart + j];
-						shapeInfo.finalWeight *= channelInfo.weight;
+						else // If past the final frame we clamp
+							shapeInfo.finalWeight = 1.0f;
 					}
 				}
 
-				// Generate morph shape vertices
-				if(anim->morphChannelWeightsDirty || hasMorphCurves)
+				for(UINT32 j = 0; j < channelInfo.shapeCount; j++)
 				{
-					SPtr<MeshData> meshData = bs_shared_ptr_new<MeshData>(anim->numMorphVertices, 0, mBlendShapeVertexDesc);
-
-					UINT8* bufferData = meshData->getData();
-					memset(bufferData, 0, meshData->getSize());
+					MorphShapeInfo& shapeInfo = anim->morphShapeInfos[channelInfo.shapeStart + j];
+					shapeInfo.finalWeight *= channelInfo.weight;
+				}
+			}
 
-					UINT32 tempDataSize = (sizeof(Vector3) + sizeof(float)) * anim->numMorphVertices;
-					UINT8* tempData = (UINT8*)bs_stack_alloc(tempDataSize);
-					memset(tempData, 0, tempDataSize);
+			// Generate morph shape vertices
+			if(anim->morphChannelWeightsDirty || hasMorphCurves)
+			{
+				SPtr<MeshData> meshData = bs_shared_ptr_new<MeshData>(anim->numMorphVertices, 0, mBlendShapeVertexDesc);
 
-					Vector3* tempNormals = (Vector3*)tempData;
-					float* accumulatedWeight = (float*)(tempData + sizeof(Vector3) * anim->numMorphVertices);
+				UINT8* bufferData = meshData->getData();
+				memset(bufferData, 0, meshData->getSize());
 
-					UINT8* positions = meshData->getElementData(VES_POSITION, 1, 1);
-					UINT8* normals = meshData->getElementData(VES_NORMAL, 1, 1);
+				// Proxies are evaluated on worker threads, use the scratch memory of the current one
+				FrameAlloc& frameAlloc = ThreadFrameAlloc::get();
 
-					UINT32 stride = mBlendShapeVertexDesc->getVertexStride(1);
+				UINT32 tempDataSize = (sizeof(Vector3) + sizeof(float)) * anim->numMorphVertices;
+				UINT8* tempData = frameAlloc.alloc(tempDataSize);
+				memset(tempData, 0, tempDataSize);
 
-					for(UINT32 i = 0; i < anim->numMorphShapes; i++)
-					{
-						const MorphShapeInfo& info = anim->morphShapeInfos[i];
-						float absWeight = Math::abs(info.finalWeight);
+				Vector3* tempNormals = (Vector3*)tempData;
+				float* accumulatedWeight = (float*)(tempData + sizeof(Vector3) * anim->numMorphVertices);
 
-						if (absWeight < 0.0001f)
-							continue;
+				UINT8* positions = meshData->getElementData(VES_POSITION, 1, 1);
+				UINT8* normals = meshData->getElementData(VES_NORMAL, 1, 1);
 
-						const Vector<MorphVertex>& morphVertices = info.shape->getVertices();
-						UINT32 numVertices = (UINT32)morphVertices.size();
-						for(UINT32 j = 0; j < numVertices; j++)
-						{
-							const MorphVertex& vertex = morphVertices[j];
+				UINT32 stride = mBlendShapeVertexDesc->getVertexStride(1);
 
-							Vector3* destPos = (Vector3*)(positions + vertex.sourceIdx * stride);
-							*destPos += vertex.deltaPosition * info.finalWeight;
+				for(UINT32 i = 0; i < anim->numMorphShapes; i++)
+				{
+					const MorphShapeInfo& info = anim->morphShapeInfos[i];
+					float absWeight = Math::abs(info.finalWeight);
 
-							tempNormals[vertex.sourceIdx] += vertex.deltaNormal * info.finalWeight;
-							accumulatedWeight[vertex.sourceIdx] += absWeight;
-						}
-					}
+					if (absWeight < 0.0001f)
+						continue;
 
-					for(UINT32 i = 0; i < anim->numMorphVertices; i++)
+					const Vector<MorphVertex>& morphVertices = info.shape->getVertices();
+					UINT32 numVertices = (UINT32)morphVertices.size();
+					for(UINT32 j = 0; j < numVertices; j++)
 					{
-						PackedNormal* destNrm = (PackedNormal*)(normals + i * stride);
+						const MorphVertex& vertex = morphVertices[j];
 
-						if (accumulatedWeight[i] > 0.0001f)
-						{
-							Vector3 normal = tempNormals[i] / accumulatedWeight[i];
-							normal /= 2.0f; // Accumulated normal is in range [-2, 2] but our normal packing method assumes [-1, 1] range
+						Vector3* destPos = (Vector3*)(positions + vertex.sourceIdx * stride);
+						*destPos += vertex.deltaPosition * info.finalWeight;
 
-							MeshUtility::packNormals(&normal, (UINT8*)destNrm, 1, sizeof(Vector3), stride);
-							destNrm->w = (UINT8)(std::min(1.0f, accumulatedWeight[i]) * 255.999f);
-						}
-						else
-						{
-							*destNrm = { 127, 127, 127, 0 };
-						}
+						tempNormals[vertex.sourceIdx] += vertex.deltaNormal * info.finalWeight;
+						accumulatedWeight[vertex.sourceIdx] += absWeight;
 					}
+				}
 
-					bs_stack_free(tempData);
+				for(UINT32 i = 0; i < anim->numMorphVertices; i++)
+				{
+					PackedNormal* destNrm = (PackedNormal*)(normals + i * stride);
 
-					animInfo.morphShapeInfo.meshData = meshData;
+					if (accumulatedWeight[i] > 0.0001f)
+					{
+						Vector3 normal = tempNormals[i] / accumulatedWeight[i];
+						normal /= 2.0f; // Accumulated normal is in range [-2, 2] but our normal packing method assumes [-1, 1] range
 
-					animInfo.morphShapeInfo.version++;
-					anim->morphChannelWeightsDirty = false;
+						MeshUtility::packNormals(&normal, (UINT8*)destNrm, 1, sizeof(Vector3), stride);
+						destNrm->w = (UINT8)(std::min(1.0f, accumulatedWeight[i]) * 255.999f);
+					}
+					else
+					{
+						*destNrm = { 127, 127, 127, 0 };
+					}
 				}
 
-				hasAnimInfo = true;
+				frameAlloc.dealloc(tempData);
+
+				animInfo.morphShapeInfo.meshData = meshData;
+
+				animInfo.morphShapeInfo.version++;
+				anim->morphChannelWeightsDirty = false;
 			}
-			else
-				animInfo.morphShapeInfo.version = 1;
 
-			if (hasAnimInfo)
-				renderData.infos[anim->id] = animInfo;
+			hasAnimInfo = true;
 		}
+		else
+			animInfo.morphShapeInfo.version = 1;
 
-		// Increments counter and ensures all writes are recorded
-		mWorkerState.store(WorkerState::DataReady, std::memory_order_release);
-		mDataReadyCount.fetch_add(1, std::memory_order_acq_rel);
+		return hasAnimInfo;
 	}
 
 	void AnimationManager::waitUntilComplete()
@@ -9,10 +9,10 @@ namespace bs
 {
 #if BS_DEBUG_MODE
 	CommandQueueBase::CommandQueueBase(ThreadId threadId)
-		:mMyThreadId(threadId), mMaxDebugIdx(0)
+		: mFirstBlock(nullptr), mLastBlock(nullptr), mNumCommands(0), mReturnedBlocksStart(0), mReturnedBlocksEnd(0)
+		, mMyThreadId(threadId), mMaxDebugIdx(0)
 	{
 		mAsyncOpSyncData = bs_shared_ptr_new<AsyncOpSyncData>();
-		mCommands = bs_new<bs::Queue<QueuedCommand>>();
 
 		{
 			Lock lock(CommandQueueBreakpointMutex);
@@ -22,140 +22,214 @@ namespace bs
 	}
 #else
 	CommandQueueBase::CommandQueueBase(ThreadId threadId)
-		:mMyThreadId(threadId)
+		: mFirstBlock(nullptr), mLastBlock(nullptr), mNumCommands(0), mReturnedBlocksStart(0), mReturnedBlocksEnd(0)
+		, mMyThreadId(threadId)
 	{
 		mAsyncOpSyncData = bs_shared_ptr_new<AsyncOpSyncData>();
-		mCommands = bs_new<bs::Queue<QueuedCommand>>();
 	}
 #endif
 
 	CommandQueueBase::~CommandQueueBase()
 	{
-		if(mCommands != nullptr)
-			bs_delete(mCommands);
+		destroyCommands(mFirstBlock);
 
-		while(!mEmptyCommandQueues.empty())
-		{
-			bs_delete(mEmptyCommandQueues.top());
-			mEmptyCommandQueues.pop();
-		}
+		for(auto& block : mFreeBlocks)
+			bs_free(block);
+
+		UINT32 end = mReturnedBlocksEnd.load(std::memory_order_acquire);
+		for(UINT32 i = mReturnedBlocksStart.load(std::memory_order_relaxed); i != end; i++)
+			bs_free(mReturnedBlocks[i % MAX_RETURNED_BLOCKS]);
 	}
 
-	AsyncOp CommandQueueBase::queueReturn(std::function<void(AsyncOp&)> commandCallback, bool _notifyWhenComplete, UINT32 _callbackId)
+	QueuedCommand* CommandQueueBase::allocCommand(UINT32 callbackSize, bool returnsValue, bool notifyWhenComplete, 
+		UINT32 callbackId)
 	{
 #if BS_DEBUG_MODE
 		breakIfNeeded(mCommandQueueIdx, mMaxDebugIdx);
-
-		QueuedCommand newCommand(commandCallback, mMaxDebugIdx++, mAsyncOpSyncData, _notifyWhenComplete, _callbackId);
-#else
-		QueuedCommand newCommand(commandCallback, mAsyncOpSyncData, _notifyWhenComplete, _callbackId);
 #endif
 
-		mCommands->push(newCommand);
+		UINT32 size = QueuedCommand::getHeaderSize() + QueuedCommand::alignSize(callbackSize);
+		if(mLastBlock == nullptr || (mLastBlock->size + size) > mLastBlock->capacity)
+		{
+			CommandBlock* block = allocBlock(size);
 
-#if BS_FORCE_SINGLETHREADED_RENDERING
-		Queue<QueuedCommand>* commands = flush();
-		playback(commands);
-#endif
+			if (mLastBlock != nullptr)
+				mLastBlock->next = block;
+			else
+				mFirstBlock = block;
 
-		return newCommand.asyncOp;
-	}
+			mLastBlock = block;
+		}
 
-	void CommandQueueBase::queue(std::function<void()> commandCallback, bool _notifyWhenComplete, UINT32 _callbackId)
-	{
-#if BS_DEBUG_MODE
-		breakIfNeeded(mCommandQueueIdx, mMaxDebugIdx);
+		QueuedCommand* command = new (mLastBlock->getData() + mLastBlock->size) 
+			QueuedCommand(returnsValue, notifyWhenComplete, callbackId);
+		command->size = size;
 
-		QueuedCommand newCommand(commandCallback, mMaxDebugIdx++, _notifyWhenComplete, _callbackId);
-#else
-		QueuedCommand newCommand(commandCallback, _notifyWhenComplete, _callbackId);
+		if(returnsValue)
+			command->asyncOp = AsyncOp(mAsyncOpSyncData);
+
+#if BS_DEBUG_MODE
+		command->debugId = mMaxDebugIdx++;
 #endif
 
-		mCommands->push(newCommand);
+		mLastBlock->size += size;
+		mNumCommands++;
 
+		return command;
+	}
+
+	void CommandQueueBase::onCommandQueued()
+	{
 #if BS_FORCE_SINGLETHREADED_RENDERING
-		Queue<QueuedCommand>* commands = flush();
+		CommandBlock* commands = flush();
 		playback(commands);
 #endif
 	}
 
-	bs::Queue<QueuedCommand>* CommandQueueBase::flush()
+	CommandBlock* CommandQueueBase::allocBlock(UINT32 size)
 	{
-		bs::Queue<QueuedCommand>* oldCommands = mCommands;
-
-		if(!mEmptyCommandQueues.empty())
+		CommandBlock* block = nullptr;
+		if(size <= BLOCK_SIZE)
 		{
-			mCommands = mEmptyCommandQueues.top();
-			mEmptyCommandQueues.pop();
+			// Grab any blocks the executing thread is done with
+			UINT32 start = mReturnedBlocksStart.load(std::memory_order_relaxed);
+			UINT32 end = mReturnedBlocksEnd.load(std::memory_order_acquire);
+
+			for(; start != end; start++)
+				mFreeBlocks.push_back(mReturnedBlocks[start % MAX_RETURNED_BLOCKS]);
+
+			mReturnedBlocksStart.store(start, std::memory_order_release);
+
+			if(!mFreeBlocks.empty())
+			{
+				block = mFreeBlocks.back();
+				mFreeBlocks.pop_back();
+			}
+			else
+			{
+				block = (CommandBlock*)bs_alloc(QueuedCommand::alignSize((UINT32)sizeof(CommandBlock)) + BLOCK_SIZE);
+				block->capacity = BLOCK_SIZE;
+			}
 		}
-		else
+		else // Command too large for a normal block, allocate a one-off block
 		{
-			mCommands = bs_new<bs::Queue<QueuedCommand>>();
+			block = (CommandBlock*)bs_alloc(QueuedCommand::alignSize((UINT32)sizeof(CommandBlock)) + size);
+			block->capacity = size;
 		}
 
-		return oldCommands;
+		block->next = nullptr;
+		block->size = 0;
+
+		return block;
 	}
 
-	void CommandQueueBase::playbackWithNotify(bs::Queue<QueuedCommand>* commands, std::function<void(UINT32)> notifyCallback)
+	void CommandQueueBase::releaseBlock(CommandBlock* block)
 	{
-		THROW_IF_NOT_CORE_THREAD;
+		if(block->capacity == BLOCK_SIZE)
+		{
+			UINT32 start = mReturnedBlocksStart.load(std::memory_order_acquire);
+			UINT32 end = mReturnedBlocksEnd.load(std::memory_order_relaxed);
+
+			if((end - start) < MAX_RETURNED_BLOCKS)
+			{
+				mReturnedBlocks[end % MAX_RETURNED_BLOCKS] = block;
+				mReturnedBlocksEnd.store(end + 1, std::memory_order_release);
+
+				return;
+			}
+		}
 
-		if(commands == nullptr)
-			return;
+		bs_free(block);
+	}
 
-		while(!commands->empty())
+	void CommandQueueBase::destroyCommands(CommandBlock* commands)
+	{
+		while(commands != nullptr)
 		{
-			QueuedCommand& command = commands->front();
+			UINT8* data = commands->getData();
+			for(UINT32 offset = 0; offset < commands->size;)
+			{
+				QueuedCommand* command = (QueuedCommand*)(data + offset);
+				offset += command->size;
+
+				command->invoke(command, false);
+				command->~QueuedCommand();
+			}
+
+			CommandBlock* next = commands->next;
+			commands->next = nullptr;
+			commands->size = 0;
+
+			if (commands->capacity == BLOCK_SIZE)
+				mFreeBlocks.push_back(commands);
+			else
+				bs_free(commands);
+
+			commands = next;
+		}
+	}
+
+	CommandBlock* CommandQueueBase::flush()
+	{
+		CommandBlock* commands = mFirstBlock;
+
+		mFirstBlock = nullptr;
+		mLastBlock = nullptr;
+		mNumCommands = 0;
+
+		return commands;
+	}
 
-			if(command.returnsValue)
+	void CommandQueueBase::playbackWithNotify(CommandBlock* commands, std::function<void(UINT32)> notifyCallback)
+	{
+		THROW_IF_NOT_CORE_THREAD;
+
+		while(commands != nullptr)
+		{
+			UINT8* data = commands->getData();
+			for(UINT32 offset = 0; offset < commands->size;)
 			{
-				AsyncOp& op = command.asyncOp;
-				command.callbackWithReturnValue(op);
+				QueuedCommand* command = (QueuedCommand*)(data + offset);
+				offset += command->size;
+
+				command->invoke(command, true);
 
-				if(!command.asyncOp.hasCompleted())
+				if(command->returnsValue && !command->asyncOp.hasCompleted())
 				{
 					LOGDBG("Async operation return value wasn't resolved properly. Resolving automatically to nullptr. " \
 						"Make sure to complete the operation before returning from the command callback method.");
-					command.asyncOp._completeOperation(nullptr);
+					command->asyncOp._completeOperation(nullptr);
 				}
-			}
-			else
-			{
-				command.callback();
-			}
 
-			if(command.notifyWhenComplete && notifyCallback != nullptr)
-			{
-				notifyCallback(command.callbackId);
+				if(command->notifyWhenComplete && notifyCallback != nullptr)
+				{
+					notifyCallback(command->callbackId);
+				}
+
+				command->~QueuedCommand();
 			}
 
-			commands->pop();
-		}
+			CommandBlock* next = commands->next;
+			releaseBlock(commands);
 
-		mEmptyCommandQueues.push(commands);
+			commands = next;
+		}
 	}
 
-	void CommandQueueBase::playback(bs::Queue<QueuedCommand>* commands)
+	void CommandQueueBase::playback(CommandBlock* commands)
 	{
 		playbackWithNotify(commands, std::function<void(UINT32)>());
 	}
 
 	void CommandQueueBase::cancelAll()
 	{
-		bs::Queue<QueuedCommand>* commands = flush();
-
-		while(!commands->empty())
-			commands->pop();
-
-		mEmptyCommandQueues.push(commands);
+		CommandBlock* commands = flush();
+		destroyCommands(commands);
 	}
 
 	bool CommandQueueBase::isEmpty()
 	{
-		if(mCommands != nullptr && mCommands->size() > 0)
-			return false;
-
-		return true;
+		return mNumCommands == 0;
 	}
 
 	void CommandQueueBase::throwInvalidThreadException(const String& message) const
@@ -7,11 +7,13 @@
 namespace bs
 {
 	Component::Component()
-		:mNotifyFlags(TCF_None), mSceneManagerId(-1)
+		:mNotifyFlags(TCF_None), mSceneManagerId(-1), mUpdateGroupId(-1), mUpdateGroupIdx(-1)
+		, mPendingNotifyFlags(TCF_None)
 	{ }
 
 	Component::Component(const HSceneObject& parent)
-		:mNotifyFlags(TCF_None), mParent(parent), mSceneManagerId(-1)
+		:mNotifyFlags(TCF_None), mSceneManagerId(-1), mUpdateGroupId(-1), mUpdateGroupIdx(-1), mParent(parent)
+		, mPendingNotifyFlags(TCF_None)
 	{
 		setName("Component");
 	}
@@ -0,0 +1,523 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#include "BsCompressedAnimationCurves.h"
+#include "BsCompressedAnimationCurvesRTTI.h"
+#include "BsAnimationClip.h"
+#include "BsAnimationUtility.h"
+#include "BsMath.h"
+
+namespace bs
+{
+	/** Maximum number of tracks that can be referenced by a CompressedAnimationKey. */
+	static const UINT32 MAX_COMPRESSED_TRACKS = 0x3FFF;
+
+	/** Maximum number of frames that can be referenced by a CompressedAnimationKey. */
+	static const UINT32 MAX_COMPRESSED_FRAMES = 0xFFFF;
+
+	/** Range in which the three smallest quaternion components are guaranteed to lie in. */
+	static const float SMALLEST_THREE_RANGE = 1.0f / Math::sqrt(2.0f);
+
+	/** Quantizes a value in [0, 1] range into a 16-bit integer. */
+	static UINT16 quantize(float value)
+	{
+		return (UINT16)Math::clamp(Math::roundToInt(value * 65535.0f), 0, 65535);
+	}
+
+	/** Returns a quantized value back to [0, 1] range. */
+	static float dequantize(UINT16 value)
+	{
+		return value * (1.0f / 65535.0f);
+	}
+
+	/** Linearly interpolates between two values, as done by the decompressor. */
+	static Vector3 interpolate(float t, const Vector3& a, const Vector3& b)
+	{
+		return a + (b - a) * t;
+	}
+
+	static Quaternion interpolate(float t, const Quaternion& a, const Quaternion& b)
+	{
+		return Quaternion::lerp(t, a, b);
+	}
+
+	/** Returns the largest per-component difference between two values. */
+	static float getError(const Vector3& a, const Vector3& b)
+	{
+		Vector3 diff = a - b;
+		return std::max(std::max(Math::abs(diff.x), Math::abs(diff.y)), Math::abs(diff.z));
+	}
+
+	static float getError(const Quaternion& a, const Quaternion& b)
+	{
+		// Both quaternions represent the same rotation, regardless of sign
+		float sign = a.dot(b) >= 0.0f ? 1.0f : -1.0f;
+
+		float error = Math::abs(a.x - b.x * sign);
+		error = std::max(error, Math::abs(a.y - b.y * sign));
+		error = std::max(error, Math::abs(a.z - b.z * sign));
+		error = std::max(error, Math::abs(a.w - b.w * sign));
+
+		return error;
+	}
+
+	/**
+	 * Resamples the curve at the provided sample rate and outputs the samples. Rotation samples are normalized and made
+	 * to lie on the same hemisphere as the previous sample, so they can be linearly interpolated.
+	 */
+	static void sampleCurve(const TAnimationCurve<Vector3>& curve, UINT32 sampleRate, Vector<Vector3>& samples)
+	{
+		UINT32 numFrames = (UINT32)samples.size();
+		for (UINT32 i = 0; i < numFrames; i++)
+			samples[i] = curve.evaluate(i / (float)sampleRate, false);
+	}
+
+	static void sampleCurve(const TAnimationCurve<Quaternion>& curve, UINT32 sampleRate, Vector<Quaternion>& samples)
+	{
+		UINT32 numFrames = (UINT32)samples.size();
+		for (UINT32 i = 0; i < numFrames; i++)
+		{
+			Quaternion sample = curve.evaluate(i / (float)sampleRate, false);
+			sample.normalize();
+
+			if (i > 0 && sample.dot(samples[i - 1]) < 0.0f)
+				sample = -sample;
+
+			samples[i] = sample;
+		}
+	}
+
+	/**
+	 * Removes samples that can be reconstructed by interpolating their neighbours, within the provided error. Outputs the
+	 * frames of the samples that need to be kept.
+	 */
+	template<class T>
+	static void reduceSamples(const Vector<T>& samples, float maxError, Vector<UINT32>& frames)
+	{
+		UINT32 numSamples = (UINT32)samples.size();
+
+		frames.clear();
+		frames.push_back(0);
+
+		UINT32 anchor = 0;
+		for(UINT32 end = 2; end < numSamples; end++)
+		{
+			// Check if all the samples between the last kept sample and the end sample can be interpolated
+			bool canReduce = true;
+			for(UINT32 i = anchor + 1; i < end; i++)
+			{
+				float t = (i - anchor) / (float)(end - anchor);
+				T value = interpolate(t, samples[anchor], samples[end]);
+
+				if(getError(value, samples[i]) > maxError)
+				{
+					canReduce = false;
+					break;
+				}
+			}
+
+			if(!canReduce)
+			{
+				anchor = end - 1;
+				frames.push_back(anchor);
+			}
+		}
+
+		if (numSamples > 1)
+			frames.push_back(numSamples - 1);
+	}
+
+	CompressedAnimationCurves::CompressedAnimationCurves()
+		: mNumPositionTracks(0), mNumRotationTracks(0), mNumScaleTracks(0), mSampleRate(1), mLength(0.0f)
+	{ }
+
+	void CompressedAnimationCurves::seek(float time, bool loop, const CompressedCurveCursor& cursor) const
+	{
+		UINT32 numTracks = mNumPositionTracks + mNumRotationTracks + mNumScaleTracks;
+		UINT32 numGroups = (UINT32)mGroups.size();
+
+		if ((UINT32)cursor.keys.size() != numTracks * 2 || (UINT32)cursor.frames.size() != numGroups)
+		{
+			cursor.keys.assign(numTracks * 2, (UINT32)-1);
+			cursor.streamPos.resize(numGroups);
+			cursor.frames.resize(numGroups);
+
+			for (UINT32 i = 0; i < numGroups; i++)
+			{
+				cursor.streamPos[i] = mGroups[i].firstKey;
+				cursor.frames[i] = 0.0f;
+			}
+		}
+
+		for (UINT32 i = 0; i < numGroups; i++)
+		{
+			const CompressedTrackGroup& group = mGroups[i];
+
+			float groupTime = time;
+			AnimationUtility::wrapTime(groupTime, 0.0f, group.length, loop);
+			float frame = groupTime * mSampleRate;
+
+			// Keys are only ever decoded going forward, so start from the beginning if moving backwards (e.g. when 
+			// looping)
+			if (frame < cursor.frames[i])
+				resetGroup(i, cursor);
+
+			cursor.frames[i] = frame;
+
+			// Keys are sorted by the frame of their preceding key, meaning a key is needed as soon as the most recently
+			// decoded key of its track is reached
+			UINT32 lastKey = group.firstKey + group.numKeys;
+			while(cursor.streamPos[i] < lastKey)
+			{
+				const CompressedAnimationKey& key = mKeys[cursor.streamPos[i]];
+				UINT32 track = key.track & MAX_COMPRESSED_TRACKS;
+
+				UINT32 lastKeyIdx = cursor.keys[track * 2 + 1];
+				if (lastKeyIdx != (UINT32)-1 && mKeys[lastKeyIdx].frame > frame)
+					break;
+
+				cursor.keys[track * 2 + 0] = lastKeyIdx;
+				cursor.keys[track * 2 + 1] = cursor.streamPos[i];
+				cursor.streamPos[i]++;
+			}
+		}
+	}
+
+	void CompressedAnimationCurves::resetGroup(UINT32 group, const CompressedCurveCursor& cursor) const
+	{
+		UINT32 numTracks = (UINT32)mTrackGroups.size();
+		for (UINT32 i = 0; i < numTracks; i++)
+		{
+			if (mTrackGroups[i] != group)
+				continue;
+
+			cursor.keys[i * 2 + 0] = (UINT32)-1;
+			cursor.keys[i * 2 + 1] = (UINT32)-1;
+		}
+
+		cursor.streamPos[group] = mGroups[group].firstKey;
+		cursor.frames[group] = 0.0f;
+	}
+
+	float CompressedAnimationCurves::getKeys(UINT32 track, const CompressedCurveCursor& cursor, UINT32& leftKey,
+		UINT32& rightKey) const
+	{
+		leftKey = cursor.keys[track * 2 + 0];
+		rightKey = cursor.keys[track * 2 + 1];
+
+		if (rightKey == (UINT32)-1)
+			return 0.0f;
+
+		// Single key, or past the last key in the track
+		float frame = cursor.frames[mTrackGroups[track]];
+		if (leftKey == (UINT32)-1 || mKeys[rightKey].frame <= frame)
+		{
+			leftKey = rightKey;
+			return 0.0f;
+		}
+
+		float leftFrame = mKeys[leftKey].frame;
+		float rightFrame = mKeys[rightKey].frame;
+
+		return Math::clamp01((frame - leftFrame) / (rightFrame - leftFrame));
+	}
+
+	Vector3 CompressedAnimationCurves::evaluatePosition(UINT32 idx, const CompressedCurveCursor& cursor) const
+	{
+		UINT32 leftKey, rightKey;
+		float t = getKeys(idx, cursor, leftKey, rightKey);
+
+		if (rightKey == (UINT32)-1)
+			return Vector3::ZERO;
+
+		const CompressedTrackRange& range = mRanges[idx];
+		Vector3 left = decodeVector(leftKey, range);
+		if (leftKey == rightKey)
+			return left;
+
+		return interpolate(t, left, decodeVector(rightKey, range));
+	}
+
+	Quaternion CompressedAnimationCurves::evaluateRotation(UINT32 idx, const CompressedCurveCursor& cursor) const
+	{
+		UINT32 leftKey, rightKey;
+		float t = getKeys(mNumPositionTracks + idx, cursor, leftKey, rightKey);
+
+		if (rightKey == (UINT32)-1)
+			return Quaternion::IDENTITY;
+
+		Quaternion left = decodeRotation(leftKey);
+		if (leftKey == rightKey)
+			return left;
+
+		return interpolate(t, left, decodeRotation(rightKey));
+	}
+
+	Vector3 CompressedAnimationCurves::evaluateScale(UINT32 idx, const CompressedCurveCursor& cursor) const
+	{
+		UINT32 leftKey, rightKey;
+		float t = getKeys(mNumPositionTracks + mNumRotationTracks + idx, cursor, leftKey, rightKey);
+
+		if (rightKey == (UINT32)-1)
+			return Vector3::ONE;
+
+		const CompressedTrackRange& range = mRanges[mNumPositionTracks + idx];
+		Vector3 left = decodeVector(leftKey, range);
+		if (leftKey == rightKey)
+			return left;
+
+		return interpolate(t, left, decodeVector(rightKey, range));
+	}
+
+	Vector3 CompressedAnimationCurves::decodeVector(UINT32 keyIdx, const CompressedTrackRange& range) const
+	{
+		const CompressedAnimationKey& key = mKeys[keyIdx];
+
+		Vector3 value(dequantize(key.value[0]), dequantize(key.value[1]), dequantize(key.value[2]));
+		return range.min + value * range.extent;
+	}
+
+	Quaternion CompressedAnimationCurves::decodeRotation(UINT32 keyIdx) const
+	{
+		const CompressedAnimationKey& key = mKeys[keyIdx];
+		UINT32 largestIdx = key.track >> 14;
+
+		float components[4];
+		float sqrdLength = 0.0f;
+		for(UINT32 i = 0, j = 0; i < 4; i++)
+		{
+			if (i == largestIdx)
+				continue;
+
+			components[i] = (dequantize(key.value[j++]) * 2.0f - 1.0f) * SMALLEST_THREE_RANGE;
+			sqrdLength += components[i] * components[i];
+		}
+
+		components[largestIdx] = Math::sqrt(std::max(0.0f, 1.0f - sqrdLength));
+
+		return Quaternion(components[3], components[0], components[1], components[2]);
+	}
+
+	SPtr<CompressedAnimationCurves> CompressedAnimationCurves::create(const AnimationCurves& curves, UINT32 sampleRate,
+		float maxError)
+	{
+		UINT32 numPositionTracks = (UINT32)curves.position.size();
+		UINT32 numRotationTracks = (UINT32)curves.rotation.size();
+		UINT32 numScaleTracks = (UINT32)curves.scale.size();
+		UINT32 numTracks = numPositionTracks + numRotationTracks + numScaleTracks;
+
+		if (numTracks > MAX_COMPRESSED_TRACKS || sampleRate == 0)
+			return nullptr;
+
+		float length = 0.0f;
+		for (auto& entry : curves.position)
+			length = std::max(length, entry.curve.getLength());
+
+		for (auto& entry : curves.rotation)
+			length = std::max(length, entry.curve.getLength());
+
+		for (auto& entry : curves.scale)
+			length = std::max(length, entry.curve.getLength());
+
+		UINT32 numFrames = (UINT32)std::ceil(length * sampleRate) + 1;
+		if (numFrames > MAX_COMPRESSED_FRAMES)
+			return nullptr;
+
+		SPtr<CompressedAnimationCurves> output = createEmpty();
+		output->mNumPositionTracks = numPositionTracks;
+		output->mNumRotationTracks = numRotationTracks;
+		output->mNumScaleTracks = numScaleTracks;
+		output->mSampleRate = sampleRate;
+		output->mLength = length;
+		output->mRanges.resize(numPositionTracks + numScaleTracks);
+		output->mTrackGroups.resize(numTracks);
+
+		// Tracks are grouped by length, so each group can loop on its own
+		Map<float, UINT32> groupLookup;
+		auto assignGroup = [&](UINT32 track, float trackLength)
+		{
+			auto iterFind = groupLookup.find(trackLength);
+			if (iterFind == groupLookup.end())
+			{
+				UINT32 groupIdx = (UINT32)output->mGroups.size();
+				output->mGroups.push_back({ trackLength, 0, 0 });
+
+				iterFind = groupLookup.insert(std::make_pair(trackLength, groupIdx)).first;
+			}
+
+			output->mTrackGroups[track] = iterFind->second;
+		};
+
+		for (UINT32 i = 0; i < numPositionTracks; i++)
+			assignGroup(i, curves.position[i].curve.getLength());
+
+		for (UINT32 i = 0; i < numRotationTracks; i++)
+			assignGroup(numPositionTracks + i, curves.rotation[i].curve.getLength());
+
+		for (UINT32 i = 0; i < numScaleTracks; i++)
+			assignGroup(numPositionTracks + numRotationTracks + i, curves.scale[i].curve.getLength());
+
+		// Keys in track order, along with the frame at which they're first needed
+		Vector<std::pair<UINT32, CompressedAnimationKey>> keys;
+		Vector<UINT32> frames;
+
+		auto getNumSamples = [&](auto& curve)
+		{
+			UINT32 numKeyFrames = curve.getNumKeyFrames();
+			if (numKeyFrames == 0)
+				return 0U;
+
+			if (numKeyFrames == 1)
+				return 1U;
+
+			return (UINT32)std::ceil(curve.getLength() * sampleRate) + 1;
+		};
+
+		auto addKeys = [&](UINT32 track, auto& samples, auto encode)
+		{
+			reduceSamples(samples, maxError, frames);
+
+			UINT32 numKeys = (UINT32)frames.size();
+			for(UINT32 i = 0; i < numKeys; i++)
+			{
+				CompressedAnimationKey key;
+				key.track = (UINT16)track;
+				key.frame = (UINT16)frames[i];
+				encode(samples[frames[i]], key);
+
+				UINT32 neededFrame = i > 0 ? frames[i - 1] : 0;
+				keys.push_back(std::make_pair(neededFrame, key));
+			}
+		};
+
+		auto compressVectorTracks = [&](const Vector<TNamedAnimationCurve<Vector3>>& tracks, UINT32 trackOffset,
+			UINT32 rangeOffset)
+		{
+			Vector<Vector3> samples;
+			for (UINT32 i = 0; i < (UINT32)tracks.size(); i++)
+			{
+				samples.resize(getNumSamples(tracks[i].curve));
+				if (samples.empty())
+					continue;
+
+				sampleCurve(tracks[i].curve, sampleRate, samples);
+
+				Vector3 min = samples[0];
+				Vector3 max = samples[0];
+				for (auto& sample : samples)
+				{
+					min = Vector3::min(min, sample);
+					max = Vector3::max(max, sample);
+				}
+
+				CompressedTrackRange& range = output->mRanges[rangeOffset + i];
+				range.min = min;
+				range.extent = max - min;
+
+				auto encode = [&range](const Vector3& value, CompressedAnimationKey& key)
+				{
+					for (UINT32 j = 0; j < 3; j++)
+					{
+						if (range.extent[j] > 0.0f)
+							key.value[j] = quantize((value[j] - range.min[j]) / range.extent[j]);
+						else
+							key.value[j] = 0;
+					}
+				};
+
+				addKeys(trackOffset + i, samples, encode);
+			}
+		};
+
+		compressVectorTracks(curves.position, 0, 0);
+		compressVectorTracks(curves.scale, numPositionTracks + numRotationTracks, numPositionTracks);
+
+		{
+			Vector<Quaternion> samples;
+			for (UINT32 i = 0; i < numRotationTracks; i++)
+			{
+				samples.resize(getNumSamples(curves.rotation[i].curve));
+				if (samples.empty())
+					continue;
+
+				sampleCurve(curves.rotation[i].curve, sampleRate, samples);
+
+				auto encode = [](const Quaternion& value, CompressedAnimationKey& key)
+				{
+					float components[4] = { value.x, value.y, value.z, value.w };
+
+					UINT32 largestIdx = 0;
+					for (UINT32 j = 1; j < 4; j++)
+					{
+						if (Math::abs(components[j]) > Math::abs(components[largestIdx]))
+							largestIdx = j;
+					}
+
+					// Ensure the omitted component is positive, so it can be reconstructed
+					float sign = components[largestIdx] < 0.0f ? -1.0f : 1.0f;
+					for(UINT32 j = 0, k = 0; j < 4; j++)
+					{
+						if (j == largestIdx)
+							continue;
+
+						float value = components[j] * sign / SMALLEST_THREE_RANGE;
+						key.value[k++] = quantize(value * 0.5f + 0.5f);
+					}
+
+					key.track |= (UINT16)(largestIdx << 14);
+				};
+
+				addKeys(numPositionTracks + i, samples, encode);
+			}
+		}
+
+		// Sort keys by group, and then by the time they are needed, so the decoder can process each group in a single
+		// forward pass
+		auto getGroup = [&output](const CompressedAnimationKey& key)
+		{
+			return output->mTrackGroups[key.track & MAX_COMPRESSED_TRACKS];
+		};
+
+		std::stable_sort(keys.begin(), keys.end(),
+			[&getGroup](auto& a, auto& b)
+		{
+			UINT32 groupA = getGroup(a.second);
+			UINT32 groupB = getGroup(b.second);
+
+			if (groupA != groupB)
+				return groupA < groupB;
+
+			return a.first < b.first;
+		});
+
+		output->mKeys.resize(keys.size());
+		for (UINT32 i = 0; i < (UINT32)keys.size(); i++)
+		{
+			output->mKeys[i] = keys[i].second;
+
+			CompressedTrackGroup& group = output->mGroups[getGroup(keys[i].second)];
+			if (group.numKeys == 0)
+				group.firstKey = i;
+
+			group.numKeys++;
+		}
+
+		return output;
+	}
+
+	SPtr<CompressedAnimationCurves> CompressedAnimationCurves::createEmpty()
+	{
+		CompressedAnimationCurves* rawPtr = new (bs_alloc<CompressedAnimationCurves>()) CompressedAnimationCurves();
+
+		return bs_shared_ptr<CompressedAnimationCurves>(rawPtr);
+	}
+
+	RTTITypeBase* CompressedAnimationCurves::getRTTIStatic()
+	{
+		return CompressedAnimationCurvesRTTI::instance();
+	}
+
+	RTTITypeBase* CompressedAnimationCurves::getRTTI() const
+	{
+		return getRTTIStatic();
+	}
+}
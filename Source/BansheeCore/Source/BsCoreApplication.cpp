@@ -49,6 +49,7 @@
 #include "BsAudio.h"
 #include "BsAnimationManager.h"
 #include "BsParamBlocks.h"
+#include "BsTextureStreamingManager.h"
 
 namespace bs
 {
@@ -95,6 +96,7 @@ namespace bs
 
 		unloadPlugin(mRendererPlugin);
 
+		ct::TextureStreamingManager::shutDown();
 		RenderAPIManager::shutDown();
 		ct::GpuProgramManager::shutDown();
 		GpuProgramManager::shutDown();
@@ -128,7 +130,8 @@ namespace bs
 		MessageHandler::startUp();
 		ProfilerCPU::startUp();
 		ProfilingManager::startUp();
-		ThreadPool::startUp<TThreadPool<ThreadBansheePolicy>>((numWorkerThreads));
+		// Task scheduler workers are long-lived pool threads, so make sure the pool can hold all of them (plus the core thread)
+		ThreadPool::startUp<TThreadPool<ThreadBansheePolicy>>(numWorkerThreads, TaskScheduler::MAX_WORKERS + 1);
 		TaskScheduler::startUp();
 		TaskScheduler::instance().removeWorker();
 		RenderStats::startUp();
@@ -149,6 +152,7 @@ namespace bs
 		mPrimaryWindow = RenderAPIManager::instance().initialize(mStartUpDesc.renderAPI, mStartUpDesc.primaryWindowDesc);
 
 		ct::ParamBlockManager::startUp();
+		ct::TextureStreamingManager::startUp();
 		Input::startUp();
 		RendererManager::startUp();
 
@@ -224,9 +228,10 @@ namespace bs
 
 			preUpdate();
 
-			PROFILE_CALL(gSceneManager()._update(), "SceneManager");
+			PROFILE_CALL(gSceneManager()._update(ComponentUpdatePhase::PrePhysics), "SceneManager");
 			gAudio()._update();
 			gPhysics().update();
+			PROFILE_CALL(gSceneManager()._update(ComponentUpdatePhase::PostPhysics), "SceneManager (post-physics)");
 			AnimationManager::instance().postUpdate();
 
 			// Update plugins
@@ -234,10 +239,15 @@ namespace bs
 				pluginUpdateFunc.second();
 
 			postUpdate();
+			PROFILE_CALL(gSceneManager()._update(ComponentUpdatePhase::Late), "SceneManager (late)");
 
 			// Send out resource events in case any were loaded/destroyed/modified
 			ResourceListenerManager::instance().update();
 
+			// Unload least recently used resources if over the memory budget
+			gResources()._updateResidency();
+
+			gSceneManager()._updateTransforms();
 			gSceneManager()._updateCoreObjectTransforms();
 			PROFILE_CALL(RendererManager::instance().getActive()->renderAll(), "Render");
 
@@ -0,0 +1,1091 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#include "BsCorePrerequisites.h"
+#include "BsSkeleton.h"
+#include "BsSkeletonMask.h"
+#include "BsAnimationClip.h"
+#include "BsAnimationCurve.h"
+#include "BsAnimationUtility.h"
+#include "BsMatrix4.h"
+#include "BsMath.h"
+#include "BsTimer.h"
+#include "BsMemStack.h"
+#include "BsCommandQueue.h"
+#include "BsCoreThread.h"
+#include "BsThreadPool.h"
+#include "BsTaskScheduler.h"
+#include "BsResources.h"
+#include "BsResource.h"
+#include "BsRTTIType.h"
+#include "BsResourceListenerManager.h"
+#include "BsCoreObjectManager.h"
+#include "BsTime.h"
+#include "BsFileSystem.h"
+#include "BsPixelUtil.h"
+#include "BsPixelData.h"
+#include "BsSceneObject.h"
+#include "BsGameObjectManager.h"
+
+#include <iostream>
+#include <iomanip>
+#include <random>
+
+using namespace bs;
+
+/**
+ * Calls the provided function repeatedly for at least the provided number of iterations, and for at least 200ms. Returns
+ * the average time of a single call, in microseconds.
+ */
+template<class T>
+static double measure(T func, UINT32 minIterations)
+{
+	static const UINT64 MIN_DURATION_US = 200000;
+
+	// Warm up caches and any lazily built data
+	func();
+
+	Timer timer;
+	UINT32 numIterations = 0;
+	while (numIterations < minIterations || timer.getMicroseconds() < MIN_DURATION_US)
+	{
+		func();
+		numIterations++;
+	}
+
+	return timer.getMicroseconds() / (double)numIterations;
+}
+
+/**
+ * Outputs a single benchmark result row, comparing the current implementation with a reference one. Set @p higherIsBetter
+ * if the values are rates rather than durations.
+ */
+static void printResult(const String& name, double current, double reference, const char* unit = "us",
+	bool higherIsBetter = false)
+{
+	double speedup = higherIsBetter ? (current / reference) : (reference / current);
+
+	std::cout << std::left << std::setw(40) << name << std::right << std::fixed << std::setprecision(3)
+		<< std::setw(14) << current << " " << unit << std::setw(14) << reference << " " << unit
+		<< std::setw(10) << std::setprecision(2) << speedup << "x" << std::endl;
+}
+
+/** Outputs the header of a benchmark result table. */
+static void printHeader(const String& title, const String& reference)
+{
+	std::cout << std::endl << title << std::endl;
+	std::cout << std::left << std::setw(40) << "" << std::right << std::setw(17) << "current" << std::setw(17)
+		<< reference << std::setw(11) << "speedup" << std::endl;
+}
+
+/************************************************************************/
+/* 								SKELETON POSE                      		*/
+/************************************************************************/
+
+/**
+ * Skeleton::getPose() as it was before the structure-of-arrays rewrite: scalar per-bone blending, followed by a
+ * recursive global pose resolve.
+ */
+static void getPoseReference(const Skeleton& skeleton, Matrix4* pose, LocalSkeletonPose& localPose,
+	const SkeletonMask& mask, const AnimationStateLayer* layers, UINT32 numLayers)
+{
+	UINT32 numBones = skeleton.getNumBones();
+	for(UINT32 i = 0; i < numBones; i++)
+	{
+		localPose.positions[i] = Vector3::ZERO;
+		localPose.rotations[i] = Quaternion::ZERO;
+		localPose.scales[i] = Vector3::ONE;
+	}
+
+	for(UINT32 i = 0; i < numLayers; i++)
+	{
+		const AnimationStateLayer& layer = layers[i];
+
+		float invLayerWeight;
+		if (layer.additive)
+		{
+			float weightSum = 0.0f;
+			for (UINT32 j = 0; j < layer.numStates; j++)
+				weightSum += layer.states[j].weight;
+
+			invLayerWeight = 1.0f / weightSum;
+		}
+		else
+			invLayerWeight = 1.0f;
+
+		for (UINT32 j = 0; j < layer.numStates; j++)
+		{
+			const AnimationState& state = layer.states[j];
+			if (state.disabled)
+				continue;
+
+			float normWeight = state.weight * invLayerWeight;
+			if (Math::approxEquals(normWeight, 0.0f))
+				continue;
+
+			for (UINT32 k = 0; k < numBones; k++)
+			{
+				if (!mask.isEnabled(k))
+					continue;
+
+				UINT32 curveIdx = state.boneToCurveMapping[k].position;
+				if (curveIdx != (UINT32)-1)
+				{
+					const TAnimationCurve<Vector3>& curve = state.curves->position[curveIdx].curve;
+					localPose.positions[k] += curve.evaluate(state.time, state.positionCaches[curveIdx], state.loop) * normWeight;
+
+					localPose.hasOverride[k] = false;
+				}
+			}
+
+			for (UINT32 k = 0; k < numBones; k++)
+			{
+				if (!mask.isEnabled(k))
+					continue;
+
+				UINT32 curveIdx = state.boneToCurveMapping[k].scale;
+				if (curveIdx != (UINT32)-1)
+				{
+					const TAnimationCurve<Vector3>& curve = state.curves->scale[curveIdx].curve;
+					localPose.scales[k] *= curve.evaluate(state.time, state.scaleCaches[curveIdx], state.loop) * normWeight;
+
+					localPose.hasOverride[k] = false;
+				}
+			}
+
+			for (UINT32 k = 0; k < numBones; k++)
+			{
+				if (!mask.isEnabled(k))
+					continue;
+
+				UINT32 curveIdx = state.boneToCurveMapping[k].rotation;
+				if (curveIdx != (UINT32)-1)
+				{
+					const TAnimationCurve<Quaternion>& curve = state.curves->rotation[curveIdx].curve;
+					Quaternion value = curve.evaluate(state.time, state.rotationCaches[curveIdx], state.loop) * normWeight;
+
+					if (value.dot(localPose.rotations[k]) < 0.0f)
+						value = -value;
+
+					localPose.rotations[k] += value;
+					localPose.hasOverride[k] = false;
+				}
+			}
+		}
+	}
+
+	UINT32 isGlobalBytes = sizeof(bool) * numBones;
+	bool* isGlobal = (bool*)bs_stack_alloc(isGlobalBytes);
+	memset(isGlobal, 0, isGlobalBytes);
+
+	for(UINT32 i = 0; i < numBones; i++)
+	{
+		bool isAssigned = localPose.rotations[i].w != 0.0f;
+		if (!isAssigned)
+			localPose.rotations[i] = Quaternion::IDENTITY;
+		else
+			localPose.rotations[i].normalize();
+
+		if (localPose.hasOverride[i])
+		{
+			isGlobal[i] = true;
+			continue;
+		}
+
+		pose[i] = Matrix4::TRS(localPose.positions[i], localPose.rotations[i], localPose.scales[i]);
+	}
+
+	std::function<void(UINT32)> calcGlobal = [&](UINT32 boneIdx)
+	{
+		UINT32 parentBoneIdx = skeleton.getBoneInfo(boneIdx).parent;
+		if (parentBoneIdx == (UINT32)-1)
+		{
+			isGlobal[boneIdx] = true;
+			return;
+		}
+
+		if (!isGlobal[parentBoneIdx])
+			calcGlobal(parentBoneIdx);
+
+		pose[boneIdx] = pose[parentBoneIdx] * pose[boneIdx];
+		isGlobal[boneIdx] = true;
+	};
+
+	for (UINT32 i = 0; i < numBones; i++)
+	{
+		if (!isGlobal[i])
+			calcGlobal(i);
+	}
+
+	for (UINT32 i = 0; i < numBones; i++)
+		pose[i] = pose[i] * skeleton.getInvBindPose(i);
+
+	bs_stack_free(isGlobal);
+}
+
+/** Creates a curve set with a position, rotation and scale curve for each bone, each with the provided number of keys. */
+static SPtr<AnimationCurves> createBoneCurves(UINT32 numBones, UINT32 numKeys, float length, std::mt19937& generator)
+{
+	std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+
+	SPtr<AnimationCurves> curves = bs_shared_ptr_new<AnimationCurves>();
+	for (UINT32 i = 0; i < numBones; i++)
+	{
+		Vector<TKeyframe<Vector3>> positionKeys(numKeys);
+		Vector<TKeyframe<Quaternion>> rotationKeys(numKeys);
+		Vector<TKeyframe<Vector3>> scaleKeys(numKeys);
+
+		for (UINT32 j = 0; j < numKeys; j++)
+		{
+			float time = length * j / (float)(numKeys - 1);
+
+			Vector3 position(dist(generator), dist(generator), dist(generator));
+			positionKeys[j] = { position, Vector3::ZERO, Vector3::ZERO, time };
+
+			Vector3 axis(dist(generator), dist(generator), dist(generator) + 2.0f);
+			axis.normalize();
+
+			Quaternion rotation(axis, Radian(dist(generator) * Math::PI));
+			rotationKeys[j] = { rotation, Quaternion::ZERO, Quaternion::ZERO, time };
+
+			Vector3 scale(1.0f + dist(generator) * 0.1f, 1.0f + dist(generator) * 0.1f, 1.0f + dist(generator) * 0.1f);
+			scaleKeys[j] = { scale, Vector3::ZERO, Vector3::ZERO, time };
+		}
+
+		String name = "Bone" + toString(i);
+		curves->addPositionCurve(name, TAnimationCurve<Vector3>(positionKeys));
+		curves->addRotationCurve(name, TAnimationCurve<Quaternion>(rotationKeys));
+		curves->addScaleCurve(name, TAnimationCurve<Vector3>(scaleKeys));
+	}
+
+	return curves;
+}
+
+/** Evaluation state for a single animation state, along with the storage it points to. */
+struct BenchmarkAnimationState
+{
+	BenchmarkAnimationState(const SPtr<AnimationCurves>& curves, UINT32 numBones, float weight)
+		: mapping(numBones), positionCaches(numBones), rotationCaches(numBones), scaleCaches(numBones)
+	{
+		for (UINT32 i = 0; i < numBones; i++)
+			mapping[i] = { i, i, i };
+
+		state.curves = curves;
+		state.boneToCurveMapping = mapping.data();
+		state.soToCurveMapping = nullptr;
+		state.positionCaches = positionCaches.data();
+		state.rotationCaches = rotationCaches.data();
+		state.scaleCaches = scaleCaches.data();
+		state.genericCaches = nullptr;
+		state.time = 0.0f;
+		state.weight = weight;
+		state.loop = true;
+		state.disabled = false;
+	}
+
+	AnimationState state;
+	Vector<AnimationCurveMapping> mapping;
+	Vector<TCurveCache<Vector3>> positionCaches;
+	Vector<TCurveCache<Quaternion>> rotationCaches;
+	Vector<TCurveCache<Vector3>> scaleCaches;
+};
+
+/**
+ * Evaluates poses of rigs with different bone counts, blending two clips with 30 keys per curve and advancing time at
+ * 60 FPS, using Skeleton::getPose() and the scalar reference implementation.
+ */
+static void benchmarkSkeletonPose()
+{
+	printHeader("Skeleton::getPose, two blended clips", "scalar");
+
+	static const float CLIP_LENGTH = 2.0f;
+	static const UINT32 NUM_KEYS = 30;
+	static const float TIME_STEP = 1.0f / 60.0f;
+
+	const UINT32 boneCounts[] = { 50, 100, 250 };
+	for (auto numBones : boneCounts)
+	{
+		std::mt19937 generator(numBones);
+
+		// Random hierarchy where every bone's parent has a lower index, except the bones are shuffled so the skeleton's
+		// bone order doesn't already match the hierarchy order
+		Vector<UINT32> order(numBones);
+		for (UINT32 i = 0; i < numBones; i++)
+			order[i] = i;
+
+		std::shuffle(order.begin() + 1, order.end(), generator);
+
+		Vector<BONE_DESC> bones(numBones);
+		for (UINT32 i = 0; i < numBones; i++)
+		{
+			BONE_DESC& bone = bones[order[i]];
+			bone.name = "Bone" + toString(order[i]);
+			bone.parent = i == 0 ? (UINT32)-1 : order[generator() % i];
+			bone.invBindPose = Matrix4::TRS(Vector3((float)i, 0.0f, 0.0f), Quaternion::IDENTITY, Vector3::ONE);
+		}
+
+		SPtr<Skeleton> skeleton = Skeleton::create(bones.data(), numBones);
+		SkeletonMask mask(numBones);
+
+		BenchmarkAnimationState currentStates[] =
+		{
+			BenchmarkAnimationState(createBoneCurves(numBones, NUM_KEYS, CLIP_LENGTH, generator), numBones, 0.7f),
+			BenchmarkAnimationState(createBoneCurves(numBones, NUM_KEYS, CLIP_LENGTH, generator), numBones, 0.3f)
+		};
+
+		BenchmarkAnimationState referenceStates[] =
+		{
+			BenchmarkAnimationState(currentStates[0].state.curves, numBones, 0.7f),
+			BenchmarkAnimationState(currentStates[1].state.curves, numBones, 0.3f)
+		};
+
+		AnimationState currentLayerStates[] = { currentStates[0].state, currentStates[1].state };
+		AnimationState referenceLayerStates[] = { referenceStates[0].state, referenceStates[1].state };
+
+		AnimationStateLayer currentLayer = { currentLayerStates, 2, 0, false };
+		AnimationStateLayer referenceLayer = { referenceLayerStates, 2, 0, false };
+
+		Vector<Matrix4> pose(numBones);
+		LocalSkeletonPose localPose(numBones);
+		memset(localPose.hasOverride, 0, sizeof(bool) * numBones);
+
+		auto advance = [&](AnimationState* states)
+		{
+			for (UINT32 i = 0; i < 2; i++)
+				states[i].time = fmod(states[i].time + TIME_STEP, CLIP_LENGTH);
+		};
+
+		double currentUs = measure([&]()
+		{
+			advance(currentLayerStates);
+			skeleton->getPose(pose.data(), localPose, mask, &currentLayer, 1);
+		}, 1000);
+
+		double referenceUs = measure([&]()
+		{
+			advance(referenceLayerStates);
+			getPoseReference(*skeleton, pose.data(), localPose, mask, &referenceLayer, 1);
+		}, 1000);
+
+		printResult(toString(numBones) + " bones", currentUs, referenceUs);
+	}
+}
+
+/************************************************************************/
+/* 								CURVE EVALUATION                   		*/
+/************************************************************************/
+
+/** TAnimationCurve::evaluate() as it was before the key index was added, binary searching through all the keys. */
+static float evaluateReference(const TAnimationCurve<float>& curve, float time)
+{
+	UINT32 numKeys = curve.getNumKeyFrames();
+	AnimationUtility::wrapTime(time, 0.0f, curve.getLength(), true);
+
+	INT32 start = 0;
+	INT32 searchLength = (INT32)numKeys;
+	while(searchLength > 0)
+	{
+		INT32 half = searchLength >> 1;
+		INT32 mid = start + half;
+
+		if(time < curve.getKeyFrame(mid).time)
+			searchLength = half;
+		else
+		{
+			start = mid + 1;
+			searchLength -= (half + 1);
+		}
+	}
+
+	UINT32 leftKeyIdx = std::max(0, start - 1);
+	UINT32 rightKeyIdx = std::min(start, (INT32)numKeys - 1);
+
+	const TKeyframe<float>& leftKey = curve.getKeyFrame(leftKeyIdx);
+	const TKeyframe<float>& rightKey = curve.getKeyFrame(rightKeyIdx);
+
+	if (leftKeyIdx == rightKeyIdx)
+		return leftKey.value;
+
+	float length = rightKey.time - leftKey.time;
+
+	float t;
+	float leftTangent;
+	float rightTangent;
+
+	if (Math::approxEquals(length, 0.0f))
+	{
+		t = 0.0f;
+		leftTangent = 0.0f;
+		rightTangent = 0.0f;
+	}
+	else
+	{
+		t = (time - leftKey.time) / length;
+		leftTangent = leftKey.outTangent * length;
+		rightTangent = rightKey.inTangent * length;
+	}
+
+	float output = Math::cubicHermite(t, leftKey.value, rightKey.value, leftTangent, rightTangent);
+
+	// Step keys
+	if (leftKey.outTangent == std::numeric_limits<float>::infinity() ||
+		rightKey.inTangent == std::numeric_limits<float>::infinity())
+		output = leftKey.value;
+
+	return output;
+}
+
+/**
+ * Evaluates curves with 10 to 10000 keys at sequential, reverse and random times, using TAnimationCurve::evaluate() and
+ * the binary search reference implementation. Results are per evaluation.
+ */
+static void benchmarkCurveEvaluation()
+{
+	printHeader("TAnimationCurve::evaluate, per evaluation", "binary search");
+
+	static const UINT32 NUM_EVALUATIONS = 1000;
+
+	const UINT32 keyCounts[] = { 10, 100, 1000, 10000 };
+	for (auto numKeys : keyCounts)
+	{
+		std::mt19937 generator(numKeys);
+		std::uniform_real_distribution<float> dist(0.0f, 1.0f);
+
+		// Keys are unevenly spaced, as they would be after keyframe reduction
+		Vector<TKeyframe<float>> keyframes(numKeys);
+		float time = 0.0f;
+		for (UINT32 i = 0; i < numKeys; i++)
+		{
+			float tangent = dist(generator) * 2.0f - 1.0f;
+			keyframes[i] = { dist(generator), tangent, tangent, time };
+
+			time += 0.1f + dist(generator) * 0.9f;
+		}
+
+		TAnimationCurve<float> curve(keyframes);
+		float length = curve.getLength();
+
+		Vector<float> sequentialTimes(NUM_EVALUATIONS);
+		for (UINT32 i = 0; i < NUM_EVALUATIONS; i++)
+			sequentialTimes[i] = length * i / (float)NUM_EVALUATIONS;
+
+		Vector<float> reverseTimes(sequentialTimes.rbegin(), sequentialTimes.rend());
+
+		Vector<float> randomTimes(NUM_EVALUATIONS);
+		for (UINT32 i = 0; i < NUM_EVALUATIONS; i++)
+			randomTimes[i] = dist(generator) * length;
+
+		const std::pair<const char*, const Vector<float>*> patterns[] =
+		{
+			{ "sequential", &sequentialTimes },
+			{ "reverse", &reverseTimes },
+			{ "random", &randomTimes }
+		};
+
+		// Accumulated so the evaluations can't be optimized out
+		volatile float sum = 0.0f;
+		for (auto& pattern : patterns)
+		{
+			const Vector<float>& times = *pattern.second;
+
+			double currentUs = measure([&]()
+			{
+				float output = 0.0f;
+				for (auto& entry : times)
+					output += curve.evaluate(entry, true);
+
+				sum = sum + output;
+			}, 100);
+
+			double referenceUs = measure([&]()
+			{
+				float output = 0.0f;
+				for (auto& entry : times)
+					output += evaluateReference(curve, entry);
+
+				sum = sum + output;
+			}, 100);
+
+			double toNs = 1000.0 / NUM_EVALUATIONS;
+			printResult(toString(numKeys) + " keys, " + pattern.first, currentUs * toNs, referenceUs * toNs, "ns");
+		}
+	}
+}
+
+/************************************************************************/
+/* 								COMMAND QUEUE                      		*/
+/************************************************************************/
+
+/** QueuedCommand as it was before commands were stored inline in command blocks. */
+struct ReferenceQueuedCommand
+{
+	ReferenceQueuedCommand(std::function<void()> _callback, bool _notifyWhenComplete = false, UINT32 _callbackId = 0)
+		:callback(_callback), asyncOp(AsyncOpEmpty()), returnsValue(false), callbackId(_callbackId)
+		, notifyWhenComplete(_notifyWhenComplete)
+	{ }
+
+	std::function<void()> callback;
+	std::function<void(AsyncOp&)> callbackWithReturnValue;
+	AsyncOp asyncOp;
+	bool returnsValue;
+	UINT32 callbackId;
+	bool notifyWhenComplete;
+};
+
+/**
+ * CommandQueue as it was before commands were stored inline in command blocks. Only contains the parts required for
+ * queuing and playing back commands that don't return a value. Recycling of the empty queues is additionally guarded by
+ * a mutex, since the queues are returned from the core thread.
+ */
+class ReferenceCommandQueue
+{
+public:
+	ReferenceCommandQueue()
+		:mCommands(bs_new<Queue<ReferenceQueuedCommand>>())
+	{ }
+
+	~ReferenceCommandQueue()
+	{
+		bs_delete(mCommands);
+
+		while (!mEmptyCommandQueues.empty())
+		{
+			bs_delete(mEmptyCommandQueues.top());
+			mEmptyCommandQueues.pop();
+		}
+	}
+
+	void queue(std::function<void()> commandCallback)
+	{
+		ReferenceQueuedCommand newCommand(commandCallback);
+		mCommands->push(newCommand);
+	}
+
+	Queue<ReferenceQueuedCommand>* flush()
+	{
+		Queue<ReferenceQueuedCommand>* oldCommands = mCommands;
+
+		Lock lock(mMutex);
+		if (!mEmptyCommandQueues.empty())
+		{
+			mCommands = mEmptyCommandQueues.top();
+			mEmptyCommandQueues.pop();
+		}
+		else
+			mCommands = bs_new<Queue<ReferenceQueuedCommand>>();
+
+		return oldCommands;
+	}
+
+	void playback(Queue<ReferenceQueuedCommand>* commands)
+	{
+		while (!commands->empty())
+		{
+			commands->front().callback();
+			commands->pop();
+		}
+
+		Lock lock(mMutex);
+		mEmptyCommandQueues.push(commands);
+	}
+
+private:
+	Queue<ReferenceQueuedCommand>* mCommands;
+	Stack<Queue<ReferenceQueuedCommand>*> mEmptyCommandQueues;
+	Mutex mMutex;
+};
+
+/** Command executed by the command queue benchmark. */
+static void executeBenchmarkCommand(const SPtr<UINT64>& counter, UINT32 value)
+{
+	*counter += value;
+}
+
+/**
+ * Queues commands on the simulation thread and plays them back on the core thread, using CommandQueue and the
+ * std::function based reference queue. Each frame the queue is flushed and its commands are handed to the core thread
+ * the same way CoreThread::submit() does, so queuing of the next frame overlaps with the playback of the previous one.
+ * Timings include waiting for the core thread to execute all commands.
+ */
+static void benchmarkCommandQueue()
+{
+	printHeader("Command queue, commands per second", "std::function");
+
+	const std::pair<UINT32, UINT32> configs[] = { { 5000, 40 }, { 500, 400 }, { 50, 4000 } };
+	for (auto& config : configs)
+	{
+		UINT32 numCommands = config.first;
+		UINT32 numFrames = config.second;
+
+		SPtr<UINT64> counter = bs_shared_ptr_new<UINT64>(0);
+		auto waitForCoreThread = []()
+		{
+			gCoreThread().queueCommand([]() {}, CTQF_InternalQueue | CTQF_BlockUntilComplete);
+		};
+
+		CommandQueue<CommandQueueNoSync> queue(BS_THREAD_CURRENT_ID);
+		double currentUs = measure([&]()
+		{
+			for (UINT32 i = 0; i < numFrames; i++)
+			{
+				for (UINT32 j = 0; j < numCommands; j++)
+					queue.queue(std::bind(&executeBenchmarkCommand, counter, j));
+
+				CommandBlock* commands = queue.flush();
+				gCoreThread().queueCommand(std::bind(&CommandQueueBase::playback, &queue, commands), CTQF_InternalQueue);
+			}
+
+			waitForCoreThread();
+		}, 1);
+
+		ReferenceCommandQueue referenceQueue;
+		double referenceUs = measure([&]()
+		{
+			for (UINT32 i = 0; i < numFrames; i++)
+			{
+				for (UINT32 j = 0; j < numCommands; j++)
+					referenceQueue.queue(std::bind(&executeBenchmarkCommand, counter, j));
+
+				Queue<ReferenceQueuedCommand>* commands = referenceQueue.flush();
+				gCoreThread().queueCommand(std::bind(&ReferenceCommandQueue::playback, &referenceQueue, commands),
+					CTQF_InternalQueue);
+			}
+
+			waitForCoreThread();
+		}, 1);
+
+		// Commands per microsecond, reported in millions per second
+		double totalCommands = numCommands * (double)numFrames;
+		printResult(toString(numCommands) + " commands x " + toString(numFrames) + " frames",
+			totalCommands / currentUs, totalCommands / referenceUs, "M/s", true);
+	}
+}
+
+/************************************************************************/
+/* 								RESOURCE LOADING                   		*/
+/************************************************************************/
+
+/** Resource containing a block of data and a list of resources it depends on. */
+class BenchmarkResource : public Resource
+{
+public:
+	BenchmarkResource()
+		:Resource(false)
+	{ }
+
+	Vector<float> mData;
+	Vector<HResource> mDependencies;
+
+	/** Creates a new resource and a handle to it. */
+	static HResource create(UINT32 dataSize, const Vector<HResource>& dependencies)
+	{
+		SPtr<BenchmarkResource> resource = _createPtr();
+		resource->mData.resize(dataSize, 1.0f);
+		resource->mDependencies = dependencies;
+
+		return gResources()._createResourceHandle(resource);
+	}
+
+	/** Creates a new resource without a handle. */
+	static SPtr<BenchmarkResource> _createPtr()
+	{
+		SPtr<BenchmarkResource> resource = bs_core_ptr<BenchmarkResource>(
+			new (bs_alloc<BenchmarkResource>()) BenchmarkResource());
+		resource->_setThisPtr(resource);
+		resource->initialize();
+
+		return resource;
+	}
+
+	static RTTITypeBase* getRTTIStatic();
+	RTTITypeBase* getRTTI() const override;
+
+protected:
+	/** @copydoc Resource::getResourceDependencies */
+	void getResourceDependencies(FrameVector<HResource>& dependencies) const override
+	{
+		for (auto& entry : mDependencies)
+			dependencies.push_back(entry);
+	}
+};
+
+class BenchmarkResourceRTTI : public RTTIType<BenchmarkResource, Resource, BenchmarkResourceRTTI>
+{
+private:
+	BS_BEGIN_RTTI_MEMBERS
+		BS_RTTI_MEMBER_PLAIN_ARRAY(mData, 0)
+		BS_RTTI_MEMBER_REFL_ARRAY(mDependencies, 1)
+	BS_END_RTTI_MEMBERS
+public:
+	BenchmarkResourceRTTI()
+		:mInitMembers(this)
+	{ }
+
+	const String& getRTTIName() override
+	{
+		static String name = "BenchmarkResource";
+		return name;
+	}
+
+	UINT32 getRTTIId() override
+	{
+		return 100000; // Outside of the range used by engine types
+	}
+
+	SPtr<IReflectable> newRTTIObject() override
+	{
+		return BenchmarkResource::_createPtr();
+	}
+};
+
+RTTITypeBase* BenchmarkResource::getRTTIStatic()
+{
+	return BenchmarkResourceRTTI::instance();
+}
+
+RTTITypeBase* BenchmarkResource::getRTTI() const
+{
+	return getRTTIStatic();
+}
+
+/** Releases the provided resource, and unloads it along with all its dependencies (up to the provided depth). */
+static void unloadLevel(HResource& root, UINT32 depth)
+{
+	gResources().release(root);
+	root = nullptr;
+
+	// Asynchronously loaded resources are referenced until their listeners are notified, normally done once per frame
+	ResourceListenerManager::instance().update();
+
+	// Dependencies only become unused once the resource referencing them is unloaded, so unload one level per call
+	for (UINT32 i = 0; i < depth; i++)
+		gResources().unloadAllUnused();
+}
+
+/**
+ * Loads a level consisting of a root resource depending on 50 group resources, each depending on 99 resources with 8KB
+ * of data, 5000 resources in total. Compares loading it through the asynchronous loading pipeline with loading it
+ * synchronously on the calling thread. Also outputs the time spent in each stage of the pipeline during the
+ * asynchronous loads, summed over all worker threads.
+ */
+static void benchmarkResourceLoading()
+{
+	static const UINT32 NUM_GROUPS = 50;
+	static const UINT32 NUM_RESOURCES_PER_GROUP = 99;
+	static const UINT32 DATA_SIZE = 2048;
+	static const UINT32 NUM_ITERATIONS = 3;
+
+	Time::startUp();
+	CoreObjectManager::startUp();
+	Resources::startUp();
+	ResourceListenerManager::startUp();
+
+	Path folder = FileSystem::getTempDirectoryPath();
+	folder.append("BansheeCoreBenchmark/");
+	FileSystem::createDir(folder);
+
+	Path rootPath = folder;
+	rootPath.setFilename("Level.asset");
+
+	{
+		Vector<HResource> groups;
+		for (UINT32 i = 0; i < NUM_GROUPS; i++)
+		{
+			Vector<HResource> resources;
+			for (UINT32 j = 0; j < NUM_RESOURCES_PER_GROUP; j++)
+			{
+				HResource resource = BenchmarkResource::create(DATA_SIZE, Vector<HResource>());
+
+				Path path = folder;
+				path.setFilename("Resource_" + toString(i) + "_" + toString(j) + ".asset");
+				gResources().save(resource, path, true);
+
+				resources.push_back(resource);
+			}
+
+			HResource group = BenchmarkResource::create(0, resources);
+
+			Path path = folder;
+			path.setFilename("Group_" + toString(i) + ".asset");
+			gResources().save(group, path, true);
+
+			groups.push_back(group);
+		}
+
+		HResource root = BenchmarkResource::create(0, groups);
+		gResources().save(root, rootPath, true);
+	}
+
+	gResources().unloadAllUnused();
+
+	UINT64 numProcessed[(UINT32)ResourceLoadStage::Count] = { };
+	UINT64 totalTimeUs[(UINT32)ResourceLoadStage::Count] = { };
+
+	double currentUs = 0.0;
+	double referenceUs = 0.0;
+	for (UINT32 i = 0; i < NUM_ITERATIONS; i++)
+	{
+		ResourceLoadStats startStats = gResources().getLoadStats();
+
+		Timer timer;
+		HResource root = gResources().loadAsync(rootPath);
+		root.blockUntilLoaded(true);
+		currentUs += timer.getMicroseconds();
+
+		unloadLevel(root, 3);
+
+		ResourceLoadStats endStats = gResources().getLoadStats();
+		for (UINT32 j = 0; j < (UINT32)ResourceLoadStage::Count; j++)
+		{
+			numProcessed[j] += endStats.numProcessed[j] - startStats.numProcessed[j];
+			totalTimeUs[j] += endStats.totalTimeUs[j] - startStats.totalTimeUs[j];
+		}
+
+		timer.reset();
+		root = gResources().load(rootPath);
+		referenceUs += timer.getMicroseconds();
+
+		unloadLevel(root, 3);
+	}
+
+	printHeader("Resource loading, 5000 dependent resources", "synchronous");
+	printResult("Level load", currentUs / NUM_ITERATIONS / 1000.0, referenceUs / NUM_ITERATIONS / 1000.0, "ms");
+
+	const char* stageNames[] = { "Read", "Deserialize", "Post-process", "Upload" };
+
+	std::cout << std::endl << "Resource loading, time per stage of an asynchronous load" << std::endl;
+	for (UINT32 i = 0; i < (UINT32)ResourceLoadStage::Count; i++)
+	{
+		std::cout << std::left << std::setw(40) << stageNames[i] << std::right << std::fixed << std::setprecision(3)
+			<< std::setw(14) << (totalTimeUs[i] / 1000.0 / NUM_ITERATIONS) << " ms" << std::setw(14)
+			<< (numProcessed[i] / NUM_ITERATIONS) << " resources" << std::endl;
+	}
+
+	FileSystem::remove(folder);
+
+	ResourceListenerManager::shutDown();
+	Resources::shutDown();
+	CoreObjectManager::shutDown();
+	Time::shutDown();
+}
+
+/************************************************************************/
+/* 								PIXEL PROCESSING                   		*/
+/************************************************************************/
+
+/** Durations of the PixelUtil operations measured by measurePixelOperations(), in microseconds. */
+struct PixelOperationTimes
+{
+	static const UINT32 NUM_CONVERSIONS = 3;
+
+	double conversions[NUM_CONVERSIONS];
+	double scaleNearest;
+	double scaleLinear;
+	double mipmaps;
+};
+
+static const UINT32 PIXEL_BENCHMARK_SIZE = 2048;
+static const PixelFormat PIXEL_CONVERSION_FORMATS[] = { PF_B8G8R8A8, PF_FLOAT16_RGBA, PF_FLOAT32_RGBA };
+static const char* PIXEL_CONVERSION_NAMES[] = { "RGBA8 to BGRA8", "RGBA8 to RGBA16F", "RGBA8 to RGBA32F" };
+
+/** Creates a square RGBA8 image filled with random colors. */
+static SPtr<PixelData> createBenchmarkImage(UINT32 size)
+{
+	SPtr<PixelData> image = PixelData::create(size, size, 1, PF_R8G8B8A8);
+
+	std::mt19937 generator(42);
+	std::uniform_int_distribution<UINT32> distribution(0, 255);
+
+	UINT8* data = image->getData();
+	UINT32 numBytes = image->getConsecutiveSize();
+	for (UINT32 i = 0; i < numBytes; i++)
+		data[i] = (UINT8)distribution(generator);
+
+	return image;
+}
+
+/**
+ * PixelUtil::bulkPixelConversion() as it was before the specialized kernels: every pixel is unpacked to floats and 
+ * packed into the destination format, one at a time. Expects both images to be consecutive and of the same size.
+ */
+static void bulkPixelConversionReference(const PixelData& src, PixelData& dst)
+{
+	UINT32 srcPixelSize = PixelUtil::getNumElemBytes(src.getFormat());
+	UINT32 dstPixelSize = PixelUtil::getNumElemBytes(dst.getFormat());
+
+	const UINT8* srcPtr = src.getData();
+	UINT8* dstPtr = dst.getData();
+
+	UINT32 numPixels = src.getWidth() * src.getHeight() * src.getDepth();
+	for (UINT32 i = 0; i < numPixels; i++)
+	{
+		float r, g, b, a;
+		PixelUtil::unpackColor(&r, &g, &b, &a, src.getFormat(), srcPtr);
+		PixelUtil::packColor(r, g, b, a, dst.getFormat(), dstPtr);
+
+		srcPtr += srcPixelSize;
+		dstPtr += dstPixelSize;
+	}
+}
+
+/** 
+ * Measures format conversion, scaling and mipmap generation of a 2048x2048 RGBA8 image. Operations run on the task 
+ * scheduler worker threads if the scheduler is started, or on the calling thread otherwise.
+ */
+static PixelOperationTimes measurePixelOperations()
+{
+	PixelOperationTimes times;
+
+	SPtr<PixelData> image = createBenchmarkImage(PIXEL_BENCHMARK_SIZE);
+	for (UINT32 i = 0; i < PixelOperationTimes::NUM_CONVERSIONS; i++)
+	{
+		SPtr<PixelData> converted = PixelData::create(PIXEL_BENCHMARK_SIZE, PIXEL_BENCHMARK_SIZE, 1, 
+			PIXEL_CONVERSION_FORMATS[i]);
+
+		times.conversions[i] = measure([&]() { PixelUtil::bulkPixelConversion(*image, *converted); }, 3);
+	}
+
+	// Non-integer scale factor, so the filters can't be reduced to a plain copy or average
+	UINT32 scaledSize = PIXEL_BENCHMARK_SIZE * 3 / 4;
+	SPtr<PixelData> scaled = PixelData::create(scaledSize, scaledSize, 1, PF_R8G8B8A8);
+
+	times.scaleNearest = measure([&]() { PixelUtil::scale(*image, *scaled, PixelUtil::FILTER_NEAREST); }, 3);
+	times.scaleLinear = measure([&]() { PixelUtil::scale(*image, *scaled, PixelUtil::FILTER_LINEAR); }, 3);
+
+	MipMapGenOptions mipOptions;
+	mipOptions.isSRGB = true;
+
+	times.mipmaps = measure([&]() { PixelUtil::genMipmaps(*image, mipOptions); }, 3);
+
+	return times;
+}
+
+/**
+ * Outputs PixelUtil results. Conversions using the specialized kernels are compared with the per-pixel conversion, both
+ * on a single thread. All operations running on the task scheduler worker threads are compared with the same operations
+ * running on a single thread. Expects the task scheduler to be started, with @p singleThreadTimes measured before it was.
+ */
+static void benchmarkPixelProcessing(const PixelOperationTimes& singleThreadTimes)
+{
+	SPtr<PixelData> image = createBenchmarkImage(PIXEL_BENCHMARK_SIZE);
+
+	printHeader("PixelUtil::bulkPixelConversion, 2048x2048, single thread", "per-pixel");
+	for (UINT32 i = 0; i < PixelOperationTimes::NUM_CONVERSIONS; i++)
+	{
+		SPtr<PixelData> converted = PixelData::create(PIXEL_BENCHMARK_SIZE, PIXEL_BENCHMARK_SIZE, 1,
+			PIXEL_CONVERSION_FORMATS[i]);
+
+		double referenceUs = measure([&]() { bulkPixelConversionReference(*image, *converted); }, 3);
+		printResult(PIXEL_CONVERSION_NAMES[i], singleThreadTimes.conversions[i] / 1000.0, referenceUs / 1000.0, "ms");
+	}
+
+	PixelOperationTimes times = measurePixelOperations();
+
+	UINT32 numThreads = std::max(1U, (UINT32)BS_THREAD_HARDWARE_CONCURRENCY);
+	printHeader("PixelUtil, 2048x2048, parallel, hardware concurrency " + toString(numThreads), "single thread");
+	for (UINT32 i = 0; i < PixelOperationTimes::NUM_CONVERSIONS; i++)
+	{
+		printResult(PIXEL_CONVERSION_NAMES[i], times.conversions[i] / 1000.0, 
+			singleThreadTimes.conversions[i] / 1000.0, "ms");
+	}
+
+	printResult("Scale to 1536x1536, nearest", times.scaleNearest / 1000.0, singleThreadTimes.scaleNearest / 1000.0, "ms");
+	printResult("Scale to 1536x1536, linear", times.scaleLinear / 1000.0, singleThreadTimes.scaleLinear / 1000.0, "ms");
+	printResult("Mipmaps, sRGB box filter", times.mipmaps / 1000.0, singleThreadTimes.mipmaps / 1000.0, "ms");
+}
+
+/************************************************************************/
+/* 								PREFAB INSTANTIATION               		*/
+/************************************************************************/
+
+/** Creates a hierarchy containing the provided number of scene objects, with each object having up to 10 children. */
+static HSceneObject createPrefabHierarchy(UINT32 numObjects)
+{
+	Vector<HSceneObject> objects(numObjects);
+	for (UINT32 i = 0; i < numObjects; i++)
+	{
+		objects[i] = SceneObject::create("Object_" + toString(i), SOF_DontInstantiate);
+
+		if (i > 0)
+			objects[i]->setParent(objects[(i - 1) / 10], false);
+	}
+
+	return objects[0];
+}
+
+/**
+ * Instantiates prefab hierarchies of 10k and 100k scene objects, by cloning them the same way Prefab::instantiate() does,
+ * and destroys the instances again. Outputs the time of each step, and the time per object. There is no reference,
+ * as GameObjectManager is used directly by the scene objects.
+ */
+static void benchmarkPrefabInstantiation()
+{
+	static const UINT32 NUM_ITERATIONS = 5;
+	static const UINT32 NUM_OBJECTS[] = { 10000, 100000 };
+
+	GameObjectManager::startUp();
+
+	std::cout << std::endl << "Prefab instantiation and scene teardown" << std::endl;
+	for (auto numObjects : NUM_OBJECTS)
+	{
+		HSceneObject prefabRoot = createPrefabHierarchy(numObjects);
+
+		double instantiateUs = 0.0;
+		double teardownUs = 0.0;
+		for (UINT32 i = 0; i < NUM_ITERATIONS; i++)
+		{
+			Timer timer;
+			HSceneObject instance = prefabRoot->clone(false);
+			instantiateUs += timer.getMicroseconds();
+
+			timer.reset();
+			instance->destroy(true);
+			teardownUs += timer.getMicroseconds();
+		}
+
+		prefabRoot->destroy(true);
+
+		String numObjectsName = toString(numObjects / 1000) + "k objects";
+		std::pair<String, double> steps[] = 
+		{
+			{ numObjectsName + ", instantiate", instantiateUs / NUM_ITERATIONS },
+			{ numObjectsName + ", teardown", teardownUs / NUM_ITERATIONS }
+		};
+
+		for (auto& step : steps)
+		{
+			std::cout << std::left << std::setw(40) << step.first << std::right << std::fixed << std::setprecision(3)
+				<< std::setw(14) << (step.second / 1000.0) << " ms" << std::setw(14) << (step.second / numObjects) 
+				<< " us per object" << std::endl;
+		}
+	}
+
+	GameObjectManager::shutDown();
+}
+
+int main()
+{
+	MemStack::beginThread();
+
+	benchmarkSkeletonPose();
+	benchmarkCurveEvaluation();
+	benchmarkPrefabInstantiation();
+
+	// PixelUtil only uses worker threads once the task scheduler is started
+	PixelOperationTimes singleThreadPixelTimes = measurePixelOperations();
+
+	ThreadPool::startUp<TThreadPool<ThreadBansheePolicy>>(TaskScheduler::MAX_WORKERS, TaskScheduler::MAX_WORKERS + 1);
+	TaskScheduler::startUp();
+	CoreThread::startUp();
+
+	benchmarkCommandQueue();
+	benchmarkResourceLoading();
+	benchmarkPixelProcessing(singleThreadPixelTimes);
+
+	CoreThread::shutDown();
+	TaskScheduler::shutDown();
+	ThreadPool::shutDown();
+
+	MemStack::endThread();
+
+	return 0;
+}
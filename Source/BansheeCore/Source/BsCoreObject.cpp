@@ -10,7 +10,7 @@ using namespace std::placeholders;
 namespace bs
 {
 	CoreObject::CoreObject(bool initializeOnCoreThread)
-		:mFlags(0), mCoreDirtyFlags(0), mInternalID(0)
+		:mFlags(0), mCoreDirtyFlags(0), mCoreSyncFlags(0), mCoreDirtyIdx((UINT32)-1), mInternalID(0)
 	{
 		mInternalID = CoreObjectManager::instance().registerObject(this);
 		mFlags = initializeOnCoreThread ? mFlags | CGO_INIT_ON_CORE_THREAD : mFlags;
@@ -92,11 +92,9 @@ namespace bs
 
 	void CoreObject::markCoreDirty(UINT32 flags)
 	{
-		bool wasDirty = isCoreDirty();
+		UINT32 oldFlags = mCoreDirtyFlags.fetch_or(flags);
 
-		mCoreDirtyFlags |= flags;
-
-		if (!wasDirty && isCoreDirty())
+		if (oldFlags == 0 && flags != 0)
 			CoreObjectManager::instance().notifyCoreDirty(this);
 	}
 
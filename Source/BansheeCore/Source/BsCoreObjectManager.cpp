@@ -7,6 +7,8 @@
 #include "BsMath.h"
 #include "BsFrameAlloc.h"
 #include "BsCoreThread.h"
+#include "BsRadixSort.h"
+#include "BsTaskScheduler.h"
 
 namespace bs
 {
@@ -40,7 +42,9 @@ namespace bs
 		Lock lock(mObjectsMutex);
 
 		mObjects[mNextAvailableID] = object;
-		mDirtyObjects[mNextAvailableID] = { object, -1 };
+
+		object->mCoreDirtyIdx = (UINT32)mDirtyObjects.size();
+		mDirtyObjects.push_back({ object, mNextAvailableID, -1 });
 
 		return mNextAvailableID++;
 	}
@@ -54,27 +58,44 @@ namespace bs
 		// If dirty, we generate sync data before it is destroyed
 		{
 			Lock lock(mObjectsMutex);
-			bool isDirty = object->isCoreDirty() || (mDirtyObjects.find(internalId) != mDirtyObjects.end());
+
+			// Object is being synced by syncDownload(), which keeps it alive until it is done. Unregistering it now could 
+			// sync it concurrently, so the unregistration is deferred until the sync finishes.
+			if (object->mCoreSyncFlags != 0)
+			{
+				mPendingUnregistrations.push_back(object);
+				return;
+			}
+
+			bool isDirty = object->isCoreDirty() || object->mCoreDirtyIdx != (UINT32)-1;
 
 			if (isDirty)
 			{
+				addDirtyObject(object);
+				DirtyObjectData& dirtyObjData = mDirtyObjects[object->mCoreDirtyIdx];
+
 				SPtr<ct::CoreObject> coreObject = object->getCore();
 				if (coreObject != nullptr)
 				{
-					CoreSyncData objSyncData = object->syncToCore(gCoreThread().getFrameAlloc());
+					FrameAlloc* allocator = gCoreThread().getFrameAlloc();
+
+					object->beginCoreSync();
+					CoreSyncData objSyncData = object->syncToCore(allocator);
+					object->endCoreSync();
 				
-					mDestroyedSyncData.push_back(CoreStoredSyncObjData(coreObject, internalId, objSyncData));
+					mDestroyedSyncData.push_back(CoreStoredSyncObjData(coreObject, internalId, objSyncData, allocator));
 
-					DirtyObjectData& dirtyObjData = mDirtyObjects[internalId];
 					dirtyObjData.syncDataId = (INT32)mDestroyedSyncData.size() - 1;
 					dirtyObjData.object = nullptr;
 				}
 				else
 				{
-					DirtyObjectData& dirtyObjData = mDirtyObjects[internalId];
 					dirtyObjData.syncDataId = -1;
 					dirtyObjData.object = nullptr;
 				}
+
+				// Entry stays in the list so the sync data gets uploaded, but the object no longer references it
+				object->mCoreDirtyIdx = (UINT32)-1;
 			}
 
 			mObjects.erase(internalId);
@@ -115,11 +136,37 @@ namespace bs
 
 	void CoreObjectManager::notifyCoreDirty(CoreObject* object)
 	{
-		UINT64 id = object->getInternalID();
-
 		Lock lock(mObjectsMutex);
 
-		mDirtyObjects[id] = { object, -1 };
+		addDirtyObject(object);
+	}
+
+	void CoreObjectManager::addDirtyObject(CoreObject* object)
+	{
+		if (object->mCoreDirtyIdx != (UINT32)-1)
+			return;
+
+		object->mCoreDirtyIdx = (UINT32)mDirtyObjects.size();
+		mDirtyObjects.push_back({ object, object->getInternalID(), -1 });
+	}
+
+	void CoreObjectManager::removeDirtyObject(CoreObject* object)
+	{
+		UINT32 idx = object->mCoreDirtyIdx;
+		if (idx == (UINT32)-1)
+			return;
+
+		// Swap with the last entry. Order of the list doesn't matter as it gets sorted before syncing.
+		if (idx != (UINT32)(mDirtyObjects.size() - 1))
+		{
+			mDirtyObjects[idx] = mDirtyObjects.back();
+
+			if (mDirtyObjects[idx].object != nullptr)
+				mDirtyObjects[idx].object->mCoreDirtyIdx = idx;
+		}
+
+		mDirtyObjects.pop_back();
+		object->mCoreDirtyIdx = (UINT32)-1;
 	}
 
 	void CoreObjectManager::notifyDependenciesDirty(CoreObject* object)
@@ -254,7 +301,7 @@ namespace bs
 			if (objectCore == nullptr)
 			{
 				curObj->markCoreClean();
-				mDirtyObjects.erase(id);
+				removeDirtyObject(curObj);
 				return;
 			}
 
@@ -262,10 +309,12 @@ namespace bs
 			IndividualCoreSyncData& data = syncData.back();
 			data.allocator = allocator;
 			data.destination = objectCore;
+
+			curObj->beginCoreSync();
 			data.syncData = curObj->syncToCore(allocator);
+			curObj->endCoreSync();
 
-			curObj->markCoreClean();
-			mDirtyObjects.erase(id);
+			removeDirtyObject(curObj);
 		};
 
 		syncObject(object);
@@ -292,94 +341,248 @@ namespace bs
 
 	void CoreObjectManager::syncDownload(FrameAlloc* allocator)
 	{
-		Lock lock(mObjectsMutex);
-
-		mCoreSyncData.push_back(CoreStoredSyncData());
-		CoreStoredSyncData& syncData = mCoreSyncData.back();
-
+		// Objects are synced below without the object list lock being held, so that objects can be created, modified and
+		// destroyed from other threads (including tasks executed while waiting on the parallel sync) without deadlocking. 
+		// Each object is referenced while it is being synced, and unregistrations made in the meantime are deferred.
+		CoreStoredSyncData syncData;
 		syncData.alloc = allocator;
-		
-		// Add all objects dependant on the dirty objects
+
 		bs_frame_mark();
 		{
-			FrameSet<CoreObject*> dirtyDependants;
-			for (auto& objectData : mDirtyObjects)
+			FrameVector<SyncEntry> entries;
+			UINT32 maxLevel = 0;
+
+			// Consume the dirty list and determine the sync order
 			{
-				auto iterFind = mDependants.find(objectData.first);
-				if (iterFind != mDependants.end())
+				Lock lock(mObjectsMutex);
+
+				// Add all objects dependant on the dirty objects
+				UINT32 numDirtyObjects = (UINT32)mDirtyObjects.size();
+				for (UINT32 i = 0; i < numDirtyObjects; i++)
 				{
-					const Vector<CoreObject*>& dependants = iterFind->second;
-					for (auto& dependant : dependants)
+					auto iterFind = mDependants.find(mDirtyObjects[i].internalId);
+					if (iterFind != mDependants.end())
 					{
-						if (!dependant->isCoreDirty())
+						const Vector<CoreObject*>& dependants = iterFind->second;
+						for (auto& dependant : dependants)
 						{
-							dependant->mCoreDirtyFlags |= 0xFFFFFFFF; // To ensure the loop below doesn't skip it
-							dirtyDependants.insert(dependant);
+							if (!dependant->isCoreDirty())
+							{
+								dependant->mCoreDirtyFlags |= 0xFFFFFFFF; // To ensure the loop below doesn't skip it
+								addDirtyObject(dependant);
+							}
 						}
 					}
 				}
+
+				numDirtyObjects = (UINT32)mDirtyObjects.size();
+
+				// Order in which objects are recursed in matters, ones with lower ID will have been created before
+				// ones with higher ones and should be updated first.
+				FrameVector<UINT64> sortKeys(numDirtyObjects * 2);
+				FrameVector<UINT32> sortedIndices(numDirtyObjects * 2);
+
+				for (UINT32 i = 0; i < numDirtyObjects; i++)
+				{
+					sortKeys[i] = mDirtyObjects[i].internalId;
+					sortedIndices[i] = i;
+
+					// Objects are removed from the dirty list. While determining the sync order their index is used for 
+					// tracking their position in the sync order instead.
+					if (mDirtyObjects[i].object != nullptr)
+						mDirtyObjects[i].object->mCoreDirtyIdx = (UINT32)-1;
+				}
+
+				RadixSort::sort(sortKeys.data(), sortedIndices.data(), numDirtyObjects, sortKeys.data() + numDirtyObjects,
+					sortedIndices.data() + numDirtyObjects);
+
+				// Determine the order in which to sync the objects, making sure dependencies are synced before 
+				// dependants. Each object is also assigned a level one higher than its highest level dependency, so that
+				// objects on the same level never depend on one another.
+				static const UINT32 SYNC_IN_PROGRESS = (UINT32)-2;
+
+				entries.reserve(numDirtyObjects);
+				syncData.entries.reserve(numDirtyObjects);
+
+				std::function<void(CoreObject*)> addObject = [&](CoreObject* curObj)
+				{
+					if (!curObj->isCoreDirty() || curObj->mCoreDirtyIdx != (UINT32)-1)
+						return; // We already processed it as some other object's dependency
+
+					// Cyclic dependencies are ignored
+					curObj->mCoreDirtyIdx = SYNC_IN_PROGRESS;
+
+					UINT32 level = 0;
+					auto iterFind = mDependencies.find(curObj->getInternalID());
+					if (iterFind != mDependencies.end())
+					{
+						const Vector<CoreObject*>& dependencies = iterFind->second;
+						for (auto& dependency : dependencies)
+						{
+							addObject(dependency);
+
+							UINT32 dependencyIdx = dependency->mCoreDirtyIdx;
+							if (dependencyIdx < (UINT32)entries.size())
+								level = std::max(level, entries[dependencyIdx].level + 1);
+						}
+					}
+
+					SPtr<ct::CoreObject> objectCore = curObj->getCore();
+					if (objectCore == nullptr)
+					{
+						curObj->markCoreClean();
+						curObj->mCoreDirtyIdx = (UINT32)-1;
+						return;
+					}
+
+					// Dirty flags are cleared while the lock is held, so modifications made during the sync mark the object
+					// dirty again and don't get lost
+					curObj->beginCoreSync();
+					curObj->mCoreDirtyIdx = (UINT32)entries.size();
+
+					SPtr<CoreObject> objectRef = curObj->getThisPtr();
+					if (objectRef != nullptr)
+					{
+						entries.push_back({ curObj, objectRef, level });
+						syncData.entries.push_back(CoreStoredSyncObjData(objectCore, curObj->getInternalID(), 
+							CoreSyncData(), nullptr));
+					}
+					else
+					{
+						// Object is being deleted and is waiting for this lock in order to unregister, sync it right away
+						CoreSyncData objSyncData = curObj->syncToCore(allocator);
+						curObj->endCoreSync();
+
+						entries.push_back({ curObj, nullptr, level });
+						syncData.entries.push_back(CoreStoredSyncObjData(objectCore, curObj->getInternalID(), objSyncData,
+							allocator));
+					}
+
+					maxLevel = std::max(maxLevel, level);
+				};
+
+				for (UINT32 i = 0; i < numDirtyObjects; i++)
+				{
+					const DirtyObjectData& objectData = mDirtyObjects[sortedIndices[i]];
+
+					CoreObject* object = objectData.object;
+					if (object != nullptr)
+						addObject(object);
+					else
+					{
+						// Object was destroyed but we still need to sync its modifications before it was destroyed
+						if (objectData.syncDataId != -1)
+						{
+							entries.push_back({ nullptr, nullptr, 0 });
+							syncData.entries.push_back(mDestroyedSyncData[objectData.syncDataId]);
+						}
+					}
+				}
+
+				// Objects are no longer in the dirty list, if they get modified from now on they will be added to the new
+				// list and synced next time
+				for (auto& entry : entries)
+				{
+					if (entry.object != nullptr)
+						entry.object->mCoreDirtyIdx = (UINT32)-1;
+				}
+
+				mDirtyObjects.clear();
+				mDestroyedSyncData.clear();
 			}
 
-			for (auto& dirtyDependant : dirtyDependants)
+			// Group the objects by level
+			FrameVector<UINT32> levelOffsets(maxLevel + 2, 0);
+			for (auto& entry : entries)
 			{
-				UINT64 id = dirtyDependant->getInternalID();
+				if (entry.objectRef != nullptr)
+					levelOffsets[entry.level + 1]++;
+			}
 
-				mDirtyObjects[id] = { dirtyDependant, -1 };
+			for (UINT32 i = 0; i <= maxLevel; i++)
+				levelOffsets[i + 1] += levelOffsets[i];
+
+			FrameVector<UINT32> levelEntries(levelOffsets[maxLevel + 1]);
+			{
+				FrameVector<UINT32> levelCursors(levelOffsets.begin(), levelOffsets.end() - 1);
+				for (UINT32 i = 0; i < (UINT32)entries.size(); i++)
+				{
+					if (entries[i].objectRef != nullptr)
+						levelEntries[levelCursors[entries[i].level]++] = i;
+				}
 			}
-		}
 
-		bs_frame_clear();
-		
-		// Order in which objects are recursed in matters, ones with lower ID will have been created before
-		// ones with higher ones and should be updated first.
-		for (auto& objectData : mDirtyObjects)
-		{
-			std::function<void(CoreObject*)> syncObject = [&](CoreObject* curObj)
+			auto syncObject = [&](UINT32 entryIdx, FrameAlloc* objectAlloc)
 			{
-				if (!curObj->isCoreDirty())
-					return; // We already processed it as some other object's dependency
+				CoreObject* object = entries[entryIdx].object;
+				CoreStoredSyncObjData& objSyncData = syncData.entries[entryIdx];
 
-				// Sync dependencies before dependants
-				// Note: I don't check for recursion. Possible infinite loop if two objects
-				// are dependent on one another.
-				
-				UINT64 id = curObj->getInternalID();
-				auto iterFind = mDependencies.find(id);
+				objSyncData.syncData = object->syncToCore(objectAlloc);
+				objSyncData.alloc = objectAlloc;
+			};
 
-				if (iterFind != mDependencies.end())
+			// Sync the objects one level at a time. Objects on the same level are independent so they can be synced in
+			// parallel, each task writing to the frame allocator of the thread it runs on.
+			for (UINT32 i = 0; i <= maxLevel; i++)
+			{
+				UINT32* levelStart = levelEntries.data() + levelOffsets[i];
+				UINT32 numObjects = levelOffsets[i + 1] - levelOffsets[i];
+
+				UINT32 numChunks = 1;
+				if (numObjects >= PARALLEL_MIN_OBJECTS && TaskScheduler::isStarted())
 				{
-					const Vector<CoreObject*>& dependencies = iterFind->second;
-					for (auto& dependency : dependencies)
-						syncObject(dependency);
+					numChunks = std::min((numObjects + OBJECTS_PER_TASK - 1) / OBJECTS_PER_TASK, 
+						TaskScheduler::MAX_WORKERS);
 				}
 
-				SPtr<ct::CoreObject> objectCore = curObj->getCore();
-				if (objectCore == nullptr)
+				if (numChunks == 1)
 				{
-					curObj->markCoreClean();
-					return;
+					for (UINT32 j = 0; j < numObjects; j++)
+						syncObject(levelStart[j], allocator);
+
+					continue;
 				}
 
-				CoreSyncData objSyncData = curObj->syncToCore(allocator);
-				curObj->markCoreClean();
+				auto syncChunks = [&](UINT32 startChunk, UINT32 endChunk)
+				{
+					FrameAlloc* threadAlloc = &ThreadFrameAlloc::get();
 
-				syncData.entries.push_back(CoreStoredSyncObjData(objectCore,
-					curObj->getInternalID(), objSyncData));
-			};
+					for (UINT32 j = startChunk; j < endChunk; j++)
+					{
+						UINT32 start = (UINT32)(((UINT64)numObjects * j) / numChunks);
+						UINT32 end = (UINT32)(((UINT64)numObjects * (j + 1)) / numChunks);
+						for (UINT32 k = start; k < end; k++)
+							syncObject(levelStart[k], threadAlloc);
+					}
+				};
 
-			CoreObject* object = objectData.second.object;
-			if (object != nullptr)
-				syncObject(object);
-			else
+				TaskScheduler::instance().parallelFor(0, numChunks, 1, syncChunks);
+			}
+
+			// Process any unregistrations deferred while the objects were being synced
+			Vector<CoreObject*> pendingUnregistrations;
 			{
-				// Object was destroyed but we still need to sync its modifications before it was destroyed
-				if (objectData.second.syncDataId != -1)
-					syncData.entries.push_back(mDestroyedSyncData[objectData.second.syncDataId]);
+				Lock lock(mObjectsMutex);
+
+				for (auto& entry : entries)
+				{
+					if (entry.objectRef != nullptr)
+						entry.object->endCoreSync();
+				}
+
+				std::swap(pendingUnregistrations, mPendingUnregistrations);
 			}
+
+			for (auto& object : pendingUnregistrations)
+				unregisterObject(object);
+
+			// Releasing the references might destroy the objects, which unregisters them
+			entries.clear();
 		}
+		bs_frame_clear();
 
-		mDirtyObjects.clear();
-		mDestroyedSyncData.clear();
+		Lock lock(mObjectsMutex);
+		mCoreSyncData.push_back(std::move(syncData));
 	}
 
 	void CoreObjectManager::syncUpload()
@@ -400,7 +603,7 @@ namespace bs
 			UINT8* data = objSyncData.syncData.getBuffer();
 
 			if (data != nullptr)
-				syncData.alloc->dealloc(data);
+				objSyncData.alloc->dealloc(data);
 		}
 
 		syncData.entries.clear();
@@ -0,0 +1,32 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#include "BsPixelUtilTestSuite.h"
+#include "BsGameObjectManagerTestSuite.h"
+#include "BsSceneManagerTestSuite.h"
+#include "BsResourcesTestSuite.h"
+#include "BsConsoleTestOutput.h"
+#include "BsMemStack.h"
+
+using namespace bs;
+
+int main()
+{
+	MemStack::beginThread();
+
+	SPtr<TestSuite> tests = PixelUtilTestSuite::create<PixelUtilTestSuite>();
+
+	// Scene manager tests run while the game object manager started by its suite is still running
+	SPtr<TestSuite> gameObjectTests = GameObjectManagerTestSuite::create<GameObjectManagerTestSuite>();
+	gameObjectTests->add(SceneManagerTestSuite::create<SceneManagerTestSuite>());
+	tests->add(gameObjectTests);
+
+	// Resource tests use the task scheduler started by the pixel utility tests
+	tests->add(ResourcesTestSuite::create<ResourcesTestSuite>());
+
+	ConsoleTestOutput testOutput;
+	tests->run(testOutput);
+
+	MemStack::endThread();
+
+	return 0;
+}
@@ -94,7 +94,7 @@ namespace bs
 		while(true)
 		{
 			// Wait until we get some ready commands
-			Queue<QueuedCommand>* commands = nullptr;
+			CommandBlock* commands = nullptr;
 			{
 				Lock lock(mCommandQueueMutex);
 
@@ -184,69 +184,6 @@ namespace bs
 		getQueue()->submitToCoreThread(blockUntilComplete);
 	}
 
-	AsyncOp CoreThread::queueReturnCommand(std::function<void(AsyncOp&)> commandCallback, CoreThreadQueueFlags flags)
-	{
-		assert(BS_THREAD_CURRENT_ID != getCoreThreadId() && "Cannot queue commands on the core thread for the core thread");
-
-		if (!flags.isSet(CTQF_InternalQueue))
-			return getQueue()->queueReturnCommand(commandCallback);
-		else
-		{
-			bool blockUntilComplete = flags.isSet(CTQF_BlockUntilComplete);
-
-			AsyncOp op;
-			UINT32 commandId = -1;
-			{
-				Lock lock(mCommandQueueMutex);
-
-				if (blockUntilComplete)
-				{
-					commandId = mMaxCommandNotifyId++;
-					op = mCommandQueue->queueReturn(commandCallback, true, commandId);
-				}
-				else
-					op = mCommandQueue->queueReturn(commandCallback);
-			}
-
-			mCommandReadyCondition.notify_all();
-
-			if (blockUntilComplete)
-				blockUntilCommandCompleted(commandId);
-
-			return op;
-		}
-	}
-
-	void CoreThread::queueCommand(std::function<void()> commandCallback, CoreThreadQueueFlags flags)
-	{
-		assert(BS_THREAD_CURRENT_ID != getCoreThreadId() && "Cannot queue commands on the core thread for the core thread");
-
-		if (!flags.isSet(CTQF_InternalQueue))
-			getQueue()->queueCommand(commandCallback);
-		else
-		{
-			bool blockUntilComplete = flags.isSet(CTQF_BlockUntilComplete);
-
-			UINT32 commandId = -1;
-			{
-				Lock lock(mCommandQueueMutex);
-
-				if (blockUntilComplete)
-				{
-					commandId = mMaxCommandNotifyId++;
-					mCommandQueue->queue(commandCallback, true, commandId);
-				}
-				else
-					mCommandQueue->queue(commandCallback);
-			}
-
-			mCommandReadyCondition.notify_all();
-
-			if (blockUntilComplete)
-				blockUntilCommandCompleted(commandId);
-		}
-	}
-
 	void CoreThread::update()
 	{
 		for (UINT32 i = 0; i < NUM_SYNC_BUFFERS; i++)
@@ -255,6 +192,11 @@ namespace bs
 		mActiveFrameAlloc = (mActiveFrameAlloc + 1) % 2;
 		mFrameAllocs[mActiveFrameAlloc]->setOwnerThread(BS_THREAD_CURRENT_ID); // Sim thread
 		mFrameAllocs[mActiveFrameAlloc]->clear();
+
+		// Per-thread frame allocators follow the same cycle, so their memory can be handed off to the core thread
+		static_assert(ThreadFrameAlloc::NUM_BUFFERS == NUM_SYNC_BUFFERS, "Thread frame allocators must be kept alive "
+			"for as long as the core thread frame allocators.");
+		ThreadFrameAlloc::advanceFrame();
 	}
 
 	FrameAlloc* CoreThread::getFrameAlloc() const
@@ -18,19 +18,9 @@ namespace bs
 		bs_delete(mCommandQueue);
 	}
 
-	AsyncOp CoreThreadQueueBase::queueReturnCommand(std::function<void(AsyncOp&)> commandCallback)
-	{
-		return mCommandQueue->queueReturn(commandCallback);
-	}
-
-	void CoreThreadQueueBase::queueCommand(std::function<void()> commandCallback)
-	{
-		mCommandQueue->queue(commandCallback);
-	}
-
 	void CoreThreadQueueBase::submitToCoreThread(bool blockUntilComplete)
 	{
-		Queue<QueuedCommand>* commands = mCommandQueue->flush();
+		CommandBlock* commands = mCommandQueue->flush();
 
 		gCoreThread().queueCommand(std::bind(&CommandQueueBase::playback, mCommandQueue, commands), 
 			CTQF_InternalQueue | CTQF_BlockUntilComplete);
@@ -5,8 +5,14 @@
 
 namespace bs
 {
+	/** Slot index encoded in instance IDs assigned by the slot map. */
+	static UINT32 getSlotIndex(UINT64 id)
+	{
+		return (UINT32)(id & 0xFFFFFFFF);
+	}
+
 	GameObjectManager::GameObjectManager()
-		:mNextAvailableID(1), mIsDeserializationActive(false), mGODeserializationMode(GODM_UseNewIds | GODM_BreakExternal)
+		:mNextFreeSlot((UINT32)-1), mIsDeserializationActive(false), mGODeserializationMode(GODM_UseNewIds | GODM_BreakExternal)
 	{
 
 	}
@@ -18,21 +24,21 @@ namespace bs
 
 	GameObjectHandleBase GameObjectManager::getObject(UINT64 id) const
 	{
-		auto iterFind = mObjects.find(id);
+		UINT32 slotIdx = findSlot(id);
 
-		if (iterFind != mObjects.end())
-			return iterFind->second;
+		if (slotIdx != (UINT32)-1)
+			return mObjects[mSlots[slotIdx].index];
 
 		return nullptr;
 	}
 
 	bool GameObjectManager::tryGetObject(UINT64 id, GameObjectHandleBase& object) const
 	{
-		auto iterFind = mObjects.find(id);
+		UINT32 slotIdx = findSlot(id);
 
-		if (iterFind != mObjects.end())
+		if (slotIdx != (UINT32)-1)
 		{
-			object = iterFind->second;
+			object = mObjects[mSlots[slotIdx].index];
 			return true;
 		}
 
@@ -41,7 +47,7 @@ namespace bs
 
 	bool GameObjectManager::objectExists(UINT64 id) const
 	{
-		return mObjects.find(id) != mObjects.end();
+		return findSlot(id) != (UINT32)-1;
 	}
 
 	void GameObjectManager::remapId(UINT64 oldId, UINT64 newId)
@@ -49,8 +55,22 @@ namespace bs
 		if (oldId == newId)
 			return;
 
-		mObjects[newId] = mObjects[oldId];
-		mObjects.erase(oldId);
+		UINT32 slotIdx = findSlot(oldId);
+		if (slotIdx == (UINT32)-1)
+			return;
+
+		// Any object still registered under the new ID gets replaced
+		UINT32 existingSlotIdx = findSlot(newId);
+		if (existingSlotIdx != (UINT32)-1)
+			freeSlot(existingSlotIdx);
+
+		if (getSlotIndex(oldId) != slotIdx)
+			mRemappedIds.erase(oldId);
+
+		if (getSlotIndex(newId) != slotIdx)
+			mRemappedIds[newId] = slotIdx;
+
+		mSlots[slotIdx].id = newId;
 	}
 
 	void GameObjectManager::queueForDestroy(const GameObjectHandleBase& object)
@@ -59,24 +79,37 @@ namespace bs
 			return;
 
 		UINT64 instanceId = object->getInstanceId();
-		mQueuedForDestroy[instanceId] = object;
+		if (mQueuedForDestroyIds.insert(instanceId).second)
+			mQueuedForDestroy.push_back(object);
 	}
 
 	void GameObjectManager::destroyQueuedObjects()
 	{
-		for (auto& objPair : mQueuedForDestroy)
-			objPair.second->destroyInternal(objPair.second, true);
+		// Note: Indexing instead of iterating, since objects can be queued by callbacks triggered during destruction
+		for (UINT32 i = 0; i < (UINT32)mQueuedForDestroy.size(); i++)
+		{
+			GameObjectHandleBase object = mQueuedForDestroy[i];
+
+			// Might have been destroyed along with its parent
+			if (!object.isDestroyed())
+				object->destroyInternal(object, true);
+		}
 
 		mQueuedForDestroy.clear();
+		mQueuedForDestroyIds.clear();
 	}
 
 	GameObjectHandleBase GameObjectManager::registerObject(const SPtr<GameObject>& object, UINT64 originalId)
 	{
-		object->initialize(object, mNextAvailableID);
+		UINT32 slotIdx = allocateSlot();
+		UINT64 instanceId = mSlots[slotIdx].id;
+
+		object->initialize(object, instanceId);
 
 		// If deserialization is active we must ensure all handles pointing to the same object share GameObjectHandleData,
 		// so check if any handles referencing this object have been created. See ::registerUnresolvedHandle for
 		// further explanation.
+		GameObjectHandleBase handle;
 		if (mIsDeserializationActive)
 		{
 			assert(originalId != 0 && "You must provide an original ID when registering a deserialized game object.");
@@ -84,43 +117,100 @@ namespace bs
 			auto iterFind = mUnresolvedHandleData.find(originalId);
 			if (iterFind != mUnresolvedHandleData.end())
 			{
-				GameObjectHandleBase handle;
 				handle.mData = iterFind->second;
 				handle._setHandleData(object);
-
-				mObjects[mNextAvailableID] = handle;
-				mIdMapping[originalId] = mNextAvailableID;
-				mNextAvailableID++;
-
-				return handle;
 			}
 			else
-			{
-				GameObjectHandleBase handle(object);
-
-				mObjects[mNextAvailableID] = handle;
-				mIdMapping[originalId] = mNextAvailableID;
-				mNextAvailableID++;
+				handle = GameObjectHandleBase(object);
 
-				return handle;
-			}
+			mIdMapping[originalId] = instanceId;
 		}
+		else
+			handle = GameObjectHandleBase(object);
 
-		GameObjectHandleBase handle(object);
-		mObjects[mNextAvailableID] = handle;
-		mNextAvailableID++;
+		mSlots[slotIdx].index = (UINT32)mObjects.size();
+		mObjects.push_back(handle);
+		mObjectSlots.push_back(slotIdx);
 
 		return handle;
 	}
 
 	void GameObjectManager::unregisterObject(GameObjectHandleBase& object)
 	{
-		mObjects.erase(object->getInstanceId());
+		UINT32 slotIdx = findSlot(object->getInstanceId());
+		if (slotIdx != (UINT32)-1)
+			freeSlot(slotIdx);
 
 		onDestroyed(object);
 		object.destroy();
 	}
 
+	UINT32 GameObjectManager::findSlot(UINT64 id) const
+	{
+		UINT32 slotIdx = getSlotIndex(id);
+		if (id != 0 && slotIdx < (UINT32)mSlots.size() && mSlots[slotIdx].id == id)
+			return slotIdx;
+
+		if (mRemappedIds.empty())
+			return (UINT32)-1;
+
+		auto iterFind = mRemappedIds.find(id);
+		if (iterFind != mRemappedIds.end())
+			return iterFind->second;
+
+		return (UINT32)-1;
+	}
+
+	UINT32 GameObjectManager::allocateSlot()
+	{
+		UINT32 slotIdx;
+		if (mNextFreeSlot != (UINT32)-1)
+		{
+			slotIdx = mNextFreeSlot;
+			mNextFreeSlot = mSlots[slotIdx].index;
+		}
+		else
+		{
+			slotIdx = (UINT32)mSlots.size();
+			mSlots.push_back({ 0, 1, 0 });
+		}
+
+		ObjectSlot& slot = mSlots[slotIdx];
+		slot.id = ((UINT64)slot.generation << 32) | slotIdx;
+
+		return slotIdx;
+	}
+
+	void GameObjectManager::freeSlot(UINT32 slotIdx)
+	{
+		ObjectSlot& slot = mSlots[slotIdx];
+
+		if (getSlotIndex(slot.id) != slotIdx)
+			mRemappedIds.erase(slot.id);
+
+		// Swap with the last object so the object array stays densely packed
+		UINT32 idx = slot.index;
+		UINT32 lastIdx = (UINT32)mObjects.size() - 1;
+		if (idx != lastIdx)
+		{
+			std::swap(mObjects[idx], mObjects[lastIdx]);
+			mObjectSlots[idx] = mObjectSlots[lastIdx];
+			mSlots[mObjectSlots[idx]].index = idx;
+		}
+
+		mObjects.erase(mObjects.end() - 1);
+		mObjectSlots.erase(mObjectSlots.end() - 1);
+
+		// Zero generation is skipped so that no ID is ever zero
+		slot.generation++;
+		if (slot.generation == 0)
+			slot.generation = 1;
+
+		slot.id = 0;
+		slot.index = mNextFreeSlot;
+		mNextFreeSlot = slotIdx;
+	}
+
 	void GameObjectManager::startDeserialization()
 	{
 		assert(!mIsDeserializationActive);
@@ -167,10 +257,10 @@ namespace bs
 
 		if (isInternalReference || (!isInternalReference && (flags & GODM_RestoreExternal) != 0))
 		{
-			auto findIterObj = mObjects.find(instanceId);
+			UINT32 slotIdx = findSlot(instanceId);
 
-			if (findIterObj != mObjects.end())
-				data.handle._resolve(findIterObj->second);
+			if (slotIdx != (UINT32)-1)
+				data.handle._resolve(mObjects[mSlots[slotIdx].index]);
 			else
 			{
 				if ((flags & GODM_KeepMissing) == 0)
@@ -205,10 +295,10 @@ namespace bs
 		auto iterFind = mIdMapping.find(originalId);
 		if (iterFind != mIdMapping.end())
 		{
-			auto iterFind2 = mObjects.find(iterFind->second);
-			if (iterFind2 != mObjects.end())
+			UINT32 slotIdx = findSlot(iterFind->second);
+			if (slotIdx != (UINT32)-1)
 			{
-				object.mData = iterFind2->second.mData;
+				object.mData = mObjects[mSlots[slotIdx].index].mData;
 				foundHandleData = true;
 			}
 		}
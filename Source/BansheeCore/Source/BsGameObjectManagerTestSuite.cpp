@@ -0,0 +1,218 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#include "BsGameObjectManagerTestSuite.h"
+#include "BsGameObjectManager.h"
+#include "BsGameObject.h"
+
+namespace bs
+{
+	/** Minimal game object that unregisters itself when destroyed, and counts how many times that happened. */
+	class TestGameObject : public GameObject
+	{
+	public:
+		static UINT32 numDestroyed;
+
+	protected:
+		void destroyInternal(GameObjectHandleBase& handle, bool immediate) override
+		{
+			numDestroyed++;
+			GameObjectManager::instance().unregisterObject(handle);
+		}
+	};
+
+	UINT32 TestGameObject::numDestroyed = 0;
+
+	static GameObjectHandleBase createObject()
+	{
+		return GameObjectManager::instance().registerObject(bs_shared_ptr_new<TestGameObject>());
+	}
+
+	static void destroyObject(GameObjectHandleBase& handle)
+	{
+		GameObjectManager::instance().unregisterObject(handle);
+	}
+
+	/** Changes the instance ID of an object, the same way restoring instance data of another object does. */
+	static void remapObject(GameObjectHandleBase& handle, UINT64 newId)
+	{
+		UINT64 oldId = handle->getInstanceId();
+		handle->_getInstanceData()->mInstanceId = newId;
+
+		GameObjectManager::instance().remapId(oldId, newId);
+	}
+
+	/** Index of the slot the ID was assigned from. */
+	static UINT32 getSlot(UINT64 id)
+	{
+		return (UINT32)(id & 0xFFFFFFFF);
+	}
+
+	GameObjectManagerTestSuite::GameObjectManagerTestSuite()
+	{
+		BS_ADD_TEST(GameObjectManagerTestSuite::testRegister_unique_ids);
+		BS_ADD_TEST(GameObjectManagerTestSuite::testUnregister_dense);
+		BS_ADD_TEST(GameObjectManagerTestSuite::testReuse_new_generation);
+		BS_ADD_TEST(GameObjectManagerTestSuite::testRemap);
+		BS_ADD_TEST(GameObjectManagerTestSuite::testRemap_slot_reused);
+		BS_ADD_TEST(GameObjectManagerTestSuite::testQueueForDestroy_once);
+	}
+
+	void GameObjectManagerTestSuite::startUp()
+	{
+		GameObjectManager::startUp();
+	}
+
+	void GameObjectManagerTestSuite::shutDown()
+	{
+		GameObjectManager::shutDown();
+	}
+
+	void GameObjectManagerTestSuite::testRegister_unique_ids()
+	{
+		static const UINT32 NUM_OBJECTS = 1000;
+
+		Vector<GameObjectHandleBase> objects;
+		UnorderedSet<UINT64> ids;
+		for (UINT32 i = 0; i < NUM_OBJECTS; i++)
+		{
+			GameObjectHandleBase object = createObject();
+
+			BS_TEST_ASSERT(object->getInstanceId() != 0);
+			BS_TEST_ASSERT(ids.insert(object->getInstanceId()).second);
+
+			objects.push_back(object);
+		}
+
+		bool valid = true;
+		for (auto& object : objects)
+		{
+			GameObjectHandleBase found = GameObjectManager::instance().getObject(object->getInstanceId());
+			valid &= !found.isDestroyed() && found.get() == object.get();
+		}
+
+		BS_TEST_ASSERT(valid);
+		BS_TEST_ASSERT(!GameObjectManager::instance().objectExists(0));
+
+		for (auto& object : objects)
+			destroyObject(object);
+	}
+
+	void GameObjectManagerTestSuite::testUnregister_dense()
+	{
+		static const UINT32 NUM_OBJECTS = 1000;
+
+		Vector<GameObjectHandleBase> objects;
+		Vector<UINT64> ids;
+		for (UINT32 i = 0; i < NUM_OBJECTS; i++)
+		{
+			objects.push_back(createObject());
+			ids.push_back(objects.back()->getInstanceId());
+		}
+
+		// Removal moves other objects around, make sure they can all still be found
+		for (UINT32 i = 0; i < NUM_OBJECTS; i += 2)
+			destroyObject(objects[i]);
+
+		bool valid = true;
+		for (UINT32 i = 0; i < NUM_OBJECTS; i++)
+		{
+			GameObjectHandleBase found;
+			bool exists = GameObjectManager::instance().tryGetObject(ids[i], found);
+
+			if ((i % 2) == 0)
+				valid &= !exists && objects[i].isDestroyed();
+			else
+				valid &= exists && found.get() == objects[i].get();
+		}
+
+		BS_TEST_ASSERT(valid);
+
+		for (UINT32 i = 1; i < NUM_OBJECTS; i += 2)
+			destroyObject(objects[i]);
+	}
+
+	void GameObjectManagerTestSuite::testReuse_new_generation()
+	{
+		GameObjectHandleBase first = createObject();
+		UINT64 firstId = first->getInstanceId();
+		destroyObject(first);
+
+		// New object takes the freed slot, but with a different ID
+		GameObjectHandleBase second = createObject();
+		UINT64 secondId = second->getInstanceId();
+
+		BS_TEST_ASSERT(getSlot(firstId) == getSlot(secondId));
+		BS_TEST_ASSERT(firstId != secondId);
+		BS_TEST_ASSERT(!GameObjectManager::instance().objectExists(firstId));
+		BS_TEST_ASSERT(GameObjectManager::instance().getObject(secondId).get() == second.get());
+
+		destroyObject(second);
+	}
+
+	void GameObjectManagerTestSuite::testRemap()
+	{
+		GameObjectHandleBase object = createObject();
+		GameObjectHandleBase other = createObject();
+
+		UINT64 oldId = object->getInstanceId();
+		UINT64 otherId = other->getInstanceId();
+		destroyObject(other);
+
+		// Take over an ID that belongs to another slot
+		remapObject(object, otherId);
+
+		BS_TEST_ASSERT(!GameObjectManager::instance().objectExists(oldId));
+		BS_TEST_ASSERT(GameObjectManager::instance().getObject(otherId).get() == object.get());
+
+		// And then an ID that belongs to no slot
+		UINT64 customId = (UINT64)12345 << 32 | 0xFFFFFF;
+		remapObject(object, customId);
+
+		BS_TEST_ASSERT(!GameObjectManager::instance().objectExists(otherId));
+		BS_TEST_ASSERT(GameObjectManager::instance().getObject(customId).get() == object.get());
+
+		destroyObject(object);
+		BS_TEST_ASSERT(!GameObjectManager::instance().objectExists(customId));
+	}
+
+	void GameObjectManagerTestSuite::testRemap_slot_reused()
+	{
+		GameObjectHandleBase object = createObject();
+		GameObjectHandleBase other = createObject();
+
+		UINT64 otherId = other->getInstanceId();
+		destroyObject(other);
+		remapObject(object, otherId);
+
+		// New object reuses the slot encoded in the remapped ID. Both must be found by their own IDs.
+		GameObjectHandleBase reused = createObject();
+		UINT64 reusedId = reused->getInstanceId();
+
+		BS_TEST_ASSERT(getSlot(reusedId) == getSlot(otherId));
+		BS_TEST_ASSERT(reusedId != otherId);
+		BS_TEST_ASSERT(GameObjectManager::instance().getObject(otherId).get() == object.get());
+		BS_TEST_ASSERT(GameObjectManager::instance().getObject(reusedId).get() == reused.get());
+
+		destroyObject(reused);
+		BS_TEST_ASSERT(GameObjectManager::instance().getObject(otherId).get() == object.get());
+
+		destroyObject(object);
+		BS_TEST_ASSERT(!GameObjectManager::instance().objectExists(otherId));
+		BS_TEST_ASSERT(!GameObjectManager::instance().objectExists(reusedId));
+	}
+
+	void GameObjectManagerTestSuite::testQueueForDestroy_once()
+	{
+		GameObjectHandleBase object = createObject();
+		UINT64 id = object->getInstanceId();
+
+		TestGameObject::numDestroyed = 0;
+		GameObjectManager::instance().queueForDestroy(object);
+		GameObjectManager::instance().queueForDestroy(object);
+		GameObjectManager::instance().destroyQueuedObjects();
+
+		BS_TEST_ASSERT(TestGameObject::numDestroyed == 1);
+		BS_TEST_ASSERT(object.isDestroyed());
+		BS_TEST_ASSERT(!GameObjectManager::instance().objectExists(id));
+	}
+}
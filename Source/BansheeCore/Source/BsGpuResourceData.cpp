@@ -4,6 +4,7 @@
 #include "BsGpuResourceDataRTTI.h"
 #include "BsCoreThread.h"
 #include "BsException.h"
+#include "BsDataStream.h"
 
 namespace bs
 {
@@ -16,6 +17,7 @@ namespace bs
 	GpuResourceData::GpuResourceData(const GpuResourceData& copy)
 	{
 		mData = copy.mData;
+		mDataOwner = copy.mDataOwner;
 		mLocked = copy.mLocked; // TODO - This should be shared by all copies pointing to the same data?
 		mOwnsData = false;
 	}
@@ -28,6 +30,7 @@ namespace bs
 	GpuResourceData& GpuResourceData::operator=(const GpuResourceData& rhs)
 	{
 		mData = rhs.mData;
+		mDataOwner = rhs.mDataOwner;
 		mLocked = rhs.mLocked; // TODO - This should be shared by all copies pointing to the same data?
 		mOwnsData = false;
 
@@ -65,6 +68,7 @@ namespace bs
 		freeInternalBuffer();
 
 		mData = (UINT8*)bs_alloc(size);
+		mDataOwner = nullptr;
 		mOwnsData = true;
 	}
 
@@ -98,9 +102,38 @@ namespace bs
 		freeInternalBuffer();
 
 		mData = data;
+		mDataOwner = nullptr;
 		mOwnsData = false;
 	}
 
+	void GpuResourceData::setExternalBuffer(UINT8* data, const SPtr<DataStream>& owner)
+	{
+		setExternalBuffer(data);
+
+		mDataOwner = owner;
+	}
+
+	void GpuResourceData::copyToInternalBuffer()
+	{
+		if (mDataOwner == nullptr)
+			return;
+
+		// Allocating the internal buffer releases the owner, which might be the last reference keeping the data mapped
+		SPtr<DataStream> owner = mDataOwner;
+		UINT8* externalData = mData;
+		allocateInternalBuffer();
+
+		memcpy(mData, externalData, getInternalBufferSize());
+	}
+
+	bool GpuResourceData::getSourceFileLocation(Path& filePath, UINT64& offset) const
+	{
+		if (mDataOwner == nullptr)
+			return false;
+
+		return mDataOwner->getMappedFileLocation(mData, filePath, offset);
+	}
+
 	void GpuResourceData::_lock() const
 	{
 		mLocked = true;
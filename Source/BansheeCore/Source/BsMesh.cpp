@@ -165,6 +165,15 @@ namespace bs
 		memcpy(dest, src, pixelData.getSize());
 	}
 
+	void Mesh::getMemoryUsage(UINT64& cpuBytes, UINT64& gpuBytes) const
+	{
+		UINT32 indexSize = mIndexType == IT_16BIT ? sizeof(UINT16) : sizeof(UINT32);
+
+		gpuBytes = (UINT64)mProperties.getNumVertices() * mVertexDesc->getVertexStride() + 
+			(UINT64)mProperties.getNumIndices() * indexSize;
+		cpuBytes = (mUsage & MU_CPUCACHED) != 0 ? gpuBytes : 0;
+	}
+
 	void Mesh::readCachedData(MeshData& dest)
 	{
 		if ((mUsage & MU_CPUCACHED) == 0)
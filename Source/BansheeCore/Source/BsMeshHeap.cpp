@@ -36,9 +36,9 @@ namespace bs
 		UINT32 meshIdx = mNextFreeId++;
 
 		SPtr<MeshHeap> thisPtr = std::static_pointer_cast<MeshHeap>(getThisPtr());
-		TransientMesh* transientMesh = new (bs_alloc<TransientMesh>()) TransientMesh(thisPtr, meshIdx, 
+		TransientMesh* transientMesh = new (bs_alloc<TransientMesh, PoolAlloc>()) TransientMesh(thisPtr, meshIdx, 
 			meshData->getNumVertices(), meshData->getNumIndices(), drawOp); 
-		SPtr<TransientMesh> transientMeshPtr = bs_core_ptr<TransientMesh>(transientMesh);
+		SPtr<TransientMesh> transientMeshPtr = bs_core_ptr<TransientMesh, PoolAlloc, PoolAlloc>(transientMesh);
 
 		transientMeshPtr->_setThisPtr(transientMeshPtr);
 		transientMeshPtr->initialize();
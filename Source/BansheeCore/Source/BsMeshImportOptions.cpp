@@ -27,8 +27,8 @@ namespace bs
 
 	MeshImportOptions::MeshImportOptions()
 		: mCPUCached(false), mImportNormals(true), mImportTangents(true), mImportBlendShapes(false), mImportSkin(false)
-		, mImportAnimation(false), mReduceKeyFrames(true), mImportRootMotion(false), mImportScale(1.0f)
-		, mCollisionMeshType(CollisionMeshType::None)
+		, mImportAnimation(false), mReduceKeyFrames(true), mImportRootMotion(false), mCompressAnimation(false)
+		, mAnimationCompressionError(0.0001f), mImportScale(1.0f), mCollisionMeshType(CollisionMeshType::None)
 	{ }
 
 	SPtr<MeshImportOptions> MeshImportOptions::create()
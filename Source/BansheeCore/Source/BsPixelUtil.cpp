@@ -6,67 +6,94 @@
 #include "BsMath.h"
 #include "BsException.h"
 #include "BsTexture.h"
+#include "BsTaskScheduler.h"
+#include "BsSIMD.h"
 #include <nvtt.h>
 
 namespace bs 
 {
+	/** Minimum number of pixels an operation needs to process before it is split across worker threads. */
+	static const UINT32 PARALLEL_MIN_PIXELS = 256 * 256;
+
+	/** Approximate number of pixels processed by a single task, when an operation is split across worker threads. */
+	static const UINT32 PIXELS_PER_TASK = 64 * 1024;
+
+	/**
+	 * Calls @p worker with ranges of rows of an image, together covering all @p numRows rows. If the image is large
+	 * enough the ranges are processed in parallel on the task scheduler worker threads, otherwise the worker is called
+	 * once on the calling thread.
+	 */
+	static void forEachRowRange(UINT32 numRows, UINT32 rowWidth, const std::function<void(UINT32, UINT32)>& worker)
+	{
+		UINT64 numPixels = (UINT64)numRows * rowWidth;
+		if (numRows > 1 && numPixels >= PARALLEL_MIN_PIXELS && TaskScheduler::isStarted())
+		{
+			UINT32 rowsPerTask = std::max(1U, PIXELS_PER_TASK / std::max(rowWidth, 1U));
+			TaskScheduler::instance().parallelFor(0, numRows, rowsPerTask, worker);
+		}
+		else
+			worker(0, numRows);
+	}
+
 	/**
 	 * Performs pixel data resampling using the point filter (nearest neighbor). Does not perform format conversions.
+	 * Destination rows are counted across all slices, i.e. row index is slice * height + y.
 	 *
 	 * @tparam elementSize	Size of a single pixel in bytes.
 	 */
-	template<UINT32 elementSize> struct NearestResampler 
+	template<UINT32 elementSize> struct NearestResampler
 	{
-		static void scale(const PixelData& source, const PixelData& dest) 
+		static void scale(const PixelData& source, const PixelData& dest, UINT32 startRow, UINT32 endRow)
 		{
 			UINT8* sourceData = source.getData();
-			UINT8* destPtr = dest.getData();
 
 			// Get steps for traversing source data in 16/48 fixed point format
 			UINT64 stepX = ((UINT64)source.getWidth() << 48) / dest.getWidth();
 			UINT64 stepY = ((UINT64)source.getHeight() << 48) / dest.getHeight();
 			UINT64 stepZ = ((UINT64)source.getDepth() << 48) / dest.getDepth();
 
-			UINT64 curZ = (stepZ >> 1) - 1; // Offset half a pixel to start at pixel center
-			for (UINT32 z = dest.getFront(); z < dest.getBack(); z++, curZ += stepZ) 
+			UINT32 height = dest.getHeight();
+			for (UINT32 row = startRow; row < endRow; row++)
 			{
+				UINT32 z = row / height;
+				UINT32 y = row % height;
+
+				// Offset half a pixel to start at pixel center
+				UINT64 curZ = (stepZ >> 1) - 1 + z * stepZ;
+				UINT64 curY = (stepY >> 1) - 1 + y * stepY;
+
 				UINT32 offsetZ = (UINT32)(curZ >> 48) * source.getSlicePitch();
+				UINT32 offsetY = (UINT32)(curY >> 48) * source.getRowPitch();
 
-				UINT64 curY = (stepY >> 1) - 1; // Offset half a pixel to start at pixel center
-				for (UINT32 y = dest.getTop(); y < dest.getBottom(); y++, curY += stepY) 
-				{
-					UINT32 offsetY = (UINT32)(curY >> 48) * source.getRowPitch();
+				UINT8* destPtr = dest.getData() + (z * dest.getSlicePitch() + y * dest.getRowPitch()) * elementSize;
 
-					UINT64 curX = (stepX >> 1) - 1; // Offset half a pixel to start at pixel center
-					for (UINT32 x = dest.getLeft(); x < dest.getRight(); x++, curX += stepX) 
-					{
-						UINT32 offsetX = (UINT32)(curX >> 48);
-						UINT32 offsetBytes = elementSize*(offsetX + offsetY + offsetZ);
+				UINT64 curX = (stepX >> 1) - 1; // Offset half a pixel to start at pixel center
+				for (UINT32 x = 0; x < dest.getWidth(); x++, curX += stepX)
+				{
+					UINT32 offsetX = (UINT32)(curX >> 48);
+					UINT32 offsetBytes = elementSize*(offsetX + offsetY + offsetZ);
 
-						UINT8* curSourcePtr = sourceData + offsetBytes;
-							
-						memcpy(destPtr, curSourcePtr, elementSize);
-						destPtr += elementSize;
-					}
+					UINT8* curSourcePtr = sourceData + offsetBytes;
 
-					destPtr += elementSize*dest.getRowSkip();
+					memcpy(destPtr, curSourcePtr, elementSize);
+					destPtr += elementSize;
 				}
-
-				destPtr += elementSize*dest.getSliceSkip();
 			}
 		}
 	};
 
-	/** Performs pixel data resampling using the box filter (linear). Performs format conversions. */
-	struct LinearResampler 
+	/**
+	 * Performs pixel data resampling using the box filter (linear). Performs format conversions. Destination rows are
+	 * counted across all slices.
+	 */
+	struct LinearResampler
 	{
-		static void scale(const PixelData& source, const PixelData& dest) 
+		static void scale(const PixelData& source, const PixelData& dest, UINT32 startRow, UINT32 endRow)
 		{
 			UINT32 sourceElemSize = PixelUtil::getNumElemBytes(source.getFormat());
 			UINT32 destElemSize = PixelUtil::getNumElemBytes(dest.getFormat());
 
 			UINT8* sourceData = source.getData();
-			UINT8* destPtr = dest.getData();
 
 			// Get steps for traversing source data in 16/48 fixed point precision format
 			UINT64 stepX = ((UINT64)source.getWidth() << 48) / dest.getWidth();
@@ -79,85 +106,83 @@ namespace bs
 			// that will be used for determining the blend amount.
 			UINT32 temp = 0;
 
-			UINT64 curZ = (stepZ >> 1) - 1; // Offset half a pixel to start at pixel center
-			for (UINT32 z = dest.getFront(); z < dest.getBack(); z++, curZ += stepZ) 
+			UINT32 height = dest.getHeight();
+			for (UINT32 row = startRow; row < endRow; row++)
 			{
+				UINT32 z = row / height;
+				UINT32 y = row % height;
+
+				UINT64 curZ = (stepZ >> 1) - 1 + z * stepZ; // Offset half a pixel to start at pixel center
 				temp = UINT32(curZ >> 32);
 				temp = (temp > 0x8000)? temp - 0x8000 : 0;
 				UINT32 sampleCoordZ1 = temp >> 16;
 				UINT32 sampleCoordZ2 = std::min(sampleCoordZ1 + 1, (UINT32)source.getDepth() - 1);
-				float sampleWeightZ = (temp & 0xFFFF) / 65536.0f; 
+				float sampleWeightZ = (temp & 0xFFFF) / 65536.0f;
 
-				UINT64 curY = (stepY >> 1) - 1; // Offset half a pixel to start at pixel center
-				for (UINT32 y = dest.getTop(); y < dest.getBottom(); y++, curY += stepY) 
+				UINT64 curY = (stepY >> 1) - 1 + y * stepY; // Offset half a pixel to start at pixel center
+				temp = (UINT32)(curY >> 32);
+				temp = (temp > 0x8000)? temp - 0x8000 : 0;
+				UINT32 sampleCoordY1 = temp >> 16;
+				UINT32 sampleCoordY2 = std::min(sampleCoordY1 + 1, (UINT32)source.getHeight() - 1);
+				float sampleWeightY = (temp & 0xFFFF) / 65536.0f;
+
+				UINT8* destPtr = dest.getData() + (z * dest.getSlicePitch() + y * dest.getRowPitch()) * destElemSize;
+
+				UINT64 curX = (stepX >> 1) - 1; // Offset half a pixel to start at pixel center
+				for (UINT32 x = 0; x < dest.getWidth(); x++, curX += stepX)
 				{
-					temp = (UINT32)(curY >> 32);
+					temp = (UINT32)(curX >> 32);
 					temp = (temp > 0x8000)? temp - 0x8000 : 0;
-					UINT32 sampleCoordY1 = temp >> 16;
-					UINT32 sampleCoordY2 = std::min(sampleCoordY1 + 1, (UINT32)source.getHeight() - 1);
-					float sampleWeightY = (temp & 0xFFFF) / 65536.0f;
+					UINT32 sampleCoordX1 = temp >> 16;
+					UINT32 sampleCoordX2 = std::min(sampleCoordX1 + 1, (UINT32)source.getWidth() - 1);
+					float sampleWeightX = (temp & 0xFFFF) / 65536.0f;
 
-					UINT64 curX = (stepX >> 1) - 1; // Offset half a pixel to start at pixel center
-					for (UINT32 x = dest.getLeft(); x < dest.getRight(); x++, curX += stepX) 
-					{
-						temp = (UINT32)(curX >> 32);
-						temp = (temp > 0x8000)? temp - 0x8000 : 0;
-						UINT32 sampleCoordX1 = temp >> 16;
-						UINT32 sampleCoordX2 = std::min(sampleCoordX1 + 1, (UINT32)source.getWidth() - 1);
-						float sampleWeightX = (temp & 0xFFFF) / 65536.0f;
-
-						Color x1y1z1, x2y1z1, x1y2z1, x2y2z1;
-						Color x1y1z2, x2y1z2, x1y2z2, x2y2z2;
+					Color x1y1z1, x2y1z1, x1y2z1, x2y2z1;
+					Color x1y1z2, x2y1z2, x1y2z2, x2y2z2;
 
 #define GETSOURCEDATA(x, y, z) sourceData + sourceElemSize*((x)+(y)*source.getRowPitch() + (z)*source.getSlicePitch())
 
-						PixelUtil::unpackColor(&x1y1z1, source.getFormat(), GETSOURCEDATA(sampleCoordX1, sampleCoordY1, sampleCoordZ1));
-						PixelUtil::unpackColor(&x2y1z1, source.getFormat(), GETSOURCEDATA(sampleCoordX2, sampleCoordY1, sampleCoordZ1));
-						PixelUtil::unpackColor(&x1y2z1, source.getFormat(), GETSOURCEDATA(sampleCoordX1, sampleCoordY2, sampleCoordZ1));
-						PixelUtil::unpackColor(&x2y2z1, source.getFormat(), GETSOURCEDATA(sampleCoordX2, sampleCoordY2, sampleCoordZ1));
-						PixelUtil::unpackColor(&x1y1z2, source.getFormat(), GETSOURCEDATA(sampleCoordX1, sampleCoordY1, sampleCoordZ2));
-						PixelUtil::unpackColor(&x2y1z2, source.getFormat(), GETSOURCEDATA(sampleCoordX2, sampleCoordY1, sampleCoordZ2));
-						PixelUtil::unpackColor(&x1y2z2, source.getFormat(), GETSOURCEDATA(sampleCoordX1, sampleCoordY2, sampleCoordZ2));
-						PixelUtil::unpackColor(&x2y2z2, source.getFormat(), GETSOURCEDATA(sampleCoordX2, sampleCoordY2, sampleCoordZ2));
+					PixelUtil::unpackColor(&x1y1z1, source.getFormat(), GETSOURCEDATA(sampleCoordX1, sampleCoordY1, sampleCoordZ1));
+					PixelUtil::unpackColor(&x2y1z1, source.getFormat(), GETSOURCEDATA(sampleCoordX2, sampleCoordY1, sampleCoordZ1));
+					PixelUtil::unpackColor(&x1y2z1, source.getFormat(), GETSOURCEDATA(sampleCoordX1, sampleCoordY2, sampleCoordZ1));
+					PixelUtil::unpackColor(&x2y2z1, source.getFormat(), GETSOURCEDATA(sampleCoordX2, sampleCoordY2, sampleCoordZ1));
+					PixelUtil::unpackColor(&x1y1z2, source.getFormat(), GETSOURCEDATA(sampleCoordX1, sampleCoordY1, sampleCoordZ2));
+					PixelUtil::unpackColor(&x2y1z2, source.getFormat(), GETSOURCEDATA(sampleCoordX2, sampleCoordY1, sampleCoordZ2));
+					PixelUtil::unpackColor(&x1y2z2, source.getFormat(), GETSOURCEDATA(sampleCoordX1, sampleCoordY2, sampleCoordZ2));
+					PixelUtil::unpackColor(&x2y2z2, source.getFormat(), GETSOURCEDATA(sampleCoordX2, sampleCoordY2, sampleCoordZ2));
 #undef GETSOURCEDATA
 
-						Color accum =
-							x1y1z1 * ((1.0f - sampleWeightX)*(1.0f - sampleWeightY)*(1.0f - sampleWeightZ)) +
-							x2y1z1 * (        sampleWeightX *(1.0f - sampleWeightY)*(1.0f - sampleWeightZ)) +
-							x1y2z1 * ((1.0f - sampleWeightX)*        sampleWeightY *(1.0f - sampleWeightZ)) +
-							x2y2z1 * (        sampleWeightX *        sampleWeightY *(1.0f - sampleWeightZ)) +
-							x1y1z2 * ((1.0f - sampleWeightX)*(1.0f - sampleWeightY)*        sampleWeightZ ) +
-							x2y1z2 * (        sampleWeightX *(1.0f - sampleWeightY)*        sampleWeightZ ) +
-							x1y2z2 * ((1.0f - sampleWeightX)*        sampleWeightY *        sampleWeightZ ) +
-							x2y2z2 * (        sampleWeightX *        sampleWeightY *        sampleWeightZ );
-
-						PixelUtil::packColor(accum, dest.getFormat(), destPtr);
+					Color accum =
+						x1y1z1 * ((1.0f - sampleWeightX)*(1.0f - sampleWeightY)*(1.0f - sampleWeightZ)) +
+						x2y1z1 * (        sampleWeightX *(1.0f - sampleWeightY)*(1.0f - sampleWeightZ)) +
+						x1y2z1 * ((1.0f - sampleWeightX)*        sampleWeightY *(1.0f - sampleWeightZ)) +
+						x2y2z1 * (        sampleWeightX *        sampleWeightY *(1.0f - sampleWeightZ)) +
+						x1y1z2 * ((1.0f - sampleWeightX)*(1.0f - sampleWeightY)*        sampleWeightZ ) +
+						x2y1z2 * (        sampleWeightX *(1.0f - sampleWeightY)*        sampleWeightZ ) +
+						x1y2z2 * ((1.0f - sampleWeightX)*        sampleWeightY *        sampleWeightZ ) +
+						x2y2z2 * (        sampleWeightX *        sampleWeightY *        sampleWeightZ );
 
-						destPtr += destElemSize;
-					}
+					PixelUtil::packColor(accum, dest.getFormat(), destPtr);
 
-					destPtr += destElemSize * dest.getRowSkip();
+					destPtr += destElemSize;
 				}
-
-				destPtr += destElemSize * dest.getSliceSkip();
 			}
 		}
 	};
 
 
-	/** 
+	/**
 	 * Performs pixel data resampling using the box filter (linear). Only handles float RGB or RGBA pixel data (32 bits per
-	 * channel).
+	 * channel). Destination rows are counted across all slices.
 	 */
-	struct LinearResampler_Float32 
+	struct LinearResampler_Float32
 	{
-		static void scale(const PixelData& source, const PixelData& dest) 
+		static void scale(const PixelData& source, const PixelData& dest, UINT32 startRow, UINT32 endRow)
 		{
 			UINT32 numSourceChannels = PixelUtil::getNumElemBytes(source.getFormat()) / sizeof(float);
 			UINT32 numDestChannels = PixelUtil::getNumElemBytes(dest.getFormat()) / sizeof(float);
 
 			float* sourceData = (float*)source.getData();
-			float* destPtr = (float*)dest.getData();
 
 			// Get steps for traversing source data in 16/48 fixed point precision format
 			UINT64 stepX = ((UINT64)source.getWidth() << 48) / dest.getWidth();
@@ -170,87 +195,86 @@ namespace bs
 			// that will be used for determining the blend amount.
 			UINT32 temp = 0;
 
-			UINT64 curZ = (stepZ >> 1) - 1; // Offset half a pixel to start at pixel center
-			for (UINT32 z = dest.getFront(); z < dest.getBack(); z++, curZ += stepZ) 
+			UINT32 height = dest.getHeight();
+			for (UINT32 row = startRow; row < endRow; row++)
 			{
+				UINT32 z = row / height;
+				UINT32 y = row % height;
+
+				UINT64 curZ = (stepZ >> 1) - 1 + z * stepZ; // Offset half a pixel to start at pixel center
 				temp = (UINT32)(curZ >> 32);
 				temp = (temp > 0x8000)? temp - 0x8000 : 0;
 				UINT32 sampleCoordZ1 = temp >> 16;
 				UINT32 sampleCoordZ2 = std::min(sampleCoordZ1 + 1, (UINT32)source.getDepth() - 1);
 				float sampleWeightZ = (temp & 0xFFFF) / 65536.0f;
 
-				UINT64 curY = (stepY >> 1) - 1; // Offset half a pixel to start at pixel center
-				for (UINT32 y = dest.getTop(); y < dest.getBottom(); y++, curY += stepY) 
+				UINT64 curY = (stepY >> 1) - 1 + y * stepY; // Offset half a pixel to start at pixel center
+				temp = (UINT32)(curY >> 32);
+				temp = (temp > 0x8000)? temp - 0x8000 : 0;
+				UINT32 sampleCoordY1 = temp >> 16;
+				UINT32 sampleCoordY2 = std::min(sampleCoordY1 + 1, (UINT32)source.getHeight() - 1);
+				float sampleWeightY = (temp & 0xFFFF) / 65536.0f;
+
+				float* destPtr = (float*)dest.getData() + (z * dest.getSlicePitch() + y * dest.getRowPitch()) * numDestChannels;
+
+				UINT64 curX = (stepX >> 1) - 1; // Offset half a pixel to start at pixel center
+				for (UINT32 x = 0; x < dest.getWidth(); x++, curX += stepX)
 				{
-					temp = (UINT32)(curY >> 32);
+					temp = (UINT32)(curX >> 32);
 					temp = (temp > 0x8000)? temp - 0x8000 : 0;
-					UINT32 sampleCoordY1 = temp >> 16;
-					UINT32 sampleCoordY2 = std::min(sampleCoordY1 + 1, (UINT32)source.getHeight() - 1);
-					float sampleWeightY = (temp & 0xFFFF) / 65536.0f;
+					UINT32 sampleCoordX1 = temp >> 16;
+					UINT32 sampleCoordX2 = std::min(sampleCoordX1 + 1, (UINT32)source.getWidth() - 1);
+					float sampleWeightX = (temp & 0xFFFF) / 65536.0f;
 
-					UINT64 curX = (stepX >> 1) - 1; // Offset half a pixel to start at pixel center
-					for (UINT32 x = dest.getLeft(); x < dest.getRight(); x++, curX += stepX) 
-					{
-						temp = (UINT32)(curX >> 32);
-						temp = (temp > 0x8000)? temp - 0x8000 : 0;
-						UINT32 sampleCoordX1 = temp >> 16;
-						UINT32 sampleCoordX2 = std::min(sampleCoordX1 + 1, (UINT32)source.getWidth() - 1);
-						float sampleWeightX = (temp & 0xFFFF) / 65536.0f;
-
-						// process R,G,B,A simultaneously for cache coherence?
-						float accum[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+					// process R,G,B,A simultaneously for cache coherence?
+					float accum[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
 
 
 #define ACCUM3(x,y,z,factor) \
-						{ float f = factor; \
-						UINT32 offset = (x + y*source.getRowPitch() + z*source.getSlicePitch())*numSourceChannels; \
-						accum[0] += sourceData[offset + 0] * f; accum[1] += sourceData[offset + 1] * f; \
-						accum[2] += sourceData[offset + 2] * f; }
+					{ float f = factor; \
+					UINT32 offset = (x + y*source.getRowPitch() + z*source.getSlicePitch())*numSourceChannels; \
+					accum[0] += sourceData[offset + 0] * f; accum[1] += sourceData[offset + 1] * f; \
+					accum[2] += sourceData[offset + 2] * f; }
 
 #define ACCUM4(x,y,z,factor) \
-						{ float f = factor; \
-						UINT32 offset = (x + y*source.getRowPitch() + z*source.getSlicePitch())*numSourceChannels; \
-						accum[0] += sourceData[offset + 0] * f; accum[1] += sourceData[offset + 1] * f; \
-						accum[2] += sourceData[offset + 2] * f; accum[3] += sourceData[offset + 3] * f; }
+					{ float f = factor; \
+					UINT32 offset = (x + y*source.getRowPitch() + z*source.getSlicePitch())*numSourceChannels; \
+					accum[0] += sourceData[offset + 0] * f; accum[1] += sourceData[offset + 1] * f; \
+					accum[2] += sourceData[offset + 2] * f; accum[3] += sourceData[offset + 3] * f; }
 
-						if (numSourceChannels == 3 || numDestChannels == 3)
-						{
-							// RGB
-							ACCUM3(sampleCoordX1, sampleCoordY1, sampleCoordZ1, (1.0f - sampleWeightX) * (1.0f - sampleWeightY) * (1.0f - sampleWeightZ));
-							ACCUM3(sampleCoordX2, sampleCoordY1, sampleCoordZ1, sampleWeightX		   * (1.0f - sampleWeightY) * (1.0f - sampleWeightZ));
-							ACCUM3(sampleCoordX1, sampleCoordY2, sampleCoordZ1, (1.0f - sampleWeightX) * sampleWeightY			* (1.0f - sampleWeightZ));
-							ACCUM3(sampleCoordX2, sampleCoordY2, sampleCoordZ1, sampleWeightX		   * sampleWeightY		    * (1.0f - sampleWeightZ));
-							ACCUM3(sampleCoordX1, sampleCoordY1, sampleCoordZ2, (1.0f - sampleWeightX) * (1.0f - sampleWeightY) * sampleWeightZ);
-							ACCUM3(sampleCoordX2, sampleCoordY1, sampleCoordZ2, sampleWeightX		   * (1.0f - sampleWeightY) * sampleWeightZ);
-							ACCUM3(sampleCoordX1, sampleCoordY2, sampleCoordZ2, (1.0f - sampleWeightX) * sampleWeightY			* sampleWeightZ);
-							ACCUM3(sampleCoordX2, sampleCoordY2, sampleCoordZ2, sampleWeightX		   * sampleWeightY			* sampleWeightZ);
-							accum[3] = 1.0f;
-						}
-						else 
-						{
-							// RGBA
-							ACCUM4(sampleCoordX1, sampleCoordY1, sampleCoordZ1, (1.0f - sampleWeightX) * (1.0f - sampleWeightY) * (1.0f - sampleWeightZ));
-							ACCUM4(sampleCoordX2, sampleCoordY1, sampleCoordZ1, sampleWeightX		   * (1.0f - sampleWeightY) * (1.0f - sampleWeightZ));
-							ACCUM4(sampleCoordX1, sampleCoordY2, sampleCoordZ1, (1.0f - sampleWeightX) * sampleWeightY			* (1.0f - sampleWeightZ));
-							ACCUM4(sampleCoordX2, sampleCoordY2, sampleCoordZ1, sampleWeightX		   * sampleWeightY			* (1.0f - sampleWeightZ));
-							ACCUM4(sampleCoordX1, sampleCoordY1, sampleCoordZ2, (1.0f - sampleWeightX) * (1.0f - sampleWeightY) * sampleWeightZ);
-							ACCUM4(sampleCoordX2, sampleCoordY1, sampleCoordZ2, sampleWeightX		   * (1.0f - sampleWeightY) * sampleWeightZ);
-							ACCUM4(sampleCoordX1, sampleCoordY2, sampleCoordZ2, (1.0f - sampleWeightX) * sampleWeightY			* sampleWeightZ);
-							ACCUM4(sampleCoordX2, sampleCoordY2, sampleCoordZ2, sampleWeightX		   * sampleWeightY			* sampleWeightZ);
-						}
+					if (numSourceChannels == 3 || numDestChannels == 3)
+					{
+						// RGB
+						ACCUM3(sampleCoordX1, sampleCoordY1, sampleCoordZ1, (1.0f - sampleWeightX) * (1.0f - sampleWeightY) * (1.0f - sampleWeightZ));
+						ACCUM3(sampleCoordX2, sampleCoordY1, sampleCoordZ1, sampleWeightX		   * (1.0f - sampleWeightY) * (1.0f - sampleWeightZ));
+						ACCUM3(sampleCoordX1, sampleCoordY2, sampleCoordZ1, (1.0f - sampleWeightX) * sampleWeightY			* (1.0f - sampleWeightZ));
+						ACCUM3(sampleCoordX2, sampleCoordY2, sampleCoordZ1, sampleWeightX		   * sampleWeightY		    * (1.0f - sampleWeightZ));
+						ACCUM3(sampleCoordX1, sampleCoordY1, sampleCoordZ2, (1.0f - sampleWeightX) * (1.0f - sampleWeightY) * sampleWeightZ);
+						ACCUM3(sampleCoordX2, sampleCoordY1, sampleCoordZ2, sampleWeightX		   * (1.0f - sampleWeightY) * sampleWeightZ);
+						ACCUM3(sampleCoordX1, sampleCoordY2, sampleCoordZ2, (1.0f - sampleWeightX) * sampleWeightY			* sampleWeightZ);
+						ACCUM3(sampleCoordX2, sampleCoordY2, sampleCoordZ2, sampleWeightX		   * sampleWeightY			* sampleWeightZ);
+						accum[3] = 1.0f;
+					}
+					else
+					{
+						// RGBA
+						ACCUM4(sampleCoordX1, sampleCoordY1, sampleCoordZ1, (1.0f - sampleWeightX) * (1.0f - sampleWeightY) * (1.0f - sampleWeightZ));
+						ACCUM4(sampleCoordX2, sampleCoordY1, sampleCoordZ1, sampleWeightX		   * (1.0f - sampleWeightY) * (1.0f - sampleWeightZ));
+						ACCUM4(sampleCoordX1, sampleCoordY2, sampleCoordZ1, (1.0f - sampleWeightX) * sampleWeightY			* (1.0f - sampleWeightZ));
+						ACCUM4(sampleCoordX2, sampleCoordY2, sampleCoordZ1, sampleWeightX		   * sampleWeightY			* (1.0f - sampleWeightZ));
+						ACCUM4(sampleCoordX1, sampleCoordY1, sampleCoordZ2, (1.0f - sampleWeightX) * (1.0f - sampleWeightY) * sampleWeightZ);
+						ACCUM4(sampleCoordX2, sampleCoordY1, sampleCoordZ2, sampleWeightX		   * (1.0f - sampleWeightY) * sampleWeightZ);
+						ACCUM4(sampleCoordX1, sampleCoordY2, sampleCoordZ2, (1.0f - sampleWeightX) * sampleWeightY			* sampleWeightZ);
+						ACCUM4(sampleCoordX2, sampleCoordY2, sampleCoordZ2, sampleWeightX		   * sampleWeightY			* sampleWeightZ);
+					}
 
-						memcpy(destPtr, accum, sizeof(float)*numDestChannels);
+					memcpy(destPtr, accum, sizeof(float)*numDestChannels);
 
 #undef ACCUM3
 #undef ACCUM4
 
-						destPtr += numDestChannels;
-					}
-
-					destPtr += numDestChannels*dest.getRowSkip();
+					destPtr += numDestChannels;
 				}
-
-				destPtr += numDestChannels*dest.getSliceSkip();
 			}
 		}
 	};
@@ -264,24 +288,23 @@ namespace bs
 	// as unrolling loops and replacing multiplies with bitshifts
 
 	/**
-	 * Performs pixel data resampling using the box filter (linear). Only handles pixel formats with one byte per channel. 
-	 * Does not perform format conversion.
+	 * Performs pixel data resampling using the box filter (linear). Only handles pixel formats with one byte per channel.
+	 * Does not perform format conversion. Destination rows are counted across all slices.
 	 *
 	 * @tparam	channels	Number of channels in the pixel format.
 	 */
-	template<UINT32 channels> struct LinearResampler_Byte 
+	template<UINT32 channels> struct LinearResampler_Byte
 	{
-		static void scale(const PixelData& source, const PixelData& dest) 
+		static void scale(const PixelData& source, const PixelData& dest, UINT32 startRow, UINT32 endRow)
 		{
 			// Only optimized for 2D
-			if (source.getDepth() > 1 || dest.getDepth() > 1) 
+			if (source.getDepth() > 1 || dest.getDepth() > 1)
 			{
-				LinearResampler::scale(source, dest);
+				LinearResampler::scale(source, dest, startRow, endRow);
 				return;
 			}
 
 			UINT8* sourceData = (UINT8*)source.getData();
-			UINT8* destPtr = (UINT8*)dest.getData();
 
 			// Get steps for traversing source data in 16/48 fixed point precision format
 			UINT64 stepX = ((UINT64)source.getWidth() << 48) / dest.getWidth();
@@ -293,9 +316,9 @@ namespace bs
 			// that will be used for determining the blend amount.
 			UINT32 temp;
 
-			UINT64 curY = (stepY >> 1) - 1; // Offset half a pixel to start at pixel center
-			for (UINT32 y = dest.getTop(); y < dest.getBottom(); y++, curY += stepY)
+			for (UINT32 y = startRow; y < endRow; y++)
 			{
+				UINT64 curY = (stepY >> 1) - 1 + y * stepY; // Offset half a pixel to start at pixel center
 				temp = (UINT32)(curY >> 36);
 				temp = (temp > 0x800)? temp - 0x800: 0;
 				UINT32 sampleWeightY = temp & 0xFFF;
@@ -305,8 +328,10 @@ namespace bs
 				UINT32 sampleY1Offset = sampleCoordY1 * source.getRowPitch();
 				UINT32 sampleY2Offset = sampleCoordY2 * source.getRowPitch();
 
+				UINT8* destPtr = (UINT8*)dest.getData() + y * dest.getRowPitch() * channels;
+
 				UINT64 curX = (stepX >> 1) - 1; // Offset half a pixel to start at pixel center
-				for (UINT32 x = dest.getLeft(); x < dest.getRight(); x++, curX += stepX)
+				for (UINT32 x = 0; x < dest.getWidth(); x++, curX += stepX)
 				{
 					temp = (UINT32)(curX >> 36);
 					temp = (temp > 0x800)? temp - 0x800 : 0;
@@ -315,7 +340,7 @@ namespace bs
 					UINT32 sampleCoordX2 = std::min(sampleCoordX1 + 1, (UINT32)source.getRight() - source.getLeft() - 1);
 
 					UINT32 sxfsyf = sampleWeightX*sampleWeightY;
-					for (UINT32 k = 0; k < channels; k++) 
+					for (UINT32 k = 0; k < channels; k++)
 					{
 						UINT32 accum =
 							sourceData[(sampleCoordX1 + sampleY1Offset)*channels+k]*(0x1000000-(sampleWeightX<<12)-(sampleWeightY<<12)+sxfsyf) +
@@ -328,11 +353,362 @@ namespace bs
 						destPtr++;
 					}
 				}
-				destPtr += channels*dest.getRowSkip();
 			}
 		}
 	};
 
+	/** Scales @p source into @p dest using the provided resampler, splitting destination rows between worker threads. */
+	template<class Resampler>
+	void scaleParallel(const PixelData& source, const PixelData& dest)
+	{
+		forEachRowRange(dest.getHeight() * dest.getDepth(), dest.getWidth(),
+			[&](UINT32 startRow, UINT32 endRow)
+		{
+			Resampler::scale(source, dest, startRow, endRow);
+		});
+	}
+
+	/** Converts a row of @p count pixels from one pixel format to another. */
+	typedef void(*ConvertRowFunc)(const UINT8* src, UINT8* dst, UINT32 count);
+
+	/** Swaps the red and blue channels of 8-bit four channel pixels (RGBA <-> BGRA). */
+	static void convertRow_8888_SwapRB(const UINT8* src, UINT8* dst, UINT32 count)
+	{
+		UINT32 i = 0;
+
+#if BS_SIMD_SSE
+		const __m128i agMask = _mm_set1_epi32(0xFF00FF00);
+		const __m128i rbMask = _mm_set1_epi32(0x00FF00FF);
+		for (; i + 4 <= count; i += 4)
+		{
+			__m128i pixels = _mm_loadu_si128((const __m128i*)(src + i * 4));
+
+			__m128i ag = _mm_and_si128(pixels, agMask);
+			__m128i rb = _mm_and_si128(pixels, rbMask);
+			rb = _mm_or_si128(_mm_slli_epi32(rb, 16), _mm_srli_epi32(rb, 16));
+
+			_mm_storeu_si128((__m128i*)(dst + i * 4), _mm_or_si128(ag, rb));
+		}
+#endif
+
+		for (; i < count; i++)
+		{
+			UINT32 pixel;
+			memcpy(&pixel, src + i * 4, sizeof(pixel));
+
+			pixel = (pixel & 0xFF00FF00) | ((pixel & 0x00FF0000) >> 16) | ((pixel & 0x000000FF) << 16);
+			memcpy(dst + i * 4, &pixel, sizeof(pixel));
+		}
+	}
+
+	/**
+	 * Expands 8-bit three channel pixels to four channel ones, with alpha set to one.
+	 *
+	 * @tparam	swapRB	If true the red and blue channels are swapped (RGB -> BGRA, or BGR -> RGBA).
+	 */
+	template<bool swapRB>
+	void convertRow_888_To_8888(const UINT8* src, UINT8* dst, UINT32 count)
+	{
+		for (UINT32 i = 0; i < count; i++, src += 3, dst += 4)
+		{
+			dst[0] = swapRB ? src[2] : src[0];
+			dst[1] = src[1];
+			dst[2] = swapRB ? src[0] : src[2];
+			dst[3] = 255;
+		}
+	}
+
+	/**
+	 * Drops the alpha channel of 8-bit four channel pixels.
+	 *
+	 * @tparam	swapRB	If true the red and blue channels are swapped (RGBA -> BGR, or BGRA -> RGB).
+	 */
+	template<bool swapRB>
+	void convertRow_8888_To_888(const UINT8* src, UINT8* dst, UINT32 count)
+	{
+		for (UINT32 i = 0; i < count; i++, src += 4, dst += 3)
+		{
+			dst[0] = swapRB ? src[2] : src[0];
+			dst[1] = src[1];
+			dst[2] = swapRB ? src[0] : src[2];
+		}
+	}
+
+	/**
+	 * Converts 8-bit four channel pixels to 32-bit floating point RGBA pixels. Results are identical to
+	 * PixelUtil::unpackColor().
+	 *
+	 * @tparam	swapRB	If true the source pixels are in BGRA order.
+	 */
+	template<bool swapRB>
+	void convertRow_8888_To_F32(const UINT8* src, UINT8* dst, UINT32 count)
+	{
+		float* output = (float*)dst;
+		UINT32 i = 0;
+
+#if BS_SIMD_SSE
+		const __m128i zero = _mm_setzero_si128();
+		const __m128 maxValue = _mm_set1_ps(255.0f);
+		for (; i + 4 <= count; i += 4)
+		{
+			__m128i pixels = _mm_loadu_si128((const __m128i*)(src + i * 4));
+			__m128i lo = _mm_unpacklo_epi8(pixels, zero);
+			__m128i hi = _mm_unpackhi_epi8(pixels, zero);
+
+			__m128 colors[4];
+			colors[0] = _mm_cvtepi32_ps(_mm_unpacklo_epi16(lo, zero));
+			colors[1] = _mm_cvtepi32_ps(_mm_unpackhi_epi16(lo, zero));
+			colors[2] = _mm_cvtepi32_ps(_mm_unpacklo_epi16(hi, zero));
+			colors[3] = _mm_cvtepi32_ps(_mm_unpackhi_epi16(hi, zero));
+
+			for (UINT32 j = 0; j < 4; j++)
+			{
+				__m128 color = _mm_div_ps(colors[j], maxValue);
+				if (swapRB)
+					color = _mm_shuffle_ps(color, color, _MM_SHUFFLE(3, 0, 1, 2));
+
+				_mm_storeu_ps(output + (i + j) * 4, color);
+			}
+		}
+#endif
+
+		for (; i < count; i++)
+		{
+			const UINT8* pixel = src + i * 4;
+			float* color = output + i * 4;
+
+			color[0] = pixel[swapRB ? 2 : 0] / 255.0f;
+			color[1] = pixel[1] / 255.0f;
+			color[2] = pixel[swapRB ? 0 : 2] / 255.0f;
+			color[3] = pixel[3] / 255.0f;
+		}
+	}
+
+	/**
+	 * Converts 32-bit floating point RGBA pixels to 8-bit four channel pixels. Results are identical to
+	 * PixelUtil::packColor().
+	 *
+	 * @tparam	swapRB	If true the destination pixels are in BGRA order.
+	 */
+	template<bool swapRB>
+	void convertRow_F32_To_8888(const UINT8* src, UINT8* dst, UINT32 count)
+	{
+		const float* input = (const float*)src;
+		UINT32 i = 0;
+
+#if BS_SIMD_SSE
+		const __m128 zero = _mm_setzero_ps();
+		const __m128 scale = _mm_set1_ps(256.0f);
+		const __m128 maxValue = _mm_set1_ps(255.0f);
+		for (; i + 4 <= count; i += 4)
+		{
+			__m128i values[4];
+			for (UINT32 j = 0; j < 4; j++)
+			{
+				__m128 color = _mm_loadu_ps(input + (i + j) * 4);
+				if (swapRB)
+					color = _mm_shuffle_ps(color, color, _MM_SHUFFLE(3, 0, 1, 2));
+
+				// Same as Bitwise::floatToFixed(): clamp, then truncate value * 256
+				color = _mm_min_ps(_mm_mul_ps(_mm_max_ps(color, zero), scale), maxValue);
+				values[j] = _mm_cvttps_epi32(color);
+			}
+
+			__m128i lo = _mm_packs_epi32(values[0], values[1]);
+			__m128i hi = _mm_packs_epi32(values[2], values[3]);
+			_mm_storeu_si128((__m128i*)(dst + i * 4), _mm_packus_epi16(lo, hi));
+		}
+#endif
+
+		for (; i < count; i++)
+		{
+			const float* color = input + i * 4;
+			UINT8* pixel = dst + i * 4;
+
+			pixel[swapRB ? 2 : 0] = (UINT8)Bitwise::floatToFixed(color[0], 8);
+			pixel[1] = (UINT8)Bitwise::floatToFixed(color[1], 8);
+			pixel[swapRB ? 0 : 2] = (UINT8)Bitwise::floatToFixed(color[2], 8);
+			pixel[3] = (UINT8)Bitwise::floatToFixed(color[3], 8);
+		}
+	}
+
+	/** Returns a table mapping 8-bit channel values to the equivalent 16-bit floating point values. */
+	static const UINT16* getByteToHalfTable()
+	{
+		struct Table
+		{
+			Table()
+			{
+				for (UINT32 i = 0; i < 256; i++)
+					values[i] = Bitwise::floatToHalf(i / 255.0f);
+			}
+
+			UINT16 values[256];
+		};
+
+		static const Table table;
+		return table.values;
+	}
+
+	/**
+	 * Converts 8-bit four channel pixels to 16-bit floating point RGBA pixels.
+	 *
+	 * @tparam	swapRB	If true the source pixels are in BGRA order.
+	 */
+	template<bool swapRB>
+	void convertRow_8888_To_F16(const UINT8* src, UINT8* dst, UINT32 count)
+	{
+		const UINT16* table = getByteToHalfTable();
+
+		UINT16* output = (UINT16*)dst;
+		for (UINT32 i = 0; i < count; i++, src += 4, output += 4)
+		{
+			output[0] = table[src[swapRB ? 2 : 0]];
+			output[1] = table[src[1]];
+			output[2] = table[src[swapRB ? 0 : 2]];
+			output[3] = table[src[3]];
+		}
+	}
+
+	/**
+	 * Converts 16-bit floating point RGBA pixels to 8-bit four channel pixels.
+	 *
+	 * @tparam	swapRB	If true the destination pixels are in BGRA order.
+	 */
+	template<bool swapRB>
+	void convertRow_F16_To_8888(const UINT8* src, UINT8* dst, UINT32 count)
+	{
+		const UINT16* input = (const UINT16*)src;
+		for (UINT32 i = 0; i < count; i++, input += 4, dst += 4)
+		{
+			dst[swapRB ? 2 : 0] = (UINT8)Bitwise::floatToFixed(Bitwise::halfToFloat(input[0]), 8);
+			dst[1] = (UINT8)Bitwise::floatToFixed(Bitwise::halfToFloat(input[1]), 8);
+			dst[swapRB ? 0 : 2] = (UINT8)Bitwise::floatToFixed(Bitwise::halfToFloat(input[2]), 8);
+			dst[3] = (UINT8)Bitwise::floatToFixed(Bitwise::halfToFloat(input[3]), 8);
+		}
+	}
+
+	/** Converts 16-bit floating point RGBA pixels to 32-bit floating point RGBA pixels. */
+	static void convertRow_F16_To_F32(const UINT8* src, UINT8* dst, UINT32 count)
+	{
+		const UINT16* input = (const UINT16*)src;
+		float* output = (float*)dst;
+
+		for (UINT32 i = 0; i < count * 4; i++)
+			output[i] = Bitwise::halfToFloat(input[i]);
+	}
+
+	/** Converts 32-bit floating point RGBA pixels to 16-bit floating point RGBA pixels. */
+	static void convertRow_F32_To_F16(const UINT8* src, UINT8* dst, UINT32 count)
+	{
+		const float* input = (const float*)src;
+		UINT16* output = (UINT16*)dst;
+
+		for (UINT32 i = 0; i < count * 4; i++)
+			output[i] = Bitwise::floatToHalf(input[i]);
+	}
+
+	/**
+	 * Returns a method specialized for converting pixels between the two provided formats, or null if the conversion
+	 * needs to go through the generic unpackColor()/packColor() path.
+	 */
+	static ConvertRowFunc findRowConversion(PixelFormat srcFormat, PixelFormat dstFormat)
+	{
+		switch (srcFormat)
+		{
+		case PF_R8G8B8A8:
+			switch (dstFormat)
+			{
+			case PF_B8G8R8A8: return &convertRow_8888_SwapRB;
+			case PF_R8G8B8: return &convertRow_8888_To_888<false>;
+			case PF_B8G8R8: return &convertRow_8888_To_888<true>;
+			case PF_FLOAT16_RGBA: return &convertRow_8888_To_F16<false>;
+			case PF_FLOAT32_RGBA: return &convertRow_8888_To_F32<false>;
+			default: return nullptr;
+			}
+		case PF_B8G8R8A8:
+			switch (dstFormat)
+			{
+			case PF_R8G8B8A8: return &convertRow_8888_SwapRB;
+			case PF_R8G8B8: return &convertRow_8888_To_888<true>;
+			case PF_B8G8R8: return &convertRow_8888_To_888<false>;
+			case PF_FLOAT16_RGBA: return &convertRow_8888_To_F16<true>;
+			case PF_FLOAT32_RGBA: return &convertRow_8888_To_F32<true>;
+			default: return nullptr;
+			}
+		case PF_R8G8B8:
+			switch (dstFormat)
+			{
+			case PF_R8G8B8A8: return &convertRow_888_To_8888<false>;
+			case PF_B8G8R8A8: return &convertRow_888_To_8888<true>;
+			default: return nullptr;
+			}
+		case PF_B8G8R8:
+			switch (dstFormat)
+			{
+			case PF_R8G8B8A8: return &convertRow_888_To_8888<true>;
+			case PF_B8G8R8A8: return &convertRow_888_To_8888<false>;
+			default: return nullptr;
+			}
+		case PF_FLOAT16_RGBA:
+			switch (dstFormat)
+			{
+			case PF_R8G8B8A8: return &convertRow_F16_To_8888<false>;
+			case PF_B8G8R8A8: return &convertRow_F16_To_8888<true>;
+			case PF_FLOAT32_RGBA: return &convertRow_F16_To_F32;
+			default: return nullptr;
+			}
+		case PF_FLOAT32_RGBA:
+			switch (dstFormat)
+			{
+			case PF_R8G8B8A8: return &convertRow_F32_To_8888<false>;
+			case PF_B8G8R8A8: return &convertRow_F32_To_8888<true>;
+			case PF_FLOAT16_RGBA: return &convertRow_F32_To_F16;
+			default: return nullptr;
+			}
+		default:
+			return nullptr;
+		}
+	}
+
+	/**
+	 * Converts between 8-bit gamma encoded channel values and linear floating point values, using lookup tables.
+	 * Encoding rounds to the nearest 8-bit value in gamma space.
+	 */
+	class GammaTable
+	{
+	public:
+		GammaTable(float gamma)
+		{
+			for (UINT32 i = 0; i < 256; i++)
+				mToLinear[i] = std::pow(i / 255.0f, gamma);
+
+			for (UINT32 i = 0; i < 255; i++)
+				mThresholds[i] = std::pow((i + 0.5f) / 255.0f, gamma);
+		}
+
+		/** Converts an 8-bit gamma encoded value to a linear value in [0, 1] range. */
+		float toLinear(UINT8 value) const { return mToLinear[value]; }
+
+		/** Converts a linear value to an 8-bit gamma encoded value. */
+		UINT8 fromLinear(float value) const
+		{
+			// Find the number of thresholds below the value
+			UINT32 idx = 0;
+			for (UINT32 step = 128; step > 0; step >>= 1)
+			{
+				if (idx + step <= 255 && mThresholds[idx + step - 1] <= value)
+					idx += step;
+			}
+
+			return (UINT8)idx;
+		}
+
+	private:
+		float mToLinear[256];
+		float mThresholds[255];
+	};
+
 	/**	Data describing a pixel format. */
     struct PixelFormatDescription 
 	{
@@ -1543,35 +1919,41 @@ namespace bs
             + (src.getLeft() + src.getTop() * src.getRowPitch() + src.getFront() * src.getSlicePitch()) * srcPixelSize;
         UINT8 *dstptr = static_cast<UINT8*>(dst.getData())
             + (dst.getLeft() + dst.getTop() * dst.getRowPitch() + dst.getFront() * dst.getSlicePitch()) * dstPixelSize;
-		
-        // Calculate pitches+skips in bytes
-		UINT32 srcRowSkipBytes = src.getRowSkip()*srcPixelSize;
-		UINT32 srcSliceSkipBytes = src.getSliceSkip()*srcPixelSize;
-		UINT32 dstRowSkipBytes = dst.getRowSkip()*dstPixelSize;
-		UINT32 dstSliceSkipBytes = dst.getSliceSkip()*dstPixelSize;
 
-        // The brute force fallback
-        float r,g,b,a;
-		for (UINT32 z = src.getFront(); z<src.getBack(); z++)
+		// Use a specialized converter for common format pairs, or fall back to per-pixel conversion
+		ConvertRowFunc convertRow = findRowConversion(src.getFormat(), dst.getFormat());
+
+		UINT32 width = src.getWidth();
+		UINT32 height = src.getHeight();
+		forEachRowRange(height * src.getDepth(), width,
+			[&](UINT32 startRow, UINT32 endRow)
 		{
-			for (UINT32 y = src.getTop(); y < src.getBottom(); y++)
-            {
-				for (UINT32 x = src.getLeft(); x<src.getRight(); x++)
-                {
-                    unpackColor(&r, &g, &b, &a, src.getFormat(), srcptr);
-                    packColor(r, g, b, a, dst.getFormat(), dstptr);
+			float r, g, b, a;
+			for (UINT32 row = startRow; row < endRow; row++)
+			{
+				UINT32 z = row / height;
+				UINT32 y = row % height;
 
-                    srcptr += srcPixelSize;
-                    dstptr += dstPixelSize;
-                }
+				const UINT8* srcRow = srcptr + (z * src.getSlicePitch() + y * src.getRowPitch()) * srcPixelSize;
+				UINT8* dstRow = dstptr + (z * dst.getSlicePitch() + y * dst.getRowPitch()) * dstPixelSize;
 
-                srcptr += srcRowSkipBytes;
-                dstptr += dstRowSkipBytes;
-            }
+				if (convertRow != nullptr)
+				{
+					convertRow(srcRow, dstRow, width);
+					continue;
+				}
 
-            srcptr += srcSliceSkipBytes;
-            dstptr += dstSliceSkipBytes;
-        }
+				// The brute force fallback
+				for (UINT32 x = 0; x < width; x++)
+				{
+					unpackColor(&r, &g, &b, &a, src.getFormat(), srcRow);
+					packColor(r, g, b, a, dst.getFormat(), dstRow);
+
+					srcRow += srcPixelSize;
+					dstRow += dstPixelSize;
+				}
+			}
+		});
     }
 
 	void PixelUtil::flipComponentOrder(PixelData& data)
@@ -1711,14 +2093,14 @@ namespace bs
 			// No conversion
 			switch (PixelUtil::getNumElemBytes(src.getFormat())) 
 			{
-			case 1: NearestResampler<1>::scale(src, temp); break;
-			case 2: NearestResampler<2>::scale(src, temp); break;
-			case 3: NearestResampler<3>::scale(src, temp); break;
-			case 4: NearestResampler<4>::scale(src, temp); break;
-			case 6: NearestResampler<6>::scale(src, temp); break;
-			case 8: NearestResampler<8>::scale(src, temp); break;
-			case 12: NearestResampler<12>::scale(src, temp); break;
-			case 16: NearestResampler<16>::scale(src, temp); break;
+			case 1: scaleParallel<NearestResampler<1>>(src, temp); break;
+			case 2: scaleParallel<NearestResampler<2>>(src, temp); break;
+			case 3: scaleParallel<NearestResampler<3>>(src, temp); break;
+			case 4: scaleParallel<NearestResampler<4>>(src, temp); break;
+			case 6: scaleParallel<NearestResampler<6>>(src, temp); break;
+			case 8: scaleParallel<NearestResampler<8>>(src, temp); break;
+			case 12: scaleParallel<NearestResampler<12>>(src, temp); break;
+			case 16: scaleParallel<NearestResampler<16>>(src, temp); break;
 			default:
 				// Never reached
 				assert(false);
@@ -1755,10 +2137,10 @@ namespace bs
 				// No conversion
 				switch (PixelUtil::getNumElemBytes(src.getFormat())) 
 				{
-				case 1: LinearResampler_Byte<1>::scale(src, temp); break;
-				case 2: LinearResampler_Byte<2>::scale(src, temp); break;
-				case 3: LinearResampler_Byte<3>::scale(src, temp); break;
-				case 4: LinearResampler_Byte<4>::scale(src, temp); break;
+				case 1: scaleParallel<LinearResampler_Byte<1>>(src, temp); break;
+				case 2: scaleParallel<LinearResampler_Byte<2>>(src, temp); break;
+				case 3: scaleParallel<LinearResampler_Byte<3>>(src, temp); break;
+				case 4: scaleParallel<LinearResampler_Byte<4>>(src, temp); break;
 				default:
 					// Never reached
 					assert(false);
@@ -1777,13 +2159,13 @@ namespace bs
 				if (scaled.getFormat() == PF_FLOAT32_RGB || scaled.getFormat() == PF_FLOAT32_RGBA)
 				{
 					// float32 to float32, avoid unpack/repack overhead
-					LinearResampler_Float32::scale(src, scaled);
+					scaleParallel<LinearResampler_Float32>(src, scaled);
 					break;
 				}
 				// Else, fall through
 			default:
 				// Fallback case, slow but works
-				LinearResampler::scale(src, scaled);
+				scaleParallel<LinearResampler>(src, scaled);
 			}
 			break;
 		}
@@ -1926,10 +2308,34 @@ namespace bs
 		if(gamma == 1.0f)
 			return;
 
+		// Pixels whose channels all stay in range don't need to be rescaled, and can be looked up directly
+		UINT8 gammaTable[256];
+		UINT32 maxUnscaledValue = 0;
+		for (UINT32 i = 0; i < 256; i++)
+		{
+			float value = (float)i * gamma;
+			if (value <= 255.0f)
+			{
+				gammaTable[i] = (UINT8)value;
+				maxUnscaledValue = i;
+			}
+			else
+				gammaTable[i] = 255;
+		}
+
 		UINT32 stride = bpp >> 3;
 
 		for(size_t i = 0, j = size / stride; i < j; i++, buffer += stride)
 		{
+			UINT32 maxValue = std::max(std::max(buffer[0], buffer[1]), buffer[2]);
+			if (maxValue <= maxUnscaledValue)
+			{
+				buffer[0] = gammaTable[buffer[0]];
+				buffer[1] = gammaTable[buffer[1]];
+				buffer[2] = gammaTable[buffer[2]];
+				continue;
+			}
+
 			float r = (float)buffer[0];
 			float g = (float)buffer[1];
 			float b = (float)buffer[2];
@@ -2025,6 +2431,148 @@ namespace bs
 		}	
 	}
 
+	/**
+	 * Generates mip levels for a 2D power of two image by averaging 2x2 blocks of the previous level in linear space,
+	 * which is what NVTT's box filter does. Unlike NVTT the rows of each level are processed in parallel.
+	 *
+	 * @param[in]	src		Image to generate the mip levels for.
+	 * @param[in]	numMips	Number of mip levels to generate, not counting the source level.
+	 * @param[in]	gamma	Gamma the color channels are encoded with. Alpha is always assumed to be linear.
+	 * @return				Mip levels in the source format, starting with a copy of the source.
+	 */
+	static Vector<SPtr<PixelData>> genMipmapsBox(const PixelData& src, UINT32 numMips, float gamma)
+	{
+		Vector<SPtr<PixelData>> outputMipBuffers;
+
+		SPtr<PixelData> sourceCopy = bs_shared_ptr_new<PixelData>(src.getWidth(), src.getHeight(), 1, src.getFormat());
+		sourceCopy->allocateInternalBuffer();
+		PixelUtil::bulkPixelConversion(src, *sourceCopy);
+		outputMipBuffers.push_back(sourceCopy);
+
+		// Averaging is done on linear RGBA floats, and each level is then encoded into one of these formats before being
+		// converted to the source format
+		bool isFloat = PixelUtil::isFloatingPoint(src.getFormat());
+		PixelFormat encodedFormat = isFloat ? PF_FLOAT32_RGBA : PF_R8G8B8A8;
+
+		GammaTable gammaTable(gamma);
+		float invGamma = 1.0f / gamma;
+
+		UINT32 curWidth = src.getWidth();
+		UINT32 curHeight = src.getHeight();
+		UINT32 numPixels = curWidth * curHeight;
+
+		SPtr<PixelData> linearData = bs_shared_ptr_new<PixelData>(curWidth, curHeight, 1, PF_FLOAT32_RGBA);
+		linearData->allocateInternalBuffer();
+
+		float* linearPixels = (float*)linearData->getData();
+		if (isFloat)
+		{
+			PixelUtil::bulkPixelConversion(src, *linearData);
+
+			if (gamma != 1.0f)
+			{
+				for (UINT32 i = 0; i < numPixels; i++)
+				{
+					for (UINT32 j = 0; j < 3; j++)
+						linearPixels[i * 4 + j] = std::pow(std::max(linearPixels[i * 4 + j], 0.0f), gamma);
+				}
+			}
+		}
+		else
+		{
+			PixelData encodedData(curWidth, curHeight, 1, encodedFormat);
+			encodedData.allocateInternalBuffer();
+			PixelUtil::bulkPixelConversion(src, encodedData);
+
+			const UINT8* encodedPixels = encodedData.getData();
+			for (UINT32 i = 0; i < numPixels * 4; i += 4)
+			{
+				linearPixels[i + 0] = gammaTable.toLinear(encodedPixels[i + 0]);
+				linearPixels[i + 1] = gammaTable.toLinear(encodedPixels[i + 1]);
+				linearPixels[i + 2] = gammaTable.toLinear(encodedPixels[i + 2]);
+				linearPixels[i + 3] = encodedPixels[i + 3] / 255.0f;
+			}
+
+			encodedData.freeInternalBuffer();
+		}
+
+		for (UINT32 i = 0; i < numMips; i++)
+		{
+			UINT32 srcWidth = curWidth;
+			UINT32 srcHeight = curHeight;
+
+			curWidth = std::max(curWidth / 2, 1U);
+			curHeight = std::max(curHeight / 2, 1U);
+
+			SPtr<PixelData> mipLinearData = bs_shared_ptr_new<PixelData>(curWidth, curHeight, 1, PF_FLOAT32_RGBA);
+			mipLinearData->allocateInternalBuffer();
+
+			PixelData encodedData(curWidth, curHeight, 1, encodedFormat);
+			encodedData.allocateInternalBuffer();
+
+			const float* srcPixels = (const float*)linearData->getData();
+			float* dstPixels = (float*)mipLinearData->getData();
+			UINT8* encodedPixels = encodedData.getData();
+
+			UINT32 dstWidth = curWidth;
+			forEachRowRange(curHeight, curWidth,
+				[&](UINT32 startRow, UINT32 endRow)
+			{
+				simd::float4 quarter = simd::set(0.25f);
+				for (UINT32 y = startRow; y < endRow; y++)
+				{
+					const float* srcRow0 = srcPixels + (y * 2) * srcWidth * 4;
+					const float* srcRow1 = srcPixels + std::min(y * 2 + 1, srcHeight - 1) * srcWidth * 4;
+
+					for (UINT32 x = 0; x < dstWidth; x++)
+					{
+						UINT32 srcOffset0 = x * 2 * 4;
+						UINT32 srcOffset1 = std::min(x * 2 + 1, srcWidth - 1) * 4;
+
+						simd::float4 sum = simd::add(
+							simd::add(simd::load(srcRow0 + srcOffset0), simd::load(srcRow0 + srcOffset1)),
+							simd::add(simd::load(srcRow1 + srcOffset0), simd::load(srcRow1 + srcOffset1)));
+
+						UINT32 dstOffset = (y * dstWidth + x) * 4;
+						float* dstPixel = dstPixels + dstOffset;
+						simd::store(dstPixel, simd::mul(sum, quarter));
+
+						if (isFloat)
+						{
+							float* encodedPixel = (float*)encodedPixels + dstOffset;
+							for (UINT32 j = 0; j < 3; j++)
+								encodedPixel[j] = gamma != 1.0f ? std::pow(dstPixel[j], invGamma) : dstPixel[j];
+
+							encodedPixel[3] = dstPixel[3];
+						}
+						else
+						{
+							UINT8* encodedPixel = encodedPixels + dstOffset;
+							for (UINT32 j = 0; j < 3; j++)
+								encodedPixel[j] = gammaTable.fromLinear(dstPixel[j]);
+
+							encodedPixel[3] = (UINT8)(Math::clamp01(dstPixel[3]) * 255.0f + 0.5f);
+						}
+					}
+				}
+			});
+
+			SPtr<PixelData> outputBuffer = bs_shared_ptr_new<PixelData>(curWidth, curHeight, 1, src.getFormat());
+			outputBuffer->allocateInternalBuffer();
+
+			PixelUtil::bulkPixelConversion(encodedData, *outputBuffer);
+			encodedData.freeInternalBuffer();
+
+			outputMipBuffers.push_back(outputBuffer);
+
+			linearData->freeInternalBuffer();
+			linearData = mipLinearData;
+		}
+
+		linearData->freeInternalBuffer();
+		return outputMipBuffers;
+	}
+
 	Vector<SPtr<PixelData>> PixelUtil::genMipmaps(const PixelData& src, const MipMapGenOptions& options)
 	{
 		Vector<SPtr<PixelData>> outputMipBuffers;
@@ -2047,6 +2595,12 @@ namespace bs
 			return outputMipBuffers;
 		}
 
+		UINT32 numMips = getMaxMipmaps(src.getWidth(), src.getHeight(), 1, src.getFormat());
+
+		// Normal maps are handled by NVTT, as they need to be renormalized. Everything else is a simple box filter.
+		if (!options.isNormalMap)
+			return genMipmapsBox(src, numMips, options.isSRGB ? 2.2f : 1.0f);
+
 		PixelFormat interimFormat = isFloatingPoint(src.getFormat()) ? PF_FLOAT32_RGBA : PF_B8G8R8A8;
 
 		PixelData interimData(src.getWidth(), src.getHeight(), 1, interimFormat);
@@ -2089,8 +2643,6 @@ namespace bs
 			co.setPixelFormat(32, 0x0000FF00, 0x00FF0000, 0xFF000000, 0x000000FF);
 		}
 
-		UINT32 numMips = getMaxMipmaps(src.getWidth(), src.getHeight(), 1, src.getFormat());
-
 		Vector<SPtr<PixelData>> rgbaMipBuffers;
 
 		// Note: This can be done more effectively without creating so many temp buffers
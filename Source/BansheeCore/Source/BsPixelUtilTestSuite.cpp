@@ -0,0 +1,314 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#include "BsPixelUtilTestSuite.h"
+#include "BsPixelUtil.h"
+#include "BsPixelData.h"
+#include "BsColor.h"
+#include "BsMath.h"
+#include "BsTaskScheduler.h"
+#include "BsThreadPool.h"
+
+#include <random>
+
+namespace bs
+{
+	/** Format pairs bulkPixelConversion() has specialized kernels for. */
+	static const PixelFormat KERNEL_FORMATS[][2] =
+	{
+		{ PF_R8G8B8A8, PF_B8G8R8A8 }, { PF_R8G8B8A8, PF_R8G8B8 }, { PF_R8G8B8A8, PF_B8G8R8 },
+		{ PF_R8G8B8A8, PF_FLOAT16_RGBA }, { PF_R8G8B8A8, PF_FLOAT32_RGBA },
+		{ PF_B8G8R8A8, PF_R8G8B8A8 }, { PF_B8G8R8A8, PF_R8G8B8 }, { PF_B8G8R8A8, PF_B8G8R8 },
+		{ PF_B8G8R8A8, PF_FLOAT16_RGBA }, { PF_B8G8R8A8, PF_FLOAT32_RGBA },
+		{ PF_R8G8B8, PF_R8G8B8A8 }, { PF_R8G8B8, PF_B8G8R8A8 },
+		{ PF_B8G8R8, PF_R8G8B8A8 }, { PF_B8G8R8, PF_B8G8R8A8 },
+		{ PF_FLOAT16_RGBA, PF_R8G8B8A8 }, { PF_FLOAT16_RGBA, PF_B8G8R8A8 }, { PF_FLOAT16_RGBA, PF_FLOAT32_RGBA },
+		{ PF_FLOAT32_RGBA, PF_R8G8B8A8 }, { PF_FLOAT32_RGBA, PF_B8G8R8A8 }, { PF_FLOAT32_RGBA, PF_FLOAT16_RGBA },
+	};
+
+	/**
+	 * Fills the pixel data with random values. Floating point formats also receive values outside of the [0, 1] range
+	 * and values exactly between two 8-bit values, to test clamping and rounding.
+	 */
+	static void fillRandom(PixelData& data, UINT32 seed)
+	{
+		std::mt19937 generator(seed);
+
+		if (!PixelUtil::isFloatingPoint(data.getFormat()))
+		{
+			UINT8* bytes = data.getData();
+			for (UINT32 i = 0; i < data.getConsecutiveSize(); i++)
+				bytes[i] = (UINT8)generator();
+
+			return;
+		}
+
+		std::uniform_real_distribution<float> distribution(-0.5f, 1.5f);
+		auto randomValue = [&]()
+		{
+			switch (generator() % 4)
+			{
+			case 0: return (generator() % 256 + 0.5f) / 255.0f;
+			case 1: return (float)(generator() % 256) / 255.0f;
+			default: return distribution(generator);
+			}
+		};
+
+		UINT32 pixelSize = PixelUtil::getNumElemBytes(data.getFormat());
+		UINT32 numPixels = data.getWidth() * data.getHeight() * data.getDepth();
+		for (UINT32 i = 0; i < numPixels; i++)
+		{
+			float r = randomValue();
+			float g = randomValue();
+			float b = randomValue();
+			float a = randomValue();
+
+			PixelUtil::packColor(r, g, b, a, data.getFormat(), data.getData() + i * pixelSize);
+		}
+	}
+
+	/** Converts consecutive pixel data one pixel at a time, using the generic unpackColor()/packColor() path. */
+	static void convertScalar(const PixelData& src, PixelData& dst)
+	{
+		UINT32 srcPixelSize = PixelUtil::getNumElemBytes(src.getFormat());
+		UINT32 dstPixelSize = PixelUtil::getNumElemBytes(dst.getFormat());
+		UINT32 numPixels = src.getWidth() * src.getHeight() * src.getDepth();
+
+		for (UINT32 i = 0; i < numPixels; i++)
+		{
+			float r, g, b, a;
+			PixelUtil::unpackColor(&r, &g, &b, &a, src.getFormat(), src.getData() + i * srcPixelSize);
+			PixelUtil::packColor(r, g, b, a, dst.getFormat(), dst.getData() + i * dstPixelSize);
+		}
+	}
+
+	static bool isEqual(const PixelData& a, const PixelData& b)
+	{
+		return a.getConsecutiveSize() == b.getConsecutiveSize() && 
+			memcmp(a.getData(), b.getData(), a.getConsecutiveSize()) == 0;
+	}
+
+	/** Converts between all formats with specialized kernels and compares the output with the generic path. */
+	static bool testKernels(UINT32 width, UINT32 height)
+	{
+		bool valid = true;
+		for (UINT32 i = 0; i < sizeof(KERNEL_FORMATS) / sizeof(KERNEL_FORMATS[0]); i++)
+		{
+			PixelData src(width, height, 1, KERNEL_FORMATS[i][0]);
+			src.allocateInternalBuffer();
+			fillRandom(src, i);
+
+			PixelData dst(width, height, 1, KERNEL_FORMATS[i][1]);
+			dst.allocateInternalBuffer();
+			PixelUtil::bulkPixelConversion(src, dst);
+
+			PixelData reference(width, height, 1, KERNEL_FORMATS[i][1]);
+			reference.allocateInternalBuffer();
+			convertScalar(src, reference);
+
+			valid &= isEqual(dst, reference);
+		}
+
+		return valid;
+	}
+
+	PixelUtilTestSuite::PixelUtilTestSuite()
+	{
+		BS_ADD_TEST(PixelUtilTestSuite::testConvert_matches_scalar);
+		BS_ADD_TEST(PixelUtilTestSuite::testConvert_row_pitch);
+		BS_ADD_TEST(PixelUtilTestSuite::testGenMipmaps_uniform_blocks);
+		BS_ADD_TEST(PixelUtilTestSuite::testGenMipmaps_average);
+
+		// Must be the last test, as it starts the task scheduler
+		BS_ADD_TEST(PixelUtilTestSuite::testParallel_matches_serial);
+	}
+
+	void PixelUtilTestSuite::startUp()
+	{
+		// Worker threads get a MemStack, needed by the resource loading tests that share the pool
+		ThreadPool::startUp<TThreadPool<ThreadBansheePolicy>>(TaskScheduler::MAX_WORKERS, TaskScheduler::MAX_WORKERS + 1);
+	}
+
+	void PixelUtilTestSuite::shutDown()
+	{
+		if (TaskScheduler::isStarted())
+			TaskScheduler::shutDown();
+
+		ThreadPool::shutDown();
+	}
+
+	void PixelUtilTestSuite::testConvert_matches_scalar()
+	{
+		// Odd widths exercise the scalar tails of the vectorized kernels
+		BS_TEST_ASSERT(testKernels(1, 1));
+		BS_TEST_ASSERT(testKernels(7, 3));
+		BS_TEST_ASSERT(testKernels(37, 11));
+	}
+
+	void PixelUtilTestSuite::testConvert_row_pitch()
+	{
+		static const UINT32 PITCH = 64;
+		static const UINT32 WIDTH = 45;
+		static const UINT32 HEIGHT = 26;
+
+		PixelData src(PITCH, HEIGHT + 3, 1, PF_R8G8B8A8);
+		src.allocateInternalBuffer();
+		fillRandom(src, 100);
+
+		// Source rows are further apart than their width, like in a part of a larger image
+		UINT32 offset = (3 * PITCH + 5) * PixelUtil::getNumElemBytes(PF_R8G8B8A8);
+		PixelData srcRegion(WIDTH, HEIGHT, 1, PF_R8G8B8A8);
+		srcRegion.setExternalBuffer(src.getData() + offset);
+		srcRegion.setRowPitch(PITCH);
+		srcRegion.setSlicePitch(PITCH * HEIGHT);
+
+		PixelData dst(WIDTH, HEIGHT, 1, PF_FLOAT32_RGBA);
+		dst.allocateInternalBuffer();
+		PixelUtil::bulkPixelConversion(srcRegion, dst);
+
+		bool valid = true;
+		for (UINT32 y = 0; y < HEIGHT; y++)
+		{
+			for (UINT32 x = 0; x < WIDTH; x++)
+				valid &= src.getColorAt(5 + x, 3 + y) == dst.getColorAt(x, y);
+		}
+
+		BS_TEST_ASSERT(valid);
+	}
+
+	void PixelUtilTestSuite::testGenMipmaps_uniform_blocks()
+	{
+		static const UINT32 SIZE = 8;
+
+		// Each 2x2 block has a single color, so the first mip level must contain exactly those colors
+		PixelData src(SIZE, SIZE, 1, PF_R8G8B8A8);
+		src.allocateInternalBuffer();
+
+		std::mt19937 generator(300);
+		Vector<Color> blockColors((SIZE / 2) * (SIZE / 2));
+		for (UINT32 i = 0; i < (UINT32)blockColors.size(); i++)
+		{
+			UINT8 color[4] = { (UINT8)generator(), (UINT8)generator(), (UINT8)generator(), (UINT8)generator() };
+			PixelUtil::unpackColor(&blockColors[i], PF_R8G8B8A8, color);
+
+			UINT32 blockX = i % (SIZE / 2);
+			UINT32 blockY = i / (SIZE / 2);
+			for (UINT32 y = 0; y < 2; y++)
+			{
+				for (UINT32 x = 0; x < 2; x++)
+					src.setColorAt(blockColors[i], blockX * 2 + x, blockY * 2 + y);
+			}
+		}
+
+		bool valid = true;
+		for (UINT32 i = 0; i < 2; i++)
+		{
+			MipMapGenOptions options;
+			options.isSRGB = i == 1;
+
+			Vector<SPtr<PixelData>> mips = PixelUtil::genMipmaps(src, options);
+			BS_TEST_ASSERT(mips.size() == 4);
+			if (mips.size() != 4)
+				return;
+
+			BS_TEST_ASSERT(mips[3]->getWidth() == 1 && mips[3]->getHeight() == 1);
+			BS_TEST_ASSERT(isEqual(*mips[0], src));
+
+			for (UINT32 j = 0; j < (UINT32)blockColors.size(); j++)
+				valid &= mips[1]->getColorAt(j % (SIZE / 2), j / (SIZE / 2)) == blockColors[j];
+		}
+
+		BS_TEST_ASSERT(valid);
+	}
+
+	void PixelUtilTestSuite::testGenMipmaps_average()
+	{
+		static const UINT32 SIZE = 64;
+
+		PixelData src8(SIZE, SIZE, 1, PF_R8G8B8A8);
+		src8.allocateInternalBuffer();
+		fillRandom(src8, 400);
+
+		PixelData srcFloat(SIZE, SIZE, 1, PF_FLOAT32_RGBA);
+		srcFloat.allocateInternalBuffer();
+		PixelUtil::bulkPixelConversion(src8, srcFloat);
+
+		MipMapGenOptions options;
+		Vector<SPtr<PixelData>> mips8 = PixelUtil::genMipmaps(src8, options);
+		Vector<SPtr<PixelData>> mipsFloat = PixelUtil::genMipmaps(srcFloat, options);
+
+		BS_TEST_ASSERT(mips8.size() > 1 && mipsFloat.size() > 1);
+		if (mips8.size() <= 1 || mipsFloat.size() <= 1)
+			return;
+
+		// Without gamma the first level is a plain average of 2x2 blocks, rounded to the nearest value for 8-bit formats
+		bool valid = true;
+		for (UINT32 y = 0; y < SIZE / 2; y++)
+		{
+			for (UINT32 x = 0; x < SIZE / 2; x++)
+			{
+				Color expected = (src8.getColorAt(x * 2, y * 2) + src8.getColorAt(x * 2 + 1, y * 2) +
+					src8.getColorAt(x * 2, y * 2 + 1) + src8.getColorAt(x * 2 + 1, y * 2 + 1)) * 0.25f;
+
+				Color actual8 = mips8[1]->getColorAt(x, y);
+				Color actualFloat = mipsFloat[1]->getColorAt(x, y);
+
+				for (UINT32 i = 0; i < 4; i++)
+				{
+					valid &= Math::abs(actual8[i] - expected[i]) <= (0.5f / 255.0f) + 1e-5f;
+					valid &= Math::abs(actualFloat[i] - expected[i]) <= 1e-5f;
+				}
+			}
+		}
+
+		BS_TEST_ASSERT(valid);
+	}
+
+	void PixelUtilTestSuite::testParallel_matches_serial()
+	{
+		// Operations on large images are split across task scheduler workers, once the scheduler is running. Results must
+		// be identical to the single threaded ones.
+		PixelData src(1024, 512, 1, PF_R8G8B8A8);
+		src.allocateInternalBuffer();
+		fillRandom(src, 500);
+
+		const UINT32 scaleSizes[][2] = { { 600, 300 }, { 1500, 700 } };
+		const PixelUtil::Filter filters[] = { PixelUtil::FILTER_NEAREST, PixelUtil::FILTER_LINEAR };
+
+		MipMapGenOptions mipOptions;
+		mipOptions.isSRGB = true;
+
+		auto run = [&]()
+		{
+			Vector<SPtr<PixelData>> output;
+			for (auto& size : scaleSizes)
+			{
+				for (auto& filter : filters)
+				{
+					SPtr<PixelData> scaled = PixelData::create(size[0], size[1], 1, PF_R8G8B8A8);
+					PixelUtil::scale(src, *scaled, filter);
+
+					output.push_back(scaled);
+				}
+			}
+
+			Vector<SPtr<PixelData>> mips = PixelUtil::genMipmaps(src, mipOptions);
+			output.insert(output.end(), mips.begin(), mips.end());
+
+			return output;
+		};
+
+		Vector<SPtr<PixelData>> serial = run();
+
+		TaskScheduler::startUp();
+		Vector<SPtr<PixelData>> parallel = run();
+
+		bool valid = serial.size() == parallel.size();
+		for (UINT32 i = 0; valid && i < (UINT32)serial.size(); i++)
+			valid &= isEqual(*serial[i], *parallel[i]);
+
+		BS_TEST_ASSERT(valid);
+
+		// Conversion kernels must match the generic path when split across workers as well
+		BS_TEST_ASSERT(testKernels(613, 301));
+	}
+}
@@ -109,6 +109,7 @@ namespace bs
 	{
 		memAllocs = MemoryCounter::getNumAllocs();
 		memFrees = MemoryCounter::getNumFrees();
+		memAllocBytes = MemoryCounter::getNumAllocatedBytes();
 
 		timer.reset();
 		timer.start();
@@ -120,8 +121,9 @@ namespace bs
 
 		UINT64 numAllocs = MemoryCounter::getNumAllocs() - memAllocs;
 		UINT64 numFrees = MemoryCounter::getNumFrees() - memFrees;
+		UINT64 numAllocBytes = MemoryCounter::getNumAllocatedBytes() - memAllocBytes;
 
-		samples.push_back(ProfileSample(timer.time, numAllocs, numFrees));
+		samples.push_back(ProfileSample(timer.time, numAllocs, numFrees, numAllocBytes));
 	}
 
 	void ProfilerCPU::ProfileData::resumeLastSample()
@@ -138,6 +140,7 @@ namespace bs
 	{
 		memAllocs = MemoryCounter::getNumAllocs();
 		memFrees = MemoryCounter::getNumFrees();
+		memAllocBytes = MemoryCounter::getNumAllocatedBytes();
 
 		timer.reset();
 		timer.start();
@@ -149,8 +152,9 @@ namespace bs
 
 		UINT64 numAllocs = MemoryCounter::getNumAllocs() - memAllocs;
 		UINT64 numFrees = MemoryCounter::getNumFrees() - memFrees;
+		UINT64 numAllocBytes = MemoryCounter::getNumAllocatedBytes() - memAllocBytes;
 
-		samples.push_back(PreciseProfileSample(timer.cycles, numAllocs, numFrees));
+		samples.push_back(PreciseProfileSample(timer.cycles, numAllocs, numFrees, numAllocBytes));
 	}
 
 	void ProfilerCPU::PreciseProfileData::resumeLastSample()
@@ -533,6 +537,7 @@ namespace bs
 
 			entryBasic->data.memAllocs = 0;
 			entryBasic->data.memFrees = 0;
+			entryBasic->data.memAllocBytes = 0;
 			entryBasic->data.totalTimeMs = 0.0;
 			entryBasic->data.maxTimeMs = 0.0;
 			for(auto& sample : curBlock->basic.samples)
@@ -541,6 +546,7 @@ namespace bs
 				entryBasic->data.maxTimeMs = std::max(entryBasic->data.maxTimeMs, sample.time);
 				entryBasic->data.memAllocs += sample.numAllocs;
 				entryBasic->data.memFrees += sample.numFrees;
+				entryBasic->data.memAllocBytes += sample.numAllocBytes;
 			}
 
 			entryBasic->data.numCalls = (UINT32)curBlock->basic.samples.size();
@@ -573,6 +579,7 @@ namespace bs
 
 			entryPrecise->data.memAllocs = 0;
 			entryPrecise->data.memFrees = 0;
+			entryPrecise->data.memAllocBytes = 0;
 			entryPrecise->data.totalCycles = 0;
 			entryPrecise->data.maxCycles = 0;
 			for(auto& sample : curBlock->precise.samples)
@@ -581,6 +588,7 @@ namespace bs
 				entryPrecise->data.maxCycles = std::max(entryPrecise->data.maxCycles, sample.cycles);
 				entryPrecise->data.memAllocs += sample.numAllocs;
 				entryPrecise->data.memFrees += sample.numFrees;
+				entryPrecise->data.memAllocBytes += sample.numAllocBytes;
 			}
 
 			entryPrecise->data.numCalls = (UINT32)curBlock->precise.samples.size();
@@ -1000,13 +1008,13 @@ namespace bs
 	}
 
 	CPUProfilerBasicSamplingEntry::Data::Data()
-		:numCalls(0), avgTimeMs(0.0), maxTimeMs(0.0), totalTimeMs(0.0),
+		:numCalls(0), memAllocs(0), memFrees(0), memAllocBytes(0), avgTimeMs(0.0), maxTimeMs(0.0), totalTimeMs(0.0),
 		avgSelfTimeMs(0.0), totalSelfTimeMs(0.0), estimatedSelfOverheadMs(0.0),
 		estimatedOverheadMs(0.0), pctOfParent(1.0f)
 	{ }
 
 	CPUProfilerPreciseSamplingEntry::Data::Data()
-		:numCalls(0), avgCycles(0), maxCycles(0), totalCycles(0),
+		:numCalls(0), memAllocs(0), memFrees(0), memAllocBytes(0), avgCycles(0), maxCycles(0), totalCycles(0),
 		avgSelfCycles(0), totalSelfCycles(0), estimatedSelfOverhead(0),
 		estimatedOverhead(0), pctOfParent(1.0f)
 	{ }
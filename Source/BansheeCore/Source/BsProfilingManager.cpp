@@ -31,6 +31,12 @@ namespace bs
 
 		gProfilerCPU().reset();
 
+		MemAllocProfiler::_update();
+		if (MemAllocProfiler::isEnabled())
+			mSavedSimReports[mNextSimReportIdx].memoryStats = MemAllocProfiler::getStats();
+		else
+			mSavedSimReports[mNextSimReportIdx].memoryStats.clear();
+
 		mNextSimReportIdx = (mNextSimReportIdx + 1) % NUM_SAVED_FRAMES;
 #endif
 	}
@@ -0,0 +1,359 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#include "BsResourceArchive.h"
+#include "BsSavedResourceData.h"
+#include "BsFileSerializer.h"
+#include "BsRTTIType.h"
+#include "BsFileSystem.h"
+#include "BsDataStream.h"
+#include "BsCompression.h"
+#include "BsDebug.h"
+
+namespace bs
+{
+	/** Identifies a file as a resource archive ("BSRA"). */
+	static const UINT32 ARCHIVE_MAGIC = 0x41525342;
+
+	/** Version of the archive format. Archives of a different version can't be opened. */
+	static const UINT32 ARCHIVE_VERSION = 1;
+
+	/** Written at the start of the archive. */
+	struct ArchiveHeader
+	{
+		UINT32 magic;
+		UINT32 version;
+		UINT32 alignment;
+		UINT32 reserved;
+	};
+
+	/** Written at the end of the archive, after the index. */
+	struct ArchiveFooter
+	{
+		UINT64 indexOffset;
+		UINT64 indexSize;
+		UINT32 numEntries;
+		UINT32 magic;
+	};
+
+	/** Helper for writing the archive index into a memory buffer. */
+	class ArchiveIndexWriter
+	{
+	public:
+		void write(const void* data, size_t size)
+		{
+			const UINT8* bytes = (const UINT8*)data;
+			mBuffer.insert(mBuffer.end(), bytes, bytes + size);
+		}
+
+		template<class T>
+		void write(const T& value) { write(&value, sizeof(value)); }
+
+		void write(const String& value)
+		{
+			write((UINT32)value.size());
+			write(value.data(), value.size());
+		}
+
+		const Vector<UINT8>& getBuffer() const { return mBuffer; }
+
+	private:
+		Vector<UINT8> mBuffer;
+	};
+
+	/** Helper for reading the archive index from memory, that checks all reads against the end of the index. */
+	class ArchiveIndexReader
+	{
+	public:
+		ArchiveIndexReader(const UINT8* data, size_t size)
+			:mData(data), mEnd(data + size)
+		{ }
+
+		bool read(void* data, size_t size)
+		{
+			if (size > (size_t)(mEnd - mData))
+				return false;
+
+			memcpy(data, mData, size);
+			mData += size;
+
+			return true;
+		}
+
+		template<class T>
+		bool read(T& value) { return read(&value, sizeof(value)); }
+
+		bool read(String& value)
+		{
+			UINT32 length;
+			if (!read(length) || length > (size_t)(mEnd - mData))
+				return false;
+
+			value.assign((const char*)mData, length);
+			mData += length;
+
+			return true;
+		}
+
+	private:
+		const UINT8* mData;
+		const UINT8* mEnd;
+	};
+
+	ResourceArchive::ResourceArchive(const ConstructPrivately& dummy, const Path& path, const SPtr<MemoryDataStream>& data)
+		:mPath(path), mData(data)
+	{ }
+
+	const ResourceArchiveEntry* ResourceArchive::findEntry(const String& uuid) const
+	{
+		auto iterFind = mEntries.find(uuid);
+		if (iterFind == mEntries.end())
+			return nullptr;
+
+		return &iterFind->second;
+	}
+
+	SPtr<DataStream> ResourceArchive::openEntry(const ResourceArchiveEntry& entry) const
+	{
+		if (entry.compression == ResourceArchiveCompression::None)
+			return bs_shared_ptr_new<MappedRegionDataStream>(mData, (size_t)entry.offset, (size_t)entry.size);
+
+		UINT8* data = (UINT8*)bs_alloc((size_t)entry.uncompressedSize);
+		size_t size = Compression::decompress(mData->getPtr() + entry.offset, (size_t)entry.size, data, 
+			(size_t)entry.uncompressedSize);
+
+		if (size != entry.uncompressedSize)
+		{
+			LOGERR("Unable to decompress resource \"" + entry.uuid + "\" from archive \"" + mPath.toString() + "\".");
+
+			bs_free(data);
+			return nullptr;
+		}
+
+		return bs_shared_ptr_new<MemoryDataStream>(data, size, true);
+	}
+
+	bool ResourceArchive::readIndex(UINT64 offset, UINT64 size, UINT32 numEntries)
+	{
+		ArchiveIndexReader reader(mData->getPtr() + offset, (size_t)size);
+		UINT64 dataEnd = offset;
+
+		mEntries.reserve(numEntries);
+		for (UINT32 i = 0; i < numEntries; i++)
+		{
+			ResourceArchiveEntry entry;
+			UINT32 compression;
+			UINT32 allowAsyncLoading;
+			UINT32 numDependencies;
+
+			if (!reader.read(entry.uuid) || !reader.read(entry.offset) || !reader.read(entry.size) || 
+				!reader.read(entry.uncompressedSize) || !reader.read(compression) || !reader.read(allowAsyncLoading) ||
+				!reader.read(numDependencies))
+			{
+				return false;
+			}
+
+			if (entry.offset > dataEnd || entry.size > dataEnd - entry.offset || compression > 
+				(UINT32)ResourceArchiveCompression::LZ)
+			{
+				return false;
+			}
+
+			entry.compression = (ResourceArchiveCompression)compression;
+			entry.allowAsyncLoading = allowAsyncLoading != 0;
+
+			for (UINT32 j = 0; j < numDependencies; j++)
+			{
+				String dependency;
+				if (!reader.read(dependency))
+					return false;
+
+				entry.dependencies.push_back(dependency);
+			}
+
+			String uuid = entry.uuid;
+			mEntries[uuid] = std::move(entry);
+		}
+
+		return true;
+	}
+
+	SPtr<ResourceArchive> ResourceArchive::open(const Path& path)
+	{
+		SPtr<DataStream> stream = FileSystem::openFileMapped(path);
+		if (stream == nullptr)
+		{
+			LOGERR("Unable to open resource archive \"" + path.toString() + "\".");
+			return nullptr;
+		}
+
+		SPtr<MemoryDataStream> data = std::static_pointer_cast<MemoryDataStream>(stream);
+		size_t size = data->size();
+
+		ArchiveHeader header;
+		ArchiveFooter footer;
+
+		bool isValid = size >= sizeof(header) + sizeof(footer);
+		if (isValid)
+		{
+			memcpy(&header, data->getPtr(), sizeof(header));
+			memcpy(&footer, data->getPtr() + size - sizeof(footer), sizeof(footer));
+
+			UINT64 indexEnd = size - sizeof(footer);
+			isValid = header.magic == ARCHIVE_MAGIC && footer.magic == ARCHIVE_MAGIC && 
+				footer.indexOffset <= indexEnd && footer.indexSize <= indexEnd - footer.indexOffset;
+		}
+
+		if (isValid && header.version != ARCHIVE_VERSION)
+		{
+			LOGERR("Unable to open resource archive \"" + path.toString() + "\". Unsupported version: " + 
+				toString(header.version) + ".");
+			return nullptr;
+		}
+
+		SPtr<ResourceArchive> archive = bs_shared_ptr_new<ResourceArchive>(ConstructPrivately(), path, data);
+		if (!isValid || !archive->readIndex(footer.indexOffset, footer.indexSize, footer.numEntries))
+		{
+			LOGERR("Unable to open resource archive \"" + path.toString() + "\". File is corrupt.");
+			return nullptr;
+		}
+
+		return archive;
+	}
+
+	ResourceArchiveWriter::ResourceArchiveWriter(const Path& path, UINT32 alignment)
+		:mAlignment(std::max(alignment, 1U)), mOffset(0)
+	{
+		mOutput = FileSystem::createAndOpenFile(path);
+
+		ArchiveHeader header;
+		header.magic = ARCHIVE_MAGIC;
+		header.version = ARCHIVE_VERSION;
+		header.alignment = mAlignment;
+		header.reserved = 0;
+
+		mOutput->write(&header, sizeof(header));
+		mOffset = sizeof(header);
+	}
+
+	ResourceArchiveWriter::~ResourceArchiveWriter()
+	{
+		close();
+	}
+
+	bool ResourceArchiveWriter::add(const String& uuid, const Path& resourcePath, ResourceArchiveCompression compression)
+	{
+		if (mOutput == nullptr)
+			return false;
+
+		if (mUUIDs.find(uuid) != mUUIDs.end())
+		{
+			LOGWRN("Resource \"" + uuid + "\" was already added to the archive. Ignoring the duplicate entry.");
+			return false;
+		}
+
+		SPtr<DataStream> file = FileSystem::openFile(resourcePath);
+		if (file == nullptr)
+		{
+			LOGERR("Unable to add resource to archive, cannot open file: " + resourcePath.toString());
+			return false;
+		}
+
+		SPtr<MemoryDataStream> contents = bs_shared_ptr_new<MemoryDataStream>(file);
+		file->close();
+
+		// Dependencies are stored in the index, so they can be retrieved without decoding the resource
+		SPtr<IReflectable> savedData;
+		{
+			FileDecoder decoder(contents);
+			savedData = decoder.decode();
+		}
+
+		if (savedData == nullptr || !rtti_is_of_type<SavedResourceData>(savedData))
+		{
+			LOGERR("Unable to add resource to archive, file is not a valid resource: " + resourcePath.toString());
+			return false;
+		}
+
+		SPtr<SavedResourceData> savedResourceData = std::static_pointer_cast<SavedResourceData>(savedData);
+
+		ResourceArchiveEntry entry;
+		entry.uuid = uuid;
+		entry.uncompressedSize = contents->size();
+		entry.compression = ResourceArchiveCompression::None;
+		entry.allowAsyncLoading = savedResourceData->allowAsyncLoading();
+		entry.dependencies = savedResourceData->getDependencies();
+
+		const UINT8* data = contents->getPtr();
+		size_t size = contents->size();
+
+		UINT8* compressedData = nullptr;
+		if (compression == ResourceArchiveCompression::LZ)
+		{
+			compressedData = (UINT8*)bs_alloc(Compression::getMaxCompressedSize(size));
+
+			size_t compressedSize = Compression::compress(data, size, compressedData);
+			if (compressedSize < size)
+			{
+				data = compressedData;
+				size = compressedSize;
+				entry.compression = ResourceArchiveCompression::LZ;
+			}
+		}
+
+		UINT32 padding = (UINT32)((mAlignment - mOffset % mAlignment) % mAlignment);
+		if (padding > 0)
+		{
+			Vector<UINT8> zeroes(padding, 0);
+			mOutput->write(zeroes.data(), padding);
+			mOffset += padding;
+		}
+
+		entry.offset = mOffset;
+		entry.size = size;
+
+		mOutput->write(data, size);
+		mOffset += size;
+
+		if (compressedData != nullptr)
+			bs_free(compressedData);
+
+		mEntries.push_back(entry);
+		mUUIDs.insert(uuid);
+
+		return true;
+	}
+
+	void ResourceArchiveWriter::close()
+	{
+		if (mOutput == nullptr)
+			return;
+
+		ArchiveIndexWriter index;
+		for (auto& entry : mEntries)
+		{
+			index.write(entry.uuid);
+			index.write(entry.offset);
+			index.write(entry.size);
+			index.write(entry.uncompressedSize);
+			index.write((UINT32)entry.compression);
+			index.write((UINT32)(entry.allowAsyncLoading ? 1 : 0));
+			index.write((UINT32)entry.dependencies.size());
+
+			for (auto& dependency : entry.dependencies)
+				index.write(dependency);
+		}
+
+		const Vector<UINT8>& indexData = index.getBuffer();
+		mOutput->write(indexData.data(), indexData.size());
+
+		ArchiveFooter footer;
+		footer.indexOffset = mOffset;
+		footer.indexSize = indexData.size();
+		footer.numEntries = (UINT32)mEntries.size();
+		footer.magic = ARCHIVE_MAGIC;
+
+		mOutput->write(&footer, sizeof(footer));
+		mOutput->close();
+		mOutput = nullptr;
+	}
+}
@@ -39,6 +39,9 @@ namespace bs
 
 		if (!mData->mIsCreated)
 		{
+			// Move the resource to the front of the loading queue, if it's still waiting to be read
+			gResources().prioritizeLoad(mData->mUUID);
+
 			Lock lock(mResourceCreatedMutex);
 			while (!mData->mIsCreated)
 			{
@@ -12,13 +12,56 @@
 #include "BsUtility.h"
 #include "BsSavedResourceData.h"
 #include "BsResourceListenerManager.h"
+#include "BsResourceArchive.h"
+#include "BsDataStream.h"
+#include "BsTimer.h"
+#include "BsTime.h"
+#include "BsCoreThread.h"
 
 namespace bs
 {
+	/** 
+	 * Maximum number of tasks reading resource files at once. Besides waiting on the disk, read tasks decode the saved
+	 * resource data and queue the dependencies, so they scale with the number of cores.
+	 */
+	static const UINT32 MAX_READ_TASKS = std::max(2U, (UINT32)BS_THREAD_HARDWARE_CONCURRENCY / 2);
+
+	/** Maximum number of read requests a read task takes from the queue at once, and sorts by their file location. */
+	static const UINT32 READ_BATCH_SIZE = 16;
+
+	/** 
+	 * Number of resources that can be read but not yet deserialized before reading stalls. Read tasks reserve a slot for
+	 * each request they take from the queue, so the limit is never exceeded.
+	 */
+	static const UINT32 MAX_QUEUED_DESERIALIZE = 64;
+
+	/** Returns the priority of the deserialize task for a resource loaded with the provided priority. */
+	static TaskPriority getDeserializeTaskPriority(ResourceLoadPriority priority)
+	{
+		switch (priority)
+		{
+		case ResourceLoadPriority::Blocking:
+			return TaskPriority::VeryHigh;
+		case ResourceLoadPriority::Background:
+			return TaskPriority::Low;
+		default:
+			return TaskPriority::Normal;
+		}
+	}
+
 	Resources::Resources()
+		:mNumReadTasks(0), mNumQueuedDeserialize(0), mNumQueuedUploads(0)
 	{
+		memset(&mResidencyStats, 0, sizeof(mResidencyStats));
+
 		mDefaultResourceManifest = ResourceManifest::create("Default");
 		mResourceManifests.push_back(mDefaultResourceManifest);
+
+		for (UINT32 i = 0; i < (UINT32)ResourceLoadStage::Count; i++)
+		{
+			mStageNumProcessed[i] = 0;
+			mStageTimeUs[i] = 0;
+		}
 	}
 
 	Resources::~Resources()
@@ -37,6 +80,16 @@ namespace bs
 
 	HResource Resources::load(const Path& filePath, ResourceLoadFlags loadFlags)
 	{
+		// Archived resources have no loose file, so resolve the path through the manifest first
+		String uuid;
+		bool foundUUID = getUUIDFromFilePath(filePath, uuid);
+		if (foundUUID)
+		{
+			SPtr<ResourceArchive> archive = findArchive(uuid);
+			if (archive != nullptr)
+				return loadInternal(uuid, filePath, archive, true, loadFlags);
+		}
+
 		if (!FileSystem::isFile(filePath))
 		{
 			LOGWRN_VERBOSE("Cannot load resource. Specified file: " + filePath.toString() + " doesn't exist.");
@@ -44,13 +97,10 @@ namespace bs
 			return HResource();
 		}
 
-		String uuid;
-		bool foundUUID = getUUIDFromFilePath(filePath, uuid);
-
 		if (!foundUUID)
 			uuid = UUIDGenerator::generateRandom();
 
-		return loadInternal(uuid, filePath, true, loadFlags);
+		return loadInternal(uuid, filePath, nullptr, true, loadFlags);
 	}
 
 	HResource Resources::load(const WeakResourceHandle<Resource>& handle, ResourceLoadFlags loadFlags)
@@ -62,8 +112,17 @@ namespace bs
 		return loadFromUUID(uuid, false, loadFlags);
 	}
 
-	HResource Resources::loadAsync(const Path& filePath, ResourceLoadFlags loadFlags)
+	HResource Resources::loadAsync(const Path& filePath, ResourceLoadFlags loadFlags, ResourceLoadPriority priority)
 	{
+		String uuid;
+		bool foundUUID = getUUIDFromFilePath(filePath, uuid);
+		if (foundUUID)
+		{
+			SPtr<ResourceArchive> archive = findArchive(uuid);
+			if (archive != nullptr)
+				return loadInternal(uuid, filePath, archive, false, loadFlags, priority);
+		}
+
 		if (!FileSystem::isFile(filePath))
 		{
 			LOGWRN_VERBOSE("Cannot load resource. Specified file: " + filePath.toString() + " doesn't exist.");
@@ -71,41 +130,45 @@ namespace bs
 			return HResource();
 		}
 
-		String uuid;
-		bool foundUUID = getUUIDFromFilePath(filePath, uuid);
-
 		if (!foundUUID)
 			uuid = UUIDGenerator::generateRandom();
 
-		return loadInternal(uuid, filePath, false, loadFlags);
+		return loadInternal(uuid, filePath, nullptr, false, loadFlags, priority);
 	}
 
-	HResource Resources::loadFromUUID(const String& uuid, bool async, ResourceLoadFlags loadFlags)
+	HResource Resources::loadFromUUID(const String& uuid, bool async, ResourceLoadFlags loadFlags, 
+		ResourceLoadPriority priority)
 	{
 		Path filePath;
+		SPtr<ResourceArchive> archive = findArchive(uuid);
+		if (archive == nullptr)
+			getFilePathFromUUID(uuid, filePath);
 
-		// Default manifest is at 0th index but all other take priority since Default manifest could
-		// contain obsolete data. 
-		for (auto iter = mResourceManifests.rbegin(); iter != mResourceManifests.rend(); ++iter)
-		{
-			if ((*iter)->uuidToFilePath(uuid, filePath))
-				break;
-		}
-
-		return loadInternal(uuid, filePath, !async, loadFlags);
+		return loadInternal(uuid, filePath, archive, !async, loadFlags, priority);
 	}
 
-	HResource Resources::loadInternal(const String& UUID, const Path& filePath, bool synchronous, ResourceLoadFlags loadFlags)
+	HResource Resources::loadInternal(const String& UUID, const Path& filePath, const SPtr<ResourceArchive>& archive,
+		bool synchronous, ResourceLoadFlags loadFlags, ResourceLoadPriority priority)
 	{
+		BS_MEMORY_SCOPE("Resources");
+
 		HResource outputResource;
 
+		// New loads must be registered under the same lock used for checking if the resource is already loaded, as worker
+		// threads might be starting a load of the same resource. Asynchronous loads are then handed off to the loading 
+		// pipeline, which reads the file and queues the dependencies on worker threads.
+		bool canLoad = archive != nullptr || (!filePath.isEmpty() && FileSystem::isFile(filePath));
+
 		bool alreadyLoading = false;
 		bool loadInProgress = false;
+		bool queuedOnPipeline = false;
+		ResourceLoadData* loadData = nullptr;
+		InProgressShard& shard = getInProgressShard(UUID);
 		{
 			// Check if resource is already being loaded on a worker thread
-			Lock inProgressLock(mInProgressResourcesMutex);
-			auto iterFind2 = mInProgressResources.find(UUID);
-			if (iterFind2 != mInProgressResources.end())
+			Lock inProgressLock(shard.mutex);
+			auto iterFind2 = shard.resources.find(UUID);
+			if (iterFind2 != shard.resources.end())
 			{
 				LoadedResourceData& resData = iterFind2->second->resData;
 				outputResource = resData.resource.lock();
@@ -120,10 +183,6 @@ namespace bs
 				loadInProgress = true;
 			}
 
-			// Previously being loaded as async but now we want it synced, so we wait
-			if (loadInProgress && synchronous)
-				outputResource.blockUntilLoaded();
-
 			if (!alreadyLoading)
 			{
 				Lock loadedLock(mLoadedResourceMutex);
@@ -141,18 +200,75 @@ namespace bs
 
 					alreadyLoading = true;
 				}
+				else if (canLoad)
+				{
+					auto iterFindHandle = mHandles.find(UUID);
+					if (iterFindHandle != mHandles.end())
+					{
+						outputResource = iterFindHandle->second.lock();
+						prepareHandleForLoad(outputResource);
+					}
+					else
+					{
+						outputResource = HResource(UUID);
+						mHandles[UUID] = outputResource.getWeak();
+					}
+
+					// Single remaining dependency is the resource itself, released once it is deserialized
+					loadData = bs_new<ResourceLoadData>(outputResource.getWeak(), 1);
+					loadData->notifyImmediately = synchronous; // Make resource listener trigger before exit if loading synchronously
+
+					if (loadFlags.isSet(ResourceLoadFlag::KeepInternalRef))
+					{
+						loadData->resData.numInternalRefs++;
+						outputResource.addInternalRef();
+					}
+
+					shard.resources[UUID] = loadData;
+					queuedOnPipeline = !synchronous;
+				}
 			}
 		}
 
-		// Not loaded and not in progress, start loading of new resource
-		// (or if already loaded or in progress, load any dependencies)
-		if (!alreadyLoading)
+		if (queuedOnPipeline)
+		{
+			ReadRequest request;
+			request.uuid = UUID;
+			request.filePath = filePath;
+			request.archive = archive;
+
+			// Resources in an archive are read in the order they are stored in
+			if (archive != nullptr)
+				request.sortKey = archive->getPath().toString() + toString(archive->findEntry(UUID)->offset, 20, '0');
+			else
+				request.sortKey = filePath.toString();
+			request.resource = outputResource;
+			request.loadFlags = loadFlags;
+
+			queueRead(request, priority);
+			return outputResource;
+		}
+
+		// Previously being loaded as async but now we want it synced, so we wait. This must be done without holding any
+		// locks, as the threads performing the load need to acquire them.
+		if (loadInProgress && synchronous)
+		{
+			prioritizeLoad(UUID);
+			outputResource.blockUntilLoaded();
+		}
+
+		// Not loaded and not in progress, and there is nothing to load it from. Create a handle so the failed load can be
+		// completed below.
+		if (!alreadyLoading && loadData == nullptr)
 		{
 			// Check if the handle already exists
 			Lock lock(mLoadedResourceMutex);
 			auto iterFind = mHandles.find(UUID);
 			if (iterFind != mHandles.end())
+			{
 				outputResource = iterFind->second.lock();
+				prepareHandleForLoad(outputResource);
+			}
 			else
 			{
 				outputResource = HResource(UUID);
@@ -162,7 +278,7 @@ namespace bs
 
 		// We have nowhere to load from, warn and complete load if a file path was provided,
 		// otherwise pass through as we might just want to load from memory. 
-		if (filePath.isEmpty())
+		if (filePath.isEmpty() && archive == nullptr)
 		{
 			if (!alreadyLoading)
 			{
@@ -174,7 +290,7 @@ namespace bs
 				return outputResource;
 			}
 		}
-		else if (!FileSystem::isFile(filePath))
+		else if (!canLoad)
 		{
 			LOGWRN_VERBOSE("Cannot load resource. Specified file: " + filePath.toString() + " doesn't exist.");
 
@@ -188,41 +304,40 @@ namespace bs
 
 		// Load dependency data if a file path is provided
 		SPtr<SavedResourceData> savedResourceData;
-		if (!filePath.isEmpty())
+		if (archive != nullptr)
+		{
+			// Archive index contains the saved resource data, no need to read it from the resource
+			const ResourceArchiveEntry* entry = archive->findEntry(UUID);
+			savedResourceData = bs_shared_ptr_new<SavedResourceData>(entry->dependencies, entry->allowAsyncLoading);
+		}
+		else if (!filePath.isEmpty())
 		{
+			Timer timer;
+
 			FileDecoder fs(filePath);
 			savedResourceData = std::static_pointer_cast<SavedResourceData>(fs.decode());
+
+			if (!alreadyLoading)
+				recordStage(ResourceLoadStage::Read, timer.getMicroseconds());
 		}
 
-		// If already loading keep the old load operation active, otherwise create a new one
+		// If already loading keep the old load operation active, otherwise continue the one registered above. The resource
+		// itself is a remaining dependency until it is deserialized, so the load can't complete while its dependencies are
+		// being registered.
 		if (!alreadyLoading)
 		{
+			// Register dependencies and count them so we know when the resource is fully loaded
+			if (loadFlags.isSet(ResourceLoadFlag::LoadDependencies) && savedResourceData != nullptr)
 			{
-				Lock lock(mInProgressResourcesMutex);
-
-				ResourceLoadData* loadData = bs_new<ResourceLoadData>(outputResource.getWeak(), 0);
-				mInProgressResources[UUID] = loadData;
-				loadData->resData = outputResource.getWeak();
-
-				if (loadFlags.isSet(ResourceLoadFlag::KeepInternalRef))
+				for (auto& dependency : savedResourceData->getDependencies())
 				{
-					loadData->resData.numInternalRefs++;
-					outputResource.addInternalRef();
-				}
-
-				loadData->remainingDependencies = 1;
-				loadData->notifyImmediately = synchronous; // Make resource listener trigger before exit if loading synchronously
-
-				// Register dependencies and count them so we know when the resource is fully loaded
-				if (loadFlags.isSet(ResourceLoadFlag::LoadDependencies) && savedResourceData != nullptr)
-				{
-					for (auto& dependency : savedResourceData->getDependencies())
+					if (dependency != UUID)
 					{
-						if (dependency != UUID)
-						{
-							mDependantLoads[dependency].push_back(loadData);
-							loadData->remainingDependencies++;
-						}
+						loadData->remainingDependencies++;
+
+						InProgressShard& dependencyShard = getInProgressShard(dependency);
+						Lock lock(dependencyShard.mutex);
+						dependencyShard.dependantLoads[dependency].push_back(loadData);
 					}
 				}
 			}
@@ -242,10 +357,10 @@ namespace bs
 
 				// Keep dependencies alive until the parent is done loading
 				{
-					Lock lock(mInProgressResourcesMutex);
+					Lock lock(shard.mutex);
 
 					// At this point the resource is guaranteed to still be in-progress, so it's safe to update its dependency list
-					mInProgressResources[UUID]->dependencies = dependencies;
+					shard.resources[UUID]->dependencies = dependencies;
 				}
 			}
 		}
@@ -255,19 +370,30 @@ namespace bs
 			if (!dependencies.empty())
 			{
 				{
-					Lock lock(mInProgressResourcesMutex);
+					// The load data and the dependant lists must be updated together, as the load can complete as soon as
+					// its lock is released. Lock all the required shards in order of their indices, so that concurrent
+					// registrations can't deadlock.
+					bool lockShard[NUM_IN_PROGRESS_SHARDS] = { };
+					lockShard[getInProgressShardIdx(UUID)] = true;
+					for (auto& dependency : dependencies)
+						lockShard[getInProgressShardIdx(dependency)] = true;
 
-					ResourceLoadData* loadData = nullptr;
+					Lock locks[NUM_IN_PROGRESS_SHARDS];
+					for (UINT32 i = 0; i < NUM_IN_PROGRESS_SHARDS; i++)
+					{
+						if (lockShard[i])
+							locks[i] = Lock(mInProgressShards[i].mutex);
+					}
 
-					auto iterFind = mInProgressResources.find(UUID);
-					if (iterFind == mInProgressResources.end()) // Fully loaded
+					auto iterFind = shard.resources.find(UUID);
+					if (iterFind == shard.resources.end()) // Fully loaded
 					{
 						loadData = bs_new<ResourceLoadData>(outputResource.getWeak(), 0);
 						loadData->resData = outputResource.getWeak();
 						loadData->remainingDependencies = 0;
 						loadData->notifyImmediately = synchronous; // Make resource listener trigger before exit if loading synchronously
 
-						mInProgressResources[UUID] = loadData;
+						shard.resources[UUID] = loadData;
 					}
 					else
 					{
@@ -281,8 +407,11 @@ namespace bs
 						{
 							bool registerDependency = true;
 
-							auto iterFind2 = mDependantLoads.find(dependency);
-							if (iterFind2 != mDependantLoads.end())
+							UnorderedMap<String, Vector<ResourceLoadData*>>& dependantLoads = 
+								getInProgressShard(dependency).dependantLoads;
+
+							auto iterFind2 = dependantLoads.find(dependency);
+							if (iterFind2 != dependantLoads.end())
 							{
 								Vector<ResourceLoadData*>& dependantData = iterFind2->second;
 								auto iterFind3 = std::find_if(dependantData.begin(), dependantData.end(),
@@ -296,7 +425,7 @@ namespace bs
 
 							if (registerDependency)
 							{
-								mDependantLoads[dependency].push_back(loadData);
+								dependantLoads[dependency].push_back(loadData);
 								loadData->remainingDependencies++;
 								loadData->dependencies.push_back(_getResourceHandle(dependency));
 							}
@@ -313,24 +442,11 @@ namespace bs
 			}
 		}
 
-		// Actually start the file read operation if not already loaded or in progress
-		if (!alreadyLoading && !filePath.isEmpty())
+		// Actually start the file read operation if not already loaded or in progress. Asynchronous loads only get here
+		// if they weren't queued on the loading pipeline, in which case they are read immediately as well.
+		if (!alreadyLoading && (!filePath.isEmpty() || archive != nullptr))
 		{
-			// Synchronous or the resource doesn't support async, read the file immediately
-			if (synchronous || !savedResourceData->allowAsyncLoading())
-			{
-				loadCallback(filePath, outputResource, loadFlags.isSet(ResourceLoadFlag::KeepSourceData));
-			}
-			else // Asynchronous, read the file on a worker thread
-			{
-				String fileName = filePath.getFilename();
-				String taskName = "Resource load: " + fileName;
-
-				bool keepSourceData = loadFlags.isSet(ResourceLoadFlag::KeepSourceData);
-				SPtr<Task> task = Task::create(taskName, 
-					std::bind(&Resources::loadCallback, this, filePath, outputResource, keepSourceData));
-				TaskScheduler::instance().addTask(task);
-			}
+			loadCallback(filePath, archive, outputResource, loadFlags.isSet(ResourceLoadFlag::KeepSourceData));
 		}
 		else // File already loaded or in progress
 		{
@@ -342,10 +458,15 @@ namespace bs
 			{
 				// In case loading finished in the meantime we cannot be sure at what point ::loadComplete was triggered,
 				// so trigger it manually so that the dependency count is properly decremented in case this resource
-				// is a dependency.
-				Lock lock(mLoadedResourceMutex);
-				auto iterFind = mLoadedResources.find(UUID);
-				if (iterFind != mLoadedResources.end())
+				// is a dependency. Completing the load locks the in-progress shards, so it must be done without holding
+				// mLoadedResourceMutex.
+				bool isLoaded;
+				{
+					Lock lock(mLoadedResourceMutex);
+					isLoaded = mLoadedResources.find(UUID) != mLoadedResources.end();
+				}
+
+				if (isLoaded)
 					loadComplete(outputResource);
 			}
 		}
@@ -353,16 +474,46 @@ namespace bs
 		return outputResource;
 	}
 
-	SPtr<Resource> Resources::loadFromDiskAndDeserialize(const Path& filePath, bool loadWithSaveData)
+	SPtr<DataStream> Resources::openResourceStream(const String& uuid, const Path& filePath, 
+		const SPtr<ResourceArchive>& archive)
+	{
+		if (archive != nullptr)
+		{
+			const ResourceArchiveEntry* entry = archive->findEntry(uuid);
+			if (entry == nullptr)
+				return nullptr;
+
+			return archive->openEntry(*entry);
+		}
+
+		// Map the file so large data blocks (e.g. mesh and texture data) can reference it without being copied
+		SPtr<DataStream> stream = FileSystem::openFileMapped(filePath);
+		if (stream != nullptr)
+			return stream;
+
+		return FileSystem::openFile(filePath);
+	}
+
+	SPtr<ResourceArchive> Resources::findArchive(const String& uuid) const
 	{
-		FileDecoder fs(filePath);
-		fs.skip(); // Skipped over saved resource data
+		Lock lock(mManifestMutex);
+
+		for (auto iter = mResourceArchives.rbegin(); iter != mResourceArchives.rend(); ++iter)
+		{
+			if ((*iter)->findEntry(uuid) != nullptr)
+				return *iter;
+		}
 
+		return nullptr;
+	}
+
+	SPtr<Resource> Resources::deserialize(FileDecoder& decoder, const Path& filePath, bool loadWithSaveData)
+	{
 		UnorderedMap<String, UINT64> loadParams;
 		if(loadWithSaveData)
 			loadParams["keepSourceData"] = 1;
 
-		SPtr<IReflectable> loadedData = fs.decode(loadParams);
+		SPtr<IReflectable> loadedData = decoder.decode(loadParams);
 
 		if (loadedData == nullptr)
 		{
@@ -384,16 +535,20 @@ namespace bs
 
 		{
 			bool loadInProgress = false;
+			{
+				InProgressShard& shard = getInProgressShard(UUID);
 
-			Lock inProgressLock(mInProgressResourcesMutex);
-			auto iterFind2 = mInProgressResources.find(UUID);
-			if (iterFind2 != mInProgressResources.end())
-				loadInProgress = true;
+				Lock inProgressLock(shard.mutex);
+				auto iterFind2 = shard.resources.find(UUID);
+				if (iterFind2 != shard.resources.end())
+					loadInProgress = true;
+			}
 
 			// Technically we should be able to just cancel a load in progress instead of blocking until it finishes.
 			// However that would mean the last reference could get lost on whatever thread did the loading, which
 			// isn't something that's supported. If this ends up being a problem either make handle counting atomic
-			// or add a separate queue for objects destroyed from the load threads.
+			// or add a separate queue for objects destroyed from the load threads. The wait must be done without holding
+			// the in-progress lock, as the threads performing the load need to acquire it.
 			if (loadInProgress)
 				resource.blockUntilLoaded();
 
@@ -438,6 +593,155 @@ namespace bs
 		}
 	}
 
+	void Resources::setResidencyBudget(UINT64 cpuBytes, UINT64 gpuBytes)
+	{
+		Lock lock(mLoadedResourceMutex);
+
+		mResidencyStats.cpuBudget = cpuBytes;
+		mResidencyStats.gpuBudget = gpuBytes;
+	}
+
+	ResourceResidencyStats Resources::getResidencyStats() const
+	{
+		Lock lock(mLoadedResourceMutex);
+		return mResidencyStats;
+	}
+
+	void Resources::_updateResidency()
+	{
+		UINT64 frameIdx = gTime().getFrameIdx();
+
+		Vector<EvictionCandidate> candidates;
+		UINT64 cpuExcess = 0;
+		UINT64 gpuExcess = 0;
+		{
+			Lock lock(mLoadedResourceMutex);
+
+			UINT64 cpuBytes = 0;
+			UINT64 gpuBytes = 0;
+			UINT32 numResident = 0;
+			for (auto& entry : mLoadedResources)
+			{
+				LoadedResourceData& resData = entry.second;
+
+				const SPtr<ResourceHandleData>& handleData = resData.resource.getHandleData();
+				if (handleData == nullptr || handleData->mPtr == nullptr)
+					continue;
+
+				if (!resData.memoryUsageKnown)
+				{
+					handleData->mPtr->getMemoryUsage(resData.cpuBytes, resData.gpuBytes);
+					resData.memoryUsageKnown = true;
+					resData.lastUsedFrame = frameIdx;
+				}
+
+				cpuBytes += resData.cpuBytes;
+				gpuBytes += resData.gpuBytes;
+				numResident++;
+
+				if (handleData->mRefCount > resData.numInternalRefs) // Referenced from outside, in use
+					resData.lastUsedFrame = frameIdx;
+				else if (resData.cpuBytes > 0 || resData.gpuBytes > 0)
+					candidates.push_back({ resData.resource, resData.lastUsedFrame, resData.cpuBytes, resData.gpuBytes });
+			}
+
+			mResidencyStats.cpuBytes = cpuBytes;
+			mResidencyStats.gpuBytes = gpuBytes;
+			mResidencyStats.numResident = numResident;
+			mResidencyStats.numEvictable = (UINT32)candidates.size();
+
+			if (mResidencyStats.cpuBudget > 0 && cpuBytes > mResidencyStats.cpuBudget)
+				cpuExcess = cpuBytes - mResidencyStats.cpuBudget;
+
+			if (mResidencyStats.gpuBudget > 0 && gpuBytes > mResidencyStats.gpuBudget)
+				gpuExcess = gpuBytes - mResidencyStats.gpuBudget;
+
+			// Forget evicted resources that no handle refers to anymore
+			for (auto iter = mEvictedResources.begin(); iter != mEvictedResources.end();)
+			{
+				auto iterFind = mHandles.find(*iter);
+				if (iterFind == mHandles.end() || iterFind->second.getHandleData().use_count() == 1)
+					iter = mEvictedResources.erase(iter);
+				else
+					++iter;
+			}
+		}
+
+		if (cpuExcess == 0 && gpuExcess == 0)
+			return;
+
+		std::sort(candidates.begin(), candidates.end(), 
+			[](const EvictionCandidate& a, const EvictionCandidate& b) { return a.lastUsedFrame < b.lastUsedFrame; });
+
+		for (auto& candidate : candidates)
+		{
+			if (cpuExcess == 0 && gpuExcess == 0)
+				break;
+
+			// Only evict resources that help with the budget that was exceeded
+			if ((cpuExcess == 0 || candidate.cpuBytes == 0) && (gpuExcess == 0 || candidate.gpuBytes == 0))
+				continue;
+
+			// Resources that cannot be loaded again would be lost
+			const String& uuid = candidate.resource.getUUID();
+
+			Path filePath;
+			if (findArchive(uuid) == nullptr && !getFilePathFromUUID(uuid, filePath))
+				continue;
+
+			HResource resource = candidate.resource.lock();
+			SPtr<Resource> resourcePtr;
+			{
+				Lock lock(mLoadedResourceMutex);
+
+				// Make sure the resource wasn't referenced since it was found, ignoring the reference we just created
+				auto iterFind = mLoadedResources.find(uuid);
+				if (iterFind == mLoadedResources.end() || resource.mData->mRefCount > iterFind->second.numInternalRefs + 1)
+					continue;
+
+				// Unload the resource while the lock is held, so that any load starting after the check above sees the
+				// resource as unloaded and takes the reload path, instead of receiving a handle that is about to be 
+				// cleared
+				LoadedResourceData& resData = iterFind->second;
+				while (resData.numInternalRefs > 0)
+				{
+					resData.numInternalRefs--;
+					resData.resource.removeInternalRef();
+				}
+
+				mLoadedResources.erase(iterFind);
+
+				resourcePtr = resource.mData->mPtr;
+				resource.setHandleData(nullptr, uuid);
+
+				mEvictedResources.insert(uuid);
+
+				mResidencyStats.numEvictions++;
+				mResidencyStats.cpuBytesEvicted += candidate.cpuBytes;
+				mResidencyStats.gpuBytesEvicted += candidate.gpuBytes;
+			}
+
+			onResourceDestroyed(uuid);
+			resourcePtr->destroy();
+
+			cpuExcess -= std::min(cpuExcess, candidate.cpuBytes);
+			gpuExcess -= std::min(gpuExcess, candidate.gpuBytes);
+		}
+	}
+
+	void Resources::prepareHandleForLoad(HResource& handle)
+	{
+		// Handle was used before and its resource was since unloaded, it needs to wait on the new load
+		if (handle.mData->mIsCreated && handle.mData->mPtr == nullptr)
+		{
+			Lock lock(ResourceHandleBase::mResourceCreatedMutex);
+			handle.mData->mIsCreated = false;
+		}
+
+		if (mEvictedResources.erase(handle.getUUID()) > 0)
+			mResidencyStats.numReloads++;
+	}
+
 	void Resources::destroy(ResourceHandleBase& resource)
 	{
 		if (resource.mData == nullptr)
@@ -448,9 +752,11 @@ namespace bs
 		{
 			bool loadInProgress = false;
 			{
-				Lock lock(mInProgressResourcesMutex);
-				auto iterFind2 = mInProgressResources.find(uuid);
-				if (iterFind2 != mInProgressResources.end())
+				InProgressShard& shard = getInProgressShard(uuid);
+
+				Lock lock(shard.mutex);
+				auto iterFind2 = shard.resources.find(uuid);
+				if (iterFind2 != shard.resources.end())
 					loadInProgress = true;
 			}
 
@@ -497,9 +803,11 @@ namespace bs
 		{
 			bool loadInProgress = false;
 			{
-				Lock lock(mInProgressResourcesMutex);
-				auto iterFind2 = mInProgressResources.find(resource.getUUID());
-				if (iterFind2 != mInProgressResources.end())
+				InProgressShard& shard = getInProgressShard(resource.getUUID());
+
+				Lock lock(shard.mutex);
+				auto iterFind2 = shard.resources.find(resource.getUUID());
+				if (iterFind2 != shard.resources.end())
 					loadInProgress = true;
 			}
 
@@ -527,7 +835,10 @@ namespace bs
 				"not be available for saving. File path: " + filePath.toString());
 		}
 
-		mDefaultResourceManifest->registerResource(resource.getUUID(), filePath);
+		{
+			Lock lock(mManifestMutex);
+			mDefaultResourceManifest->registerResource(resource.getUUID(), filePath);
+		}
 
 		Vector<ResourceDependency> dependencyList = Utility::findResourceDependencies(*resource.get());
 		Vector<String> dependencyUUIDs(dependencyList.size());
@@ -582,11 +893,26 @@ namespace bs
 		return savedResourceData->getDependencies();
 	}
 
+	Vector<String> Resources::getDependenciesFromUUID(const String& uuid)
+	{
+		SPtr<ResourceArchive> archive = findArchive(uuid);
+		if (archive != nullptr)
+			return archive->findEntry(uuid)->dependencies;
+
+		Path filePath;
+		if (!getFilePathFromUUID(uuid, filePath) || !FileSystem::isFile(filePath))
+			return Vector<String>();
+
+		return getDependencies(filePath);
+	}
+
 	void Resources::registerResourceManifest(const SPtr<ResourceManifest>& manifest)
 	{
 		if(manifest->getName() == "Default")
 			return;
 
+		Lock lock(mManifestMutex);
+
 		auto findIter = std::find(mResourceManifests.begin(), mResourceManifests.end(), manifest);
 		if(findIter == mResourceManifests.end())
 			mResourceManifests.push_back(manifest);
@@ -599,13 +925,35 @@ namespace bs
 		if (manifest->getName() == "Default")
 			return;
 
+		Lock lock(mManifestMutex);
+
 		auto findIter = std::find(mResourceManifests.begin(), mResourceManifests.end(), manifest);
 		if (findIter != mResourceManifests.end())
 			mResourceManifests.erase(findIter);
 	}
 
+	void Resources::registerResourceArchive(const SPtr<ResourceArchive>& archive)
+	{
+		Lock lock(mManifestMutex);
+
+		auto findIter = std::find(mResourceArchives.begin(), mResourceArchives.end(), archive);
+		if (findIter == mResourceArchives.end())
+			mResourceArchives.push_back(archive);
+	}
+
+	void Resources::unregisterResourceArchive(const SPtr<ResourceArchive>& archive)
+	{
+		Lock lock(mManifestMutex);
+
+		auto findIter = std::find(mResourceArchives.begin(), mResourceArchives.end(), archive);
+		if (findIter != mResourceArchives.end())
+			mResourceArchives.erase(findIter);
+	}
+
 	SPtr<ResourceManifest> Resources::getResourceManifest(const String& name) const
 	{
+		Lock lock(mManifestMutex);
+
 		for(auto iter = mResourceManifests.rbegin(); iter != mResourceManifests.rend(); ++iter) 
 		{
 			if(name == (*iter)->getName())
@@ -619,9 +967,11 @@ namespace bs
 	{
 		if (checkInProgress)
 		{
-			Lock inProgressLock(mInProgressResourcesMutex);
-			auto iterFind2 = mInProgressResources.find(uuid);
-			if (iterFind2 != mInProgressResources.end())
+			InProgressShard& shard = getInProgressShard(uuid);
+
+			Lock inProgressLock(shard.mutex);
+			auto iterFind2 = shard.resources.find(uuid);
+			if (iterFind2 != shard.resources.end())
 			{
 				return true;
 			}
@@ -678,6 +1028,10 @@ namespace bs
 
 	bool Resources::getFilePathFromUUID(const String& uuid, Path& filePath) const
 	{
+		Lock lock(mManifestMutex);
+
+		// Default manifest is at 0th index but all other take priority since Default manifest could
+		// contain obsolete data. 
 		for(auto iter = mResourceManifests.rbegin(); iter != mResourceManifests.rend(); ++iter) 
 		{
 			if((*iter)->uuidToFilePath(uuid, filePath))
@@ -693,6 +1047,8 @@ namespace bs
 		if (!manifestPath.isAbsolute())
 			manifestPath.makeAbsolute(FileSystem::getWorkingDirectoryPath());
 
+		Lock lock(mManifestMutex);
+
 		for(auto iter = mResourceManifests.rbegin(); iter != mResourceManifests.rend(); ++iter) 
 		{
 			if ((*iter)->filePathToUUID(manifestPath, uuid))
@@ -702,82 +1058,424 @@ namespace bs
 		return false;
 	}
 
-	void Resources::loadComplete(HResource& resource)
+	ResourceLoadStats Resources::getLoadStats() const
 	{
-		String uuid = resource.getUUID();
+		ResourceLoadStats stats;
+		for (UINT32 i = 0; i < (UINT32)ResourceLoadStage::Count; i++)
+		{
+			stats.numProcessed[i] = mStageNumProcessed[i].load(std::memory_order_relaxed);
+			stats.totalTimeUs[i] = mStageTimeUs[i].load(std::memory_order_relaxed);
+			stats.numQueued[i] = 0;
+		}
 
-		ResourceLoadData* myLoadData = nullptr;
-		bool finishLoad = true;
-		Vector<ResourceLoadData*> dependantLoads;
 		{
-			Lock inProgresslock(mInProgressResourcesMutex);
+			Lock lock(mPipelineMutex);
 
-			auto iterFind = mInProgressResources.find(uuid);
-			if (iterFind != mInProgressResources.end())
+			for (UINT32 i = 0; i < (UINT32)ResourceLoadPriority::Count; i++)
+				stats.numQueued[(UINT32)ResourceLoadStage::Read] += (UINT32)mReadQueues[i].size();
+
+			stats.numQueued[(UINT32)ResourceLoadStage::Deserialize] = mNumQueuedDeserialize;
+		}
+
+		stats.numQueued[(UINT32)ResourceLoadStage::Upload] = mNumQueuedUploads.load(std::memory_order_relaxed);
+		return stats;
+	}
+
+	void Resources::loadComplete(HResource& resource)
+	{
+		// Completing a load can complete the loads of its dependants, which can in turn complete their own dependants.
+		// Process them iteratively, as dependency chains can be arbitrarily deep.
+		Vector<HResource> toComplete = { resource };
+		while (!toComplete.empty())
+		{
+			HResource current = toComplete.back();
+			toComplete.pop_back();
+
+			String uuid = current.getUUID();
+
+			ResourceLoadData* myLoadData = nullptr;
+			bool finishLoad = true;
 			{
-				myLoadData = iterFind->second;
-				finishLoad = myLoadData->remainingDependencies == 0;
-				
+				InProgressShard& shard = getInProgressShard(uuid);
+				Lock inProgresslock(shard.mutex);
+
+				auto iterFind = shard.resources.find(uuid);
+				if (iterFind != shard.resources.end())
+				{
+					myLoadData = iterFind->second;
+					finishLoad = myLoadData->remainingDependencies == 0;
+					
+					if (finishLoad)
+						shard.resources.erase(iterFind);
+				}
+
+				auto iterFind2 = shard.dependantLoads.find(uuid);
+				if (iterFind2 != shard.dependantLoads.end())
+				{
+					// Dependants are stored in other shards, whose locks aren't held. Retrieve the handle before 
+					// decrementing the counter, as the dependant's load can complete and free its load data as soon as 
+					// the counter reaches zero.
+					for (auto& dependantLoad : iterFind2->second)
+					{
+						toComplete.push_back(dependantLoad->resData.resource.lock());
+
+						if (finishLoad)
+							dependantLoad->remainingDependencies--;
+					}
+				}
+
 				if (finishLoad)
-					mInProgressResources.erase(iterFind);
+				{
+					shard.dependantLoads.erase(uuid);
+
+					// If loadedData is null then we're probably completing load on an already loaded resource, triggered
+					// by its dependencies.
+					if (myLoadData != nullptr && myLoadData->loadedData != nullptr)
+					{
+						Lock loadedLock(mLoadedResourceMutex);
+
+						mLoadedResources[uuid] = myLoadData->resData;
+						current.setHandleData(myLoadData->loadedData, uuid);
+					}
+				}
+			}
+
+			if (finishLoad && myLoadData != nullptr)
+			{
+				onResourceLoaded(current);
+
+				// This should only ever be true on the main thread
+				if (myLoadData->notifyImmediately)
+					ResourceListenerManager::instance().notifyListeners(uuid);
+
+				bs_delete(myLoadData);
 			}
+		}
+	}
+
+	void Resources::loadCallback(const Path& filePath, const SPtr<ResourceArchive>& archive, HResource& resource, 
+		bool loadWithSaveData)
+	{
+		BS_MEMORY_SCOPE("Resources");
+		Timer timer;
+
+		SPtr<Resource> rawResource;
+		SPtr<DataStream> stream = openResourceStream(resource.getUUID(), filePath, archive);
+		if (stream != nullptr)
+		{
+			FileDecoder fs(stream);
+			fs.skip(); // Skipped over saved resource data
+
+			rawResource = deserialize(fs, archive != nullptr ? archive->getPath() : filePath, loadWithSaveData);
+		}
+		else
+			LOGERR("Unable to load resource at path \"" + filePath.toString() + "\"");
+
+		recordStage(ResourceLoadStage::Deserialize, timer.getMicroseconds());
+
+		trackUpload(rawResource);
+		finishDeserialize(resource, rawResource);
+	}
+
+	void Resources::finishDeserialize(HResource& resource, const SPtr<Resource>& rawResource)
+	{
+		Timer timer;
 
-			auto iterFind2 = mDependantLoads.find(uuid);
+		{
+			InProgressShard& shard = getInProgressShard(resource.getUUID());
+			Lock lock(shard.mutex);
+
+			// Check if all my dependencies are loaded
+			ResourceLoadData* myLoadData = shard.resources[resource.getUUID()];
+			myLoadData->loadedData = rawResource;
+			myLoadData->remainingDependencies--;
+		}
 
-			if (iterFind2 != mDependantLoads.end())
-				dependantLoads = iterFind2->second;
+		loadComplete(resource);
+		recordStage(ResourceLoadStage::PostProcess, timer.getMicroseconds());
+	}
+
+	void Resources::queueRead(const ReadRequest& request, ResourceLoadPriority priority)
+	{
+		Lock lock(mPipelineMutex);
+
+		mReadQueues[(UINT32)priority].push_back(request);
+		startReadTasks();
+	}
 
-			if (finishLoad)
+	void Resources::startReadTasks()
+	{
+		// Reading is stalled until the deserialize tasks catch up, so that memory used by files that were read but not yet
+		// deserialized stays bounded
+		if (mNumQueuedDeserialize >= MAX_QUEUED_DESERIALIZE)
+			return;
+
+		UINT32 numPendingReads = 0;
+		for (UINT32 i = 0; i < (UINT32)ResourceLoadPriority::Count; i++)
+			numPendingReads += (UINT32)mReadQueues[i].size();
+
+		UINT32 numBatches = (numPendingReads + READ_BATCH_SIZE - 1) / READ_BATCH_SIZE;
+		UINT32 numTasks = std::min(numBatches, MAX_READ_TASKS);
+
+		while (mNumReadTasks < numTasks)
+		{
+			SPtr<Task> task = Task::create("Resource read", std::bind(&Resources::readTaskWorker, this), TaskPriority::High);
+			TaskScheduler::instance().addTask(task);
+
+			mNumReadTasks++;
+		}
+	}
+
+	void Resources::readTaskWorker()
+	{
+		Vector<ReadRequest> batch;
+		batch.reserve(READ_BATCH_SIZE);
+
+		while (true)
+		{
+			ResourceLoadPriority priority;
 			{
-				mDependantLoads.erase(uuid);
+				Lock lock(mPipelineMutex);
+
+				UINT32 queueIdx = 0;
+				while (queueIdx < (UINT32)ResourceLoadPriority::Count && mReadQueues[queueIdx].empty())
+					queueIdx++;
 
-				// If loadedData is null then we're probably completing load on an already loaded resource, triggered
-				// by its dependencies.
-				if (myLoadData != nullptr && myLoadData->loadedData != nullptr)
+				if (queueIdx == (UINT32)ResourceLoadPriority::Count || mNumQueuedDeserialize >= MAX_QUEUED_DESERIALIZE)
 				{
-					Lock loadedLock(mLoadedResourceMutex);
+					mNumReadTasks--;
+					return;
+				}
+
+				// Reserve a deserialize slot for each request, so the deserialize stage can't grow past its limit
+				// regardless of how many read tasks are running
+				Deque<ReadRequest>& queue = mReadQueues[queueIdx];
+				UINT32 numRequests = std::min((UINT32)queue.size(), READ_BATCH_SIZE);
+				numRequests = std::min(numRequests, MAX_QUEUED_DESERIALIZE - mNumQueuedDeserialize);
 
-					mLoadedResources[uuid] = myLoadData->resData;
-					resource.setHandleData(myLoadData->loadedData, uuid);
+				for (UINT32 i = 0; i < numRequests; i++)
+				{
+					batch.push_back(std::move(queue.front()));
+					queue.pop_front();
 				}
 
-				for (auto& dependantLoad : dependantLoads)
-					dependantLoad->remainingDependencies--;
+				mNumQueuedDeserialize += numRequests;
+
+				priority = (ResourceLoadPriority)queueIdx;
+			}
+
+			// Read the files in order of their paths, so files stored close to each other are read together
+			std::sort(batch.begin(), batch.end(), 
+				[](const ReadRequest& a, const ReadRequest& b) { return a.sortKey < b.sortKey; });
+
+			for (auto& request : batch)
+				readResource(request, priority);
+
+			batch.clear();
+		}
+	}
+
+	void Resources::readResource(const ReadRequest& request, ResourceLoadPriority priority)
+	{
+		BS_MEMORY_SCOPE("Resources");
+		Timer timer;
+
+		SPtr<DataStream> stream = openResourceStream(request.uuid, request.filePath, request.archive);
+		Path sourcePath = request.archive != nullptr ? request.archive->getPath() : request.filePath;
+
+		SPtr<SavedResourceData> savedResourceData;
+		if (stream != nullptr)
+		{
+			// Touch every page of the mapped file, so the file is read from disk here instead of during deserialization
+			if (stream->isMapped())
+			{
+				SPtr<MemoryDataStream> memStream = std::static_pointer_cast<MemoryDataStream>(stream);
+				const UINT8* data = memStream->getPtr();
+				size_t size = memStream->size();
+
+				UINT8 checksum = 0;
+				for (size_t i = 0; i < size; i += 4096)
+					checksum ^= data[i];
+
+				volatile UINT8 sink = checksum;
+				(void)sink;
 			}
+
+			FileDecoder fs(stream);
+			if (request.archive != nullptr)
+			{
+				// Archive index contains the saved resource data, no need to decode it
+				const ResourceArchiveEntry* entry = request.archive->findEntry(request.uuid);
+				savedResourceData = bs_shared_ptr_new<SavedResourceData>(entry->dependencies, entry->allowAsyncLoading);
+
+				fs.skip();
+			}
+			else
+				savedResourceData = std::static_pointer_cast<SavedResourceData>(fs.decode());
 		}
 
-		for (auto& dependantLoad : dependantLoads)
+		HResource resource = request.resource;
+		if (savedResourceData == nullptr)
 		{
-			HResource dependant = dependantLoad->resData.resource.lock();
-			loadComplete(dependant);
+			LOGERR("Unable to load resource at path \"" + sourcePath.toString() + "\"");
+
+			recordStage(ResourceLoadStage::Read, timer.getMicroseconds());
+			finishDeserialize(resource, nullptr);
+			releaseDeserializeSlot();
+			return;
 		}
 
-		if (finishLoad && myLoadData != nullptr)
+		if (request.loadFlags.isSet(ResourceLoadFlag::LoadDependencies))
 		{
-			onResourceLoaded(resource);
+			const Vector<String>& dependencyUUIDs = savedResourceData->getDependencies();
+			UINT32 numDependencies = (UINT32)dependencyUUIDs.size();
+
+			// Resource can't finish loading before it is deserialized, so its load data is guaranteed to stay valid
+			InProgressShard& shard = getInProgressShard(request.uuid);
+
+			ResourceLoadData* loadData;
+			{
+				Lock lock(shard.mutex);
+				loadData = shard.resources[request.uuid];
+			}
+
+			// Register dependencies and count them so we know when the resource is fully loaded
+			for (auto& dependency : dependencyUUIDs)
+			{
+				if (dependency != request.uuid)
+				{
+					loadData->remainingDependencies++;
+
+					InProgressShard& dependencyShard = getInProgressShard(dependency);
+					Lock lock(dependencyShard.mutex);
+					dependencyShard.dependantLoads[dependency].push_back(loadData);
+				}
+			}
+
+			ResourceLoadFlags depLoadFlags = ResourceLoadFlag::LoadDependencies;
+			if (request.loadFlags.isSet(ResourceLoadFlag::KeepSourceData))
+				depLoadFlags |= ResourceLoadFlag::KeepSourceData;
+
+			Vector<HResource> dependencies(numDependencies);
+			for (UINT32 i = 0; i < numDependencies; i++)
+				dependencies[i] = loadFromUUID(dependencyUUIDs[i], true, depLoadFlags, priority);
+
+			// Keep dependencies alive until the parent is done loading
+			{
+				Lock lock(shard.mutex);
+				loadData->dependencies = dependencies;
+			}
+		}
 
-			// This should only ever be true on the main thread
-			if (myLoadData->notifyImmediately)
-				ResourceListenerManager::instance().notifyListeners(uuid);
+		recordStage(ResourceLoadStage::Read, timer.getMicroseconds());
 
-			bs_delete(myLoadData);
+		DeserializeRequest deserializeRequest;
+		deserializeRequest.filePath = sourcePath;
+		deserializeRequest.resource = resource;
+		deserializeRequest.stream = stream;
+		deserializeRequest.keepSourceData = request.loadFlags.isSet(ResourceLoadFlag::KeepSourceData);
+
+		// Resources that don't support asynchronous loading are deserialized by the read task, one at a time
+		if (!savedResourceData->allowAsyncLoading())
+		{
+			deserializeResource(deserializeRequest);
+			releaseDeserializeSlot();
+			return;
 		}
+
+		String taskName = "Resource load: " + request.filePath.getFilename();
+		SPtr<Task> task = Task::create(taskName, std::bind(&Resources::deserializeTaskWorker, this, deserializeRequest), 
+			getDeserializeTaskPriority(priority));
+		TaskScheduler::instance().addTask(task);
+	}
+
+	void Resources::deserializeResource(const DeserializeRequest& request)
+	{
+		BS_MEMORY_SCOPE("Resources");
+		Timer timer;
+
+		FileDecoder fs(request.stream);
+		SPtr<Resource> rawResource = deserialize(fs, request.filePath, request.keepSourceData);
+		recordStage(ResourceLoadStage::Deserialize, timer.getMicroseconds());
+
+		trackUpload(rawResource);
+
+		HResource resource = request.resource;
+		finishDeserialize(resource, rawResource);
+	}
+
+	void Resources::deserializeTaskWorker(const DeserializeRequest& request)
+	{
+		deserializeResource(request);
+		releaseDeserializeSlot();
+	}
+
+	void Resources::releaseDeserializeSlot()
+	{
+		// Read tasks might have stopped due to the deserialize stage being full
+		Lock lock(mPipelineMutex);
+
+		mNumQueuedDeserialize--;
+		startReadTasks();
+	}
+
+	void Resources::trackUpload(const SPtr<Resource>& resource)
+	{
+		if (resource == nullptr)
+			return;
+
+		if (resource->getCore() == nullptr)
+			return;
+
+		if (!CoreThread::isStarted() || BS_THREAD_CURRENT_ID == gCoreThread().getCoreThreadId())
+			return;
+
+		// Core object initialization is queued on the internal queue during deserialization, so this command executes
+		// right after it
+		mNumQueuedUploads++;
+		gCoreThread().queueCommand(std::bind(&Resources::uploadComplete, this, Timer()), CTQF_InternalQueue);
+	}
+
+	void Resources::uploadComplete(const Timer& timer)
+	{
+		mNumQueuedUploads--;
+		recordStage(ResourceLoadStage::Upload, timer.getMicroseconds());
 	}
 
-	void Resources::loadCallback(const Path& filePath, HResource& resource, bool loadWithSaveData)
+	void Resources::prioritizeLoad(const String& uuid)
 	{
-		SPtr<Resource> rawResource = loadFromDiskAndDeserialize(filePath, loadWithSaveData);
+		Lock lock(mPipelineMutex);
 
+		for (UINT32 i = (UINT32)ResourceLoadPriority::Blocking + 1; i < (UINT32)ResourceLoadPriority::Count; i++)
 		{
-			Lock lock(mInProgressResourcesMutex);
+			Deque<ReadRequest>& queue = mReadQueues[i];
+			auto iterFind = std::find_if(queue.begin(), queue.end(), 
+				[&](const ReadRequest& x) { return x.uuid == uuid; });
 
-			// Check if all my dependencies are loaded
-			ResourceLoadData* myLoadData = mInProgressResources[resource.getUUID()];
-			myLoadData->loadedData = rawResource;
-			myLoadData->remainingDependencies--;
+			if (iterFind != queue.end())
+			{
+				mReadQueues[(UINT32)ResourceLoadPriority::Blocking].push_back(std::move(*iterFind));
+				queue.erase(iterFind);
+
+				return;
+			}
 		}
+	}
 
-		loadComplete(resource);
+	void Resources::recordStage(ResourceLoadStage stage, UINT64 timeUs)
+	{
+		mStageNumProcessed[(UINT32)stage].fetch_add(1, std::memory_order_relaxed);
+		mStageTimeUs[(UINT32)stage].fetch_add(timeUs, std::memory_order_relaxed);
+	}
+
+	Resources::InProgressShard& Resources::getInProgressShard(const String& uuid)
+	{
+		return mInProgressShards[getInProgressShardIdx(uuid)];
+	}
+
+	UINT32 Resources::getInProgressShardIdx(const String& uuid)
+	{
+		return (UINT32)(std::hash<String>()(uuid) % NUM_IN_PROGRESS_SHARDS);
 	}
 
 	BS_CORE_EXPORT Resources& gResources()
@@ -0,0 +1,355 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#include "BsResourcesTestSuite.h"
+#include "BsResources.h"
+#include "BsResource.h"
+#include "BsResourceListenerManager.h"
+#include "BsCoreObjectManager.h"
+#include "BsTime.h"
+#include "BsFileSystem.h"
+#include "BsRTTIType.h"
+#include "BsThreadDefines.h"
+
+namespace bs
+{
+	/** Resource containing a block of data and a list of resources it depends on. */
+	class TestResource : public Resource
+	{
+	public:
+		TestResource()
+			:Resource(false)
+		{ }
+
+		Vector<float> mData;
+		Vector<HResource> mDependencies;
+
+		/** Creates a new resource and a handle to it. */
+		static HResource create(UINT32 dataSize, const Vector<HResource>& dependencies)
+		{
+			SPtr<TestResource> resource = _createPtr();
+			resource->mData.resize(dataSize, 1.0f);
+			resource->mDependencies = dependencies;
+
+			return gResources()._createResourceHandle(resource);
+		}
+
+		/** Creates a new resource without a handle. */
+		static SPtr<TestResource> _createPtr()
+		{
+			SPtr<TestResource> resource = bs_core_ptr<TestResource>(new (bs_alloc<TestResource>()) TestResource());
+			resource->_setThisPtr(resource);
+			resource->initialize();
+
+			return resource;
+		}
+
+		/** @copydoc Resource::getMemoryUsage */
+		void getMemoryUsage(UINT64& cpuBytes, UINT64& gpuBytes) const override
+		{
+			cpuBytes = mData.size() * sizeof(float);
+			gpuBytes = 0;
+		}
+
+		static RTTITypeBase* getRTTIStatic();
+		RTTITypeBase* getRTTI() const override;
+
+	protected:
+		/** @copydoc Resource::getResourceDependencies */
+		void getResourceDependencies(FrameVector<HResource>& dependencies) const override
+		{
+			for (auto& entry : mDependencies)
+				dependencies.push_back(entry);
+		}
+	};
+
+	class TestResourceRTTI : public RTTIType<TestResource, Resource, TestResourceRTTI>
+	{
+	private:
+		BS_BEGIN_RTTI_MEMBERS
+			BS_RTTI_MEMBER_PLAIN_ARRAY(mData, 0)
+			BS_RTTI_MEMBER_REFL_ARRAY(mDependencies, 1)
+		BS_END_RTTI_MEMBERS
+	public:
+		TestResourceRTTI()
+			:mInitMembers(this)
+		{ }
+
+		const String& getRTTIName() override
+		{
+			static String name = "TestResource";
+			return name;
+		}
+
+		UINT32 getRTTIId() override
+		{
+			return 100011; // Outside of the range used by engine types
+		}
+
+		SPtr<IReflectable> newRTTIObject() override
+		{
+			return TestResource::_createPtr();
+		}
+	};
+
+	RTTITypeBase* TestResource::getRTTIStatic()
+	{
+		return TestResourceRTTI::instance();
+	}
+
+	RTTITypeBase* TestResource::getRTTI() const
+	{
+		return getRTTIStatic();
+	}
+
+	/** Number of group resources the root resource depends on. */
+	static const UINT32 NUM_GROUPS = 8;
+
+	/** Number of resources each group resource depends on. */
+	static const UINT32 NUM_GROUP_RESOURCES = 100;
+
+	/** Number of floats stored in each of the group's dependencies. */
+	static const UINT32 DATA_SIZE = 256;
+
+	/** Maximum number of resources the loading pipeline may hold read but not yet deserialized. */
+	static const UINT32 MAX_QUEUED_DESERIALIZE = 64;
+
+	static Path getGroupPath(const Path& folder, UINT32 idx)
+	{
+		Path path = folder;
+		path.setFilename("Group_" + toString(idx) + ".asset");
+
+		return path;
+	}
+
+	static Path getResourcePath(const Path& folder, UINT32 groupIdx, UINT32 idx)
+	{
+		Path path = folder;
+		path.setFilename("Resource_" + toString(groupIdx) + "_" + toString(idx) + ".asset");
+
+		return path;
+	}
+
+	static Path getRootPath(const Path& folder)
+	{
+		Path path = folder;
+		path.setFilename("Root.asset");
+
+		return path;
+	}
+
+	/** Checks that the resource and all of its dependencies (recursively) are loaded and contain the saved data. */
+	static bool isTreeLoaded(const HResource& resource)
+	{
+		if (!resource.isLoaded(false))
+			return false;
+
+		ResourceHandle<TestResource> testResource = static_resource_cast<TestResource>(resource);
+		for (auto& entry : testResource->mData)
+		{
+			if (entry != 1.0f)
+				return false;
+		}
+
+		for (auto& dependency : testResource->mDependencies)
+		{
+			if (!isTreeLoaded(dependency))
+				return false;
+		}
+
+		return true;
+	}
+
+	/** Releases the provided resource, and unloads it along with all its dependencies. */
+	static void unloadTree(HResource& root)
+	{
+		gResources().release(root);
+		root = nullptr;
+
+		// Asynchronously loaded resources are referenced until their listeners are notified
+		ResourceListenerManager::instance().update();
+
+		// Dependencies only become unused once the resource referencing them is unloaded, so unload one level per call
+		for (UINT32 i = 0; i < 3; i++)
+			gResources().unloadAllUnused();
+	}
+
+	ResourcesTestSuite::ResourcesTestSuite()
+	{
+		BS_ADD_TEST(ResourcesTestSuite::testLoadAsync_dependencies);
+		BS_ADD_TEST(ResourcesTestSuite::testLoadAsync_sync_load_in_progress);
+		BS_ADD_TEST(ResourcesTestSuite::testResidency_evict_reload);
+	}
+
+	void ResourcesTestSuite::startUp()
+	{
+		// Runs as part of PixelUtilTestSuite, which starts the thread pool and the task scheduler
+		Time::startUp();
+		CoreObjectManager::startUp();
+		Resources::startUp();
+		ResourceListenerManager::startUp();
+
+		mFolder = FileSystem::getTempDirectoryPath();
+		mFolder.append("BansheeResourcesTest/");
+		FileSystem::createDir(mFolder);
+
+		Vector<HResource> groups;
+		for (UINT32 i = 0; i < NUM_GROUPS; i++)
+		{
+			Vector<HResource> resources;
+			for (UINT32 j = 0; j < NUM_GROUP_RESOURCES; j++)
+			{
+				HResource resource = TestResource::create(DATA_SIZE, Vector<HResource>());
+				gResources().save(resource, getResourcePath(mFolder, i, j), true);
+
+				resources.push_back(resource);
+			}
+
+			HResource group = TestResource::create(0, resources);
+			gResources().save(group, getGroupPath(mFolder, i), true);
+
+			groups.push_back(group);
+		}
+
+		HResource root = TestResource::create(0, groups);
+		gResources().save(root, getRootPath(mFolder), true);
+
+		gResources().unloadAllUnused();
+	}
+
+	void ResourcesTestSuite::shutDown()
+	{
+		FileSystem::remove(mFolder);
+
+		ResourceListenerManager::shutDown();
+		Resources::shutDown();
+		CoreObjectManager::shutDown();
+		Time::shutDown();
+	}
+
+	void ResourcesTestSuite::testLoadAsync_dependencies()
+	{
+		HResource root = gResources().loadAsync(getRootPath(mFolder));
+
+		// Read but not yet deserialized resources must stay within the bound while the pipeline is busy
+		UINT32 maxQueued = 0;
+		while (!root.isLoaded())
+		{
+			ResourceLoadStats stats = gResources().getLoadStats();
+			maxQueued = std::max(maxQueued, stats.numQueued[(UINT32)ResourceLoadStage::Deserialize]);
+		}
+
+		BS_TEST_ASSERT(maxQueued <= MAX_QUEUED_DESERIALIZE);
+		BS_TEST_ASSERT(isTreeLoaded(root));
+
+		ResourceLoadStats stats = gResources().getLoadStats();
+		for (UINT32 i = 0; i < (UINT32)ResourceLoadStage::Count; i++)
+			BS_TEST_ASSERT(stats.numQueued[i] == 0);
+
+		unloadTree(root);
+	}
+
+	void ResourcesTestSuite::testLoadAsync_sync_load_in_progress()
+	{
+		HResource root = gResources().loadAsync(getRootPath(mFolder));
+
+		// Synchronous loads of resources the pipeline is already loading must wait for them, not load them again
+		Vector<HResource> groups;
+		for (UINT32 i = 0; i < NUM_GROUPS; i++)
+		{
+			HResource group = gResources().load(getGroupPath(mFolder, i));
+			BS_TEST_ASSERT(isTreeLoaded(group));
+
+			groups.push_back(group);
+		}
+
+		root.blockUntilLoaded();
+		BS_TEST_ASSERT(isTreeLoaded(root));
+
+		ResourceHandle<TestResource> testRoot = static_resource_cast<TestResource>(root);
+		for (UINT32 i = 0; i < NUM_GROUPS; i++)
+			BS_TEST_ASSERT(testRoot->mDependencies[i].getUUID() == groups[i].getUUID());
+
+		for (auto& group : groups)
+			gResources().release(group);
+
+		unloadTree(root);
+	}
+
+	void ResourcesTestSuite::testResidency_evict_reload()
+	{
+		static const UINT32 NUM_RESOURCES = 10;
+		static const UINT32 NUM_RESIDENT = 5;
+		static const UINT32 NUM_LOADS = 500;
+
+		// Loaded resources only referenced by the resource system can be evicted. Weak handles keep track of them 
+		// without referencing them.
+		Vector<WeakResourceHandle<Resource>> weakResources;
+		for (UINT32 i = 0; i < NUM_RESOURCES; i++)
+			weakResources.push_back(gResources().load(getResourcePath(mFolder, 0, i)).getWeak());
+
+		ResourceResidencyStats startStats = gResources().getResidencyStats();
+
+		UINT64 budget = NUM_RESIDENT * DATA_SIZE * sizeof(float);
+		gResources().setResidencyBudget(budget, 0);
+		gResources()._updateResidency();
+
+		UINT32 numEvicted = 0;
+		for (auto& resource : weakResources)
+		{
+			if (!resource.isLoaded(false))
+				numEvicted++;
+		}
+
+		BS_TEST_ASSERT(numEvicted >= NUM_RESOURCES - NUM_RESIDENT);
+		BS_TEST_ASSERT(gResources().getResidencyStats().numEvictions - startStats.numEvictions == numEvicted);
+
+		// Memory use is measured before evicting, so the next update reports it within the budget
+		gResources()._updateResidency();
+		BS_TEST_ASSERT(gResources().getResidencyStats().cpuBytes <= budget);
+
+		// Resources loaded on another thread while evictions run must always come back loaded
+		std::atomic<UINT32> numFailed(0);
+		std::atomic<bool> done(false);
+		Thread thread([this, &numFailed, &done]()
+		{
+			MemStack::beginThread();
+
+			for (UINT32 i = 0; i < NUM_LOADS; i++)
+			{
+				HResource resource = gResources().load(getResourcePath(mFolder, 0, i % NUM_RESOURCES));
+				if (!isTreeLoaded(resource))
+					numFailed++;
+			}
+
+			MemStack::endThread();
+			done = true;
+		});
+
+		while (!done)
+			gResources()._updateResidency();
+
+		thread.join();
+		BS_TEST_ASSERT(numFailed == 0);
+
+		// Evicted resources are reloaded on next use, and existing handles point to the reloaded data
+		gResources()._updateResidency();
+		gResources().setResidencyBudget(0, 0);
+
+		UINT64 numReloads = gResources().getResidencyStats().numReloads;
+
+		Vector<HResource> resources;
+		numEvicted = 0;
+		for (auto& resource : weakResources)
+		{
+			if (!resource.isLoaded(false))
+				numEvicted++;
+
+			resources.push_back(gResources().load(resource));
+			BS_TEST_ASSERT(isTreeLoaded(resources.back()));
+			BS_TEST_ASSERT(resource.isLoaded(false));
+		}
+
+		BS_TEST_ASSERT(numEvicted >= NUM_RESOURCES - NUM_RESIDENT);
+		BS_TEST_ASSERT(gResources().getResidencyStats().numReloads - numReloads == numEvicted);
+	}
+}
@@ -10,6 +10,8 @@
 #include "BsViewport.h"
 #include "BsGameObjectManager.h"
 #include "BsRenderTarget.h"
+#include "BsProfilerCPU.h"
+#include "BsTaskScheduler.h"
 
 namespace bs
 {
@@ -20,6 +22,12 @@ namespace bs
 		UninitializedList = 2
 	};
 
+	/** Minimum number of components in a thread safe update group before they are updated in parallel. */
+	static const UINT32 PARALLEL_MIN_COMPONENTS = 256;
+
+	/** Number of components updated by a single task. */
+	static const UINT32 COMPONENTS_PER_TASK = 64;
+
 	SceneManager::SceneManager()
 	{
 		mRootNode = SceneObject::createInternal("SceneRoot");
@@ -80,38 +88,96 @@ namespace bs
 
 		mRootNode = root;
 		mRootNode->_setParent(HSceneObject());
+		mTransformStorage.notifyHierarchyDirty();
 
 		oldRoot->destroy();
 	}
 
+	/** Returns the core object a registered entry of the scene manager refers to. */
+	static void* getCoreObject(const SceneRenderableData& data) { return data.renderable.get(); }
+	static void* getCoreObject(const SceneCameraData& data) { return data.camera.get(); }
+	static void* getCoreObject(const SceneLightData& data) { return data.light.get(); }
+	static void* getCoreObject(const SceneReflectionProbeData& data) { return data.probe.get(); }
+
+	template<class T>
+	void SceneManager::registerCoreObject(Vector<T>& objects, SceneCoreObjectType type, const T& data)
+	{
+		void* object = getCoreObject(data);
+		unregisterCoreObject(objects, object);
+
+		CoreObjectEntry entry;
+		entry.type = type;
+		entry.index = (UINT32)objects.size();
+		entry.sceneObject = !data.sceneObject.isDestroyed() ? data.sceneObject.get() : nullptr;
+
+		objects.push_back(data);
+		mCoreObjects[object] = entry;
+		mSceneObjectBindings.insert(std::make_pair(entry.sceneObject, object));
+
+		// Make sure the new object receives the current state of its scene object
+		if (!data.sceneObject.isDestroyed())
+			_notifyCoreObjectsDirty(data.sceneObject);
+	}
+
+	template<class T>
+	void SceneManager::unregisterCoreObject(Vector<T>& objects, void* object)
+	{
+		auto iterFind = mCoreObjects.find(object);
+		if (iterFind == mCoreObjects.end())
+			return;
+
+		CoreObjectEntry entry = iterFind->second;
+		mCoreObjects.erase(iterFind);
+
+		auto range = mSceneObjectBindings.equal_range(entry.sceneObject);
+		for (auto iter = range.first; iter != range.second; ++iter)
+		{
+			if (iter->second == object)
+			{
+				mSceneObjectBindings.erase(iter);
+				break;
+			}
+		}
+
+		// Swap with the last entry so the array stays dense
+		UINT32 lastIdx = (UINT32)objects.size() - 1;
+		if (entry.index != lastIdx)
+		{
+			std::swap(objects[entry.index], objects[lastIdx]);
+			mCoreObjects[getCoreObject(objects[entry.index])].index = entry.index;
+		}
+
+		objects.erase(objects.end() - 1);
+	}
+
 	void SceneManager::_registerRenderable(const SPtr<Renderable>& renderable, const HSceneObject& so)
 	{
-		mRenderables[renderable.get()] = SceneRenderableData(renderable, so);
+		registerCoreObject(mRenderables, SceneCoreObjectType::Renderable, SceneRenderableData(renderable, so));
 	}
 
 	void SceneManager::_unregisterRenderable(const SPtr<Renderable>& renderable)
 	{
-		mRenderables.erase(renderable.get());
+		unregisterCoreObject(mRenderables, renderable.get());
 	}
 
 	void SceneManager::_registerLight(const SPtr<Light>& light, const HSceneObject& so)
 	{
-		mLights[light.get()] = SceneLightData(light, so);
+		registerCoreObject(mLights, SceneCoreObjectType::Light, SceneLightData(light, so));
 	}
 
 	void SceneManager::_unregisterLight(const SPtr<Light>& light)
 	{
-		mLights.erase(light.get());
+		unregisterCoreObject(mLights, light.get());
 	}
 
 	void SceneManager::_registerCamera(const SPtr<Camera>& camera, const HSceneObject& so)
 	{
-		mCameras[camera.get()] = SceneCameraData(camera, so);
+		registerCoreObject(mCameras, SceneCoreObjectType::Camera, SceneCameraData(camera, so));
 	}
 
 	void SceneManager::_unregisterCamera(const SPtr<Camera>& camera)
 	{
-		mCameras.erase(camera.get());
+		unregisterCoreObject(mCameras, camera.get());
 
 		auto iterFind = std::find_if(mMainCameras.begin(), mMainCameras.end(),
 			[&](const SceneCameraData& x)
@@ -125,12 +191,13 @@ namespace bs
 
 	void SceneManager::_registerReflectionProbe(const SPtr<ReflectionProbe>& probe, const HSceneObject& so)
 	{
-		mReflectionProbes[probe.get()] = SceneReflectionProbeData(probe, so);
+		registerCoreObject(mReflectionProbes, SceneCoreObjectType::ReflectionProbe, 
+			SceneReflectionProbeData(probe, so));
 	}
 
 	void SceneManager::_unregisterReflectionProbe(const SPtr<ReflectionProbe>& probe)
 	{
-		mReflectionProbes.erase(probe.get());
+		unregisterCoreObject(mReflectionProbes, probe.get());
 	}
 
 	void SceneManager::_notifyMainCameraStateChanged(const SPtr<Camera>& camera)
@@ -145,7 +212,11 @@ namespace bs
 		if (camera->isMain())
 		{
 			if (iterFind == mMainCameras.end())
-				mMainCameras.push_back(mCameras[camera.get()]);
+			{
+				auto iterFindCamera = mCoreObjects.find(camera.get());
+				if (iterFindCamera != mCoreObjects.end())
+					mMainCameras.push_back(mCameras[iterFindCamera->second.index]);
+			}
 
 			viewport->setTarget(mMainRT);
 		}
@@ -159,23 +230,89 @@ namespace bs
 		}
 	}
 
+	void SceneManager::setBatchedTransformUpdates(bool enabled)
+	{
+		if (mBatchedTransformUpdates == enabled)
+			return;
+
+		mBatchedTransformUpdates = enabled;
+
+		// Deliver any pending changes. Any changes made by the notified components are already handled immediately.
+		if (!enabled)
+			mTransformStorage.update(mRootNode);
+
+		mTransformStorage.clear();
+	}
+
+	void SceneManager::_updateTransforms()
+	{
+		if (!mBatchedTransformUpdates)
+			return;
+
+		mTransformStorage.update(mRootNode);
+	}
+
+	void SceneManager::_notifyTransformModified(const HSceneObject& so)
+	{
+		mTransformStorage.queueModified(so);
+	}
+
+	void SceneManager::_notifyHierarchyChanged()
+	{
+		if (mBatchedTransformUpdates)
+			mTransformStorage.notifyHierarchyDirty();
+	}
+
+	void SceneManager::_notifyCoreObjectsDirty(const HSceneObject& so)
+	{
+		if ((so->mDirtyFlags & SceneObject::CoreSyncQueued) != 0)
+			return;
+
+		so->mDirtyFlags |= SceneObject::CoreSyncQueued;
+		mDirtySceneObjects.push_back(so);
+	}
+
 	void SceneManager::_updateCoreObjectTransforms()
 	{
-		for (auto& renderablePair : mRenderables)
+		// Objects queued during the sync (if any) get handled on the next call
+		Vector<HSceneObject> dirtySceneObjects;
+		std::swap(dirtySceneObjects, mDirtySceneObjects);
+
+		for (auto& so : dirtySceneObjects)
 		{
-			SPtr<Renderable> renderable = renderablePair.second.renderable;
-			HSceneObject so = renderablePair.second.sceneObject;
+			if (so.isDestroyed())
+				continue;
+
+			so->mDirtyFlags &= ~SceneObject::CoreSyncQueued;
+
+			auto range = mSceneObjectBindings.equal_range(so.get());
+			for (auto iter = range.first; iter != range.second; ++iter)
+			{
+				const CoreObjectEntry& entry = mCoreObjects[iter->second];
+				syncCoreObject(entry.type, entry.index);
+			}
+		}
+	}
+
+	void SceneManager::syncCoreObject(SceneCoreObjectType type, UINT32 idx)
+	{
+		switch(type)
+		{
+		case SceneCoreObjectType::Renderable:
+		{
+			SPtr<Renderable> renderable = mRenderables[idx].renderable;
+			HSceneObject so = mRenderables[idx].sceneObject;
 
 			renderable->_updateTransform(so);
 
 			if (so->getActive() != renderable->getIsActive())
 				renderable->setIsActive(so->getActive());
 		}
-
-		for (auto& cameraPair : mCameras)
+			break;
+		case SceneCoreObjectType::Camera:
 		{
-			SPtr<Camera> handler = cameraPair.second.camera;
-			HSceneObject so = cameraPair.second.sceneObject;
+			SPtr<Camera> handler = mCameras[idx].camera;
+			HSceneObject so = mCameras[idx].sceneObject;
 
 			UINT32 curHash = so->getTransformHash();
 			if (curHash != handler->_getLastModifiedHash())
@@ -187,15 +324,13 @@ namespace bs
 			}
 
 			if (so->getActive() != handler->getIsActive())
-			{
 				handler->setIsActive(so->getActive());
-			}
 		}
-
-		for (auto& lightPair : mLights)
+			break;
+		case SceneCoreObjectType::Light:
 		{
-			SPtr<Light> handler = lightPair.second.light;
-			HSceneObject so = lightPair.second.sceneObject;
+			SPtr<Light> handler = mLights[idx].light;
+			HSceneObject so = mLights[idx].sceneObject;
 
 			UINT32 curHash = so->getTransformHash();
 			if (curHash != handler->_getLastModifiedHash())
@@ -207,15 +342,13 @@ namespace bs
 			}
 
 			if (so->getActive() != handler->getIsActive())
-			{
 				handler->setIsActive(so->getActive());
-			}
 		}
-
-		for (auto& probePair : mReflectionProbes)
+			break;
+		case SceneCoreObjectType::ReflectionProbe:
 		{
-			SPtr<ReflectionProbe> probe = probePair.second.probe;
-			HSceneObject so = probePair.second.sceneObject;
+			SPtr<ReflectionProbe> probe = mReflectionProbes[idx].probe;
+			HSceneObject so = mReflectionProbes[idx].sceneObject;
 
 			UINT32 curHash = so->getTransformHash();
 			if (curHash != probe->_getLastModifiedHash())
@@ -227,9 +360,9 @@ namespace bs
 			}
 
 			if (so->getActive() != probe->getIsActive())
-			{
 				probe->setIsActive(so->getActive());
-			}
+		}
+			break;
 		}
 	}
 
@@ -293,11 +426,7 @@ namespace bs
 					if (entry->sceneObject()->getActive())
 					{
 						entry->onEnabled();
-
-						UINT32 idx = (UINT32)mActiveComponents.size();
-						mActiveComponents.push_back(entry);
-
-						entry->setSceneManagerId(encodeComponentId(idx, ActiveList));
+						addToActiveList(entry);
 					}
 					else
 					{
@@ -325,10 +454,7 @@ namespace bs
 				removeFromInactiveList(component);
 				i--; // Keep the same index next iteration to process the component we just swapped
 
-				UINT32 activeIdx = (UINT32)mActiveComponents.size();
-				mActiveComponents.push_back(component);
-
-				component->setSceneManagerId(encodeComponentId(activeIdx, ActiveList));
+				addToActiveList(component);
 			}
 		}
 		// Stop updates on all active components
@@ -383,11 +509,7 @@ namespace bs
 			if (parentActive)
 			{
 				component->onEnabled();
-
-				UINT32 idx = (UINT32)mActiveComponents.size();
-				mActiveComponents.push_back(component);
-
-				component->setSceneManagerId(encodeComponentId(idx, ActiveList));
+				addToActiveList(component);
 			}
 			else
 			{
@@ -416,11 +538,7 @@ namespace bs
 				component->onEnabled();
 
 			removeFromInactiveList(component);
-
-			UINT32 activeIdx = (UINT32)mActiveComponents.size();
-			mActiveComponents.push_back(component);
-
-			component->setSceneManagerId(encodeComponentId(activeIdx, ActiveList));
+			addToActiveList(component);
 		}
 	}
 
@@ -473,8 +591,19 @@ namespace bs
 		component->onDestroyed();
 	}
 
+	void SceneManager::addToActiveList(const HComponent& component)
+	{
+		UINT32 idx = (UINT32)mActiveComponents.size();
+		mActiveComponents.push_back(component);
+
+		component->setSceneManagerId(encodeComponentId(idx, ActiveList));
+		addToUpdateGroup(component);
+	}
+
 	void SceneManager::removeFromActiveList(const HComponent& component)
 	{
+		removeFromUpdateGroup(component);
+
 		UINT32 listType;
 		UINT32 idx;
 		decodeComponentId(component->getSceneManagerId(), idx, listType);
@@ -493,6 +622,92 @@ namespace bs
 		mActiveComponents.erase(mActiveComponents.end() - 1);
 	}
 
+	void SceneManager::addToUpdateGroup(const HComponent& component)
+	{
+		const ComponentFlags updateFlags = ComponentFlag::PostPhysicsUpdate | ComponentFlag::LateUpdate | 
+			ComponentFlag::ThreadSafeUpdate;
+
+		ComponentFlags flags = component->mFlags & updateFlags;
+		RTTITypeBase* rtti = component->getRTTI();
+
+		UINT64 key = ((UINT64)rtti->getRTTIId() << 32) | (UINT32)flags;
+		auto iterFind = mUpdateGroupLookup.find(key);
+
+		UINT32 groupId;
+		if (iterFind == mUpdateGroupLookup.end())
+		{
+			groupId = (UINT32)mUpdateGroups.size();
+			mUpdateGroups.push_back(ComponentUpdateGroup());
+
+			ComponentUpdateGroup& group = mUpdateGroups.back();
+			group.name = rtti->getRTTIName().c_str();
+			group.flags = flags;
+
+			mUpdateGroupLookup[key] = groupId;
+		}
+		else
+			groupId = iterFind->second;
+
+		ComponentUpdateGroup& group = mUpdateGroups[groupId];
+		component->mUpdateGroupId = groupId;
+		component->mUpdateGroupIdx = (UINT32)group.components.size();
+		group.components.push_back(component.get());
+	}
+
+	void SceneManager::removeFromUpdateGroup(const HComponent& component)
+	{
+		Component* componentPtr = component.get();
+
+		ComponentUpdateGroup& group = mUpdateGroups[componentPtr->mUpdateGroupId];
+		UINT32 idx = componentPtr->mUpdateGroupIdx;
+		UINT32 lastIdx = (UINT32)group.components.size() - 1;
+
+		assert(group.components[idx] == componentPtr);
+
+		// Moving another component into the removed slot while the group is being iterated would cause the moved 
+		// component to be skipped, so only clear the slot until the update phase finishes
+		if (mUpdatingComponents)
+		{
+			group.components[idx] = nullptr;
+			group.hasRemovedEntries = true;
+		}
+		else
+		{
+			if (idx != lastIdx)
+			{
+				std::swap(group.components[idx], group.components[lastIdx]);
+				group.components[idx]->mUpdateGroupIdx = idx;
+			}
+
+			group.components.erase(group.components.end() - 1);
+		}
+
+		componentPtr->mUpdateGroupId = (UINT32)-1;
+		componentPtr->mUpdateGroupIdx = (UINT32)-1;
+	}
+
+	void SceneManager::compactUpdateGroups()
+	{
+		for (auto& group : mUpdateGroups)
+		{
+			if (!group.hasRemovedEntries)
+				continue;
+
+			UINT32 numComponents = 0;
+			for (auto& component : group.components)
+			{
+				if (component == nullptr)
+					continue;
+
+				component->mUpdateGroupIdx = numComponents;
+				group.components[numComponents++] = component;
+			}
+
+			group.components.resize(numComponents);
+			group.hasRemovedEntries = false;
+		}
+	}
+
 	void SceneManager::removeFromInactiveList(const HComponent& component)
 	{
 		UINT32 listType;
@@ -546,17 +761,76 @@ namespace bs
 		type = id >> 30;
 	}
 
-	void SceneManager::_update()
+	void SceneManager::_update(ComponentUpdatePhase phase)
 	{
-		// Note: Eventually perform updates based on component types and/or on component priority. Right now we just
-		// iterate in an undefined order, but it wouldn't be hard to change it.
+		ComponentFlags phaseFlags;
+		if (phase == ComponentUpdatePhase::PostPhysics)
+			phaseFlags = ComponentFlag::PostPhysicsUpdate;
+		else if (phase == ComponentUpdatePhase::Late)
+			phaseFlags = ComponentFlag::LateUpdate;
+
+		// Note: Indexing instead of iterating, since serially updated components can create or destroy other components.
+		// Components removed in the meantime leave null entries in their groups, compacted once all groups are updated.
+		mUpdatingComponents = true;
+		for (UINT32 i = 0; i < (UINT32)mUpdateGroups.size(); i++)
+		{
+			if (mUpdateGroups[i].components.empty())
+				continue;
 
-		for (auto& entry : mActiveComponents)
-			entry->update();
+			if (phase != ComponentUpdatePhase::PrePhysics && (mUpdateGroups[i].flags & phaseFlags) == 0)
+				continue;
+
+			const char* name = mUpdateGroups[i].name;
+			gProfilerCPU().beginSample(name);
+
+			UINT32 numComponents = (UINT32)mUpdateGroups[i].components.size();
+			bool threadSafe = mUpdateGroups[i].flags.isSet(ComponentFlag::ThreadSafeUpdate);
+			if (threadSafe && numComponents >= PARALLEL_MIN_COMPONENTS && TaskScheduler::isStarted())
+			{
+				TaskScheduler::instance().parallelFor(0, numComponents, COMPONENTS_PER_TASK,
+					[this, i, phase](UINT32 start, UINT32 end)
+				{
+					updateComponents(i, phase, start, end);
+				});
+			}
+			else
+				updateComponents(i, phase, 0, numComponents);
+
+			gProfilerCPU().endSample(name);
+		}
+
+		mUpdatingComponents = false;
+		compactUpdateGroups();
 
 		GameObjectManager::instance().destroyQueuedObjects();
 	}
 
+	void SceneManager::updateComponents(UINT32 groupId, ComponentUpdatePhase phase, UINT32 start, UINT32 end)
+	{
+		// Type of all components in the group is the same, so the virtual calls below are well predicted
+		for (UINT32 i = start; i < end && i < (UINT32)mUpdateGroups[groupId].components.size(); i++)
+		{
+			Component* component = mUpdateGroups[groupId].components[i];
+			if (component == nullptr) // Removed during this update phase
+				continue;
+
+			switch(phase)
+			{
+			case ComponentUpdatePhase::PrePhysics:
+				component->update();
+				break;
+			case ComponentUpdatePhase::PostPhysics:
+				component->postPhysicsUpdate();
+				break;
+			case ComponentUpdatePhase::Late:
+				component->lateUpdate();
+				break;
+			default:
+				break;
+			}
+		}
+	}
+
 	void SceneManager::registerNewSO(const HSceneObject& node)
 	{ 
 		if(mRootNode)
@@ -0,0 +1,175 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#include "BsSceneManagerTestSuite.h"
+#include "BsSceneManager.h"
+#include "BsSceneObject.h"
+#include "BsComponent.h"
+#include "BsGameObjectManager.h"
+#include "BsProfilerCPU.h"
+#include "BsRTTIType.h"
+
+namespace bs
+{
+	/** Component that counts its updates, and can deactivate a scene object when updated. */
+	class TestUpdateComponent : public Component
+	{
+	public:
+		TestUpdateComponent(const HSceneObject& parent)
+			:Component(parent)
+		{ }
+
+		void update() override
+		{
+			numUpdates++;
+
+			if (deactivateOnUpdate != nullptr)
+				deactivateOnUpdate->setActive(false);
+		}
+
+		UINT32 numUpdates = 0;
+		HSceneObject deactivateOnUpdate;
+
+		static RTTITypeBase* getRTTIStatic();
+		RTTITypeBase* getRTTI() const override;
+	};
+
+	class TestUpdateComponentRTTI : public RTTIType<TestUpdateComponent, Component, TestUpdateComponentRTTI>
+	{
+	public:
+		const String& getRTTIName() override
+		{
+			static String name = "TestUpdateComponent";
+			return name;
+		}
+
+		UINT32 getRTTIId() override
+		{
+			return 100010; // Outside of the range used by engine types
+		}
+
+		SPtr<IReflectable> newRTTIObject() override
+		{
+			return nullptr;
+		}
+	};
+
+	RTTITypeBase* TestUpdateComponent::getRTTIStatic()
+	{
+		return TestUpdateComponentRTTI::instance();
+	}
+
+	RTTITypeBase* TestUpdateComponent::getRTTI() const
+	{
+		return getRTTIStatic();
+	}
+
+	/** Number of components created by each test. All of them end up in the same update group. */
+	static const UINT32 NUM_COMPONENTS = 10;
+
+	static Vector<GameObjectHandle<TestUpdateComponent>> createComponents()
+	{
+		Vector<GameObjectHandle<TestUpdateComponent>> components;
+		for (UINT32 i = 0; i < NUM_COMPONENTS; i++)
+		{
+			HSceneObject so = SceneObject::create("TestUpdate");
+			components.push_back(so->addComponent<TestUpdateComponent>());
+		}
+
+		return components;
+	}
+
+	static void destroyComponents(Vector<GameObjectHandle<TestUpdateComponent>>& components)
+	{
+		for (auto& component : components)
+			component->SO()->destroy(true);
+	}
+
+	/** Runs a single update and checks that each component was updated the expected number of times. */
+	static bool checkUpdates(Vector<GameObjectHandle<TestUpdateComponent>>& components,
+		const Vector<UINT32>& expected)
+	{
+		for (auto& component : components)
+			component->numUpdates = 0;
+
+		gSceneManager()._update(ComponentUpdatePhase::PrePhysics);
+
+		bool valid = true;
+		for (UINT32 i = 0; i < NUM_COMPONENTS; i++)
+			valid &= components[i]->numUpdates == expected[i];
+
+		return valid;
+	}
+
+	SceneManagerTestSuite::SceneManagerTestSuite()
+	{
+		BS_ADD_TEST(SceneManagerTestSuite::testUpdate_once);
+		BS_ADD_TEST(SceneManagerTestSuite::testUpdate_remove_self);
+		BS_ADD_TEST(SceneManagerTestSuite::testUpdate_remove_updated);
+		BS_ADD_TEST(SceneManagerTestSuite::testUpdate_remove_pending);
+	}
+
+	void SceneManagerTestSuite::startUp()
+	{
+		// Runs as part of GameObjectManagerTestSuite, which starts the game object manager
+		ProfilerCPU::startUp();
+		SceneManager::startUp();
+	}
+
+	void SceneManagerTestSuite::shutDown()
+	{
+		SceneManager::shutDown();
+		ProfilerCPU::shutDown();
+	}
+
+	void SceneManagerTestSuite::testUpdate_once()
+	{
+		Vector<GameObjectHandle<TestUpdateComponent>> components = createComponents();
+
+		BS_TEST_ASSERT(checkUpdates(components, Vector<UINT32>(NUM_COMPONENTS, 1)));
+
+		destroyComponents(components);
+	}
+
+	void SceneManagerTestSuite::testUpdate_remove_self()
+	{
+		Vector<GameObjectHandle<TestUpdateComponent>> components = createComponents();
+		components[3]->deactivateOnUpdate = components[3]->SO();
+
+		// The component moved into the removed component's slot must still be updated
+		BS_TEST_ASSERT(checkUpdates(components, Vector<UINT32>(NUM_COMPONENTS, 1)));
+
+		Vector<UINT32> expected(NUM_COMPONENTS, 1);
+		expected[3] = 0;
+		BS_TEST_ASSERT(checkUpdates(components, expected));
+
+		destroyComponents(components);
+	}
+
+	void SceneManagerTestSuite::testUpdate_remove_updated()
+	{
+		Vector<GameObjectHandle<TestUpdateComponent>> components = createComponents();
+		components[5]->deactivateOnUpdate = components[2]->SO();
+
+		BS_TEST_ASSERT(checkUpdates(components, Vector<UINT32>(NUM_COMPONENTS, 1)));
+
+		Vector<UINT32> expected(NUM_COMPONENTS, 1);
+		expected[2] = 0;
+		BS_TEST_ASSERT(checkUpdates(components, expected));
+
+		destroyComponents(components);
+	}
+
+	void SceneManagerTestSuite::testUpdate_remove_pending()
+	{
+		Vector<GameObjectHandle<TestUpdateComponent>> components = createComponents();
+		components[4]->deactivateOnUpdate = components[8]->SO();
+
+		// Deactivated before its turn, so it isn't updated at all
+		Vector<UINT32> expected(NUM_COMPONENTS, 1);
+		expected[8] = 0;
+		BS_TEST_ASSERT(checkUpdates(components, expected));
+		BS_TEST_ASSERT(checkUpdates(components, expected));
+
+		destroyComponents(components);
+	}
+}
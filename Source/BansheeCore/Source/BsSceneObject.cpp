@@ -11,14 +11,23 @@
 #include "BsPrefabUtility.h"
 #include "BsMatrix3.h"
 #include "BsCoreApplication.h"
+#include "BsPhysics.h"
 
 namespace bs
 {
+	/** Checks are transform changes of instantiated objects propagated through a batched update in SceneManager. */
+	static bool isBatchingTransforms()
+	{
+		return SceneManager::isStarted() && gSceneManager().getBatchedTransformUpdates();
+	}
+
 	SceneObject::SceneObject(const String& name, UINT32 flags)
 		: GameObject(), mPrefabHash(0), mFlags(flags), mPosition(Vector3::ZERO), mRotation(Quaternion::IDENTITY)
 		, mScale(Vector3::ONE), mWorldPosition(Vector3::ZERO), mWorldRotation(Quaternion::IDENTITY)
 		, mWorldScale(Vector3::ONE), mCachedLocalTfrm(Matrix4::IDENTITY), mCachedWorldTfrm(Matrix4::IDENTITY)
-		, mDirtyFlags(0xFFFFFFFF), mDirtyHash(0), mActiveSelf(true), mActiveHierarchy(true)
+		, mDirtyFlags(DirtyFlags::LocalTfrmDirty | DirtyFlags::WorldTfrmDirty), mDirtyHash(0), mWorldVersion(0)
+		, mParentWorldVersion(0), mPendingNotifyFlags(0), mTransformIdx((UINT32)-1), mActiveSelf(true)
+		, mActiveHierarchy(true)
 	{
 		setName(name);
 	}
@@ -431,11 +440,67 @@ namespace bs
 			updateWorldTfrm();
 	}
 
+	bool SceneObject::isCachedWorldTfrmUpToDate() const
+	{
+		if ((mDirtyFlags & DirtyFlags::WorldTfrmDirty) != 0)
+			return false;
+
+		if (mParent == nullptr || !isBatchingTransforms())
+			return true;
+
+		return mParent->isCachedWorldTfrmUpToDate() && mParent->mWorldVersion == mParentWorldVersion;
+	}
+
 	void SceneObject::notifyTransformChanged(TransformChangedFlags flags) const
 	{
 		mDirtyFlags |= DirtyFlags::LocalTfrmDirty | DirtyFlags::WorldTfrmDirty;
 		mDirtyHash++;
 
+		notifyCoreObjectsDirty();
+
+		if (isInstantiated() && isBatchingTransforms())
+		{
+			// Components check the physics update state when notified, so changes made by the physics update are delivered
+			// right away. World transforms are still recalculated by SceneManager::_updateTransforms().
+			if (Physics::isStarted() && gPhysics()._isUpdateInProgress())
+				triggerTransformChangedRecursive(flags);
+			else
+			{
+				// Descendants and components get notified once per frame, by SceneManager::_updateTransforms(). Which
+				// components want the notification is decided now, as components might disable their notify flags while
+				// moving their own scene object.
+				mPendingNotifyFlags |= flags;
+
+				for (auto& entry : mComponents)
+				{
+					if (entry->supportsNotify(flags))
+						entry->mPendingNotifyFlags = (TransformChangedFlags)(entry->mPendingNotifyFlags | flags);
+				}
+			}
+
+			if ((mDirtyFlags & DirtyFlags::QueuedForUpdate) == 0)
+			{
+				mDirtyFlags |= DirtyFlags::QueuedForUpdate;
+				gSceneManager()._notifyTransformModified(mThisHandle);
+			}
+
+			return;
+		}
+
+		triggerTransformChanged(flags);
+
+		for (auto& entry : mChildren)
+			entry->notifyTransformChanged(flags);
+	}
+
+	void SceneObject::notifyCoreObjectsDirty() const
+	{
+		if (isInstantiated() && SceneManager::isStarted())
+			gSceneManager()._notifyCoreObjectsDirty(mThisHandle);
+	}
+
+	void SceneObject::triggerTransformChanged(TransformChangedFlags flags) const
+	{
 		for(auto& entry : mComponents)
 		{
 			if (entry->supportsNotify(flags))
@@ -445,9 +510,39 @@ namespace bs
 					entry->onTransformChanged(flags);
 			}
 		}
+	}
+
+	void SceneObject::triggerTransformChangedRecursive(TransformChangedFlags flags) const
+	{
+		triggerTransformChanged(flags);
 
 		for (auto& entry : mChildren)
-			entry->notifyTransformChanged(flags);
+			entry->triggerTransformChangedRecursive(flags);
+	}
+
+	void SceneObject::triggerPendingTransformChanged(TransformChangedFlags parentFlags) const
+	{
+		for(auto& entry : mComponents)
+		{
+			TransformChangedFlags flags = entry->mPendingNotifyFlags;
+			entry->mPendingNotifyFlags = TCF_None;
+
+			if (entry->supportsNotify(parentFlags))
+				flags = (TransformChangedFlags)(flags | parentFlags);
+
+			if (flags == TCF_None)
+				continue;
+
+			bool alwaysRun = entry->hasFlag(ComponentFlag::AlwaysRun);
+			if(alwaysRun || gSceneManager().isRunning())
+				entry->onTransformChanged(flags);
+		}
+	}
+
+	void SceneObject::clearPendingTransformChanged() const
+	{
+		for(auto& entry : mComponents)
+			entry->mPendingNotifyFlags = TCF_None;
 	}
 
 	void SceneObject::updateWorldTfrm() const
@@ -471,6 +566,7 @@ namespace bs
 			mWorldPosition += mParent->getWorldPosition();
 
 			mCachedWorldTfrm.setTRS(mWorldPosition, mWorldRotation, mWorldScale);
+			mParentWorldVersion = mParent->mWorldVersion;
 		}
 		else
 		{
@@ -482,6 +578,7 @@ namespace bs
 		}
 
 		mDirtyFlags &= ~DirtyFlags::WorldTfrmDirty;
+		mWorldVersion++;
 	}
 
 	void SceneObject::updateLocalTfrm() const
@@ -580,6 +677,9 @@ namespace bs
 		mChildren.push_back(object); 
 
 		object->_setFlags(mFlags);
+
+		if (SceneManager::isStarted())
+			gSceneManager()._notifyHierarchyChanged();
 	}
 
 	void SceneObject::removeChild(const HSceneObject& object)
@@ -593,6 +693,9 @@ namespace bs
 			BS_EXCEPT(InternalErrorException, 
 				"Trying to remove a child but it's not a child of the transform.");
 		}
+
+		if (SceneManager::isStarted())
+			gSceneManager()._notifyHierarchyChanged();
 	}
 
 	HSceneObject SceneObject::findChild(const String& name, bool recursive)
@@ -653,6 +756,7 @@ namespace bs
 		if (mActiveHierarchy != activeHierarchy)
 		{
 			mActiveHierarchy = activeHierarchy;
+			notifyCoreObjectsDirty();
 
 			if (triggerEvents)
 			{
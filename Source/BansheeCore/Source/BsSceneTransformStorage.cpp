@@ -0,0 +1,288 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#include "BsSceneTransformStorage.h"
+#include "BsSceneObject.h"
+#include "BsTaskScheduler.h"
+
+namespace bs
+{
+	/** Minimum number of objects at a single hierarchy depth before their transforms are updated in parallel. */
+	static const UINT32 PARALLEL_MIN_OBJECTS = 1024;
+
+	/** Number of objects whose transforms are updated by a single task. */
+	static const UINT32 OBJECTS_PER_TASK = 512;
+
+	/** Parent index of objects without a parent. */
+	static const UINT32 NO_PARENT = (UINT32)-1;
+
+	SceneTransformStorage::SceneTransformStorage()
+		:mHierarchyDirty(true)
+	{ }
+
+	void SceneTransformStorage::queueModified(const HSceneObject& so)
+	{
+		mModifiedObjects.push_back(so);
+	}
+
+	void SceneTransformStorage::update(const HSceneObject& root)
+	{
+		if (mHierarchyDirty)
+			rebuild(root);
+
+		// Notifications triggered below might modify transforms again, those get handled on the next update
+		Vector<HSceneObject> modifiedObjects;
+		std::swap(modifiedObjects, mModifiedObjects);
+
+		UINT32 numObjects = (UINT32)mObjects.size();
+		UINT32 firstLevel = (UINT32)mLevelOffsets.size();
+		for (auto& so : modifiedObjects)
+		{
+			if (so.isDestroyed())
+				continue;
+
+			SceneObject* obj = so.get();
+			TransformChangedFlags flags = (TransformChangedFlags)obj->mPendingNotifyFlags;
+
+			obj->mPendingNotifyFlags = 0;
+			obj->mDirtyFlags &= ~SceneObject::QueuedForUpdate;
+
+			UINT32 idx = obj->mTransformIdx;
+			if (idx >= numObjects || mObjects[idx].get() != obj)
+			{
+				// Not part of the scene hierarchy, notify the object and its descendants directly
+				obj->triggerPendingTransformChanged(TCF_None);
+
+				for (auto& child : obj->mChildren)
+					child->notifyTransformChanged(flags);
+
+				continue;
+			}
+
+			mLocalPositions[idx] = obj->mPosition;
+			mLocalRotations[idx] = obj->mRotation;
+			mLocalScales[idx] = obj->mScale;
+
+			mDirty[idx] |= Modified;
+			mNotifyFlags[idx] |= flags;
+
+			UINT32 level = (UINT32)(std::upper_bound(mLevelOffsets.begin(), mLevelOffsets.end(), idx) -
+				mLevelOffsets.begin()) - 1;
+			firstLevel = std::min(firstLevel, level);
+		}
+
+		UINT32 numLevels = (UINT32)mLevelOffsets.size() - 1;
+		if (firstLevel >= numLevels)
+			return;
+
+		// Each level depends on the world transforms of the previous one, but objects within a level are independent
+		for (UINT32 level = firstLevel; level < numLevels; level++)
+		{
+			UINT32 start = mLevelOffsets[level];
+			UINT32 end = mLevelOffsets[level + 1];
+
+			if ((end - start) >= PARALLEL_MIN_OBJECTS && TaskScheduler::isStarted())
+			{
+				TaskScheduler::instance().parallelFor(start, end, OBJECTS_PER_TASK,
+					[this](UINT32 rangeStart, UINT32 rangeEnd)
+				{
+					updateRange(rangeStart, rangeEnd);
+				});
+			}
+			else
+				updateRange(start, end);
+		}
+
+		// Write the results back, parents always come before their children
+		Vector<std::pair<HSceneObject, TransformChangedFlags>> notifications;
+		for (UINT32 i = mLevelOffsets[firstLevel]; i < numObjects; i++)
+		{
+			if (mDirty[i] == Clean)
+				continue;
+
+			if (mObjects[i].isDestroyed())
+			{
+				mDirty[i] = Clean;
+				mNotifyFlags[i] = 0;
+				mParentNotifyFlags[i] = 0;
+				continue;
+			}
+
+			SceneObject* obj = mObjects[i].get();
+			obj->mWorldPosition = mWorldPositions[i];
+			obj->mWorldRotation = mWorldRotations[i];
+			obj->mWorldScale = mWorldScales[i];
+			obj->mCachedWorldTfrm = mWorldTfrms[i];
+			obj->mDirtyFlags &= ~SceneObject::WorldTfrmDirty;
+			obj->mWorldVersion++;
+
+			UINT32 parentIdx = mParents[i];
+			if (parentIdx != NO_PARENT)
+				obj->mParentWorldVersion = mObjects[parentIdx]->mWorldVersion;
+
+			// Objects modified directly already changed their hash and were queued for a core object sync when they
+			// were modified
+			if ((mDirty[i] & Modified) == 0)
+			{
+				obj->mDirtyHash++;
+				obj->notifyCoreObjectsDirty();
+			}
+
+			notifications.push_back(std::make_pair(mObjects[i], (TransformChangedFlags)mParentNotifyFlags[i]));
+
+			mDirty[i] = Clean;
+			mNotifyFlags[i] = 0;
+			mParentNotifyFlags[i] = 0;
+		}
+
+		// Notify components last, as they might modify the hierarchy. Notifications for the object's own modifications
+		// were queued on its components when the modifications were made.
+		for (auto& entry : notifications)
+		{
+			if (!entry.first.isDestroyed())
+				entry.first->triggerPendingTransformChanged(entry.second);
+		}
+	}
+
+	void SceneTransformStorage::clear()
+	{
+		mObjects.clear();
+		mParents.clear();
+		mLevelOffsets.clear();
+
+		mLocalPositions.clear();
+		mLocalRotations.clear();
+		mLocalScales.clear();
+
+		mWorldPositions.clear();
+		mWorldRotations.clear();
+		mWorldScales.clear();
+		mWorldTfrms.clear();
+
+		mDirty.clear();
+		mNotifyFlags.clear();
+		mParentNotifyFlags.clear();
+
+		for (auto& so : mModifiedObjects)
+		{
+			if (!so.isDestroyed())
+			{
+				so->mPendingNotifyFlags = 0;
+				so->mDirtyFlags &= ~SceneObject::QueuedForUpdate;
+				so->clearPendingTransformChanged();
+			}
+		}
+
+		mModifiedObjects.clear();
+		mHierarchyDirty = true;
+	}
+
+	void SceneTransformStorage::rebuild(const HSceneObject& root)
+	{
+		mObjects.clear();
+		mParents.clear();
+		mLevelOffsets.clear();
+		mHierarchyDirty = false;
+
+		if (root == nullptr || root.isDestroyed())
+		{
+			mLevelOffsets.push_back(0);
+			return;
+		}
+
+		// Breadth first, so objects end up sorted by depth, and parents always come before their children
+		mObjects.push_back(root);
+		mParents.push_back(NO_PARENT);
+
+		UINT32 levelStart = 0;
+		while (levelStart < (UINT32)mObjects.size())
+		{
+			UINT32 levelEnd = (UINT32)mObjects.size();
+			mLevelOffsets.push_back(levelStart);
+
+			for (UINT32 i = levelStart; i < levelEnd; i++)
+			{
+				for (auto& child : mObjects[i]->mChildren)
+				{
+					mObjects.push_back(child);
+					mParents.push_back(i);
+				}
+			}
+
+			levelStart = levelEnd;
+		}
+
+		UINT32 numObjects = (UINT32)mObjects.size();
+		mLevelOffsets.push_back(numObjects);
+
+		mLocalPositions.resize(numObjects);
+		mLocalRotations.resize(numObjects);
+		mLocalScales.resize(numObjects);
+
+		mWorldPositions.resize(numObjects);
+		mWorldRotations.resize(numObjects);
+		mWorldScales.resize(numObjects);
+		mWorldTfrms.resize(numObjects);
+
+		mDirty.assign(numObjects, Clean);
+		mNotifyFlags.assign(numObjects, 0);
+		mParentNotifyFlags.assign(numObjects, 0);
+
+		for (UINT32 i = 0; i < numObjects; i++)
+		{
+			SceneObject* obj = mObjects[i].get();
+			obj->mTransformIdx = i;
+
+			mLocalPositions[i] = obj->mPosition;
+			mLocalRotations[i] = obj->mRotation;
+			mLocalScales[i] = obj->mScale;
+
+			// Marking as modified just so the world transform is calculated, this is reverted below
+			mDirty[i] = Modified;
+		}
+
+		// Objects with pending modifications are recalculated again during the update, so it doesn't matter if this
+		// uses their new local transforms
+		UINT32 numLevels = (UINT32)mLevelOffsets.size() - 1;
+		for (UINT32 level = 0; level < numLevels; level++)
+			updateRange(mLevelOffsets[level], mLevelOffsets[level + 1]);
+
+		mDirty.assign(numObjects, Clean);
+	}
+
+	void SceneTransformStorage::updateRange(UINT32 start, UINT32 end)
+	{
+		for (UINT32 i = start; i < end; i++)
+		{
+			UINT32 parentIdx = mParents[i];
+			if (parentIdx != NO_PARENT && mDirty[parentIdx] != Clean)
+			{
+				mDirty[i] |= ParentModified;
+				mNotifyFlags[i] |= mNotifyFlags[parentIdx];
+				mParentNotifyFlags[i] |= mNotifyFlags[parentIdx];
+			}
+
+			if (mDirty[i] == Clean)
+				continue;
+
+			// Same as SceneObject::updateWorldTfrm()
+			if (parentIdx != NO_PARENT)
+			{
+				const Quaternion& parentRotation = mWorldRotations[parentIdx];
+				const Vector3& parentScale = mWorldScales[parentIdx];
+
+				mWorldRotations[i] = parentRotation * mLocalRotations[i];
+				mWorldScales[i] = parentScale * mLocalScales[i];
+				mWorldPositions[i] = parentRotation.rotate(parentScale * mLocalPositions[i]);
+				mWorldPositions[i] += mWorldPositions[parentIdx];
+			}
+			else
+			{
+				mWorldRotations[i] = mLocalRotations[i];
+				mWorldPositions[i] = mLocalPositions[i];
+				mWorldScales[i] = mLocalScales[i];
+			}
+
+			mWorldTfrms[i].setTRS(mWorldPositions[i], mWorldRotations[i], mWorldScales[i]);
+		}
+	}
+}
@@ -4,6 +4,7 @@
 #include "BsAnimationClip.h"
 #include "BsSkeletonMask.h"
 #include "BsSkeletonRTTI.h"
+#include "BsSIMD.h"
 
 namespace bs
 {
@@ -84,12 +85,97 @@ namespace bs
 		return *this;
 	}
 
+	/** 
+	 * Local transforms of all bones in a skeleton, stored in structure-of-arrays form (i.e. a separate array for each 
+	 * component). Number of elements is padded to a multiple of four so the data can be processed with SIMD instructions.
+	 */
+	struct SkeletonPoseSoA
+	{
+		SkeletonPoseSoA(UINT8* buffer, UINT32 numBones)
+			:numBones(numBones)
+		{
+			float* data = (float*)buffer;
+			for (UINT32 i = 0; i < 3; i++)
+			{
+				positions[i] = data;
+				data += numBones;
+			}
+
+			for (UINT32 i = 0; i < 4; i++)
+			{
+				rotations[i] = data;
+				data += numBones;
+			}
+
+			for (UINT32 i = 0; i < 3; i++)
+			{
+				scales[i] = data;
+				data += numBones;
+			}
+		}
+
+		/** Returns the number of bytes required for storing a pose with the specified number of bones. */
+		static UINT32 getMemorySize(UINT32 numBones) { return sizeof(float) * 10 * numBones; }
+
+		/** Sets all positions and rotations to zero, and all scales to one. */
+		void reset()
+		{
+			for (UINT32 i = 0; i < 3; i++)
+				memset(positions[i], 0, sizeof(float) * numBones);
+
+			for (UINT32 i = 0; i < 4; i++)
+				memset(rotations[i], 0, sizeof(float) * numBones);
+
+			for (UINT32 i = 0; i < 3; i++)
+			{
+				for (UINT32 j = 0; j < numBones; j++)
+					scales[i][j] = 1.0f;
+			}
+		}
+
+		Vector3 getPosition(UINT32 idx) const { return Vector3(positions[0][idx], positions[1][idx], positions[2][idx]); }
+		Vector3 getScale(UINT32 idx) const { return Vector3(scales[0][idx], scales[1][idx], scales[2][idx]); }
+
+		Quaternion getRotation(UINT32 idx) const 
+		{ 
+			return Quaternion(rotations[3][idx], rotations[0][idx], rotations[1][idx], rotations[2][idx]); 
+		}
+
+		void setPosition(UINT32 idx, const Vector3& value)
+		{
+			positions[0][idx] = value.x;
+			positions[1][idx] = value.y;
+			positions[2][idx] = value.z;
+		}
+
+		void setScale(UINT32 idx, const Vector3& value)
+		{
+			scales[0][idx] = value.x;
+			scales[1][idx] = value.y;
+			scales[2][idx] = value.z;
+		}
+
+		void setRotation(UINT32 idx, const Quaternion& value)
+		{
+			rotations[0][idx] = value.x;
+			rotations[1][idx] = value.y;
+			rotations[2][idx] = value.z;
+			rotations[3][idx] = value.w;
+		}
+
+		float* positions[3];
+		float* rotations[4]; /**< x, y, z, w */
+		float* scales[3];
+		UINT32 numBones;
+	};
+
 	Skeleton::Skeleton()
-		:mInvBindPoses(nullptr), mBoneInfo(nullptr), mNumBones(0)
+		:mNumBones(0), mInvBindPoses(nullptr), mBoneInfo(nullptr), mBoneOrder(nullptr), mBoneDepths(nullptr)
 	{ }
 
 	Skeleton::Skeleton(BONE_DESC* bones, UINT32 numBones)
-		:mInvBindPoses(bs_newN<Matrix4>(numBones)), mBoneInfo(bs_newN<SkeletonBoneInfo>(numBones)), mNumBones(numBones)
+		: mNumBones(numBones), mInvBindPoses(bs_newN<Matrix4>(numBones)), mBoneInfo(bs_newN<SkeletonBoneInfo>(numBones))
+		, mBoneOrder(nullptr), mBoneDepths(nullptr)
 	{
 		for(UINT32 i = 0; i < numBones; i++)
 		{
@@ -97,6 +183,8 @@ namespace bs
 			mBoneInfo[i].name = bones[i].name;
 			mBoneInfo[i].parent = bones[i].parent;
 		}
+
+		buildBoneOrder();
 	}
 
 	Skeleton::~Skeleton()
@@ -106,6 +194,74 @@ namespace bs
 
 		if (mBoneInfo != nullptr)
 			bs_deleteN(mBoneInfo, mNumBones);
+
+		if (mBoneOrder != nullptr)
+			bs_free(mBoneOrder);
+
+		if (mBoneDepths != nullptr)
+			bs_free(mBoneDepths);
+	}
+
+	void Skeleton::buildBoneOrder()
+	{
+		if (mBoneOrder != nullptr)
+			bs_free(mBoneOrder);
+
+		if (mBoneDepths != nullptr)
+			bs_free(mBoneDepths);
+
+		mBoneOrder = (UINT32*)bs_alloc(sizeof(UINT32) * mNumBones);
+		mBoneDepths = (UINT32*)bs_alloc(sizeof(UINT32) * mNumBones);
+
+		// Find the depth of each bone in the hierarchy
+		UINT32* depths = mBoneDepths;
+		for (UINT32 i = 0; i < mNumBones; i++)
+			depths[i] = (UINT32)-1;
+
+		for (UINT32 i = 0; i < mNumBones; i++)
+		{
+			if (depths[i] != (UINT32)-1)
+				continue;
+
+			// Walk up until a root or a bone with known depth is found. Limit the walk in case of a (malformed) cycle.
+			UINT32 depth = 0;
+			UINT32 curBoneIdx = i;
+			while(depth <= mNumBones)
+			{
+				UINT32 parentIdx = mBoneInfo[curBoneIdx].parent;
+				if (parentIdx == (UINT32)-1 || parentIdx >= mNumBones)
+					break;
+
+				if (depths[parentIdx] != (UINT32)-1)
+				{
+					depth += depths[parentIdx] + 1;
+					break;
+				}
+
+				curBoneIdx = parentIdx;
+				depth++;
+			}
+
+			// Assign depths to the walked bones as well
+			curBoneIdx = i;
+			UINT32 curDepth = depth;
+			while(curBoneIdx != (UINT32)-1 && curBoneIdx < mNumBones && depths[curBoneIdx] == (UINT32)-1)
+			{
+				depths[curBoneIdx] = curDepth;
+				curBoneIdx = mBoneInfo[curBoneIdx].parent;
+
+				if (curDepth == 0)
+					break;
+
+				curDepth--;
+			}
+		}
+
+		for (UINT32 i = 0; i < mNumBones; i++)
+			mBoneOrder[i] = i;
+
+		std::stable_sort(mBoneOrder, mBoneOrder + mNumBones, 
+			[depths](UINT32 a, UINT32 b) { return depths[a] < depths[b]; });
 	}
 
 	SPtr<Skeleton> Skeleton::create(BONE_DESC* bones, UINT32 numBones)
@@ -124,6 +280,7 @@ namespace bs
 
 			AnimationState state;
 			state.curves = clip.getCurves();
+			state.compressedCurves = clip.getCompressedCurves();
 			state.boneToCurveMapping = boneToCurveMapping.data();
 			state.loop = loop;
 			state.weight = 1.0f;
@@ -153,18 +310,21 @@ namespace bs
 	}
 
 	void Skeleton::getPose(Matrix4* pose, LocalSkeletonPose& localPose, const SkeletonMask& mask, 
-		const AnimationStateLayer* layers, UINT32 numLayers)
+		const AnimationStateLayer* layers, UINT32 numLayers, UINT32 maxBoneDepth)
 	{
-		// Note: If more performance is required this method could be optimized with vector instructions
-
 		assert(localPose.numBones == mNumBones);
 
-		for(UINT32 i = 0; i < mNumBones; i++)
-		{
-			localPose.positions[i] = Vector3::ZERO;
-			localPose.rotations[i] = Quaternion::ZERO;
-			localPose.scales[i] = Vector3::ONE;
-		}
+		// Pose is blended in structure-of-arrays form so that blending, normalization and matrix construction can be
+		// performed on four bones at once
+		UINT32 numPaddedBones = (UINT32)Math::divideAndRoundUp((int)mNumBones, 4) * 4;
+		UINT32 poseSize = SkeletonPoseSoA::getMemorySize(numPaddedBones);
+
+		UINT8* scratch = (UINT8*)bs_stack_alloc(poseSize * 2);
+		SkeletonPoseSoA blendedPose(scratch, numPaddedBones);
+		SkeletonPoseSoA sampledPose(scratch + poseSize, numPaddedBones);
+
+		blendedPose.reset();
+		sampledPose.reset();
 
 		// Note: For a possible performance improvement consider keeping an array of only active (non-disabled) bones and
 		// just iterate over them without mask checks. Possibly also a list of active curve mappings to avoid those checks
@@ -197,139 +357,287 @@ namespace bs
 				if (Math::approxEquals(normWeight, 0.0f))
 					continue;
 
+				// Decode all the keys required for this time in a single pass, if the clip is compressed
+				const CompressedAnimationCurves* compressedCurves = state.compressedCurves.get();
+				if (compressedCurves != nullptr)
+					compressedCurves->seek(state.time, state.loop, state.compressedCursor);
+
+				// Sample the curves. Bones without a curve get a neutral sample that leaves the blended value unchanged.
 				for (UINT32 k = 0; k < mNumBones; k++)
 				{
-					if (!mask.isEnabled(k))
-						continue;
-
 					const AnimationCurveMapping& mapping = state.boneToCurveMapping[k];
+					bool isEnabled = mask.isEnabled(k) && mBoneDepths[k] <= maxBoneDepth;
+
 					UINT32 curveIdx = mapping.position;
-					if (curveIdx != (UINT32)-1)
+					if (isEnabled && curveIdx != (UINT32)-1)
 					{
-						const TAnimationCurve<Vector3>& curve = state.curves->position[curveIdx].curve;
-						localPose.positions[k] += curve.evaluate(state.time, state.positionCaches[curveIdx], state.loop) * normWeight;
+						Vector3 value;
+						if (compressedCurves != nullptr)
+							value = compressedCurves->evaluatePosition(curveIdx, state.compressedCursor);
+						else
+						{
+							const TAnimationCurve<Vector3>& curve = state.curves->position[curveIdx].curve;
+							value = curve.evaluate(state.time, state.positionCaches[curveIdx], state.loop);
+						}
 
+						sampledPose.setPosition(k, value);
 						localPose.hasOverride[k] = false;
 					}
-				}
+					else
+						sampledPose.setPosition(k, Vector3::ZERO);
 
-				for (UINT32 k = 0; k < mNumBones; k++)
-				{
-					if (!mask.isEnabled(k))
-						continue;
-
-					const AnimationCurveMapping& mapping = state.boneToCurveMapping[k];
-					UINT32 curveIdx = mapping.scale;
-					if (curveIdx != (UINT32)-1)
+					curveIdx = mapping.scale;
+					if (isEnabled && curveIdx != (UINT32)-1)
 					{
-						const TAnimationCurve<Vector3>& curve = state.curves->scale[curveIdx].curve;
-						localPose.scales[k] *= curve.evaluate(state.time, state.scaleCaches[curveIdx], state.loop) * normWeight;
+						Vector3 value;
+						if (compressedCurves != nullptr)
+							value = compressedCurves->evaluateScale(curveIdx, state.compressedCursor);
+						else
+						{
+							const TAnimationCurve<Vector3>& curve = state.curves->scale[curveIdx].curve;
+							value = curve.evaluate(state.time, state.scaleCaches[curveIdx], state.loop);
+						}
 
+						sampledPose.setScale(k, value * normWeight);
 						localPose.hasOverride[k] = false;
 					}
-				}
+					else
+						sampledPose.setScale(k, Vector3::ONE);
 
-				if(layer.additive)
-				{
-					for (UINT32 k = 0; k < mNumBones; k++)
+					curveIdx = mapping.rotation;
+					if (isEnabled && curveIdx != (UINT32)-1)
 					{
-						if (!mask.isEnabled(k))
-							continue;
-
-						const AnimationCurveMapping& mapping = state.boneToCurveMapping[k];
-						UINT32 curveIdx = mapping.rotation;
-						if (curveIdx != (UINT32)-1)
+						Quaternion value;
+						if (compressedCurves != nullptr)
+							value = compressedCurves->evaluateRotation(curveIdx, state.compressedCursor);
+						else
 						{
-							bool isAssigned = localPose.rotations[k].w != 0.0f;
-							if (!isAssigned)
-								localPose.rotations[k] = Quaternion::IDENTITY;
-
 							const TAnimationCurve<Quaternion>& curve = state.curves->rotation[curveIdx].curve;
+							value = curve.evaluate(state.time, state.rotationCaches[curveIdx], state.loop);
+						}
 
-							Quaternion value = curve.evaluate(state.time, state.rotationCaches[curveIdx], state.loop);
-							value = Quaternion::lerp(normWeight, Quaternion::IDENTITY, value);
+						if(layer.additive)
+						{
+							Quaternion rotation = blendedPose.getRotation(k);
 
-							localPose.rotations[k] *= value;
-							localPose.hasOverride[k] = false;
+							bool isAssigned = rotation.w != 0.0f;
+							if (!isAssigned)
+								rotation = Quaternion::IDENTITY;
+
+							rotation *= Quaternion::lerp(normWeight, Quaternion::IDENTITY, value);
+							blendedPose.setRotation(k, rotation);
 						}
+						else
+							sampledPose.setRotation(k, value);
+
+						localPose.hasOverride[k] = false;
 					}
+					else
+						sampledPose.setRotation(k, Quaternion::ZERO);
 				}
-				else
+
+				simd::float4 weight = simd::set(normWeight);
+				for (UINT32 k = 0; k < numPaddedBones; k += 4)
 				{
-					for (UINT32 k = 0; k < mNumBones; k++)
+					// Positions are blended as a weighted sum
+					for(UINT32 l = 0; l < 3; l++)
+					{
+						simd::float4 value = simd::load(sampledPose.positions[l] + k);
+						simd::float4 blended = simd::load(blendedPose.positions[l] + k);
+
+						simd::store(blendedPose.positions[l] + k, simd::madd(value, weight, blended));
+					}
+
+					// Scales are multiplied (weight is already applied)
+					for(UINT32 l = 0; l < 3; l++)
 					{
-						if (!mask.isEnabled(k))
-							continue;
+						simd::float4 value = simd::load(sampledPose.scales[l] + k);
+						simd::float4 blended = simd::load(blendedPose.scales[l] + k);
 
-						const AnimationCurveMapping& mapping = state.boneToCurveMapping[k];
-						UINT32 curveIdx = mapping.rotation;
-						if (curveIdx != (UINT32)-1)
+						simd::store(blendedPose.scales[l] + k, simd::mul(value, blended));
+					}
+
+					// Rotations are blended as a weighted sum, ensuring the sampled rotation is in the same hemisphere as
+					// the accumulated rotation. Result is normalized at the end (nlerp).
+					if(!layer.additive)
+					{
+						simd::float4 value[4];
+						simd::float4 blended[4];
+						simd::float4 dot = simd::zero();
+						for(UINT32 l = 0; l < 4; l++)
 						{
-							const TAnimationCurve<Quaternion>& curve = state.curves->rotation[curveIdx].curve;
-							Quaternion value = curve.evaluate(state.time, state.rotationCaches[curveIdx], state.loop) * normWeight;
+							value[l] = simd::mul(simd::load(sampledPose.rotations[l] + k), weight);
+							blended[l] = simd::load(blendedPose.rotations[l] + k);
 
-							if (value.dot(localPose.rotations[k]) < 0.0f)
-								value = -value;
-							
-							localPose.rotations[k] += value;
-							localPose.hasOverride[k] = false;
+							dot = simd::madd(value[l], blended[l], dot);
+						}
+
+						simd::float4 flip = simd::cmpLess(dot, simd::zero());
+						for(UINT32 l = 0; l < 4; l++)
+						{
+							simd::float4 signedValue = simd::select(flip, simd::sub(simd::zero(), value[l]), value[l]);
+							simd::store(blendedPose.rotations[l] + k, simd::add(blended[l], signedValue));
 						}
 					}
 				}
 			}
 		}
 
-		// Calculate local pose matrices
-		UINT32 isGlobalBytes = sizeof(bool) * mNumBones;
-		bool* isGlobal = (bool*)bs_stack_alloc(isGlobalBytes);
-		memset(isGlobal, 0, isGlobalBytes);
+		// Normalize rotations, use identity for bones that had no rotation assigned
+		for(UINT32 i = 0; i < numPaddedBones; i += 4)
+		{
+			simd::float4 x = simd::load(blendedPose.rotations[0] + i);
+			simd::float4 y = simd::load(blendedPose.rotations[1] + i);
+			simd::float4 z = simd::load(blendedPose.rotations[2] + i);
+			simd::float4 w = simd::load(blendedPose.rotations[3] + i);
+
+			simd::float4 sqrdLength = simd::mul(x, x);
+			sqrdLength = simd::madd(y, y, sqrdLength);
+			sqrdLength = simd::madd(z, z, sqrdLength);
+			sqrdLength = simd::madd(w, w, sqrdLength);
+
+			simd::float4 invLength = simd::div(simd::set(1.0f), simd::sqrt(sqrdLength));
+			simd::float4 isAssigned = simd::cmpNotEqual(w, simd::zero());
+
+			simd::store(blendedPose.rotations[0] + i, simd::select(isAssigned, simd::mul(x, invLength), simd::zero()));
+			simd::store(blendedPose.rotations[1] + i, simd::select(isAssigned, simd::mul(y, invLength), simd::zero()));
+			simd::store(blendedPose.rotations[2] + i, simd::select(isAssigned, simd::mul(z, invLength), simd::zero()));
+			simd::store(blendedPose.rotations[3] + i, simd::select(isAssigned, simd::mul(w, invLength), simd::set(1.0f)));
+		}
 
+		// Output the local pose. Bones past the maximum depth weren't evaluated and keep their existing local transform.
 		for(UINT32 i = 0; i < mNumBones; i++)
 		{
-			bool isAssigned = localPose.rotations[i].w != 0.0f;
-			if (!isAssigned)
-				localPose.rotations[i] = Quaternion::IDENTITY;
-			else
-				localPose.rotations[i].normalize();
-
-			if (localPose.hasOverride[i])
+			if(mBoneDepths[i] > maxBoneDepth)
 			{
-				isGlobal[i] = true;
+				blendedPose.setPosition(i, localPose.positions[i]);
+				blendedPose.setRotation(i, localPose.rotations[i]);
+				blendedPose.setScale(i, localPose.scales[i]);
 				continue;
 			}
 
-			pose[i] = Matrix4::TRS(localPose.positions[i], localPose.rotations[i], localPose.scales[i]);
+			localPose.positions[i] = blendedPose.getPosition(i);
+			localPose.rotations[i] = blendedPose.getRotation(i);
+			localPose.scales[i] = blendedPose.getScale(i);
 		}
 
-		// Calculate global poses
-		// Note: For a possible performance improvement consider sorting bones in such order so that parents (and overrides)
-		// always come before children, we no isGlobal check is needed.
-		std::function<void(UINT32)> calcGlobal = [&](UINT32 boneIdx)
+		calculateGlobalPose(pose, blendedPose, localPose.hasOverride);
+		bs_stack_free(scratch);
+	}
+
+	void Skeleton::getPose(Matrix4* pose, LocalSkeletonPose& localPose, const LocalSkeletonPose& from, 
+		const LocalSkeletonPose& to, float t)
+	{
+		assert(localPose.numBones == mNumBones);
+
+		UINT32 numPaddedBones = (UINT32)Math::divideAndRoundUp((int)mNumBones, 4) * 4;
+		UINT32 poseSize = SkeletonPoseSoA::getMemorySize(numPaddedBones);
+
+		UINT8* scratch = (UINT8*)bs_stack_alloc(poseSize);
+		SkeletonPoseSoA interpolatedPose(scratch, numPaddedBones);
+		interpolatedPose.reset();
+
+		for(UINT32 i = 0; i < mNumBones; i++)
 		{
-			UINT32 parentBoneIdx = mBoneInfo[boneIdx].parent;
-			if (parentBoneIdx == (UINT32)-1)
-			{
-				isGlobal[boneIdx] = true;
-				return;
-			}
+			localPose.positions[i] = Vector3::lerp(t, from.positions[i], to.positions[i]);
+			localPose.rotations[i] = Quaternion::lerp(t, from.rotations[i], to.rotations[i]);
+			localPose.scales[i] = Vector3::lerp(t, from.scales[i], to.scales[i]);
 
-			if (!isGlobal[parentBoneIdx])
-				calcGlobal(parentBoneIdx);
+			interpolatedPose.setPosition(i, localPose.positions[i]);
+			interpolatedPose.setRotation(i, localPose.rotations[i]);
+			interpolatedPose.setScale(i, localPose.scales[i]);
+		}
 
-			pose[boneIdx] = pose[parentBoneIdx] * pose[boneIdx];
-			isGlobal[boneIdx] = true;
-		};
+		calculateGlobalPose(pose, interpolatedPose, localPose.hasOverride);
+		bs_stack_free(scratch);
+	}
 
-		for (UINT32 i = 0; i < mNumBones; i++)
+	void Skeleton::calculateGlobalPose(Matrix4* pose, const SkeletonPoseSoA& localPose, const bool* hasOverride) const
+	{
+		UINT32 numPaddedBones = localPose.numBones;
+
+		// Calculate local pose matrices, four at a time
+		for(UINT32 i = 0; i < numPaddedBones; i += 4)
 		{
-			if (!isGlobal[i])
-				calcGlobal(i);
+			simd::float4 x = simd::load(localPose.rotations[0] + i);
+			simd::float4 y = simd::load(localPose.rotations[1] + i);
+			simd::float4 z = simd::load(localPose.rotations[2] + i);
+			simd::float4 w = simd::load(localPose.rotations[3] + i);
+
+			simd::float4 tx = simd::add(x, x);
+			simd::float4 ty = simd::add(y, y);
+			simd::float4 tz = simd::add(z, z);
+			simd::float4 twx = simd::mul(tx, w);
+			simd::float4 twy = simd::mul(ty, w);
+			simd::float4 twz = simd::mul(tz, w);
+			simd::float4 txx = simd::mul(tx, x);
+			simd::float4 txy = simd::mul(ty, x);
+			simd::float4 txz = simd::mul(tz, x);
+			simd::float4 tyy = simd::mul(ty, y);
+			simd::float4 tyz = simd::mul(tz, y);
+			simd::float4 tzz = simd::mul(tz, z);
+
+			simd::float4 one = simd::set(1.0f);
+			simd::float4 scaleX = simd::load(localPose.scales[0] + i);
+			simd::float4 scaleY = simd::load(localPose.scales[1] + i);
+			simd::float4 scaleZ = simd::load(localPose.scales[2] + i);
+
+			simd::float4 rows[3][4];
+			rows[0][0] = simd::mul(scaleX, simd::sub(one, simd::add(tyy, tzz)));
+			rows[0][1] = simd::mul(scaleY, simd::sub(txy, twz));
+			rows[0][2] = simd::mul(scaleZ, simd::add(txz, twy));
+			rows[0][3] = simd::load(localPose.positions[0] + i);
+
+			rows[1][0] = simd::mul(scaleX, simd::add(txy, twz));
+			rows[1][1] = simd::mul(scaleY, simd::sub(one, simd::add(txx, tzz)));
+			rows[1][2] = simd::mul(scaleZ, simd::sub(tyz, twx));
+			rows[1][3] = simd::load(localPose.positions[1] + i);
+
+			rows[2][0] = simd::mul(scaleX, simd::sub(txz, twy));
+			rows[2][1] = simd::mul(scaleY, simd::add(tyz, twx));
+			rows[2][2] = simd::mul(scaleZ, simd::sub(one, simd::add(txx, tyy)));
+			rows[2][3] = simd::load(localPose.positions[2] + i);
+
+			// Convert from a row per component to a row per bone
+			for(UINT32 j = 0; j < 3; j++)
+				simd::transpose(rows[j][0], rows[j][1], rows[j][2], rows[j][3]);
+
+			simd::float4 lastRow = simd::set(0.0f, 0.0f, 0.0f, 1.0f);
+			for(UINT32 j = 0; j < 4; j++)
+			{
+				UINT32 boneIdx = i + j;
+				if (boneIdx >= mNumBones || hasOverride[boneIdx])
+					continue;
+
+				float* dst = &pose[boneIdx][0][0];
+				simd::store(dst + 0, rows[0][j]);
+				simd::store(dst + 4, rows[1][j]);
+				simd::store(dst + 8, rows[2][j]);
+				simd::store(dst + 12, lastRow);
+			}
 		}
 
+		// Calculate global poses. Bones are sorted so parents always come before children, so a parent's pose is always 
+		// global by the time its children are processed. Overriden bones are already in global space.
 		for (UINT32 i = 0; i < mNumBones; i++)
-			pose[i] = pose[i] * mInvBindPoses[i];
+		{
+			UINT32 boneIdx = mBoneOrder[i];
+			if (hasOverride[boneIdx])
+				continue;
 
-		bs_stack_free(isGlobal);
+			UINT32 parentBoneIdx = mBoneInfo[boneIdx].parent;
+			if (parentBoneIdx == (UINT32)-1)
+				continue;
+
+			Matrix4 local = pose[boneIdx];
+			simd::mulMatrix(&pose[parentBoneIdx][0][0], &local[0][0], &pose[boneIdx][0][0]);
+		}
+
+		for (UINT32 i = 0; i < mNumBones; i++)
+		{
+			Matrix4 global = pose[i];
+			simd::mulMatrix(&global[0][0], &mInvBindPoses[i][0][0], &pose[i][0][0]);
+		}
 	}
 
 	UINT32 Skeleton::getRootBoneIndex() const
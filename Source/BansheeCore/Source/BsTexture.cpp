@@ -9,6 +9,7 @@
 #include "BsAsyncOp.h"
 #include "BsResources.h"
 #include "BsPixelUtil.h"
+#include "BsTextureStreamingManager.h"
 
 namespace bs 
 {
@@ -112,6 +113,11 @@ namespace bs
 
 		if ((mProperties.getUsage() & TU_CPUCACHED) == 0)
 			mInitData = nullptr;
+		else if (mInitData != nullptr)
+		{
+			// Data lives as long as the texture, so it shouldn't keep referencing the file it was loaded from
+			mInitData->copyToInternalBuffer();
+		}
 
 		return coreObj;
 	}
@@ -158,6 +164,22 @@ namespace bs
 			data, std::placeholders::_1));
 	}
 
+	void Texture::getMemoryUsage(UINT64& cpuBytes, UINT64& gpuBytes) const
+	{
+		gpuBytes = 0;
+		for (UINT32 i = 0; i <= mProperties.getNumMipmaps(); i++)
+		{
+			UINT32 width = std::max(1U, mProperties.getWidth() >> i);
+			UINT32 height = std::max(1U, mProperties.getHeight() >> i);
+			UINT32 depth = std::max(1U, mProperties.getDepth() >> i);
+
+			gpuBytes += PixelUtil::getMemorySize(width, height, depth, mProperties.getFormat());
+		}
+
+		gpuBytes *= mProperties.getNumFaces();
+		cpuBytes = (mProperties.getUsage() & TU_CPUCACHED) != 0 ? gpuBytes : 0;
+	}
+
 	UINT32 Texture::calculateSize() const
 	{
 		return mProperties.getNumFaces() * PixelUtil::getMemorySize(mProperties.getWidth(),
@@ -329,9 +351,15 @@ namespace bs
 	SPtr<Texture> Texture::NORMAL;
 
 	Texture::Texture(const TEXTURE_DESC& desc, const SPtr<PixelData>& initData, GpuDeviceFlags deviceMask)
-		:mProperties(desc), mInitData(initData)
+		:mProperties(desc), mInitData(initData), mFirstLoadedMip(0)
 	{ }
 
+	Texture::~Texture()
+	{
+		if (mProperties.isStreaming() && TextureStreamingManager::isStarted())
+			TextureStreamingManager::instance()._unregisterTexture(this);
+	}
+
 	void Texture::initialize()
 	{
 		if (mInitData != nullptr)
@@ -511,6 +539,21 @@ namespace bs
 		return iterFind->second;
 	}
 
+	TextureSurface Texture::getLoadedSurface(const TextureSurface& surface) const
+	{
+		if (mFirstLoadedMip <= surface.mipLevel)
+			return surface;
+
+		UINT32 numMips = mProperties.getNumMipmaps() + 1;
+		UINT32 lastMip = surface.numMipLevels == 0 ? numMips : std::min(surface.mipLevel + surface.numMipLevels, numMips);
+
+		TextureSurface output = surface;
+		output.mipLevel = std::min(mFirstLoadedMip, numMips - 1);
+		output.numMipLevels = lastMip > output.mipLevel ? lastMip - output.mipLevel : 1;
+
+		return output;
+	}
+
 	/************************************************************************/
 	/* 								STATICS	                      			*/
 	/************************************************************************/
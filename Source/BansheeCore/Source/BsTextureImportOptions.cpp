@@ -7,7 +7,7 @@ namespace bs
 {
 	TextureImportOptions::TextureImportOptions()
 		: mFormat(PF_R8G8B8A8), mGenerateMips(false), mMaxMip(0), mCPUCached(false), mSRGB(false), mCubemap(false)
-		, mCubemapSourceType(CubemapSourceType::Faces)
+		, mCubemapSourceType(CubemapSourceType::Faces), mStreaming(false)
 	{ }
 
 	SPtr<TextureImportOptions> TextureImportOptions::create()
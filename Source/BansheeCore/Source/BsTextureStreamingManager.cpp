@@ -0,0 +1,381 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#include "BsTextureStreamingManager.h"
+#include "BsTexture.h"
+#include "BsPixelData.h"
+#include "BsPixelUtil.h"
+#include "BsTaskScheduler.h"
+#include "BsFileSystem.h"
+#include "BsDataStream.h"
+#include "BsDebug.h"
+
+namespace bs
+{
+	namespace ct
+	{
+	/** Textures whose largest dimension is at or below this size are always fully loaded. */
+	static const UINT32 MAX_ALWAYS_LOADED_SIZE = 128;
+
+	/** Number of frames a texture keeps its wanted detail after it was last requested. */
+	static const UINT64 DISCARD_DELAY_FRAMES = 60;
+
+	/** Maximum number of mip levels being loaded at once. */
+	static const UINT32 MAX_PENDING_LOADS = 8;
+
+	/** Default maximum size of the loaded streamed mip levels, in bytes. */
+	static const UINT64 DEFAULT_MAX_LOADED_BYTES = 256 * 1024 * 1024;
+
+	TextureStreamingManager::TextureStreamingManager()
+		: mMaxLoadedBytes(DEFAULT_MAX_LOADED_BYTES), mLoadedBytes(0), mFrameIdx(0), mNumStreamedIn(0), mBytesStreamedIn(0)
+		, mNumDiscarded(0)
+	{ }
+
+	TextureStreamingManager::~TextureStreamingManager()
+	{
+		for (auto& entry : mTextures)
+		{
+			if (entry.loadTask != nullptr)
+				entry.loadTask->wait();
+		}
+	}
+
+	void TextureStreamingManager::_registerTexture(const SPtr<Texture>& texture, const Vector<SPtr<PixelData>>& pixelData,
+		UINT32 firstLoadedMip)
+	{
+		Texture* texturePtr = texture.get();
+		if (firstLoadedMip == 0 || mTextureLookup.find(texturePtr) != mTextureLookup.end())
+			return;
+
+		const TextureProperties& props = texture->getProperties();
+		UINT32 numMips = props.getNumMipmaps() + 1;
+		UINT32 numFaces = props.getNumFaces();
+
+		StreamedTexture entry;
+		entry.texture = texturePtr;
+		entry.subresources.resize(numFaces * numMips);
+		entry.firstLoadedMip = firstLoadedMip;
+		entry.firstAlwaysLoadedMip = firstLoadedMip;
+		entry.firstLoadableMip = 0;
+		entry.requestedMip = firstLoadedMip;
+		entry.wantedMip = firstLoadedMip;
+		entry.lastRequestFrame = 0;
+
+		// Remember where the data of the streamed levels comes from, and release it if it can be read again later
+		for (UINT32 face = 0; face < numFaces; face++)
+		{
+			for (UINT32 mip = 0; mip < firstLoadedMip; mip++)
+			{
+				UINT32 subresourceIdx = face * numMips + mip;
+				if (subresourceIdx >= (UINT32)pixelData.size() || pixelData[subresourceIdx] == nullptr)
+					continue;
+
+				const SPtr<PixelData>& data = pixelData[subresourceIdx];
+				StreamedSubresource& subresource = entry.subresources[subresourceIdx];
+				subresource.size = data->getConsecutiveSize();
+
+				if (data->getSourceFileLocation(subresource.filePath, subresource.offset))
+				{
+					subresource.pixelData = bs_shared_ptr_new<PixelData>(*data);
+					subresource.pixelData->setExternalBuffer(nullptr);
+				}
+				else
+				{
+					data->copyToInternalBuffer();
+					subresource.pixelData = data;
+				}
+			}
+		}
+
+		mTextureLookup[texturePtr] = (UINT32)mTextures.size();
+		mTextures.push_back(entry);
+
+		texture->_setFirstLoadedMip(firstLoadedMip);
+	}
+
+	void TextureStreamingManager::_unregisterTexture(Texture* texture)
+	{
+		auto iterFind = mTextureLookup.find(texture);
+		if (iterFind == mTextureLookup.end())
+			return;
+
+		UINT32 idx = iterFind->second;
+		StreamedTexture& entry = mTextures[idx];
+
+		const TextureProperties& props = texture->getProperties();
+		UINT32 firstCountedMip = entry.firstLoadedMip;
+		if (entry.loadTask != nullptr)
+		{
+			// Bytes for the level being loaded are reserved when the load starts
+			entry.loadTask->wait();
+			firstCountedMip--;
+		}
+
+		for (UINT32 mip = firstCountedMip; mip < entry.firstAlwaysLoadedMip; mip++)
+			mLoadedBytes -= getMipSize(props, mip);
+
+		mTextureLookup.erase(iterFind);
+		if (idx != (UINT32)mTextures.size() - 1)
+		{
+			mTextures[idx] = std::move(mTextures.back());
+			mTextureLookup[mTextures[idx].texture] = idx;
+		}
+
+		mTextures.pop_back();
+	}
+
+	void TextureStreamingManager::requestMip(Texture* texture, UINT32 mipLevel)
+	{
+		auto iterFind = mTextureLookup.find(texture);
+		if (iterFind == mTextureLookup.end())
+			return;
+
+		StreamedTexture& entry = mTextures[iterFind->second];
+		if (entry.lastRequestFrame != mFrameIdx)
+		{
+			entry.requestedMip = mipLevel;
+			entry.lastRequestFrame = mFrameIdx;
+		}
+		else
+			entry.requestedMip = std::min(entry.requestedMip, mipLevel);
+	}
+
+	void TextureStreamingManager::_update()
+	{
+		UINT32 numPendingLoads = 0;
+		for (auto& entry : mTextures)
+		{
+			if (entry.lastRequestFrame == mFrameIdx)
+				entry.wantedMip = std::min(entry.requestedMip, entry.firstAlwaysLoadedMip);
+			else if ((mFrameIdx - entry.lastRequestFrame) > DISCARD_DELAY_FRAMES)
+				entry.wantedMip = entry.firstAlwaysLoadedMip;
+
+			if (entry.loadTask != nullptr)
+			{
+				if (entry.loadTask->isComplete())
+					finishLoad(entry);
+				else
+					numPendingLoads++;
+			}
+		}
+
+		// Find textures missing detail they need, most missing levels first
+		Vector<UINT32> candidates;
+		for (UINT32 i = 0; i < (UINT32)mTextures.size(); i++)
+		{
+			const StreamedTexture& entry = mTextures[i];
+			if (entry.loadTask == nullptr && entry.wantedMip < entry.firstLoadedMip && 
+				entry.firstLoadableMip < entry.firstLoadedMip)
+			{
+				candidates.push_back(i);
+			}
+		}
+
+		std::sort(candidates.begin(), candidates.end(),
+			[&](UINT32 a, UINT32 b)
+		{
+			const StreamedTexture& entryA = mTextures[a];
+			const StreamedTexture& entryB = mTextures[b];
+
+			UINT32 missingA = entryA.firstLoadedMip - entryA.wantedMip;
+			UINT32 missingB = entryB.firstLoadedMip - entryB.wantedMip;
+			if (missingA != missingB)
+				return missingA > missingB;
+
+			// Prefer smaller levels, as they're quicker to load
+			return entryA.firstLoadedMip > entryB.firstLoadedMip;
+		});
+
+		for (auto& idx : candidates)
+		{
+			if (numPendingLoads >= MAX_PENDING_LOADS)
+				break;
+
+			StreamedTexture& entry = mTextures[idx];
+			const TextureProperties& props = entry.texture->getProperties();
+
+			UINT32 mip = entry.firstLoadedMip - 1;
+			UINT64 mipSize = getMipSize(props, mip);
+
+			// Level can never fit, don't discard other levels trying to make space for it
+			if (mipSize > mMaxLoadedBytes)
+				continue;
+
+			bool hasSpace = true;
+			while (mLoadedBytes + mipSize > mMaxLoadedBytes)
+			{
+				if (!discardMip(&entry))
+				{
+					hasSpace = false;
+					break;
+				}
+			}
+
+			if (!hasSpace)
+				continue;
+
+			Vector<StreamedSubresource> faceSources;
+			UINT32 numMips = props.getNumMipmaps() + 1;
+			for (UINT32 face = 0; face < props.getNumFaces(); face++)
+				faceSources.push_back(entry.subresources[face * numMips + mip]);
+
+			// Read the data from disk on a worker, so the core thread only needs to upload it
+			SPtr<Vector<SPtr<PixelData>>> loadedData = bs_shared_ptr_new<Vector<SPtr<PixelData>>>(faceSources.size());
+			auto loadWorker = [faceSources, loadedData]()
+			{
+				for (UINT32 i = 0; i < (UINT32)faceSources.size(); i++)
+				{
+					const StreamedSubresource& source = faceSources[i];
+					if (source.pixelData == nullptr)
+						continue;
+
+					if (source.filePath.isEmpty())
+					{
+						(*loadedData)[i] = source.pixelData;
+						continue;
+					}
+
+					SPtr<DataStream> stream = FileSystem::openFile(source.filePath);
+					if (stream == nullptr)
+						continue;
+
+					stream->seek((size_t)source.offset);
+
+					SPtr<PixelData> pixelData = bs_shared_ptr_new<PixelData>(*source.pixelData);
+					pixelData->allocateInternalBuffer(source.size);
+
+					if (stream->read(pixelData->getData(), source.size) == source.size)
+						(*loadedData)[i] = pixelData;
+				}
+			};
+
+			entry.loadedData = loadedData;
+			entry.loadTask = Task::create("TextureMipLoad", loadWorker, TaskPriority::Low);
+			TaskScheduler::instance().addTask(entry.loadTask);
+
+			mLoadedBytes += mipSize;
+			numPendingLoads++;
+		}
+
+		mFrameIdx++;
+	}
+
+	void TextureStreamingManager::finishLoad(StreamedTexture& entry)
+	{
+		SPtr<Vector<SPtr<PixelData>>> loadedData = entry.loadedData;
+		entry.loadTask = nullptr;
+		entry.loadedData = nullptr;
+
+		const TextureProperties& props = entry.texture->getProperties();
+		UINT32 numMips = props.getNumMipmaps() + 1;
+		UINT32 numFaces = props.getNumFaces();
+		UINT32 mip = entry.firstLoadedMip - 1;
+
+		for (UINT32 face = 0; face < numFaces; face++)
+		{
+			const StreamedSubresource& source = entry.subresources[face * numMips + mip];
+			if (source.pixelData != nullptr && (*loadedData)[face] == nullptr)
+			{
+				LOGWRN("Unable to read mip level " + toString(mip) + " of a streamed texture from \"" + 
+					source.filePath.toString() + "\". More detailed levels of the texture won't be streamed in.");
+
+				// Release the space reserved when the load started
+				mLoadedBytes -= getMipSize(props, mip);
+				entry.firstLoadableMip = mip + 1;
+				return;
+			}
+		}
+
+		for (UINT32 face = 0; face < numFaces; face++)
+		{
+			const SPtr<PixelData>& pixelData = (*loadedData)[face];
+			if (pixelData != nullptr)
+				entry.texture->writeData(*pixelData, mip, face);
+		}
+
+		entry.firstLoadedMip = mip;
+		entry.texture->_setFirstLoadedMip(mip);
+
+		mNumStreamedIn++;
+		mBytesStreamedIn += getMipSize(props, mip);
+	}
+
+	bool TextureStreamingManager::discardMip(const StreamedTexture* exclude)
+	{
+		StreamedTexture* discardEntry = nullptr;
+		for (auto& entry : mTextures)
+		{
+			if (&entry == exclude || entry.loadTask != nullptr || entry.firstLoadedMip >= entry.firstAlwaysLoadedMip)
+				continue;
+
+			// Levels needed by textures visible this frame are only discarded if they're more detailed than needed
+			bool visible = entry.lastRequestFrame == mFrameIdx;
+			if (visible && entry.firstLoadedMip >= entry.wantedMip)
+				continue;
+
+			if (discardEntry == nullptr || entry.lastRequestFrame < discardEntry->lastRequestFrame)
+				discardEntry = &entry;
+		}
+
+		if (discardEntry == nullptr)
+			return false;
+
+		const TextureProperties& props = discardEntry->texture->getProperties();
+		UINT32 mip = discardEntry->firstLoadedMip;
+
+		discardEntry->firstLoadedMip = mip + 1;
+		discardEntry->texture->_setFirstLoadedMip(mip + 1);
+
+		mLoadedBytes -= getMipSize(props, mip);
+		mNumDiscarded++;
+
+		return true;
+	}
+
+	TextureStreamingStats TextureStreamingManager::getStats() const
+	{
+		TextureStreamingStats stats;
+		stats.numTextures = (UINT32)mTextures.size();
+		stats.maxLoadedBytes = mMaxLoadedBytes;
+		stats.loadedBytes = mLoadedBytes;
+		stats.numPendingLoads = 0;
+		stats.numStreamedIn = mNumStreamedIn;
+		stats.bytesStreamedIn = mBytesStreamedIn;
+		stats.numDiscarded = mNumDiscarded;
+
+		for (auto& entry : mTextures)
+		{
+			if (entry.loadTask != nullptr)
+				stats.numPendingLoads++;
+		}
+
+		return stats;
+	}
+
+	UINT32 TextureStreamingManager::getInitialLoadedMip(const TextureProperties& props)
+	{
+		if (!props.isStreaming() || props.getTextureType() == TEX_TYPE_3D)
+			return 0;
+
+		UINT32 numMips = props.getNumMipmaps() + 1;
+		for (UINT32 mip = 0; mip < numMips; mip++)
+		{
+			UINT32 width = std::max(1U, props.getWidth() >> mip);
+			UINT32 height = std::max(1U, props.getHeight() >> mip);
+
+			if (std::max(width, height) <= MAX_ALWAYS_LOADED_SIZE)
+				return mip;
+		}
+
+		return numMips - 1;
+	}
+
+	UINT64 TextureStreamingManager::getMipSize(const TextureProperties& props, UINT32 mipLevel)
+	{
+		UINT32 width, height, depth;
+		PixelUtil::getSizeForMipLevel(props.getWidth(), props.getHeight(), props.getDepth(), mipLevel,
+			width, height, depth);
+
+		return (UINT64)PixelUtil::getMemorySize(width, height, depth, props.getFormat()) * props.getNumFaces();
+	}
+	}
+}
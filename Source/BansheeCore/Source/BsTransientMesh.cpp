@@ -30,10 +30,10 @@ namespace bs
 
 	SPtr<ct::CoreObject> TransientMesh::createCore() const
 	{
-		ct::TransientMesh* core = new (bs_alloc<ct::TransientMesh>()) ct::TransientMesh(
+		ct::TransientMesh* core = new (bs_alloc<ct::TransientMesh, PoolAlloc>()) ct::TransientMesh(
 			mParentHeap->getCore(), mId, mProperties.mNumVertices, mProperties.mNumIndices, mProperties.mSubMeshes);
 
-		SPtr<ct::CoreObject> meshCore = bs_shared_ptr<ct::TransientMesh>(core);
+		SPtr<ct::CoreObject> meshCore = bs_shared_ptr<ct::TransientMesh, PoolAlloc, PoolAlloc>(core);
 		meshCore->_setThisPtr(meshCore);
 
 		return meshCore;
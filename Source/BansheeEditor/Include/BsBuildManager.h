@@ -6,6 +6,7 @@
 #include "BsIReflectable.h"
 #include "BsModule.h"
 #include "BsPlatformInfo.h"
+#include "BsResourceArchive.h"
 
 namespace bs
 {
@@ -90,6 +91,18 @@ namespace bs
 		/**	Clears currently active build settings. */
 		void clear();
 
+		/**
+		 * Packs the provided resources into a single resource archive, which the game can register with Resources to load
+		 * resources by their UUIDs, or by paths a registered manifest maps to those UUIDs.
+		 *
+		 * @param[in]	outFile			Path of the archive to create.
+		 * @param[in]	resources		List of resource UUIDs and paths to the saved resource files.
+		 * @param[in]	compression		Compression to apply to resource data in the archive.
+		 * @return						True if all resources were added to the archive.
+		 */
+		bool createResourceArchive(const Path& outFile, const Vector<std::pair<String, Path>>& resources, 
+			ResourceArchiveCompression compression = ResourceArchiveCompression::LZ) const;
+
 	private:
 		static const WString BUILD_FOLDER_NAME;
 
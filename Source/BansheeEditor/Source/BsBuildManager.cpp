@@ -164,6 +164,28 @@ namespace bs
 		mBuildData = nullptr;
 	}
 
+	bool BuildManager::createResourceArchive(const Path& outFile, const Vector<std::pair<String, Path>>& resources, 
+		ResourceArchiveCompression compression) const
+	{
+		if (FileSystem::exists(outFile))
+			FileSystem::remove(outFile);
+
+		ResourceArchiveWriter writer(outFile);
+
+		bool success = true;
+		for (auto& entry : resources)
+		{
+			if (!writer.add(entry.first, entry.second, compression))
+			{
+				LOGWRN("Cannot include resource in resource archive: " + entry.second.toString());
+				success = false;
+			}
+		}
+
+		writer.close();
+		return success;
+	}
+
 	void BuildManager::save(const Path& outFile)
 	{
 		FileEncoder fe(outFile);
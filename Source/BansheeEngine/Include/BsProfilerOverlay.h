@@ -20,7 +20,8 @@ namespace bs
 	enum class ProfilerOverlayType
 	{
 		CPUSamples,
-		GPUSamples
+		GPUSamples,
+		Memory /**< Memory usage per allocator category and tag. Enables MemAllocProfiler tracking when shown. */
 	};
 
 	/**
@@ -139,6 +140,30 @@ namespace bs
 			bool disabled;
 		};
 
+		/**	Holds data about GUI elements in a single row of memory statistics. */
+		struct MemoryRow
+		{
+			GUILayout* layout;
+
+			GUILabel* guiTag;
+			GUILabel* guiCategory;
+			GUILabel* guiLiveBytes;
+			GUILabel* guiPeakBytes;
+			GUILabel* guiLiveAllocs;
+			GUILabel* guiFrameAllocs;
+			GUILabel* guiFrameBytes;
+
+			HString tag;
+			HString category;
+			HString liveBytes;
+			HString peakBytes;
+			HString liveAllocs;
+			HString frameAllocs;
+			HString frameBytes;
+
+			bool disabled;
+		};
+
 	public:
 		/**	Constructs a new overlay attached to the specified parent and displayed on the provided camera. */
 		ProfilerOverlayInternal(const SPtr<Camera>& target);
@@ -165,6 +190,9 @@ namespace bs
 		/** Updates sizes of GUI areas used for displaying GPU sample data. To be called after viewport change or resize. */
 		void updateGPUSampleAreaSizes();
 
+		/** Updates sizes of GUI areas used for displaying memory data. To be called after viewport change or resize. */
+		void updateMemoryAreaSizes();
+
 		/**
 		 * Updates CPU GUI elements from the data in the provided profiler reports. To be called whenever a new report is 
 		 * received.
@@ -177,6 +205,12 @@ namespace bs
 		 */
 		void updateGPUSampleContents(const GPUProfilerReport& gpuReport);
 
+		/**
+		 * Updates memory GUI elements from the data in the provided profiler report. To be called whenever a new report is
+		 * received.
+		 */
+		void updateMemoryContents(const ProfilerReport& simReport);
+
 		static const UINT32 MAX_DEPTH;
 
 		ProfilerOverlayType mType;
@@ -254,9 +288,13 @@ namespace bs
 		HString mGPUVertexBufferBindsStr;
 		HString mGPUIndexBufferBindsStr;
 
+		GUILayout* mMemoryLayout = nullptr;
+		GUILayout* mMemoryLayoutContents = nullptr;
+
 		Vector<BasicRow> mBasicRows;
 		Vector<PreciseRow> mPreciseRows;
 		Vector<GPUSampleRow> mGPUSampleRows;
+		Vector<MemoryRow> mMemoryRows;
 
 		HEvent mTargetResizedConn;
 		bool mIsShown;
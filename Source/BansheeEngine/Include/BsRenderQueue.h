@@ -38,17 +38,20 @@ namespace bs { namespace ct
 	 * Render objects determines rendering order of objects contained within it. Rendering order is determined by object
 	 * material, and can influence rendering of transparent or opaque objects, or be used to improve performance by grouping
 	 * similar objects together.
+	 *
+	 * Elements are sorted by packing the sorting criteria into a single 64-bit key per element and radix sorting the keys.
 	 */
 	class BS_EXPORT RenderQueue
 	{
 		/**	Data used for renderable element sorting. Represents a single pass for a single mesh. */
 		struct SortableElement
 		{
-			UINT32 seqIdx;
+			UINT32 elementIdx;
 			INT32 priority;
 			float distFromCamera;
 			UINT32 shaderId;
 			UINT32 passIdx;
+			bool separablePasses;
 		};
 
 	public:
@@ -63,10 +66,16 @@ namespace bs { namespace ct
 		 */
 		void add(RenderableElement* element, float distFromCamera);
 
+		/** 
+		 * Appends all the entries from the provided queue to this queue. Entries are ordered as if they were added after
+		 * all the existing entries in this queue. Allows multiple queues to be populated in parallel and then merged.
+		 */
+		void append(const RenderQueue& other);
+
 		/**	Clears all render operations from the queue. */
 		void clear();
 		
-		/**	Sorts all the render operations using user-defined rules. */
+		/**	Sorts all the render operations using the rules determined by the state reduction mode. */
 		virtual void sort();
 
 		/** Returns a list of sorted render elements. Caller must ensure sort() is called before this method. */
@@ -79,19 +88,22 @@ namespace bs { namespace ct
 		void setStateReduction(StateReduction mode) { mStateReductionMode = mode; }
 
 	protected:
-		/**	Callback used for sorting elements with no material grouping. */
-		static bool elementSorterNoGroup(UINT32 aIdx, UINT32 bIdx, const Vector<SortableElement>& lookup);
-
-		/**	Callback used for sorting elements with preferred material grouping. */
-		static bool elementSorterPreferGroup(UINT32 aIdx, UINT32 bIdx, const Vector<SortableElement>& lookup);
-
-		/**	Callback used for sorting elements with material grouping after sorting. */
-		static bool elementSorterPreferSort(UINT32 aIdx, UINT32 bIdx, const Vector<SortableElement>& lookup);
+		/** 
+		 * Generates a key that determines the position of the element in the sorted queue, according to the current state
+		 * reduction mode. Elements with lower keys are rendered first. Elements with equal keys are rendered in the order
+		 * they were added in.
+		 */
+		UINT64 getSortKey(const SortableElement& element) const;
 
 		Vector<SortableElement> mSortableElements;
 		Vector<UINT32> mSortableElementIdx;
+		Vector<UINT64> mSortKeys;
 		Vector<RenderableElement*> mElements;
 
+		// Scratch buffers used during sorting
+		Vector<UINT32> mSortableElementIdxTemp;
+		Vector<UINT64> mSortKeysTemp;
+
 		Vector<RenderQueueElement> mSortedRenderElements;
 		StateReduction mStateReductionMode;
 	};
@@ -239,6 +239,8 @@ namespace bs
 
 	void GUIManager::update()
 	{
+		BS_MEMORY_SCOPE("GUI");
+
 		DragAndDropManager::instance()._update();
 
 		// Show tooltip if needed
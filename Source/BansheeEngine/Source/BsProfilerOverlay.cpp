@@ -289,6 +289,91 @@ namespace bs
 		}
 	};
 
+	class MemoryRowFiller
+	{
+	public:
+		UINT32 curIdx;
+		GUILayout& layout;
+		GUIWidget& widget;
+		Vector<ProfilerOverlayInternal::MemoryRow>& rows;
+
+		MemoryRowFiller(Vector<ProfilerOverlayInternal::MemoryRow>& _rows, GUILayout& _layout, GUIWidget& _widget)
+			:curIdx(0), layout(_layout), widget(_widget), rows(_rows)
+		{ }
+
+		~MemoryRowFiller()
+		{
+			UINT32 excessEntries = (UINT32)rows.size() - curIdx;
+			for (UINT32 i = 0; i < excessEntries; i++)
+			{
+				ProfilerOverlayInternal::MemoryRow& row = rows[curIdx + i];
+
+				if (!row.disabled)
+				{
+					row.layout->setVisible(false);
+					row.disabled = true;
+				}
+			}
+
+			rows.resize(curIdx);
+		}
+
+		void addData(const char* tag, MemoryCategory category, INT64 liveBytes, INT64 peakBytes, INT64 liveAllocs,
+			UINT64 frameAllocs, UINT64 frameBytes)
+		{
+			if (curIdx >= rows.size())
+			{
+				rows.push_back(ProfilerOverlayInternal::MemoryRow());
+
+				ProfilerOverlayInternal::MemoryRow& newRow = rows.back();
+
+				newRow.disabled = false;
+				newRow.tag = HEString(L"{0}");
+				newRow.category = HEString(L"{0}");
+				newRow.liveBytes = HEString(L"{0} KB");
+				newRow.peakBytes = HEString(L"{0} KB");
+				newRow.liveAllocs = HEString(L"{0}");
+				newRow.frameAllocs = HEString(L"{0}");
+				newRow.frameBytes = HEString(L"{0} KB");
+
+				newRow.layout = layout.insertNewElement<GUILayoutX>(layout.getNumChildren());
+
+				newRow.guiTag = newRow.layout->addNewElement<GUILabel>(newRow.tag, GUIOptions(GUIOption::fixedWidth(150)));
+				newRow.guiCategory = newRow.layout->addNewElement<GUILabel>(newRow.category, GUIOptions(GUIOption::fixedWidth(60)));
+				newRow.guiLiveBytes = newRow.layout->addNewElement<GUILabel>(newRow.liveBytes, GUIOptions(GUIOption::fixedWidth(100)));
+				newRow.guiPeakBytes = newRow.layout->addNewElement<GUILabel>(newRow.peakBytes, GUIOptions(GUIOption::fixedWidth(100)));
+				newRow.guiLiveAllocs = newRow.layout->addNewElement<GUILabel>(newRow.liveAllocs, GUIOptions(GUIOption::fixedWidth(60)));
+				newRow.guiFrameAllocs = newRow.layout->addNewElement<GUILabel>(newRow.frameAllocs, GUIOptions(GUIOption::fixedWidth(60)));
+				newRow.guiFrameBytes = newRow.layout->addNewElement<GUILabel>(newRow.frameBytes, GUIOptions(GUIOption::fixedWidth(100)));
+			}
+
+			ProfilerOverlayInternal::MemoryRow& row = rows[curIdx];
+			row.tag.setParameter(0, toWString(String(tag)));
+			row.category.setParameter(0, category == MemoryCategory::Pool ? L"Pool" : L"General");
+			row.liveBytes.setParameter(0, toWString(liveBytes / 1024.0, 2, 0, ' ', std::ios::fixed));
+			row.peakBytes.setParameter(0, toWString(peakBytes / 1024.0, 2, 0, ' ', std::ios::fixed));
+			row.liveAllocs.setParameter(0, toWString(liveAllocs));
+			row.frameAllocs.setParameter(0, toWString(frameAllocs));
+			row.frameBytes.setParameter(0, toWString(frameBytes / 1024.0, 2, 0, ' ', std::ios::fixed));
+
+			row.guiTag->setContent(row.tag);
+			row.guiCategory->setContent(row.category);
+			row.guiLiveBytes->setContent(row.liveBytes);
+			row.guiPeakBytes->setContent(row.peakBytes);
+			row.guiLiveAllocs->setContent(row.liveAllocs);
+			row.guiFrameAllocs->setContent(row.frameAllocs);
+			row.guiFrameBytes->setContent(row.frameBytes);
+
+			if (row.disabled)
+			{
+				row.layout->setVisible(true);
+				row.disabled = false;
+			}
+
+			curIdx++;
+		}
+	};
+
 	const UINT32 ProfilerOverlayInternal::MAX_DEPTH = 4;
 
 	CProfilerOverlay::CProfilerOverlay()
@@ -513,18 +598,42 @@ namespace bs
 		mGPULayoutFrameContentsRight->addElement(mGPUIndexBufferBindsLbl);
 		mGPULayoutFrameContentsRight->addNewElement<GUIFlexibleSpace>();
 
+		// Set up memory areas
+		mMemoryLayout = mWidget->getPanel()->addNewElement<GUILayoutY>();
+
+		GUILayout* memoryTitle = mMemoryLayout->addNewElement<GUILayoutY>();
+		mMemoryLayoutContents = mMemoryLayout->addNewElement<GUILayoutY>();
+		mMemoryLayout->addNewElement<GUIFlexibleSpace>();
+
+		HString memoryStr(L"__ProfOvMemory", L"Memory");
+		memoryTitle->addElement(GUILabel::create(memoryStr));
+		memoryTitle->addNewElement<GUIFixedSpace>(20);
+
+		GUILayout* memoryTitleRow = memoryTitle->addNewElement<GUILayoutX>();
+
+		HString memoryTagStr(L"__ProfOvMemTag", L"Tag");
+		HString memoryCategoryStr(L"__ProfOvMemCategory", L"Category");
+		HString memoryLiveBytesStr(L"__ProfOvMemLiveBytes", L"Live");
+		HString memoryPeakBytesStr(L"__ProfOvMemPeakBytes", L"Peak");
+		HString memoryLiveAllocsStr(L"__ProfOvMemLiveAllocs", L"# live");
+		HString memoryFrameAllocsStr(L"__ProfOvMemFrameAllocs", L"# allocs");
+		HString memoryFrameBytesStr(L"__ProfOvMemFrameBytes", L"Allocated");
+		memoryTitleRow->addElement(GUILabel::create(memoryTagStr, GUIOptions(GUIOption::fixedWidth(150))));
+		memoryTitleRow->addElement(GUILabel::create(memoryCategoryStr, GUIOptions(GUIOption::fixedWidth(60))));
+		memoryTitleRow->addElement(GUILabel::create(memoryLiveBytesStr, GUIOptions(GUIOption::fixedWidth(100))));
+		memoryTitleRow->addElement(GUILabel::create(memoryPeakBytesStr, GUIOptions(GUIOption::fixedWidth(100))));
+		memoryTitleRow->addElement(GUILabel::create(memoryLiveAllocsStr, GUIOptions(GUIOption::fixedWidth(60))));
+		memoryTitleRow->addElement(GUILabel::create(memoryFrameAllocsStr, GUIOptions(GUIOption::fixedWidth(60))));
+		memoryTitleRow->addElement(GUILabel::create(memoryFrameBytesStr, GUIOptions(GUIOption::fixedWidth(100))));
+
 		updateCPUSampleAreaSizes();
 		updateGPUSampleAreaSizes();
+		updateMemoryAreaSizes();
 
 		if (!mIsShown)
 			hide();
 		else
-		{
-			if (mType == ProfilerOverlayType::CPUSamples)
-				show(ProfilerOverlayType::CPUSamples);
-			else
-				show(ProfilerOverlayType::GPUSamples);
-		}
+			show(mType);
 	}
 
 	void ProfilerOverlayInternal::show(ProfilerOverlayType type)
@@ -537,8 +646,9 @@ namespace bs
 			mPreciseLayoutContents->setVisible(true);
 			mGPULayoutFrameContents->setVisible(false);
 			mGPULayoutSamples->setVisible(false);
+			mMemoryLayout->setVisible(false);
 		}
-		else
+		else if (type == ProfilerOverlayType::GPUSamples)
 		{
 			mGPULayoutFrameContents->setVisible(true);
 			mGPULayoutSamples->setVisible(true);
@@ -546,6 +656,19 @@ namespace bs
 			mPreciseLayoutLabels->setVisible(false);
 			mBasicLayoutContents->setVisible(false);
 			mPreciseLayoutContents->setVisible(false);
+			mMemoryLayout->setVisible(false);
+		}
+		else
+		{
+			mMemoryLayout->setVisible(true);
+			mBasicLayoutLabels->setVisible(false);
+			mPreciseLayoutLabels->setVisible(false);
+			mBasicLayoutContents->setVisible(false);
+			mPreciseLayoutContents->setVisible(false);
+			mGPULayoutFrameContents->setVisible(false);
+			mGPULayoutSamples->setVisible(false);
+
+			MemAllocProfiler::setEnabled(true);
 		}
 
 		mType = type;
@@ -560,6 +683,7 @@ namespace bs
 		mPreciseLayoutContents->setVisible(false);
 		mGPULayoutFrameContents->setVisible(false);
 		mGPULayoutSamples->setVisible(false);
+		mMemoryLayout->setVisible(false);
 		mIsShown = false;
 	}
 
@@ -569,6 +693,7 @@ namespace bs
 		const ProfilerReport& latestCoreReport = ProfilingManager::instance().getReport(ProfiledThread::Core);
 
 		updateCPUSampleContents(latestSimReport, latestCoreReport);
+		updateMemoryContents(latestSimReport);
 
 		while (ProfilerGPU::instance().getNumAvailableReports() > 1)
 			ProfilerGPU::instance().getNextReport(); // Drop any extra reports, we only want the latest
@@ -583,6 +708,7 @@ namespace bs
 	{
 		updateCPUSampleAreaSizes();
 		updateGPUSampleAreaSizes();
+		updateMemoryAreaSizes();
 	}
 
 	void ProfilerOverlayInternal::updateCPUSampleAreaSizes()
@@ -633,6 +759,18 @@ namespace bs
 		mGPULayoutSamples->setHeight(samplesHeight);
 	}
 
+	void ProfilerOverlayInternal::updateMemoryAreaSizes()
+	{
+		static const INT32 PADDING = 10;
+
+		UINT32 width = (UINT32)std::max(0, (INT32)mTarget->getWidth() - PADDING * 2);
+		UINT32 height = (UINT32)std::max(0, (INT32)mTarget->getHeight() - PADDING * 2);
+
+		mMemoryLayout->setPosition(PADDING, PADDING);
+		mMemoryLayout->setWidth(width);
+		mMemoryLayout->setHeight(height);
+	}
+
 	void ProfilerOverlayInternal::updateCPUSampleContents(const ProfilerReport& simReport, const ProfilerReport& coreReport)
 	{
 		static const UINT32 NUM_ROOT_ENTRIES = 2;
@@ -770,4 +908,22 @@ namespace bs
 			sampleRowFiller.addData(sample.name, sample.timeMs);
 		}
 	}
+
+	void ProfilerOverlayInternal::updateMemoryContents(const ProfilerReport& simReport)
+	{
+		// Largest users of memory first
+		Vector<const MemoryStats*> sortedStats;
+		for (auto& stats : simReport.memoryStats)
+			sortedStats.push_back(&stats);
+
+		std::sort(sortedStats.begin(), sortedStats.end(),
+			[](const MemoryStats* a, const MemoryStats* b) { return a->liveBytes > b->liveBytes; });
+
+		MemoryRowFiller memoryRowFiller(mMemoryRows, *mMemoryLayoutContents, *mWidget->_getInternal());
+		for (auto& stats : sortedStats)
+		{
+			memoryRowFiller.addData(stats->tagName, stats->category, stats->liveBytes, stats->peakBytes, 
+				stats->liveAllocs, stats->frameAllocs, stats->frameBytes);
+		}
+	}
 }
\ No newline at end of file
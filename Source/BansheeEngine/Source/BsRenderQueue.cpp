@@ -6,11 +6,21 @@
 #include "BsMesh.h"
 #include "BsMaterial.h"
 #include "BsRenderableElement.h"
-
-using namespace std::placeholders;
+#include "BsRadixSort.h"
 
 namespace bs { namespace ct
 {
+	/** Maps a float to an integer with the same ordering, so it can be used in integer sort keys. */
+	static UINT32 floatToSortableInt(float value)
+	{
+		UINT32 bits;
+		memcpy(&bits, &value, sizeof(bits));
+
+		// Flip all bits of negative values so larger magnitudes sort first, and the sign bit of positive values so they
+		// sort after negative ones
+		return (bits & 0x80000000) != 0 ? ~bits : (bits | 0x80000000);
+	}
+
 	RenderQueue::RenderQueue(StateReduction mode)
 		:mStateReductionMode(mode)
 	{
@@ -21,6 +31,7 @@ namespace bs { namespace ct
 	{
 		mSortableElements.clear();
 		mSortableElementIdx.clear();
+		mSortKeys.clear();
 		mElements.clear();
 
 		mSortedRenderElements.clear();
@@ -28,12 +39,13 @@ namespace bs { namespace ct
 
 	void RenderQueue::add(RenderableElement* element, float distFromCamera)
 	{
-		SPtr<Material> material = element->material;
+		const SPtr<Material>& material = element->material;
 		SPtr<Shader> shader = material->getShader();
 
+		UINT32 elementIdx = (UINT32)mElements.size();
 		mElements.push_back(element);
 		
-		UINT32 queuePriority = shader->getQueuePriority();
+		INT32 queuePriority = shader->getQueuePriority();
 		QueueSortType sortType = shader->getQueueSortType();
 		UINT32 shaderId = shader->getId();
 		bool separablePasses = shader->getAllowSeparablePasses();
@@ -56,60 +68,58 @@ namespace bs { namespace ct
 
 		for (UINT32 i = 0; i < numPasses; i++)
 		{
-			UINT32 idx = (UINT32)mSortableElementIdx.size();
-			mSortableElementIdx.push_back(idx);
-
 			mSortableElements.push_back(SortableElement());
 			SortableElement& sortableElem = mSortableElements.back();
 
-			sortableElem.seqIdx = idx;
+			sortableElem.elementIdx = elementIdx;
 			sortableElem.priority = queuePriority;
 			sortableElem.shaderId = shaderId;
 			sortableElem.passIdx = i;
 			sortableElem.distFromCamera = distFromCamera;
+			sortableElem.separablePasses = separablePasses;
+		}
+	}
+
+	void RenderQueue::append(const RenderQueue& other)
+	{
+		UINT32 elementOffset = (UINT32)mElements.size();
+		mElements.insert(mElements.end(), other.mElements.begin(), other.mElements.end());
+
+		for(auto& entry : other.mSortableElements)
+		{
+			mSortableElements.push_back(entry);
+			mSortableElements.back().elementIdx += elementOffset;
 		}
 	}
 
 	void RenderQueue::sort()
 	{
-		std::function<bool(UINT32, UINT32, const Vector<SortableElement>&)> sortMethod;
+		UINT32 numSortableElements = (UINT32)mSortableElements.size();
+
+		// Sort only keys and indices since we generate an entirely new data set anyway, it doesn't make sense to move
+		// sortable elements
+		mSortKeys.resize(numSortableElements);
+		mSortableElementIdx.resize(numSortableElements);
+		mSortKeysTemp.resize(numSortableElements);
+		mSortableElementIdxTemp.resize(numSortableElements);
 
-		switch (mStateReductionMode)
+		for (UINT32 i = 0; i < numSortableElements; i++)
 		{
-		case StateReduction::None:
-			sortMethod = &elementSorterNoGroup;
-			break;
-		case StateReduction::Material:
-			sortMethod = &elementSorterPreferGroup;
-			break;
-		case StateReduction::Distance:
-			sortMethod = &elementSorterPreferSort;
-			break;
+			mSortKeys[i] = getSortKey(mSortableElements[i]);
+			mSortableElementIdx[i] = i;
 		}
 
-		// Sort only indices since we generate an entirely new data set anyway, it doesn't make sense to move sortable elements
-		std::sort(mSortableElementIdx.begin(), mSortableElementIdx.end(), std::bind(sortMethod, _1, _2, mSortableElements));
+		RadixSort::sort(mSortKeys.data(), mSortableElementIdx.data(), numSortableElements, mSortKeysTemp.data(), 
+			mSortableElementIdxTemp.data());
 
 		UINT32 prevShaderId = (UINT32)-1;
 		UINT32 prevPassIdx = (UINT32)-1;
-		RenderableElement* renderElem = nullptr;
-		INT32 currentElementIdx = -1;
-		UINT32 numPassesInCurrentElement = 0;
-		bool separablePasses = true;
-		for (UINT32 i = 0; i < (UINT32)mSortableElementIdx.size(); i++)
+		for (UINT32 i = 0; i < numSortableElements; i++)
 		{
-			UINT32 idx = mSortableElementIdx[i];
-
-			while (numPassesInCurrentElement == 0)
-			{
-				currentElementIdx++;
-				renderElem = mElements[currentElementIdx];
-				numPassesInCurrentElement = renderElem->material->getNumPasses();
-				separablePasses = renderElem->material->getShader()->getAllowSeparablePasses();
-			}
+			const SortableElement& elem = mSortableElements[mSortableElementIdx[i]];
+			RenderableElement* renderElem = mElements[elem.elementIdx];
 
-			const SortableElement& elem = mSortableElements[idx];
-			if (separablePasses)
+			if (elem.separablePasses)
 			{
 				mSortedRenderElements.push_back(RenderQueueElement());
 
@@ -125,12 +135,11 @@ namespace bs { namespace ct
 				}
 				else
 					sortedElem.applyPass = false;
-
-				numPassesInCurrentElement--;
 			}
 			else
 			{
-				for (UINT32 j = 0; j < numPassesInCurrentElement; j++)
+				UINT32 numPasses = renderElem->material->getNumPasses();
+				for (UINT32 j = 0; j < numPasses; j++)
 				{
 					mSortedRenderElements.push_back(RenderQueueElement());
 
@@ -142,66 +151,36 @@ namespace bs { namespace ct
 					prevShaderId = elem.shaderId;
 					prevPassIdx = j;
 				}
-
-				numPassesInCurrentElement = 0;
-			}			
+			}
 		}
 	}
 
-	bool RenderQueue::elementSorterNoGroup(UINT32 aIdx, UINT32 bIdx, const Vector<SortableElement>& lookup)
-	{
-		const SortableElement& a = lookup[aIdx];
-		const SortableElement& b = lookup[bIdx];
-
-		UINT8 isHigher = (a.priority > b.priority) << 2 |
-			(a.distFromCamera < b.distFromCamera) << 1 |
-			(a.seqIdx < b.seqIdx);
-
-		UINT8 isLower = (a.priority < b.priority) << 2 |
-			(a.distFromCamera > b.distFromCamera) << 1 |
-			(a.seqIdx > b.seqIdx);
-
-		return isHigher > isLower;
-	}
-
-	bool RenderQueue::elementSorterPreferGroup(UINT32 aIdx, UINT32 bIdx, const Vector<SortableElement>& lookup)
-	{
-		const SortableElement& a = lookup[aIdx];
-		const SortableElement& b = lookup[bIdx];
-		
-		UINT8 isHigher = (a.priority > b.priority) << 4 |
-			(a.shaderId < b.shaderId) << 3 |
-			(a.passIdx < b.passIdx) << 2 |
-			(a.distFromCamera < b.distFromCamera) << 1 |
-			(a.seqIdx < b.seqIdx);
-
-		UINT8 isLower = (a.priority < b.priority) << 4 |
-			(a.shaderId > b.shaderId) << 3 |
-			(a.passIdx > b.passIdx) << 2 |
-			(a.distFromCamera > b.distFromCamera) << 1 |
-			(a.seqIdx > b.seqIdx);
-
-		return isHigher > isLower;
-	}
-
-	bool RenderQueue::elementSorterPreferSort(UINT32 aIdx, UINT32 bIdx, const Vector<SortableElement>& lookup)
+	UINT64 RenderQueue::getSortKey(const SortableElement& element) const
 	{
-		const SortableElement& a = lookup[aIdx];
-		const SortableElement& b = lookup[bIdx];
-
-		UINT8 isHigher = (a.priority > b.priority) << 4 | 
-			(a.distFromCamera < b.distFromCamera) << 3 | 
-			(a.shaderId < b.shaderId) << 2 | 
-			(a.passIdx < b.passIdx) << 1 | 
-			(a.seqIdx < b.seqIdx);
-
-		UINT8 isLower = (a.priority < b.priority) << 4 |
-			(a.distFromCamera > b.distFromCamera) << 3 |
-			(a.shaderId > b.shaderId) << 2 |
-			(a.passIdx > b.passIdx) << 1 |
-			(a.seqIdx > b.seqIdx);
-
-		return isHigher > isLower;
+		// Key layout, from most to least significant bits:
+		//  - 16 bits of priority, inverted so higher priorities come first
+		//  - 24 bits of distance (sign, exponent and top of the mantissa), 20 bits of shader ID and 4 bits of pass index,
+		//    ordered depending on the state reduction mode
+		// Shader IDs and pass indices that don't fit are truncated, which can only reduce the quality of grouping. The
+		// state changes are still determined from full values when generating the sorted elements.
+		INT32 priority = Math::clamp(element.priority, (INT32)std::numeric_limits<INT16>::min(),
+			(INT32)std::numeric_limits<INT16>::max());
+
+		UINT64 priorityBits = (UINT64)(0x7FFF - priority);
+		UINT64 distanceBits = floatToSortableInt(element.distFromCamera) >> 8;
+		UINT64 shaderBits = element.shaderId & 0xFFFFF;
+		UINT64 passBits = std::min(element.passIdx, 0xFU);
+
+		switch(mStateReductionMode)
+		{
+		default:
+		case StateReduction::None:
+			return (priorityBits << 48) | (distanceBits << 24);
+		case StateReduction::Material:
+			return (priorityBits << 48) | (shaderBits << 28) | (passBits << 24) | distanceBits;
+		case StateReduction::Distance:
+			return (priorityBits << 48) | (distanceBits << 24) | (shaderBits << 4) | passBits;
+		}
 	}
 
 	const Vector<RenderQueueElement>& RenderQueue::getSortedElements() const
@@ -185,6 +185,12 @@ namespace bs
 			{
 				SPtr<AnimationClip> clip = AnimationClip::_createPtr(entry.curves, entry.isAdditive, entry.sampleRate, 
 					entry.rootMotion);
+
+				if (meshImportOptions->getAnimationCompression())
+				{
+					if (!clip->compress(meshImportOptions->getAnimationCompressionError()))
+						LOGWRN("Unable to compress animation clip \"" + entry.name + "\". Clip will be stored uncompressed.");
+				}
 				
 				for(auto& eventsEntry : events)
 				{
@@ -190,6 +190,7 @@ namespace bs
 		texDesc.format = textureImportOptions->getFormat();
 		texDesc.usage = usage;
 		texDesc.hwGamma = sRGB;
+		texDesc.streaming = textureImportOptions->getStreaming() && numMips > 0;
 
 		SPtr<Texture> newTexture = Texture::_createPtr(texDesc);
 
@@ -454,8 +454,10 @@ namespace bs { namespace ct
 							if (mTextureInfos[unit].type != newTextureType)
 								glBindTexture(mTextureInfos[unit].type, 0);
 
-							SPtr<TextureView> texView = glTex->requestView(surface.mipLevel, surface.numMipLevels, 
-																surface.arraySlice, surface.numArraySlices, GVU_DEFAULT);
+							TextureSurface loadedSurface = glTex->getLoadedSurface(surface);
+							SPtr<TextureView> texView = glTex->requestView(loadedSurface.mipLevel, 
+								loadedSurface.numMipLevels, loadedSurface.arraySlice, loadedSurface.numArraySlices, 
+								GVU_DEFAULT);
 
 							GLTextureView* glTexView = static_cast<GLTextureView*>(texView.get());
 							glBindTexture(newTextureType, glTexView->getGLID());
@@ -52,9 +52,11 @@ set(BS_BANSHEEUTILITY_SRC_GENERAL
 	"Source/BsDynLib.cpp"
 	"Source/BsDynLibManager.cpp"
 	"Source/BsMessageHandler.cpp"
+	"Source/BsRadixSort.cpp"
 	"Source/BsTimer.cpp"
 	"Source/BsTime.cpp"
 	"Source/BsUtil.cpp"
+	"Source/BsCompression.cpp"
 )
 
 set(BS_BANSHEEUTILITY_INC_DEBUG
@@ -83,6 +85,7 @@ set(BS_BANSHEEUTILITY_SRC_THREADING
 
 set(BS_BANSHEEUTILITY_INC_GENERAL
 	"Include/BsAny.h"
+	"Include/BsBitfield.h"
 	"Include/BsBitwise.h"
 	"Include/BsDynLib.h"
 	"Include/BsDynLibManager.h"
@@ -91,11 +94,13 @@ set(BS_BANSHEEUTILITY_INC_GENERAL
 	"Include/BsMessageHandlerFwd.h"
 	"Include/BsModule.h"
 	"Include/BsPlatformUtility.h"
+	"Include/BsRadixSort.h"
 	"Include/BsServiceLocator.h"
 	"Include/BsTime.h"
 	"Include/BsTimer.h"
 	"Include/BsUtil.h"
 	"Include/BsFlags.h"
+	"Include/BsCompression.h"
 )
 
 set(BS_BANSHEEUTILITY_SRC_ALLOCATORS
@@ -103,6 +108,9 @@ set(BS_BANSHEEUTILITY_SRC_ALLOCATORS
 	"Source/BsGlobalFrameAlloc.cpp"
 	"Source/BsMemStack.cpp"
 	"Source/BsMemoryAllocator.cpp"
+	"Source/BsThreadFrameAlloc.cpp"
+	"Source/BsPoolAlloc.cpp"
+	"Source/BsMemAllocProfiler.cpp"
 )
 
 set(BS_BANSHEEUTILITY_SRC_RTTI
@@ -130,6 +138,8 @@ set(BS_BANSHEEUTILITY_INC_ALLOCATORS
 	"Include/BsMemStack.h"
 	"Include/BsStaticAlloc.h"
 	"Include/BsGroupAlloc.h"
+	"Include/BsThreadFrameAlloc.h"
+	"Include/BsPoolAlloc.h"
 )
 
 set(BS_BANSHEEUTILITY_INC_THIRDPARTY
@@ -159,6 +169,7 @@ set(BS_BANSHEEUTILITY_SRC_MATH
 	"Source/BsVector4.cpp"
 	"Source/BsBounds.cpp"
 	"Source/BsConvexVolume.cpp"
+	"Source/BsDynamicAABBTree.cpp"
 	"Source/BsTorus.cpp"
 	"Source/BsRect3.cpp"
 	"Source/BsRect2.cpp"
@@ -170,6 +181,11 @@ set(BS_BANSHEEUTILITY_SRC_MATH
 
 set(BS_BANSHEEUTILITY_INC_TESTING
 	"Include/BsFileSystemTestSuite.h"
+	"Include/BsDynamicAABBTreeTestSuite.h"
+	"Include/BsRadixSortTestSuite.h"
+	"Include/BsThreadFrameAllocTestSuite.h"
+	"Include/BsPoolAllocTestSuite.h"
+	"Include/BsCompressionTestSuite.h"
 	"Include/BsTestSuite.h"
 	"Include/BsTestOutput.h"
 	"Include/BsConsoleTestOutput.h"
@@ -177,6 +193,11 @@ set(BS_BANSHEEUTILITY_INC_TESTING
 
 set(BS_BANSHEEUTILITY_SRC_TESTING
 	"Source/BsFileSystemTestSuite.cpp"
+	"Source/BsDynamicAABBTreeTestSuite.cpp"
+	"Source/BsRadixSortTestSuite.cpp"
+	"Source/BsThreadFrameAllocTestSuite.cpp"
+	"Source/BsPoolAllocTestSuite.cpp"
+	"Source/BsCompressionTestSuite.cpp"
 	"Source/BsTestSuite.cpp"
 	"Source/BsTestOutput.cpp"
 	"Source/BsConsoleTestOutput.cpp"
@@ -208,6 +229,7 @@ set(BS_BANSHEEUTILITY_INC_MATH
 	"Include/BsVector4.h"
 	"Include/BsBounds.h"
 	"Include/BsConvexVolume.h"
+	"Include/BsDynamicAABBTree.h"
 	"Include/BsTorus.h"
 	"Include/BsLineSegment3.h"
 	"Include/BsRect3.h"
@@ -217,6 +239,7 @@ set(BS_BANSHEEUTILITY_INC_MATH
 	"Include/BsMatrixNxM.h"
 	"Include/BsVectorNI.h"
 	"Include/BsLine2.h"
+	"Include/BsSIMD.h"
 )
 
 set(BS_BANSHEEUTILITY_SRC_ERROR
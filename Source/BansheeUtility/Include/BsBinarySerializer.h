@@ -20,8 +20,6 @@ namespace bs
 
 	// TODO - Low priority. I will probably want to extract a generalized Serializer class so we can re-use the code
 	// in text or other serializers
-	// TODO - Low priority. Encode does a chunk-based encode so that we don't need to know the buffer size in advance,
-	// and don't have to use a lot of memory for the buffer. Consider doing something similar for decode.
 	// TODO - Low priority. Add a simple encode method that doesn't require a callback, instead it calls the callback internally
 	// and creates the buffer internally.
 	/**
@@ -67,7 +65,10 @@ namespace bs
 			bool shallow = false, const UnorderedMap<String, UINT64>& params = UnorderedMap<String, UINT64>());
 
 		/**
-		 * Decodes an object from binary data.
+		 * Decodes an object from binary data. Field data is read directly from the stream and assigned to the decoded
+		 * objects, without building an intermediate representation. Only the locations of the encoded objects are kept
+		 * in memory during decoding. Data block fields receive the provided stream, so file streams are not read into
+		 * memory unless the field requires it.
 		 *
 		 * @param[in]	data  		Binary data to decode.
 		 * @param[in]	dataLength	Length of the data in bytes.
@@ -140,6 +141,23 @@ namespace bs
 			bool decodeInProgress; // Used for error reporting circular references
 		};
 
+		/** Location of a part of an encoded object, containing either the object's own fields or fields of a base class. */
+		struct EncodedSection
+		{
+			UINT32 typeId;
+			UINT64 offset; /**< Stream offset of the first field in the section. */
+		};
+
+		/** Information about an object encoded at the top level of a data stream (i.e. not embedded in another object). */
+		struct EncodedObject
+		{
+			SPtr<IReflectable> object;
+			UINT32 firstSection; /**< Index of the object's first entry in mEncodedSections. Derived class comes first. */
+			UINT32 numSections;
+			bool isDecoded;
+			bool decodeInProgress; // Used for error reporting circular references
+		};
+
 		/** Encodes a single IReflectable object. */
 		UINT8* encodeEntry(IReflectable* object, UINT32 objectId, UINT8* buffer, UINT32& bufferLength, UINT32* bytesWritten,
 			std::function<UINT8*(UINT8* buffer, UINT32 bytesWritten, UINT32& newBufferSize)> flushBufferCallback, bool shallow);
@@ -151,6 +169,63 @@ namespace bs
 		bool decodeEntry(const SPtr<DataStream>& data, UINT32 dataLength, UINT32& bytesRead, SPtr<SerializedObject>& output, 
 			bool copyData, bool streamDataBlock);
 
+		/**
+		 * Finds all top-level objects in the stream and records the locations of their sections, without reading any
+		 * field data. Results are stored in mEncodedObjects and mEncodedSections.
+		 */
+		void indexObjects(const SPtr<DataStream>& data, size_t end);
+
+		/**
+		 * Skips over the object starting at the current stream position, including any objects embedded within it. 
+		 *
+		 * @param[in]	data		Stream positioned at the object meta data.
+		 * @param[in]	end			Offset at which the encoded data ends.
+		 * @param[out]	sections	Optional output for the locations of the object's sections, derived class first.
+		 * @return					Unique identifier of the object, or 0 if the object isn't referenced by pointers.
+		 */
+		UINT32 scanObject(const SPtr<DataStream>& data, size_t end, Vector<EncodedSection>* sections);
+
+		/** Decodes a top-level object, and marks it as decoded. */
+		void decodeEncodedObject(EncodedObject& encodedObject, const SPtr<DataStream>& data, size_t end);
+
+		/** 
+		 * Decodes the fields in the provided sections directly from the stream into @p object. Base class sections are
+		 * decoded first. Sections whose type doesn't match the current class hierarchy are ignored.
+		 */
+		void decodeObject(IReflectable* object, const EncodedSection* sections, UINT32 numSections, 
+			const SPtr<DataStream>& data, size_t end);
+
+		/**
+		 * Decodes an object embedded within another object, starting at the current stream position. After the call the
+		 * stream will be positioned after the end of the object. Returns null if the object's type is not known, or if
+		 * @p skip is true.
+		 */
+		SPtr<IReflectable> decodeEmbeddedObject(const SPtr<DataStream>& data, size_t end, bool skip);
+
+		/**
+		 * Decodes fields at the current stream position and assigns them to @p object, until a terminator field, object
+		 * meta data or the end of data is reached. If @p rtti is null, or a field is not known, the field data is 
+		 * skipped.
+		 *
+		 * @return	True if the decoding stopped because object meta data was encountered. In that case the stream is
+		 *			positioned at the start of the meta data.
+		 */
+		bool decodeFields(IReflectable* object, RTTITypeBase* rtti, const SPtr<DataStream>& data, size_t end);
+
+		/**
+		 * Returns the object with the provided unique identifier, creating it if it wasn't created already. Unless the
+		 * field is a weak reference the object will also be decoded, if it hasn't been already.
+		 */
+		SPtr<IReflectable> resolveObjectRef(UINT32 objectId, RTTIReflectablePtrFieldBase* field, 
+			const SPtr<DataStream>& data, size_t end);
+
+		/**
+		 * Returns a pointer to @p size bytes of data at the current stream position, and advances the stream. For memory
+		 * streams the data is referenced directly. For other streams it is read into a temporary buffer that remains
+		 * valid until the next call.
+		 */
+		UINT8* readFieldData(const SPtr<DataStream>& data, UINT32 size);
+
 		/**	Helper method for encoding a complex object and copying its data to a buffer. */
 		UINT8* complexTypeToBuffer(IReflectable* object, UINT8* buffer, UINT32& bufferLength, UINT32* bytesWritten,
 			std::function<UINT8*(UINT8* buffer, UINT32 bytesWritten, UINT32& newBufferSize)> flushBufferCallback, bool shallow);
@@ -201,12 +276,18 @@ namespace bs
 		UnorderedMap<SPtr<SerializedObject>, ObjectToDecode> mObjectMap;
 		UnorderedMap<UINT32, SPtr<SerializedObject>> mInterimObjectMap;
 
+		Vector<EncodedObject> mEncodedObjects;
+		Vector<EncodedSection> mEncodedSections;
+		UnorderedMap<UINT32, UINT32> mEncodedObjectIds;
+		Vector<UINT8> mFieldBuffer;
+
 		UnorderedMap<String, UINT64> mParams;
 
 		static const int META_SIZE = 4; // Meta field size
 		static const int NUM_ELEM_FIELD_SIZE = 4; // Size of the field storing number of array elements
 		static const int COMPLEX_TYPE_FIELD_SIZE = 4; // Size of the field storing the size of a child complex type
 		static const int DATA_BLOCK_TYPE_FIELD_SIZE = 4;
+		static const UINT32 MAX_FIELD_READ_SIZE = 64 * 1024; // Max. plain array data read from a file stream at once
 	};
 
 	/** @} */
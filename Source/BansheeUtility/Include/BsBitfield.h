@@ -0,0 +1,119 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#pragma once
+
+#include "BsPrerequisitesUtil.h"
+
+namespace bs
+{
+	/** @addtogroup General
+	 *  @{
+	 */
+
+	/**
+	 * Dynamically sized array of bits, packed into 32-bit words. Unused bits in the last word are always zero. Words can
+	 * be accessed directly, allowing operations on 32 bits at once, and allowing different threads to write to different
+	 * words without synchronization.
+	 */
+	class Bitfield
+	{
+	public:
+		/** Number of bits stored in a single word. */
+		static const UINT32 BITS_PER_WORD = 32;
+
+		Bitfield(UINT32 count = 0, bool value = false)
+			:mNumBits(0)
+		{
+			resize(count, value);
+		}
+
+		/** Changes the number of bits in the bitfield. New bits are initialized to @p value. */
+		void resize(UINT32 count, bool value = false)
+		{
+			UINT32 oldCount = mNumBits;
+			mNumBits = count;
+			mWords.resize(getNumWords(count), value ? ~0U : 0U);
+
+			if(value && count > oldCount && (oldCount % BITS_PER_WORD) != 0)
+				mWords[oldCount / BITS_PER_WORD] |= ~0U << (oldCount % BITS_PER_WORD);
+
+			clearUnusedBits();
+		}
+
+		/** Sets all the bits to the provided value. */
+		void reset(bool value = false)
+		{
+			for (auto& word : mWords)
+				word = value ? ~0U : 0U;
+
+			clearUnusedBits();
+		}
+
+		/** Removes all the bits. */
+		void clear()
+		{
+			mWords.clear();
+			mNumBits = 0;
+		}
+
+		/** Returns the value of the bit at the specified index. */
+		bool operator[](UINT32 idx) const
+		{
+			return (mWords[idx / BITS_PER_WORD] & (1U << (idx % BITS_PER_WORD))) != 0;
+		}
+
+		/** Changes the value of the bit at the specified index. */
+		void set(UINT32 idx, bool value)
+		{
+			UINT32 mask = 1U << (idx % BITS_PER_WORD);
+
+			if (value)
+				mWords[idx / BITS_PER_WORD] |= mask;
+			else
+				mWords[idx / BITS_PER_WORD] &= ~mask;
+		}
+
+		/** Sets all bits that are set in @p other. Both bitfields must be of the same size. */
+		Bitfield& operator|=(const Bitfield& other)
+		{
+			assert(mNumBits == other.mNumBits);
+
+			for (UINT32 i = 0; i < (UINT32)mWords.size(); i++)
+				mWords[i] |= other.mWords[i];
+
+			return *this;
+		}
+
+		/** Returns the number of bits in the bitfield. */
+		UINT32 size() const { return mNumBits; }
+
+		/** Returns the number of words the bits are stored in. */
+		UINT32 getNumWords() const { return (UINT32)mWords.size(); }
+
+		/**
+		 * Returns the words the bits are stored in. Bit at index i is stored in word i / BITS_PER_WORD, at bit position
+		 * i % BITS_PER_WORD. Bits past size() must be left at zero.
+		 */
+		UINT32* getWords() { return mWords.data(); }
+
+		/** @copydoc getWords() */
+		const UINT32* getWords() const { return mWords.data(); }
+
+		/** Returns the number of words required for storing the provided number of bits. */
+		static UINT32 getNumWords(UINT32 numBits) { return (numBits + BITS_PER_WORD - 1) / BITS_PER_WORD; }
+
+	private:
+		/** Clears the bits in the last word that are past the bitfield size. */
+		void clearUnusedBits()
+		{
+			UINT32 numUsedBits = mNumBits % BITS_PER_WORD;
+			if (numUsedBits != 0)
+				mWords.back() &= (1U << numUsedBits) - 1;
+		}
+
+		Vector<UINT32> mWords;
+		UINT32 mNumBits;
+	};
+
+	/** @} */
+}
@@ -0,0 +1,49 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#pragma once
+
+#include "BsPrerequisitesUtil.h"
+
+namespace bs
+{
+	/** @addtogroup General
+	 *  @{
+	 */
+
+	/**
+	 * Lossless compression of blocks of binary data. Uses a byte-oriented LZ77 scheme modeled after the LZ4 block format,
+	 * which trades compression ratio for very fast decompression, making it suitable for data that is decompressed at 
+	 * load time.
+	 */
+	class BS_UTILITY_EXPORT Compression
+	{
+	public:
+		/** Returns the maximum number of bytes compress() can output for an input of the provided size. */
+		static size_t getMaxCompressedSize(size_t size);
+
+		/**
+		 * Compresses a block of data.
+		 *
+		 * @param[in]	input		Data to compress.
+		 * @param[in]	size		Size of the input data, in bytes.
+		 * @param[out]	output		Buffer to write the compressed data to. Must be at least getMaxCompressedSize() bytes 
+		 *							large.
+		 * @return					Size of the compressed data, in bytes.
+		 */
+		static size_t compress(const UINT8* input, size_t size, UINT8* output);
+
+		/**
+		 * Decompresses a block of data previously compressed with compress(). 
+		 *
+		 * @param[in]	input		Compressed data.
+		 * @param[in]	size		Size of the compressed data, in bytes.
+		 * @param[out]	output		Buffer to write the decompressed data to.
+		 * @param[in]	outputSize	Size of the output buffer, in bytes.
+		 * @return					Size of the decompressed data in bytes, or 0 if the input is malformed or doesn't fit
+		 *							in the output buffer.
+		 */
+		static size_t decompress(const UINT8* input, size_t size, UINT8* output, size_t outputSize);
+	};
+
+	/** @} */
+}
@@ -0,0 +1,25 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#pragma once
+
+#include "BsTestSuite.h"
+
+namespace bs
+{
+	class BS_UTILITY_EXPORT CompressionTestSuite : public TestSuite
+	{
+	public:
+		CompressionTestSuite();
+
+	private:
+		void testRoundTrip_empty();
+		void testRoundTrip_small();
+		void testRoundTrip_random();
+		void testRoundTrip_repetitive();
+		void testRoundTrip_long_runs();
+		void testDecompress_truncated();
+		void testDecompress_small_output();
+		void testDecompress_invalid_offset();
+		void testDecompress_garbage();
+	};
+}
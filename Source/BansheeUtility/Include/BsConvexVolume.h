@@ -34,7 +34,7 @@ namespace bs
 		bool intersects(const Sphere& sphere) const;
 
 		/** Returns the internal set of planes that represent the volume. */
-		Vector<Plane> getPlanes() const { return mPlanes; }
+		const Vector<Plane>& getPlanes() const { return mPlanes; }
 
 	private:
 		Vector<Plane> mPlanes;
@@ -50,6 +50,18 @@ namespace bs
 		virtual bool isWriteable() const { return (mAccess & WRITE) != 0; }
 		virtual bool isFile() const = 0;
 
+		/**
+		 * Returns true if the stream data is a file mapped into memory. Such data remains valid for as long as the stream
+		 * exists, so it can be referenced directly instead of being copied out of the stream.
+		 */
+		virtual bool isMapped() const { return false; }
+
+		/**
+		 * If @p data points into the data of a file mapped into memory by this stream, returns the path of the file and
+		 * the offset of @p data from the start of the file. Returns false otherwise.
+		 */
+		virtual bool getMappedFileLocation(const UINT8* data, Path& filePath, UINT64& offset) const { return false; }
+
         /** Reads data from the buffer and copies it to the specified value. */
         template<typename T> DataStream& operator>>(T& val);
 
@@ -221,6 +233,86 @@ namespace bs
 		bool mFreeOnClose;
 	};
 
+	/**
+	 * Data stream for reading data from a file mapped into memory. Parts of the file are loaded by the OS as they are
+	 * accessed, instead of the file being read into a separately allocated buffer. Any writes to the mapped memory are 
+	 * private to the process and are never written back to the file.
+	 *
+	 * @note	Use FileSystem::openFileMapped() to create the stream.
+	 */
+	class BS_UTILITY_EXPORT MappedFileDataStream : public MemoryDataStream
+	{
+	public:
+		/**
+		 * Wraps a file that has already been mapped into memory. The stream takes ownership of the mapping.
+		 *
+		 * @param[in]	filePath	Path of the mapped file.
+		 * @param[in]	memory		Start of the mapped memory. Can be null for empty files.
+		 * @param[in]	size		Size of the mapped memory in bytes.
+		 */
+		MappedFileDataStream(const Path& filePath, void* memory, size_t size);
+		~MappedFileDataStream();
+
+		/** @copydoc DataStream::isMapped */
+		bool isMapped() const override { return true; }
+
+		/** @copydoc DataStream::getMappedFileLocation */
+		bool getMappedFileLocation(const UINT8* data, Path& filePath, UINT64& offset) const override;
+
+		/** 
+		 * @copydoc DataStream::clone 
+		 *
+		 * @note	The file is always mapped again, instead of having its contents copied.
+		 */
+		SPtr<DataStream> clone(bool copyData = true) const override;
+
+		/** @copydoc DataStream::close */
+		void close() override;
+
+		/** Returns the path of the mapped file. */
+		const Path& getPath() const { return mPath; }
+
+	protected:
+		Path mPath;
+	};
+
+	/**
+	 * Data stream for reading a part of a memory stream (e.g. a single entry in a mapped archive file). The data is
+	 * referenced directly, and the parent stream is kept alive for as long as the region stream exists.
+	 */
+	class BS_UTILITY_EXPORT MappedRegionDataStream : public MemoryDataStream
+	{
+	public:
+		/**
+		 * Creates a stream referencing a part of a memory stream.
+		 *
+		 * @param[in]	parent		Stream to reference the data of.
+		 * @param[in]	offset		Offset from the start of the parent stream at which the region starts, in bytes.
+		 * @param[in]	size		Size of the region, in bytes.
+		 */
+		MappedRegionDataStream(const SPtr<MemoryDataStream>& parent, size_t offset, size_t size);
+
+		/** @copydoc DataStream::isMapped */
+		bool isMapped() const override { return mParent->isMapped(); }
+
+		/** @copydoc DataStream::getMappedFileLocation */
+		bool getMappedFileLocation(const UINT8* data, Path& filePath, UINT64& offset) const override
+		{
+			return mParent->getMappedFileLocation(data, filePath, offset);
+		}
+
+		/** 
+		 * @copydoc DataStream::clone 
+		 *
+		 * @note	Data of mapped parents is never copied, the new stream references the same region. Otherwise only the
+		 *			data in the region is copied, if requested.
+		 */
+		SPtr<DataStream> clone(bool copyData = true) const override;
+
+	protected:
+		SPtr<MemoryDataStream> mParent;
+	};
+
 	/** Data stream for handling data from standard streams. */
 	class BS_UTILITY_EXPORT FileDataStream : public DataStream
 	{
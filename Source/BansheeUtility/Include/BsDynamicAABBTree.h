@@ -0,0 +1,154 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#pragma once
+
+#include "BsPrerequisitesUtil.h"
+#include "BsAABox.h"
+#include "BsFrameAlloc.h"
+
+namespace bs
+{
+	/** @addtogroup Math
+	 *  @{
+	 */
+
+	/**
+	 * Bounding volume hierarchy of axis aligned boxes that can be updated incrementally as objects are added, moved or
+	 * removed. Used for quickly finding all objects overlapping a volume, without having to test every object.
+	 *
+	 * Objects are inserted with tight bounds. Once an object moves for the first time its bounds in the tree are enlarged
+	 * by a margin, so that small movements don't require the tree to be modified. This means objects that never move
+	 * keep tight bounds and cost nothing to maintain, while moving objects are only re-inserted when they leave their
+	 * enlarged bounds.
+	 *
+	 * The tree is kept balanced through rotations performed during insertion and removal.
+	 */
+	class BS_UTILITY_EXPORT DynamicAABBTree
+	{
+	public:
+		/**
+		 * Constructs a new empty tree.
+		 *
+		 * @param[in]	margin	Amount by which to enlarge the bounds of moving objects, as a fraction of their size.
+		 */
+		DynamicAABBTree(float margin = 0.1f);
+
+		/**
+		 * Inserts a new object into the tree.
+		 *
+		 * @param[in]	bounds		World bounds of the object.
+		 * @param[in]	userData	Arbitrary value to associate with the object. Returned by queries.
+		 * @return					Identifier of the object in the tree. Used for updating and removing the object.
+		 */
+		UINT32 insert(const AABox& bounds, UINT32 userData);
+
+		/** Removes an object from the tree. */
+		void remove(UINT32 id);
+
+		/**
+		 * Updates the bounds of an object in the tree. The tree will only be modified if the new bounds are not contained
+		 * by the bounds the object is stored with.
+		 *
+		 * @param[in]	id		Identifier of the object, as returned by insert().
+		 * @param[in]	bounds	New world bounds of the object.
+		 * @return				True if the object had to be re-inserted into the tree.
+		 */
+		bool update(UINT32 id, const AABox& bounds);
+
+		/** Changes the value associated with an object. */
+		void setUserData(UINT32 id, UINT32 userData) { mNodes[id].userData = userData; }
+
+		/** Returns the value associated with an object. */
+		UINT32 getUserData(UINT32 id) const { return mNodes[id].userData; }
+
+		/** Returns the bounds the object is stored with in the tree. These might be larger than the object bounds. */
+		const AABox& getBounds(UINT32 id) const { return mNodes[id].bounds; }
+
+		/**
+		 * Finds all objects whose bounds in the tree intersect the provided convex volume.
+		 *
+		 * @param[in]	volume			Volume to test the objects against.
+		 * @param[out]	inside			Values associated with objects whose tree bounds are fully inside the volume. Such
+		 *								objects are guaranteed to intersect the volume with their actual bounds as well.
+		 * @param[out]	intersecting	Values associated with objects whose tree bounds intersect the volume, but aren't
+		 *								fully inside it. Caller should perform a more precise test on such objects.
+		 */
+		void query(const ConvexVolume& volume, Vector<UINT32>& inside, Vector<UINT32>& intersecting) const;
+
+		/** 
+		 * @copydoc query(const ConvexVolume&, Vector<UINT32>&, Vector<UINT32>&) const 
+		 *
+		 * @note	Overload for output allocated from a frame allocator, such as ThreadFrameAlloc on worker threads.
+		 */
+		void query(const ConvexVolume& volume, FrameVector<UINT32, StdFrameAlloc<UINT32>>& inside, 
+			FrameVector<UINT32, StdFrameAlloc<UINT32>>& intersecting) const;
+
+		/**
+		 * Finds all objects whose bounds in the tree intersect the provided sphere.
+		 *
+		 * @param[in]	sphere		Sphere to test the objects against.
+		 * @param[out]	output		Values associated with objects whose tree bounds intersect the sphere. Caller should
+		 *							perform a more precise test on the objects if needed.
+		 */
+		void query(const Sphere& sphere, Vector<UINT32>& output) const;
+
+		/** Returns the number of objects in the tree. */
+		UINT32 getNumObjects() const { return mNumObjects; }
+
+		/** Removes all objects from the tree. */
+		void clear();
+
+	private:
+		/** Implements both convex volume query() overloads. */
+		template<class T>
+		void queryVolume(const ConvexVolume& volume, T& inside, T& intersecting) const;
+
+		/** Single node in the tree. Leaf nodes represent objects, while other nodes always have two children. */
+		struct Node
+		{
+			bool isLeaf() const { return children[0] == (UINT32)-1; }
+
+			AABox bounds;
+			UINT32 parent; /**< Index of the parent node, or index of the next free node if the node is unused. */
+			UINT32 children[2];
+			INT32 height; /**< Height of the node in the tree, 0 for leaves, -1 for unused nodes. */
+			UINT32 userData;
+			bool moved; /**< True if the leaf has moved at least once and is stored with enlarged bounds. */
+		};
+
+		/** Finds an unused node or allocates a new one, and returns its index. */
+		UINT32 allocateNode();
+
+		/** Releases a node so it can be re-used. */
+		void freeNode(UINT32 idx);
+
+		/** Inserts an already allocated leaf node into the hierarchy. */
+		void insertLeaf(UINT32 leaf);
+
+		/** Removes a leaf node from the hierarchy, without freeing it. */
+		void removeLeaf(UINT32 leaf);
+
+		/**
+		 * Performs a rotation on the provided node if its sub-trees are unbalanced. Returns the index of the node now at
+		 * the position of the provided node.
+		 */
+		UINT32 balance(UINT32 idx);
+
+		/** Walks up the tree from the provided node, refitting bounds and heights, and balancing the nodes. */
+		void refit(UINT32 idx);
+
+		/** Returns half of the surface area of the provided box, used as the cost metric when building the tree. */
+		static float getCost(const AABox& box);
+
+		/** Returns a box enclosing both of the provided boxes. */
+		static AABox merge(const AABox& a, const AABox& b);
+
+		Vector<Node> mNodes;
+		UINT32 mRoot;
+		UINT32 mFreeList;
+		UINT32 mNumObjects;
+		float mMargin;
+	};
+
+	/** @} */
+}
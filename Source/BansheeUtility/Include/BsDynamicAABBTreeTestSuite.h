@@ -0,0 +1,23 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#pragma once
+
+#include "BsTestSuite.h"
+
+namespace bs
+{
+	class BS_UTILITY_EXPORT DynamicAABBTreeTestSuite : public TestSuite
+	{
+	public:
+		DynamicAABBTreeTestSuite();
+
+	private:
+		void testQuery_empty();
+		void testQuery_sphere();
+		void testQuery_volume();
+		void testRemove();
+		void testUpdate_within_margin();
+		void testUpdate_moved();
+		void testClear();
+	};
+}
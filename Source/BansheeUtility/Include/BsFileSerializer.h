@@ -44,7 +44,21 @@ namespace bs
 	class BS_UTILITY_EXPORT FileDecoder
 	{
 	public:
-		FileDecoder(const Path& fileLocation);
+		/**
+		 * Opens the file for decoding.
+		 *
+		 * @param[in]	fileLocation	Path to the file to decode.
+		 * @param[in]	mapToMemory		If true the file will be mapped into memory instead of being read through a file
+		 *								stream. Decoded data blocks will then reference the mapped file directly, rather
+		 *								than reading the file into separately allocated buffers.
+		 */
+		FileDecoder(const Path& fileLocation, bool mapToMemory = false);
+
+		/** 
+		 * Decodes objects from an already open stream, starting at its current position. Useful when decoding of a file
+		 * is split between multiple stages or threads.
+		 */
+		FileDecoder(const SPtr<DataStream>& stream);
 
 		/**	
 		 * Deserializes an IReflectable object by reading the binary data at the provided file location. 
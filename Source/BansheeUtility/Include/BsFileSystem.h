@@ -22,6 +22,15 @@ namespace bs
 		 */
 		static SPtr<DataStream> openFile(const Path& fullPath, bool readOnly = true);
 
+		/**
+		 * Opens a file for reading by mapping it into memory. Returned stream can be read like any other memory stream,
+		 * without the file contents being copied into memory first. 
+		 *
+		 * @param[in]	fullPath	Full path to a file.
+		 * @return					Stream of type MappedFileDataStream, or null if the file couldn't be mapped.
+		 */
+		static SPtr<DataStream> openFileMapped(const Path& fullPath);
+
 		/**
 		 * Opens a file and returns a data stream capable of reading and writing to that file. If file doesn't exist new
 		 * one will be created.
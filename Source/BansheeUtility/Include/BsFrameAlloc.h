@@ -126,6 +126,20 @@ namespace bs
 		 */
 		void setOwnerThread(ThreadId thread);
 
+		/**
+		 * Returns the number of bytes allocated since the last call to clear(), including any padding and debug data.
+		 *
+		 * @note	Not thread safe.
+		 */
+		UINT32 getAllocatedBytes() const;
+
+		/**
+		 * Returns the total size of the memory blocks reserved by the allocator.
+		 *
+		 * @note	Not thread safe.
+		 */
+		UINT32 getReservedBytes() const;
+
 	private:
 		UINT32 mBlockSize;
 		Vector<MemBlock*> mBlocks;
@@ -55,6 +55,7 @@ namespace bs
 	class Ray;
 	class Capsule;
 	class Sphere;
+	class ConvexVolume;
 	class Vector2;
 	class Vector3;
 	class Vector4;
@@ -68,8 +69,11 @@ namespace bs
 	class DataStream;
 	class MemoryDataStream;
 	class FileDataStream;
+	class MappedFileDataStream;
+	class MappedRegionDataStream;
 	class MeshData;
 	class FileSystem;
+	class FileDecoder;
 	class Timer;
 	class Task;
 	class GpuResourceData;
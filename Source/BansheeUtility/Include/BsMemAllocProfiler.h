@@ -37,6 +37,116 @@ namespace bs
 		}
 	};
 
+	/** Memory usage statistics for allocations of a single category, made under a single tag. */
+	struct MemoryStats
+	{
+		UINT32 tag; /**< Tag the allocations were made under. */
+		const char* tagName; /**< Name of the tag, as provided to MemAllocProfiler::registerTag(). */
+		MemoryCategory category; /**< Category of allocator that made the allocations. */
+
+		INT64 liveBytes; /**< Number of bytes allocated and not yet freed. */
+		INT64 peakBytes; /**< Highest value of liveBytes since tracking was enabled. */
+		INT64 liveAllocs; /**< Number of allocations not yet freed. */
+		UINT64 totalAllocs; /**< Number of allocations made since tracking was enabled. */
+		UINT64 totalBytes; /**< Number of bytes allocated since tracking was enabled. */
+		UINT64 frameAllocs; /**< Number of allocations made during the last completed frame. */
+		UINT64 frameBytes; /**< Number of bytes allocated during the last completed frame. */
+	};
+
+	/** List of memory statistics, allocated so it doesn't show up in the statistics themselves. */
+	typedef Vector<MemoryStats, StdAlloc<MemoryStats, ProfilerAlloc>> MemoryStatsList;
+
+	/**
+	 * Keeps track of live memory, peak memory and allocation rate of the general and pool allocators, split by allocator
+	 * category and by an optional tag identifying the subsystem that made the allocation (e.g. "Animation", "GUI").
+	 * Allocations are tagged by the tag active on the allocating thread, see MemoryScope and BS_MEMORY_SCOPE. Frees
+	 * are attributed to the tag and category the memory was allocated with, regardless of the thread they happen on.
+	 *
+	 * Tracking is disabled by default, in which case the only cost is a single flag check per allocation. While enabled,
+	 * each allocation and free performs a lookup in a sharded address map. Memory allocated before tracking was enabled
+	 * is not accounted for. If BS_PROFILING_ENABLED is 0, the tracking is compiled out.
+	 *
+	 * @note	Thread safe.
+	 */
+	class BS_UTILITY_EXPORT MemAllocProfiler
+	{
+	public:
+		/**
+		 * Enables or disables allocation tracking. Enabling clears all existing statistics. Statistics remain queryable
+		 * after tracking is disabled.
+		 */
+		static void setEnabled(bool enabled);
+
+		/** Checks is allocation tracking currently enabled. */
+		static bool isEnabled() { return MemoryCounter::isTrackingEnabled(); }
+
+		/**
+		 * Registers a tag with the provided name and returns its identifier. Registering the same name multiple times
+		 * returns the same identifier. Returns UNTAGGED if the maximum number of tags was reached.
+		 */
+		static UINT32 registerTag(const char* name);
+
+		/** Returns the name of a tag previously returned by registerTag(). */
+		static const char* getTagName(UINT32 tag);
+
+		/** Sets the tag that allocations made by the current thread will be tracked under. */
+		static void setThreadTag(UINT32 tag);
+
+		/** Returns the tag that allocations made by the current thread are tracked under. */
+		static UINT32 getThreadTag();
+
+		/** Returns statistics for every tag and category that allocated memory since tracking was enabled. */
+		static MemoryStatsList getStats();
+
+		/**
+		 * Ends the current frame, updating the per-frame allocation statistics. Called once per frame by the profiling
+		 * manager.
+		 */
+		static void _update();
+
+		/** Tag used for allocations made outside of any memory scope. */
+		static const UINT32 UNTAGGED = 0;
+
+		/** Maximum number of tags that can be registered, including UNTAGGED. */
+		static const UINT32 MAX_TAGS = 64;
+	};
+
+	/** Tags all memory allocated by the current thread with the provided tag, for the lifetime of the object. */
+	class MemoryScope
+	{
+	public:
+		MemoryScope(UINT32 tag)
+			:mPrevTag(MemAllocProfiler::getThreadTag())
+		{
+			MemAllocProfiler::setThreadTag(tag);
+		}
+
+		~MemoryScope()
+		{
+			MemAllocProfiler::setThreadTag(mPrevTag);
+		}
+
+	private:
+		UINT32 mPrevTag;
+	};
+
 	/** @} */
 	/** @} */
-}
\ No newline at end of file
+}
+
+#if BS_PROFILING_ENABLED
+/** Joins two tokens, expanding them first so that __LINE__ resolves to the line number. */
+#define BS_MEMORY_SCOPE_CONCAT_IMPL(a, b) a##b
+#define BS_MEMORY_SCOPE_CONCAT(a, b) BS_MEMORY_SCOPE_CONCAT_IMPL(a, b)
+
+/** 
+ * Tags all memory allocated by the current thread until the end of the current scope with the provided name. Variable 
+ * names include the line number, so that nested scopes in the same block don't collide.
+ */
+#define BS_MEMORY_SCOPE(name) \
+	static const bs::UINT32 BS_MEMORY_SCOPE_CONCAT(_bsMemoryScopeTag, __LINE__) = \
+		bs::MemAllocProfiler::registerTag(name); \
+	bs::MemoryScope BS_MEMORY_SCOPE_CONCAT(_bsMemoryScope, __LINE__)(BS_MEMORY_SCOPE_CONCAT(_bsMemoryScopeTag, __LINE__))
+#else
+#define BS_MEMORY_SCOPE(name)
+#endif
\ No newline at end of file
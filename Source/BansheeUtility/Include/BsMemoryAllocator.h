@@ -97,6 +97,14 @@ namespace bs
 	}
 #endif
 
+	/** Categories of allocators whose allocations can be tracked by MemAllocProfiler. */
+	enum class MemoryCategory
+	{
+		General, /**< Allocations made through the general allocator (GenAlloc and other generic categories). */
+		Pool, /**< Allocations made through PoolAlloc. */
+		Count // Keep at end
+	};
+
 	/**
 	 * Thread safe class used for storing total number of memory allocations and deallocations, primarily for statistic 
 	 * purposes.
@@ -113,16 +121,38 @@ namespace bs
 		{
 			return Frees;
 		}
+
+		/** Returns the total number of bytes allocated by the current thread through the general and pool allocators. */
+		static BS_UTILITY_EXPORT UINT64 getNumAllocatedBytes()
+		{
+			return AllocBytes;
+		}
+
+		/** Checks whether MemAllocProfiler is currently tracking individual allocations. */
+		static bool isTrackingEnabled()
+		{
+			return TrackingEnabled.load(std::memory_order_relaxed);
+		}
 		
 	private:
 		friend class MemoryAllocatorBase;
+		friend class MemAllocProfiler;
 
 		// Threadlocal data can't be exported, so some magic to make it accessible from MemoryAllocator
 		static BS_UTILITY_EXPORT void incAllocCount() { Allocs++; }
+		static BS_UTILITY_EXPORT void incAllocCount(size_t bytes) { Allocs++; AllocBytes += bytes; }
 		static BS_UTILITY_EXPORT void incFreeCount() { Frees++; }
 
+		/** Records a new allocation with MemAllocProfiler. Only called while tracking is enabled. */
+		static BS_UTILITY_EXPORT void trackAlloc(void* ptr, size_t bytes, MemoryCategory category);
+
+		/** Records a deallocation with MemAllocProfiler. Only called while tracking is enabled. */
+		static BS_UTILITY_EXPORT void trackFree(void* ptr);
+
 		static BS_THREADLOCAL UINT64 Allocs;
 		static BS_THREADLOCAL UINT64 Frees;
+		static BS_THREADLOCAL UINT64 AllocBytes;
+		static BS_UTILITY_EXPORT std::atomic<bool> TrackingEnabled;
 	};
 
 	/** Base class all memory allocators need to inherit. Provides allocation and free counting. */
@@ -131,6 +161,27 @@ namespace bs
 	protected:
 		static void incAllocCount() { MemoryCounter::incAllocCount(); }
 		static void incFreeCount() { MemoryCounter::incFreeCount(); }
+
+		/** 
+		 * Counts an allocation of @p bytes bytes at @p ptr, and reports it to MemAllocProfiler under the provided
+		 * category if tracking is enabled.
+		 */
+		static void trackAlloc(void* ptr, size_t bytes, MemoryCategory category)
+		{
+			MemoryCounter::incAllocCount(bytes);
+
+			if (MemoryCounter::isTrackingEnabled())
+				MemoryCounter::trackAlloc(ptr, bytes, category);
+		}
+
+		/** Counts a deallocation, and reports it to MemAllocProfiler if tracking is enabled. Call before freeing. */
+		static void trackFree(void* ptr)
+		{
+			MemoryCounter::incFreeCount();
+
+			if (MemoryCounter::isTrackingEnabled())
+				MemoryCounter::trackFree(ptr);
+		}
 	};
 
 	/**
@@ -146,11 +197,13 @@ namespace bs
 		/** Allocates @p bytes bytes. */
 		static void* allocate(size_t bytes)
 		{
+			void* ptr = malloc(bytes);
+
 #if BS_PROFILING_ENABLED
-			incAllocCount();
+			trackAlloc(ptr, bytes, MemoryCategory::General);
 #endif
 
-			return malloc(bytes);
+			return ptr;
 		}
 
 		/** 
@@ -159,28 +212,32 @@ namespace bs
 		 */
 		static void* allocateAligned(size_t bytes, size_t alignment)
 		{
+			void* ptr = platformAlignedAlloc(bytes, alignment);
+
 #if BS_PROFILING_ENABLED
-			incAllocCount();
+			trackAlloc(ptr, bytes, MemoryCategory::General);
 #endif
 
-			return platformAlignedAlloc(bytes, alignment);
+			return ptr;
 		}
 
 		/** Allocates @p bytes and aligns them to a 16 byte boundary. */
 		static void* allocateAligned16(size_t bytes)
 		{
+			void* ptr = platformAlignedAlloc16(bytes);
+
 #if BS_PROFILING_ENABLED
-			incAllocCount();
+			trackAlloc(ptr, bytes, MemoryCategory::General);
 #endif
 
-			return platformAlignedAlloc16(bytes);
+			return ptr;
 		}
 
 		/** Frees the memory at the specified location. */
 		static void free(void* ptr)
 		{
 #if BS_PROFILING_ENABLED
-			incFreeCount();
+			trackFree(ptr);
 #endif
 
 			::free(ptr);
@@ -190,7 +247,7 @@ namespace bs
 		static void freeAligned(void* ptr)
 		{
 #if BS_PROFILING_ENABLED
-			incFreeCount();
+			trackFree(ptr);
 #endif
 
 			platformAlignedFree(ptr);
@@ -200,7 +257,7 @@ namespace bs
 		static void freeAligned16(void* ptr)
 		{
 #if BS_PROFILING_ENABLED
-			incFreeCount();
+			trackFree(ptr);
 #endif
 
 			platformAlignedFree16(ptr);
@@ -437,6 +494,6 @@ namespace bs
 	/** @} */
 }
 
+#include "BsPoolAlloc.h"
 #include "BsMemStack.h"
 #include "BsGlobalFrameAlloc.h"
-#include "BsMemAllocProfiler.h"
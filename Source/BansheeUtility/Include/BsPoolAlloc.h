@@ -0,0 +1,135 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#pragma once
+
+namespace bs
+{
+	/** @addtogroup Internal-Utility
+	 *  @{
+	 */
+
+	/** @addtogroup Memory-Internal
+	 *  @{
+	 */
+
+	/**
+	 * Allocator for small objects that are allocated and freed often. Allocation sizes are rounded up to one of a fixed
+	 * set of size classes, and elements of each size class are allocated from their own 64KB slabs. Each thread keeps a
+	 * cache of free elements for every size class, so most allocations and frees don't require any synchronization.
+	 * Elements are moved between thread caches and a shared free list in batches.
+	 *
+	 * Allocations larger than MAX_SIZE, or aligned to more than 16 bytes, are passed through to the general allocator.
+	 * Returned memory is 16 byte aligned, same as with the general allocator. Slab memory is never returned to the OS,
+	 * but free elements are re-used by any thread.
+	 *
+	 * @note	Thread safe. Memory can be freed on a different thread than the one it was allocated on.
+	 */
+	class BS_UTILITY_EXPORT PoolAlloc
+	{
+	public:
+		/** Allocates @p bytes bytes. */
+		static void* allocate(size_t bytes);
+
+		/** Allocates @p bytes bytes aligned to the specified boundary (in bytes). Alignment must be power of two. */
+		static void* allocateAligned(size_t bytes, size_t alignment);
+
+		/** Allocates @p bytes bytes aligned to a 16 byte boundary. */
+		static void* allocateAligned16(size_t bytes);
+
+		/** Frees memory allocated with allocate(). */
+		static void free(void* ptr);
+
+		/** Frees memory allocated with allocateAligned(). */
+		static void freeAligned(void* ptr);
+
+		/** Frees memory allocated with allocateAligned16(). */
+		static void freeAligned16(void* ptr);
+
+		/**
+		 * Moves all free elements cached by the current thread to the shared free lists, so they can be used by other
+		 * threads. Should be called before a thread that used the allocator exits.
+		 */
+		static void endThread();
+
+		/** Returns the total size of memory reserved for slabs so far, in bytes. */
+		static UINT64 getReservedBytes();
+
+		/** Largest allocation size handled by the allocator. Larger allocations use the general allocator. */
+		static const UINT32 MAX_SIZE = 256;
+	};
+
+	/** Specialized memory allocator implementation that allows use of PoolAlloc in normal new/delete/free/dealloc operators. */
+	template<>
+	class MemoryAllocator<PoolAlloc> : public MemoryAllocatorBase
+	{
+	public:
+		/** @copydoc MemoryAllocator::allocate */
+		static void* allocate(size_t bytes)
+		{
+			void* ptr = PoolAlloc::allocate(bytes);
+
+#if BS_PROFILING_ENABLED
+			trackAlloc(ptr, bytes, MemoryCategory::Pool);
+#endif
+
+			return ptr;
+		}
+
+		/** @copydoc MemoryAllocator::allocateAligned */
+		static void* allocateAligned(size_t bytes, size_t alignment)
+		{
+			void* ptr = PoolAlloc::allocateAligned(bytes, alignment);
+
+#if BS_PROFILING_ENABLED
+			trackAlloc(ptr, bytes, MemoryCategory::Pool);
+#endif
+
+			return ptr;
+		}
+
+		/** @copydoc MemoryAllocator::allocateAligned16 */
+		static void* allocateAligned16(size_t bytes)
+		{
+			void* ptr = PoolAlloc::allocateAligned16(bytes);
+
+#if BS_PROFILING_ENABLED
+			trackAlloc(ptr, bytes, MemoryCategory::Pool);
+#endif
+
+			return ptr;
+		}
+
+		/** @copydoc MemoryAllocator::free */
+		static void free(void* ptr)
+		{
+#if BS_PROFILING_ENABLED
+			trackFree(ptr);
+#endif
+
+			PoolAlloc::free(ptr);
+		}
+
+		/** @copydoc MemoryAllocator::freeAligned */
+		static void freeAligned(void* ptr)
+		{
+#if BS_PROFILING_ENABLED
+			trackFree(ptr);
+#endif
+
+			PoolAlloc::freeAligned(ptr);
+		}
+
+		/** @copydoc MemoryAllocator::freeAligned16 */
+		static void freeAligned16(void* ptr)
+		{
+#if BS_PROFILING_ENABLED
+			trackFree(ptr);
+#endif
+
+			PoolAlloc::freeAligned16(ptr);
+		}
+	};
+
+	/** @} */
+	/** @} */
+}
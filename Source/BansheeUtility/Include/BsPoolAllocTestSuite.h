@@ -0,0 +1,23 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#pragma once
+
+#include "BsTestSuite.h"
+
+namespace bs
+{
+	class BS_UTILITY_EXPORT PoolAllocTestSuite : public TestSuite
+	{
+	public:
+		PoolAllocTestSuite();
+
+	private:
+		void testAllocate_sizes();
+		void testFree_reuse();
+		void testFree_no_growth();
+		void testAllocate_large();
+		void testAllocate_aligned();
+		void testFree_other_thread();
+		void testMultithreaded();
+	};
+}
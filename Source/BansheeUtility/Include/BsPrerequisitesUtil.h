@@ -264,6 +264,9 @@
 // Commonly used standard headers
 #include "BsStdHeaders.h"
 
+// Memory usage tracking
+#include "BsMemAllocProfiler.h"
+
 // Forward declarations
 #include "BsFwdDeclUtil.h"
 
@@ -94,6 +94,13 @@ namespace bs
 		 * location and contains the proper type.
 		 */
 		virtual void arrayElemFromBuffer(void* object, int index, void* buffer) = 0;
+
+		/**
+		 * Sets a range of values in the array on the provided field of the provided object. Values are copied from the 
+		 * buffer, which must contain @p count tightly packed values starting with the value at @p startIndex. Only valid
+		 * for fields whose type doesn't have a dynamic size.
+		 */
+		virtual void arrayFromBuffer(void* object, UINT32 startIndex, UINT32 count, void* buffer) = 0;
 	};
 
 	/** Represents a plain class field containing a specific type. */
@@ -287,6 +294,33 @@ namespace bs
 			std::function<void(ObjectType*, UINT32, DataType&)> f = any_cast<std::function<void(ObjectType*, UINT32, DataType&)>>(valueSetter);
 			f(castObject, index, value);
 		}
+
+		/** @copydoc RTTIPlainFieldBase::arrayFromBuffer */
+		void arrayFromBuffer(void* object, UINT32 startIndex, UINT32 count, void* buffer) override
+		{
+			checkIsArray(true);
+			checkType<DataType>();
+
+			ObjectType* castObject = static_cast<ObjectType*>(object);
+
+			if(valueSetter.empty())
+			{
+				BS_EXCEPT(InternalErrorException, 
+					"Specified field (" + mName + ") has no setter.");
+			}
+
+			std::function<void(ObjectType*, UINT32, DataType&)> f = any_cast<std::function<void(ObjectType*, UINT32, DataType&)>>(valueSetter);
+
+			char* data = (char*)buffer;
+			for(UINT32 i = 0; i < count; i++)
+			{
+				DataType value;
+				RTTIPlainType<DataType>::fromMemory(value, data);
+				f(castObject, startIndex + i, value);
+
+				data += sizeof(DataType);
+			}
+		}
 	};
 
 	/** @} */
@@ -0,0 +1,50 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#pragma once
+
+#include "BsPrerequisitesUtil.h"
+
+namespace bs
+{
+	/** @addtogroup General
+	 *  @{
+	 */
+
+	/**
+	 * Sorts integer keys using a least significant digit radix sort. The sort is stable, and runs in linear time. Large
+	 * inputs are sorted in parallel using the task scheduler.
+	 */
+	class BS_UTILITY_EXPORT RadixSort
+	{
+	public:
+		/**
+		 * Sorts the provided keys in ascending order, and reorders the values associated with each key in the same way.
+		 * Elements with the same key keep their relative order.
+		 *
+		 * @param[in, out]	keys		Keys to sort.
+		 * @param[in, out]	values		Values associated with the keys. Must have the same number of entries as @p keys.
+		 * @param[in]		count		Number of entries in @p keys and @p values.
+		 * @param[in]		tmpKeys		Scratch buffer with at least @p count entries, used during sorting.
+		 * @param[in]		tmpValues	Scratch buffer with at least @p count entries, used during sorting.
+		 */
+		static void sort(UINT64* keys, UINT32* values, UINT32 count, UINT64* tmpKeys, UINT32* tmpValues);
+
+		/** Minimum number of elements required before the sort is performed in parallel. */
+		static const UINT32 PARALLEL_MIN_ELEMENTS = 16384;
+
+		/** Minimum number of elements processed by a single task when sorting in parallel. */
+		static const UINT32 ELEMENTS_PER_TASK = 8192;
+
+	private:
+		/** Number of key bits sorted by a single pass. */
+		static const UINT32 RADIX_BITS = 8;
+
+		/** Number of different digit values in a single pass. */
+		static const UINT32 NUM_BUCKETS = 1 << RADIX_BITS;
+
+		/** Number of passes required to sort all bits of a key. */
+		static const UINT32 NUM_PASSES = 64 / RADIX_BITS;
+	};
+
+	/** @} */
+}
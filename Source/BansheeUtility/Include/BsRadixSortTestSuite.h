@@ -0,0 +1,24 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#pragma once
+
+#include "BsTestSuite.h"
+
+namespace bs
+{
+	class BS_UTILITY_EXPORT RadixSortTestSuite : public TestSuite
+	{
+	public:
+		RadixSortTestSuite();
+		void startUp() override;
+		void shutDown() override;
+
+	private:
+		void testSort_empty();
+		void testSort_single();
+		void testSort_random();
+		void testSort_duplicates();
+		void testSort_high_bits();
+		void testSort_parallel();
+	};
+}
@@ -0,0 +1,348 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#pragma once
+
+#include "BsPrerequisitesUtil.h"
+
+// Detect available instruction sets
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#	define BS_SIMD_SSE 1
+#	include <emmintrin.h>
+#	if defined(__AVX__)
+#		define BS_SIMD_AVX 1
+#		include <immintrin.h>
+#	endif
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#	define BS_SIMD_NEON 1
+#	include <arm_neon.h>
+#endif
+
+namespace bs
+{
+	/** @addtogroup Math
+	 *  @{
+	 */
+
+	/**
+	 * Thin wrappers around platform specific SIMD instructions. Operations are performed on four floats at once using
+	 * SSE on x86, NEON on ARM, or scalar code if neither is available. Intended for use in performance critical loops
+	 * that process data laid out in structure-of-arrays form.
+	 */
+	namespace simd
+	{
+		/** Four floats that are operated on in parallel. */
+		struct float4
+		{
+#if BS_SIMD_SSE
+			__m128 v;
+#elif BS_SIMD_NEON
+			float32x4_t v;
+#else
+			float v[4];
+#endif
+		};
+
+		/** Loads four floats from memory. Memory doesn't need to be aligned. */
+		inline float4 load(const float* data)
+		{
+			float4 output;
+#if BS_SIMD_SSE
+			output.v = _mm_loadu_ps(data);
+#elif BS_SIMD_NEON
+			output.v = vld1q_f32(data);
+#else
+			for (UINT32 i = 0; i < 4; i++) output.v[i] = data[i];
+#endif
+			return output;
+		}
+
+		/** Stores four floats into memory. Memory doesn't need to be aligned. */
+		inline void store(float* data, const float4& value)
+		{
+#if BS_SIMD_SSE
+			_mm_storeu_ps(data, value.v);
+#elif BS_SIMD_NEON
+			vst1q_f32(data, value.v);
+#else
+			for (UINT32 i = 0; i < 4; i++) data[i] = value.v[i];
+#endif
+		}
+
+		/** Returns a value with all four components set to @p value. */
+		inline float4 set(float value)
+		{
+			float4 output;
+#if BS_SIMD_SSE
+			output.v = _mm_set1_ps(value);
+#elif BS_SIMD_NEON
+			output.v = vdupq_n_f32(value);
+#else
+			for (UINT32 i = 0; i < 4; i++) output.v[i] = value;
+#endif
+			return output;
+		}
+
+		/** Returns a value with the four components set to the provided values. */
+		inline float4 set(float x, float y, float z, float w)
+		{
+			float4 output;
+#if BS_SIMD_SSE
+			output.v = _mm_setr_ps(x, y, z, w);
+#else
+			float data[4] = { x, y, z, w };
+			output = load(data);
+#endif
+			return output;
+		}
+
+		/** Returns a value with all components set to zero. */
+		inline float4 zero()
+		{
+			return set(0.0f);
+		}
+
+		/** Returns a + b. */
+		inline float4 add(const float4& a, const float4& b)
+		{
+			float4 output;
+#if BS_SIMD_SSE
+			output.v = _mm_add_ps(a.v, b.v);
+#elif BS_SIMD_NEON
+			output.v = vaddq_f32(a.v, b.v);
+#else
+			for (UINT32 i = 0; i < 4; i++) output.v[i] = a.v[i] + b.v[i];
+#endif
+			return output;
+		}
+
+		/** Returns a - b. */
+		inline float4 sub(const float4& a, const float4& b)
+		{
+			float4 output;
+#if BS_SIMD_SSE
+			output.v = _mm_sub_ps(a.v, b.v);
+#elif BS_SIMD_NEON
+			output.v = vsubq_f32(a.v, b.v);
+#else
+			for (UINT32 i = 0; i < 4; i++) output.v[i] = a.v[i] - b.v[i];
+#endif
+			return output;
+		}
+
+		/** Returns a * b. */
+		inline float4 mul(const float4& a, const float4& b)
+		{
+			float4 output;
+#if BS_SIMD_SSE
+			output.v = _mm_mul_ps(a.v, b.v);
+#elif BS_SIMD_NEON
+			output.v = vmulq_f32(a.v, b.v);
+#else
+			for (UINT32 i = 0; i < 4; i++) output.v[i] = a.v[i] * b.v[i];
+#endif
+			return output;
+		}
+
+		/** Returns a * b + c. */
+		inline float4 madd(const float4& a, const float4& b, const float4& c)
+		{
+#if BS_SIMD_NEON
+			float4 output;
+			output.v = vmlaq_f32(c.v, a.v, b.v);
+			return output;
+#else
+			return add(mul(a, b), c);
+#endif
+		}
+
+		/** Returns a / b. */
+		inline float4 div(const float4& a, const float4& b)
+		{
+			float4 output;
+#if BS_SIMD_SSE
+			output.v = _mm_div_ps(a.v, b.v);
+#elif BS_SIMD_NEON && defined(__aarch64__)
+			output.v = vdivq_f32(a.v, b.v);
+#else
+			float aData[4], bData[4], data[4];
+			store(aData, a);
+			store(bData, b);
+			for (UINT32 i = 0; i < 4; i++) data[i] = aData[i] / bData[i];
+			output = load(data);
+#endif
+			return output;
+		}
+
+		/** Returns the square root of each component. */
+		inline float4 sqrt(const float4& a)
+		{
+			float4 output;
+#if BS_SIMD_SSE
+			output.v = _mm_sqrt_ps(a.v);
+#elif BS_SIMD_NEON && defined(__aarch64__)
+			output.v = vsqrtq_f32(a.v);
+#else
+			float data[4];
+			store(data, a);
+			for (UINT32 i = 0; i < 4; i++) data[i] = std::sqrt(data[i]);
+			output = load(data);
+#endif
+			return output;
+		}
+
+		/** Returns the per-component minimum of the two values. */
+		inline float4 min(const float4& a, const float4& b)
+		{
+			float4 output;
+#if BS_SIMD_SSE
+			output.v = _mm_min_ps(a.v, b.v);
+#elif BS_SIMD_NEON
+			output.v = vminq_f32(a.v, b.v);
+#else
+			for (UINT32 i = 0; i < 4; i++) output.v[i] = a.v[i] < b.v[i] ? a.v[i] : b.v[i];
+#endif
+			return output;
+		}
+
+		/** Returns the per-component maximum of the two values. */
+		inline float4 max(const float4& a, const float4& b)
+		{
+			float4 output;
+#if BS_SIMD_SSE
+			output.v = _mm_max_ps(a.v, b.v);
+#elif BS_SIMD_NEON
+			output.v = vmaxq_f32(a.v, b.v);
+#else
+			for (UINT32 i = 0; i < 4; i++) output.v[i] = a.v[i] > b.v[i] ? a.v[i] : b.v[i];
+#endif
+			return output;
+		}
+
+		/**
+		 * Compares each component and returns a mask with all bits set for components where a < b, and all bits cleared
+		 * otherwise. Mask can be used with select() and getMask().
+		 */
+		inline float4 cmpLess(const float4& a, const float4& b)
+		{
+			float4 output;
+#if BS_SIMD_SSE
+			output.v = _mm_cmplt_ps(a.v, b.v);
+#elif BS_SIMD_NEON
+			output.v = vreinterpretq_f32_u32(vcltq_f32(a.v, b.v));
+#else
+			for (UINT32 i = 0; i < 4; i++)
+			{
+				UINT32 mask = a.v[i] < b.v[i] ? 0xFFFFFFFF : 0;
+				memcpy(&output.v[i], &mask, sizeof(mask));
+			}
+#endif
+			return output;
+		}
+
+		/** Compares each component and returns a mask with all bits set for components where a != b. */
+		inline float4 cmpNotEqual(const float4& a, const float4& b)
+		{
+			float4 output;
+#if BS_SIMD_SSE
+			output.v = _mm_cmpneq_ps(a.v, b.v);
+#elif BS_SIMD_NEON
+			output.v = vreinterpretq_f32_u32(vmvnq_u32(vceqq_f32(a.v, b.v)));
+#else
+			for (UINT32 i = 0; i < 4; i++)
+			{
+				UINT32 mask = a.v[i] != b.v[i] ? 0xFFFFFFFF : 0;
+				memcpy(&output.v[i], &mask, sizeof(mask));
+			}
+#endif
+			return output;
+		}
+
+		/** Returns components from @p a where the @p mask is set, and from @p b where it is not. */
+		inline float4 select(const float4& mask, const float4& a, const float4& b)
+		{
+			float4 output;
+#if BS_SIMD_SSE
+			output.v = _mm_or_ps(_mm_and_ps(mask.v, a.v), _mm_andnot_ps(mask.v, b.v));
+#elif BS_SIMD_NEON
+			output.v = vbslq_f32(vreinterpretq_u32_f32(mask.v), a.v, b.v);
+#else
+			for (UINT32 i = 0; i < 4; i++)
+			{
+				UINT32 maskBits;
+				memcpy(&maskBits, &mask.v[i], sizeof(maskBits));
+				output.v[i] = maskBits != 0 ? a.v[i] : b.v[i];
+			}
+#endif
+			return output;
+		}
+
+		/** Returns a four bit integer, with each bit set if the corresponding component of the mask is set. */
+		inline UINT32 getMask(const float4& mask)
+		{
+#if BS_SIMD_SSE
+			return (UINT32)_mm_movemask_ps(mask.v);
+#else
+			float data[4];
+			store(data, mask);
+
+			UINT32 output = 0;
+			for (UINT32 i = 0; i < 4; i++)
+			{
+				UINT32 maskBits;
+				memcpy(&maskBits, &data[i], sizeof(maskBits));
+				output |= (maskBits >> 31) << i;
+			}
+
+			return output;
+#endif
+		}
+
+		/** Transposes a 4x4 matrix whose rows are represented by the four provided values. */
+		inline void transpose(float4& row0, float4& row1, float4& row2, float4& row3)
+		{
+#if BS_SIMD_SSE
+			_MM_TRANSPOSE4_PS(row0.v, row1.v, row2.v, row3.v);
+#else
+			float data[4][4];
+			store(data[0], row0);
+			store(data[1], row1);
+			store(data[2], row2);
+			store(data[3], row3);
+
+			row0 = set(data[0][0], data[1][0], data[2][0], data[3][0]);
+			row1 = set(data[0][1], data[1][1], data[2][1], data[3][1]);
+			row2 = set(data[0][2], data[1][2], data[2][2], data[3][2]);
+			row3 = set(data[0][3], data[1][3], data[2][3], data[3][3]);
+#endif
+		}
+
+		/**
+		 * Multiplies two row-major 4x4 matrices, output = a * b. Output may not alias the inputs.
+		 *
+		 * @param[in]	a		First matrix, as an array of 16 floats.
+		 * @param[in]	b		Second matrix, as an array of 16 floats.
+		 * @param[out]	output	Resulting matrix, as an array of 16 floats.
+		 */
+		inline void mulMatrix(const float* a, const float* b, float* output)
+		{
+			float4 bRow0 = load(b);
+			float4 bRow1 = load(b + 4);
+			float4 bRow2 = load(b + 8);
+			float4 bRow3 = load(b + 12);
+
+			for(UINT32 i = 0; i < 4; i++)
+			{
+				const float* aRow = a + i * 4;
+
+				float4 row = mul(set(aRow[0]), bRow0);
+				row = madd(set(aRow[1]), bRow1, row);
+				row = madd(set(aRow[2]), bRow2, row);
+				row = madd(set(aRow[3]), bRow3, row);
+
+				store(output + i * 4, row);
+			}
+		}
+	}
+
+	/** @} */
+}
@@ -162,11 +162,14 @@ namespace bs
 		return std::allocate_shared<Type>(StdAlloc<Type, AllocCategory>(), std::forward<Args>(args)...);
 	}
 
-	/** Create a new shared pointer using the default allocator category. */
+	/** 
+	 * Create a new shared pointer using the default allocator category. The object and the shared pointer data are
+	 * allocated together, using the small object allocator if they are small enough.
+	 */
 	template<class Type, class... Args>
 	SPtr<Type> bs_shared_ptr_new(Args &&... args)
 	{
-		return std::allocate_shared<Type>(StdAlloc<Type, GenAlloc>(), std::forward<Args>(args)...);
+		return std::allocate_shared<Type>(StdAlloc<Type, PoolAlloc>(), std::forward<Args>(args)...);
 	}
 
 	/**
@@ -12,6 +12,7 @@ namespace bs
 	 *  @{
 	 */
 	class TaskScheduler;
+	class TaskGroup;
 
 	/** Task priority. Tasks with higher priority will get executed sooner. */
 	enum class TaskPriority
@@ -25,7 +26,7 @@ namespace bs
 
 	/**
 	 * Represents a single task that may be queued in the TaskScheduler.
-	 * 			
+	 *
 	 * @note	Thread safe.
 	 */
 	class BS_UTILITY_EXPORT Task
@@ -33,7 +34,7 @@ namespace bs
 		struct PrivatelyConstruct {};
 
 	public:
-		Task(const PrivatelyConstruct& dummy, const String& name, std::function<void()> taskWorker, 
+		Task(const PrivatelyConstruct& dummy, const String& name, std::function<void()> taskWorker,
 			TaskPriority priority, SPtr<Task> dependency);
 
 		/**
@@ -43,9 +44,10 @@ namespace bs
 		 * @param[in]	taskWorker	Worker method that does all of the work in the task.
 		 * @param[in]	priority  	(optional) Higher priority means the tasks will be executed sooner.
 		 * @param[in]	dependency	(optional) Task dependency if one exists. If provided the task will
-		 * 							not be executed until its dependency is complete.
+		 * 							not be executed until its dependency is complete. If the dependency gets canceled
+		 * 							this task will be canceled as well.
 		 */
-		static SPtr<Task> create(const String& name, std::function<void()> taskWorker, TaskPriority priority = TaskPriority::Normal, 
+		static SPtr<Task> create(const String& name, std::function<void()> taskWorker, TaskPriority priority = TaskPriority::Normal,
 			SPtr<Task> dependency = nullptr);
 
 		/** Returns true if the task has completed. */
@@ -55,9 +57,11 @@ namespace bs
 		bool isCanceled() const;
 
 		/**
-		 * Blocks the current thread until the task has completed. 
-		 * 
-		 * @note	While waiting adds a new worker thread, so that the blocking threads core can be utilized.
+		 * Blocks the current thread until the task has completed.
+		 *
+		 * @note
+		 * If called from a task scheduler worker thread, the thread will execute other queued tasks while it waits.
+		 * Otherwise a new worker is added while waiting, so that the blocking threads core can be utilized.
 		 */
 		void wait();
 
@@ -66,6 +70,7 @@ namespace bs
 
 	private:
 		friend class TaskScheduler;
+		friend class TaskGroup;
 
 		String mName;
 		TaskPriority mPriority;
@@ -75,18 +80,112 @@ namespace bs
 		std::atomic<UINT32> mState; /**< 0 - Inactive, 1 - In progress, 2 - Completed, 3 - Canceled */
 
 		TaskScheduler* mParent;
+		TaskGroup* mGroup;
+
+		SPtr<Task> mQueuedRef; /**< Keeps the task alive while it is referenced by one of the scheduler queues. */
+		Vector<SPtr<Task>> mDependants;
+		SpinLock mDependantsLock;
+	};
+
+	/**
+	 * Groups a set of tasks that can be waited on together. Useful for fork-join style workloads where a large job is
+	 * split into many small tasks, which are then all waited upon before continuing.
+	 *
+	 * @note
+	 * Group must outlive all the tasks queued through it. Destructor will block until all the tasks in the group are
+	 * complete.
+	 * @note
+	 * Thread safe.
+	 */
+	class BS_UTILITY_EXPORT TaskGroup
+	{
+	public:
+		TaskGroup();
+		~TaskGroup();
+
+		/**
+		 * Queues a new task as part of the group. If called from a task scheduler worker thread the task will be queued
+		 * on that worker's local queue, and will likely be executed by the same thread unless some other worker steals it.
+		 */
+		void run(std::function<void()> taskWorker);
+
+		/**
+		 * Blocks until all the tasks in the group have completed. The calling thread will execute other queued tasks while
+		 * waiting.
+		 */
+		void wait();
+
+		/** Returns true if all tasks queued in the group have completed. */
+		bool isComplete() const;
+
+	private:
+		friend class TaskScheduler;
+
+		std::atomic<UINT32> mNumPending;
 	};
 
+	/** @} */
+	/** @addtogroup Internal-Utility
+	 *  @{
+	 */
+
+	/** @addtogroup Threading-Internal
+	 *  @{
+	 */
+
+	/**
+	 * Fixed size double ended queue used for work stealing. The owner thread can push and pop tasks from the bottom of
+	 * the queue, while any other thread can steal tasks from the top.
+	 *
+	 * @note	push() and pop() may only be called from the owner thread, steal() may be called from any thread.
+	 */
+	class BS_UTILITY_EXPORT WorkStealingQueue
+	{
+	public:
+		/** Maximum number of tasks the queue can hold. Must be a power of two. */
+		static const UINT32 CAPACITY = 4096;
+
+		WorkStealingQueue();
+
+		/** Pushes a new task to the bottom of the queue. Returns false if the queue is full. */
+		bool push(Task* task);
+
+		/** Pops a task from the bottom of the queue. Returns null if the queue is empty. */
+		Task* pop();
+
+		/**
+		 * Attempts to steal a task from the top of the queue. Returns null if the queue is empty, or if another thread
+		 * beat the caller to the task.
+		 */
+		Task* steal();
+
+		/** Returns true if the queue currently holds no tasks. Only a hint if called from a non-owner thread. */
+		bool isEmpty() const;
+
+	private:
+		std::atomic<INT64> mTop;
+		std::atomic<INT64> mBottom;
+		std::atomic<Task*> mTasks[CAPACITY];
+	};
+
+	/** @} */
+	/** @} */
+
+	/** @addtogroup Threading
+	 *  @{
+	 */
+
 	/**
 	 * Represents a task scheduler running on multiple threads. You may queue tasks on it from any thread and they will be
 	 * executed in user specified order on any available thread.
-	 * 			
-	 * @note	
+	 *
+	 * @note
 	 * Thread safe.
 	 * @note
-	 * This type of task scheduler uses a global queue and is best used for coarse granularity of tasks. (Number of tasks 
-	 * in the order of hundreds. Higher number of tasks might require different queuing and locking mechanism, potentially 
-	 * at the cost of flexibility.)
+	 * Each worker thread has its own local queue. Tasks queued from within a worker thread (e.g. a task spawning child
+	 * tasks) are placed on that worker's local queue and don't go through any global lock. Idle workers steal tasks from
+	 * other workers' queues. Tasks queued from non-worker threads are placed in a global queue sorted by priority.
+	 * Priority is not respected for tasks in the local queues.
 	 * @note
 	 * By default the task scheduler will create as many threads as there are physical CPU cores. You may add or remove
 	 * threads using addWorker()/removeWorker() methods.
@@ -100,6 +199,20 @@ namespace bs
 		/** Queues a new task. */
 		void addTask(const SPtr<Task>& task);
 
+		/**
+		 * Executes the provided worker method over the range [@p begin, @p end), split into chunks of at most @p grain
+		 * elements. Chunks are executed in parallel on the worker threads, as well as on the calling thread. Method returns
+		 * after all the chunks have been processed.
+		 *
+		 * @param[in]	begin	First index in the range.
+		 * @param[in]	end		One past the last index in the range.
+		 * @param[in]	grain	Maximum number of elements to process in a single chunk. Should be large enough so that
+		 *						the work in a chunk outweighs the overhead of queuing a task.
+		 * @param[in]	worker	Method called for each chunk, receiving the start (inclusive) and end (exclusive) index of
+		 *						the chunk.
+		 */
+		void parallelFor(UINT32 begin, UINT32 end, UINT32 grain, const std::function<void(UINT32, UINT32)>& worker);
+
 		/**	Adds a new worker thread which will be used for executing queued tasks. */
 		void addWorker();
 
@@ -108,32 +221,96 @@ namespace bs
 
 		/** Returns the maximum available worker threads (maximum number of tasks that can be executed simultaneously). */
 		UINT32 getNumWorkers() const { return mMaxActiveTasks; }
+
+		/**
+		 * Returns the index of the worker the calling thread represents, or -1 if the calling thread isn't a task
+		 * scheduler worker thread. Index will be in the [0, MAX_WORKERS) range.
+		 */
+		INT32 getCurrentWorkerIdx() const;
+
+		/** Maximum number of worker threads the scheduler can create. */
+		static const UINT32 MAX_WORKERS = 64;
+
 	protected:
 		friend class Task;
+		friend class TaskGroup;
+
+		/** Data about a single worker thread. */
+		struct WorkerData
+		{
+			WorkerData(UINT32 idx)
+				:idx(idx)
+			{ }
+
+			UINT32 idx;
+			WorkStealingQueue queue;
+			HThread thread;
+		};
 
-		/**	Main task scheduler method that dispatches tasks to other threads. */
-		void runMain();
+		/**	Main worker thread method that executes tasks from local, global or other workers' queues. */
+		void runWorker(WorkerData* worker);
 
-		/**	Worker method that runs a single task. */
-		void runTask(SPtr<Task> task);
+		/**	Executes a task previously retrieved from one of the queues and notifies any waiters. */
+		void runTask(Task* task);
 
-		/**	Blocks the calling thread until the specified task has completed. */
+		/** Marks the task as completed or canceled, queues any dependant tasks and notifies any waiters. */
+		void finishTask(Task* task, bool canceled);
+
+		/** Places the task in the calling thread's local queue if it has one, or in the global queue otherwise. */
+		void queueTask(const SPtr<Task>& task);
+
+		/**
+		 * Attempts to find a task in the local queue, global queue or any of the other worker queues. Returns null if no
+		 * task is available.
+		 *
+		 * @param[in]	worker		Worker data of the calling thread, or null if the calling thread isn't a worker.
+		 * @param[in]	group		If not null, only tasks belonging to this group will be retrieved, and no tasks will
+		 *							be stolen from other workers. Used for non-worker threads that are helping out while
+		 *							waiting on a group, to ensure they don't pick up unrelated (potentially long running, or
+		 *							lock acquiring) tasks.
+		 */
+		Task* findTask(WorkerData* worker, const TaskGroup* group = nullptr);
+
+		/**
+		 * Blocks the calling thread until the specified task has completed. Worker threads execute other tasks while
+		 * waiting.
+		 */
 		void waitUntilComplete(const Task* task);
 
+		/**	Blocks the calling thread until all tasks in the group have completed, executing other tasks while waiting. */
+		void waitUntilComplete(const TaskGroup* group);
+
+		/** Wakes up any threads waiting on task completion. */
+		void notifyTaskComplete();
+
+		/** Wakes up an idle worker to process newly queued work. */
+		void notifyWorkAvailable();
+
+		/** Starts a new worker thread if the number of allowed workers exceeds the number of started workers. */
+		void spawnWorkers();
+
 		/**	Method used for sorting tasks. */
 		static bool taskCompare(const SPtr<Task>& lhs, const SPtr<Task>& rhs);
 
-		HThread mTaskSchedulerThread;
+		WorkerData* mWorkers[MAX_WORKERS];
+		std::atomic<UINT32> mNumWorkers;
+
 		Set<SPtr<Task>, std::function<bool(const SPtr<Task>&, const SPtr<Task>&)>> mTaskQueue;
-		Vector<SPtr<Task>> mActiveTasks;
-		UINT32 mMaxActiveTasks;
-		UINT32 mNextTaskId;
+		std::atomic<UINT32> mNumQueued;
+		std::atomic<UINT32> mMaxActiveTasks;
+		std::atomic<UINT32> mNextTaskId;
+		std::atomic<UINT64> mWorkEpoch;
+		std::atomic<UINT32> mNumSleeping;
+		std::atomic<UINT32> mNumWaiting;
 		bool mShutdown;
 
 		Mutex mReadyMutex;
 		Mutex mCompleteMutex;
 		Signal mTaskReadyCond;
+		Signal mWorkerParkedCond;
 		Signal mTaskCompleteCond;
+
+		static BS_THREADLOCAL WorkerData* ActiveWorker;
 	};
 
 	/** @} */
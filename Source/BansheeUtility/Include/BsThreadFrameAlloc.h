@@ -0,0 +1,89 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#pragma once
+
+#include "BsPrerequisitesUtil.h"
+
+namespace bs
+{
+	/** @addtogroup Internal-Utility
+	 *  @{
+	 */
+
+	/** @addtogroup Memory-Internal
+	 *  @{
+	 */
+
+	/**
+	 * Provides each thread with its own set of frame allocators, one for each of the last NUM_BUFFERS frames. Intended
+	 * for scratch memory in code running on worker threads (e.g. tasks queued on the TaskScheduler), so such code doesn't
+	 * need to allocate from the heap every frame.
+	 *
+	 * Frames are advanced by calling advanceFrame(), once per simulation frame. Each thread clears its allocator for the
+	 * new frame the first time it requests it, so allocations and clears never require any synchronization between
+	 * threads. Memory allocated during a frame remains valid until NUM_BUFFERS - 1 more frames are started, meaning it can
+	 * be handed off to another thread (e.g. the core thread) as long as that thread is done with it by then.
+	 *
+	 * @note
+	 * Thread safe. Memory must be allocated on the thread that requested the allocator, but can be deallocated on any
+	 * thread. All allocations must be deallocated before the allocator is cleared, same as with FrameAlloc.
+	 */
+	class ThreadFrameAlloc
+	{
+	public:
+		/** Usage statistics of the frame allocators of a single thread. */
+		struct ThreadStats
+		{
+			ThreadId thread;
+			UINT64 lastFrame; /**< Last frame during which the thread used its allocator. */
+			UINT32 lastFrameBytes; /**< Number of bytes allocated during the last completed frame. */
+			UINT32 peakFrameBytes; /**< Highest number of bytes allocated in a single frame. */
+			UINT32 reservedBytes; /**< Number of bytes currently reserved by all of the thread's allocators. */
+		};
+
+		/**
+		 * Returns the frame allocator for the calling thread and the current frame. The allocator must only be used for
+		 * allocation on the calling thread.
+		 */
+		static BS_UTILITY_EXPORT FrameAlloc& get();
+
+		/**
+		 * Starts a new frame. Allocators used during the frame NUM_BUFFERS frames ago will be cleared once their threads
+		 * request them again.
+		 */
+		static BS_UTILITY_EXPORT void advanceFrame();
+
+		/** Returns the index of the current frame. */
+		static BS_UTILITY_EXPORT UINT64 getFrameIdx();
+
+		/**
+		 * Sets up the allocators for the currently active thread. Calling this is optional, as the allocators are created
+		 * when first requested.
+		 */
+		static BS_UTILITY_EXPORT void beginThread();
+
+		/**
+		 * Releases the allocators of the currently active thread, so they can be re-used by another thread. Memory
+		 * allocated by the thread remains valid for the same duration as if the thread didn't end.
+		 */
+		static BS_UTILITY_EXPORT void endThread();
+
+		/** Returns usage statistics for all threads that currently have frame allocators. */
+		static BS_UTILITY_EXPORT Vector<ThreadStats> getStats();
+
+		/** Number of frames an allocation remains valid for. */
+		static const UINT32 NUM_BUFFERS = 2;
+
+	private:
+		struct ThreadAllocs;
+		struct Registry;
+
+		/** Returns the object keeping track of allocators of all threads. */
+		static Registry& getRegistry();
+
+		static BS_THREADLOCAL ThreadAllocs* ActiveAllocs;
+	};
+
+	/** @} */
+	/** @} */
+}
@@ -0,0 +1,23 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#pragma once
+
+#include "BsTestSuite.h"
+
+namespace bs
+{
+	class BS_UTILITY_EXPORT ThreadFrameAllocTestSuite : public TestSuite
+	{
+	public:
+		ThreadFrameAllocTestSuite();
+
+	private:
+		void testGet_same_frame();
+		void testGet_reuse_after_frames();
+		void testAlloc_valid_next_frame();
+		void testAlloc_cleared_on_reuse();
+		void testThreads_separate();
+		void testEndThread_reuse();
+		void testGetStats();
+	};
+}
@@ -56,7 +56,6 @@ namespace bs
 		mTotalBytesWritten = 0;
 		mParams = params;
 
-		Vector<SPtr<IReflectable>> encodedObjects;
 		UINT32 objectId = findOrCreatePersistentId(object);
 		
 		// Encode primary object and its value types
@@ -67,44 +66,25 @@ namespace bs
 				"Destination buffer is null or not large enough.");
 		}
 
-		// Encode pointed to objects and their value types
+		// Encode pointed to objects and their value types, in the order they were queued in. 
+		// Note: Indexing instead of iterating, since encoding an object can queue more objects. Entries are only removed
+		// once encoding is done, which also keeps the objects referenced. The system assigns unique IDs to IReflectable 
+		// objects based on pointer addresses, so if objects got released the same address could be assigned twice.
 		UnorderedSet<UINT32> serializedObjects;
-		while(true)
+		for(UINT32 i = 0; i < (UINT32)mObjectsToEncode.size(); i++)
 		{
-			auto iter = mObjectsToEncode.begin();
-			bool foundObjectToProcess = false;
-			for(; iter != mObjectsToEncode.end(); ++iter)
+			UINT32 curObjectId = mObjectsToEncode[i].objectId;
+			if(!serializedObjects.insert(curObjectId).second)
+				continue; // Already processed
+
+			SPtr<IReflectable> curObject = mObjectsToEncode[i].object;
+			buffer = encodeEntry(curObject.get(), curObjectId, buffer, 
+				bufferLength, bytesWritten, flushBufferCallback, shallow);
+			if(buffer == nullptr)
 			{
-				auto foundExisting = serializedObjects.find(iter->objectId);
-				if(foundExisting != serializedObjects.end())
-					continue; // Already processed
-
-				SPtr<IReflectable> curObject = iter->object;
-				UINT32 curObjectid = iter->objectId;
-				serializedObjects.insert(curObjectid);
-				mObjectsToEncode.erase(iter);
-
-				buffer = encodeEntry(curObject.get(), curObjectid, buffer, 
-					bufferLength, bytesWritten, flushBufferCallback, shallow);
-				if(buffer == nullptr)
-				{
-					BS_EXCEPT(InternalErrorException, 
-						"Destination buffer is null or not large enough.");
-				}
-
-				foundObjectToProcess = true;
-
-				// Ensure we keep a reference to the object so it isn't released.
-				// The system assigns unique IDs to IReflectable objects based on pointer 
-				// addresses but if objects get released then same address could be assigned twice.
-				// Note: To get around this I could assign unique IDs to IReflectable objects
-				encodedObjects.push_back(curObject);
-
-				break; // Need to start over as mObjectsToSerialize was possibly modified
+				BS_EXCEPT(InternalErrorException, 
+					"Destination buffer is null or not large enough.");
 			}
-
-			if(!foundObjectToProcess) // We're done
-				break;
 		}
 
 		// Final flush
@@ -116,7 +96,6 @@ namespace bs
 
 		*bytesWritten = mTotalBytesWritten;
 
-		encodedObjects.clear();
 		mObjectsToEncode.clear();
 		mObjectAddrToId.clear();
 	}
@@ -129,11 +108,51 @@ namespace bs
 		if (dataLength == 0)
 			return nullptr;
 
-		SPtr<SerializedObject> intermediateObject = _decodeToIntermediate(data, dataLength);
-		if (intermediateObject == nullptr)
-			return nullptr;
+		size_t end = data->tell() + dataLength;
+
+		// Find where all the objects are first, so that referenced objects can be decoded before the objects that 
+		// reference them. Field data is skipped at this point.
+		indexObjects(data, end);
+
+		SPtr<IReflectable> output;
+		if (!mEncodedObjects.empty())
+		{
+			EncodedObject& rootObject = mEncodedObjects[0];
+
+			RTTITypeBase* type = IReflectable::_getRTTIfromTypeId(mEncodedSections[rootObject.firstSection].typeId);
+			if (type != nullptr)
+			{
+				rootObject.object = type->newRTTIObject();
+				decodeEncodedObject(rootObject, data, end);
+
+				output = rootObject.object;
+			}
+		}
+
+		// Go through the remaining objects (should be only ones with weak refs). Decoding them can create more such
+		// objects, so repeat until all created objects are decoded.
+		bool decodedAny = true;
+		while (decodedAny)
+		{
+			decodedAny = false;
+			for (auto& encodedObject : mEncodedObjects)
+			{
+				if (encodedObject.object == nullptr || encodedObject.isDecoded)
+					continue;
+
+				decodeEncodedObject(encodedObject, data, end);
+				decodedAny = true;
+			}
+		}
+
+		data->seek(end);
+
+		mEncodedObjects.clear();
+		mEncodedSections.clear();
+		mEncodedObjectIds.clear();
+		mFieldBuffer.clear();
 
-		return _decodeFromIntermediate(intermediateObject);
+		return output;
 	}
 
 	SPtr<IReflectable> BinarySerializer::_decodeFromIntermediate(const SPtr<SerializedObject>& serializedObject)
@@ -1115,6 +1134,508 @@ namespace bs
 		}
 	}
 
+	void BinarySerializer::indexObjects(const SPtr<DataStream>& data, size_t end)
+	{
+		while (data->tell() < end)
+		{
+			EncodedObject encodedObject;
+			encodedObject.firstSection = (UINT32)mEncodedSections.size();
+			encodedObject.isDecoded = false;
+			encodedObject.decodeInProgress = false;
+
+			UINT32 objectId = scanObject(data, end, &mEncodedSections);
+			encodedObject.numSections = (UINT32)mEncodedSections.size() - encodedObject.firstSection;
+
+			if (objectId > 0)
+				mEncodedObjectIds[objectId] = (UINT32)mEncodedObjects.size();
+
+			mEncodedObjects.push_back(encodedObject);
+		}
+	}
+
+	UINT32 BinarySerializer::scanObject(const SPtr<DataStream>& data, size_t end, Vector<EncodedSection>* sections)
+	{
+		ObjectMetaData objectMetaData;
+		objectMetaData.objectMeta = 0;
+		objectMetaData.typeId = 0;
+
+		if (data->read(&objectMetaData, sizeof(ObjectMetaData)) != sizeof(ObjectMetaData))
+		{
+			BS_EXCEPT(InternalErrorException, "Error decoding data.");
+		}
+
+		UINT32 objectId = 0;
+		UINT32 objectTypeId = 0;
+		bool objectIsBaseClass = false;
+		decodeObjectMetaData(objectMetaData, objectId, objectTypeId, objectIsBaseClass);
+
+		if (objectIsBaseClass)
+		{
+			BS_EXCEPT(InternalErrorException, "Encountered a base-class object while looking for a new object. " \
+				"Base class objects are only supposed to be parts of a larger object.");
+		}
+
+		if (sections != nullptr)
+		{
+			EncodedSection section;
+			section.typeId = objectTypeId;
+			section.offset = (UINT64)data->tell();
+
+			sections->push_back(section);
+		}
+
+		while (decodeFields(nullptr, nullptr, data, end))
+		{
+			size_t metaDataOffset = data->tell();
+
+			ObjectMetaData objMetaData;
+			objMetaData.objectMeta = 0;
+			objMetaData.typeId = 0;
+
+			if (data->read(&objMetaData, sizeof(ObjectMetaData)) != sizeof(ObjectMetaData))
+			{
+				BS_EXCEPT(InternalErrorException, "Error decoding data.");
+			}
+
+			UINT32 objId = 0;
+			UINT32 objTypeId = 0;
+			bool objIsBaseClass = false;
+			decodeObjectMetaData(objMetaData, objId, objTypeId, objIsBaseClass);
+
+			if (!objIsBaseClass)
+			{
+				// Found new object, we're done
+				data->seek(metaDataOffset);
+				break;
+			}
+
+			if (sections != nullptr)
+			{
+				EncodedSection section;
+				section.typeId = objTypeId;
+				section.offset = (UINT64)data->tell();
+
+				sections->push_back(section);
+			}
+		}
+
+		return objectId;
+	}
+
+	void BinarySerializer::decodeEncodedObject(EncodedObject& encodedObject, const SPtr<DataStream>& data, size_t end)
+	{
+		encodedObject.decodeInProgress = true;
+		decodeObject(encodedObject.object.get(), &mEncodedSections[encodedObject.firstSection], encodedObject.numSections,
+			data, end);
+		encodedObject.decodeInProgress = false;
+		encodedObject.isDecoded = true;
+	}
+
+	void BinarySerializer::decodeObject(IReflectable* object, const EncodedSection* sections, UINT32 numSections,
+		const SPtr<DataStream>& data, size_t end)
+	{
+		if (numSections == 0)
+			return;
+
+		// Saved and current base classes might not match, in which case the remaining sections are ignored
+		RTTITypeBase** rttiTypes = (RTTITypeBase**)bs_stack_alloc(sizeof(RTTITypeBase*) * numSections);
+
+		UINT32 numTypes = 0;
+		RTTITypeBase* rtti = IReflectable::_getRTTIfromTypeId(sections[0].typeId);
+		while (rtti != nullptr && numTypes < numSections)
+		{
+			if (rtti->getRTTIId() != sections[numTypes].typeId)
+				break;
+
+			rttiTypes[numTypes++] = rtti;
+			rtti = rtti->getBaseClass();
+		}
+
+		for (INT32 i = (INT32)numTypes - 1; i >= 0; i--)
+		{
+			rttiTypes[i]->onDeserializationStarted(object, mParams);
+
+			data->seek(sections[i].offset);
+			decodeFields(object, rttiTypes[i], data, end);
+		}
+
+		for (INT32 i = (INT32)numTypes - 1; i >= 0; i--)
+			rttiTypes[i]->onDeserializationEnded(object, mParams);
+
+		bs_stack_free(rttiTypes);
+	}
+
+	SPtr<IReflectable> BinarySerializer::decodeEmbeddedObject(const SPtr<DataStream>& data, size_t end, bool skip)
+	{
+		size_t metaDataOffset = data->tell();
+
+		ObjectMetaData objectMetaData;
+		objectMetaData.objectMeta = 0;
+		objectMetaData.typeId = 0;
+
+		if (data->read(&objectMetaData, sizeof(ObjectMetaData)) != sizeof(ObjectMetaData))
+		{
+			BS_EXCEPT(InternalErrorException, "Error decoding data.");
+		}
+
+		UINT32 objectId = 0;
+		UINT32 objectTypeId = 0;
+		bool objectIsBaseClass = false;
+		decodeObjectMetaData(objectMetaData, objectId, objectTypeId, objectIsBaseClass);
+
+		RTTITypeBase* rtti = nullptr;
+		if (!skip)
+			rtti = IReflectable::_getRTTIfromTypeId(objectTypeId);
+
+		if (rtti == nullptr)
+		{
+			data->seek(metaDataOffset);
+			scanObject(data, end, nullptr);
+
+			return nullptr;
+		}
+
+		SPtr<IReflectable> object = rtti->newRTTIObject();
+		if (rtti->getBaseClass() != nullptr)
+		{
+			// Base classes are encoded after the derived class but must be decoded before it, so find the sections first
+			data->seek(metaDataOffset);
+
+			Vector<EncodedSection> sections;
+			scanObject(data, end, &sections);
+
+			size_t objectEnd = data->tell();
+			decodeObject(object.get(), sections.data(), (UINT32)sections.size(), data, end);
+			data->seek(objectEnd);
+		}
+		else
+		{
+			rtti->onDeserializationStarted(object.get(), mParams);
+
+			// Any base class data was encoded by an older version of the type, so skip it
+			RTTITypeBase* fieldRtti = rtti;
+			while (decodeFields(object.get(), fieldRtti, data, end))
+			{
+				data->skip(sizeof(ObjectMetaData));
+				fieldRtti = nullptr;
+			}
+
+			rtti->onDeserializationEnded(object.get(), mParams);
+		}
+
+		return object;
+	}
+
+	bool BinarySerializer::decodeFields(IReflectable* object, RTTITypeBase* rtti, const SPtr<DataStream>& data, size_t end)
+	{
+		while (data->tell() < end)
+		{
+			int metaData = -1;
+			if (data->read(&metaData, META_SIZE) != META_SIZE)
+			{
+				BS_EXCEPT(InternalErrorException, "Error decoding data.");
+			}
+
+			if (isObjectMetaData(metaData)) // We've reached a new object or a base class of the current one
+			{
+				data->seek(data->tell() - META_SIZE);
+				return true;
+			}
+
+			bool isArray;
+			SerializableFieldType fieldType;
+			UINT16 fieldId;
+			UINT8 fieldSize;
+			bool hasDynamicSize;
+			bool terminator;
+			decodeFieldMetaData(metaData, fieldId, fieldSize, isArray, fieldType, hasDynamicSize, terminator);
+
+			if (terminator)
+				return false;
+
+			RTTIField* curGenericField = nullptr;
+
+			if (rtti != nullptr)
+				curGenericField = rtti->findField(fieldId);
+
+			if (curGenericField != nullptr)
+			{
+				if (!hasDynamicSize && curGenericField->getTypeSize() != fieldSize)
+				{
+					BS_EXCEPT(InternalErrorException,
+						"Data type mismatch. Type size stored in file and actual type size don't match. ("
+						+ toString(curGenericField->getTypeSize()) + " vs. " + toString(fieldSize) + ")");
+				}
+
+				if (curGenericField->mIsVectorType != isArray)
+				{
+					BS_EXCEPT(InternalErrorException,
+						"Data type mismatch. One is array, other is a single type.");
+				}
+
+				if (curGenericField->mType != fieldType)
+				{
+					BS_EXCEPT(InternalErrorException,
+						"Data type mismatch. Field types don't match. " + toString(UINT32(curGenericField->mType)) + " vs. " + toString(UINT32(fieldType)));
+				}
+			}
+
+			if (isArray)
+			{
+				UINT32 arrayNumElems = 0;
+				if (data->read(&arrayNumElems, NUM_ELEM_FIELD_SIZE) != NUM_ELEM_FIELD_SIZE)
+				{
+					BS_EXCEPT(InternalErrorException, "Error decoding data.");
+				}
+
+				if (curGenericField != nullptr)
+					curGenericField->setArraySize(object, arrayNumElems);
+
+				switch (fieldType)
+				{
+				case SerializableFT_ReflectablePtr:
+				{
+					RTTIReflectablePtrFieldBase* curField = static_cast<RTTIReflectablePtrFieldBase*>(curGenericField);
+
+					if (curField == nullptr)
+					{
+						data->skip(arrayNumElems * COMPLEX_TYPE_FIELD_SIZE);
+						break;
+					}
+
+					for (UINT32 i = 0; i < arrayNumElems; i++)
+					{
+						UINT32 childObjectId = 0;
+						if (data->read(&childObjectId, COMPLEX_TYPE_FIELD_SIZE) != COMPLEX_TYPE_FIELD_SIZE)
+						{
+							BS_EXCEPT(InternalErrorException, "Error decoding data.");
+						}
+
+						curField->setArrayValue(object, i, resolveObjectRef(childObjectId, curField, data, end));
+					}
+
+					break;
+				}
+				case SerializableFT_Reflectable:
+				{
+					RTTIReflectableFieldBase* curField = static_cast<RTTIReflectableFieldBase*>(curGenericField);
+
+					for (UINT32 i = 0; i < arrayNumElems; i++)
+					{
+						SPtr<IReflectable> childObject = decodeEmbeddedObject(data, end, curField == nullptr);
+
+						if (childObject != nullptr)
+							curField->setArrayValue(object, i, *childObject);
+					}
+
+					break;
+				}
+				case SerializableFT_Plain:
+				{
+					RTTIPlainFieldBase* curField = static_cast<RTTIPlainFieldBase*>(curGenericField);
+
+					if (!hasDynamicSize)
+					{
+						if (curField == nullptr)
+						{
+							data->skip(arrayNumElems * fieldSize);
+							break;
+						}
+
+						// Elements have the same size and are tightly packed, so they can be assigned in bulk. File streams
+						// are read in chunks to avoid allocating a buffer for the entire array.
+						UINT32 maxElemsPerRead = arrayNumElems;
+						if (data->isFile())
+							maxElemsPerRead = std::max(MAX_FIELD_READ_SIZE / fieldSize, 1U);
+
+						for (UINT32 i = 0; i < arrayNumElems; i += maxElemsPerRead)
+						{
+							UINT32 numElems = std::min(arrayNumElems - i, maxElemsPerRead);
+
+							UINT8* fieldData = readFieldData(data, numElems * fieldSize);
+							curField->arrayFromBuffer(object, i, numElems, fieldData);
+						}
+					}
+					else
+					{
+						for (UINT32 i = 0; i < arrayNumElems; i++)
+						{
+							UINT32 typeSize = 0;
+							data->read(&typeSize, sizeof(UINT32));
+							data->seek(data->tell() - sizeof(UINT32));
+
+							if (curField != nullptr)
+								curField->arrayElemFromBuffer(object, i, readFieldData(data, typeSize));
+							else
+								data->skip(typeSize);
+						}
+					}
+
+					break;
+				}
+				default:
+					BS_EXCEPT(InternalErrorException,
+						"Error decoding data. Encountered a type I don't know how to decode. Type: " + toString(UINT32(fieldType)) +
+						", Is array: " + toString(isArray));
+				}
+			}
+			else
+			{
+				switch (fieldType)
+				{
+				case SerializableFT_ReflectablePtr:
+				{
+					RTTIReflectablePtrFieldBase* curField = static_cast<RTTIReflectablePtrFieldBase*>(curGenericField);
+
+					UINT32 childObjectId = 0;
+					if (data->read(&childObjectId, COMPLEX_TYPE_FIELD_SIZE) != COMPLEX_TYPE_FIELD_SIZE)
+					{
+						BS_EXCEPT(InternalErrorException, "Error decoding data.");
+					}
+
+					if (curField != nullptr)
+						curField->setValue(object, resolveObjectRef(childObjectId, curField, data, end));
+
+					break;
+				}
+				case SerializableFT_Reflectable:
+				{
+					RTTIReflectableFieldBase* curField = static_cast<RTTIReflectableFieldBase*>(curGenericField);
+
+					SPtr<IReflectable> childObject = decodeEmbeddedObject(data, end, curField == nullptr);
+					if (childObject != nullptr)
+						curField->setValue(object, *childObject);
+
+					break;
+				}
+				case SerializableFT_Plain:
+				{
+					RTTIPlainFieldBase* curField = static_cast<RTTIPlainFieldBase*>(curGenericField);
+
+					UINT32 typeSize = fieldSize;
+					if (hasDynamicSize)
+					{
+						data->read(&typeSize, sizeof(UINT32));
+						data->seek(data->tell() - sizeof(UINT32));
+					}
+
+					if (curField != nullptr)
+						curField->fromBuffer(object, readFieldData(data, typeSize));
+					else
+						data->skip(typeSize);
+
+					break;
+				}
+				case SerializableFT_DataBlock:
+				{
+					RTTIManagedDataBlockFieldBase* curField = static_cast<RTTIManagedDataBlockFieldBase*>(curGenericField);
+
+					// Data block size
+					UINT32 dataBlockSize = 0;
+					if (data->read(&dataBlockSize, DATA_BLOCK_TYPE_FIELD_SIZE) != DATA_BLOCK_TYPE_FIELD_SIZE)
+					{
+						BS_EXCEPT(InternalErrorException, "Error decoding data.");
+					}
+
+					// Data block data, provided directly from the source stream. Memory streams are provided as a region
+					// covering only the data block, so the field cannot access (or copy, when cloning) the rest of the source.
+					if (curField != nullptr)
+					{
+						size_t dataBlockOffset = data->tell();
+
+						if (!data->isFile())
+						{
+							SPtr<MemoryDataStream> memStream = std::static_pointer_cast<MemoryDataStream>(data);
+							SPtr<DataStream> blockStream = bs_shared_ptr_new<MappedRegionDataStream>(memStream, 
+								dataBlockOffset, dataBlockSize);
+
+							curField->setValue(object, blockStream, dataBlockSize);
+						}
+						else
+							curField->setValue(object, data, dataBlockSize);
+
+						data->seek(dataBlockOffset + dataBlockSize);
+					}
+					else
+						data->skip(dataBlockSize);
+
+					break;
+				}
+				default:
+					BS_EXCEPT(InternalErrorException,
+						"Error decoding data. Encountered a type I don't know how to decode. Type: " + toString(UINT32(fieldType)) +
+						", Is array: " + toString(isArray));
+				}
+			}
+		}
+
+		return false;
+	}
+
+	SPtr<IReflectable> BinarySerializer::resolveObjectRef(UINT32 objectId, RTTIReflectablePtrFieldBase* field,
+		const SPtr<DataStream>& data, size_t end)
+	{
+		if (objectId == 0)
+			return nullptr;
+
+		auto iterFind = mEncodedObjectIds.find(objectId);
+		if (iterFind == mEncodedObjectIds.end())
+			return nullptr;
+
+		EncodedObject& encodedObject = mEncodedObjects[iterFind->second];
+		if (encodedObject.object == nullptr)
+		{
+			RTTITypeBase* rtti = IReflectable::_getRTTIfromTypeId(mEncodedSections[encodedObject.firstSection].typeId);
+			if (rtti == nullptr)
+				return nullptr;
+
+			encodedObject.object = rtti->newRTTIObject();
+		}
+
+		bool needsDecoding = (field->getFlags() & RTTI_Flag_WeakRef) == 0 && !encodedObject.isDecoded;
+		if (needsDecoding)
+		{
+			if (encodedObject.decodeInProgress)
+			{
+				LOGWRN("Detected a circular reference when decoding. Referenced object's fields " \
+					"will be resolved in an undefined order (i.e. one of the objects will not " \
+					"be fully deserialized when assigned to its field). Use RTTI_Flag_WeakRef to " \
+					"get rid of this warning and tell the system which of the objects is allowed " \
+					"to be deserialized after it is assigned to its field.");
+			}
+			else
+			{
+				size_t returnOffset = data->tell();
+				decodeEncodedObject(encodedObject, data, end);
+				data->seek(returnOffset);
+			}
+		}
+
+		return encodedObject.object;
+	}
+
+	UINT8* BinarySerializer::readFieldData(const SPtr<DataStream>& data, UINT32 size)
+	{
+		if (!data->isFile())
+		{
+			MemoryDataStream* memStream = static_cast<MemoryDataStream*>(data.get());
+			UINT8* fieldData = memStream->getCurrentPtr();
+
+			data->skip(size);
+			return fieldData;
+		}
+
+		if (mFieldBuffer.size() < size)
+			mFieldBuffer.resize(size);
+
+		if (data->read(mFieldBuffer.data(), size) != size)
+		{
+			BS_EXCEPT(InternalErrorException, "Error decoding data.");
+		}
+
+		return mFieldBuffer.data();
+	}
+
 	UINT32 BinarySerializer::encodeFieldMetaData(UINT16 id, UINT8 size, bool array, 
 		SerializableFieldType type, bool hasDynamicSize, bool terminator)
 	{
@@ -0,0 +1,206 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#include "BsCompression.h"
+
+namespace bs
+{
+	/** Shortest match that can be encoded. */
+	static const UINT32 MIN_MATCH = 4;
+
+	/** Number of bytes at the end of the input that are always encoded as literals. */
+	static const UINT32 LAST_LITERALS = 5;
+
+	/** Matches can't start within this many bytes of the end of the input. */
+	static const UINT32 MATCH_START_LIMIT = 12;
+
+	/** Largest distance between a match and the data it references. */
+	static const UINT32 MAX_OFFSET = 65535;
+
+	/** Number of bits used for indexing the table of recently seen sequences. */
+	static const UINT32 HASH_BITS = 12;
+
+	/** Reads four bytes from a potentially unaligned address. */
+	static UINT32 read32(const UINT8* ptr)
+	{
+		UINT32 value;
+		memcpy(&value, ptr, sizeof(value));
+
+		return value;
+	}
+
+	/** Returns the index of the four byte sequence in the table of recently seen sequences. */
+	static UINT32 hashSequence(UINT32 sequence)
+	{
+		return (sequence * 2654435761U) >> (32 - HASH_BITS);
+	}
+
+	/** Writes the part of a length that doesn't fit into the token, as a sequence of bytes. */
+	static UINT8* writeLength(UINT8* output, size_t length)
+	{
+		while (length >= 255)
+		{
+			*output++ = 255;
+			length -= 255;
+		}
+
+		*output++ = (UINT8)length;
+		return output;
+	}
+
+	/** Writes a sequence of literals, followed by a match unless @p matchLength is zero. */
+	static UINT8* writeSequence(UINT8* output, const UINT8* literals, size_t numLiterals, UINT32 offset, size_t matchLength)
+	{
+		size_t encodedMatchLength = matchLength > 0 ? matchLength - MIN_MATCH : 0;
+
+		UINT8* token = output++;
+		*token = (UINT8)((std::min(numLiterals, (size_t)15) << 4) | std::min(encodedMatchLength, (size_t)15));
+
+		if (numLiterals >= 15)
+			output = writeLength(output, numLiterals - 15);
+
+		memcpy(output, literals, numLiterals);
+		output += numLiterals;
+
+		if (matchLength == 0)
+			return output;
+
+		*output++ = (UINT8)(offset & 0xFF);
+		*output++ = (UINT8)(offset >> 8);
+
+		if (encodedMatchLength >= 15)
+			output = writeLength(output, encodedMatchLength - 15);
+
+		return output;
+	}
+
+	/** Reads the part of a length that didn't fit into the token. Returns false if the input ends prematurely. */
+	static bool readLength(const UINT8*& input, const UINT8* inputEnd, size_t& length)
+	{
+		UINT8 value;
+		do
+		{
+			if (input == inputEnd)
+				return false;
+
+			value = *input++;
+			length += value;
+		} while (value == 255);
+
+		return true;
+	}
+
+	size_t Compression::getMaxCompressedSize(size_t size)
+	{
+		return size + size / 255 + 16;
+	}
+
+	size_t Compression::compress(const UINT8* input, size_t size, UINT8* output)
+	{
+		UINT8* outputStart = output;
+
+		const UINT8* inputEnd = input + size;
+		const UINT8* anchor = input; // Start of literals not yet written
+
+		if (size > MATCH_START_LIMIT)
+		{
+			const UINT8* matchEndLimit = inputEnd - LAST_LITERALS;
+			const UINT8* matchStartLimit = inputEnd - MATCH_START_LIMIT;
+
+			// Offset from the start of the input of the last position each sequence was seen at
+			UINT32 table[1 << HASH_BITS];
+			memset(table, 0, sizeof(table));
+
+			const UINT8* current = input;
+			while (current < matchStartLimit)
+			{
+				UINT32 sequence = read32(current);
+				UINT32 hash = hashSequence(sequence);
+
+				const UINT8* candidate = input + table[hash];
+				table[hash] = (UINT32)(current - input);
+
+				if (candidate >= current || (current - candidate) > MAX_OFFSET || read32(candidate) != sequence)
+				{
+					current++;
+					continue;
+				}
+
+				const UINT8* matchEnd = current + MIN_MATCH;
+				const UINT8* candidateEnd = candidate + MIN_MATCH;
+				while (matchEnd < matchEndLimit && *matchEnd == *candidateEnd)
+				{
+					matchEnd++;
+					candidateEnd++;
+				}
+
+				output = writeSequence(output, anchor, current - anchor, (UINT32)(current - candidate), matchEnd - current);
+
+				current = matchEnd;
+				anchor = current;
+			}
+		}
+
+		// Remaining data is written as a sequence of literals without a match
+		output = writeSequence(output, anchor, inputEnd - anchor, 0, 0);
+
+		return output - outputStart;
+	}
+
+	size_t Compression::decompress(const UINT8* input, size_t size, UINT8* output, size_t outputSize)
+	{
+		const UINT8* inputEnd = input + size;
+		UINT8* outputStart = output;
+		UINT8* outputEnd = output + outputSize;
+
+		while (input < inputEnd)
+		{
+			UINT8 token = *input++;
+
+			size_t numLiterals = token >> 4;
+			if (numLiterals == 15 && !readLength(input, inputEnd, numLiterals))
+				return 0;
+
+			if (numLiterals > (size_t)(inputEnd - input) || numLiterals > (size_t)(outputEnd - output))
+				return 0;
+
+			memcpy(output, input, numLiterals);
+			input += numLiterals;
+			output += numLiterals;
+
+			// Last sequence has no match
+			if (input == inputEnd)
+				break;
+
+			if (inputEnd - input < 2)
+				return 0;
+
+			size_t offset = input[0] | (input[1] << 8);
+			input += 2;
+
+			if (offset == 0 || offset > (size_t)(output - outputStart))
+				return 0;
+
+			size_t matchLength = token & 15;
+			if (matchLength == 15 && !readLength(input, inputEnd, matchLength))
+				return 0;
+
+			matchLength += MIN_MATCH;
+			if (matchLength > (size_t)(outputEnd - output))
+				return 0;
+
+			// Matches can overlap the data being written, in which case the data repeats
+			const UINT8* match = output - offset;
+			if (offset >= matchLength)
+				memcpy(output, match, matchLength);
+			else
+			{
+				for (size_t i = 0; i < matchLength; i++)
+					output[i] = match[i];
+			}
+
+			output += matchLength;
+		}
+
+		return output - outputStart;
+	}
+}
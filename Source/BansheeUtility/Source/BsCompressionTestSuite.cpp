@@ -0,0 +1,203 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#include "BsCompressionTestSuite.h"
+#include "BsCompression.h"
+#include <random>
+
+namespace bs
+{
+	static Vector<UINT8> generateRandom(size_t size, UINT32 seed)
+	{
+		std::mt19937 generator(seed);
+
+		Vector<UINT8> output(size);
+		for (auto& entry : output)
+			entry = (UINT8)generator();
+
+		return output;
+	}
+
+	/** Generates data made out of short random words repeated at random, similar to text or serialized data. */
+	static Vector<UINT8> generateRepetitive(size_t size, UINT32 seed)
+	{
+		std::mt19937 generator(seed);
+
+		static const UINT32 NUM_WORDS = 32;
+		Vector<UINT8> words[NUM_WORDS];
+		for (auto& word : words)
+			word = generateRandom(3 + generator() % 12, generator());
+
+		Vector<UINT8> output;
+		while (output.size() < size)
+		{
+			const Vector<UINT8>& word = words[generator() % NUM_WORDS];
+			output.insert(output.end(), word.begin(), word.end());
+		}
+
+		output.resize(size);
+		return output;
+	}
+
+	static Vector<UINT8> compress(const Vector<UINT8>& input)
+	{
+		Vector<UINT8> output(Compression::getMaxCompressedSize(input.size()));
+		size_t size = Compression::compress(input.data(), input.size(), output.data());
+		output.resize(size);
+
+		return output;
+	}
+
+	/** Compresses and decompresses the data and checks the output matches the input. */
+	static bool roundTrip(const Vector<UINT8>& input)
+	{
+		Vector<UINT8> compressed = compress(input);
+		if (compressed.size() > Compression::getMaxCompressedSize(input.size()))
+			return false;
+
+		Vector<UINT8> output(input.size());
+		size_t size = Compression::decompress(compressed.data(), compressed.size(), output.data(), output.size());
+
+		return size == input.size() && output == input;
+	}
+
+	CompressionTestSuite::CompressionTestSuite()
+	{
+		BS_ADD_TEST(CompressionTestSuite::testRoundTrip_empty);
+		BS_ADD_TEST(CompressionTestSuite::testRoundTrip_small);
+		BS_ADD_TEST(CompressionTestSuite::testRoundTrip_random);
+		BS_ADD_TEST(CompressionTestSuite::testRoundTrip_repetitive);
+		BS_ADD_TEST(CompressionTestSuite::testRoundTrip_long_runs);
+		BS_ADD_TEST(CompressionTestSuite::testDecompress_truncated);
+		BS_ADD_TEST(CompressionTestSuite::testDecompress_small_output);
+		BS_ADD_TEST(CompressionTestSuite::testDecompress_invalid_offset);
+		BS_ADD_TEST(CompressionTestSuite::testDecompress_garbage);
+	}
+
+	void CompressionTestSuite::testRoundTrip_empty()
+	{
+		Vector<UINT8> compressed = compress(Vector<UINT8>());
+		BS_TEST_ASSERT(compressed.size() > 0);
+
+		UINT8 output = 0;
+		BS_TEST_ASSERT(Compression::decompress(compressed.data(), compressed.size(), &output, 0) == 0);
+	}
+
+	void CompressionTestSuite::testRoundTrip_small()
+	{
+		// Covers inputs shorter than the minimum size at which matches are searched for
+		bool success = true;
+		for (UINT32 i = 1; i <= 32; i++)
+		{
+			success &= roundTrip(generateRandom(i, i));
+			success &= roundTrip(Vector<UINT8>(i, (UINT8)i));
+		}
+
+		BS_TEST_ASSERT(success);
+	}
+
+	void CompressionTestSuite::testRoundTrip_random()
+	{
+		BS_TEST_ASSERT(roundTrip(generateRandom(100000, 1)));
+	}
+
+	void CompressionTestSuite::testRoundTrip_repetitive()
+	{
+		Vector<UINT8> input = generateRepetitive(100000, 2);
+		BS_TEST_ASSERT(roundTrip(input));
+
+		Vector<UINT8> compressed = compress(input);
+		BS_TEST_ASSERT(compressed.size() < input.size() / 2);
+	}
+
+	void CompressionTestSuite::testRoundTrip_long_runs()
+	{
+		// Literal and match lengths that don't fit into the token, and matches overlapping the data they reference
+		Vector<UINT8> input = generateRandom(1000, 3);
+		input.insert(input.end(), 5000, 0xAA);
+
+		Vector<UINT8> pattern = generateRandom(7, 4);
+		for (UINT32 i = 0; i < 1000; i++)
+			input.insert(input.end(), pattern.begin(), pattern.end());
+
+		Vector<UINT8> tail = generateRandom(600, 5);
+		input.insert(input.end(), tail.begin(), tail.end());
+
+		BS_TEST_ASSERT(roundTrip(input));
+
+		// Data far apart must still decode correctly, even though the encoder can't reference it directly
+		Vector<UINT8> block = generateRandom(1000, 6);
+		Vector<UINT8> distant = block;
+		Vector<UINT8> filler = generateRandom(70000, 7);
+		distant.insert(distant.end(), filler.begin(), filler.end());
+		distant.insert(distant.end(), block.begin(), block.end());
+
+		BS_TEST_ASSERT(roundTrip(distant));
+	}
+
+	void CompressionTestSuite::testDecompress_truncated()
+	{
+		Vector<UINT8> input = generateRepetitive(4096, 8);
+		Vector<UINT8> compressed = compress(input);
+
+		// Truncated data can decode to a prefix of the original, but never to the full output
+		bool valid = true;
+		Vector<UINT8> output(input.size());
+		for (size_t i = 0; i < compressed.size(); i++)
+		{
+			size_t size = Compression::decompress(compressed.data(), i, output.data(), output.size());
+			valid &= size < input.size();
+			valid &= memcmp(output.data(), input.data(), size) == 0;
+		}
+
+		BS_TEST_ASSERT(valid);
+	}
+
+	void CompressionTestSuite::testDecompress_small_output()
+	{
+		Vector<UINT8> input = generateRepetitive(4096, 9);
+		Vector<UINT8> compressed = compress(input);
+
+		Vector<UINT8> output(input.size());
+		size_t size = Compression::decompress(compressed.data(), compressed.size(), output.data(), output.size() - 1);
+
+		BS_TEST_ASSERT(size == 0);
+	}
+
+	void CompressionTestSuite::testDecompress_invalid_offset()
+	{
+		UINT8 output[64];
+
+		// One literal followed by a match referencing data before the start of the output
+		UINT8 beforeStart[] = { 0x10, 'a', 2, 0 };
+		BS_TEST_ASSERT(Compression::decompress(beforeStart, sizeof(beforeStart), output, sizeof(output)) == 0);
+
+		UINT8 zeroOffset[] = { 0x10, 'a', 0, 0 };
+		BS_TEST_ASSERT(Compression::decompress(zeroOffset, sizeof(zeroOffset), output, sizeof(output)) == 0);
+
+		UINT8 validOffset[] = { 0x10, 'a', 1, 0 };
+		BS_TEST_ASSERT(Compression::decompress(validOffset, sizeof(validOffset), output, sizeof(output)) == 5);
+	}
+
+	void CompressionTestSuite::testDecompress_garbage()
+	{
+		static const UINT32 OUTPUT_SIZE = 1024;
+		static const UINT32 GUARD_SIZE = 64;
+
+		// Corrupt input must not write past the provided output size
+		bool valid = true;
+		Vector<UINT8> output(OUTPUT_SIZE + GUARD_SIZE);
+		for (UINT32 i = 0; i < 1000; i++)
+		{
+			Vector<UINT8> input = generateRandom(1 + i % 200, 100 + i);
+			memset(output.data() + OUTPUT_SIZE, 0xCD, GUARD_SIZE);
+
+			size_t size = Compression::decompress(input.data(), input.size(), output.data(), OUTPUT_SIZE);
+			valid &= size <= OUTPUT_SIZE;
+
+			for (UINT32 j = 0; j < GUARD_SIZE; j++)
+				valid &= output[OUTPUT_SIZE + j] == 0xCD;
+		}
+
+		BS_TEST_ASSERT(valid);
+	}
+}
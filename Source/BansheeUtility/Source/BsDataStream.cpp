@@ -1,6 +1,7 @@
 //********************************** Banshee Engine (www.banshee3d.com) **************************************************//
 //**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
 #include "BsDataStream.h"
+#include "BsFileSystem.h"
 #include "BsDebug.h"
 #include <codecvt>
 
@@ -368,6 +369,51 @@ namespace bs
         }
     }
 
+	MappedFileDataStream::MappedFileDataStream(const Path& filePath, void* memory, size_t size)
+		:MemoryDataStream(memory, size, false), mPath(filePath)
+	{
+		mAccess = READ;
+	}
+
+	MappedFileDataStream::~MappedFileDataStream()
+	{
+		close();
+	}
+
+	bool MappedFileDataStream::getMappedFileLocation(const UINT8* data, Path& filePath, UINT64& offset) const
+	{
+		if (mData == nullptr || data < mData || data > mEnd)
+			return false;
+
+		filePath = mPath;
+		offset = (UINT64)(data - mData);
+		return true;
+	}
+
+	SPtr<DataStream> MappedFileDataStream::clone(bool) const
+	{
+		return FileSystem::openFileMapped(mPath);
+	}
+
+	MappedRegionDataStream::MappedRegionDataStream(const SPtr<MemoryDataStream>& parent, size_t offset, size_t size)
+		:MemoryDataStream(parent->getPtr() + offset, size, false), mParent(parent)
+	{
+		mAccess = READ;
+	}
+
+	SPtr<DataStream> MappedRegionDataStream::clone(bool copyData) const
+	{
+		if (copyData && !mParent->isMapped())
+		{
+			UINT8* data = (UINT8*)bs_alloc((UINT32)mSize);
+			memcpy(data, mData, mSize);
+
+			return bs_shared_ptr_new<MemoryDataStream>(data, mSize);
+		}
+
+		return bs_shared_ptr_new<MappedRegionDataStream>(mParent, mData - mParent->getPtr(), mSize);
+	}
+
     FileDataStream::FileDataStream(const Path& path, AccessMode accessMode, bool freeOnClose)
         : DataStream(accessMode), mPath(path), mFreeOnClose(freeOnClose)
     {
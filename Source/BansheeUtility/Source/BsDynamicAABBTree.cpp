@@ -0,0 +1,472 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#include "BsDynamicAABBTree.h"
+#include "BsConvexVolume.h"
+#include "BsSphere.h"
+#include "BsMath.h"
+
+namespace bs
+{
+	DynamicAABBTree::DynamicAABBTree(float margin)
+		:mRoot((UINT32)-1), mFreeList((UINT32)-1), mNumObjects(0), mMargin(margin)
+	{ }
+
+	UINT32 DynamicAABBTree::insert(const AABox& bounds, UINT32 userData)
+	{
+		UINT32 id = allocateNode();
+		mNodes[id].bounds = bounds;
+		mNodes[id].userData = userData;
+
+		insertLeaf(id);
+		mNumObjects++;
+
+		return id;
+	}
+
+	void DynamicAABBTree::remove(UINT32 id)
+	{
+		assert(id < (UINT32)mNodes.size() && mNodes[id].isLeaf());
+
+		removeLeaf(id);
+		freeNode(id);
+		mNumObjects--;
+	}
+
+	bool DynamicAABBTree::update(UINT32 id, const AABox& bounds)
+	{
+		assert(id < (UINT32)mNodes.size() && mNodes[id].isLeaf());
+
+		if (mNodes[id].bounds.contains(bounds))
+			return false;
+
+		removeLeaf(id);
+
+		// Object is moving, store it with enlarged bounds so small movements don't require re-insertion
+		Vector3 margin = bounds.getSize() * mMargin;
+
+		Node& node = mNodes[id];
+		node.bounds = AABox(bounds.getMin() - margin, bounds.getMax() + margin);
+		node.moved = true;
+
+		insertLeaf(id);
+		return true;
+	}
+
+	void DynamicAABBTree::query(const ConvexVolume& volume, Vector<UINT32>& inside, Vector<UINT32>& intersecting) const
+	{
+		queryVolume(volume, inside, intersecting);
+	}
+
+	void DynamicAABBTree::query(const ConvexVolume& volume, FrameVector<UINT32, StdFrameAlloc<UINT32>>& inside, 
+		FrameVector<UINT32, StdFrameAlloc<UINT32>>& intersecting) const
+	{
+		queryVolume(volume, inside, intersecting);
+	}
+
+	template<class T>
+	void DynamicAABBTree::queryVolume(const ConvexVolume& volume, T& inside, T& intersecting) const
+	{
+		if (mRoot == (UINT32)-1)
+			return;
+
+		const Vector<Plane>& planes = volume.getPlanes();
+		UINT32 numPlanes = (UINT32)planes.size();
+		assert(numPlanes <= 32);
+
+		Vector3* absNormals = (Vector3*)bs_stack_alloc(sizeof(Vector3) * numPlanes);
+		for(UINT32 i = 0; i < numPlanes; i++)
+		{
+			const Vector3& normal = planes[i].normal;
+			absNormals[i] = Vector3(Math::abs(normal.x), Math::abs(normal.y), Math::abs(normal.z));
+		}
+
+		// Each stack entry contains a node index, and a mask of planes the node's parent intersected. Planes the parent
+		// was fully in front of don't need to be tested for the children. If the mask becomes empty the entire sub-tree
+		// is inside the volume.
+		UINT32 maxStackSize = (UINT32)mNodes[mRoot].height + 2;
+		std::pair<UINT32, UINT32>* stack =
+			(std::pair<UINT32, UINT32>*)bs_stack_alloc(sizeof(std::pair<UINT32, UINT32>) * maxStackSize);
+
+		UINT32 stackSize = 0;
+		UINT32 allPlanesMask = numPlanes < 32 ? (1U << numPlanes) - 1 : 0xFFFFFFFF;
+		stack[stackSize++] = std::make_pair(mRoot, allPlanesMask);
+
+		while(stackSize > 0)
+		{
+			UINT32 nodeIdx = stack[stackSize - 1].first;
+			UINT32 planeMask = stack[stackSize - 1].second;
+			stackSize--;
+
+			const Node& node = mNodes[nodeIdx];
+
+			if(planeMask != 0)
+			{
+				Vector3 center = node.bounds.getCenter();
+				Vector3 extents = node.bounds.getHalfSize();
+
+				bool culled = false;
+				for(UINT32 i = 0; i < numPlanes; i++)
+				{
+					UINT32 planeBit = 1U << i;
+					if ((planeMask & planeBit) == 0)
+						continue;
+
+					float dist = center.dot(planes[i].normal) - planes[i].d;
+					float effectiveRadius = extents.dot(absNormals[i]);
+
+					if (dist < -effectiveRadius)
+					{
+						culled = true;
+						break;
+					}
+
+					if (dist >= effectiveRadius)
+						planeMask &= ~planeBit;
+				}
+
+				if (culled)
+					continue;
+			}
+
+			if(node.isLeaf())
+			{
+				if (planeMask == 0)
+					inside.push_back(node.userData);
+				else
+					intersecting.push_back(node.userData);
+			}
+			else
+			{
+				stack[stackSize++] = std::make_pair(node.children[0], planeMask);
+				stack[stackSize++] = std::make_pair(node.children[1], planeMask);
+			}
+		}
+
+		bs_stack_free(stack);
+		bs_stack_free(absNormals);
+	}
+
+	void DynamicAABBTree::query(const Sphere& sphere, Vector<UINT32>& output) const
+	{
+		if (mRoot == (UINT32)-1)
+			return;
+
+		UINT32 maxStackSize = (UINT32)mNodes[mRoot].height + 2;
+		UINT32* stack = (UINT32*)bs_stack_alloc(sizeof(UINT32) * maxStackSize);
+
+		UINT32 stackSize = 0;
+		stack[stackSize++] = mRoot;
+
+		while(stackSize > 0)
+		{
+			const Node& node = mNodes[stack[--stackSize]];
+			if (!node.bounds.intersects(sphere))
+				continue;
+
+			if (node.isLeaf())
+				output.push_back(node.userData);
+			else
+			{
+				stack[stackSize++] = node.children[0];
+				stack[stackSize++] = node.children[1];
+			}
+		}
+
+		bs_stack_free(stack);
+	}
+
+	void DynamicAABBTree::clear()
+	{
+		mNodes.clear();
+		mRoot = (UINT32)-1;
+		mFreeList = (UINT32)-1;
+		mNumObjects = 0;
+	}
+
+	UINT32 DynamicAABBTree::allocateNode()
+	{
+		UINT32 idx;
+		if(mFreeList != (UINT32)-1)
+		{
+			idx = mFreeList;
+			mFreeList = mNodes[idx].parent;
+		}
+		else
+		{
+			idx = (UINT32)mNodes.size();
+			mNodes.push_back(Node());
+		}
+
+		Node& node = mNodes[idx];
+		node.parent = (UINT32)-1;
+		node.children[0] = (UINT32)-1;
+		node.children[1] = (UINT32)-1;
+		node.height = 0;
+		node.userData = (UINT32)-1;
+		node.moved = false;
+
+		return idx;
+	}
+
+	void DynamicAABBTree::freeNode(UINT32 idx)
+	{
+		mNodes[idx].height = -1;
+		mNodes[idx].parent = mFreeList;
+		mFreeList = idx;
+	}
+
+	void DynamicAABBTree::insertLeaf(UINT32 leaf)
+	{
+		if(mRoot == (UINT32)-1)
+		{
+			mRoot = leaf;
+			mNodes[leaf].parent = (UINT32)-1;
+			return;
+		}
+
+		// Find the best sibling for the new leaf, by descending into the child that results in the smallest increase in
+		// surface area
+		AABox leafBounds = mNodes[leaf].bounds;
+
+		UINT32 idx = mRoot;
+		while(!mNodes[idx].isLeaf())
+		{
+			const Node& node = mNodes[idx];
+
+			float cost = getCost(node.bounds);
+			float combinedCost = getCost(merge(node.bounds, leafBounds));
+
+			// Cost of creating a new parent for this node and the new leaf
+			float siblingCost = 2.0f * combinedCost;
+
+			// Minimum cost of pushing the leaf further down the tree
+			float inheritanceCost = 2.0f * (combinedCost - cost);
+
+			float childCosts[2];
+			for(UINT32 i = 0; i < 2; i++)
+			{
+				const Node& child = mNodes[node.children[i]];
+
+				float childCost = getCost(merge(child.bounds, leafBounds));
+				if (!child.isLeaf())
+					childCost -= getCost(child.bounds);
+
+				childCosts[i] = childCost + inheritanceCost;
+			}
+
+			if (siblingCost < childCosts[0] && siblingCost < childCosts[1])
+				break;
+
+			idx = childCosts[0] < childCosts[1] ? node.children[0] : node.children[1];
+		}
+
+		// Create a new parent for the sibling and the new leaf. Note that this might reallocate the node array.
+		UINT32 sibling = idx;
+		UINT32 newParent = allocateNode();
+		UINT32 oldParent = mNodes[sibling].parent;
+
+		Node& parentNode = mNodes[newParent];
+		parentNode.parent = oldParent;
+		parentNode.bounds = merge(leafBounds, mNodes[sibling].bounds);
+		parentNode.height = mNodes[sibling].height + 1;
+		parentNode.children[0] = sibling;
+		parentNode.children[1] = leaf;
+
+		if(oldParent != (UINT32)-1)
+		{
+			Node& oldParentNode = mNodes[oldParent];
+			if (oldParentNode.children[0] == sibling)
+				oldParentNode.children[0] = newParent;
+			else
+				oldParentNode.children[1] = newParent;
+		}
+		else
+			mRoot = newParent;
+
+		mNodes[sibling].parent = newParent;
+		mNodes[leaf].parent = newParent;
+
+		refit(newParent);
+	}
+
+	void DynamicAABBTree::removeLeaf(UINT32 leaf)
+	{
+		if(leaf == mRoot)
+		{
+			mRoot = (UINT32)-1;
+			return;
+		}
+
+		UINT32 parent = mNodes[leaf].parent;
+		UINT32 grandParent = mNodes[parent].parent;
+		UINT32 sibling = mNodes[parent].children[0] == leaf ? mNodes[parent].children[1] : mNodes[parent].children[0];
+
+		// Replace the parent with the sibling
+		if(grandParent != (UINT32)-1)
+		{
+			Node& grandParentNode = mNodes[grandParent];
+			if (grandParentNode.children[0] == parent)
+				grandParentNode.children[0] = sibling;
+			else
+				grandParentNode.children[1] = sibling;
+
+			mNodes[sibling].parent = grandParent;
+			freeNode(parent);
+
+			refit(grandParent);
+		}
+		else
+		{
+			mRoot = sibling;
+			mNodes[sibling].parent = (UINT32)-1;
+			freeNode(parent);
+		}
+	}
+
+	UINT32 DynamicAABBTree::balance(UINT32 idxA)
+	{
+		Node& a = mNodes[idxA];
+		if (a.isLeaf() || a.height < 2)
+			return idxA;
+
+		UINT32 idxB = a.children[0];
+		UINT32 idxC = a.children[1];
+		Node& b = mNodes[idxB];
+		Node& c = mNodes[idxC];
+
+		INT32 balance = c.height - b.height;
+
+		// Rotate C up
+		if(balance > 1)
+		{
+			UINT32 idxF = c.children[0];
+			UINT32 idxG = c.children[1];
+			Node& f = mNodes[idxF];
+			Node& g = mNodes[idxG];
+
+			c.children[0] = idxA;
+			c.parent = a.parent;
+			a.parent = idxC;
+
+			if(c.parent != (UINT32)-1)
+			{
+				Node& parent = mNodes[c.parent];
+				if (parent.children[0] == idxA)
+					parent.children[0] = idxC;
+				else
+					parent.children[1] = idxC;
+			}
+			else
+				mRoot = idxC;
+
+			if(f.height > g.height)
+			{
+				c.children[1] = idxF;
+				a.children[1] = idxG;
+				g.parent = idxA;
+
+				a.bounds = merge(b.bounds, g.bounds);
+				c.bounds = merge(a.bounds, f.bounds);
+				a.height = 1 + std::max(b.height, g.height);
+				c.height = 1 + std::max(a.height, f.height);
+			}
+			else
+			{
+				c.children[1] = idxG;
+				a.children[1] = idxF;
+				f.parent = idxA;
+
+				a.bounds = merge(b.bounds, f.bounds);
+				c.bounds = merge(a.bounds, g.bounds);
+				a.height = 1 + std::max(b.height, f.height);
+				c.height = 1 + std::max(a.height, g.height);
+			}
+
+			return idxC;
+		}
+
+		// Rotate B up
+		if(balance < -1)
+		{
+			UINT32 idxD = b.children[0];
+			UINT32 idxE = b.children[1];
+			Node& d = mNodes[idxD];
+			Node& e = mNodes[idxE];
+
+			b.children[0] = idxA;
+			b.parent = a.parent;
+			a.parent = idxB;
+
+			if(b.parent != (UINT32)-1)
+			{
+				Node& parent = mNodes[b.parent];
+				if (parent.children[0] == idxA)
+					parent.children[0] = idxB;
+				else
+					parent.children[1] = idxB;
+			}
+			else
+				mRoot = idxB;
+
+			if(d.height > e.height)
+			{
+				b.children[1] = idxD;
+				a.children[0] = idxE;
+				e.parent = idxA;
+
+				a.bounds = merge(c.bounds, e.bounds);
+				b.bounds = merge(a.bounds, d.bounds);
+				a.height = 1 + std::max(c.height, e.height);
+				b.height = 1 + std::max(a.height, d.height);
+			}
+			else
+			{
+				b.children[1] = idxE;
+				a.children[0] = idxD;
+				d.parent = idxA;
+
+				a.bounds = merge(c.bounds, d.bounds);
+				b.bounds = merge(a.bounds, e.bounds);
+				a.height = 1 + std::max(c.height, d.height);
+				b.height = 1 + std::max(a.height, e.height);
+			}
+
+			return idxB;
+		}
+
+		return idxA;
+	}
+
+	void DynamicAABBTree::refit(UINT32 idx)
+	{
+		while(idx != (UINT32)-1)
+		{
+			idx = balance(idx);
+
+			Node& node = mNodes[idx];
+			const Node& child0 = mNodes[node.children[0]];
+			const Node& child1 = mNodes[node.children[1]];
+
+			node.height = 1 + std::max(child0.height, child1.height);
+			node.bounds = merge(child0.bounds, child1.bounds);
+
+			idx = node.parent;
+		}
+	}
+
+	float DynamicAABBTree::getCost(const AABox& box)
+	{
+		Vector3 size = box.getMax() - box.getMin();
+		return size.x * size.y + size.y * size.z + size.z * size.x;
+	}
+
+	AABox DynamicAABBTree::merge(const AABox& a, const AABox& b)
+	{
+		Vector3 min = a.getMin();
+		Vector3 max = a.getMax();
+		min.floor(b.getMin());
+		max.ceil(b.getMax());
+
+		return AABox(min, max);
+	}
+}
@@ -0,0 +1,256 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#include "BsDynamicAABBTreeTestSuite.h"
+#include "BsDynamicAABBTree.h"
+#include "BsConvexVolume.h"
+#include "BsSphere.h"
+#include "BsThreadFrameAlloc.h"
+
+#include <algorithm>
+
+namespace bs
+{
+	/** Number of boxes along each axis of the test grid. */
+	static const UINT32 GRID_SIZE = 10;
+
+	/** Returns the bounds of the box at the provided grid index. Boxes are unit sized and spaced two units apart. */
+	static AABox getGridBox(UINT32 idx)
+	{
+		UINT32 x = idx % GRID_SIZE;
+		UINT32 y = (idx / GRID_SIZE) % GRID_SIZE;
+		UINT32 z = idx / (GRID_SIZE * GRID_SIZE);
+
+		Vector3 min(x * 2.0f, y * 2.0f, z * 2.0f);
+		return AABox(min, min + Vector3::ONE);
+	}
+
+	/** Returns a volume in the shape of an axis aligned box. */
+	static ConvexVolume createBoxVolume(const Vector3& min, const Vector3& max)
+	{
+		Vector<Plane> planes =
+		{
+			Plane(Vector3(1.0f, 0.0f, 0.0f), min.x),
+			Plane(Vector3(-1.0f, 0.0f, 0.0f), -max.x),
+			Plane(Vector3(0.0f, 1.0f, 0.0f), min.y),
+			Plane(Vector3(0.0f, -1.0f, 0.0f), -max.y),
+			Plane(Vector3(0.0f, 0.0f, 1.0f), min.z),
+			Plane(Vector3(0.0f, 0.0f, -1.0f), -max.z)
+		};
+
+		return ConvexVolume(planes);
+	}
+
+	/** Fills the tree with a grid of boxes, with each box's user data set to its index. */
+	static void fillTree(DynamicAABBTree& tree, Vector<UINT32>& ids)
+	{
+		UINT32 numBoxes = GRID_SIZE * GRID_SIZE * GRID_SIZE;
+		ids.resize(numBoxes);
+
+		for (UINT32 i = 0; i < numBoxes; i++)
+			ids[i] = tree.insert(getGridBox(i), i);
+	}
+
+	/** Checks if both lists contain the same values, regardless of order. */
+	static bool isSameSet(Vector<UINT32> a, Vector<UINT32> b)
+	{
+		std::sort(a.begin(), a.end());
+		std::sort(b.begin(), b.end());
+
+		return a == b;
+	}
+
+	DynamicAABBTreeTestSuite::DynamicAABBTreeTestSuite()
+	{
+		BS_ADD_TEST(DynamicAABBTreeTestSuite::testQuery_empty);
+		BS_ADD_TEST(DynamicAABBTreeTestSuite::testQuery_sphere);
+		BS_ADD_TEST(DynamicAABBTreeTestSuite::testQuery_volume);
+		BS_ADD_TEST(DynamicAABBTreeTestSuite::testRemove);
+		BS_ADD_TEST(DynamicAABBTreeTestSuite::testUpdate_within_margin);
+		BS_ADD_TEST(DynamicAABBTreeTestSuite::testUpdate_moved);
+		BS_ADD_TEST(DynamicAABBTreeTestSuite::testClear);
+	}
+
+	void DynamicAABBTreeTestSuite::testQuery_empty()
+	{
+		DynamicAABBTree tree;
+
+		Vector<UINT32> output;
+		tree.query(Sphere(Vector3::ZERO, 100.0f), output);
+
+		BS_TEST_ASSERT(output.empty());
+		BS_TEST_ASSERT(tree.getNumObjects() == 0);
+	}
+
+	void DynamicAABBTreeTestSuite::testQuery_sphere()
+	{
+		DynamicAABBTree tree;
+		Vector<UINT32> ids;
+		fillTree(tree, ids);
+
+		BS_TEST_ASSERT(tree.getNumObjects() == (UINT32)ids.size());
+
+		Sphere sphere(Vector3(7.0f, 9.0f, 5.0f), 4.5f);
+
+		Vector<UINT32> expected;
+		for (UINT32 i = 0; i < (UINT32)ids.size(); i++)
+		{
+			if (getGridBox(i).intersects(sphere))
+				expected.push_back(i);
+		}
+
+		Vector<UINT32> output;
+		tree.query(sphere, output);
+
+		BS_TEST_ASSERT(!expected.empty());
+		BS_TEST_ASSERT(isSameSet(output, expected));
+	}
+
+	void DynamicAABBTreeTestSuite::testQuery_volume()
+	{
+		DynamicAABBTree tree;
+		Vector<UINT32> ids;
+		fillTree(tree, ids);
+
+		// Fully contains boxes in [4, 8] range on each axis, and partially the ones at 3 and 9
+		ConvexVolume volume = createBoxVolume(Vector3(3.5f, 3.5f, 3.5f), Vector3(9.5f, 9.5f, 9.5f));
+
+		Vector<UINT32> expectedInside;
+		Vector<UINT32> expectedIntersecting;
+		for (UINT32 i = 0; i < (UINT32)ids.size(); i++)
+		{
+			AABox box = getGridBox(i);
+			if (!volume.intersects(box))
+				continue;
+
+			bool inside = box.getMin().x >= 3.5f && box.getMin().y >= 3.5f && box.getMin().z >= 3.5f &&
+				box.getMax().x <= 9.5f && box.getMax().y <= 9.5f && box.getMax().z <= 9.5f;
+
+			if (inside)
+				expectedInside.push_back(i);
+			else
+				expectedIntersecting.push_back(i);
+		}
+
+		Vector<UINT32> inside;
+		Vector<UINT32> intersecting;
+		tree.query(volume, inside, intersecting);
+
+		BS_TEST_ASSERT(expectedInside.size() == 27);
+		BS_TEST_ASSERT(isSameSet(inside, expectedInside));
+		BS_TEST_ASSERT(isSameSet(intersecting, expectedIntersecting));
+
+		// Frame allocated output must match
+		StdFrameAlloc<UINT32> frameAlloc(&ThreadFrameAlloc::get());
+		FrameVector<UINT32, StdFrameAlloc<UINT32>> frameInside(frameAlloc);
+		FrameVector<UINT32, StdFrameAlloc<UINT32>> frameIntersecting(frameAlloc);
+		tree.query(volume, frameInside, frameIntersecting);
+
+		BS_TEST_ASSERT(isSameSet(Vector<UINT32>(frameInside.begin(), frameInside.end()), expectedInside));
+		BS_TEST_ASSERT(isSameSet(Vector<UINT32>(frameIntersecting.begin(), frameIntersecting.end()), 
+			expectedIntersecting));
+	}
+
+	void DynamicAABBTreeTestSuite::testRemove()
+	{
+		DynamicAABBTree tree;
+		Vector<UINT32> ids;
+		fillTree(tree, ids);
+
+		UINT32 numBoxes = (UINT32)ids.size();
+		for (UINT32 i = 0; i < numBoxes; i += 2)
+			tree.remove(ids[i]);
+
+		BS_TEST_ASSERT(tree.getNumObjects() == numBoxes / 2);
+
+		Sphere sphere(Vector3(10.0f, 10.0f, 10.0f), 6.0f);
+
+		Vector<UINT32> expected;
+		for (UINT32 i = 1; i < numBoxes; i += 2)
+		{
+			if (getGridBox(i).intersects(sphere))
+				expected.push_back(i);
+		}
+
+		Vector<UINT32> output;
+		tree.query(sphere, output);
+
+		BS_TEST_ASSERT(isSameSet(output, expected));
+
+		// Removed slots must be reusable
+		for (UINT32 i = 0; i < numBoxes; i += 2)
+			ids[i] = tree.insert(getGridBox(i), i);
+
+		BS_TEST_ASSERT(tree.getNumObjects() == numBoxes);
+
+		for (UINT32 i = 0; i < numBoxes; i++)
+			BS_TEST_ASSERT(tree.getUserData(ids[i]) == i);
+	}
+
+	void DynamicAABBTreeTestSuite::testUpdate_within_margin()
+	{
+		DynamicAABBTree tree(0.5f);
+
+		AABox box(Vector3::ZERO, Vector3::ONE);
+		UINT32 id = tree.insert(box, 0);
+
+		// First move enlarges the stored bounds by the margin
+		box = AABox(Vector3(0.1f, 0.0f, 0.0f), Vector3(1.1f, 1.0f, 1.0f));
+		BS_TEST_ASSERT(tree.update(id, box));
+		BS_TEST_ASSERT(tree.getBounds(id).contains(box));
+
+		// Small moves after that don't need to modify the tree
+		box = AABox(Vector3(0.2f, 0.0f, 0.0f), Vector3(1.2f, 1.0f, 1.0f));
+		BS_TEST_ASSERT(!tree.update(id, box));
+		BS_TEST_ASSERT(tree.getBounds(id).contains(box));
+	}
+
+	void DynamicAABBTreeTestSuite::testUpdate_moved()
+	{
+		DynamicAABBTree tree;
+		Vector<UINT32> ids;
+		fillTree(tree, ids);
+
+		// Move every box far away along the x axis
+		UINT32 numBoxes = (UINT32)ids.size();
+		Vector3 offset(100.0f, 0.0f, 0.0f);
+		for (UINT32 i = 0; i < numBoxes; i++)
+		{
+			AABox box = getGridBox(i);
+			tree.update(ids[i], AABox(box.getMin() + offset, box.getMax() + offset));
+		}
+
+		Vector<UINT32> output;
+		tree.query(Sphere(Vector3(9.0f, 9.0f, 9.0f), 20.0f), output);
+		BS_TEST_ASSERT(output.empty());
+
+		Sphere sphere(Vector3(107.0f, 9.0f, 5.0f), 4.5f);
+		tree.query(sphere, output);
+
+		// Moved objects are stored with enlarged bounds, so the query may return more objects, but never fewer
+		for (UINT32 i = 0; i < numBoxes; i++)
+		{
+			AABox box = getGridBox(i);
+			if (!AABox(box.getMin() + offset, box.getMax() + offset).intersects(sphere))
+				continue;
+
+			BS_TEST_ASSERT(std::find(output.begin(), output.end(), i) != output.end());
+		}
+
+		for (auto& entry : output)
+			BS_TEST_ASSERT(tree.getBounds(ids[entry]).intersects(sphere));
+	}
+
+	void DynamicAABBTreeTestSuite::testClear()
+	{
+		DynamicAABBTree tree;
+		Vector<UINT32> ids;
+		fillTree(tree, ids);
+
+		tree.clear();
+		BS_TEST_ASSERT(tree.getNumObjects() == 0);
+
+		Vector<UINT32> output;
+		tree.query(Sphere(Vector3::ZERO, 1000.0f), output);
+		BS_TEST_ASSERT(output.empty());
+	}
+}
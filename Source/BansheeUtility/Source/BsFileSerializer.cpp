@@ -63,9 +63,14 @@ namespace bs
 		return bufferStart;
 	}
 
-	FileDecoder::FileDecoder(const Path& fileLocation)
+	FileDecoder::FileDecoder(const Path& fileLocation, bool mapToMemory)
 	{
-		mInputStream = FileSystem::openFile(fileLocation, true);
+		if (mapToMemory)
+			mInputStream = FileSystem::openFileMapped(fileLocation);
+
+		// Fall back to reading the file normally if it cannot be mapped
+		if (mInputStream == nullptr)
+			mInputStream = FileSystem::openFile(fileLocation, true);
 
 		if (mInputStream == nullptr)
 			return;
@@ -77,6 +82,10 @@ namespace bs
 		}
 	}
 
+	FileDecoder::FileDecoder(const SPtr<DataStream>& stream)
+		:mInputStream(stream)
+	{ }
+
 	SPtr<IReflectable> FileDecoder::decode(const UnorderedMap<String, UINT64>& params)
 	{
 		if (mInputStream->eof())
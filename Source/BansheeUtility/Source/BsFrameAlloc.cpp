@@ -235,6 +235,8 @@ namespace bs
 
 				allocBlock(totalBytes);
 			}
+			else if (mBlocks.size() > 0)
+				mBlocks[0]->clear();
 		}
 	}
 
@@ -292,4 +294,22 @@ namespace bs
 		mOwnerThread = thread;
 #endif
 	}
+
+	UINT32 FrameAlloc::getAllocatedBytes() const
+	{
+		UINT32 numBytes = 0;
+		for (auto& block : mBlocks)
+			numBytes += block->mFreePtr;
+
+		return numBytes;
+	}
+
+	UINT32 FrameAlloc::getReservedBytes() const
+	{
+		UINT32 numBytes = 0;
+		for (auto& block : mBlocks)
+			numBytes += block->mSize;
+
+		return numBytes;
+	}
 }
\ No newline at end of file
@@ -0,0 +1,275 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#include "BsPrerequisitesUtil.h"
+#include "BsMemAllocProfiler.h"
+#include "BsSpinLock.h"
+
+namespace bs
+{
+	/** Number of separately locked maps tracked allocations are split into, to reduce contention between threads. */
+	static const UINT32 NUM_ALLOC_SHARDS = 64;
+
+	/** Maximum length of a tag name, including the null terminator. Longer names are truncated. */
+	static const UINT32 MAX_TAG_NAME_LENGTH = 64;
+
+	static const UINT32 NUM_CATEGORIES = (UINT32)MemoryCategory::Count;
+
+	/** Information about a single live allocation, required for attributing its deallocation. */
+	struct TrackedAlloc
+	{
+		size_t bytes;
+		UINT32 tag;
+		MemoryCategory category;
+	};
+
+	typedef UnorderedMap<void*, TrackedAlloc, std::hash<void*>, std::equal_to<void*>,
+		StdAlloc<std::pair<void* const, TrackedAlloc>, ProfilerAlloc>> TrackedAllocMap;
+
+	/** Live allocations whose addresses map to a single shard. */
+	struct AllocShard
+	{
+		SpinLock lock;
+		TrackedAllocMap* allocs; /**< Created when tracking is first enabled and never destroyed. */
+	};
+
+	/** Statistics for a single tag and category. */
+	struct MemoryCounters
+	{
+		std::atomic<INT64> liveBytes;
+		std::atomic<INT64> peakBytes;
+		std::atomic<INT64> liveAllocs;
+		std::atomic<UINT64> totalAllocs;
+		std::atomic<UINT64> totalBytes;
+		std::atomic<UINT64> frameAllocs;
+		std::atomic<UINT64> frameBytes;
+
+		// Only accessed by _update()
+		UINT64 lastTotalAllocs;
+		UINT64 lastTotalBytes;
+	};
+
+	static AllocShard gAllocShards[NUM_ALLOC_SHARDS];
+	static MemoryCounters gMemoryCounters[MemAllocProfiler::MAX_TAGS][NUM_CATEGORIES];
+
+	static Mutex gTagMutex;
+	static char gTagNames[MemAllocProfiler::MAX_TAGS][MAX_TAG_NAME_LENGTH] = { "Untagged" };
+	static std::atomic<UINT32> gNumTags { 1 };
+
+	/** Tag that allocations made by the current thread are tracked under. */
+	static BS_THREADLOCAL UINT32 ThreadTag = MemAllocProfiler::UNTAGGED;
+
+	/** Returns the shard responsible for tracking the allocation at the provided address. */
+	static AllocShard& getShard(void* ptr)
+	{
+		// Low bits are mostly zero due to alignment
+		UINT64 hash = ((UINT64)(uintptr_t)ptr >> 4) * 0x9E3779B97F4A7C15ULL;
+		return gAllocShards[hash >> 58];
+	}
+
+	static_assert(NUM_ALLOC_SHARDS == 64, "Shard selection in getShard() assumes 64 shards.");
+
+	void MemoryCounter::trackAlloc(void* ptr, size_t bytes, MemoryCategory category)
+	{
+		if (ptr == nullptr)
+			return;
+
+		UINT32 tag = ThreadTag;
+
+		AllocShard& shard = getShard(ptr);
+		{
+			ScopedSpinLock lock(shard.lock);
+			if (shard.allocs == nullptr)
+				return;
+
+			(*shard.allocs)[ptr] = { bytes, tag, category };
+		}
+
+		MemoryCounters& counters = gMemoryCounters[tag][(UINT32)category];
+		counters.totalAllocs.fetch_add(1, std::memory_order_relaxed);
+		counters.totalBytes.fetch_add(bytes, std::memory_order_relaxed);
+		counters.liveAllocs.fetch_add(1, std::memory_order_relaxed);
+
+		INT64 liveBytes = counters.liveBytes.fetch_add((INT64)bytes, std::memory_order_relaxed) + (INT64)bytes;
+		INT64 peakBytes = counters.peakBytes.load(std::memory_order_relaxed);
+		while (liveBytes > peakBytes)
+		{
+			if (counters.peakBytes.compare_exchange_weak(peakBytes, liveBytes, std::memory_order_relaxed))
+				break;
+		}
+	}
+
+	void MemoryCounter::trackFree(void* ptr)
+	{
+		if (ptr == nullptr)
+			return;
+
+		TrackedAlloc alloc;
+
+		AllocShard& shard = getShard(ptr);
+		{
+			ScopedSpinLock lock(shard.lock);
+			if (shard.allocs == nullptr)
+				return;
+
+			// Memory allocated before tracking was enabled won't be found
+			auto iterFind = shard.allocs->find(ptr);
+			if (iterFind == shard.allocs->end())
+				return;
+
+			alloc = iterFind->second;
+			shard.allocs->erase(iterFind);
+		}
+
+		MemoryCounters& counters = gMemoryCounters[alloc.tag][(UINT32)alloc.category];
+		counters.liveAllocs.fetch_sub(1, std::memory_order_relaxed);
+		counters.liveBytes.fetch_sub((INT64)alloc.bytes, std::memory_order_relaxed);
+	}
+
+	void MemAllocProfiler::setEnabled(bool enabled)
+	{
+		if (enabled == isEnabled())
+			return;
+
+		if (enabled)
+		{
+			for (UINT32 i = 0; i < MAX_TAGS; i++)
+			{
+				for (UINT32 j = 0; j < NUM_CATEGORIES; j++)
+				{
+					MemoryCounters& counters = gMemoryCounters[i][j];
+					counters.liveBytes.store(0, std::memory_order_relaxed);
+					counters.peakBytes.store(0, std::memory_order_relaxed);
+					counters.liveAllocs.store(0, std::memory_order_relaxed);
+					counters.totalAllocs.store(0, std::memory_order_relaxed);
+					counters.totalBytes.store(0, std::memory_order_relaxed);
+					counters.frameAllocs.store(0, std::memory_order_relaxed);
+					counters.frameBytes.store(0, std::memory_order_relaxed);
+					counters.lastTotalAllocs = 0;
+					counters.lastTotalBytes = 0;
+				}
+			}
+
+			for (UINT32 i = 0; i < NUM_ALLOC_SHARDS; i++)
+			{
+				ScopedSpinLock lock(gAllocShards[i].lock);
+				if (gAllocShards[i].allocs == nullptr)
+					gAllocShards[i].allocs = bs_new<TrackedAllocMap, ProfilerAlloc>();
+			}
+
+			MemoryCounter::TrackingEnabled.store(true, std::memory_order_release);
+		}
+		else
+		{
+			MemoryCounter::TrackingEnabled.store(false, std::memory_order_release);
+
+			// Maps aren't destroyed, as other threads might still be in the process of tracking an allocation
+			for (UINT32 i = 0; i < NUM_ALLOC_SHARDS; i++)
+			{
+				ScopedSpinLock lock(gAllocShards[i].lock);
+				gAllocShards[i].allocs->clear();
+			}
+		}
+	}
+
+	UINT32 MemAllocProfiler::registerTag(const char* name)
+	{
+		Lock lock(gTagMutex);
+
+		UINT32 numTags = gNumTags.load(std::memory_order_relaxed);
+		for (UINT32 i = 0; i < numTags; i++)
+		{
+			if (strncmp(gTagNames[i], name, MAX_TAG_NAME_LENGTH - 1) == 0)
+				return i;
+		}
+
+		if (numTags == MAX_TAGS)
+			return UNTAGGED;
+
+		strncpy(gTagNames[numTags], name, MAX_TAG_NAME_LENGTH - 1);
+		gNumTags.store(numTags + 1, std::memory_order_release);
+
+		return numTags;
+	}
+
+	const char* MemAllocProfiler::getTagName(UINT32 tag)
+	{
+		if (tag >= gNumTags.load(std::memory_order_acquire))
+			return gTagNames[UNTAGGED];
+
+		return gTagNames[tag];
+	}
+
+	void MemAllocProfiler::setThreadTag(UINT32 tag)
+	{
+		ThreadTag = tag;
+	}
+
+	UINT32 MemAllocProfiler::getThreadTag()
+	{
+		return ThreadTag;
+	}
+
+	MemoryStatsList MemAllocProfiler::getStats()
+	{
+		MemoryStatsList output;
+
+		UINT32 numTags = gNumTags.load(std::memory_order_acquire);
+		for (UINT32 i = 0; i < numTags; i++)
+		{
+			for (UINT32 j = 0; j < NUM_CATEGORIES; j++)
+			{
+				MemoryCounters& counters = gMemoryCounters[i][j];
+
+				UINT64 totalAllocs = counters.totalAllocs.load(std::memory_order_relaxed);
+				if (totalAllocs == 0)
+					continue;
+
+				MemoryStats stats;
+				stats.tag = i;
+				stats.tagName = gTagNames[i];
+				stats.category = (MemoryCategory)j;
+				stats.liveBytes = counters.liveBytes.load(std::memory_order_relaxed);
+				stats.peakBytes = counters.peakBytes.load(std::memory_order_relaxed);
+				stats.liveAllocs = counters.liveAllocs.load(std::memory_order_relaxed);
+				stats.totalAllocs = totalAllocs;
+				stats.totalBytes = counters.totalBytes.load(std::memory_order_relaxed);
+				stats.frameAllocs = counters.frameAllocs.load(std::memory_order_relaxed);
+				stats.frameBytes = counters.frameBytes.load(std::memory_order_relaxed);
+
+				output.push_back(stats);
+			}
+		}
+
+		return output;
+	}
+
+	void MemAllocProfiler::_update()
+	{
+		if (!isEnabled())
+			return;
+
+		UINT32 numTags = gNumTags.load(std::memory_order_acquire);
+		for (UINT32 i = 0; i < numTags; i++)
+		{
+			for (UINT32 j = 0; j < NUM_CATEGORIES; j++)
+			{
+				MemoryCounters& counters = gMemoryCounters[i][j];
+
+				// Totals only decrease if statistics were reset since the last update
+				UINT64 totalAllocs = counters.totalAllocs.load(std::memory_order_relaxed);
+				UINT64 totalBytes = counters.totalBytes.load(std::memory_order_relaxed);
+				if (totalAllocs < counters.lastTotalAllocs || totalBytes < counters.lastTotalBytes)
+				{
+					counters.lastTotalAllocs = 0;
+					counters.lastTotalBytes = 0;
+				}
+
+				counters.frameAllocs.store(totalAllocs - counters.lastTotalAllocs, std::memory_order_relaxed);
+				counters.frameBytes.store(totalBytes - counters.lastTotalBytes, std::memory_order_relaxed);
+
+				counters.lastTotalAllocs = totalAllocs;
+				counters.lastTotalBytes = totalBytes;
+			}
+		}
+	}
+}
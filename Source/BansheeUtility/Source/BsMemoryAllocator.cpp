@@ -6,4 +6,6 @@ namespace bs
 {
 	UINT64 BS_THREADLOCAL MemoryCounter::Allocs = 0;
 	UINT64 BS_THREADLOCAL MemoryCounter::Frees = 0;
+	UINT64 BS_THREADLOCAL MemoryCounter::AllocBytes = 0;
+	std::atomic<bool> MemoryCounter::TrackingEnabled { false };
 }
\ No newline at end of file
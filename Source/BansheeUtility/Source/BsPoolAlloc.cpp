@@ -0,0 +1,367 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#include "BsPrerequisitesUtil.h"
+#include "BsPoolAlloc.h"
+
+namespace bs
+{
+	// Note: All of the state below is zero-initialized and must not require any constructors to run, as the allocator
+	// can be used during static initialization.
+
+	/** Number of bits in the address of a slab. Slabs are aligned to their size. */
+	static const UINT32 SLAB_SHIFT = 16;
+
+	/** Size of a single slab, in bytes. */
+	static const UINT32 SLAB_SIZE = 1 << SLAB_SHIFT;
+
+	/** Number of slabs allocated from the general allocator at once, to reduce the memory wasted on alignment. */
+	static const UINT32 SLABS_PER_GROUP = 16;
+
+	/** Difference in element size between two neighbouring size classes. Also the alignment of all elements. */
+	static const UINT32 SIZE_CLASS_STEP = 16;
+
+	/** Number of different element sizes the allocator supports. */
+	static const UINT32 NUM_SIZE_CLASSES = PoolAlloc::MAX_SIZE / SIZE_CLASS_STEP;
+
+	/** Approximate number of bytes moved between a thread cache and the shared free list at once. */
+	static const UINT32 BATCH_BYTES = 4096;
+
+	/** Number of address bits covered by each level of the slab map. Two levels cover a 48-bit address space. */
+	static const UINT32 SLAB_MAP_BITS = 16;
+	static const UINT32 SLAB_MAP_SIZE = 1 << SLAB_MAP_BITS;
+
+	/**
+	 * Shared state of a single size class. Free elements are stored in batches. Elements in a batch are linked through
+	 * their first pointer, while batches are linked through the second pointer of their first element.
+	 */
+	struct PoolSizeClass
+	{
+		std::atomic<bool> locked;
+		void* batches;
+		UINT8* slabPtr; /**< Start of the unused part of the most recently allocated slab. */
+		UINT8* slabEnd;
+	};
+
+	/** Slabs not yet assigned to a size class. */
+	struct PoolSlabGroup
+	{
+		std::atomic<bool> locked;
+		UINT8* slabPtr;
+		UINT8* slabEnd;
+	};
+
+	static PoolSizeClass gPoolSizeClasses[NUM_SIZE_CLASSES];
+	static PoolSlabGroup gPoolSlabGroup;
+	static std::atomic<UINT64> gPoolReservedBytes;
+
+	/**
+	 * Two level map that stores the size class of each slab, indexed by the slab address. Allows free() to determine
+	 * the size class of an element, and whether it was allocated from a slab at all. Entries store the size class index
+	 * incremented by one, or zero for addresses that don't belong to a slab.
+	 */
+	static std::atomic<UINT8*> gPoolSlabMap[SLAB_MAP_SIZE];
+
+	/** Free elements cached by the current thread, for each size class. */
+	static BS_THREADLOCAL void* ThreadElements[NUM_SIZE_CLASSES];
+	static BS_THREADLOCAL UINT32 ThreadNumElements[NUM_SIZE_CLASSES];
+
+	/** Returns the size of elements in the provided size class, in bytes. */
+	static UINT32 getElementSize(UINT32 sizeClass)
+	{
+		return (sizeClass + 1) * SIZE_CLASS_STEP;
+	}
+
+	/** Returns the number of elements moved between a thread cache and the shared free list at once. */
+	static UINT32 getBatchSize(UINT32 sizeClass)
+	{
+		return BATCH_BYTES / getElementSize(sizeClass);
+	}
+
+	/** Acquires exclusive access to shared state protected by the provided flag. */
+	static void lockShared(std::atomic<bool>& locked)
+	{
+		while (locked.exchange(true, std::memory_order_acquire))
+		{
+			while (locked.load(std::memory_order_relaxed))
+				std::this_thread::yield();
+		}
+	}
+
+	/** Releases access acquired with lockShared(). */
+	static void unlockShared(std::atomic<bool>& locked)
+	{
+		locked.store(false, std::memory_order_release);
+	}
+
+	/** Returns the size class of the slab containing the provided address, incremented by one, or zero if none. */
+	static UINT32 findSizeClass(void* ptr)
+	{
+		UINT64 slabIdx = (UINT64)(uintptr_t)ptr >> SLAB_SHIFT;
+		UINT64 mapIdx = slabIdx >> SLAB_MAP_BITS;
+		if (mapIdx >= SLAB_MAP_SIZE)
+			return 0;
+
+		UINT8* leaf = gPoolSlabMap[mapIdx].load(std::memory_order_acquire);
+		if (leaf == nullptr)
+			return 0;
+
+		return leaf[slabIdx & (SLAB_MAP_SIZE - 1)];
+	}
+
+	/** Allocates a new slab and records its size class. Returns null if the slab cannot be used. */
+	static UINT8* allocSlab(UINT32 sizeClass)
+	{
+		UINT8* slab;
+
+		lockShared(gPoolSlabGroup.locked);
+		if (gPoolSlabGroup.slabPtr == gPoolSlabGroup.slabEnd)
+		{
+			UINT32 groupSize = SLAB_SIZE * SLABS_PER_GROUP;
+			UINT8* group = (UINT8*)platformAlignedAlloc(groupSize, SLAB_SIZE);
+
+			// Addresses outside of the range covered by the map cannot be used
+			if (group == nullptr || ((UINT64)(uintptr_t)(group + groupSize - 1) >> (SLAB_SHIFT + SLAB_MAP_BITS)) >= SLAB_MAP_SIZE)
+			{
+				if (group != nullptr)
+					platformAlignedFree(group);
+
+				unlockShared(gPoolSlabGroup.locked);
+				return nullptr;
+			}
+
+			gPoolSlabGroup.slabPtr = group;
+			gPoolSlabGroup.slabEnd = group + groupSize;
+			gPoolReservedBytes.fetch_add(groupSize, std::memory_order_relaxed);
+		}
+
+		slab = gPoolSlabGroup.slabPtr;
+		gPoolSlabGroup.slabPtr += SLAB_SIZE;
+		unlockShared(gPoolSlabGroup.locked);
+
+		UINT64 slabIdx = (UINT64)(uintptr_t)slab >> SLAB_SHIFT;
+		UINT64 mapIdx = slabIdx >> SLAB_MAP_BITS;
+
+		UINT8* leaf = gPoolSlabMap[mapIdx].load(std::memory_order_acquire);
+		if (leaf == nullptr)
+		{
+			UINT8* newLeaf = (UINT8*)calloc(SLAB_MAP_SIZE, 1);
+			if (gPoolSlabMap[mapIdx].compare_exchange_strong(leaf, newLeaf, std::memory_order_acq_rel))
+				leaf = newLeaf;
+			else
+				::free(newLeaf);
+		}
+
+		// Elements from the slab are handed out only after this point, so any thread freeing them will see the entry
+		leaf[slabIdx & (SLAB_MAP_SIZE - 1)] = (UINT8)(sizeClass + 1);
+
+		return slab;
+	}
+
+	/**
+	 * Fills the current thread's cache of the provided size class with a batch of elements, either from the shared free
+	 * list or from a slab. Returns false if no memory could be allocated.
+	 */
+	static bool refillThreadCache(UINT32 sizeClassIdx)
+	{
+		PoolSizeClass& sizeClass = gPoolSizeClasses[sizeClassIdx];
+		UINT32 elementSize = getElementSize(sizeClassIdx);
+
+		void* batch = nullptr;
+		UINT32 numElements = 0;
+
+		lockShared(sizeClass.locked);
+		if (sizeClass.batches != nullptr)
+		{
+			batch = sizeClass.batches;
+			sizeClass.batches = ((void**)batch)[1];
+		}
+		else
+		{
+			if (sizeClass.slabPtr == sizeClass.slabEnd)
+			{
+				UINT8* slab = allocSlab(sizeClassIdx);
+				if (slab == nullptr)
+				{
+					unlockShared(sizeClass.locked);
+					return false;
+				}
+
+				sizeClass.slabPtr = slab;
+				sizeClass.slabEnd = slab + (SLAB_SIZE / elementSize) * elementSize;
+			}
+
+			numElements = std::min(getBatchSize(sizeClassIdx), (UINT32)(sizeClass.slabEnd - sizeClass.slabPtr) / elementSize);
+
+			UINT8* elements = sizeClass.slabPtr;
+			sizeClass.slabPtr += numElements * elementSize;
+
+			for (UINT32 i = 0; i < numElements - 1; i++)
+				*(void**)(elements + i * elementSize) = elements + (i + 1) * elementSize;
+
+			*(void**)(elements + (numElements - 1) * elementSize) = nullptr;
+			batch = elements;
+		}
+		unlockShared(sizeClass.locked);
+
+		// Batches taken from the free list can be of any size, as threads return all their elements when they end
+		if (numElements == 0)
+		{
+			for (void* element = batch; element != nullptr; element = *(void**)element)
+				numElements++;
+		}
+
+		ThreadElements[sizeClassIdx] = batch;
+		ThreadNumElements[sizeClassIdx] = numElements;
+
+		return true;
+	}
+
+	/** Moves a list of elements to the shared free list of the provided size class. */
+	static void releaseBatch(UINT32 sizeClassIdx, void* batch)
+	{
+		PoolSizeClass& sizeClass = gPoolSizeClasses[sizeClassIdx];
+
+		lockShared(sizeClass.locked);
+		((void**)batch)[1] = sizeClass.batches;
+		sizeClass.batches = batch;
+		unlockShared(sizeClass.locked);
+	}
+
+	/** Returns an element to the current thread's cache, moving a batch to the shared free list if the cache is full. */
+	static void freeElement(UINT32 sizeClassIdx, void* ptr)
+	{
+		*(void**)ptr = ThreadElements[sizeClassIdx];
+		ThreadElements[sizeClassIdx] = ptr;
+
+		UINT32 batchSize = getBatchSize(sizeClassIdx);
+		if (++ThreadNumElements[sizeClassIdx] <= batchSize * 2)
+			return;
+
+		void* batch = ThreadElements[sizeClassIdx];
+		void* last = batch;
+		for (UINT32 i = 0; i < batchSize - 1; i++)
+			last = *(void**)last;
+
+		ThreadElements[sizeClassIdx] = *(void**)last;
+		ThreadNumElements[sizeClassIdx] -= batchSize;
+
+		*(void**)last = nullptr;
+		releaseBatch(sizeClassIdx, batch);
+	}
+
+	/** 
+	 * Takes an element of at least the provided size from the current thread's cache. Returns null if no more slabs can 
+	 * be allocated, in which case the caller falls back to the general allocator matching its free method.
+	 */
+	static void* allocateElement(size_t bytes)
+	{
+		UINT32 sizeClassIdx = bytes > 0 ? (UINT32)(bytes - 1) / SIZE_CLASS_STEP : 0;
+		if (ThreadElements[sizeClassIdx] == nullptr)
+		{
+			if (!refillThreadCache(sizeClassIdx))
+				return nullptr;
+		}
+
+		void* element = ThreadElements[sizeClassIdx];
+		ThreadElements[sizeClassIdx] = *(void**)element;
+		ThreadNumElements[sizeClassIdx]--;
+
+		return element;
+	}
+
+	void* PoolAlloc::allocate(size_t bytes)
+	{
+		if (bytes > MAX_SIZE)
+			return malloc(bytes);
+
+		void* element = allocateElement(bytes);
+		if (element == nullptr)
+			return malloc(bytes);
+
+		return element;
+	}
+
+	void* PoolAlloc::allocateAligned(size_t bytes, size_t alignment)
+	{
+		if (alignment > 16)
+			return platformAlignedAlloc(bytes, alignment);
+
+		if (bytes > MAX_SIZE)
+			return platformAlignedAlloc(bytes, alignment);
+
+		// Memory not from the pool is freed with platformAlignedFree(), so it must come from the matching allocator
+		void* element = allocateElement(bytes);
+		if (element == nullptr)
+			return platformAlignedAlloc(bytes, alignment);
+
+		return element;
+	}
+
+	void* PoolAlloc::allocateAligned16(size_t bytes)
+	{
+		if (bytes > MAX_SIZE)
+			return platformAlignedAlloc16(bytes);
+
+		// Memory not from the pool is freed with platformAlignedFree16(), so it must come from the matching allocator
+		void* element = allocateElement(bytes);
+		if (element == nullptr)
+			return platformAlignedAlloc16(bytes);
+
+		return element;
+	}
+
+	void PoolAlloc::free(void* ptr)
+	{
+		if (ptr == nullptr)
+			return;
+
+		UINT32 sizeClass = findSizeClass(ptr);
+		if (sizeClass == 0)
+			::free(ptr);
+		else
+			freeElement(sizeClass - 1, ptr);
+	}
+
+	void PoolAlloc::freeAligned(void* ptr)
+	{
+		if (ptr == nullptr)
+			return;
+
+		UINT32 sizeClass = findSizeClass(ptr);
+		if (sizeClass == 0)
+			platformAlignedFree(ptr);
+		else
+			freeElement(sizeClass - 1, ptr);
+	}
+
+	void PoolAlloc::freeAligned16(void* ptr)
+	{
+		if (ptr == nullptr)
+			return;
+
+		UINT32 sizeClass = findSizeClass(ptr);
+		if (sizeClass == 0)
+			platformAlignedFree16(ptr);
+		else
+			freeElement(sizeClass - 1, ptr);
+	}
+
+	void PoolAlloc::endThread()
+	{
+		for (UINT32 i = 0; i < NUM_SIZE_CLASSES; i++)
+		{
+			if (ThreadElements[i] == nullptr)
+				continue;
+
+			releaseBatch(i, ThreadElements[i]);
+
+			ThreadElements[i] = nullptr;
+			ThreadNumElements[i] = 0;
+		}
+	}
+
+	UINT64 PoolAlloc::getReservedBytes()
+	{
+		return gPoolReservedBytes.load(std::memory_order_relaxed);
+	}
+}
@@ -0,0 +1,230 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#include "BsPoolAllocTestSuite.h"
+
+namespace bs
+{
+	/** Fills the memory with a pattern derived from the provided seed. */
+	static void fillPattern(void* ptr, size_t bytes, UINT32 seed)
+	{
+		UINT8* data = (UINT8*)ptr;
+		for (size_t i = 0; i < bytes; i++)
+			data[i] = (UINT8)(seed + i);
+	}
+
+	/** Checks that the memory contains the pattern written by fillPattern(). */
+	static bool checkPattern(const void* ptr, size_t bytes, UINT32 seed)
+	{
+		const UINT8* data = (const UINT8*)ptr;
+		for (size_t i = 0; i < bytes; i++)
+		{
+			if (data[i] != (UINT8)(seed + i))
+				return false;
+		}
+
+		return true;
+	}
+
+	static bool isAligned(const void* ptr, size_t alignment)
+	{
+		return ((uintptr_t)ptr & (alignment - 1)) == 0;
+	}
+
+	PoolAllocTestSuite::PoolAllocTestSuite()
+	{
+		BS_ADD_TEST(PoolAllocTestSuite::testAllocate_sizes);
+		BS_ADD_TEST(PoolAllocTestSuite::testFree_reuse);
+		BS_ADD_TEST(PoolAllocTestSuite::testFree_no_growth);
+		BS_ADD_TEST(PoolAllocTestSuite::testAllocate_large);
+		BS_ADD_TEST(PoolAllocTestSuite::testAllocate_aligned);
+		BS_ADD_TEST(PoolAllocTestSuite::testFree_other_thread);
+		BS_ADD_TEST(PoolAllocTestSuite::testMultithreaded);
+	}
+
+	void PoolAllocTestSuite::testAllocate_sizes()
+	{
+		Vector<void*> allocs;
+		for (UINT32 i = 0; i <= PoolAlloc::MAX_SIZE; i++)
+		{
+			void* ptr = PoolAlloc::allocate(i);
+			BS_TEST_ASSERT(ptr != nullptr);
+			BS_TEST_ASSERT(isAligned(ptr, 16));
+
+			fillPattern(ptr, i, i);
+			allocs.push_back(ptr);
+		}
+
+		// Neighbouring allocations must not overlap
+		bool intact = true;
+		for (UINT32 i = 0; i <= PoolAlloc::MAX_SIZE; i++)
+			intact &= checkPattern(allocs[i], i, i);
+
+		BS_TEST_ASSERT(intact);
+
+		for (auto& entry : allocs)
+			PoolAlloc::free(entry);
+	}
+
+	void PoolAllocTestSuite::testFree_reuse()
+	{
+		void* first = PoolAlloc::allocate(40);
+		PoolAlloc::free(first);
+
+		// Freed elements go to the thread cache and are handed out again for the same size class
+		void* second = PoolAlloc::allocate(48);
+		BS_TEST_ASSERT(first == second);
+		PoolAlloc::free(second);
+
+		PoolAlloc::free(nullptr);
+	}
+
+	void PoolAllocTestSuite::testFree_no_growth()
+	{
+		static const UINT32 NUM_ALLOCS = 20000;
+
+		Vector<void*> allocs(NUM_ALLOCS);
+		for (UINT32 i = 0; i < NUM_ALLOCS; i++)
+			allocs[i] = PoolAlloc::allocate(64);
+
+		for (auto& entry : allocs)
+			PoolAlloc::free(entry);
+
+		UINT64 reservedBytes = PoolAlloc::getReservedBytes();
+		BS_TEST_ASSERT(reservedBytes > 0);
+
+		// Same number of allocations must be served entirely from the freed elements
+		for (UINT32 i = 0; i < NUM_ALLOCS; i++)
+			allocs[i] = PoolAlloc::allocate(64);
+
+		BS_TEST_ASSERT(PoolAlloc::getReservedBytes() == reservedBytes);
+
+		for (auto& entry : allocs)
+			PoolAlloc::free(entry);
+	}
+
+	void PoolAllocTestSuite::testAllocate_large()
+	{
+		UINT64 reservedBytes = PoolAlloc::getReservedBytes();
+
+		void* ptr = PoolAlloc::allocate(PoolAlloc::MAX_SIZE + 1);
+		BS_TEST_ASSERT(ptr != nullptr);
+
+		fillPattern(ptr, PoolAlloc::MAX_SIZE + 1, 7);
+		BS_TEST_ASSERT(checkPattern(ptr, PoolAlloc::MAX_SIZE + 1, 7));
+		PoolAlloc::free(ptr);
+
+		BS_TEST_ASSERT(PoolAlloc::getReservedBytes() == reservedBytes);
+	}
+
+	void PoolAllocTestSuite::testAllocate_aligned()
+	{
+		void* small16 = PoolAlloc::allocateAligned16(24);
+		void* large16 = PoolAlloc::allocateAligned16(PoolAlloc::MAX_SIZE * 2);
+		void* small64 = PoolAlloc::allocateAligned(24, 64);
+		void* small8 = PoolAlloc::allocateAligned(24, 8);
+
+		BS_TEST_ASSERT(isAligned(small16, 16));
+		BS_TEST_ASSERT(isAligned(large16, 16));
+		BS_TEST_ASSERT(isAligned(small64, 64));
+		BS_TEST_ASSERT(isAligned(small8, 8));
+
+		PoolAlloc::freeAligned16(small16);
+		PoolAlloc::freeAligned16(large16);
+		PoolAlloc::freeAligned(small64);
+		PoolAlloc::freeAligned(small8);
+	}
+
+	void PoolAllocTestSuite::testFree_other_thread()
+	{
+		static const UINT32 NUM_ALLOCS = 5000;
+
+		Vector<void*> allocs(NUM_ALLOCS);
+		Thread thread([&allocs]()
+		{
+			for (UINT32 i = 0; i < NUM_ALLOCS; i++)
+			{
+				allocs[i] = PoolAlloc::allocate(96);
+				fillPattern(allocs[i], 96, i);
+			}
+
+			PoolAlloc::endThread();
+		});
+		thread.join();
+
+		bool intact = true;
+		for (UINT32 i = 0; i < NUM_ALLOCS; i++)
+			intact &= checkPattern(allocs[i], 96, i);
+
+		BS_TEST_ASSERT(intact);
+
+		for (auto& entry : allocs)
+			PoolAlloc::free(entry);
+
+		// Elements freed on this thread are re-used by this thread, regardless of where they were allocated
+		UINT64 reservedBytes = PoolAlloc::getReservedBytes();
+		for (UINT32 i = 0; i < NUM_ALLOCS; i++)
+			allocs[i] = PoolAlloc::allocate(96);
+
+		BS_TEST_ASSERT(PoolAlloc::getReservedBytes() == reservedBytes);
+
+		for (auto& entry : allocs)
+			PoolAlloc::free(entry);
+	}
+
+	void PoolAllocTestSuite::testMultithreaded()
+	{
+		static const UINT32 NUM_THREADS = 4;
+		static const UINT32 NUM_ITERATIONS = 50000;
+		static const UINT32 NUM_LIVE = 256;
+
+		std::atomic<UINT32> numErrors(0);
+		Vector<Thread> threads;
+		for (UINT32 i = 0; i < NUM_THREADS; i++)
+		{
+			threads.push_back(Thread([i, &numErrors]()
+			{
+				void* live[NUM_LIVE] = { };
+				UINT32 sizes[NUM_LIVE] = { };
+				UINT32 seeds[NUM_LIVE] = { };
+
+				UINT32 state = i * 7919 + 1;
+				for (UINT32 j = 0; j < NUM_ITERATIONS; j++)
+				{
+					state = state * 1664525 + 1013904223;
+
+					UINT32 slot = (state >> 8) % NUM_LIVE;
+					if (live[slot] != nullptr)
+					{
+						if (!checkPattern(live[slot], sizes[slot], seeds[slot]))
+							numErrors++;
+
+						PoolAlloc::free(live[slot]);
+					}
+
+					sizes[slot] = (state >> 16) % (PoolAlloc::MAX_SIZE + 1);
+					seeds[slot] = state;
+					live[slot] = PoolAlloc::allocate(sizes[slot]);
+					fillPattern(live[slot], sizes[slot], seeds[slot]);
+				}
+
+				for (UINT32 j = 0; j < NUM_LIVE; j++)
+				{
+					if (live[j] == nullptr)
+						continue;
+
+					if (!checkPattern(live[j], sizes[j], seeds[j]))
+						numErrors++;
+
+					PoolAlloc::free(live[j]);
+				}
+
+				PoolAlloc::endThread();
+			}));
+		}
+
+		for (auto& thread : threads)
+			thread.join();
+
+		BS_TEST_ASSERT(numErrors == 0);
+	}
+}
@@ -0,0 +1,126 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#include "BsRadixSort.h"
+#include "BsTaskScheduler.h"
+
+namespace bs
+{
+	void RadixSort::sort(UINT64* keys, UINT32* values, UINT32 count, UINT64* tmpKeys, UINT32* tmpValues)
+	{
+		if (count < 2)
+			return;
+
+		// Count digits for all passes at once. Passes where all keys share the same digit can be skipped.
+		UINT32 histograms[NUM_PASSES][NUM_BUCKETS];
+		memset(histograms, 0, sizeof(histograms));
+
+		for(UINT32 i = 0; i < count; i++)
+		{
+			UINT64 key = keys[i];
+			for(UINT32 j = 0; j < NUM_PASSES; j++)
+				histograms[j][(key >> (j * RADIX_BITS)) & (NUM_BUCKETS - 1)]++;
+		}
+
+		// When sorting in parallel each task handles a fixed chunk of the input, so per-chunk digit offsets can be
+		// calculated. Scattering chunks in order keeps the sort stable.
+		UINT32 numChunks = 1;
+		if (count >= PARALLEL_MIN_ELEMENTS && TaskScheduler::isStarted())
+			numChunks = std::min((count + ELEMENTS_PER_TASK - 1) / ELEMENTS_PER_TASK, TaskScheduler::MAX_WORKERS);
+
+		Vector<UINT32> chunkOffsets;
+		if (numChunks > 1)
+			chunkOffsets.resize(numChunks * NUM_BUCKETS);
+
+		auto getChunkStart = [&](UINT32 chunk) { return (UINT32)(((UINT64)count * chunk) / numChunks); };
+
+		UINT64* srcKeys = keys;
+		UINT32* srcValues = values;
+		UINT64* dstKeys = tmpKeys;
+		UINT32* dstValues = tmpValues;
+
+		for(UINT32 i = 0; i < NUM_PASSES; i++)
+		{
+			UINT32 shift = i * RADIX_BITS;
+			UINT32 firstDigit = (srcKeys[0] >> shift) & (NUM_BUCKETS - 1);
+			if (histograms[i][firstDigit] == count)
+				continue;
+
+			if(numChunks == 1)
+			{
+				UINT32 offsets[NUM_BUCKETS];
+
+				UINT32 offset = 0;
+				for(UINT32 j = 0; j < NUM_BUCKETS; j++)
+				{
+					offsets[j] = offset;
+					offset += histograms[i][j];
+				}
+
+				for(UINT32 j = 0; j < count; j++)
+				{
+					UINT32 dstIdx = offsets[(srcKeys[j] >> shift) & (NUM_BUCKETS - 1)]++;
+					dstKeys[dstIdx] = srcKeys[j];
+					dstValues[dstIdx] = srcValues[j];
+				}
+			}
+			else
+			{
+				auto countChunks = [&](UINT32 startChunk, UINT32 endChunk)
+				{
+					for(UINT32 j = startChunk; j < endChunk; j++)
+					{
+						UINT32* chunkHistogram = &chunkOffsets[j * NUM_BUCKETS];
+						memset(chunkHistogram, 0, sizeof(UINT32) * NUM_BUCKETS);
+
+						UINT32 end = getChunkStart(j + 1);
+						for (UINT32 k = getChunkStart(j); k < end; k++)
+							chunkHistogram[(srcKeys[k] >> shift) & (NUM_BUCKETS - 1)]++;
+					}
+				};
+
+				TaskScheduler::instance().parallelFor(0, numChunks, 1, countChunks);
+
+				// Convert per-chunk counts into offsets. Entries with the same digit are placed in chunk order.
+				UINT32 offset = 0;
+				for(UINT32 j = 0; j < NUM_BUCKETS; j++)
+				{
+					for(UINT32 k = 0; k < numChunks; k++)
+					{
+						UINT32& chunkOffset = chunkOffsets[k * NUM_BUCKETS + j];
+						UINT32 chunkCount = chunkOffset;
+
+						chunkOffset = offset;
+						offset += chunkCount;
+					}
+				}
+
+				auto scatterChunks = [&](UINT32 startChunk, UINT32 endChunk)
+				{
+					for(UINT32 j = startChunk; j < endChunk; j++)
+					{
+						UINT32* offsets = &chunkOffsets[j * NUM_BUCKETS];
+
+						UINT32 end = getChunkStart(j + 1);
+						for (UINT32 k = getChunkStart(j); k < end; k++)
+						{
+							UINT32 dstIdx = offsets[(srcKeys[k] >> shift) & (NUM_BUCKETS - 1)]++;
+							dstKeys[dstIdx] = srcKeys[k];
+							dstValues[dstIdx] = srcValues[k];
+						}
+					}
+				};
+
+				TaskScheduler::instance().parallelFor(0, numChunks, 1, scatterChunks);
+			}
+
+			std::swap(srcKeys, dstKeys);
+			std::swap(srcValues, dstValues);
+		}
+
+		if(srcKeys != keys)
+		{
+			memcpy(keys, srcKeys, sizeof(UINT64) * count);
+			memcpy(values, srcValues, sizeof(UINT32) * count);
+		}
+	}
+}
@@ -0,0 +1,118 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#include "BsRadixSortTestSuite.h"
+#include "BsRadixSort.h"
+#include "BsTaskScheduler.h"
+#include "BsThreadPool.h"
+
+#include <algorithm>
+#include <random>
+
+namespace bs
+{
+	/** 
+	 * Sorts the provided keys using both RadixSort and std::stable_sort, and checks if the results match. Values are set
+	 * to the original key indices, so the stability of the sort is checked as well.
+	 */
+	static bool sortAndCompare(const Vector<UINT64>& input)
+	{
+		UINT32 count = (UINT32)input.size();
+
+		Vector<std::pair<UINT64, UINT32>> expected(count);
+		for (UINT32 i = 0; i < count; i++)
+			expected[i] = std::make_pair(input[i], i);
+
+		std::stable_sort(expected.begin(), expected.end(),
+			[](auto& a, auto& b) { return a.first < b.first; });
+
+		Vector<UINT64> keys = input;
+		Vector<UINT32> values(count);
+		for (UINT32 i = 0; i < count; i++)
+			values[i] = i;
+
+		Vector<UINT64> tmpKeys(count);
+		Vector<UINT32> tmpValues(count);
+		RadixSort::sort(keys.data(), values.data(), count, tmpKeys.data(), tmpValues.data());
+
+		for (UINT32 i = 0; i < count; i++)
+		{
+			if (keys[i] != expected[i].first || values[i] != expected[i].second)
+				return false;
+		}
+
+		return true;
+	}
+
+	/** Generates the requested number of random keys, with values in [0, maxValue] range. */
+	static Vector<UINT64> generateKeys(UINT32 count, UINT64 maxValue, UINT32 seed)
+	{
+		std::mt19937_64 generator(seed);
+		std::uniform_int_distribution<UINT64> distribution(0, maxValue);
+
+		Vector<UINT64> keys(count);
+		for (auto& key : keys)
+			key = distribution(generator);
+
+		return keys;
+	}
+
+	RadixSortTestSuite::RadixSortTestSuite()
+	{
+		BS_ADD_TEST(RadixSortTestSuite::testSort_empty);
+		BS_ADD_TEST(RadixSortTestSuite::testSort_single);
+		BS_ADD_TEST(RadixSortTestSuite::testSort_random);
+		BS_ADD_TEST(RadixSortTestSuite::testSort_duplicates);
+		BS_ADD_TEST(RadixSortTestSuite::testSort_high_bits);
+		BS_ADD_TEST(RadixSortTestSuite::testSort_parallel);
+	}
+
+	void RadixSortTestSuite::startUp()
+	{
+		ThreadPool::startUp<TThreadPool<>>(TaskScheduler::MAX_WORKERS, TaskScheduler::MAX_WORKERS + 1);
+		TaskScheduler::startUp();
+	}
+
+	void RadixSortTestSuite::shutDown()
+	{
+		TaskScheduler::shutDown();
+		ThreadPool::shutDown();
+	}
+
+	void RadixSortTestSuite::testSort_empty()
+	{
+		BS_TEST_ASSERT(sortAndCompare(Vector<UINT64>()));
+	}
+
+	void RadixSortTestSuite::testSort_single()
+	{
+		BS_TEST_ASSERT(sortAndCompare({ 42 }));
+	}
+
+	void RadixSortTestSuite::testSort_random()
+	{
+		BS_TEST_ASSERT(sortAndCompare(generateKeys(1000, std::numeric_limits<UINT64>::max(), 1)));
+	}
+
+	void RadixSortTestSuite::testSort_duplicates()
+	{
+		BS_TEST_ASSERT(sortAndCompare(generateKeys(1000, 7, 2)));
+	}
+
+	void RadixSortTestSuite::testSort_high_bits()
+	{
+		// Keys only differing in the most significant byte, so every pass except the last one sees identical digits
+		Vector<UINT64> keys = generateKeys(1000, 255, 3);
+		for (auto& key : keys)
+			key <<= 56;
+
+		BS_TEST_ASSERT(sortAndCompare(keys));
+	}
+
+	void RadixSortTestSuite::testSort_parallel()
+	{
+		UINT32 count = RadixSort::PARALLEL_MIN_ELEMENTS * 4 + 17;
+
+		BS_TEST_ASSERT(sortAndCompare(generateKeys(count, std::numeric_limits<UINT64>::max(), 4)));
+		BS_TEST_ASSERT(sortAndCompare(generateKeys(count, 1000, 5)));
+	}
+}
@@ -5,10 +5,13 @@
 
 namespace bs
 {
-	Task::Task(const PrivatelyConstruct& dummy, const String& name, std::function<void()> taskWorker, 
+	BS_THREADLOCAL TaskScheduler::WorkerData* TaskScheduler::ActiveWorker = nullptr;
+	const UINT32 TaskScheduler::MAX_WORKERS;
+
+	Task::Task(const PrivatelyConstruct& dummy, const String& name, std::function<void()> taskWorker,
 		TaskPriority priority, SPtr<Task> dependency)
 		:mName(name), mPriority(priority), mTaskId(0), mTaskWorker(taskWorker), mTaskDependency(dependency),
-		mParent(nullptr)
+		mState(0), mParent(nullptr), mGroup(nullptr)
 	{
 
 	}
@@ -39,56 +42,211 @@ namespace bs
 		mState.store(3);
 	}
 
-	TaskScheduler::TaskScheduler()
-		:mTaskQueue(&TaskScheduler::taskCompare), mMaxActiveTasks(0), mNextTaskId(0), mShutdown(false)
+	TaskGroup::TaskGroup()
+		:mNumPending(0)
+	{ }
+
+	TaskGroup::~TaskGroup()
 	{
-		mMaxActiveTasks = BS_THREAD_HARDWARE_CONCURRENCY;
+		wait();
+	}
+
+	void TaskGroup::run(std::function<void()> taskWorker)
+	{
+		SPtr<Task> task = Task::create(StringUtil::BLANK, std::move(taskWorker));
+		task->mGroup = this;
 
-		mTaskSchedulerThread = ThreadPool::instance().run("TaskScheduler", std::bind(&TaskScheduler::runMain, this));
+		mNumPending.fetch_add(1);
+		TaskScheduler::instance().addTask(task);
 	}
 
-	TaskScheduler::~TaskScheduler()
+	void TaskGroup::wait()
+	{
+		if(mNumPending.load() == 0)
+			return;
+
+		TaskScheduler::instance().waitUntilComplete(this);
+	}
+
+	bool TaskGroup::isComplete() const
+	{
+		return mNumPending.load() == 0;
+	}
+
+	WorkStealingQueue::WorkStealingQueue()
+		:mTop(0), mBottom(0)
+	{
+		for(UINT32 i = 0; i < CAPACITY; i++)
+			mTasks[i].store(nullptr, std::memory_order_relaxed);
+	}
+
+	bool WorkStealingQueue::push(Task* task)
 	{
-		// Wait until all tasks complete
+		INT64 bottom = mBottom.load(std::memory_order_relaxed);
+		INT64 top = mTop.load(std::memory_order_acquire);
+
+		if((bottom - top) >= (INT64)CAPACITY)
+			return false;
+
+		mTasks[bottom & (CAPACITY - 1)].store(task, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_release);
+		mBottom.store(bottom + 1, std::memory_order_relaxed);
+
+		return true;
+	}
+
+	Task* WorkStealingQueue::pop()
+	{
+		INT64 bottom = mBottom.load(std::memory_order_relaxed) - 1;
+		mBottom.store(bottom, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		INT64 top = mTop.load(std::memory_order_relaxed);
+
+		if(top > bottom)
 		{
-			Lock activeTaskLock(mReadyMutex);
+			// Queue is empty
+			mBottom.store(bottom + 1, std::memory_order_relaxed);
+			return nullptr;
+		}
 
-			while (mActiveTasks.size() > 0)
-			{
-				SPtr<Task> task = mActiveTasks[0];
-				activeTaskLock.unlock();
+		Task* task = mTasks[bottom & (CAPACITY - 1)].load(std::memory_order_relaxed);
+		if(top == bottom)
+		{
+			// Last element, race against any stealers
+			if(!mTop.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+				task = nullptr;
 
-				task->wait();
-				activeTaskLock.lock();
-			}
+			mBottom.store(bottom + 1, std::memory_order_relaxed);
 		}
 
-		// Start shutdown of the main queue worker and wait until it exits
+		return task;
+	}
+
+	Task* WorkStealingQueue::steal()
+	{
+		INT64 top = mTop.load(std::memory_order_acquire);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		INT64 bottom = mBottom.load(std::memory_order_acquire);
+
+		if(top >= bottom)
+			return nullptr;
+
+		Task* task = mTasks[top & (CAPACITY - 1)].load(std::memory_order_relaxed);
+		if(!mTop.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+			return nullptr;
+
+		return task;
+	}
+
+	bool WorkStealingQueue::isEmpty() const
+	{
+		return mBottom.load(std::memory_order_relaxed) <= mTop.load(std::memory_order_relaxed);
+	}
+
+	TaskScheduler::TaskScheduler()
+		: mNumWorkers(0), mTaskQueue(&TaskScheduler::taskCompare), mNumQueued(0), mMaxActiveTasks(0), mNextTaskId(0)
+		, mWorkEpoch(0), mNumSleeping(0), mNumWaiting(0), mShutdown(false)
+	{
+		for(UINT32 i = 0; i < MAX_WORKERS; i++)
+			mWorkers[i] = nullptr;
+
+		mMaxActiveTasks = BS_THREAD_HARDWARE_CONCURRENCY;
+
+		Lock lock(mReadyMutex);
+		spawnWorkers();
+	}
+
+	TaskScheduler::~TaskScheduler()
+	{
+		// Signal shutdown to all workers, and wait until they finish their current task
 		{
 			Lock lock(mReadyMutex);
 
 			mShutdown = true;
 		}
 
-		mTaskReadyCond.notify_one();
+		mTaskReadyCond.notify_all();
+		mWorkerParkedCond.notify_all();
+
+		UINT32 numWorkers = mNumWorkers.load();
+		for(UINT32 i = 0; i < numWorkers; i++)
+			mWorkers[i]->thread.blockUntilComplete();
 
-		mTaskSchedulerThread.blockUntilComplete();
+		// Release any tasks that never got to execute
+		for(UINT32 i = 0; i < numWorkers; i++)
+		{
+			Task* task;
+			while((task = mWorkers[i]->queue.pop()) != nullptr)
+				task->mQueuedRef = nullptr;
+
+			bs_delete(mWorkers[i]);
+		}
+
+		for(auto& task : mTaskQueue)
+			task->mQueuedRef = nullptr;
+
+		mTaskQueue.clear();
 	}
 
 	void TaskScheduler::addTask(const SPtr<Task>& task)
 	{
-		Lock lock(mReadyMutex);
-
 		assert(task->mState != 1 && "Task is already executing, it cannot be executed again until it finishes.");
 
 		task->mParent = this;
-		task->mTaskId = mNextTaskId++;
+		task->mTaskId = mNextTaskId.fetch_add(1);
 		task->mState.store(0); // Reset state in case the task is getting re-queued
 
-		mTaskQueue.insert(task);
+		if(task->mTaskDependency != nullptr)
+		{
+			Task* dependency = task->mTaskDependency.get();
 
-		// Wake main scheduler thread
-		mTaskReadyCond.notify_one();
+			ScopedSpinLock lock(dependency->mDependantsLock);
+			UINT32 state = dependency->mState.load();
+
+			// Dependency not finished, it will queue this task once it does
+			if(state != 2 && state != 3)
+			{
+				dependency->mDependants.push_back(task);
+				return;
+			}
+
+			if(state == 3)
+			{
+				task->mState.store(3);
+				return;
+			}
+		}
+
+		queueTask(task);
+	}
+
+	void TaskScheduler::parallelFor(UINT32 begin, UINT32 end, UINT32 grain, const std::function<void(UINT32, UINT32)>& worker)
+	{
+		if(begin >= end)
+			return;
+
+		if(grain == 0)
+			grain = 1;
+
+		TaskGroup group;
+
+		// Recursively split the range in half, queuing one half and continuing with the other. This way only a few tasks
+		// are queued up-front, and the rest are created by whichever thread ends up executing (or stealing) them.
+		std::function<void(UINT32, UINT32)> split = [&](UINT32 start, UINT32 stop)
+		{
+			while((stop - start) > grain)
+			{
+				UINT32 mid = start + (stop - start) / 2;
+				group.run([&split, mid, stop]() { split(mid, stop); });
+
+				stop = mid;
+			}
+
+			worker(start, stop);
+		};
+
+		split(begin, end);
+		group.wait();
 	}
 
 	void TaskScheduler::addWorker()
@@ -96,9 +254,10 @@ namespace bs
 		Lock lock(mReadyMutex);
 
 		mMaxActiveTasks++;
+		spawnWorkers();
 
-		// A spot freed up, queue new tasks on main scheduler thread if they exist
-		mTaskReadyCond.notify_one();
+		// A spot freed up, wake a parked worker if one exists
+		mWorkerParkedCond.notify_all();
 	}
 
 	void TaskScheduler::removeWorker()
@@ -109,58 +268,192 @@ namespace bs
 			mMaxActiveTasks--;
 	}
 
-	void TaskScheduler::runMain()
+	INT32 TaskScheduler::getCurrentWorkerIdx() const
+	{
+		if(ActiveWorker == nullptr)
+			return -1;
+
+		return (INT32)ActiveWorker->idx;
+	}
+
+	void TaskScheduler::spawnWorkers()
+	{
+		UINT32 numWorkers = mNumWorkers.load();
+		while(numWorkers < mMaxActiveTasks && numWorkers < MAX_WORKERS)
+		{
+			WorkerData* worker = bs_new<WorkerData>(numWorkers);
+			mWorkers[numWorkers] = worker;
+
+			// Publish the worker only after it has been fully constructed, so stealing threads never see partial data
+			mNumWorkers.store(numWorkers + 1, std::memory_order_release);
+
+			worker->thread = ThreadPool::instance().run("TaskWorker", std::bind(&TaskScheduler::runWorker, this, worker));
+			numWorkers++;
+		}
+	}
+
+	void TaskScheduler::runWorker(WorkerData* worker)
 	{
+		ActiveWorker = worker;
+
 		while(true)
 		{
+			UINT64 epoch = mWorkEpoch.load();
+
+			// Only workers within the active range are allowed to look for new tasks. Inactive workers still drain their 
+			// local queue before parking, since no other worker is guaranteed to be awake to steal those tasks.
+			Task* task;
+			if(worker->idx < mMaxActiveTasks.load())
+				task = findTask(worker);
+			else
+				task = worker->queue.pop();
+
+			if(task != nullptr)
+			{
+				runTask(task);
+				continue;
+			}
+
 			Lock lock(mReadyMutex);
 
-			while((mTaskQueue.size() == 0 || (UINT32)mActiveTasks.size() >= mMaxActiveTasks) && !mShutdown)
+			while(worker->idx >= mMaxActiveTasks.load() && !mShutdown)
+				mWorkerParkedCond.wait(lock);
+
+			if(mShutdown)
+				break;
+
+			mNumSleeping++;
+			while(mWorkEpoch.load() == epoch && !mShutdown && worker->idx < mMaxActiveTasks.load())
 				mTaskReadyCond.wait(lock);
+			mNumSleeping--;
 
 			if(mShutdown)
 				break;
+		}
 
-			for(UINT32 i = 0; (i < mTaskQueue.size()) && ((UINT32)mActiveTasks.size() < mMaxActiveTasks); i++)
-			{
-				SPtr<Task> curTask = *mTaskQueue.begin();
-				mTaskQueue.erase(mTaskQueue.begin());
+		ActiveWorker = nullptr;
+	}
 
-				if(curTask->isCanceled())
-					continue;
+	Task* TaskScheduler::findTask(WorkerData* worker, const TaskGroup* group)
+	{
+		// Local queue first, as those tasks are likely to use data that's already in cache
+		if(worker != nullptr)
+		{
+			Task* task = worker->queue.pop();
+			if(task != nullptr)
+				return task;
+		}
 
-				if(curTask->mTaskDependency != nullptr && !curTask->mTaskDependency->isComplete())
-					continue;
+		// Global queue
+		if(mNumQueued.load() > 0)
+		{
+			Lock lock(mReadyMutex);
 
-				curTask->mState.store(1);
-				mActiveTasks.push_back(curTask);
+			auto iterFind = mTaskQueue.begin();
+			if(group != nullptr)
+			{
+				while(iterFind != mTaskQueue.end() && (*iterFind)->mGroup != group)
+					++iterFind;
+			}
 
-				ThreadPool::instance().run(curTask->mName, std::bind(&TaskScheduler::runTask, this, curTask));
+			if(iterFind != mTaskQueue.end())
+			{
+				Task* task = iterFind->get();
+				mTaskQueue.erase(iterFind);
+				mNumQueued--;
+
+				return task;
 			}
 		}
+
+		// Stolen tasks can't be inspected before they're taken, so restricted searches don't steal
+		if(group != nullptr)
+			return nullptr;
+
+		// Steal from other workers
+		UINT32 numWorkers = mNumWorkers.load(std::memory_order_acquire);
+		UINT32 start = worker != nullptr ? worker->idx + 1 : 0;
+		for(UINT32 i = 0; i < numWorkers; i++)
+		{
+			WorkerData* victim = mWorkers[(start + i) % numWorkers];
+			if(victim == worker)
+				continue;
+
+			Task* task = victim->queue.steal();
+			if(task != nullptr)
+				return task;
+		}
+
+		return nullptr;
 	}
 
-	void TaskScheduler::runTask(SPtr<Task> task)
+	void TaskScheduler::queueTask(const SPtr<Task>& task)
 	{
-		task->mTaskWorker();
+		// Keep the task alive while it's referenced from the queue
+		task->mQueuedRef = task;
 
+		WorkerData* worker = ActiveWorker;
+		if(worker != nullptr && worker->queue.push(task.get()))
 		{
-			Lock lock(mReadyMutex);
+			notifyWorkAvailable();
+			return;
+		}
 
-			auto findIter = std::find(mActiveTasks.begin(), mActiveTasks.end(), task);
-			if (findIter != mActiveTasks.end())
-				mActiveTasks.erase(findIter);
+		Lock lock(mReadyMutex);
+
+		mTaskQueue.insert(task);
+		mNumQueued++;
+		mWorkEpoch++;
+
+		// Wake all sleeping workers, as any single one might be in the process of getting parked
+		mTaskReadyCond.notify_all();
+	}
+
+	void TaskScheduler::runTask(Task* task)
+	{
+		SPtr<Task> taskPtr = std::move(task->mQueuedRef);
+
+		// Task might have been canceled while it was queued
+		UINT32 expectedState = 0;
+		if(!task->mState.compare_exchange_strong(expectedState, 1))
+		{
+			finishTask(task, true);
+			return;
 		}
 
+		task->mTaskWorker();
+		finishTask(task, false);
+	}
+
+	void TaskScheduler::finishTask(Task* task, bool canceled)
+	{
+		Vector<SPtr<Task>> dependants;
 		{
-			Lock lock(mCompleteMutex);
-			task->mState.store(2);
+			ScopedSpinLock lock(task->mDependantsLock);
+
+			if(!canceled)
+				task->mState.store(2);
 
-			mTaskCompleteCond.notify_all();
+			std::swap(dependants, task->mDependants);
 		}
 
-		// Possibly this task was someones dependency, so wake the main scheduler thread
-		mTaskReadyCond.notify_one();
+		// Note: Group may be destroyed as soon as the counter is decremented, so don't access it afterwards
+		TaskGroup* group = task->mGroup;
+		if(group != nullptr)
+			group->mNumPending.fetch_sub(1);
+
+		for(auto& dependant : dependants)
+		{
+			if(canceled)
+			{
+				dependant->mState.store(3);
+				finishTask(dependant.get(), true);
+			}
+			else
+				queueTask(dependant);
+		}
+
+		notifyTaskComplete();
 	}
 
 	void TaskScheduler::waitUntilComplete(const Task* task)
@@ -168,24 +461,103 @@ namespace bs
 		if(task->isCanceled())
 			return;
 
+		WorkerData* worker = ActiveWorker;
+		if(worker != nullptr)
+		{
+			// Execute other tasks while waiting, so this worker isn't blocked
+			while(!task->isComplete() && !task->isCanceled())
+			{
+				Task* otherTask = findTask(worker);
+				if(otherTask != nullptr)
+				{
+					runTask(otherTask);
+					continue;
+				}
+
+				Lock lock(mCompleteMutex);
+
+				mNumWaiting++;
+				if(!task->isComplete() && !task->isCanceled())
+				{
+					// Nothing to help with, let another worker use this core while we wait
+					addWorker();
+					mTaskCompleteCond.wait(lock);
+					removeWorker();
+				}
+				mNumWaiting--;
+			}
+		}
+		else
 		{
 			Lock lock(mCompleteMutex);
-			
-			while(!task->isComplete())
+
+			mNumWaiting++;
+			while(!task->isComplete() && !task->isCanceled())
 			{
 				addWorker();
 				mTaskCompleteCond.wait(lock);
 				removeWorker();
 			}
+			mNumWaiting--;
 		}
 	}
 
+	void TaskScheduler::waitUntilComplete(const TaskGroup* group)
+	{
+		WorkerData* worker = ActiveWorker;
+		while(!group->isComplete())
+		{
+			// Non-worker threads only help with tasks of the group they're waiting on. Running anything else could block
+			// them for a long time, or deadlock if the task needs a lock the waiting thread is holding.
+			Task* otherTask = findTask(worker, worker == nullptr ? group : nullptr);
+			if(otherTask != nullptr)
+			{
+				runTask(otherTask);
+				continue;
+			}
+
+			Lock lock(mCompleteMutex);
+
+			mNumWaiting++;
+			if(!group->isComplete())
+			{
+				addWorker();
+				mTaskCompleteCond.wait(lock);
+				removeWorker();
+			}
+			mNumWaiting--;
+		}
+	}
+
+	void TaskScheduler::notifyTaskComplete()
+	{
+		if(mNumWaiting.load() == 0)
+			return;
+
+		Lock lock(mCompleteMutex);
+		mTaskCompleteCond.notify_all();
+	}
+
+	void TaskScheduler::notifyWorkAvailable()
+	{
+		mWorkEpoch++;
+
+		if(mNumSleeping.load() == 0)
+			return;
+
+		Lock lock(mReadyMutex);
+		mTaskReadyCond.notify_one();
+	}
+
 	bool TaskScheduler::taskCompare(const SPtr<Task>& lhs, const SPtr<Task>& rhs)
 	{
 		// If one tasks priority is higher, that one goes first
 		if(lhs->mPriority > rhs->mPriority)
 			return true;
 
+		if(lhs->mPriority < rhs->mPriority)
+			return false;
+
 		// Otherwise we go by smaller id, as that task was queued earlier than the other
 		return lhs->mTaskId < rhs->mTaskId;
 	}
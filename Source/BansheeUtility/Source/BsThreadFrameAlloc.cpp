@@ -0,0 +1,186 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#include "BsThreadFrameAlloc.h"
+#include "BsFrameAlloc.h"
+
+namespace bs
+{
+	/** Size of the first memory block of each allocator. Allocators grow as needed. */
+	static const UINT32 THREAD_FRAME_ALLOC_BLOCK_SIZE = 64 * 1024;
+
+	/** Frame allocators belonging to a single thread. */
+	struct ThreadFrameAlloc::ThreadAllocs
+	{
+		ThreadAllocs()
+			:curFrame((UINT64)-1), lastFrame((UINT64)-1), lastFrameBytes(0), peakFrameBytes(0), reservedBytes(0)
+		{
+			for (UINT32 i = 0; i < NUM_BUFFERS; i++)
+				allocs[i] = bs_new<FrameAlloc>(THREAD_FRAME_ALLOC_BLOCK_SIZE);
+		}
+
+		~ThreadAllocs()
+		{
+			for (UINT32 i = 0; i < NUM_BUFFERS; i++)
+				bs_delete(allocs[i]);
+		}
+
+		FrameAlloc* allocs[NUM_BUFFERS];
+		UINT64 curFrame; /**< Frame the thread last requested an allocator for. */
+
+		// Written by the owner thread, read by getStats()
+		ThreadId thread;
+		std::atomic<UINT64> lastFrame;
+		std::atomic<UINT32> lastFrameBytes;
+		std::atomic<UINT32> peakFrameBytes;
+		std::atomic<UINT32> reservedBytes;
+	};
+
+	/** Keeps track of allocators of all threads, and of allocators released by ended threads. */
+	struct ThreadFrameAlloc::Registry
+	{
+		~Registry()
+		{
+			for (auto& entry : active)
+				bs_delete(entry);
+
+			for (auto& entry : unused)
+				bs_delete(entry);
+		}
+
+		Mutex mutex;
+		Vector<ThreadAllocs*> active;
+		Vector<ThreadAllocs*> unused;
+		std::atomic<UINT64> frameIdx { 0 };
+	};
+
+	ThreadFrameAlloc::Registry& ThreadFrameAlloc::getRegistry()
+	{
+		static Registry registry;
+		return registry;
+	}
+
+	BS_THREADLOCAL ThreadFrameAlloc::ThreadAllocs* ThreadFrameAlloc::ActiveAllocs = nullptr;
+
+	FrameAlloc& ThreadFrameAlloc::get()
+	{
+		if (ActiveAllocs == nullptr)
+			beginThread();
+
+		ThreadAllocs* allocs = ActiveAllocs;
+		UINT64 frame = getRegistry().frameIdx.load(std::memory_order_acquire);
+
+		FrameAlloc* alloc = allocs->allocs[frame % NUM_BUFFERS];
+		if (allocs->curFrame != frame)
+		{
+			// First request this frame. The thread is done allocating from the previous frame's allocator, so record its
+			// usage. The allocator for this frame was last used at least NUM_BUFFERS frames ago and can be cleared.
+			if (allocs->curFrame != (UINT64)-1)
+			{
+				UINT32 usedBytes = allocs->allocs[allocs->curFrame % NUM_BUFFERS]->getAllocatedBytes();
+
+				allocs->lastFrameBytes.store(usedBytes, std::memory_order_relaxed);
+				if (usedBytes > allocs->peakFrameBytes.load(std::memory_order_relaxed))
+					allocs->peakFrameBytes.store(usedBytes, std::memory_order_relaxed);
+			}
+
+			alloc->clear();
+			allocs->curFrame = frame;
+
+			UINT32 reservedBytes = 0;
+			for (UINT32 i = 0; i < NUM_BUFFERS; i++)
+				reservedBytes += allocs->allocs[i]->getReservedBytes();
+
+			allocs->reservedBytes.store(reservedBytes, std::memory_order_relaxed);
+			allocs->lastFrame.store(frame, std::memory_order_relaxed);
+		}
+
+		return *alloc;
+	}
+
+	void ThreadFrameAlloc::advanceFrame()
+	{
+		getRegistry().frameIdx.fetch_add(1, std::memory_order_acq_rel);
+	}
+
+	UINT64 ThreadFrameAlloc::getFrameIdx()
+	{
+		return getRegistry().frameIdx.load(std::memory_order_acquire);
+	}
+
+	void ThreadFrameAlloc::beginThread()
+	{
+		if (ActiveAllocs != nullptr)
+			return;
+
+		Registry& registry = getRegistry();
+
+		ThreadAllocs* allocs;
+		{
+			Lock lock(registry.mutex);
+
+			// Re-use allocators of an ended thread if possible. Their contents are left intact, as other threads might
+			// still be using memory allocated by the ended thread.
+			if (!registry.unused.empty())
+			{
+				allocs = registry.unused.back();
+				registry.unused.pop_back();
+			}
+			else
+				allocs = bs_new<ThreadAllocs>();
+
+			allocs->thread = BS_THREAD_CURRENT_ID;
+			allocs->lastFrameBytes.store(0, std::memory_order_relaxed);
+			allocs->peakFrameBytes.store(0, std::memory_order_relaxed);
+
+			registry.active.push_back(allocs);
+		}
+
+		for (UINT32 i = 0; i < NUM_BUFFERS; i++)
+			allocs->allocs[i]->setOwnerThread(allocs->thread);
+
+		ActiveAllocs = allocs;
+	}
+
+	void ThreadFrameAlloc::endThread()
+	{
+		if (ActiveAllocs == nullptr)
+			return;
+
+		Registry& registry = getRegistry();
+		{
+			Lock lock(registry.mutex);
+
+			auto iterFind = std::find(registry.active.begin(), registry.active.end(), ActiveAllocs);
+			if (iterFind != registry.active.end())
+			{
+				*iterFind = registry.active.back();
+				registry.active.pop_back();
+			}
+
+			registry.unused.push_back(ActiveAllocs);
+		}
+
+		ActiveAllocs = nullptr;
+	}
+
+	Vector<ThreadFrameAlloc::ThreadStats> ThreadFrameAlloc::getStats()
+	{
+		Registry& registry = getRegistry();
+		Lock lock(registry.mutex);
+
+		Vector<ThreadStats> output(registry.active.size());
+		for (UINT32 i = 0; i < (UINT32)registry.active.size(); i++)
+		{
+			ThreadAllocs* allocs = registry.active[i];
+			ThreadStats& stats = output[i];
+
+			stats.thread = allocs->thread;
+			stats.lastFrame = allocs->lastFrame.load(std::memory_order_relaxed);
+			stats.lastFrameBytes = allocs->lastFrameBytes.load(std::memory_order_relaxed);
+			stats.peakFrameBytes = allocs->peakFrameBytes.load(std::memory_order_relaxed);
+			stats.reservedBytes = allocs->reservedBytes.load(std::memory_order_relaxed);
+		}
+
+		return output;
+	}
+}
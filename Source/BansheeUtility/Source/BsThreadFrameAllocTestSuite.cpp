@@ -0,0 +1,137 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#include "BsThreadFrameAllocTestSuite.h"
+#include "BsThreadFrameAlloc.h"
+#include "BsFrameAlloc.h"
+
+namespace bs
+{
+	ThreadFrameAllocTestSuite::ThreadFrameAllocTestSuite()
+	{
+		BS_ADD_TEST(ThreadFrameAllocTestSuite::testGet_same_frame);
+		BS_ADD_TEST(ThreadFrameAllocTestSuite::testGet_reuse_after_frames);
+		BS_ADD_TEST(ThreadFrameAllocTestSuite::testAlloc_valid_next_frame);
+		BS_ADD_TEST(ThreadFrameAllocTestSuite::testAlloc_cleared_on_reuse);
+		BS_ADD_TEST(ThreadFrameAllocTestSuite::testThreads_separate);
+		BS_ADD_TEST(ThreadFrameAllocTestSuite::testEndThread_reuse);
+		BS_ADD_TEST(ThreadFrameAllocTestSuite::testGetStats);
+	}
+
+	void ThreadFrameAllocTestSuite::testGet_same_frame()
+	{
+		FrameAlloc* first = &ThreadFrameAlloc::get();
+		FrameAlloc* second = &ThreadFrameAlloc::get();
+
+		BS_TEST_ASSERT(first == second);
+	}
+
+	void ThreadFrameAllocTestSuite::testGet_reuse_after_frames()
+	{
+		FrameAlloc* first = &ThreadFrameAlloc::get();
+
+		ThreadFrameAlloc::advanceFrame();
+		BS_TEST_ASSERT(&ThreadFrameAlloc::get() != first);
+
+		for (UINT32 i = 1; i < ThreadFrameAlloc::NUM_BUFFERS; i++)
+			ThreadFrameAlloc::advanceFrame();
+
+		BS_TEST_ASSERT(&ThreadFrameAlloc::get() == first);
+	}
+
+	void ThreadFrameAllocTestSuite::testAlloc_valid_next_frame()
+	{
+		FrameAlloc& firstAlloc = ThreadFrameAlloc::get();
+		UINT8* first = firstAlloc.alloc(64);
+		memset(first, 0xAB, 64);
+
+		ThreadFrameAlloc::advanceFrame();
+
+		FrameAlloc& secondAlloc = ThreadFrameAlloc::get();
+		UINT8* second = secondAlloc.alloc(64);
+		memset(second, 0xCD, 64);
+
+		// Memory from the previous frame must remain untouched for NUM_BUFFERS - 1 frames
+		bool intact = true;
+		for (UINT32 i = 0; i < 64; i++)
+			intact &= first[i] == 0xAB;
+
+		BS_TEST_ASSERT(intact);
+
+		secondAlloc.dealloc(second);
+		firstAlloc.dealloc(first);
+	}
+
+	void ThreadFrameAllocTestSuite::testAlloc_cleared_on_reuse()
+	{
+		FrameAlloc& alloc = ThreadFrameAlloc::get();
+		UINT8* data = alloc.alloc(128);
+		BS_TEST_ASSERT(alloc.getAllocatedBytes() > 0);
+		alloc.dealloc(data);
+
+		for (UINT32 i = 0; i < ThreadFrameAlloc::NUM_BUFFERS; i++)
+			ThreadFrameAlloc::advanceFrame();
+
+		FrameAlloc& reusedAlloc = ThreadFrameAlloc::get();
+		BS_TEST_ASSERT(&reusedAlloc == &alloc);
+		BS_TEST_ASSERT(reusedAlloc.getAllocatedBytes() == 0);
+	}
+
+	void ThreadFrameAllocTestSuite::testThreads_separate()
+	{
+		FrameAlloc* otherAlloc = nullptr;
+		Thread thread([&otherAlloc]()
+		{
+			otherAlloc = &ThreadFrameAlloc::get();
+			ThreadFrameAlloc::endThread();
+		});
+		thread.join();
+
+		BS_TEST_ASSERT(otherAlloc != nullptr);
+		BS_TEST_ASSERT(otherAlloc != &ThreadFrameAlloc::get());
+	}
+
+	void ThreadFrameAllocTestSuite::testEndThread_reuse()
+	{
+		FrameAlloc* firstAlloc = nullptr;
+		Thread firstThread([&firstAlloc]()
+		{
+			firstAlloc = &ThreadFrameAlloc::get();
+			ThreadFrameAlloc::endThread();
+		});
+		firstThread.join();
+
+		// Allocators of an ended thread are handed to the next thread that starts using the allocator
+		FrameAlloc* secondAlloc = nullptr;
+		Thread secondThread([&secondAlloc]()
+		{
+			secondAlloc = &ThreadFrameAlloc::get();
+			ThreadFrameAlloc::endThread();
+		});
+		secondThread.join();
+
+		BS_TEST_ASSERT(firstAlloc != nullptr);
+		BS_TEST_ASSERT(firstAlloc == secondAlloc);
+	}
+
+	void ThreadFrameAllocTestSuite::testGetStats()
+	{
+		FrameAlloc& alloc = ThreadFrameAlloc::get();
+		UINT8* data = alloc.alloc(256);
+
+		ThreadId threadId = BS_THREAD_CURRENT_ID;
+		Vector<ThreadFrameAlloc::ThreadStats> stats = ThreadFrameAlloc::getStats();
+
+		bool found = false;
+		for (auto& entry : stats)
+		{
+			if (entry.thread != threadId)
+				continue;
+
+			found = true;
+			BS_TEST_ASSERT(entry.reservedBytes > 0);
+		}
+
+		BS_TEST_ASSERT(found);
+		alloc.dealloc(data);
+	}
+}
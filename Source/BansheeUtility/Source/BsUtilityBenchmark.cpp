@@ -0,0 +1,455 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#include "BsPrerequisitesUtil.h"
+#include "BsIReflectable.h"
+#include "BsRTTIType.h"
+#include "BsBinarySerializer.h"
+#include "BsMemorySerializer.h"
+#include "BsSerializedObject.h"
+#include "BsDataStream.h"
+#include "BsMemAllocProfiler.h"
+#include "BsTimer.h"
+#include "BsMemStack.h"
+#include "BsPoolAlloc.h"
+
+#include <iostream>
+#include <iomanip>
+#include <random>
+
+#if BS_PLATFORM == BS_PLATFORM_WIN32
+#  define WIN32_LEAN_AND_MEAN
+#  if !defined(NOMINMAX) && defined(_MSC_VER)
+#	define NOMINMAX // required to stop windows.h messing up std::min
+#  endif
+#  include <windows.h>
+#  include <psapi.h>
+#elif BS_PLATFORM == BS_PLATFORM_LINUX
+#  include <unistd.h>
+#endif
+
+using namespace bs;
+
+/**
+ * Calls the provided function repeatedly for at least the provided number of iterations, and for at least 200ms. Returns
+ * the average time of a single call, in microseconds.
+ */
+template<class T>
+static double measure(T func, UINT32 minIterations)
+{
+	static const UINT64 MIN_DURATION_US = 200000;
+
+	// Warm up caches and any lazily built data
+	func();
+
+	Timer timer;
+	UINT32 numIterations = 0;
+	while (numIterations < minIterations || timer.getMicroseconds() < MIN_DURATION_US)
+	{
+		func();
+		numIterations++;
+	}
+
+	return timer.getMicroseconds() / (double)numIterations;
+}
+
+/**
+ * Calls the provided function once with allocation tracking enabled, and returns the highest amount of memory that was
+ * live during the call, in kilobytes. Peaks are summed over all allocator categories and tags, so the returned value is
+ * an upper bound if the peaks of individual categories happened at different times.
+ */
+template<class T>
+static double measurePeakMemory(T func)
+{
+	MemAllocProfiler::setEnabled(true);
+	func();
+	MemAllocProfiler::setEnabled(false);
+
+	INT64 peakBytes = 0;
+	for (auto& entry : MemAllocProfiler::getStats())
+		peakBytes += entry.peakBytes;
+
+	return peakBytes / 1024.0;
+}
+
+/**
+ * Outputs a single benchmark result row, comparing the current implementation with a reference one. Set @p higherIsBetter
+ * if the values are rates rather than durations.
+ */
+static void printResult(const String& name, double current, double reference, const char* unit = "us",
+	bool higherIsBetter = false)
+{
+	double speedup = higherIsBetter ? (current / reference) : (reference / current);
+
+	std::cout << std::left << std::setw(40) << name << std::right << std::fixed << std::setprecision(3)
+		<< std::setw(14) << current << " " << unit << std::setw(14) << reference << " " << unit
+		<< std::setw(10) << std::setprecision(2) << speedup << "x" << std::endl;
+}
+
+/** Outputs the header of a benchmark result table. */
+static void printHeader(const String& title, const String& reference, const String& ratio = "speedup")
+{
+	std::cout << std::endl << title << std::endl;
+	std::cout << std::left << std::setw(40) << "" << std::right << std::setw(17) << "current" << std::setw(17)
+		<< reference << std::setw(11) << ratio << std::endl;
+}
+
+/************************************************************************/
+/* 								SERIALIZATION                      		*/
+/************************************************************************/
+
+/** Node in a tree of serializable objects, used for benchmarking the binary serializer. */
+class BenchmarkNode : public IReflectable
+{
+public:
+	UINT32 mId = 0;
+	float mWeight = 0.0f;
+	String mName;
+	Vector<float> mSamples;
+	Vector<SPtr<BenchmarkNode>> mChildren;
+
+	static RTTITypeBase* getRTTIStatic();
+	RTTITypeBase* getRTTI() const override;
+};
+
+class BenchmarkNodeRTTI : public RTTIType<BenchmarkNode, IReflectable, BenchmarkNodeRTTI>
+{
+private:
+	BS_BEGIN_RTTI_MEMBERS
+		BS_RTTI_MEMBER_PLAIN(mId, 0)
+		BS_RTTI_MEMBER_PLAIN(mWeight, 1)
+		BS_RTTI_MEMBER_PLAIN(mName, 2)
+		BS_RTTI_MEMBER_PLAIN_ARRAY(mSamples, 3)
+		BS_RTTI_MEMBER_REFLPTR_ARRAY(mChildren, 4)
+	BS_END_RTTI_MEMBERS
+public:
+	BenchmarkNodeRTTI()
+		:mInitMembers(this)
+	{ }
+
+	const String& getRTTIName() override
+	{
+		static String name = "BenchmarkNode";
+		return name;
+	}
+
+	UINT32 getRTTIId() override
+	{
+		return 100000; // Outside of the range used by engine types
+	}
+
+	SPtr<IReflectable> newRTTIObject() override
+	{
+		return bs_shared_ptr_new<BenchmarkNode>();
+	}
+};
+
+RTTITypeBase* BenchmarkNode::getRTTIStatic()
+{
+	return BenchmarkNodeRTTI::instance();
+}
+
+RTTITypeBase* BenchmarkNode::getRTTI() const
+{
+	return getRTTIStatic();
+}
+
+/** Creates a tree of nodes with the provided total number of nodes, each with up to @p numChildren children. */
+static SPtr<BenchmarkNode> createNodeTree(UINT32 numNodes, UINT32 numChildren, UINT32 numSamples)
+{
+	std::mt19937 generator(1234);
+	std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+
+	Vector<SPtr<BenchmarkNode>> nodes(numNodes);
+	for(UINT32 i = 0; i < numNodes; i++)
+	{
+		SPtr<BenchmarkNode> node = bs_shared_ptr_new<BenchmarkNode>();
+		node->mId = i;
+		node->mWeight = distribution(generator);
+		node->mName = "Node_" + toString(i);
+
+		node->mSamples.resize(numSamples);
+		for (auto& sample : node->mSamples)
+			sample = distribution(generator);
+
+		if (i > 0)
+			nodes[(i - 1) / numChildren]->mChildren.push_back(node);
+
+		nodes[i] = node;
+	}
+
+	return nodes[0];
+}
+
+/**
+ * Compares decoding directly from the data stream with the previous decode path, which first builds an intermediate
+ * SerializedObject representation and then decodes the objects from it.
+ */
+static void benchmarkSerializationDecode()
+{
+	static const UINT32 NUM_CHILDREN = 8;
+	static const UINT32 NUM_SAMPLES = 64;
+
+	const UINT32 nodeCounts[] = { 1000, 10000, 50000 };
+
+	printHeader("Binary decode (time)", "intermediate");
+
+	Vector<std::pair<UINT32, std::pair<double, double>>> memoryResults;
+	for(auto& numNodes : nodeCounts)
+	{
+		UINT32 dataSize = 0;
+		UINT8* data;
+		{
+			SPtr<BenchmarkNode> root = createNodeTree(numNodes, NUM_CHILDREN, NUM_SAMPLES);
+
+			MemorySerializer serializer;
+			data = serializer.encode(root.get(), dataSize);
+		}
+
+		SPtr<DataStream> stream = bs_shared_ptr_new<MemoryDataStream>(data, dataSize, false);
+
+		auto decodeStream = [&]()
+		{
+			stream->seek(0);
+
+			BinarySerializer serializer;
+			SPtr<IReflectable> output = serializer.decode(stream, dataSize);
+		};
+
+		auto decodeIntermediate = [&]()
+		{
+			stream->seek(0);
+
+			BinarySerializer serializer;
+			SPtr<SerializedObject> intermediate = serializer._decodeToIntermediate(stream, dataSize);
+			SPtr<IReflectable> output = serializer._decodeFromIntermediate(intermediate);
+		};
+
+		// Streaming path runs first, so it cannot benefit from memory released by the other path
+		double currentKB = measurePeakMemory(decodeStream);
+		double referenceKB = measurePeakMemory(decodeIntermediate);
+		memoryResults.push_back(std::make_pair(numNodes, std::make_pair(currentKB, referenceKB)));
+
+		double currentUs = measure(decodeStream, 5);
+		double referenceUs = measure(decodeIntermediate, 5);
+
+		printResult(toString(numNodes) + " nodes (" + toString(dataSize / 1024) + " KB)", currentUs / 1000.0,
+			referenceUs / 1000.0, "ms");
+
+		bs_free(data);
+	}
+
+	printHeader("Binary decode (peak memory)", "intermediate", "saving");
+	for (auto& entry : memoryResults)
+		printResult(toString(entry.first) + " nodes", entry.second.first, entry.second.second, "KB");
+}
+
+/************************************************************************/
+/* 								POOL ALLOCATOR                     		*/
+/************************************************************************/
+
+/** Returns the amount of physical memory used by the process, in bytes. Returns zero on unsupported platforms. */
+static UINT64 getResidentBytes()
+{
+#if BS_PLATFORM == BS_PLATFORM_WIN32
+	PROCESS_MEMORY_COUNTERS counters;
+	if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+		return 0;
+
+	return counters.WorkingSetSize;
+#elif BS_PLATFORM == BS_PLATFORM_LINUX
+	FILE* file = fopen("/proc/self/statm", "r");
+	if (file == nullptr)
+		return 0;
+
+	unsigned long long totalPages = 0;
+	unsigned long long residentPages = 0;
+	if (fscanf(file, "%llu %llu", &totalPages, &residentPages) != 2)
+		residentPages = 0;
+
+	fclose(file);
+	return residentPages * (UINT64)sysconf(_SC_PAGESIZE);
+#else
+	return 0;
+#endif
+}
+
+/** Forwards allocations to the system allocator. */
+struct BenchmarkSystemAlloc
+{
+	static void* allocate(size_t bytes) { return malloc(bytes); }
+	static void free(void* ptr) { ::free(ptr); }
+};
+
+/** Forwards allocations to the pool allocator. */
+struct BenchmarkPoolAlloc
+{
+	static void* allocate(size_t bytes) { return PoolAlloc::allocate(bytes); }
+	static void free(void* ptr) { PoolAlloc::free(ptr); }
+};
+
+/**
+ * Allocates and frees random sized small objects from the provided number of threads at once. Each thread keeps a set of
+ * live allocations and randomly replaces them. Every eighth freed allocation is first exchanged through a shared list,
+ * so it ends up being freed by a different thread than the one that allocated it.
+ */
+template<class Alloc>
+static void runAllocThreads(UINT32 numThreads, UINT32 numOperations)
+{
+	static const UINT32 NUM_LIVE = 4096;
+	static const UINT32 NUM_SHARED = 4096;
+
+	Vector<std::atomic<void*>> shared(NUM_SHARED);
+	for (auto& entry : shared)
+		entry.store(nullptr);
+
+	Vector<Thread> threads;
+	for (UINT32 i = 0; i < numThreads; i++)
+	{
+		threads.push_back(Thread([&shared, numOperations, i]()
+		{
+			std::mt19937 generator(i + 1);
+
+			Vector<void*> live(NUM_LIVE, nullptr);
+			for (UINT32 j = 0; j < numOperations; j++)
+			{
+				void*& entry = live[generator() % NUM_LIVE];
+				if (entry != nullptr)
+				{
+					if ((j & 7) == 0)
+						entry = shared[generator() % NUM_SHARED].exchange(entry);
+
+					if (entry != nullptr)
+						Alloc::free(entry);
+				}
+
+				UINT32 size = 8 + generator() % (PoolAlloc::MAX_SIZE - 7);
+				entry = Alloc::allocate(size);
+				*(UINT8*)entry = (UINT8)size;
+			}
+
+			for (auto& entry : live)
+			{
+				if (entry != nullptr)
+					Alloc::free(entry);
+			}
+
+			PoolAlloc::endThread();
+		}));
+	}
+
+	for (auto& thread : threads)
+		thread.join();
+
+	for (auto& entry : shared)
+	{
+		void* ptr = entry.exchange(nullptr);
+		if (ptr != nullptr)
+			Alloc::free(ptr);
+	}
+}
+
+/**
+ * Allocates a large number of random sized small objects, frees 90% of them at random and then allocates objects of a
+ * different size mix. Returns the growth in resident memory divided by the number of bytes still allocated by the
+ * caller, i.e. how many bytes of physical memory each requested byte ends up using.
+ */
+template<class Alloc>
+static double measureFragmentation()
+{
+	static const UINT32 NUM_ALLOCATIONS = 2000000;
+
+	std::mt19937 generator(5);
+
+	Vector<std::pair<void*, UINT32>> allocations;
+	allocations.reserve(NUM_ALLOCATIONS + NUM_ALLOCATIONS / 4);
+
+	UINT64 startBytes = getResidentBytes();
+	for (UINT32 i = 0; i < NUM_ALLOCATIONS; i++)
+	{
+		UINT32 size = 8 + generator() % (PoolAlloc::MAX_SIZE - 7);
+		void* ptr = Alloc::allocate(size);
+		memset(ptr, 0, size);
+
+		allocations.push_back(std::make_pair(ptr, size));
+	}
+
+	UINT64 liveBytes = 0;
+	for (auto& entry : allocations)
+	{
+		if (generator() % 10 != 0)
+		{
+			Alloc::free(entry.first);
+			entry.first = nullptr;
+		}
+		else
+			liveBytes += entry.second;
+	}
+
+	for (UINT32 i = 0; i < NUM_ALLOCATIONS / 4; i++)
+	{
+		UINT32 size = 8 + generator() % 57;
+		void* ptr = Alloc::allocate(size);
+		memset(ptr, 0, size);
+
+		allocations.push_back(std::make_pair(ptr, size));
+		liveBytes += size;
+	}
+
+	UINT64 usedBytes = getResidentBytes() - startBytes;
+
+	for (auto& entry : allocations)
+	{
+		if (entry.first != nullptr)
+			Alloc::free(entry.first);
+	}
+
+	return usedBytes / (double)liveBytes;
+}
+
+/**
+ * Compares the pool allocator with the system allocator. Throughput is measured for small allocations made and freed
+ * on multiple threads at once. Fragmentation is measured as the physical memory used after most allocations were freed
+ * and replaced with allocations of different sizes.
+ */
+static void benchmarkPoolAlloc()
+{
+	static const UINT32 NUM_OPERATIONS = 1000000;
+
+	// Fragmentation goes first, so that neither allocator can re-use memory left over from the throughput runs. Pool
+	// allocator goes first, since its slabs could otherwise be placed in memory freed by the system allocator.
+	if (getResidentBytes() != 0)
+	{
+		double current = measureFragmentation<BenchmarkPoolAlloc>();
+		double reference = measureFragmentation<BenchmarkSystemAlloc>();
+
+		printHeader("PoolAlloc fragmentation, resident bytes per live byte", "malloc", "saving");
+		printResult("90% freed, re-allocated", current, reference, "");
+	}
+
+	printHeader("PoolAlloc throughput, allocations and frees", "malloc");
+
+	const UINT32 threadCounts[] = { 1, 4, 8 };
+	for (auto& numThreads : threadCounts)
+	{
+		double currentUs = measure([&]() { runAllocThreads<BenchmarkPoolAlloc>(numThreads, NUM_OPERATIONS); }, 1);
+		double referenceUs = measure([&]() { runAllocThreads<BenchmarkSystemAlloc>(numThreads, NUM_OPERATIONS); }, 1);
+
+		// Every operation both frees and allocates, reported in millions of operations per second
+		double totalOperations = numThreads * (double)NUM_OPERATIONS * 2;
+		printResult(toString(numThreads) + " threads", totalOperations / currentUs, totalOperations / referenceUs,
+			"M/s", true);
+	}
+}
+
+int main()
+{
+	MemStack::beginThread();
+
+	// Runs first, so its resident memory measurements aren't affected by memory freed by other benchmarks
+	benchmarkPoolAlloc();
+	benchmarkSerializationDecode();
+
+	MemStack::endThread();
+
+	return 0;
+}
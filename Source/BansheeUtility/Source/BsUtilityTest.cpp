@@ -1,15 +1,31 @@
 //********************************** Banshee Engine (www.banshee3d.com) **************************************************//
 //**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
 #include "BsFileSystemTestSuite.h"
+#include "BsDynamicAABBTreeTestSuite.h"
+#include "BsRadixSortTestSuite.h"
+#include "BsThreadFrameAllocTestSuite.h"
+#include "BsPoolAllocTestSuite.h"
+#include "BsCompressionTestSuite.h"
 #include "BsConsoleTestOutput.h"
+#include "BsMemStack.h"
 
 using namespace bs;
 
 int main()
 {
+	MemStack::beginThread();
+
 	SPtr<TestSuite> tests = FileSystemTestSuite::create<FileSystemTestSuite>();
+	tests->add(DynamicAABBTreeTestSuite::create<DynamicAABBTreeTestSuite>());
+	tests->add(RadixSortTestSuite::create<RadixSortTestSuite>());
+	tests->add(ThreadFrameAllocTestSuite::create<ThreadFrameAllocTestSuite>());
+	tests->add(PoolAllocTestSuite::create<PoolAllocTestSuite>());
+	tests->add(CompressionTestSuite::create<CompressionTestSuite>());
+
 	ConsoleTestOutput testOutput;
 	tests->run(testOutput);
 
+	MemStack::endThread();
+
 	return 0;
 }
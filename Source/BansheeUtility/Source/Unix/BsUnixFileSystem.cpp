@@ -8,6 +8,8 @@
 
 #include <dirent.h>
 #include <errno.h>
+#include <fcntl.h>
+#include <sys/mman.h>
 #include <sys/stat.h>
 #include <sys/types.h>
 #include <unistd.h>
@@ -128,6 +130,45 @@ namespace bs
 		return bs_shared_ptr_new<FileDataStream>(path, accessMode, true);
 	}
 
+	SPtr<DataStream> FileSystem::openFileMapped(const Path& path)
+	{
+		String pathString = path.toString();
+
+		int fileDesc = open(pathString.c_str(), O_RDONLY);
+		if (fileDesc == -1)
+		{
+			HANDLE_PATH_ERROR(pathString, errno);
+			return nullptr;
+		}
+
+		struct stat st_buf;
+		if (fstat(fileDesc, &st_buf) != 0)
+		{
+			HANDLE_PATH_ERROR(pathString, errno);
+			::close(fileDesc);
+			return nullptr;
+		}
+
+		size_t size = (size_t)st_buf.st_size;
+		void* memory = nullptr;
+		if (size > 0)
+		{
+			// Private mapping, so writes to the memory are never written back to the file
+			memory = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fileDesc, 0);
+			if (memory == MAP_FAILED)
+			{
+				HANDLE_PATH_ERROR(pathString, errno);
+				::close(fileDesc);
+				return nullptr;
+			}
+		}
+
+		// Mapping remains valid after the file is closed
+		::close(fileDesc);
+
+		return bs_shared_ptr_new<MappedFileDataStream>(path, memory, size);
+	}
+
 	SPtr<DataStream> FileSystem::createAndOpenFile(const Path& path)
 	{
 		return bs_shared_ptr_new<FileDataStream>(path, DataStream::AccessMode::WRITE, true);
@@ -279,4 +320,13 @@ namespace bs
 
 		return Path(String(directoryName) + "/");
 	}
+
+	void MappedFileDataStream::close()
+	{
+		if (mData != nullptr)
+		{
+			munmap(mData, mSize);
+			mData = nullptr;
+		}
+	}
 }
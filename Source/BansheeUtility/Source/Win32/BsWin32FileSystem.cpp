@@ -283,6 +283,54 @@ namespace bs
 		return bs_shared_ptr_new<FileDataStream>(fullPath, accessMode, true);
 	}
 
+	SPtr<DataStream> FileSystem::openFileMapped(const Path& fullPath)
+	{
+		WString pathWString = fullPath.toWString();
+
+		// Allow the file to be deleted while mapped, so resources can be overwritten by removing them first
+		HANDLE hFile = CreateFileW(pathWString.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE, 0, 
+			OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, 0);
+		if (hFile == INVALID_HANDLE_VALUE)
+		{
+			win32_handleError(GetLastError(), pathWString);
+			return nullptr;
+		}
+
+		LARGE_INTEGER fileSize;
+		if (GetFileSizeEx(hFile, &fileSize) == FALSE)
+		{
+			win32_handleError(GetLastError(), pathWString);
+			CloseHandle(hFile);
+			return nullptr;
+		}
+
+		void* memory = nullptr;
+		if (fileSize.QuadPart > 0)
+		{
+			// Copy-on-write mapping, so writes to the memory are never written back to the file
+			HANDLE hMapping = CreateFileMappingW(hFile, 0, PAGE_WRITECOPY, 0, 0, 0);
+			if (hMapping != nullptr)
+				memory = MapViewOfFile(hMapping, FILE_MAP_COPY, 0, 0, 0);
+
+			DWORD error = GetLastError();
+
+			if (hMapping != nullptr)
+				CloseHandle(hMapping);
+
+			if (memory == nullptr)
+			{
+				win32_handleError(error, pathWString);
+				CloseHandle(hFile);
+				return nullptr;
+			}
+		}
+
+		// View remains valid after the handles are closed
+		CloseHandle(hFile);
+
+		return bs_shared_ptr_new<MappedFileDataStream>(fullPath, memory, (size_t)fileSize.QuadPart);
+	}
+
 	SPtr<DataStream> FileSystem::createAndOpenFile(const Path& fullPath)
 	{
 		return bs_shared_ptr_new<FileDataStream>(fullPath, DataStream::AccessMode::WRITE, true);
@@ -467,4 +515,13 @@ namespace bs
 	{
 		return Path(win32_getTempDirectory());
 	}
+
+	void MappedFileDataStream::close()
+	{
+		if (mData != nullptr)
+		{
+			UnmapViewOfFile(mData);
+			mData = nullptr;
+		}
+	}
 }
@@ -80,6 +80,7 @@ namespace bs { namespace ct
 			PerSetData* perSetData;
 
 			VkImage* sampledImages;
+			UINT32* sampledMips; /**< Most detailed mip level bound for each sampled image. */
 			VkImage* storageImages;
 			VkBuffer* uniformBuffers;
 			VkBuffer* buffers;
@@ -79,6 +79,7 @@ namespace bs { namespace ct
 			.reserve<VkWriteDescriptorSet>(numBindings * numDevices)
 			.reserve<WriteInfo>(numBindings * numDevices)
 			.reserve<VkImage>(numTextures * numDevices)
+			.reserve<UINT32>(numTextures * numDevices)
 			.reserve<VkImage>(numStorageTextures * numDevices)
 			.reserve<VkBuffer>(numParamBlocks * numDevices)
 			.reserve<VkBuffer>(numBuffers * numDevices)
@@ -106,12 +107,14 @@ namespace bs { namespace ct
 
 			mPerDeviceData[i].perSetData = mAlloc.alloc<PerSetData>(numSets);
 			mPerDeviceData[i].sampledImages = mAlloc.alloc<VkImage>(numTextures);
+			mPerDeviceData[i].sampledMips = mAlloc.alloc<UINT32>(numTextures);
 			mPerDeviceData[i].storageImages = mAlloc.alloc<VkImage>(numStorageTextures);
 			mPerDeviceData[i].uniformBuffers = mAlloc.alloc<VkBuffer>(numParamBlocks);
 			mPerDeviceData[i].buffers = mAlloc.alloc<VkBuffer>(numBuffers);
 			mPerDeviceData[i].samplers = mAlloc.alloc<VkSampler>(numSamplers);
 
 			bs_zero_out(mPerDeviceData[i].sampledImages, numTextures);
+			bs_zero_out(mPerDeviceData[i].sampledMips, numTextures);
 			bs_zero_out(mPerDeviceData[i].storageImages, numStorageTextures);
 			bs_zero_out(mPerDeviceData[i].uniformBuffers, numParamBlocks);
 			bs_zero_out(mPerDeviceData[i].buffers, numBuffers);
@@ -288,6 +291,10 @@ namespace bs { namespace ct
 		Lock(mMutex);
 
 		VulkanTexture* vulkanTexture = static_cast<VulkanTexture*>(texture.get());
+
+		TextureSurface loadedSurface = surface;
+		if (vulkanTexture != nullptr)
+			loadedSurface = vulkanTexture->getLoadedSurface(surface);
 		for (UINT32 i = 0; i < BS_MAX_DEVICES; i++)
 		{
 			if (mPerDeviceData[i].perSetData == nullptr)
@@ -302,8 +309,9 @@ namespace bs { namespace ct
 			PerSetData& perSetData = mPerDeviceData[i].perSetData[set];
 			if (imageRes != nullptr)
 			{
-				perSetData.writeInfos[bindingIdx].image.imageView = imageRes->getView(surface, false);
+				perSetData.writeInfos[bindingIdx].image.imageView = imageRes->getView(loadedSurface, false);
 				mPerDeviceData[i].sampledImages[sequentialIdx] = imageRes->getHandle();
+				mPerDeviceData[i].sampledMips[sequentialIdx] = loadedSurface.mipLevel;
 			}
 			else
 			{
@@ -710,19 +718,23 @@ namespace bs { namespace ct
 
 			buffer.registerResource(resource, range, layout, layout, VulkanUseFlag::Read);
 
-			// Check if internal resource changed from what was previously bound in the descriptor set
+			// Check if internal resource, or its loaded mip levels, changed from what was previously bound in the
+			// descriptor set
 			assert(perDeviceData.sampledImages[i] != VK_NULL_HANDLE);
 
 			VkImage vkImage = resource->getHandle();
-			if (perDeviceData.sampledImages[i] != vkImage)
+			TextureSurface loadedSurface = element->getLoadedSurface(surface);
+			if (perDeviceData.sampledImages[i] != vkImage || perDeviceData.sampledMips[i] != loadedSurface.mipLevel)
 			{
 				perDeviceData.sampledImages[i] = vkImage;
+				perDeviceData.sampledMips[i] = loadedSurface.mipLevel;
 
 				UINT32 set, slot;
 				mParamInfo->getSetSlot(GpuPipelineParamInfo::ParamType::Texture, i, set, slot);
 
 				UINT32 bindingIdx = vkParamInfo.getBindingIdx(set, slot);
-				perDeviceData.perSetData[set].writeInfos[bindingIdx].image.imageView = resource->getView(surface, false);
+				perDeviceData.perSetData[set].writeInfos[bindingIdx].image.imageView = 
+					resource->getView(loadedSurface, false);
 
 				mSetsDirty[set] = true;
 			}
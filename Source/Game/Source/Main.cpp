@@ -8,6 +8,7 @@
 #include "BsFileSystem.h"
 #include "BsResources.h"
 #include "BsResourceManifest.h"
+#include "BsResourceArchive.h"
 #include "BsPrefab.h"
 #include "BsSceneObject.h"
 #include "BsSceneManager.h"
@@ -141,6 +142,16 @@ void runApplication()
 		gResources().registerResourceManifest(manifest);
 	}
 
+	Path resourceArchivePath = resourcesPath + GAME_RESOURCE_ARCHIVE_NAME;
+	if (FileSystem::exists(resourceArchivePath))
+	{
+		SPtr<ResourceArchive> archive = ResourceArchive::open(resourceArchivePath);
+		if (archive != nullptr)
+			gResources().registerResourceArchive(archive);
+		else
+			LOGWRN("Unable to open resource archive: " + resourceArchivePath.toString());
+	}
+
 	{
 		HPrefab mainScene = static_resource_cast<Prefab>(gResources().loadFromUUID(gameSettings->mainSceneUUID, 
 			false, ResourceLoadFlag::LoadDependencies));
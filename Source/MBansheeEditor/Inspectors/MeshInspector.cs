@@ -24,6 +24,8 @@ namespace BansheeEditor
         private GUIToggleField cpuCachedField;
         private GUIEnumField collisionMeshTypeField;
         private GUIToggleField keyFrameReductionField;
+        private GUIToggleField animCompressionField;
+        private GUIFloatField animCompressionErrorField;
         private GUIToggleField rootMotionField;
         private GUIArrayField<AnimationSplitInfo, AnimSplitArrayRow> animSplitInfoField;
         private GUIButton reimportButton;
@@ -57,6 +59,8 @@ namespace BansheeEditor
             cpuCachedField.Value = newImportOptions.CPUCached;
             collisionMeshTypeField.Value = (ulong)newImportOptions.CollisionMeshType;
             keyFrameReductionField.Value = newImportOptions.KeyframeReduction;
+            animCompressionField.Value = newImportOptions.AnimationCompression;
+            animCompressionErrorField.Value = newImportOptions.AnimationCompressionError;
             rootMotionField.Value = newImportOptions.ImportRootMotion;
 
             importOptions = newImportOptions;
@@ -80,6 +84,8 @@ namespace BansheeEditor
             cpuCachedField = new GUIToggleField(new LocEdString("CPU cached"));
             collisionMeshTypeField = new GUIEnumField(typeof(CollisionMeshType), new LocEdString("Collision mesh"));
             keyFrameReductionField = new GUIToggleField(new LocEdString("Keyframe Reduction"));
+            animCompressionField = new GUIToggleField(new LocEdString("Compress animation"));
+            animCompressionErrorField = new GUIFloatField(new LocEdString("Compression error"));
             rootMotionField = new GUIToggleField(new LocEdString("Import root motion"));
             reimportButton = new GUIButton(new LocEdString("Reimport"));
 
@@ -92,6 +98,8 @@ namespace BansheeEditor
             cpuCachedField.OnChanged += x => importOptions.CPUCached = x;
             collisionMeshTypeField.OnSelectionChanged += x => importOptions.CollisionMeshType = (CollisionMeshType)x;
             keyFrameReductionField.OnChanged += x => importOptions.KeyframeReduction = x;
+            animCompressionField.OnChanged += x => importOptions.AnimationCompression = x;
+            animCompressionErrorField.OnChanged += x => importOptions.AnimationCompressionError = x;
             rootMotionField.OnChanged += x => importOptions.ImportRootMotion = x;
 
             reimportButton.OnClick += TriggerReimport;
@@ -105,6 +113,8 @@ namespace BansheeEditor
             Layout.AddElement(cpuCachedField);
             Layout.AddElement(collisionMeshTypeField);
             Layout.AddElement(keyFrameReductionField);
+            Layout.AddElement(animCompressionField);
+            Layout.AddElement(animCompressionErrorField);
             Layout.AddElement(rootMotionField);
 
             splitInfos = importOptions.AnimationClipSplits;
@@ -286,6 +286,27 @@ namespace BansheeEditor
             set { Internal_SetKeyFrameReduction(mCachedPtr, value); }
         }
 
+        /// <summary>
+        /// Determines if imported animation clips will be compressed. Compressed clips use significantly less memory and
+        /// are faster to evaluate, at the cost of some precision.
+        /// </summary>
+        public bool AnimationCompression
+        {
+            get { return Internal_GetAnimationCompression(mCachedPtr); }
+            set { Internal_SetAnimationCompression(mCachedPtr, value); }
+        }
+
+        /// <summary>
+        /// Maximum error allowed when removing redundant keyframes during animation clip compression. Applies to
+        /// individual components of bone positions, rotations and scales. Only relevant if <see cref="AnimationCompression"/>
+        /// is enabled.
+        /// </summary>
+        public float AnimationCompressionError
+        {
+            get { return Internal_GetAnimationCompressionError(mCachedPtr); }
+            set { Internal_SetAnimationCompressionError(mCachedPtr, value); }
+        }
+
         /// <summary>
         /// Determines if import of root motion curves is enabled. When enabled, any animation curves in imported animations 
         /// affecting the root bone will be available through a set of separate curves in AnimationClip, and they won't be
@@ -372,6 +393,18 @@ namespace BansheeEditor
         [MethodImpl(MethodImplOptions.InternalCall)]
         private static extern void Internal_SetKeyFrameReduction(IntPtr thisPtr, bool value);
 
+        [MethodImpl(MethodImplOptions.InternalCall)]
+        private static extern bool Internal_GetAnimationCompression(IntPtr thisPtr);
+
+        [MethodImpl(MethodImplOptions.InternalCall)]
+        private static extern void Internal_SetAnimationCompression(IntPtr thisPtr, bool value);
+
+        [MethodImpl(MethodImplOptions.InternalCall)]
+        private static extern float Internal_GetAnimationCompressionError(IntPtr thisPtr);
+
+        [MethodImpl(MethodImplOptions.InternalCall)]
+        private static extern void Internal_SetAnimationCompressionError(IntPtr thisPtr, float value);
+
         [MethodImpl(MethodImplOptions.InternalCall)]
         private static extern bool Internal_GetRootMotion(IntPtr thisPtr);
 
@@ -232,19 +232,19 @@ namespace bs
 		
 		//// Renderables
 		Vector<RendererObject*> mRenderables;
-		Vector<CullInfo> mRenderableCullInfos;
-		Vector<bool> mRenderableVisibility; // Transient
+		CullInfoArray mRenderableCullInfos;
+		Bitfield mRenderableVisibility; // Transient
 
 		//// Lights
 		Vector<RendererLight> mDirectionalLights;
 		Vector<RendererLight> mRadialLights;
 		Vector<RendererLight> mSpotLights;
-		Vector<Sphere> mPointLightWorldBounds;
-		Vector<Sphere> mSpotLightWorldBounds;
+		CullInfoArray mPointLightCullInfos;
+		CullInfoArray mSpotLightCullInfos;
 
 		//// Reflection probes
 		Vector<RendererReflectionProbe> mReflProbes;
-		Vector<Sphere> mReflProbeWorldBounds;
+		CullInfoArray mReflProbeCullInfos;
 		Vector<bool> mCubemapArrayUsedSlots;
 		SPtr<Texture> mReflCubemapArrayTex;
 
@@ -281,10 +281,10 @@ namespace bs
 
 		// Helpers to avoid memory allocations
 		Vector<LightData> mLightDataTemp;
-		Vector<bool> mLightVisibilityTemp;
+		Bitfield mLightVisibilityTemp;
 
 		Vector<ReflProbeData> mReflProbeDataTemp;
-		Vector<bool> mReflProbeVisibilityTemp;
+		Bitfield mReflProbeVisibilityTemp;
 
 		// Sim thread only fields
 		SPtr<RenderBeastOptions> mOptions;
@@ -9,6 +9,8 @@
 #include "BsRendererObject.h"
 #include "BsBounds.h"
 #include "BsConvexVolume.h"
+#include "BsBitfield.h"
+#include "BsDynamicAABBTree.h"
 
 namespace bs { namespace ct
 {
@@ -108,18 +110,78 @@ namespace bs { namespace ct
 	/** Information whether certain scene objects are visible in a view, per object type. */
 	struct VisibilityInfo
 	{
-		Vector<bool> renderables;
+		Bitfield renderables;
 	};
 
-	/** Information used for culling an object against a view. */
-	struct CullInfo
+	/** 
+	 * Contains information used for culling a set of objects against a view. Bounds are stored in structure-of-arrays
+	 * form, in blocks of four objects, so that four objects can be tested against a frustum plane at once. The bounds
+	 * are also kept in a bounding volume hierarchy, allowing large sets of objects to be culled without visiting every 
+	 * object.
+	 */
+	class CullInfoArray
 	{
-		CullInfo(const Bounds& bounds, UINT64 layer = -1)
-			:bounds(bounds), layer(layer)
-		{ }
+	public:
+		/** Number of objects stored in a single block. */
+		static const UINT32 BLOCK_SIZE = 4;
+
+		/** Bounds of BLOCK_SIZE objects. */
+		struct Block
+		{
+			float sphereCenter[3][BLOCK_SIZE];
+			float sphereRadius[BLOCK_SIZE];
+			float boxCenter[3][BLOCK_SIZE];
+			float boxExtents[3][BLOCK_SIZE]; /**< Absolute half-size of the box. */
+		};
+
+		CullInfoArray();
+
+		/** Appends a new object to the end of the array. */
+		void add(const Bounds& bounds, UINT64 layer = -1);
+
+		/** Updates the bounds of the object at the specified index. */
+		void setBounds(UINT32 idx, const Bounds& bounds);
+
+		/** Swaps the data of the two objects at the specified indices. */
+		void swap(UINT32 a, UINT32 b);
+
+		/** Removes the last object in the array. */
+		void removeLast();
 
-		Bounds bounds;
-		UINT64 layer;
+		/** Removes all objects. */
+		void clear();
+
+		/** Returns the center of the bounding box of the object at the specified index. */
+		Vector3 getBoxCenter(UINT32 idx) const;
+
+		/** Returns the radius of the bounding sphere of the object at the specified index. */
+		float getSphereRadius(UINT32 idx) const;
+
+		/** Returns the number of objects in the array. */
+		UINT32 size() const { return mNumEntries; }
+
+		/** Returns the blocks containing object bounds. Unused entries in the last block have zero size. */
+		const Vector<Block>& getBlocks() const { return mBlocks; }
+
+		/** Returns a layer bitmask for each object. */
+		const Vector<UINT64>& getLayers() const { return mLayers; }
+
+		/** 
+		 * Returns a bounding volume hierarchy containing the bounding boxes of all objects. Queries return indices of the
+		 * objects in this array.
+		 */
+		const DynamicAABBTree& getTree() const { return mTree; }
+
+		/** Tests if the bounds of the object at the specified index intersect the provided volume. */
+		bool intersects(UINT32 idx, const ConvexVolume& volume) const;
+
+	private:
+		Vector<Block> mBlocks;
+		Vector<UINT64> mLayers;
+		UINT32 mNumEntries;
+
+		DynamicAABBTree mTree;
+		Vector<UINT32> mTreeIds;
 	};
 
 	/** Contains information about a Camera, used by the Renderer. */
@@ -217,7 +279,9 @@ namespace bs { namespace ct
 		const SPtr<RenderQueue>& getTransparentQueue() const { return mTransparentQueue; }
 
 		/**
-		 * Populates view render queues by determining visible renderable objects. 
+		 * Populates view render queues by determining visible renderable objects. Large sets of visible objects are queued
+		 * in parallel on the task scheduler worker threads. Different views may call this method concurrently, as long as
+		 * they don't share the @p visibility output.
 		 *
 		 * @param[in]	renderables			A set of renderable objects to iterate over and determine visibility for.
 		 * @param[in]	cullInfos			A set of world bounds & other information relevant for culling the provided
@@ -230,24 +294,27 @@ namespace bs { namespace ct
 		 *									As a side-effect, per-view visibility data is also calculated and can be
 		 *									retrieved by calling getVisibilityMask().
 		 */
-		void determineVisible(const Vector<RendererObject*>& renderables, const Vector<CullInfo>& cullInfos,
-			Vector<bool>* visibility = nullptr);
+		void determineVisible(const Vector<RendererObject*>& renderables, const CullInfoArray& cullInfos,
+			Bitfield* visibility = nullptr);
 
 		/**
-		 * Culls the provided set of bounds against the current frustum and outputs a set of visibility flags determining
-		 * which entry is or ins't visible by this view. Both inputs must be arrays of the same size.
+		 * Culls the provided set of bounds against the current frustum and sets the bits in @p visibility for entries
+		 * that are visible by this view. Bits for entries that aren't visible are left unchanged. Both inputs must be of
+		 * the same size. Large sets are culled by querying the bounding volume hierarchy, while smaller ones are tested
+		 * linearly, in parallel on the task scheduler worker threads if there are enough of them.
 		 */
-		void calculateVisibility(const Vector<CullInfo>& cullInfos, Vector<bool>& visibility) const;
-
-		/**
-		* Culls the provided set of bounds against the current frustum and outputs a set of visibility flags determining
-		* which entry is or ins't visible by this view. Both inputs must be arrays of the same size.
-		*/
-		void calculateVisibility(const Vector<Sphere>& bounds, Vector<bool>& visibility) const;
+		void calculateVisibility(const CullInfoArray& cullInfos, Bitfield& visibility) const;
 
 		/** Returns the visibility mask calculated with the last call to determineVisible(). */
 		const VisibilityInfo& getVisibilityMasks() const { return mVisibility; }
 
+		/**
+		 * Estimates the on-screen size of every object found visible by the last call to determineVisible(), and requests
+		 * the mip levels needed to display the textures used by their materials from the texture streaming manager.
+		 * Object textures are assumed to be mapped once across the object's bounds.
+		 */
+		void requestTextureMips(const Vector<RendererObject*>& renderables, const CullInfoArray& cullInfos) const;
+
 		/** 
 		 * Returns a structure containing information about post-processing effects. This structure will be modified and
 		 * maintained by the post-processing system.
@@ -281,11 +348,24 @@ namespace bs { namespace ct
 		 */
 		Vector2 getNDCZTransform(const Matrix4& projMatrix) const;
 
+		/** Minimum number of bitfield words (32 objects each) to cull in a single task when culling in parallel. */
+		static const UINT32 CULL_WORDS_PER_TASK = 64;
+
+		/** Number of bitfield words (32 objects each) to add to render queues in a single task when queuing in parallel. */
+		static const UINT32 QUEUE_WORDS_PER_TASK = 16;
+
+		/** Minimum number of objects required before culling queries the bounding volume hierarchy instead. */
+		static const UINT32 CULL_TREE_MIN_OBJECTS = 4096;
+
 		RENDERER_VIEW_DESC mViewDesc;
 
 		SPtr<RenderQueue> mOpaqueQueue;
 		SPtr<RenderQueue> mTransparentQueue;
 
+		// Per-task queues used when populating the render queues in parallel, merged into the main queues afterwards
+		Vector<RenderQueue> mOpaqueQueueChunks;
+		Vector<RenderQueue> mTransparentQueueChunks;
+
 		SPtr<RenderTargets> mRenderTargets;
 		PostProcessInfo mPostProcessInfo;
 		bool mUsingGBuffer;
@@ -37,6 +37,8 @@
 #include "BsMeshData.h"
 #include "BsLightGrid.h"
 #include "BsSkybox.h"
+#include "BsTaskScheduler.h"
+#include "BsTextureStreamingManager.h"
 
 using namespace std::placeholders;
 
@@ -45,6 +47,15 @@ namespace bs { namespace ct
 	// Limited by max number of array elements in texture for DX11 hardware
 	constexpr UINT32 MaxReflectionCubemaps = 2048 / 6;
 
+	/** Converts a bounding sphere into bounds usable for culling. */
+	static Bounds getSphereBounds(const Sphere& sphere)
+	{
+		Vector3 extents(sphere.getRadius(), sphere.getRadius(), sphere.getRadius());
+		AABox box(sphere.getCenter() - extents, sphere.getCenter() + extents);
+
+		return Bounds(box, sphere);
+	}
+
 	RenderBeast::RenderBeast()
 	{
 		mOptions = bs_shared_ptr_new<RenderBeastOptions>();
@@ -109,6 +120,7 @@ namespace bs { namespace ct
 		mRenderTargets.clear();
 		mCameras.clear();
 		mRenderables.clear();
+		mRenderableCullInfos.clear();
 		mRenderableVisibility.clear();
 
 		mReflCubemapArrayTex = nullptr;
@@ -143,8 +155,8 @@ namespace bs { namespace ct
 		renderable->setRendererId(renderableId);
 
 		mRenderables.push_back(bs_new<RendererObject>());
-		mRenderableCullInfos.push_back(CullInfo(renderable->getBounds(), renderable->getLayer()));
-		mRenderableVisibility.push_back(false);
+		mRenderableCullInfos.add(renderable->getBounds(), renderable->getLayer());
+		mRenderableVisibility.resize(renderableId + 1);
 
 		RendererObject* rendererObject = mRenderables.back();
 		rendererObject->renderable = renderable;
@@ -295,7 +307,7 @@ namespace bs { namespace ct
 		{
 			// Swap current last element with the one we want to erase
 			std::swap(mRenderables[renderableId], mRenderables[lastRenderableId]);
-			std::swap(mRenderableCullInfos[renderableId], mRenderableCullInfos[lastRenderableId]);
+			mRenderableCullInfos.swap(renderableId, lastRenderableId);
 
 			lastRenerable->setRendererId(renderableId);
 
@@ -305,8 +317,8 @@ namespace bs { namespace ct
 
 		// Last element is the one we want to erase
 		mRenderables.erase(mRenderables.end() - 1);
-		mRenderableCullInfos.erase(mRenderableCullInfos.end() - 1);
-		mRenderableVisibility.erase(mRenderableVisibility.end() - 1);
+		mRenderableCullInfos.removeLast();
+		mRenderableVisibility.resize(lastRenderableId);
 
 		bs_delete(rendererObject);
 	}
@@ -316,7 +328,7 @@ namespace bs { namespace ct
 		UINT32 renderableId = renderable->getRendererId();
 
 		mRenderables[renderableId]->updatePerObjectBuffer();
-		mRenderableCullInfos[renderableId].bounds = renderable->getBounds();
+		mRenderableCullInfos.setBounds(renderableId, renderable->getBounds());
 	}
 
 	void RenderBeast::notifyLightAdded(Light* light)
@@ -336,7 +348,7 @@ namespace bs { namespace ct
 				light->setRendererId(lightId);
 
 				mRadialLights.push_back(RendererLight(light));
-				mPointLightWorldBounds.push_back(light->getBounds());
+				mPointLightCullInfos.add(getSphereBounds(light->getBounds()));
 			}
 			else // Spot
 			{
@@ -344,7 +356,7 @@ namespace bs { namespace ct
 				light->setRendererId(lightId);
 
 				mSpotLights.push_back(RendererLight(light));
-				mSpotLightWorldBounds.push_back(light->getBounds());
+				mSpotLightCullInfos.add(getSphereBounds(light->getBounds()));
 			}
 		}
 	}
@@ -354,9 +366,9 @@ namespace bs { namespace ct
 		UINT32 lightId = light->getRendererId();
 
 		if (light->getType() == LightType::Radial)
-			mPointLightWorldBounds[lightId] = light->getBounds();
+			mPointLightCullInfos.setBounds(lightId, getSphereBounds(light->getBounds()));
 		else if(light->getType() == LightType::Spot)
-			mSpotLightWorldBounds[lightId] = light->getBounds();
+			mSpotLightCullInfos.setBounds(lightId, getSphereBounds(light->getBounds()));
 	}
 
 	void RenderBeast::notifyLightRemoved(Light* light)
@@ -388,14 +400,14 @@ namespace bs { namespace ct
 				{
 					// Swap current last element with the one we want to erase
 					std::swap(mRadialLights[lightId], mRadialLights[lastLightId]);
-					std::swap(mPointLightWorldBounds[lightId], mPointLightWorldBounds[lastLightId]);
+					mPointLightCullInfos.swap(lightId, lastLightId);
 
 					lastLight->setRendererId(lightId);
 				}
 
 				// Last element is the one we want to erase
 				mRadialLights.erase(mRadialLights.end() - 1);
-				mPointLightWorldBounds.erase(mPointLightWorldBounds.end() - 1);
+				mPointLightCullInfos.removeLast();
 			}
 			else // Spot
 			{
@@ -406,14 +418,14 @@ namespace bs { namespace ct
 				{
 					// Swap current last element with the one we want to erase
 					std::swap(mSpotLights[lightId], mSpotLights[lastLightId]);
-					std::swap(mSpotLightWorldBounds[lightId], mSpotLightWorldBounds[lastLightId]);
+					mSpotLightCullInfos.swap(lightId, lastLightId);
 
 					lastLight->setRendererId(lightId);
 				}
 
 				// Last element is the one we want to erase
 				mSpotLights.erase(mSpotLights.end() - 1);
-				mSpotLightWorldBounds.erase(mSpotLightWorldBounds.end() - 1);
+				mSpotLightCullInfos.removeLast();
 			}
 		}
 	}
@@ -465,7 +477,7 @@ namespace bs { namespace ct
 		mReflProbes.push_back(RendererReflectionProbe(probe));
 		RendererReflectionProbe& probeInfo = mReflProbes.back();
 
-		mReflProbeWorldBounds.push_back(probe->getBounds());
+		mReflProbeCullInfos.add(getSphereBounds(probe->getBounds()));
 
 		// Find a spot in cubemap array
 		UINT32 numArrayEntries = (UINT32)mCubemapArrayUsedSlots.size();
@@ -497,7 +509,7 @@ namespace bs { namespace ct
 	{
 		// Should only get called if transform changes, any other major changes and ReflProbeInfo entry gets rebuild
 		UINT32 probeId = probe->getRendererId();
-		mReflProbeWorldBounds[probeId] = probe->getBounds();
+		mReflProbeCullInfos.setBounds(probeId, getSphereBounds(probe->getBounds()));
 
 		RendererReflectionProbe& probeInfo = mReflProbes[probeId];
 		probeInfo.arrayDirty = true;
@@ -518,14 +530,14 @@ namespace bs { namespace ct
 		{
 			// Swap current last element with the one we want to erase
 			std::swap(mReflProbes[probeId], mReflProbes[lastProbeId]);
-			std::swap(mReflProbeWorldBounds[probeId], mReflProbeWorldBounds[lastProbeId]);
+			mReflProbeCullInfos.swap(probeId, lastProbeId);
 
-			probe->setRendererId(probeId);
+			lastProbe->setRendererId(probeId);
 		}
 
 		// Last element is the one we want to erase
-		mRadialLights.erase(mRadialLights.end() - 1);
-		mPointLightWorldBounds.erase(mPointLightWorldBounds.end() - 1);
+		mReflProbes.erase(mReflProbes.end() - 1);
+		mReflProbeCullInfos.removeLast();
 
 		if (arrayIdx != -1)
 			mCubemapArrayUsedSlots[arrayIdx] = false;
@@ -813,6 +825,9 @@ namespace bs { namespace ct
 		// Render everything
 		renderViews(views.data(), (UINT32)views.size(), frameInfo);
 
+		// Stream in texture detail requested by this frame's views
+		TextureStreamingManager::instance()._update();
+
 		gProfilerGPU().endFrame();
 
 		// Present render targets with back buffers
@@ -827,11 +842,25 @@ namespace bs { namespace ct
 
 	void RenderBeast::renderViews(RendererCamera** views, UINT32 numViews, const FrameInfo& frameInfo)
 	{
-		// Generate render queues per camera
-		mRenderableVisibility.assign(mRenderableVisibility.size(), false);
+		// Generate render queues per camera. Views are processed concurrently, and their visibility merged afterwards.
+		auto determineVisible = [&](UINT32 start, UINT32 end)
+		{
+			for (UINT32 i = start; i < end; i++)
+				views[i]->determineVisible(mRenderables, mRenderableCullInfos);
+		};
+
+		TaskScheduler::instance().parallelFor(0, numViews, 1, determineVisible);
 
+		mRenderableVisibility.reset(false);
 		for(UINT32 i = 0; i < numViews; i++)
-			views[i]->determineVisible(mRenderables, mRenderableCullInfos, &mRenderableVisibility);
+			mRenderableVisibility |= views[i]->getVisibilityMasks().renderables;
+
+		// Request the texture detail needed by visible objects
+		if (TextureStreamingManager::instance().getNumTextures() > 0)
+		{
+			for (UINT32 i = 0; i < numViews; i++)
+				views[i]->requestTextureMips(mRenderables, mRenderableCullInfos);
+		}
 
 		// Generate a list of lights and their GPU buffers
 		UINT32 numDirLights = (UINT32)mDirectionalLights.size();
@@ -843,9 +872,10 @@ namespace bs { namespace ct
 
 		UINT32 numRadialLights = (UINT32)mRadialLights.size();
 		UINT32 numVisibleRadialLights = 0;
-		mLightVisibilityTemp.resize(numRadialLights, false);
+		mLightVisibilityTemp.resize(numRadialLights);
+		mLightVisibilityTemp.reset(false);
 		for (UINT32 i = 0; i < numViews; i++)
-			views[i]->calculateVisibility(mPointLightWorldBounds, mLightVisibilityTemp);
+			views[i]->calculateVisibility(mPointLightCullInfos, mLightVisibilityTemp);
 
 		for(UINT32 i = 0; i < numRadialLights; i++)
 		{
@@ -859,9 +889,10 @@ namespace bs { namespace ct
 
 		UINT32 numSpotLights = (UINT32)mSpotLights.size();
 		UINT32 numVisibleSpotLights = 0;
-		mLightVisibilityTemp.resize(numSpotLights, false);
+		mLightVisibilityTemp.resize(numSpotLights);
+		mLightVisibilityTemp.reset(false);
 		for (UINT32 i = 0; i < numViews; i++)
-			views[i]->calculateVisibility(mSpotLightWorldBounds, mLightVisibilityTemp);
+			views[i]->calculateVisibility(mSpotLightCullInfos, mLightVisibilityTemp);
 
 		for (UINT32 i = 0; i < numSpotLights; i++)
 		{
@@ -881,9 +912,10 @@ namespace bs { namespace ct
 		// Gemerate reflection probes and their GPU buffers
 		UINT32 numProbes = (UINT32)mReflProbes.size();
 
-		mReflProbeVisibilityTemp.resize(numProbes, false);
+		mReflProbeVisibilityTemp.resize(numProbes);
+		mReflProbeVisibilityTemp.reset(false);
 		for (UINT32 i = 0; i < numViews; i++)
-			views[i]->calculateVisibility(mReflProbeWorldBounds, mReflProbeVisibilityTemp);
+			views[i]->calculateVisibility(mReflProbeCullInfos, mReflProbeVisibilityTemp);
 
 		for(UINT32 i = 0; i < numProbes; i++)
 		{
@@ -1524,7 +1556,6 @@ namespace bs { namespace ct
 
 			views[i].setView(viewDesc);
 			views[i].updatePerViewBuffer();
-			views[i].determineVisible(mRenderables, mRenderableCullInfos);
 		}
 
 		RendererCamera* viewPtrs[] = { &views[0], &views[1], &views[2], &views[3], &views[4], &views[5] };
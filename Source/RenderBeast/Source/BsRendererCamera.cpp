@@ -8,6 +8,9 @@
 #include "BsRenderTargets.h"
 #include "BsRendererUtility.h"
 #include "BsGpuParamsSet.h"
+#include "BsSIMD.h"
+#include "BsTaskScheduler.h"
+#include "BsTextureStreamingManager.h"
 
 namespace bs { namespace ct
 {
@@ -54,6 +57,140 @@ namespace bs { namespace ct
 		gRendererUtility().setPassParams(mParamsSet);
 	}
 
+	CullInfoArray::CullInfoArray()
+		:mNumEntries(0)
+	{ }
+
+	void CullInfoArray::add(const Bounds& bounds, UINT64 layer)
+	{
+		if ((mNumEntries % BLOCK_SIZE) == 0)
+		{
+			Block block;
+			memset(&block, 0, sizeof(block));
+
+			mBlocks.push_back(block);
+		}
+
+		mLayers.push_back(layer);
+		mTreeIds.push_back(mTree.insert(bounds.getBox(), mNumEntries));
+		setBounds(mNumEntries++, bounds);
+	}
+
+	void CullInfoArray::setBounds(UINT32 idx, const Bounds& bounds)
+	{
+		Block& block = mBlocks[idx / BLOCK_SIZE];
+		UINT32 entryIdx = idx % BLOCK_SIZE;
+
+		const Sphere& sphere = bounds.getSphere();
+		const Vector3& sphereCenter = sphere.getCenter();
+		block.sphereCenter[0][entryIdx] = sphereCenter.x;
+		block.sphereCenter[1][entryIdx] = sphereCenter.y;
+		block.sphereCenter[2][entryIdx] = sphereCenter.z;
+		block.sphereRadius[entryIdx] = sphere.getRadius();
+
+		const AABox& box = bounds.getBox();
+		Vector3 boxCenter = box.getCenter();
+		Vector3 boxExtents = box.getHalfSize();
+		for(UINT32 i = 0; i < 3; i++)
+		{
+			block.boxCenter[i][entryIdx] = boxCenter[i];
+			block.boxExtents[i][entryIdx] = Math::abs(boxExtents[i]);
+		}
+
+		mTree.update(mTreeIds[idx], box);
+	}
+
+	void CullInfoArray::swap(UINT32 a, UINT32 b)
+	{
+		Block& blockA = mBlocks[a / BLOCK_SIZE];
+		Block& blockB = mBlocks[b / BLOCK_SIZE];
+		UINT32 entryA = a % BLOCK_SIZE;
+		UINT32 entryB = b % BLOCK_SIZE;
+
+		for(UINT32 i = 0; i < 3; i++)
+		{
+			std::swap(blockA.sphereCenter[i][entryA], blockB.sphereCenter[i][entryB]);
+			std::swap(blockA.boxCenter[i][entryA], blockB.boxCenter[i][entryB]);
+			std::swap(blockA.boxExtents[i][entryA], blockB.boxExtents[i][entryB]);
+		}
+
+		std::swap(blockA.sphereRadius[entryA], blockB.sphereRadius[entryB]);
+		std::swap(mLayers[a], mLayers[b]);
+
+		std::swap(mTreeIds[a], mTreeIds[b]);
+		mTree.setUserData(mTreeIds[a], a);
+		mTree.setUserData(mTreeIds[b], b);
+	}
+
+	void CullInfoArray::removeLast()
+	{
+		assert(mNumEntries > 0);
+
+		mNumEntries--;
+		mLayers.pop_back();
+
+		mTree.remove(mTreeIds.back());
+		mTreeIds.pop_back();
+
+		if ((mNumEntries % BLOCK_SIZE) == 0)
+			mBlocks.pop_back();
+		else
+		{
+			// Keep unused entries zeroed out
+			Block& block = mBlocks.back();
+			UINT32 entryIdx = mNumEntries % BLOCK_SIZE;
+
+			for(UINT32 i = 0; i < 3; i++)
+			{
+				block.sphereCenter[i][entryIdx] = 0.0f;
+				block.boxCenter[i][entryIdx] = 0.0f;
+				block.boxExtents[i][entryIdx] = 0.0f;
+			}
+
+			block.sphereRadius[entryIdx] = 0.0f;
+		}
+	}
+
+	void CullInfoArray::clear()
+	{
+		mBlocks.clear();
+		mLayers.clear();
+		mNumEntries = 0;
+
+		mTree.clear();
+		mTreeIds.clear();
+	}
+
+	Vector3 CullInfoArray::getBoxCenter(UINT32 idx) const
+	{
+		const Block& block = mBlocks[idx / BLOCK_SIZE];
+		UINT32 entryIdx = idx % BLOCK_SIZE;
+
+		return Vector3(block.boxCenter[0][entryIdx], block.boxCenter[1][entryIdx], block.boxCenter[2][entryIdx]);
+	}
+
+	float CullInfoArray::getSphereRadius(UINT32 idx) const
+	{
+		return mBlocks[idx / BLOCK_SIZE].sphereRadius[idx % BLOCK_SIZE];
+	}
+
+	bool CullInfoArray::intersects(UINT32 idx, const ConvexVolume& volume) const
+	{
+		const Block& block = mBlocks[idx / BLOCK_SIZE];
+		UINT32 entryIdx = idx % BLOCK_SIZE;
+
+		Vector3 sphereCenter(block.sphereCenter[0][entryIdx], block.sphereCenter[1][entryIdx], 
+			block.sphereCenter[2][entryIdx]);
+
+		if (!volume.intersects(Sphere(sphereCenter, block.sphereRadius[entryIdx])))
+			return false;
+
+		Vector3 boxCenter = getBoxCenter(idx);
+		Vector3 boxExtents(block.boxExtents[0][entryIdx], block.boxExtents[1][entryIdx], block.boxExtents[2][entryIdx]);
+
+		return volume.intersects(AABox(boxCenter - boxExtents, boxCenter + boxExtents));
+	}
+
 	RendererCamera::RendererCamera()
 		: mUsingGBuffer(false)
 	{
@@ -143,87 +280,302 @@ namespace bs { namespace ct
 		}
 	}
 
-	void RendererCamera::determineVisible(const Vector<RendererObject*>& renderables, const Vector<CullInfo>& cullInfos,
-		Vector<bool>* visibility)
+	void RendererCamera::determineVisible(const Vector<RendererObject*>& renderables, const CullInfoArray& cullInfos,
+		Bitfield* visibility)
 	{
-		mVisibility.renderables.clear();
-		mVisibility.renderables.resize(renderables.size(), false);
+		mVisibility.renderables.resize((UINT32)renderables.size());
+		mVisibility.renderables.reset(false);
 
 		if (mViewDesc.isOverlay)
 			return;
 
 		calculateVisibility(cullInfos, mVisibility.renderables);
 
-		// Update per-object param buffers and queue render elements
-		for(UINT32 i = 0; i < (UINT32)cullInfos.size(); i++)
+		// Queue render elements of all visible objects in the provided range of bitfield words
+		const UINT32* visibleWords = mVisibility.renderables.getWords();
+		auto queueWords = [&](UINT32 startWord, UINT32 endWord, RenderQueue& opaqueQueue, RenderQueue& transparentQueue)
 		{
-			if (!mVisibility.renderables[i])
-				continue;
-
-			const AABox& boundingBox = cullInfos[i].bounds.getBox();
-			float distanceToCamera = (mViewDesc.viewOrigin - boundingBox.getCenter()).length();
-
-			for (auto& renderElem : renderables[i]->elements)
+			for(UINT32 i = startWord; i < endWord; i++)
 			{
-				// Note: I could keep opaque and transparent renderables in two separate arrays, so I don't need to do the
-				// check here
-				bool isTransparent = (renderElem.material->getShader()->getFlags() & (UINT32)ShaderFlags::Transparent) != 0;
-
-				if (isTransparent)
-					mTransparentQueue->add(&renderElem, distanceToCamera);
-				else
-					mOpaqueQueue->add(&renderElem, distanceToCamera);
+				UINT32 word = visibleWords[i];
+				for(UINT32 j = 0; word != 0; j++, word >>= 1)
+				{
+					if ((word & 1) == 0)
+						continue;
+
+					UINT32 renderableIdx = i * Bitfield::BITS_PER_WORD + j;
+					float distanceToCamera = (mViewDesc.viewOrigin - cullInfos.getBoxCenter(renderableIdx)).length();
+
+					for (auto& renderElem : renderables[renderableIdx]->elements)
+					{
+						// Note: I could keep opaque and transparent renderables in two separate arrays, so I don't need
+						// to do the check here
+						bool isTransparent = (renderElem.material->getShader()->getFlags() & 
+							(UINT32)ShaderFlags::Transparent) != 0;
+
+						if (isTransparent)
+							transparentQueue.add(&renderElem, distanceToCamera);
+						else
+							opaqueQueue.add(&renderElem, distanceToCamera);
+					}
+				}
 			}
-		}
+		};
 
-		if(visibility != nullptr)
+		UINT32 numWords = mVisibility.renderables.getNumWords();
+		if(numWords > QUEUE_WORDS_PER_TASK)
 		{
-			for (UINT32 i = 0; i < (UINT32)renderables.size(); i++)
+			// Each task queues a fixed range of words into its own queues. Queues are then merged in order, so the final
+			// order is the same as if the elements were queued serially.
+			UINT32 numChunks = (numWords + QUEUE_WORDS_PER_TASK - 1) / QUEUE_WORDS_PER_TASK;
+			if ((UINT32)mOpaqueQueueChunks.size() < numChunks)
+			{
+				mOpaqueQueueChunks.resize(numChunks);
+				mTransparentQueueChunks.resize(numChunks);
+			}
+
+			auto queueChunks = [&](UINT32 startChunk, UINT32 endChunk)
+			{
+				for(UINT32 i = startChunk; i < endChunk; i++)
+				{
+					UINT32 startWord = i * QUEUE_WORDS_PER_TASK;
+					UINT32 endWord = std::min(startWord + QUEUE_WORDS_PER_TASK, numWords);
+
+					queueWords(startWord, endWord, mOpaqueQueueChunks[i], mTransparentQueueChunks[i]);
+				}
+			};
+
+			TaskScheduler::instance().parallelFor(0, numChunks, 1, queueChunks);
+
+			for(UINT32 i = 0; i < numChunks; i++)
 			{
-				bool visible = (*visibility)[i];
+				mOpaqueQueue->append(mOpaqueQueueChunks[i]);
+				mTransparentQueue->append(mTransparentQueueChunks[i]);
 
-				(*visibility)[i] = visible || mVisibility.renderables[i];
+				mOpaqueQueueChunks[i].clear();
+				mTransparentQueueChunks[i].clear();
 			}
 		}
+		else
+			queueWords(0, numWords, *mOpaqueQueue, *mTransparentQueue);
+
+		if(visibility != nullptr)
+			*visibility |= mVisibility.renderables;
 
 		mOpaqueQueue->sort();
 		mTransparentQueue->sort();
 	}
 
-	void RendererCamera::calculateVisibility(const Vector<CullInfo>& cullInfos, Vector<bool>& visibility) const
+	void RendererCamera::requestTextureMips(const Vector<RendererObject*>& renderables, 
+		const CullInfoArray& cullInfos) const
 	{
-		UINT64 cameraLayers = mViewDesc.visibleLayers;
-		const ConvexVolume& worldFrustum = mViewDesc.cullFrustum;
+		if (mViewDesc.isOverlay)
+			return;
+
+		TextureStreamingManager& streamingManager = TextureStreamingManager::instance();
 
-		for (UINT32 i = 0; i < (UINT32)cullInfos.size(); i++)
+		// Size of an object of unit radius at unit distance (or any distance, for orthographic projections), in pixels
+		bool isOrtho = mViewDesc.projTransform[3][3] == 1.0f;
+		float pixelsPerUnit = Math::abs(mViewDesc.projTransform[1][1]) * mViewDesc.target.viewRect.height;
+
+		const UINT32* visibleWords = mVisibility.renderables.getWords();
+		UINT32 numWords = mVisibility.renderables.getNumWords();
+		for(UINT32 i = 0; i < numWords; i++)
 		{
-			if ((cullInfos[i].layer & cameraLayers) == 0)
-				continue;
-
-			// Do frustum culling
-			// Note: This is bound to be a bottleneck at some point. When it is ensure that intersect methods use vector
-			// operations, as it is trivial to update them. Also consider spatial partitioning.
-			const Sphere& boundingSphere = cullInfos[i].bounds.getSphere();
-			if (worldFrustum.intersects(boundingSphere))
+			UINT32 word = visibleWords[i];
+			for(UINT32 j = 0; word != 0; j++, word >>= 1)
 			{
-				// More precise with the box
-				const AABox& boundingBox = cullInfos[i].bounds.getBox();
+				if ((word & 1) == 0)
+					continue;
+
+				UINT32 renderableIdx = i * Bitfield::BITS_PER_WORD + j;
+
+				float diameter = cullInfos.getSphereRadius(renderableIdx) * pixelsPerUnit;
+				if (!isOrtho)
+				{
+					float distance = (mViewDesc.viewOrigin - cullInfos.getBoxCenter(renderableIdx)).length();
+					diameter /= std::max(distance, mViewDesc.nearPlane);
+				}
+
+				diameter = std::max(diameter, 1.0f);
+
+				for (auto& renderElem : renderables[renderableIdx]->elements)
+				{
+					SPtr<MaterialParams> params = renderElem.material->_getInternalParams();
 
-				if (worldFrustum.intersects(boundingBox))
-					visibility[i] = true;
+					UINT32 numParams = params->getNumParams();
+					for (UINT32 k = 0; k < numParams; k++)
+					{
+						const MaterialParams::ParamData* paramData = params->getParamData(k);
+						if (paramData->type != MaterialParams::ParamType::Texture)
+							continue;
+
+						SPtr<Texture> texture;
+						TextureSurface surface;
+						params->getTexture(*paramData, texture, surface);
+
+						if (texture == nullptr || !texture->getProperties().isStreaming())
+							continue;
+
+						const TextureProperties& props = texture->getProperties();
+						float texels = (float)std::max(props.getWidth(), props.getHeight());
+
+						UINT32 mip = 0;
+						if (texels > diameter)
+							mip = std::min((UINT32)Math::log2(texels / diameter), props.getNumMipmaps());
+
+						streamingManager.requestMip(texture.get(), mip);
+					}
+				}
 			}
 		}
 	}
 
-	void RendererCamera::calculateVisibility(const Vector<Sphere>& bounds, Vector<bool>& visibility) const
+	void RendererCamera::calculateVisibility(const CullInfoArray& cullInfos, Bitfield& visibility) const
 	{
-		const ConvexVolume& worldFrustum = mViewDesc.cullFrustum;
+		static_assert(Bitfield::BITS_PER_WORD % CullInfoArray::BLOCK_SIZE == 0, 
+			"Bitfield words must contain a whole number of cull blocks.");
+
+		UINT64 cameraLayers = mViewDesc.visibleLayers;
+		const Vector<CullInfoArray::Block>& blocks = cullInfos.getBlocks();
+		const Vector<UINT64>& layers = cullInfos.getLayers();
 
-		for (UINT32 i = 0; i < (UINT32)bounds.size(); i++)
+		// Scratch memory comes from the allocator of the calling thread, as this might be running on a worker
+		FrameAlloc& frameAlloc = ThreadFrameAlloc::get();
+
+		// For large sets only visit the objects in the parts of the hierarchy that overlap the frustum. Objects whose
+		// nodes are fully inside the frustum need no further testing.
+		if(cullInfos.size() >= CULL_TREE_MIN_OBJECTS)
 		{
-			if (worldFrustum.intersects(bounds[i]))
-				visibility[i] = true;
+			// Frame allocator memory isn't freed when a vector grows, so reserve enough for all objects up front
+			StdFrameAlloc<UINT32> indexAlloc(&frameAlloc);
+			FrameVector<UINT32, StdFrameAlloc<UINT32>> inside(indexAlloc);
+			FrameVector<UINT32, StdFrameAlloc<UINT32>> intersecting(indexAlloc);
+			inside.reserve(cullInfos.size());
+			intersecting.reserve(cullInfos.size());
+
+			cullInfos.getTree().query(mViewDesc.cullFrustum, inside, intersecting);
+
+			for(auto& entry : inside)
+			{
+				if ((layers[entry] & cameraLayers) != 0)
+					visibility.set(entry, true);
+			}
+
+			for(auto& entry : intersecting)
+			{
+				if ((layers[entry] & cameraLayers) != 0 && cullInfos.intersects(entry, mViewDesc.cullFrustum))
+					visibility.set(entry, true);
+			}
+
+			return;
 		}
+
+		// Splat frustum planes once, so they can be tested against four objects at a time
+		struct CullPlane
+		{
+			simd::float4 normal[3];
+			simd::float4 absNormal[3];
+			simd::float4 d;
+		};
+
+		const Vector<Plane>& planes = mViewDesc.cullFrustum.getPlanes();
+		UINT32 numPlanes = (UINT32)planes.size();
+
+		CullPlane* cullPlanes = (CullPlane*)frameAlloc.allocAligned(sizeof(CullPlane) * numPlanes, 16);
+		for(UINT32 i = 0; i < numPlanes; i++)
+		{
+			for(UINT32 j = 0; j < 3; j++)
+			{
+				cullPlanes[i].normal[j] = simd::set(planes[i].normal[j]);
+				cullPlanes[i].absNormal[j] = simd::set(Math::abs(planes[i].normal[j]));
+			}
+
+			cullPlanes[i].d = simd::set(planes[i].d);
+		}
+
+		// Each call culls all the objects belonging to the provided range of bitfield words. Since threads never write
+		// to the same word no synchronization is needed.
+		const UINT32 blocksPerWord = Bitfield::BITS_PER_WORD / CullInfoArray::BLOCK_SIZE;
+		UINT32* visibleWords = visibility.getWords();
+		UINT32 numBlocks = (UINT32)blocks.size();
+
+		auto cullWords = [&](UINT32 startWord, UINT32 endWord)
+		{
+			for(UINT32 i = startWord; i < endWord; i++)
+			{
+				UINT32 startBlock = i * blocksPerWord;
+				UINT32 endBlock = std::min(startBlock + blocksPerWord, numBlocks);
+
+				UINT32 visibleBits = 0;
+				for(UINT32 j = startBlock; j < endBlock; j++)
+				{
+					const CullInfoArray::Block& block = blocks[j];
+
+					simd::float4 sphereCenter[3];
+					simd::float4 boxCenter[3];
+					simd::float4 boxExtents[3];
+					for(UINT32 k = 0; k < 3; k++)
+					{
+						sphereCenter[k] = simd::load(block.sphereCenter[k]);
+						boxCenter[k] = simd::load(block.boxCenter[k]);
+						boxExtents[k] = simd::load(block.boxExtents[k]);
+					}
+
+					simd::float4 sphereRadius = simd::load(block.sphereRadius);
+
+					// An object is culled if either its sphere or its box is fully behind any plane. Track the smallest
+					// signed distance from any plane to the back of either shape, objects with a negative distance are
+					// culled.
+					simd::float4 minDistance = simd::set(std::numeric_limits<float>::max());
+					for(UINT32 k = 0; k < numPlanes; k++)
+					{
+						const CullPlane& plane = cullPlanes[k];
+
+						simd::float4 sphereDist = simd::mul(sphereCenter[0], plane.normal[0]);
+						sphereDist = simd::madd(sphereCenter[1], plane.normal[1], sphereDist);
+						sphereDist = simd::madd(sphereCenter[2], plane.normal[2], sphereDist);
+						sphereDist = simd::add(simd::sub(sphereDist, plane.d), sphereRadius);
+
+						simd::float4 boxDist = simd::mul(boxCenter[0], plane.normal[0]);
+						boxDist = simd::madd(boxCenter[1], plane.normal[1], boxDist);
+						boxDist = simd::madd(boxCenter[2], plane.normal[2], boxDist);
+						boxDist = simd::sub(boxDist, plane.d);
+
+						simd::float4 effectiveRadius = simd::mul(boxExtents[0], plane.absNormal[0]);
+						effectiveRadius = simd::madd(boxExtents[1], plane.absNormal[1], effectiveRadius);
+						effectiveRadius = simd::madd(boxExtents[2], plane.absNormal[2], effectiveRadius);
+						boxDist = simd::add(boxDist, effectiveRadius);
+
+						minDistance = simd::min(minDistance, simd::min(sphereDist, boxDist));
+					}
+
+					UINT32 culledMask = simd::getMask(simd::cmpLess(minDistance, simd::zero()));
+					UINT32 blockVisibleBits = ~culledMask & 0xF;
+
+					// Apply the layer mask
+					UINT32 firstEntry = j * CullInfoArray::BLOCK_SIZE;
+					for(UINT32 k = 0; k < CullInfoArray::BLOCK_SIZE; k++)
+					{
+						UINT32 entryIdx = firstEntry + k;
+						if (entryIdx >= cullInfos.size() || (layers[entryIdx] & cameraLayers) == 0)
+							blockVisibleBits &= ~(1U << k);
+					}
+
+					visibleBits |= blockVisibleBits << ((j - startBlock) * CullInfoArray::BLOCK_SIZE);
+				}
+
+				visibleWords[i] |= visibleBits;
+			}
+		};
+
+		UINT32 numWords = visibility.getNumWords();
+		if (numWords > CULL_WORDS_PER_TASK)
+			TaskScheduler::instance().parallelFor(0, numWords, CULL_WORDS_PER_TASK, cullWords);
+		else
+			cullWords(0, numWords);
+
+		frameAlloc.dealloc((UINT8*)cullPlanes);
 	}
 
 	Vector2 RendererCamera::getDeviceZTransform(const Matrix4& projMatrix) const
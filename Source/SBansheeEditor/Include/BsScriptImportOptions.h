@@ -118,6 +118,10 @@ namespace bs
 		static void internal_SetImportBlendShapes(ScriptMeshImportOptions* thisPtr, bool value);
 		static bool internal_GetKeyFrameReduction(ScriptMeshImportOptions* thisPtr);
 		static void internal_SetKeyFrameReduction(ScriptMeshImportOptions* thisPtr, bool value);
+		static bool internal_GetAnimationCompression(ScriptMeshImportOptions* thisPtr);
+		static void internal_SetAnimationCompression(ScriptMeshImportOptions* thisPtr, bool value);
+		static float internal_GetAnimationCompressionError(ScriptMeshImportOptions* thisPtr);
+		static void internal_SetAnimationCompressionError(ScriptMeshImportOptions* thisPtr, float value);
 		static bool internal_GetRootMotion(ScriptMeshImportOptions* thisPtr);
 		static void internal_SetRootMotion(ScriptMeshImportOptions* thisPtr, bool value);
 		static float internal_GetScale(ScriptMeshImportOptions* thisPtr);
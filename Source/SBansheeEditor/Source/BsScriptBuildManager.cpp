@@ -17,6 +17,7 @@
 #include "BsPrefab.h"
 #include "BsEditorApplication.h"
 #include "BsResourceManifest.h"
+#include "BsResourceArchive.h"
 #include "BsBuiltinResources.h"
 #include "BsSceneObject.h"
 #include "BsDebug.h"
@@ -300,6 +301,8 @@ namespace bs
 
 		FileSystem::createDir(outputPath);
 
+		Vector<std::pair<String, Path>> packagedResources;
+
 		Path libraryDir = gProjectLibrary().getResourcesFolder();
 		for (auto& entry : usedResources)
 		{
@@ -365,6 +368,25 @@ namespace bs
 			}
 			else
 				FileSystem::copy(entry, destPath);
+
+			packagedResources.push_back(std::make_pair(uuid, destPath));
+		}
+
+		// Pack resources into an archive so the game can load them with fewer file accesses. Loads by path are resolved
+		// to the archive through the manifest, so loose files are only kept for resources that failed to be archived.
+		Path archivePath = outputPath;
+		archivePath.append(GAME_RESOURCE_ARCHIVE_NAME);
+
+		BuildManager::instance().createResourceArchive(archivePath, packagedResources);
+
+		SPtr<ResourceArchive> archive = ResourceArchive::open(archivePath);
+		if (archive != nullptr)
+		{
+			for (auto& entry : packagedResources)
+			{
+				if (archive->findEntry(entry.first) != nullptr)
+					FileSystem::remove(entry.second);
+			}
 		}
 
 		// Save icon
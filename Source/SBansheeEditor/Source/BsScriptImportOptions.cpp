@@ -205,6 +205,10 @@ namespace bs
 		metaData.scriptClass->addInternalCall("Internal_SetImportBlendShapes", &ScriptMeshImportOptions::internal_SetImportBlendShapes);
 		metaData.scriptClass->addInternalCall("Internal_GetKeyFrameReduction", &ScriptMeshImportOptions::internal_GetKeyFrameReduction);
 		metaData.scriptClass->addInternalCall("Internal_SetKeyFrameReduction", &ScriptMeshImportOptions::internal_SetKeyFrameReduction);
+		metaData.scriptClass->addInternalCall("Internal_GetAnimationCompression", &ScriptMeshImportOptions::internal_GetAnimationCompression);
+		metaData.scriptClass->addInternalCall("Internal_SetAnimationCompression", &ScriptMeshImportOptions::internal_SetAnimationCompression);
+		metaData.scriptClass->addInternalCall("Internal_GetAnimationCompressionError", &ScriptMeshImportOptions::internal_GetAnimationCompressionError);
+		metaData.scriptClass->addInternalCall("Internal_SetAnimationCompressionError", &ScriptMeshImportOptions::internal_SetAnimationCompressionError);
 		metaData.scriptClass->addInternalCall("Internal_GetRootMotion", &ScriptMeshImportOptions::internal_GetRootMotion);
 		metaData.scriptClass->addInternalCall("Internal_SetRootMotion", &ScriptMeshImportOptions::internal_SetRootMotion);
 		metaData.scriptClass->addInternalCall("Internal_GetScale", &ScriptMeshImportOptions::internal_GetScale);
@@ -311,6 +315,26 @@ namespace bs
 		thisPtr->getMeshImportOptions()->setKeyFrameReduction(value);
 	}
 
+	bool ScriptMeshImportOptions::internal_GetAnimationCompression(ScriptMeshImportOptions* thisPtr)
+	{
+		return thisPtr->getMeshImportOptions()->getAnimationCompression();
+	}
+
+	void ScriptMeshImportOptions::internal_SetAnimationCompression(ScriptMeshImportOptions* thisPtr, bool value)
+	{
+		thisPtr->getMeshImportOptions()->setAnimationCompression(value);
+	}
+
+	float ScriptMeshImportOptions::internal_GetAnimationCompressionError(ScriptMeshImportOptions* thisPtr)
+	{
+		return thisPtr->getMeshImportOptions()->getAnimationCompressionError();
+	}
+
+	void ScriptMeshImportOptions::internal_SetAnimationCompressionError(ScriptMeshImportOptions* thisPtr, float value)
+	{
+		thisPtr->getMeshImportOptions()->setAnimationCompressionError(value);
+	}
+
 	bool ScriptMeshImportOptions::internal_GetRootMotion(ScriptMeshImportOptions* thisPtr)
 	{
 		return thisPtr->getMeshImportOptions()->getImportRootMotion();